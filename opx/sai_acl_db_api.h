@@ -61,6 +61,26 @@ sai_status_t sai_acl_rule_create_db_entry (sai_acl_rule_t *p_acl_rule);
  */
 sai_status_t sai_acl_rule_delete_db_entry (sai_acl_rule_t *p_acl_rule);
 
+/*
+ * @brief Create a batch of entries in the ACL ENTRY database table and their
+ * filter and action lists, with multi row insert statements
+ * @param count - Number of ACL entries.
+ * @param rule_list - New ACL entry nodes to be inserted in DB.
+ * @return sai status code
+ */
+sai_status_t sai_acl_rule_create_db_entries (uint_t count,
+                                             sai_acl_rule_t **rule_list);
+
+/*
+ * @brief Delete a batch of entries from the ACL ENTRY database table, with
+ * one statement per group of entries
+ * @param count - Number of ACL entries.
+ * @param rule_list - ACL entry nodes to be deleted from DB.
+ * @return sai status code
+ */
+sai_status_t sai_acl_rule_delete_db_entries (uint_t count,
+                                             sai_acl_rule_t **rule_list);
+
 /*
  * @brief Set the fields in the existing ACL ENTRY database table
  * @param p_new_acl_rule - ACL entry node with new actions and filters.
@@ -97,6 +117,26 @@ sai_status_t sai_acl_counter_create_db_entry (sai_acl_counter_t *p_acl_cntr);
  */
 sai_status_t sai_acl_counter_delete_db_entry (sai_acl_counter_t *p_acl_cntr);
 
+/*
+ * @brief Create a batch of entries in the ACL COUNTER database table, with
+ * multi row insert statements
+ * @param count - Number of ACL counters.
+ * @param cntr_list - New ACL Counter nodes to be inserted in DB.
+ * @return sai status code
+ */
+sai_status_t sai_acl_counter_create_db_entries (uint_t count,
+                                                sai_acl_counter_t **cntr_list);
+
+/*
+ * @brief Delete a batch of entries from the ACL COUNTER database table, with
+ * one statement per group of entries
+ * @param count - Number of ACL counters.
+ * @param cntr_list - ACL Counter nodes to be deleted from DB.
+ * @return sai status code
+ */
+sai_status_t sai_acl_counter_delete_db_entries (uint_t count,
+                                                sai_acl_counter_t **cntr_list);
+
 /*
  * @brief Set counter fields in counter entry on ACL COUNTER database table
  * @param p_acl_cntr - ACL Counter node.
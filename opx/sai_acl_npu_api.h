@@ -103,7 +103,9 @@ typedef sai_status_t (*sai_npu_copy_acl_rule_fn)(sai_acl_rule_t *src_rule,
  *
  * @param[in] acl_table  Pointer to the ACL Table node
  * @param[in] set_rule   Pointer to ACL Rule derived from set ACL Attribute list
- * @param[inout] compare_rule    Pointer to ACL Rule used for comparison
+ * @param[in] compare_rule    Pointer to ACL Rule used for comparison, a
+ *                           snapshot of given_rule sharing its lists, not to
+ *                           be modified
  * @param[in] given_rule    Pointer to original unmodified ACL rule
  * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
  *  error code is returned.
@@ -299,6 +301,57 @@ typedef void (*sai_npu_dump_counter_per_entry) (int entry_id);
 typedef sai_status_t (*sai_npu_attribute_acl_slice_get_fn)(sai_object_id_t acl_slice_id,
                                                             uint32_t attr_count,
                                                             sai_attribute_t *attr_list);
+
+/**
+ * @brief Create a batch of ACL Rules of one ACL Table in NPU.
+ *
+ * @param[inout] acl_table  Pointer to the ACL Table node
+ * @param[in] count  Number of ACL Rules
+ * @param[inout] rule_list  ACL Rule nodes
+ * @return SAI_STATUS_SUCCESS if all the rules were created, otherwise none
+ *  was created and the caller retries the rules one at a time.
+ */
+typedef sai_status_t (*sai_npu_create_acl_rules_fn)(sai_acl_table_t *acl_table,
+                                                    uint_t count,
+                                                    sai_acl_rule_t **rule_list);
+
+/**
+ * @brief Delete a batch of ACL Rules of one ACL Table from NPU.
+ *
+ * @param[inout] acl_table  Pointer to the ACL Table node
+ * @param[in] count  Number of ACL Rules
+ * @param[inout] rule_list  ACL Rule nodes
+ * @return SAI_STATUS_SUCCESS if all the rules were deleted, otherwise none
+ *  was deleted and the caller retries the rules one at a time.
+ */
+typedef sai_status_t (*sai_npu_delete_acl_rules_fn)(sai_acl_table_t *acl_table,
+                                                    uint_t count,
+                                                    sai_acl_rule_t **rule_list);
+
+/**
+ * @brief Create a batch of ACL Counters of one ACL Table in NPU.
+ *
+ * @param[in] acl_table  Pointer to the ACL Table node
+ * @param[in] count  Number of ACL Counters
+ * @param[inout] cntr_list  ACL Counter nodes
+ * @return SAI_STATUS_SUCCESS if all the counters were created, otherwise none
+ *  was created and the caller retries the counters one at a time.
+ */
+typedef sai_status_t (*sai_npu_create_acl_cntrs_fn)(sai_acl_table_t *acl_table,
+                                                    uint_t count,
+                                                    sai_acl_counter_t **cntr_list);
+
+/**
+ * @brief Delete a batch of ACL Counters from NPU.
+ *
+ * @param[in] count  Number of ACL Counters
+ * @param[inout] cntr_list  ACL Counter nodes
+ * @return SAI_STATUS_SUCCESS if all the counters were deleted, otherwise none
+ *  was deleted and the caller retries the counters one at a time.
+ */
+typedef sai_status_t (*sai_npu_delete_acl_cntrs_fn)(uint_t count,
+                                                    sai_acl_counter_t **cntr_list);
+
 /**
  * @brief ACL NPU API table.
  */
@@ -330,6 +383,10 @@ typedef struct _sai_npu_acl_api_t {
     sai_npu_dump_counters                     dump_all_counters;
     sai_npu_dump_counter_per_entry            dump_entry_counter;
     sai_npu_attribute_acl_slice_get_fn        get_acl_slice_attribute;
+    sai_npu_create_acl_rules_fn               create_acl_rules;
+    sai_npu_delete_acl_rules_fn               delete_acl_rules;
+    sai_npu_create_acl_cntrs_fn               create_acl_cntrs;
+    sai_npu_delete_acl_cntrs_fn               delete_acl_cntrs;
 } sai_npu_acl_api_t;
 
 /**
@@ -62,7 +62,7 @@ typedef enum _sai_acl_rule_attr_type {
 /** Logging utility for SAI ACL API */
 #define SAI_ACL_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_ACL, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_ACL, level)) { \
             SAI_LOG_UTIL(ev_log_t_ACL, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -349,6 +349,30 @@ uint_t sai_acl_entry_depth_get (void);
 uint_t sai_acl_max_efp_slice_get (void);
 uint_t sai_acl_fp_slice_depth_get (sai_acl_stage_t stage, sai_uint32_t slice_id);
 
+/**
+ * @brief Check the parameters common to the bulk ACL APIs and set the
+ * status of every object to SAI_STATUS_NOT_EXECUTED.
+ *
+ * @param[in] object_count Number of objects
+ * @param[in] mode Bulk error mode
+ * @param[out] object_statuses Status of each object
+ * @return SAI_STATUS_SUCCESS if the parameters are valid
+ */
+sai_status_t sai_acl_bulk_params_validate(uint32_t object_count,
+                                          sai_bulk_op_error_mode_t mode,
+                                          sai_status_t *object_statuses);
+
+/**
+ * @brief Return status of a bulk ACL API from the status of its objects.
+ *
+ * @param[in] object_count Number of objects
+ * @param[in] object_statuses Status of each object
+ * @return SAI_STATUS_SUCCESS if all the objects succeeded, else
+ * SAI_STATUS_FAILURE
+ */
+sai_status_t sai_acl_bulk_status_get(uint32_t object_count,
+                                     const sai_status_t *object_statuses);
+
 /**
  * @brief return the slice node for given slice tree.
  *
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file sai_api_stats.h
+*
+* @brief This file contains the per API call counters and latency
+*        histograms collected at the SAI method table boundary.
+*
+*        The create/remove/set/get methods of the control plane objects
+*        returned by sai_api_query are wrapped, as are the bulk APIs, in the
+*        method tables or exported by their module. Each call is counted and
+*        timed into per thread records, so the fast path takes no lock and
+*        does no shared atomic operation. The module locks report the time
+*        spent waiting on them to the API call of the calling thread.
+*
+*************************************************************************/
+
+#ifndef __SAI_API_STATS_H__
+#define __SAI_API_STATS_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "saitypes.h"
+#include "std_mutex_lock.h"
+
+/** \defgroup SAIAPISTATS SAI - API call statistics
+ *   Call counters and latency histograms of the SAI APIs
+ *
+ *  \ingroup SAIAPI
+ *  \{
+ */
+
+/** Environment variable, set to 1 to collect the API stats from init */
+#define SAI_API_STATS_ENV "SAI_API_STATS"
+
+/** Bulk APIs exported by their module rather than in a method table */
+typedef enum _sai_api_stats_bulk_t {
+    SAI_API_STATS_BULK_FDB_ENTRY_CREATE,
+    SAI_API_STATS_BULK_FDB_ENTRY_REMOVE,
+    SAI_API_STATS_BULK_FDB_ENTRY_SET,
+    SAI_API_STATS_BULK_NEIGHBOR_ENTRY_CREATE,
+    SAI_API_STATS_BULK_NEIGHBOR_ENTRY_REMOVE,
+    SAI_API_STATS_BULK_NEXT_HOP_CREATE,
+    SAI_API_STATS_BULK_NEXT_HOP_REMOVE,
+    SAI_API_STATS_BULK_ACL_ENTRY_CREATE,
+    SAI_API_STATS_BULK_ACL_ENTRY_REMOVE,
+    SAI_API_STATS_BULK_ACL_COUNTER_CREATE,
+    SAI_API_STATS_BULK_ACL_COUNTER_REMOVE,
+    SAI_API_STATS_BULK_MAX
+} sai_api_stats_bulk_t;
+
+/** Bulk API call in progress */
+typedef struct _sai_api_stats_call_t {
+    void     *p_rec;
+    uint64_t  start_ns;
+} sai_api_stats_call_t;
+
+/**
+ * @brief Start the accounting of a call to an exported bulk API.
+ *
+ * @param[in] bulk Bulk API called
+ * @param[out] p_call Call in progress, passed to sai_api_stats_bulk_end
+ */
+void sai_api_stats_bulk_start (sai_api_stats_bulk_t bulk,
+                               sai_api_stats_call_t *p_call);
+
+/**
+ * @brief End the accounting of a call to an exported bulk API.
+ *
+ * @param[in] p_call Call in progress
+ * @param[in] object_count Number of objects of the call
+ * @param[in] status Return status of the call
+ */
+void sai_api_stats_bulk_end (sai_api_stats_call_t *p_call,
+                             uint32_t object_count, sai_status_t status);
+
+/** Return the status of an exported bulk API call, counted and timed */
+#define SAI_API_STATS_BULK_CALL(_bulk, _object_count, _call)                  \
+    do {                                                                      \
+        sai_api_stats_call_t stats_call;                                      \
+        sai_status_t         stats_status;                                    \
+                                                                              \
+        sai_api_stats_bulk_start (_bulk, &stats_call);                        \
+        stats_status = _call;                                                 \
+        sai_api_stats_bulk_end (&stats_call, _object_count, stats_status);    \
+                                                                              \
+        return stats_status;                                                  \
+    } while (0)
+
+/**
+ * @brief Wrap the method table of an API with the stats collecting methods.
+ *
+ * @param[in] api_id SAI API identifier
+ * @param[in] method_table Method table of the API
+ * @return Wrapped method table, or method_table when the API is not
+ *         instrumented
+ */
+void *sai_api_stats_table_wrap (sai_api_t api_id, void *method_table);
+
+/**
+ * @brief Enable or disable the collection of the API stats.
+ *
+ * @param[in] enable true to collect the API stats
+ */
+void sai_api_stats_enable_set (bool enable);
+
+/**
+ * @brief Check if the API stats are collected.
+ *
+ * @return true when the API stats are collected
+ */
+bool sai_api_stats_is_enabled (void);
+
+/**
+ * @brief Lock a module mutex, accounting the time spent waiting on it to
+ *        the SAI API call in progress on the calling thread.
+ *
+ * @param[in] lock Module mutex
+ */
+void sai_api_stats_mutex_lock (std_mutex_type_t *lock);
+
+/**
+ * @brief Take a module read write lock for reading or for writing,
+ *        accounting the time spent waiting on it to the SAI API call in
+ *        progress on the calling thread.
+ *
+ * @param[in] lock Module read write lock
+ * @param[in] write true to take the lock for writing
+ */
+void sai_api_stats_rwlock_lock (pthread_rwlock_t *lock, bool write);
+
+/**
+ * @brief Dump the call counters and latency percentiles of the APIs that
+ *        were called since the last reset.
+ */
+void sai_api_stats_dump (void);
+
+/**
+ * @brief Clear the API stats of all the threads.
+ */
+void sai_api_stats_reset (void);
+
+/**
+ * \}
+ */
+
+#endif /* __SAI_API_STATS_H__ */
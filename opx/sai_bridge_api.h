@@ -97,6 +97,49 @@ sai_status_t sai_bridge_port_cache_delete (sai_object_id_t bridge_port_id);
 sai_status_t sai_bridge_port_cache_read (sai_object_id_t bridge_port_id,
                                          dn_sai_bridge_port_info_t **bridge_port_info);
 
+/**
+ * @brief Copy out bridge cache info for the Bridge ID without the bridge lock.
+ *        The copy is consistent even while the bridge cache is being updated.
+ *
+ * @param[in] bridge_id Bridge SAI Object identifier
+ * @param[out] bridge_info Copy of the bridge info structure
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_bridge_cache_snapshot_read (sai_object_id_t bridge_id,
+                                             dn_sai_bridge_info_t *bridge_info);
+
+/**
+ * @brief Copy out bridge port cache info for the Bridge port ID without the
+ *        bridge lock. The copy is consistent even while the bridge port cache
+ *        is being updated.
+ *
+ * @param[in] bridge_port_id Bridge port SAI Object identifier
+ * @param[out] bridge_port_info Copy of the bridge port info structure
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_bridge_port_cache_snapshot_read (sai_object_id_t bridge_port_id,
+                                                  dn_sai_bridge_port_info_t *bridge_port_info);
+
+/**
+ * @brief Make the changes done in place on the bridge cache info read for
+ *        the Bridge ID visible to the snapshot readers. Called with the
+ *        bridge lock held.
+ *
+ * @param[in] bridge_id Bridge SAI Object identifier
+ */
+void sai_bridge_cache_publish (sai_object_id_t bridge_id);
+
+/**
+ * @brief Make the changes done in place on the bridge port cache info read
+ *        for the Bridge port ID visible to the snapshot readers. Called with
+ *        the bridge lock held.
+ *
+ * @param[in] bridge_port_id Bridge port SAI Object identifier
+ */
+void sai_bridge_port_cache_publish (sai_object_id_t bridge_port_id);
+
 /**
  * @brief Check if bridge is created
  *
@@ -133,7 +176,7 @@ uint_t sai_bridge_port_total_count(void);
  * @brief Get the list of bridges in the system
  *
  * @param[inout] count Size of bridge_list. During out it has Number of bridges in the system.
- * @param[out] bridge_list List of bridge IDs in the system
+ * @param[out] bridge_list List of bridge IDs in the system, from one snapshot
  * @return SAI_STATUS_SUCCESS if successful otherwise a different
  *  error code is returned.
  */
@@ -143,7 +186,7 @@ sai_status_t sai_bridge_list_get(uint_t *count, sai_object_id_t *bridge_list);
  * @brief Get the list of bridge ports in the system
  *
  * @param[inout] count Size of bridge_port_list. During out it has Number of bridge ports in the system.
- * @param[out] bridge_port_list List of bridge port IDs in the system
+ * @param[out] bridge_port_list List of bridge port IDs in the system, from one snapshot
  * @return SAI_STATUS_SUCCESS if successful otherwise a different
  *  error code is returned.
  */
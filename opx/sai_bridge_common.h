@@ -286,7 +286,7 @@ typedef enum _sai_bridge_debug_dump_t {
 /** Logging utility for SAI BRIDGE API */
 #define SAI_BRIDGE_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_BRIDGE, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_BRIDGE, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_BRIDGE, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -212,6 +212,32 @@ sai_status_t sai_set_acl_cntr(sai_object_id_t acl_counter_id,
 sai_status_t sai_get_acl_cntr(sai_object_id_t acl_counter_id,
                               uint32_t attr_count,
                               sai_attribute_t *attr_list);
+
+/* Bulk ACL rule and counter APIs, with a status per object and the
+ * stop-on-error and ignore-error modes. A batch holds the ACL lock once. */
+sai_status_t sai_bulk_create_acl_rule(sai_object_id_t switch_id,
+                                      uint32_t object_count,
+                                      const uint32_t *attr_count,
+                                      const sai_attribute_t **attr_list,
+                                      sai_bulk_op_error_mode_t mode,
+                                      sai_object_id_t *object_id,
+                                      sai_status_t *object_statuses);
+sai_status_t sai_bulk_remove_acl_rule(uint32_t object_count,
+                                      const sai_object_id_t *object_id,
+                                      sai_bulk_op_error_mode_t mode,
+                                      sai_status_t *object_statuses);
+sai_status_t sai_bulk_create_acl_counter(sai_object_id_t switch_id,
+                                         uint32_t object_count,
+                                         const uint32_t *attr_count,
+                                         const sai_attribute_t **attr_list,
+                                         sai_bulk_op_error_mode_t mode,
+                                         sai_object_id_t *object_id,
+                                         sai_status_t *object_statuses);
+sai_status_t sai_bulk_remove_acl_counter(uint32_t object_count,
+                                         const sai_object_id_t *object_id,
+                                         sai_bulk_op_error_mode_t mode,
+                                         sai_status_t *object_statuses);
+
 sai_status_t  sai_acl_rule_policer_update(sai_acl_rule_t *acl_rule_modify,
                                           sai_acl_rule_t *acl_rule_present);
 sai_status_t sai_attach_policer_to_acl_rule(sai_acl_rule_t *acl_rule);
@@ -251,11 +277,13 @@ sai_status_t sai_get_acl_range(sai_object_id_t acl_range_id,
 void sai_acl_table_group_init(void);
 void sai_acl_table_group_member_init(void);
 void sai_acl_range_init(void);
+void sai_acl_rule_index_init(void);
 void sai_acl_lock(void);
 void sai_acl_unlock(void);
 void sai_acl_dump_all_tables(void);
 void sai_acl_dump_table(sai_object_id_t table_id);
 void sai_acl_dump_rule(sai_object_id_t rule_id);
+void sai_acl_dump_counter(sai_object_id_t counter_id);
 void sai_acl_dump_counters();
 void sai_acl_dump_counter_per_entry(int eid);
 sai_status_t sai_acl_slice_attribute_get(sai_object_id_t acl_slice_id,
@@ -24,6 +24,7 @@
 
 #include "sai.h"
 #include "sai_gen_utils.h"
+#include "sai_log_async.h"
 #include "event_log.h"
 #include "event_log_types.h"
 
@@ -58,8 +59,16 @@
                  EV_LOG_ERR(mod, SAI_ERR_SUBLVL, ID, msg, ##__VA_ARGS__)
 
 /**
- * @brief  Generic SAI logging util function
+ * @brief  Generic SAI logging util function. The log is queued to the
+ *         log thread when the asynchronous sink is enabled.
  */
 #define SAI_LOG_UTIL(MOD, LEVEL, msg, ...) \
-                     LEVEL(MOD, sai_switch_id_str_get(), msg, ##__VA_ARGS__)
+    do { \
+        if (sai_log_async_enabled ()) { \
+            sai_log_async_record (MOD, LEVEL, __FILE__, __func__, __LINE__, \
+                                  msg, ##__VA_ARGS__); \
+        } else { \
+            LEVEL(MOD, sai_switch_id_str_get(), msg, ##__VA_ARGS__); \
+        } \
+    } while (0)
 #endif /* _SAI_EVENT_LOG_H_ */
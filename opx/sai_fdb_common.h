@@ -163,7 +163,7 @@ static inline bool sai_fdb_entry_is_forwarding_action(sai_packet_action_t action
 /** Logging utility for SAI FDB API */
 #define SAI_FDB_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_FDB, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_FDB, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_FDB, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
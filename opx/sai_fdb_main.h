@@ -74,8 +74,59 @@ sai_status_t sai_l2_deregister_fdb_entry(const sai_fdb_entry_t *fdb_entry);
 void sai_l2_fdb_register_internal_callback (sai_fdb_internal_callback_fn
                                                        fdb_internal_callback);
 
+/** SAI FDB API - Create a batch of FDB entries
+      \param[in] object_count Number of FDB entries
+      \param[in] fdb_entry FDB entries to be created
+      \param[in] attr_count Attribute count of each entry
+      \param[in] attr_list Attribute list of each entry
+      \param[in] mode Stop on the first error or process all the entries
+      \param[out] object_statuses Status of each entry, SAI_STATUS_NOT_EXECUTED
+                   for the entries skipped after an error
+      \return Success: SAI_STATUS_SUCCESS if all the entries were created
+              Failure: SAI_STATUS_FAILURE, SAI_STATUS_INVALID_PARAMETER,
+                       SAI_STATUS_NO_MEMORY
+*/
+sai_status_t sai_l2_bulk_create_fdb_entry(uint32_t object_count,
+                                          const sai_fdb_entry_t *fdb_entry,
+                                          const uint32_t *attr_count,
+                                          const sai_attribute_t **attr_list,
+                                          sai_bulk_op_error_mode_t mode,
+                                          sai_status_t *object_statuses);
+
+/** SAI FDB API - Remove a batch of FDB entries
+      \param[in] object_count Number of FDB entries
+      \param[in] fdb_entry FDB entries to be removed
+      \param[in] mode Stop on the first error or process all the entries
+      \param[out] object_statuses Status of each entry
+      \return Success: SAI_STATUS_SUCCESS if all the entries were removed
+              Failure: SAI_STATUS_FAILURE, SAI_STATUS_INVALID_PARAMETER,
+                       SAI_STATUS_NO_MEMORY
+*/
+sai_status_t sai_l2_bulk_remove_fdb_entry(uint32_t object_count,
+                                          const sai_fdb_entry_t *fdb_entry,
+                                          sai_bulk_op_error_mode_t mode,
+                                          sai_status_t *object_statuses);
+
+/** SAI FDB API - Set an attribute on each of a batch of FDB entries
+      \param[in] object_count Number of FDB entries
+      \param[in] fdb_entry FDB entries to be updated
+      \param[in] attr_list One attribute per entry
+      \param[in] mode Stop on the first error or process all the entries
+      \param[out] object_statuses Status of each entry
+      \return Success: SAI_STATUS_SUCCESS if all the entries were updated
+              Failure: SAI_STATUS_FAILURE, SAI_STATUS_INVALID_PARAMETER,
+                       SAI_STATUS_NO_MEMORY
+*/
+sai_status_t sai_l2_bulk_set_fdb_entry_attribute(uint32_t object_count,
+                                                 const sai_fdb_entry_t *fdb_entry,
+                                                 const sai_attribute_t *attr_list,
+                                                 sai_bulk_op_error_mode_t mode,
+                                                 sai_status_t *object_statuses);
+
 void sai_dump_all_fdb_entry_nodes (void);
 
+void sai_dump_fdb_entry_nodes_page (uint_t start, uint_t count);
+
 void sai_dump_all_fdb_entry_count (void);
 
 void sai_dump_all_fdb_registered_nodes (void);
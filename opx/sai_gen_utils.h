@@ -62,6 +62,80 @@ typedef struct _dn_sai_id_gen_info {
  */
 sai_status_t dn_sai_get_next_free_id(dn_sai_id_gen_info_t *info);
 
+/** Levels of a dn_sai_index_pool_t, enough for 48 bit object ids */
+#define DN_SAI_INDEX_POOL_MAX_LEVELS (8)
+
+/** SAI GEN API - Pool of indices in [min_id, max_id], kept as a hierarchical
+    bitmap. Bit n of level 0 is set when index min_id + n is in use and bit n
+    of level l + 1 is set when word n of level l is full. The bitmaps double
+    as the pool fills up, so that allocating the lowest free index and freeing
+    an index take one step per level. The caller serializes the accesses. */
+typedef struct _dn_sai_index_pool {
+    /** min_id: Lowest index of the pool */
+    uint64_t min_id;
+    /** max_id: Highest index of the pool */
+    uint64_t max_id;
+    /** size: Indices covered by level 0, a multiple of 64 */
+    uint64_t size;
+    /** used: Indices in use */
+    uint64_t used;
+    /** levels: Levels of the bitmap, the top level being a single word */
+    uint_t levels;
+    /** level: Bitmap words of each level */
+    uint64_t *level[DN_SAI_INDEX_POOL_MAX_LEVELS];
+} dn_sai_index_pool_t;
+
+/** SAI GEN API - Initialize an empty index pool
+    \param[out] pool Index pool
+    \param[in] min_id Lowest index of the pool
+    \param[in] max_id Highest index of the pool
+    \return Success: SAI_STATUS_SUCCESS
+            Failure: SAI_STATUS_INVALID_PARAMETER if the range is empty or
+                     wider than 48 bits
+ */
+sai_status_t dn_sai_index_pool_init(dn_sai_index_pool_t *pool,
+                                    uint64_t min_id, uint64_t max_id);
+
+/** SAI GEN API - Release the bitmaps of an index pool, every index is free
+    \param[in,out] pool Index pool
+ */
+void dn_sai_index_pool_deinit(dn_sai_index_pool_t *pool);
+
+/** SAI GEN API - Allocate the lowest free index of an index pool
+    \param[in,out] pool Index pool
+    \param[out] index Allocated index
+    \return Success: SAI_STATUS_SUCCESS
+            Failure: SAI_STATUS_TABLE_FULL if every index is in use,
+                     SAI_STATUS_NO_MEMORY if the bitmaps cannot grow
+ */
+sai_status_t dn_sai_index_pool_alloc(dn_sai_index_pool_t *pool, uint64_t *index);
+
+/** SAI GEN API - Mark a given index of an index pool in use, as when
+    rebuilding the pool from the objects already present
+    \param[in,out] pool Index pool
+    \param[in] index Index to mark in use
+    \return Success: SAI_STATUS_SUCCESS
+            Failure: SAI_STATUS_INVALID_PARAMETER if out of the pool,
+                     SAI_STATUS_ITEM_ALREADY_EXISTS if already in use,
+                     SAI_STATUS_NO_MEMORY if the bitmaps cannot grow
+ */
+sai_status_t dn_sai_index_pool_reserve(dn_sai_index_pool_t *pool, uint64_t index);
+
+/** SAI GEN API - Return an index to an index pool
+    \param[in,out] pool Index pool
+    \param[in] index Index to free
+    \return Success: SAI_STATUS_SUCCESS
+            Failure: SAI_STATUS_ITEM_NOT_FOUND if the index is not in use
+ */
+sai_status_t dn_sai_index_pool_free(dn_sai_index_pool_t *pool, uint64_t index);
+
+/** SAI GEN API - Check if an index of an index pool is in use
+    \param[in] pool Index pool
+    \param[in] index Index
+    \return true if the index is in use, false otherwise
+ */
+bool dn_sai_index_pool_is_used(const dn_sai_index_pool_t *pool, uint64_t index);
+
 /** SAI GEN API - Get indexed attribute return type
       \param[in] ret_val Original attribute return val with index 0
       \param[in] attr_index The index of the attribute
@@ -102,6 +176,30 @@ void sai_log_level_set (sai_api_t api_id, sai_log_level_t level);
 */
 bool sai_is_log_enabled (sai_api_t api_id, sai_log_level_t level);
 
+/** Log level of each API, written by sai_log_level_set */
+extern sai_log_level_t g_sai_api_log_level [SAI_NUM_API_ID];
+extern sai_log_level_t g_sai_api_custom_log_level [SAI_NUM_API_CUSTOM_ID];
+
+/** SAI GEN API - Inline variant of sai_is_log_enabled for the module log
+    macros. Reads the per API level table directly, so that a disabled
+    level costs a load and a compare, and no argument of the log is
+    evaluated.
+      \param[in] api_id SAI API id
+      \param[in] level SAI log level
+      \return true if the level is enabled false otherwise
+*/
+static inline bool sai_is_log_enabled_fast (sai_api_t api_id,
+                                            sai_log_level_t level)
+{
+    if (api_id < SAI_NUM_API_ID) {
+        return (level >= g_sai_api_log_level [api_id]);
+    }
+    if (SAI_API_CUSTOM_CHECK(api_id)) {
+        return (level >= g_sai_api_custom_log_level [SAI_API_CUSTOM_INDEX(api_id)]);
+    }
+    return (level >= SAI_LOG_LEVEL_WARN);
+}
+
 /** SAI GEN API - To get the switch id in string format for logs
  */
 const char* sai_switch_id_str_get (void);
@@ -95,7 +95,7 @@ typedef struct _dn_sai_hash_obj_db_t {
 /** Logging utility for SAI HASH API */
 #define SAI_HASH_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_HASH, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_HASH, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_HASH, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -27,8 +27,21 @@
 #include "saihostif.h"
 #include "saitypes.h"
 #include "saistatus.h"
+#include "sai_hostif_common.h"
 
 void sai_hostif_rx_register_callback(sai_packet_event_notification_fn rx_register_fn);
 sai_status_t sai_hostif_get_default_trap_group(sai_attribute_t *attr);
+
+/*
+ * FD host interface receive path. The packets punted to the CPU are queued
+ * on every FD host interface, they are dequeued in batches once the event fd
+ * of the host interface polls readable. The event fd is cleared when a
+ * dequeue finds the queue empty.
+ */
+sai_status_t sai_hostif_packets_recv(sai_object_id_t hif_id,
+                                     dn_sai_hostif_packet_t *pkt_list,
+                                     uint_t *pkt_count);
+sai_status_t sai_hostif_event_fd_get(sai_object_id_t hif_id, int *event_fd);
+sai_status_t sai_hostif_rx_drops_get(sai_object_id_t hif_id, uint64_t *rx_drops);
 #endif
 
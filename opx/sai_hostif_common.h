@@ -39,7 +39,7 @@
 /** Logging utility for SAI Host Interface API */
 #define SAI_HOSTIF_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_HOSTIF, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_HOSTIF, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_HOSTIF, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -161,6 +161,53 @@ typedef struct _dn_sai_user_def_trap_node_t {
     sai_object_id_t     trap_group;
 } dn_sai_user_def_trap_node_t;
 
+/**
+ * @brief Host interface node key
+ */
+typedef struct _dn_sai_hostif_key_t {
+    /** Host interface object id */
+    sai_object_id_t hostif_id;
+} dn_sai_hostif_key_t;
+
+/**
+ * @brief Host interface node datastructure
+ *
+ * Contains the information related to a SAI host interface
+ */
+typedef struct _dn_sai_hostif_node_t {
+    /** Key for the host interface node */
+    dn_sai_hostif_key_t key;
+    /** Host interface type */
+    sai_hostif_type_t   type;
+    /** Port, LAG or VLAN the host interface is bound to */
+    sai_object_id_t     obj_id;
+    /** Name of the host interface netdev */
+    char                name [SAI_HOSTIF_NAME_SIZE];
+    /** Operational status of the host interface netdev */
+    bool                oper_status;
+    /** CPU queue of the host interface */
+    uint_t              queue;
+    /** NPU specific information for the host interface */
+    void               *npu_hostif_info;
+} dn_sai_hostif_node_t;
+
+/** Attributes returned with a packet received on a FD host interface */
+#define DN_SAI_HOSTIF_PKT_MAX_ATTRS (3)
+
+/**
+ * @brief Packet received on a FD host interface
+ */
+typedef struct _dn_sai_hostif_packet_t {
+    /** Buffer the packet is copied to, set by the caller */
+    void               *buffer;
+    /** Size of the buffer on input, length of the packet on output */
+    sai_size_t          buffer_size;
+    /** Number of attributes in attr_list */
+    uint_t              attr_count;
+    /** Trap id, ingress port and ingress LAG of the packet */
+    sai_attribute_t     attr_list [DN_SAI_HOSTIF_PKT_MAX_ATTRS];
+} dn_sai_hostif_packet_t;
+
 /**
  * @brief HostIf Operations
  *
@@ -38,6 +38,7 @@
 #include <string.h>
 
 #define DN_HOSTIF_MAX_TRAP_GROUPS          (128)
+#define DN_HOSTIF_MAX_HOSTIFS              (1024)
 #define DN_HOSTIF_DEFAULT_MIN_PRIO         (0)
 #define DN_HOSTIF_DEFAULT_TRAP_GROUP_ATTRS (3)
 #define DN_HOSTIF_USER_DEF_TRAP_TYPE_SHIFT (16)
@@ -72,7 +73,16 @@ typedef struct _dn_sai_hostif_user_defined_trap_attr_property_t {
     dn_sai_hostif_check_attribute_fn check_attr_func;
 } dn_sai_hostif_user_defined_trap_attr_property_t;
 
+typedef struct _dn_sai_hostif_attr_property_t {
+    sai_attr_id_t                    attr_id;
+    bool                             mandatory_in_create;
+    bool                             valid_in_create;
+    bool                             valid_in_set;
+} dn_sai_hostif_attr_property_t;
+
 typedef struct _dn_sai_hostif_info_t {
+    rbtree_handle             hostif_tree;
+    void                     *hostif_bitmap;
     rbtree_handle             trap_tree;
     rbtree_handle             trap_group_tree;
     rbtree_handle             user_def_trap_tree;
@@ -88,6 +98,7 @@ typedef struct _dn_sai_hostif_info_t {
     uint_t                    max_trap_attrs;
     uint_t                    max_user_def_trap_attrs;
     uint_t                    max_user_def_traps;
+    uint_t                    max_hostif_attrs;
 } dn_sai_hostintf_info_t;
 
 typedef struct _dn_sai_hostif_valid_traps_t {
@@ -204,6 +215,19 @@ static inline dn_sai_user_def_trap_node_t *
                                                                &temp_node);
 }
 
+static inline dn_sai_hostif_node_t *dn_sai_hostif_find_hostif(
+                                                rbtree_handle hostif_tree,
+                                                sai_object_id_t hostif_id)
+{
+    STD_ASSERT(hostif_tree != NULL);
+    dn_sai_hostif_node_t temp_node;
+
+    memset(&temp_node, 0, sizeof(dn_sai_hostif_node_t));
+    temp_node.key.hostif_id = hostif_id;
+
+    return (dn_sai_hostif_node_t *) std_rbtree_getexact(hostif_tree, &temp_node);
+}
+
 /***************Function prototypes*************************/
 void sai_hostif_lock();
 void sai_hostif_unlock();
@@ -251,6 +251,22 @@ dn_sai_ipmc_repl_group_node_t* sai_ipmc_repl_group_get_next(dn_sai_ipmc_repl_gro
 */
 sai_status_t sai_l3_mcast_init(void);
 
+/** SAI IPMC API - Init the IPMC group, RPF group and IPMC entry caches
+    and their NPU handlers
+    \return Success: SAI_STATUS_SUCCESS
+            Failure: SAI_STATUS_UNINITIALIZED
+*/
+sai_status_t sai_ipmc_init(void);
+
+/** SAI IPMC API - Refresh in the NPU the IPMC entries pointing to an IPMC
+    group or an RPF group, after a change of its members.
+    Called with the IPMC lock held, takes the L3 MCAST lock.
+    \param[in] group_id IPMC group or RPF group object id
+    \return Success: SAI_STATUS_SUCCESS
+            Failure: Error of the last entry the NPU failed to refresh
+*/
+sai_status_t sai_ipmc_group_entries_update(sai_object_id_t group_id);
+
 /** SAI L3 IPMC API - Init L3 IPMC RPF Group Module data structures
     \return Success: SAI_STATUS_SUCCESS
             Failure: SAI_STATUS_UNINITIALIZED
@@ -137,7 +137,7 @@ typedef struct _dn_sai_ipmc_repl_group_node_t {
 /** Logging utility for SAI IPMC API */
 #define SAI_IPMC_LOG(module, level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (module, level)) { \
+        if (sai_is_log_enabled_fast (module, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_IPMC, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -78,7 +78,7 @@ typedef struct _dn_sai_l2mc_group_node_t {
 /** Logging utility for SAI L2MC API */
 #define SAI_L2MC_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_L2MC, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_L2MC, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_L2MC, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
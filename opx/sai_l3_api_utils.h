@@ -26,6 +26,7 @@
 
 #include "saiswitch.h"
 #include "sairouterinterface.h"
+#include "saineighbor.h"
 #include "saitypes.h"
 #include "saistatus.h"
 #include "std_struct_utils.h"
@@ -58,6 +59,15 @@
  * Route functionality related macros.
  */
 #define SAI_FIB_ROUTE_MAX_ATTR_COUNT       (4)
+
+/*
+ * Underlay neighbor of the tunnel encap next hops affected by a bulk
+ * neighbor create or remove.
+ */
+typedef struct _sai_fib_neighbor_dep_key_t {
+    sai_object_id_t   vrf_id;
+    sai_ip_address_t  ip_addr;
+} sai_fib_neighbor_dep_key_t;
 #define SAI_FIB_ROUTE_DFLT_PKT_ACTION      (SAI_PACKET_ACTION_FORWARD)
 #define SAI_FIB_ROUTE_DFLT_TRAP_PRIO       (0)
 
@@ -196,6 +206,9 @@ void sai_fib_route_attr_set_affected_encap_nh_update (
                                            sai_fib_route_t *p_new_route_info);
 void sai_fib_neighbor_affected_encap_nh_resolve (sai_fib_nh_t *p_neighbor,
                                                  dn_sai_operations_t op_type);
+void sai_fib_neighbor_list_affected_encap_nh_resolve (
+                                      sai_fib_neighbor_dep_key_t *p_key_list,
+                                      uint_t key_count);
 void sai_fib_neighbor_dep_encap_nh_list_update (sai_fib_nh_t *p_neighbor,
                                                 sai_fib_nh_t *p_attr_info,
                                                 uint_t attr_flags);
@@ -221,10 +234,45 @@ void sai_fib_dump_rif (sai_object_id_t rif_id);
 
 void sai_fib_dump_all_rif_in_vr (sai_object_id_t vr_id);
 
+/*
+ * Bulk neighbor and next hop APIs. A batch is applied under one hold of the
+ * FIB lock and the encap next hops depending on the neighbors are resolved
+ * once per batch.
+ */
+sai_status_t sai_fib_neighbor_bulk_create (
+                                    uint32_t object_count,
+                                    const sai_neighbor_entry_t *neighbor_entry,
+                                    const uint32_t *attr_count,
+                                    const sai_attribute_t **attr_list,
+                                    sai_bulk_op_error_mode_t mode,
+                                    sai_status_t *object_statuses);
+
+sai_status_t sai_fib_neighbor_bulk_remove (
+                                    uint32_t object_count,
+                                    const sai_neighbor_entry_t *neighbor_entry,
+                                    sai_bulk_op_error_mode_t mode,
+                                    sai_status_t *object_statuses);
+
+sai_status_t sai_fib_next_hop_bulk_create (sai_object_id_t switch_id,
+                                           uint32_t object_count,
+                                           const uint32_t *attr_count,
+                                           const sai_attribute_t **attr_list,
+                                           sai_bulk_op_error_mode_t mode,
+                                           sai_object_id_t *object_id,
+                                           sai_status_t *object_statuses);
+
+sai_status_t sai_fib_next_hop_bulk_remove (uint32_t object_count,
+                                           const sai_object_id_t *object_id,
+                                           sai_bulk_op_error_mode_t mode,
+                                           sai_status_t *object_statuses);
+
 void sai_fib_dump_all_rif (void);
 
 void sai_fib_dump_all_route_in_vr (sai_object_id_t vrf);
 
+void sai_fib_dump_route_page_in_vr (sai_object_id_t vrf, sai_object_id_t nh_id,
+                                    uint_t start, uint_t count);
+
 void sai_fib_dump_nh (sai_object_id_t nh_id);
 
 void sai_fib_dump_all_nh (void);
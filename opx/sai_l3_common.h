@@ -36,6 +36,7 @@
 #include "sairoute.h"
 #include "saiswitch.h"
 #include "saitunnel.h"
+#include "sai_l3_lpm.h"
 
 /**
  * @brief SAI L3 data structure for the global parameters
@@ -108,6 +109,9 @@ typedef struct _sai_fib_vrf_t {
     /** Dummy Marker node to be passsed for the route tree radical walk */
     std_radical_ref_t  route_marker;
 
+    /** Compiled LPM table mirroring the route tree, for lock free lookups */
+    sai_fib_lpm_t     *route_lpm;
+
     /** Place holder for NPU-specific data */
     void            *hw_info;
 } sai_fib_vrf_t;
@@ -387,6 +391,9 @@ typedef struct _sai_fib_route_t {
     /** Route Meta Data */
     uint_t                     meta_data;
 
+    /** Leaf of the route in the VRF LPM table */
+    uint_t                     lpm_leaf;
+
     /** List of Encap Next Hops that depends on this route. */
     std_dll_head               dep_encap_nh_list;
 
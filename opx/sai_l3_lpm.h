@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_l3_lpm.h
+ *
+ * @brief This file contains the data structures and APIs of the compiled
+ *        longest prefix match table mirroring the route tree of a VRF.
+ *
+ * IPv4 uses a DIR-24-8 layout: a 2^24 entry root table indexed by the top
+ * 24 address bits and 256 entry groups for the prefixes longer than /24.
+ * IPv6 uses the same multibit trie with a 16 bit root stride and 8 bit
+ * strides below it.
+ *
+ * An IPv6 lookup is thus not O(1): it reads 1 + (len - 16) / 8 table
+ * entries for a match of length len, 5 for a /48, 7 for a /64 and 15 for a
+ * /128, plus the leaf. 16 bit strides would halve that, but each group
+ * below the root would take 256 KB instead of 1 KB: 10,000 random /32 to
+ * /128 prefixes take about 42,000 groups (43 MB) with 8 bit strides, and
+ * would take about 21,600 groups (5.7 GB) with 16 bit strides.
+ *
+ * Updates are serialized by the caller (FIB lock). Lookups take no lock
+ * and can run concurrently with updates; a freed group or leaf is reused
+ * only once the lookups that started before it was freed are done. An
+ * update never waits for them, it takes a never used group or leaf instead.
+ */
+
+#ifndef __SAI_L3_LPM_H__
+#define __SAI_L3_LPM_H__
+
+#include "saitypes.h"
+#include "saistatus.h"
+#include "std_type_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Root table stride of the IPv4 table */
+#define SAI_FIB_LPM_IPV4_ROOT_BITS       (24)
+
+/** Root table stride of the IPv6 table */
+#define SAI_FIB_LPM_IPV6_ROOT_BITS       (16)
+
+/** Stride of the tables below the root */
+#define SAI_FIB_LPM_GROUP_BITS           (8)
+#define SAI_FIB_LPM_GROUP_SIZE           (1 << SAI_FIB_LPM_GROUP_BITS)
+
+/** Groups are allocated in chunks so that lookups never see a reallocation */
+#define SAI_FIB_LPM_GROUPS_PER_CHUNK     (1024)
+#define SAI_FIB_LPM_MAX_GROUP_CHUNKS     (1024)
+
+/** Leaves are allocated in chunks, leaf 0 is reserved for "no route" */
+#define SAI_FIB_LPM_LEAVES_PER_CHUNK     (16384)
+#define SAI_FIB_LPM_MAX_LEAF_CHUNKS      (1024)
+
+/** Leaf value meaning the prefix is not compiled in the table */
+#define SAI_FIB_LPM_LEAF_NONE            (0)
+
+/** Opaque per VRF LPM table */
+typedef struct _sai_fib_lpm_t sai_fib_lpm_t;
+
+/**
+ * @brief Forwarding result of a prefix, as returned by a lookup.
+ */
+typedef struct _sai_fib_lpm_nh_t {
+    /** Route packet action */
+    sai_packet_action_t packet_action;
+
+    /** SAI_OBJECT_TYPE_NEXT_HOP/NEXT_HOP_GROUP or SAI_FIB_ROUTE_NH_TYPE_NONE */
+    uint_t              nh_type;
+
+    /** Next hop or next hop group id */
+    sai_object_id_t     nh_id;
+
+    /** Length of the matched prefix, filled in by the lookup */
+    uint_t              prefix_len;
+} sai_fib_lpm_nh_t;
+
+/**
+ * @brief Usage counters of an LPM table.
+ */
+typedef struct _sai_fib_lpm_stats_t {
+    uint_t  leaf_count;
+    uint_t  ipv4_group_count;
+    uint_t  ipv6_group_count;
+    /** Bytes allocated for the tables, root tables are lazily backed */
+    size_t  mem_bytes;
+} sai_fib_lpm_stats_t;
+
+/**
+ * @brief Allocate an empty LPM table.
+ *
+ * @return LPM table or NULL on allocation failure
+ */
+sai_fib_lpm_t *sai_fib_lpm_create (void);
+
+/**
+ * @brief Free an LPM table; no lookup may be in progress.
+ *
+ * @param[in] p_lpm LPM table
+ */
+void sai_fib_lpm_destroy (sai_fib_lpm_t *p_lpm);
+
+/**
+ * @brief Compile a prefix in the table.
+ *
+ * @param[in] p_lpm LPM table
+ * @param[in] p_prefix Prefix, IPv4 in Network Byte Order
+ * @param[in] prefix_len Prefix length
+ * @param[in] p_nh Forwarding result of the prefix
+ * @param[out] p_leaf Leaf to pass to the update and remove APIs
+ * @return SAI_STATUS_SUCCESS on success, SAI_STATUS_NO_MEMORY otherwise
+ */
+sai_status_t sai_fib_lpm_prefix_add (sai_fib_lpm_t *p_lpm,
+                                     const sai_ip_address_t *p_prefix,
+                                     uint_t prefix_len,
+                                     const sai_fib_lpm_nh_t *p_nh,
+                                     uint_t *p_leaf);
+
+/**
+ * @brief Update the forwarding result of a compiled prefix in place.
+ *
+ * @param[in] p_lpm LPM table
+ * @param[in] leaf Leaf returned by sai_fib_lpm_prefix_add
+ * @param[in] p_nh New forwarding result
+ */
+void sai_fib_lpm_prefix_update (sai_fib_lpm_t *p_lpm, uint_t leaf,
+                                const sai_fib_lpm_nh_t *p_nh);
+
+/**
+ * @brief Remove a compiled prefix, its addresses fall back to the covering
+ *        prefix.
+ *
+ * @param[in] p_lpm LPM table
+ * @param[in] p_prefix Prefix, IPv4 in Network Byte Order
+ * @param[in] prefix_len Prefix length
+ * @param[in] leaf Leaf returned by sai_fib_lpm_prefix_add
+ * @param[in] cover_leaf Leaf of the next less specific prefix or
+ *            SAI_FIB_LPM_LEAF_NONE
+ * @param[in] cover_len Length of the next less specific prefix
+ */
+void sai_fib_lpm_prefix_remove (sai_fib_lpm_t *p_lpm,
+                                const sai_ip_address_t *p_prefix,
+                                uint_t prefix_len, uint_t leaf,
+                                uint_t cover_leaf, uint_t cover_len);
+
+/**
+ * @brief Longest prefix match lookup; lock free.
+ *
+ * @param[in] p_lpm LPM table
+ * @param[in] p_addr Address, IPv4 in Network Byte Order
+ * @param[out] p_nh Forwarding result of the longest matching prefix
+ * @return true if a prefix matched, false otherwise
+ */
+bool sai_fib_lpm_lookup (const sai_fib_lpm_t *p_lpm,
+                         const sai_ip_address_t *p_addr,
+                         sai_fib_lpm_nh_t *p_nh);
+
+/**
+ * @brief Get the usage counters of an LPM table.
+ *
+ * @param[in] p_lpm LPM table
+ * @param[out] p_stats Usage counters
+ */
+void sai_fib_lpm_stats_get (const sai_fib_lpm_t *p_lpm,
+                            sai_fib_lpm_stats_t *p_stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SAI_L3_LPM_H__ */
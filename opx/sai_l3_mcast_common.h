@@ -81,7 +81,7 @@ typedef struct _dn_sai_l3_mcast_global_data_t {
 /** Logging utility for SAI MCAST API */
 #define SAI_L3_MCAST_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_IPMC, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_IPMC, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_IPMC, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -168,7 +168,7 @@
 /** Logging utility for SAI Virtual Router API */
 #define SAI_ROUTER_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_VIRTUAL_ROUTER, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_VIRTUAL_ROUTER, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_ROUTER, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -176,7 +176,7 @@
 /** Logging utility for SAI Router Interface API */
 #define SAI_RIF_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_ROUTER_INTERFACE, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_ROUTER_INTERFACE, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_ROUTER_INTF, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -184,7 +184,7 @@
 /** Logging utility for SAI Next Hop API */
 #define SAI_NEXTHOP_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_NEXT_HOP, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_NEXT_HOP, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_NEXT_HOP, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -192,7 +192,7 @@
 /** Logging utility for SAI Neighbor API */
 #define SAI_NEIGHBOR_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_NEIGHBOR, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_NEIGHBOR, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_NEIGHBOR, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -200,7 +200,7 @@
 /** Logging utility for SAI Next Hop Group API */
 #define SAI_NH_GROUP_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_NEXT_HOP_GROUP, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_NEXT_HOP_GROUP, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_NEXT_HOP_GROUP, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -208,7 +208,7 @@
 /** Logging utility for SAI Route API */
 #define SAI_ROUTE_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (ev_log_t_SAI_ROUTE, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_ROUTE, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_ROUTER, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -711,15 +711,27 @@ bool sai_fib_is_ip_addr_in_prefix (sai_ip_address_t *p_prefix,
                                    sai_ip_address_t *p_ip_address);
 
 /**
- * @brief Utility to take simple mutex lock for FIB resources access.
+ * @brief Utility to take the FIB resources lock for writing.
  */
 void sai_fib_lock (void);
 
 /**
- * @brief Utility to release simple mutex lock for FIB resources access.
+ * @brief Utility to release the FIB resources lock taken for writing.
  */
 void sai_fib_unlock (void);
 
+/**
+ * @brief Utility to take the FIB resources lock for reading. Readers run
+ *        concurrently with each other. Must not be taken again, nor for
+ *        writing, by the holder.
+ */
+void sai_fib_read_lock (void);
+
+/**
+ * @brief Utility to release the FIB resources lock taken for reading.
+ */
+void sai_fib_read_unlock (void);
+
 /**
  * @brief Utility to check is_init_complete flag for SAI L3 component.
  *
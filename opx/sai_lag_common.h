@@ -104,7 +104,7 @@ typedef struct _sai_lag_node_t {
 /** Logging utility for SAI LAG API */
 #define SAI_LAG_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_LAG, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_LAG, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_LAG, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
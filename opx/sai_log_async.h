@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_log_async.h
+ *
+ * @brief This file contains the APIs of the asynchronous SAI log sink.
+ *
+ *        When enabled, SAI_LOG_UTIL does not format the log in the calling
+ *        thread. It stores the format pointer and the arguments in a record
+ *        of a ring owned by the calling thread, without taking a lock, and
+ *        a log thread formats and emits the records. A log finding the
+ *        ring of its thread full is dropped and counted.
+ *
+ *        The format of a log must be a string literal. String arguments
+ *        are copied into the record, truncated to the space left in it.
+ */
+
+#ifndef __SAI_LOG_ASYNC_H__
+#define __SAI_LOG_ASYNC_H__
+
+#include "saitypes.h"
+#include "saistatus.h"
+#include "std_type_defs.h"
+
+#include <stdint.h>
+
+/* Environment variable enabling the asynchronous sink at log init */
+#define SAI_LOG_ASYNC_ENV          "SAI_LOG_ASYNC"
+
+/* Records of the ring of a thread, a power of 2 */
+#define SAI_LOG_ASYNC_RING_SIZE    (1024)
+
+/* Arguments of a record, '*' widths and precisions included */
+#define SAI_LOG_ASYNC_MAX_ARGS     (12)
+
+/* Bytes of a record holding the copied string arguments */
+#define SAI_LOG_ASYNC_STR_BUF_LEN  (160)
+
+/* Longest log emitted by the log thread */
+#define SAI_LOG_ASYNC_MSG_LEN      (1024)
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/** Set while the asynchronous sink is enabled */
+extern bool g_sai_log_async_enabled;
+
+/**
+ * @brief Whether the logs go to the asynchronous sink.
+ * @return true if enabled, false otherwise
+ */
+static inline bool sai_log_async_enabled (void)
+{
+    return __atomic_load_n (&g_sai_log_async_enabled, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Queue a log on the ring of the calling thread.
+ * @param[in] module Event log module of the log
+ * @param[in] level SAI log level of the log
+ * @param[in] file Source file of the log call, a string literal
+ * @param[in] func Function of the log call
+ * @param[in] line Source line of the log call
+ * @param[in] fmt printf format of the log, a string literal
+ */
+void sai_log_async_record (int module, sai_log_level_t level,
+                           const char *file, const char *func, int line,
+                           const char *fmt, ...);
+
+/**
+ * @brief Emit a formatted log at the location of its log call, for logs
+ *        emitted away from it.
+ * @param[in] module Event log module of the log
+ * @param[in] level SAI log level of the log
+ * @param[in] file Source file of the log call
+ * @param[in] func Function of the log call
+ * @param[in] line Source line of the log call
+ * @param[in] msg Text of the log
+ */
+void sai_log_emit_at (int module, sai_log_level_t level, const char *file,
+                      const char *func, int line, const char *msg);
+
+/**
+ * @brief Enable or disable the asynchronous sink. The log thread is
+ *        started on the first enable, and drains the queued logs after a
+ *        disable.
+ * @param[in] enable true to enable
+ * @return SAI_STATUS_SUCCESS on success, error otherwise
+ */
+sai_status_t sai_log_async_enable (bool enable);
+
+/**
+ * @brief Wait until the log thread has emitted the logs queued so far.
+ * @param[in] timeout_msec Longest wait
+ * @return true if the rings are empty, false on timeout
+ */
+bool sai_log_async_flush (uint_t timeout_msec);
+
+/**
+ * @brief Logs dropped on full rings, since start.
+ * @return Dropped log count
+ */
+uint64_t sai_log_async_drops_get (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SAI_LOG_ASYNC_H__ */
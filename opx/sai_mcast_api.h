@@ -54,5 +54,10 @@ dn_sai_mcast_entry_node_t * sai_find_mcast_entry(dn_sai_mcast_entry_node_t *entr
     \return Success: SAI_STATUS_SUCCESS
 */
 sai_status_t sai_remove_mcast_entry_node(dn_sai_mcast_entry_node_t *mcast_entry_node);
+/** SAI MCAST API - Get the multicast entry following a key in the cache
+    \param[in] mcast_key MCAST entry key, all zero for the first entry
+    \return A Valid pointer to the next mcast entry node in the cache else NULL
+*/
+dn_sai_mcast_entry_node_t * sai_get_next_mcast_entry(const dn_sai_mcast_entry_key_t *mcast_key);
 
 #endif
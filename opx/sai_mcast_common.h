@@ -92,7 +92,7 @@ typedef struct _dn_sai_mcast_global_data_t {
 /** Logging utility for SAI MCAST API */
 #define SAI_MCAST_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_L2MC, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_L2MC, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_MCAST, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
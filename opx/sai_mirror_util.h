@@ -34,7 +34,7 @@
 /** Logging utility for SAI Mirror API */
 #define SAI_MIRROR_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_MIRROR, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_MIRROR, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_MIRROR, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -69,4 +69,6 @@ void sai_tunnel_deinit (void);
 
 sai_status_t sai_l2mc_init (void);
 
+sai_status_t sai_ipmc_init (void);
+
 #endif
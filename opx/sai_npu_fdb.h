@@ -200,6 +200,35 @@ Failure: SAI_STATUS_NOT_SUPPORTED
  */
 typedef sai_status_t (*sai_npu_mcast_cpu_flood_enable_get_fn)(bool *enable);
 
+/** SAI NPU FDB - Create a batch of FDB entries
+  \param[in] count Number of FDB entries
+  \param[in] fdb_entry_list FDB entries which have members MAC address and VLAN
+  \param[in] fdb_entry_node_list Data related to each FDB entry such as port, type, action, etc.
+  \return Success: SAI_STATUS_SUCCESS if all the entries were created
+Failure: SAI_STATUS_FAILURE, the caller retries the entries one at a time
+ */
+typedef sai_status_t (*sai_npu_create_fdb_entries_fn)(uint_t count,
+                                                      const sai_fdb_entry_t *fdb_entry_list,
+                                                      const sai_fdb_entry_node_t *fdb_entry_node_list);
+
+/** SAI NPU FDB - Flush a batch of FDB entries
+  \param[in] count Number of FDB entries
+  \param[in] fdb_entry_list FDB entries which have members MAC address and VLAN
+  \return Success: SAI_STATUS_SUCCESS if all the entries were flushed
+Failure: SAI_STATUS_FAILURE, the caller retries the entries one at a time
+ */
+typedef sai_status_t (*sai_npu_flush_fdb_entries_fn)(uint_t count,
+                                                     const sai_fdb_entry_t *fdb_entry_list);
+
+/** SAI NPU FDB - Write a batch of FDB entries to hardware
+  \param[in] count Number of FDB entries
+  \param[in] fdb_entry_node_list FDB entry nodes which have FDB key, type, action and port
+  \return Success: SAI_STATUS_SUCCESS if all the entries were written
+Failure: SAI_STATUS_FAILURE, the caller retries the entries one at a time
+ */
+typedef sai_status_t (*sai_npu_write_fdb_entries_to_hardware_fn)(uint_t count,
+                                                                 sai_fdb_entry_node_t *const *fdb_entry_node_list);
+
 /** SAI FDB API - Register internal flush callback
     \param[in] flush_fdb_entry Function pointer to flush callback function
 */
@@ -231,6 +260,9 @@ typedef struct _sai_npu_fdb_api_t {
     sai_npu_mcast_cpu_flood_enable_set_fn          mcast_cpu_flood_enable_set;
     sai_npu_bcast_cpu_flood_enable_get_fn          bcast_cpu_flood_enable_get;
     sai_npu_mcast_cpu_flood_enable_get_fn          mcast_cpu_flood_enable_get;
+    sai_npu_create_fdb_entries_fn                  create_fdb_entries;
+    sai_npu_flush_fdb_entries_fn                   flush_fdb_entries;
+    sai_npu_write_fdb_entries_to_hardware_fn       write_fdb_entries_to_hardware;
 
 } sai_npu_fdb_api_t;
 
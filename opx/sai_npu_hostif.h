@@ -154,6 +154,61 @@ typedef uint32_t (*sai_npu_hostif_get_max_user_def_traps)(void);
  * @return Maximum number of user defined traps supported
  */
 
+/**
+ * @brief Create the NPU resources backing a host interface
+ *
+ * @param[inout] hostif_node Host interface node, npu_hostif_info is filled in
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+typedef sai_status_t (*sai_npu_hostif_create_fn)(dn_sai_hostif_node_t *hostif_node);
+
+/**
+ * @brief Remove the NPU resources backing a host interface
+ *
+ * @param[in] hostif_node Host interface node
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+typedef sai_status_t (*sai_npu_hostif_remove_fn)(dn_sai_hostif_node_t *hostif_node);
+
+/**
+ * @brief Apply a host interface attribute at NPU
+ *
+ * @param[in] hostif_node Host interface node, still holding the old value
+ * @param[in] attr Attribute to be set
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+typedef sai_status_t (*sai_npu_hostif_set_fn)(dn_sai_hostif_node_t *hostif_node,
+                                              const sai_attribute_t *attr);
+
+/**
+ * @brief Dequeue the packets received on a FD host interface
+ *
+ * @param[in] hif_id FD host interface
+ * @param[inout] pkt_list Packets, buffer and buffer_size are set by the caller
+ * @param[inout] pkt_count Size of pkt_list on input, packets dequeued on output
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+typedef sai_status_t (*sai_npu_hostif_recv_fn)(sai_object_id_t hif_id,
+                                               dn_sai_hostif_packet_t *pkt_list,
+                                               uint_t *pkt_count);
+
+/**
+ * @brief Get the event fd and the drop counter of a FD host interface
+ *
+ * @param[in] hif_id FD host interface
+ * @param[out] event_fd Event fd, readable while packets are queued
+ * @param[out] rx_drops Packets dropped on a full queue
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise a different
+ *  error code is returned.
+ */
+typedef sai_status_t (*sai_npu_hostif_fd_info_get_fn)(sai_object_id_t hif_id,
+                                                      int *event_fd,
+                                                      uint64_t *rx_drops);
+
 /**
  * @brief HOSTIF NPU API table.
  */
@@ -169,6 +224,11 @@ typedef struct _sai_npu_hostif_api_t {
     sai_npu_hostif_debug_set_fn            npu_debug_set;
     sai_npu_hosif_rx_errors_get_fn         rx_errors_get;
     sai_npu_hostif_get_max_user_def_traps  npu_get_max_user_def_traps;
+    sai_npu_hostif_create_fn               npu_hostif_create;
+    sai_npu_hostif_remove_fn               npu_hostif_remove;
+    sai_npu_hostif_set_fn                  npu_hostif_set;
+    sai_npu_hostif_recv_fn                 npu_hostif_recv;
+    sai_npu_hostif_fd_info_get_fn          npu_hostif_fd_info_get;
 }sai_npu_hostif_api_t;
 /**
  * @}
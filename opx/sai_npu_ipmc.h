@@ -121,6 +121,45 @@ typedef sai_status_t (*sai_npu_ipmc_rpf_group_member_port_remove_fn)(
  */
 typedef void (*sai_npu_ipmc_rpf_group_member_dump_hw_info_fn)(const void *hw_info);
 
+/** SAI NPU IPMC - Creates an IPMC group
+  \param[inout]  ipmc_group_node IPMC group info
+  \param[out] ipmc_group_node SAI IPMC group uoid
+  \return Success: SAI_STATUS_SUCCESS
+Failure: SAI_STATUS_FAILURE
+ */
+typedef sai_status_t (*sai_npu_ipmc_group_create_fn)(
+        dn_sai_ipmc_group_node_t *ipmc_group_node);
+
+/** SAI NPU IPMC - Delete an IPMC group
+  \param[in] ipmc_group_node IPMC group info
+  \return Success: SAI_STATUS_SUCCESS
+Failure: SAI_STATUS_FAILURE
+ */
+typedef sai_status_t (*sai_npu_ipmc_group_delete_fn)(
+        dn_sai_ipmc_group_node_t *ipmc_group_node);
+
+/** SAI NPU IPMC - Add L3 Router Interface to IPMC Group, as an output interface
+  of the IPMC entries pointing to the group
+  \param[in]  ipmc_group_node IPMC Group info
+  \param[inout]  ipmc_group_member_node IPMC Group member info
+  \param[out] ipmc_group_member_node SAI IPMC Group member uoid
+  \return Success: SAI_STATUS_SUCCESS
+Failure: SAI_STATUS_FAILURE
+ */
+typedef sai_status_t (*sai_npu_ipmc_group_member_create_fn)(
+        dn_sai_ipmc_group_node_t *ipmc_group_node,
+        dn_sai_ipmc_group_member_node_t *ipmc_group_member_node);
+
+/** SAI NPU IPMC - Remove L3 Router Interface from IPMC Group
+  \param[in]  ipmc_group_node IPMC Group info
+  \param[in]  ipmc_group_member_node IPMC Group member info
+  \return Success: SAI_STATUS_SUCCESS
+Failure: SAI_STATUS_FAILURE
+ */
+typedef sai_status_t (*sai_npu_ipmc_group_member_remove_fn)(
+        dn_sai_ipmc_group_node_t *ipmc_group_node,
+        dn_sai_ipmc_group_member_node_t *ipmc_group_member_node);
+
 /**
  * @brief L3 IPMC NPU API table.
  */
@@ -136,6 +175,10 @@ typedef struct _sai_npu_l3_ipmc_api_t {
     sai_npu_ipmc_rpf_group_member_port_add_fn ipmc_rpf_group_member_port_add;
     sai_npu_ipmc_rpf_group_member_port_remove_fn ipmc_rpf_group_member_port_remove;
     sai_npu_ipmc_rpf_group_member_dump_hw_info_fn  ipmc_rpf_group_member_dump_hw_info;
+    sai_npu_ipmc_group_create_fn              ipmc_group_create;
+    sai_npu_ipmc_group_delete_fn              ipmc_group_remove;
+    sai_npu_ipmc_group_member_create_fn       ipmc_group_member_create;
+    sai_npu_ipmc_group_member_remove_fn       ipmc_group_member_remove;
 } sai_npu_l3_ipmc_api_t;
 
 #endif
@@ -405,6 +405,24 @@ typedef sai_status_t (*sai_npu_qos_port_map_set_fn)(sai_object_id_t port_id,
                                       sai_qos_map_type_t map_type,
                                       bool map_set);
 
+/**
+ * @brief Push the entries of a map changed by a map attribute set to a port
+ * the map is bound to. Called without the Qos lock; the changed entries are
+ * applied at once, and a delta older than the map values the port holds is
+ * ignored.
+ *
+ * @param[in] port_id port object id on which map is applied
+ * @param[in] map_id map object id applied to port
+ * @param[in] map_type Type of the map applied on port.
+ * @param[in] p_delta Changed entries and the map generation holding them
+ * @return SAI_STATUS_SUCCESS if operation is successful otherwise
+ * a different error code is returned.
+ */
+typedef sai_status_t (*sai_npu_qos_port_map_delta_set_fn)(sai_object_id_t port_id,
+                                      sai_object_id_t map_id,
+                                      sai_qos_map_type_t map_type,
+                                      const dn_sai_qos_map_delta_t *p_delta);
+
 /**
  * @brief Function to determine whether the map is hwobject or not
  *
@@ -878,6 +896,7 @@ typedef struct _sai_npu_qos_map_api_t {
     sai_npu_qos_map_is_hw_object_fn        map_is_hw_object;
     sai_npu_qos_is_map_type_supported_fn   is_map_supported;
     sai_npu_attribute_table_get_fn         attribute_table_get;
+    sai_npu_qos_port_map_delta_set_fn      port_map_delta_set;
 
 } sai_npu_qos_map_api_t;
 
@@ -177,6 +177,22 @@ typedef sai_status_t (*sai_npu_stp_port_lag_handler_fn)(const dn_sai_stp_port_in
                                                         uint_t port_cnt,
                                                         sai_object_id_t *port_list, bool is_add);
 
+/**
+ * @brief Set the stp state of a batch of ports
+ * @param[in] count Number of stp port states
+ * @param[in] stp_inst_list STP instance Id of each port
+ * @param[in] port_list Bridge port of each state
+ * @param[in] state_list Stp state of each port
+ * @param[out] status_list Per port status of the state set
+ * @return SAI_STATUS_SUCCESS if all the stp port states are set otherwise
+ * appropriate sai error code would be returned
+ */
+typedef sai_status_t (*sai_npu_stp_port_state_bulk_set_fn) (uint32_t count,
+                                                            const sai_object_id_t *stp_inst_list,
+                                                            const sai_object_id_t *port_list,
+                                                            const sai_stp_port_state_t *state_list,
+                                                            sai_status_t *status_list);
+
 /**
  * @brief STP NPU API table.
  */
@@ -193,6 +209,7 @@ typedef struct _sai_npu_stp_api_t {
     sai_npu_vlan_stp_get_fn              vlan_stp_get;
     sai_npu_stp_port_notif_handler_fn    stp_port_notif_handler;
     sai_npu_stp_port_lag_handler_fn      stp_port_lag_handler;
+    sai_npu_stp_port_state_bulk_set_fn   port_state_bulk_set;
 } sai_npu_stp_api_t;
 
 /**
@@ -285,6 +285,17 @@ static inline bool sai_is_obj_id_stp_instance (sai_object_id_t uoid)
     return (sai_uoid_obj_type_get (uoid) == SAI_OBJECT_TYPE_STP);
 }
 
+/**
+ * @brief Check if the SAI object id is hostif object id.
+ *
+ * @param[in] uoid SAI unified object id.
+ * @return true if hostif object id else false is returned.
+ */
+static inline bool sai_is_obj_id_hostif (sai_object_id_t uoid)
+{
+    return (sai_uoid_obj_type_get (uoid) == SAI_OBJECT_TYPE_HOSTIF);
+}
+
 /**
  * @brief Check if the SAI object id is hostif trap group object id.
  *
@@ -539,6 +550,50 @@ static inline bool sai_is_obj_id_l2mc_member(sai_object_id_t uoid)
     return (sai_uoid_obj_type_get (uoid) == SAI_OBJECT_TYPE_L2MC_GROUP_MEMBER);
 }
 
+/**
+ * @brief Check if the SAI object id is IPMC Group object id.
+ *
+ * @param[in] uoid SAI unified object id.
+ * @return true if IPMC Group object id else false is returned.
+ */
+static inline bool sai_is_obj_id_ipmc_group(sai_object_id_t uoid)
+{
+    return (sai_uoid_obj_type_get (uoid) == SAI_OBJECT_TYPE_IPMC_GROUP);
+}
+
+/**
+ * @brief Check if the SAI object id is IPMC Group Member object id.
+ *
+ * @param[in] uoid SAI unified object id.
+ * @return true if IPMC Group Member object id else false is returned.
+ */
+static inline bool sai_is_obj_id_ipmc_group_member(sai_object_id_t uoid)
+{
+    return (sai_uoid_obj_type_get (uoid) == SAI_OBJECT_TYPE_IPMC_GROUP_MEMBER);
+}
+
+/**
+ * @brief Check if the SAI object id is RPF Group object id.
+ *
+ * @param[in] uoid SAI unified object id.
+ * @return true if RPF Group object id else false is returned.
+ */
+static inline bool sai_is_obj_id_rpf_group(sai_object_id_t uoid)
+{
+    return (sai_uoid_obj_type_get (uoid) == SAI_OBJECT_TYPE_RPF_GROUP);
+}
+
+/**
+ * @brief Check if the SAI object id is RPF Group Member object id.
+ *
+ * @param[in] uoid SAI unified object id.
+ * @return true if RPF Group Member object id else false is returned.
+ */
+static inline bool sai_is_obj_id_rpf_group_member(sai_object_id_t uoid)
+{
+    return (sai_uoid_obj_type_get (uoid) == SAI_OBJECT_TYPE_RPF_GROUP_MEMBER);
+}
+
 /**
  * @brief Check if the SAI object id is Port Pool object id.
  *
@@ -55,7 +55,7 @@
 /** Logging utility for SAI Virtual Router API */
 #define SAI_PORT_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_PORT, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_PORT, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_PORT, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -42,6 +42,10 @@
 #define SAI_QOS_POLICER_TYPE_INVALID              (-1)
 #define SAI_QOS_WRED_MAX_ATTR_COUNT               (14)
 
+/* Environment variable, 0 to build the QoS state of all the ports at switch
+ * init rather than deferring the front panel ports to a builder thread */
+#define SAI_QOS_PORT_INIT_DEFER_ENV               "SAI_QOS_PORT_INIT_DEFER"
+
 sai_status_t sai_qos_port_all_init (void);
 
 sai_status_t sai_qos_port_all_deinit (void);
@@ -118,6 +122,22 @@ sai_status_t sai_qos_map_process_port_set (sai_object_id_t port_id,
 
 sai_status_t sai_qos_map_port_list_update(dn_sai_qos_map_t *p_map);
 
+sai_status_t sai_qos_map_delta_get(const sai_qos_map_list_t *p_old_list,
+                                   const dn_sai_qos_map_t *p_map,
+                                   dn_sai_qos_map_delta_t *p_delta);
+
+void sai_qos_map_delta_free(dn_sai_qos_map_delta_t *p_delta);
+
+sai_status_t sai_qos_map_port_ids_get(dn_sai_qos_map_t *p_map,
+                                      sai_object_id_t **p_port_list,
+                                      uint_t *p_port_count);
+
+void sai_qos_map_port_list_delta_update(sai_object_id_t map_id,
+                                        sai_qos_map_type_t map_type,
+                                        const dn_sai_qos_map_delta_t *p_delta,
+                                        const sai_object_id_t *p_port_list,
+                                        uint_t port_count);
+
 sai_status_t sai_qos_port_scheduler_set (sai_object_id_t port_id,
                                          const sai_attribute_t *p_attr);
 
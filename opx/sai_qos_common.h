@@ -313,8 +313,34 @@ typedef struct _dn_sai_qos_map_t
     /** Port list head. Nodes of type dn_sai_qos_port_t */
     std_dll_head               port_dll_head;
 
+    /** Bumped, under the Qos lock, on every change of map_to_value */
+    uint64_t                   generation;
+
 } dn_sai_qos_map_t;
 
+/**
+ * @brief SAI Qos map delta Data Structure
+ *
+ * Contains the entries of a map value list changed by a map attribute set,
+ * pushed to the ports the map is bound to without the Qos lock.
+ */
+
+typedef struct _dn_sai_qos_map_delta_t
+{
+    /** Map generation holding the changed entries */
+    uint64_t                   generation;
+
+    /** Number of changed entries */
+    uint_t                     count;
+
+    /** Position of each changed entry in the map value list */
+    uint_t                    *index_list;
+
+    /** Copy of each changed entry */
+    sai_qos_map_t             *entry_list;
+
+} dn_sai_qos_map_delta_t;
+
 /**
  * @brief SAI QOS WRED Thresholds structure
  */
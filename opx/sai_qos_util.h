@@ -62,6 +62,9 @@
 #define SAI_HIERARCHY_LEVEL_CHAR  "\t"
 #define SAI_HIERARCHY_LEVEL_CHAR_LEN 1
 
+/* Qos objects walked per hold of the Qos lock by the Qos dumps */
+#define SAI_QOS_DBG_DUMP_CHUNK (256)
+
 
 /**
  * @brief Accessor function for SAI Qos global config structure.
@@ -107,6 +110,19 @@ void sai_qos_lock (void);
  */
 void sai_qos_unlock (void);
 
+/**
+ * @brief Build the QoS state of the ports deferred at switch init, in port
+ *        list order. Called by sai_qos_lock with the lock held, so that no
+ *        QoS change runs ahead of them.
+ */
+void sai_qos_port_deferred_init_flush (void);
+
+/**
+ * @brief Wait until the QoS state of the ports deferred at switch init is
+ *        built. For readers of the port QoS state not taking the QoS lock.
+ */
+void sai_qos_port_all_init_wait (void);
+
 /**
  * @brief Utility to get first Qos DLL Node
  * @param[in] p_dll_head DLL head
@@ -1018,31 +1034,31 @@ sai_status_t sai_qos_sched_group_and_child_nodes_update (
 
 /** Logging utility for SAI POLICER API */
 #define SAI_POLICER_LOG(level, msg, ...) \
-        if (sai_is_log_enabled (SAI_API_POLICER, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_POLICER, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_POLICER, level, msg, ##__VA_ARGS__); \
        }
 
 /** Logging utility for SAI Scheduler Group API */
 #define SAI_SCHED_GRP_LOG(level, msg, ...) \
-        if (sai_is_log_enabled (SAI_API_SCHEDULER_GROUP, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_SCHEDULER_GROUP, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_SCHEDULER_GRP, level, msg, ##__VA_ARGS__); \
         }
 
 /** Logging utility for SAI Queue API */
 #define SAI_QUEUE_LOG(level, msg, ...) \
-        if (sai_is_log_enabled (SAI_API_QUEUE, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_QUEUE, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_QUEUE, level, msg, ##__VA_ARGS__); \
         }
 
 /** Logging utility for SAI Scheduler API */
 #define SAI_SCHED_LOG(level, msg, ...) \
-        if (sai_is_log_enabled (SAI_API_SCHEDULER, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_SCHEDULER, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_SCHEDULER, level, msg, ##__VA_ARGS__); \
         }
 
 /** Logging utility for SAI WRED API */
 #define SAI_WRED_LOG(level, msg, ...) \
-        if (sai_is_log_enabled (SAI_API_WRED, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_WRED, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_WRED, level, msg, ##__VA_ARGS__); \
        }
 
@@ -1050,7 +1066,7 @@ sai_status_t sai_qos_sched_group_and_child_nodes_update (
  * @brief   SAI maps specific trace logging function
  */
 #define SAI_MAPS_LOG(level, msg, ...) \
-        if (sai_is_log_enabled (SAI_API_QOS_MAP, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_QOS_MAP, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_MAPS, level, msg, ##__VA_ARGS__); \
        }
 
@@ -1058,13 +1074,13 @@ sai_status_t sai_qos_sched_group_and_child_nodes_update (
  * @brief   SAI Qos Initialization specific trace logging function
  */
 #define SAI_QOS_LOG(level, msg, ...) \
-        if (sai_is_log_enabled (SAI_API_QOS_MAP, level) || \
-            (sai_is_log_enabled (SAI_API_QUEUE, level)) || \
-            (sai_is_log_enabled (SAI_API_WRED, level)) || \
-            (sai_is_log_enabled (SAI_API_POLICER, level))|| \
-            (sai_is_log_enabled (SAI_API_SCHEDULER, level))|| \
-            (sai_is_log_enabled (SAI_API_SCHEDULER_GROUP, level)) || \
-            (sai_is_log_enabled (SAI_API_BUFFER, level))) { \
+        if (sai_is_log_enabled_fast (SAI_API_QOS_MAP, level) || \
+            (sai_is_log_enabled_fast (SAI_API_QUEUE, level)) || \
+            (sai_is_log_enabled_fast (SAI_API_WRED, level)) || \
+            (sai_is_log_enabled_fast (SAI_API_POLICER, level))|| \
+            (sai_is_log_enabled_fast (SAI_API_SCHEDULER, level))|| \
+            (sai_is_log_enabled_fast (SAI_API_SCHEDULER_GROUP, level)) || \
+            (sai_is_log_enabled_fast (SAI_API_BUFFER, level))) { \
             SAI_LOG_UTIL(ev_log_t_SAI_QOS, level, msg, ##__VA_ARGS__); \
        }
 
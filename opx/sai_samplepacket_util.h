@@ -34,7 +34,7 @@
 /** Logging utility for SAI Samplepacket API */
 #define SAI_SAMPLEPACKET_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_SAMPLEPACKET, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_SAMPLEPACKET, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_SAMPLEPACKET, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
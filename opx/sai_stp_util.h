@@ -34,7 +34,7 @@
 /** Logging utility for SAI STP API */
 #define SAI_STP_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_STP, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_STP, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_STP, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
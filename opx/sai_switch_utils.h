@@ -48,7 +48,7 @@
 /** Logging utility for SAI Virtual Router API */
 #define SAI_SWITCH_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_SWITCH, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_SWITCH, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_SWITCH, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
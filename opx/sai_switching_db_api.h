@@ -63,6 +63,17 @@ sai_status_t sai_fdb_set_db_entry (const sai_fdb_entry_t *fdb_entry,
                                    sai_packet_action_t action,
                                    uint_t metadata);
 
+/*
+ * @brief Update a batch of entries in the FDB database table using one
+ * statement per group of entries
+ * @param count - Number of FDB entries.
+ * @param fdb_entry_node_list - FDB entry nodes which contain the FDB key, type,
+ * action and port.
+ * @return sai status code
+ */
+sai_status_t sai_fdb_set_db_entries (uint_t count,
+                                     const sai_fdb_entry_node_t *const *fdb_entry_node_list);
+
 /*
  * @brief Delete an entry from the FDB database table
  * @param fdb_entry - SAI FDB entry info which contains MAC address and VLAN.
@@ -70,6 +81,29 @@ sai_status_t sai_fdb_set_db_entry (const sai_fdb_entry_t *fdb_entry,
  */
 sai_status_t sai_fdb_delete_db_entry (const sai_fdb_entry_t* fdb_entry);
 
+/*
+ * @brief Create a batch of entries in the FDB database table using multi
+ * row insert statements
+ * @param count - Number of FDB entries.
+ * @param fdb_entry_list - SAI FDB entries which contain MAC address and VLAN.
+ * @param fdb_entry_node_list - Data related to each FDB entry such as port,
+ * type, action, etc.
+ * @return sai status code
+ */
+sai_status_t sai_fdb_create_db_entries (uint_t count,
+                                        const sai_fdb_entry_t *fdb_entry_list,
+                                        const sai_fdb_entry_node_t *fdb_entry_node_list);
+
+/*
+ * @brief Delete a batch of entries from the FDB database table using one
+ * statement per group of entries
+ * @param count - Number of FDB entries.
+ * @param fdb_entry_list - SAI FDB entries which contain MAC address and VLAN.
+ * @return sai status code
+ */
+sai_status_t sai_fdb_delete_db_entries (uint_t count,
+                                        const sai_fdb_entry_t *fdb_entry_list);
+
 /*
  * @brief Delete the FDB entries for the given port and vlan from the FDB
  * database table
@@ -45,7 +45,7 @@
 /** Logging utility for SAI Tunnel API */
 #define SAI_TUNNEL_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_TUNNEL, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_TUNNEL, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_TUNNEL, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
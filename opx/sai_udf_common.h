@@ -117,7 +117,7 @@ typedef struct _dn_sai_udf_t {
 /** Logging utility for SAI UDF API */
 #define SAI_UDF_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_UDF, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_UDF, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_UDF, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
@@ -86,7 +86,7 @@ typedef struct _sai_vlan_global_cache_node_t{
 /** Logging utility for SAI VLAN API */
 #define SAI_VLAN_LOG(level, msg, ...) \
     do { \
-        if (sai_is_log_enabled (SAI_API_VLAN, level)) { \
+        if (sai_is_log_enabled_fast (SAI_API_VLAN, level)) { \
             SAI_LOG_UTIL(ev_log_t_SAI_VLAN, level, msg, ##__VA_ARGS__); \
         } \
     } while (0)
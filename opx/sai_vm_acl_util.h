@@ -43,6 +43,14 @@ sai_status_t sai_npu_set_acl_rule(sai_acl_table_t *acl_table,
 sai_status_t sai_npu_create_acl_cntr(sai_acl_table_t *acl_table,
                                      sai_acl_counter_t *acl_cntr);
 sai_status_t sai_npu_delete_acl_cntr(sai_acl_counter_t *acl_cntr);
+sai_status_t sai_npu_create_acl_rules(sai_acl_table_t *acl_table, uint_t count,
+                                      sai_acl_rule_t **rule_list);
+sai_status_t sai_npu_delete_acl_rules(sai_acl_table_t *acl_table, uint_t count,
+                                      sai_acl_rule_t **rule_list);
+sai_status_t sai_npu_create_acl_cntrs(sai_acl_table_t *acl_table, uint_t count,
+                                      sai_acl_counter_t **cntr_list);
+sai_status_t sai_npu_delete_acl_cntrs(uint_t count,
+                                      sai_acl_counter_t **cntr_list);
 sai_status_t sai_npu_set_acl_cntr(sai_acl_counter_t *acl_cntr,
                                   uint64_t count_value, bool byte_set);
 sai_status_t sai_npu_get_acl_cntr(sai_acl_counter_t *acl_cntr,
@@ -65,6 +73,10 @@ sai_status_t sai_npu_set_acl_range(sai_acl_range_t *acl_range, uint_t attr_count
                                    const sai_attribute_t *p_attr);
 sai_status_t sai_npu_get_acl_range(sai_acl_range_t *acl_range, uint_t attr_count,
                                    sai_attribute_t *p_attr_list);
+
+/* Check a packet field value against the compiled checker of a range,
+ * with the ACL lock held. */
+bool sai_vm_acl_range_match(const sai_acl_range_t *acl_range, uint_t value);
 sai_status_t sai_npu_get_acl_slice_attribute(sai_object_id_t acl_slice_id,
                                              uint32_t attr_count,
                                              sai_attribute_t *attr_list);
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_vm_bridge_link.h
+ *
+ * @brief This file contains the structures and APIs resolving the kernel
+ *        VLAN bridges of the switch namespace and their members.
+ */
+
+#ifndef __SAI_VM_BRIDGE_LINK_H__
+#define __SAI_VM_BRIDGE_LINK_H__
+
+#include "saitypes.h"
+#include "saistatus.h"
+#include "std_type_defs.h"
+
+#include <stdbool.h>
+
+/* Name of the kernel bridge of a VLAN, in the switch namespace */
+#define SAI_VM_BRIDGE_VLAN_NAME_FMT  "br%u"
+
+/* Bridge member from a link dump of the switch namespace */
+typedef struct _sai_vm_bridge_link_t {
+    int if_index;
+    int master_if_index;
+    /* Lower device of a VLAN device, 0 otherwise */
+    int link_if_index;
+} sai_vm_bridge_link_t;
+
+/* Snapshot of the kernel VLAN bridges and their members */
+typedef struct _sai_vm_bridge_link_table_t {
+    /* Bridge members, sorted by master once the dump is complete */
+    sai_vm_bridge_link_t *links;
+    uint_t                count;
+    uint_t                size;
+    /* Interface index of the bridge of each VLAN, 0 if none */
+    int                  *vlan_br_if_index;
+    bool                  oom;
+} sai_vm_bridge_link_table_t;
+
+/**
+ * @brief Callback invoked for every member of a VLAN bridge backed by a port.
+ * @param[in] br_if_index Interface index of the VLAN bridge
+ * @param[in] if_index Interface index of the bridge member
+ * @param[in] ctx Caller context
+ */
+typedef void (*sai_vm_bridge_member_fn) (int br_if_index, int if_index, void *ctx);
+
+/**
+ * @brief Take a snapshot of the VLAN bridges and their members with one
+ *        link dump.
+ * @param[in] sock rtnetlink socket in the switch namespace
+ * @param[out] p_tbl Table to fill, released with sai_vm_bridge_link_table_free
+ * @return SAI_STATUS_SUCCESS on success, error otherwise
+ */
+sai_status_t sai_vm_bridge_link_table_get (int sock, sai_vm_bridge_link_table_t *p_tbl);
+
+/**
+ * @brief Release the memory held by a bridge link table.
+ * @param[in] p_tbl Table returned by sai_vm_bridge_link_table_get
+ */
+void sai_vm_bridge_link_table_free (sai_vm_bridge_link_table_t *p_tbl);
+
+/**
+ * @brief Walk the members of the bridge of a VLAN backed by a port, either
+ *        the port interface itself or a VLAN device on top of it.
+ * @param[in] p_tbl Bridge link table
+ * @param[in] vlan_id VLAN of the bridge
+ * @param[in] port_if_index Interface index of the port
+ * @param[in] fn Callback invoked for each matching member
+ * @param[in] ctx Caller context passed to the callback
+ */
+void sai_vm_bridge_vlan_members_walk (const sai_vm_bridge_link_table_t *p_tbl,
+                                      sai_vlan_id_t vlan_id, int port_if_index,
+                                      sai_vm_bridge_member_fn fn, void *ctx);
+
+/**
+ * @brief Interface index, in the switch namespace, of the front panel
+ *        interface of a bridge port.
+ * @param[in] bridge_port_id Bridge port object id
+ * @return Interface index, 0 if the bridge port has no interface of its own
+ */
+int sai_vm_bridge_port_if_index_get (sai_object_id_t bridge_port_id);
+
+#endif /* __SAI_VM_BRIDGE_LINK_H__ */
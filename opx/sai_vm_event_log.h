@@ -28,11 +28,29 @@
 #include "event_log_types.h"
 #include "sai_event_log.h"
 
-/** Logging utility for SAI Scheduler API */
+/**
+ * Lowest level of the VM DB logs built in. Logs of lower levels are
+ * compiled out, e.g. -DSAI_VM_DB_LOG_LEVEL_MIN=SAI_LOG_LEVEL_ERROR drops
+ * the DB traces from a build.
+ */
+#ifndef SAI_VM_DB_LOG_LEVEL_MIN
+#define SAI_VM_DB_LOG_LEVEL_MIN SAI_LOG_LEVEL_DEBUG
+#endif
+
+/**
+ * Logging utility for the SAI VM DB, enabled with the log level of the
+ * switch API. The message and the SQL text in its arguments are only
+ * formatted when the level is enabled.
+ */
 #define SAI_VM_DB_LOG(level, msg, ...) \
-        SAI_LOG_UTIL(ev_log_t_DB_SQL, level, msg, ##__VA_ARGS__); \
+    do { \
+        if (((level) >= SAI_VM_DB_LOG_LEVEL_MIN) && \
+            sai_is_log_enabled_fast (SAI_API_SWITCH, level)) { \
+            SAI_LOG_UTIL(ev_log_t_DB_SQL, level, msg, ##__VA_ARGS__); \
+        } \
+    } while (0)
 
-/** Per log level based macros for SAI Scheduler API */
+/** Per log level based macros for the SAI VM DB */
 #define SAI_VM_DB_LOG_TRACE(msg, ...) \
             SAI_VM_DB_LOG (SAI_LOG_LEVEL_DEBUG, msg, ##__VA_ARGS__)
 
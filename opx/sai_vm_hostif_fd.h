@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_vm_hostif_fd.h
+ *
+ * @brief This file contains the APIs of the SAI FD host interfaces.
+ *
+ *        Every FD host interface has a bounded single producer ring. The
+ *        packet RX thread queues a copy of each punted frame on the ring of
+ *        every FD host interface without taking a lock, and signals the
+ *        event fd of the host interface when its ring turns non empty.
+ *        Frames finding a ring full are dropped and counted.
+ */
+
+#ifndef __SAI_VM_HOSTIF_FD_H__
+#define __SAI_VM_HOSTIF_FD_H__
+
+#include "saitypes.h"
+#include "saistatus.h"
+#include "sai_hostif_common.h"
+#include "sai_port_common.h"
+
+#include <stddef.h>
+
+/* Frames queued on a FD host interface, a power of 2 */
+#define SAI_VM_HOSTIF_FD_RING_SIZE   (1024)
+
+/**
+ * @brief Initialize the FD host interface database.
+ * @return SAI_STATUS_SUCCESS on success, error otherwise
+ */
+sai_status_t sai_vm_hostif_fd_init (void);
+
+/**
+ * @brief Create the ring and the event fd of a FD host interface.
+ * @param[inout] hostif_node Host interface, npu_hostif_info is filled in
+ * @return SAI_STATUS_SUCCESS on success, error otherwise
+ */
+sai_status_t sai_vm_hostif_fd_create (dn_sai_hostif_node_t *hostif_node);
+
+/**
+ * @brief Remove a FD host interface, once the RX thread and the receivers
+ *        are done with it.
+ * @param[in] hostif_node Host interface
+ */
+void sai_vm_hostif_fd_remove (dn_sai_hostif_node_t *hostif_node);
+
+/**
+ * @brief Queue a frame received on a port on every FD host interface.
+ *        Called from the packet RX thread only.
+ * @param[in] port_info Ingress port
+ * @param[in] frame Frame, as given to the packet event callback
+ * @param[in] len Length of the frame
+ */
+void sai_vm_hostif_fd_rx (const sai_port_info_t *port_info, const void *frame,
+                          size_t len);
+
+/**
+ * @brief Dequeue the frames of a FD host interface. The event fd is cleared
+ *        when the ring is found empty.
+ * @param[in] hif_id FD host interface
+ * @param[inout] pkt_list Packets, buffer and buffer_size are set by the caller
+ * @param[inout] pkt_count Size of pkt_list on input, frames dequeued on output
+ * @return SAI_STATUS_SUCCESS on success, SAI_STATUS_BUFFER_OVERFLOW if the
+ *         first frame does not fit, its length being in buffer_size
+ */
+sai_status_t sai_vm_hostif_fd_recv (sai_object_id_t hif_id,
+                                    dn_sai_hostif_packet_t *pkt_list,
+                                    uint_t *pkt_count);
+
+/**
+ * @brief Get the event fd and the drop counter of a FD host interface.
+ * @param[in] hif_id FD host interface
+ * @param[out] event_fd Event fd, readable while frames are queued
+ * @param[out] rx_drops Frames dropped on a full ring
+ * @return SAI_STATUS_SUCCESS on success, error otherwise
+ */
+sai_status_t sai_vm_hostif_fd_info_get (sai_object_id_t hif_id, int *event_fd,
+                                        uint64_t *rx_drops);
+
+/**
+ * @brief Frames dropped on full rings of all FD host interfaces, since start.
+ * @return Dropped frame count
+ */
+uint64_t sai_vm_hostif_fd_rx_drops_total_get (void);
+
+#endif /* __SAI_VM_HOSTIF_FD_H__ */
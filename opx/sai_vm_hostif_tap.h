@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_vm_hostif_tap.h
+ *
+ * @brief This file contains the APIs backing the SAI netdev host interfaces
+ *        with multiqueue TAP devices in the switch namespace.
+ *
+ *        Frames received on a virtual port are written to the TAP of the
+ *        port, of its LAG or of its VLAN, on a queue picked by flow hash.
+ *        Every TAP queue has a TX thread sending the frames written to the
+ *        TAP out of the bound port, a LAG member or the VLAN bridge.
+ */
+
+#ifndef __SAI_VM_HOSTIF_TAP_H__
+#define __SAI_VM_HOSTIF_TAP_H__
+
+#include "saitypes.h"
+#include "saistatus.h"
+#include "sai_hostif_common.h"
+#include "sai_port_common.h"
+
+#include <stddef.h>
+
+/* Upper bound and default of the queue count of a TAP */
+#define SAI_VM_HOSTIF_TAP_MAX_QUEUES       (16)
+#define SAI_VM_HOSTIF_TAP_DEFAULT_QUEUES   (4)
+
+/* Environment variable overriding the queue count of the TAPs created next */
+#define SAI_VM_HOSTIF_TAP_QUEUES_ENV       "SAI_VM_HOSTIF_TAP_QUEUES"
+
+/* Frames a TX thread reads from its queue before polling again */
+#define SAI_VM_HOSTIF_TAP_TX_BURST         (64)
+
+/* Largest LAG resolved on TX */
+#define SAI_VM_HOSTIF_TAP_MAX_LAG_PORTS    (64)
+
+/**
+ * @brief Initialize the TAP database.
+ * @return SAI_STATUS_SUCCESS on success, error otherwise
+ */
+sai_status_t sai_vm_hostif_tap_init (void);
+
+/**
+ * @brief Create the TAP device of a netdev host interface.
+ * @param[inout] hostif_node Host interface, npu_hostif_info is filled in
+ * @return SAI_STATUS_SUCCESS on success, error otherwise
+ */
+sai_status_t sai_vm_hostif_tap_create (dn_sai_hostif_node_t *hostif_node);
+
+/**
+ * @brief Remove the TAP device of a netdev host interface, once its TX
+ *        threads are stopped.
+ * @param[in] hostif_node Host interface
+ */
+void sai_vm_hostif_tap_remove (dn_sai_hostif_node_t *hostif_node);
+
+/**
+ * @brief Set the carrier of the TAP device of a netdev host interface.
+ * @param[in] hostif_node Host interface
+ * @param[in] oper_status New operational status
+ * @return SAI_STATUS_SUCCESS on success, error otherwise
+ */
+sai_status_t sai_vm_hostif_tap_oper_status_set (dn_sai_hostif_node_t *hostif_node,
+                                                bool oper_status);
+
+/**
+ * @brief Deliver a frame received on a port to the TAP bound to the port,
+ *        to its LAG or to the VLAN of the frame, in that order.
+ * @param[in] port_info Ingress port
+ * @param[in] vlan_tagged Whether the frame was received with a VLAN tag
+ * @param[in] vlan_id VLAN of the tag of the frame
+ * @param[in] frame Untagged frame
+ * @param[in] len Length of the frame
+ * @return true if a TAP took the frame, false if none is bound
+ */
+bool sai_vm_hostif_tap_rx (const sai_port_info_t *port_info, bool vlan_tagged,
+                           sai_vlan_id_t vlan_id, const void *frame, size_t len);
+
+/**
+ * @brief Frames dropped on TAP RX queues being full, since start.
+ * @return Dropped frame count
+ */
+uint64_t sai_vm_hostif_tap_rx_drops_get (void);
+
+#endif /* __SAI_VM_HOSTIF_TAP_H__ */
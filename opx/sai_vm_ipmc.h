@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_vm_ipmc.h
+ *
+ * @brief This file contains the sai-vm data of the IPMC and RPF group
+ *        members, kept in the hw_info of the member nodes.
+ */
+
+#ifndef __SAI_VM_IPMC_H__
+#define __SAI_VM_IPMC_H__
+
+#include "saitypes.h"
+#include "sai_vm_mroute.h"
+
+#include <stddef.h>
+
+/* Kernel interface of the router interface of a group member */
+typedef struct _sai_vm_ipmc_member_hw_info_t {
+    /* Interface index in the switch namespace, 0 if the RIF has none */
+    int  if_index;
+
+    /* VIF referenced by the member, SAI_VM_MROUTE_INVALID_VIF if none */
+    int  vif;
+} sai_vm_ipmc_member_hw_info_t;
+
+/**
+ * @brief Interface index of the kernel device of a router interface.
+ * @param[in] rif_id Router interface id
+ * @return Interface index in the switch namespace, 0 for a LAG RIF or a RIF
+ *         without kernel device
+ */
+int sai_vm_ipmc_rif_if_index_get (sai_object_id_t rif_id);
+
+/**
+ * @brief VIF of an IPMC or RPF group member.
+ * @param[in] hw_info hw_info of the member node
+ * @return VIF index, SAI_VM_MROUTE_INVALID_VIF if the member has none
+ */
+static inline int sai_vm_ipmc_member_vif_get (const void *hw_info)
+{
+    if (hw_info == NULL) {
+        return SAI_VM_MROUTE_INVALID_VIF;
+    }
+    return ((const sai_vm_ipmc_member_hw_info_t *) hw_info)->vif;
+}
+
+#endif /* __SAI_VM_IPMC_H__ */
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_vm_lag.h
+ *
+ * @brief This file contains the function prototypes for the kernel bond
+ *        devices backing the SAI LAG objects in VM environment.
+ */
+
+#ifndef __SAI_VM_LAG_H__
+#define __SAI_VM_LAG_H__
+
+#include "saitypes.h"
+#include "saistatus.h"
+
+/* Name of the bond device backing a LAG, in the virtual port namespace */
+#define SAI_VM_LAG_DEV_NAME_FMT  "sailag%u"
+
+/* Bond link monitoring interval in milliseconds */
+#define SAI_VM_LAG_MIIMON_MS     (100)
+
+/**
+ * @brief Map the native hash fields of a switch LAG hash attribute to the
+ *        transmit hash policy of all the bond devices.
+ *
+ * @param[in] attr_id Switch hash attribute id, non LAG attributes are ignored
+ * @param[in] native_field_list List of sai_native_hash_field_t
+ * @return SAI_STATUS_SUCCESS on success, error otherwise
+ */
+sai_status_t sai_vm_lag_hash_fields_set (sai_attr_id_t attr_id,
+                                         const sai_s32_list_t *native_field_list);
+
+#endif /* __SAI_VM_LAG_H__ */
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_vm_mcast.h
+ *
+ * @brief This file contains the APIs rendering the L2 multicast entries
+ *        into the multicast database (MDB) of the kernel VLAN bridges.
+ *
+ *        Changes are queued and coalesced per kernel entry, then sent to
+ *        the kernel as one rtnetlink batch by a flusher thread.
+ */
+
+#ifndef __SAI_VM_MCAST_H__
+#define __SAI_VM_MCAST_H__
+
+#include "saitypes.h"
+#include "saistatus.h"
+#include "sai_l2mc_common.h"
+
+#include <stdbool.h>
+
+/* Time the flusher waits after the first queued change, to batch a burst */
+#define SAI_VM_MDB_FLUSH_DELAY_US  (10*1000)
+
+/**
+ * @brief Open the rtnetlink socket of the switch namespace, remove the stale
+ *        permanent MDB entries of the VLAN bridges and start the flusher.
+ * @return SAI_STATUS_SUCCESS, the entries are kept in software only if the
+ *         kernel cannot be reached
+ */
+sai_status_t sai_vm_mdb_init (void);
+
+/**
+ * @brief Queue the addition or deletion of the MDB entries of a port on the
+ *        bridge of a VLAN.
+ * A later update of the same entry, before it is flushed, replaces this one.
+ * @param[in] vlan_id VLAN of the bridge
+ * @param[in] port_if_index Interface index of the port in the switch namespace
+ * @param[in] grp_addr Group address
+ * @param[in] src_addr Source address of an (S,G) entry, NULL for (*,G)
+ * @param[in] add true to add the entry, false to delete it
+ * @return SAI_STATUS_SUCCESS or SAI_STATUS_NO_MEMORY
+ */
+sai_status_t sai_vm_mdb_entry_update (sai_vlan_id_t vlan_id, int port_if_index,
+                                      const sai_ip_address_t *grp_addr,
+                                      const sai_ip_address_t *src_addr, bool add);
+
+/**
+ * @brief Send the queued MDB changes to the kernel and wait for the outcome.
+ * @return SAI_STATUS_SUCCESS if every change was applied, error otherwise
+ */
+sai_status_t sai_vm_mdb_flush (void);
+
+/**
+ * @brief Render an L2MC group member on all the L2MC entries of its group.
+ * Members on LAG bridge ports are not rendered, they have no interface in
+ * the switch namespace. Called with the L2MC lock held.
+ * @param[in] l2mc_member_node L2MC group member
+ * @param[in] add true when the member joins the group, false when it leaves
+ */
+void sai_vm_mcast_l2mc_member_update (const dn_sai_l2mc_member_node_t *l2mc_member_node,
+                                      bool add);
+
+#endif /* __SAI_VM_MCAST_H__ */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_vm_mroute.h
+ *
+ * @brief This file contains the APIs programming the IPv4 multicast routing
+ *        table of the switch namespace through the kernel mroute socket.
+ *
+ *        Interfaces are added as virtual interfaces (VIFs) while referenced
+ *        and forwarding cache (MFC) entries are updated in place.
+ */
+
+#ifndef __SAI_VM_MROUTE_H__
+#define __SAI_VM_MROUTE_H__
+
+#include "saitypes.h"
+#include "saistatus.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Size of the kernel VIF table, MAXVIFS of linux/mroute.h */
+#define SAI_VM_MROUTE_MAX_VIFS      (32)
+
+#define SAI_VM_MROUTE_INVALID_VIF   (-1)
+
+/* TTL threshold of a VIF in the output list of an MFC entry */
+#define SAI_VM_MROUTE_OIF_TTL       (1)
+
+/* TTL threshold of a VIF outside the output list of an MFC entry */
+#define SAI_VM_MROUTE_NO_OIF_TTL    (255)
+
+/**
+ * @brief Open the mroute socket of the switch namespace. The socket owns the
+ *        multicast routing table, which the kernel flushes when it closes.
+ * @return SAI_STATUS_SUCCESS, the entries are kept in software only if the
+ *         table cannot be owned
+ */
+sai_status_t sai_vm_mroute_init (void);
+
+/**
+ * @brief Take a reference on the VIF of an interface, adding it on the first
+ *        reference.
+ * @param[in] if_index Interface index in the switch namespace
+ * @return VIF index, SAI_VM_MROUTE_INVALID_VIF if it cannot be added
+ */
+int sai_vm_mroute_vif_get (int if_index);
+
+/**
+ * @brief Release a reference taken with sai_vm_mroute_vif_get, deleting the
+ *        VIF on the last one.
+ * @param[in] if_index Interface index in the switch namespace
+ */
+void sai_vm_mroute_vif_put (int if_index);
+
+/**
+ * @brief VIF of an interface, without taking a reference.
+ * @param[in] if_index Interface index in the switch namespace
+ * @return VIF index, SAI_VM_MROUTE_INVALID_VIF if the interface has none
+ */
+int sai_vm_mroute_vif_find (int if_index);
+
+/**
+ * @brief Add an MFC entry or update it in place.
+ * @param[in] src_addr Source address, NULL or unspecified for a (*,G) entry
+ * @param[in] grp_addr IPv4 group address
+ * @param[in] parent_vif VIF of the RPF interface
+ * @param[in] ttls TTL threshold of each VIF, SAI_VM_MROUTE_NO_OIF_TTL
+ *            outside the output list
+ * @return SAI_STATUS_SUCCESS on success, error otherwise
+ */
+sai_status_t sai_vm_mroute_mfc_set (const sai_ip_address_t *src_addr,
+                                    const sai_ip_address_t *grp_addr, int parent_vif,
+                                    const uint8_t ttls [SAI_VM_MROUTE_MAX_VIFS]);
+
+/**
+ * @brief Delete an MFC entry, a missing entry is not an error.
+ * @param[in] src_addr Source address, NULL or unspecified for a (*,G) entry
+ * @param[in] grp_addr IPv4 group address
+ * @return SAI_STATUS_SUCCESS on success, error otherwise
+ */
+sai_status_t sai_vm_mroute_mfc_del (const sai_ip_address_t *src_addr,
+                                    const sai_ip_address_t *grp_addr);
+
+#endif /* __SAI_VM_MROUTE_H__ */
@@ -25,6 +25,9 @@
 #define __SAI_VM_QOS_H__
 
 #include "saiport.h"
+#include "saibuffer.h"
+
+#include <linux/pkt_sched.h>
 
 #define SAI_VM_QOS_MAX_SUPPORTED_QUEUES        (4096)
 #define SAI_VM_QOS_MAX_SCHEDULER_PROFILES      (4096)
@@ -136,4 +139,82 @@ static inline uint8_t *sai_vm_qos_policer_bitmap_get (void)
 sai_status_t sai_qos_port_attribute_get(sai_npu_object_id_t port_id,
                                         sai_port_attr_t port_attr,
                                         sai_attribute_value_t *value);
+
+/* Major number of the root qdisc on the virtual port devices. Queue index
+ * N of a port is the tc class (and leaf qdisc parent) 1:(N+1). */
+#define SAI_VM_QOS_TC_ROOT_MAJOR               (1)
+
+#define SAI_VM_QOS_QUEUE_CLASSID(queue_index) \
+        TC_H_MAKE((SAI_VM_QOS_TC_ROOT_MAJOR << 16), ((queue_index) + 1))
+
+/* Default tc statistics poll interval in milliseconds */
+#define SAI_VM_QOS_STATS_POLL_INTERVAL_DFLT    (1000)
+
+/** Counters cached for every qdisc of the tc statistics snapshot */
+typedef enum _sai_vm_qos_tc_stat_t {
+    SAI_VM_QOS_TC_STAT_PACKETS = 0,
+    SAI_VM_QOS_TC_STAT_BYTES,
+    SAI_VM_QOS_TC_STAT_DROPS,
+    SAI_VM_QOS_TC_STAT_OVERLIMITS,
+    SAI_VM_QOS_TC_STAT_BACKLOG,
+    SAI_VM_QOS_TC_STAT_QLEN,
+    /** Highest backlog seen across polls since the last clear */
+    SAI_VM_QOS_TC_STAT_WATERMARK,
+    SAI_VM_QOS_TC_STAT_MAX,
+} sai_vm_qos_tc_stat_t;
+
+/**
+ * @brief Start the tc statistics poller. All qdiscs of the virtual port
+ *        namespace are dumped with a single request per poll interval
+ *        and the stats getters are served from the cached snapshot.
+ */
+sai_status_t sai_vm_qos_stats_init (void);
+
+/**
+ * @brief Set the tc statistics poll interval.
+ * @param[in] interval_ms Interval in milliseconds, 0 restores the default
+ */
+void sai_vm_qos_stats_poll_interval_set (uint_t interval_ms);
+
+/**
+ * @brief Get the virtual port device index of a SAI port.
+ * @param[in] port_id SAI port object id
+ * @param[out] if_index Interface index in the virtual port namespace
+ * @return SAI_STATUS_ITEM_NOT_FOUND if the port has no virtual port device
+ */
+sai_status_t sai_vm_qos_port_if_index_get (sai_object_id_t port_id,
+                                           int *if_index);
+
+/**
+ * @brief Read the cached counters of the qdisc attached to a parent handle.
+ * @param[in] if_index Interface index of the device
+ * @param[in] parent Parent handle of the qdisc (class id, TC_H_ROOT, TC_H_INGRESS)
+ * @param[out] stats Array of SAI_VM_QOS_TC_STAT_MAX counters
+ * @return SAI_STATUS_ITEM_NOT_FOUND if no such qdisc is in the snapshot
+ */
+sai_status_t sai_vm_qos_tc_stats_get (int if_index, uint32_t parent,
+                                      uint64_t *stats);
+
+/**
+ * @brief Clear the cached counters of the qdisc attached to a parent handle.
+ * @param[in] if_index Interface index of the device
+ * @param[in] parent Parent handle of the qdisc
+ * @param[in] stat_ids Counters to clear
+ * @param[in] count Number of counters to clear
+ */
+sai_status_t sai_vm_qos_tc_stats_clear (int if_index, uint32_t parent,
+                                        const sai_vm_qos_tc_stat_t *stat_ids,
+                                        uint_t count);
+
+/**
+ * @brief Read the aggregated occupancy of all egress or ingress qdiscs.
+ * @param[in] pool_type Egress pools aggregate the port queues, ingress pools
+ *            the ingress qdiscs
+ * @param[out] curr_bytes Current backlog in bytes
+ * @param[out] watermark_bytes Highest backlog seen across polls
+ */
+void sai_vm_qos_tc_pool_stats_get (sai_buffer_pool_type_t pool_type,
+                                   uint64_t *curr_bytes,
+                                   uint64_t *watermark_bytes);
+
 #endif /* __SAI_VM_QOS_H__ */
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * @file sai_vm_rtnl.h
+ *
+ * @brief This file contains the structures and APIs for issuing rtnetlink
+ *        requests towards the kernel objects backing the virtual ports.
+ *************************************************************************/
+
+#ifndef __SAI_VM_RTNL_H__
+#define __SAI_VM_RTNL_H__
+
+#include "saitypes.h"
+#include "saistatus.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Receive buffer size used for dump replies */
+#define SAI_VM_RTNL_RCV_BUF_SIZE  (64*1024)
+
+/* Initial and incremental size of a batch request buffer */
+#define SAI_VM_RTNL_BATCH_CHUNK_SIZE  (4*1024)
+
+/* Messages sent per sendmsg, so that their acks fit in the receive buffer */
+#define SAI_VM_RTNL_BATCH_WINDOW  (64)
+
+/**
+ * @brief A set of rtnetlink requests sent to the kernel in a few large
+ *        sendmsg and acknowledged individually.
+ *
+ * Messages and attributes are referred to by their offset in the buffer,
+ * as the buffer is reallocated while the batch grows.
+ */
+typedef struct _sai_vm_rtnl_batch_t {
+    /* Request buffer */
+    char    *buf;
+    /* Bytes used in the request buffer */
+    size_t   len;
+    /* Bytes allocated for the request buffer */
+    size_t   size;
+    /* Offset of the message currently being built */
+    size_t   msg_offset;
+    /* Number of messages in the batch */
+    uint32_t msg_count;
+    /* Per message error (0 or -errno) filled in by sai_vm_rtnl_batch_commit */
+    int     *msg_err;
+    /* Set when an allocation failed while building the batch */
+    bool     oom;
+} sai_vm_rtnl_batch_t;
+
+/**
+ * @brief Callback invoked for every message of a dump reply.
+ *
+ * @param[in] hdr Netlink message header of the reply
+ * @param[in] ctx Caller context passed to sai_vm_rtnl_dump
+ */
+typedef void (*sai_vm_rtnl_msg_cb_t) (struct nlmsghdr *hdr, void *ctx);
+
+/**
+ * @brief Open a NETLINK_ROUTE socket in the virtual port namespace.
+ *
+ * @param[in] groups Multicast groups to subscribe to, 0 for request only
+ * @return Socket descriptor or STD_INVALID_FD on failure
+ */
+int sai_vm_rtnl_open (uint32_t groups);
+
+/**
+ * @brief Open a NETLINK_ROUTE socket in the namespace of the switch
+ *        process, where the VLAN bridges live.
+ *
+ * @param[in] groups Multicast groups to subscribe to, 0 for request only
+ * @return Socket descriptor or STD_INVALID_FD on failure
+ */
+int sai_vm_rtnl_switch_ns_open (uint32_t groups);
+
+/**
+ * @brief Close a socket returned by sai_vm_rtnl_open.
+ *
+ * @param[in] sock Socket descriptor
+ */
+void sai_vm_rtnl_close (int sock);
+
+/**
+ * @brief Issue a dump request and walk all the reply messages.
+ *
+ * The request header flags and sequence number are filled in by this API.
+ *
+ * @param[in] sock Socket returned by sai_vm_rtnl_open
+ * @param[in] req Request message, including the family specific header
+ * @param[in] cb Callback invoked for each reply message
+ * @param[in] ctx Caller context passed to the callback
+ * @return SAI_STATUS_SUCCESS once NLMSG_DONE is received, error otherwise
+ */
+sai_status_t sai_vm_rtnl_dump (int sock, struct nlmsghdr *req,
+                               sai_vm_rtnl_msg_cb_t cb, void *ctx);
+
+/**
+ * @brief Index the attributes of a message by type.
+ *
+ * @param[out] tb Table of max + 1 entries, filled with the attributes found
+ * @param[in] max Highest attribute type of interest
+ * @param[in] rta First attribute
+ * @param[in] len Length of the attribute area
+ */
+void sai_vm_rtnl_attr_parse (struct rtattr **tb, int max,
+                             struct rtattr *rta, int len);
+
+/**
+ * @brief Initialize an empty batch.
+ *
+ * @param[out] batch Batch to initialize
+ */
+void sai_vm_rtnl_batch_init (sai_vm_rtnl_batch_t *batch);
+
+/**
+ * @brief Release the memory held by a batch.
+ *
+ * @param[in] batch Batch to release
+ */
+void sai_vm_rtnl_batch_free (sai_vm_rtnl_batch_t *batch);
+
+/**
+ * @brief Start a new message in the batch.
+ *
+ * NLM_F_REQUEST and NLM_F_ACK are always set; the sequence number is
+ * assigned at commit time.
+ *
+ * @param[in] batch Batch to add the message to
+ * @param[in] type Netlink message type
+ * @param[in] flags Additional netlink message flags
+ * @param[in] hdr Family specific header
+ * @param[in] hdr_len Length of the family specific header
+ */
+void sai_vm_rtnl_batch_msg_add (sai_vm_rtnl_batch_t *batch, uint16_t type,
+                                uint16_t flags, const void *hdr, size_t hdr_len);
+
+/**
+ * @brief Append an attribute to the message being built.
+ *
+ * @param[in] batch Batch holding the message
+ * @param[in] type Attribute type
+ * @param[in] data Attribute payload, may be NULL if len is 0
+ * @param[in] len Length of the attribute payload
+ */
+void sai_vm_rtnl_attr_add (sai_vm_rtnl_batch_t *batch, uint16_t type,
+                           const void *data, size_t len);
+
+/**
+ * @brief Open a nested attribute in the message being built.
+ *
+ * @param[in] batch Batch holding the message
+ * @param[in] type Attribute type of the nest
+ * @return Handle to pass to sai_vm_rtnl_nest_end
+ */
+size_t sai_vm_rtnl_nest_begin (sai_vm_rtnl_batch_t *batch, uint16_t type);
+
+/**
+ * @brief Close a nested attribute opened by sai_vm_rtnl_nest_begin.
+ *
+ * @param[in] batch Batch holding the message
+ * @param[in] nest Handle returned by sai_vm_rtnl_nest_begin
+ */
+void sai_vm_rtnl_nest_end (sai_vm_rtnl_batch_t *batch, size_t nest);
+
+/**
+ * @brief Send the messages of a batch SAI_VM_RTNL_BATCH_WINDOW at a time
+ *        and collect the acknowledgement of every message.
+ *
+ * The kernel processes every message of the batch even if an earlier one
+ * fails, the individual outcome is left in batch->msg_err.
+ *
+ * @param[in] sock Socket returned by sai_vm_rtnl_open
+ * @param[in] batch Batch to send
+ * @param[in] cb Optional callback for reply messages other than acks
+ * @param[in] ctx Caller context passed to the callback
+ * @return SAI_STATUS_SUCCESS if every message was acknowledged without error
+ */
+sai_status_t sai_vm_rtnl_batch_commit (int sock, sai_vm_rtnl_batch_t *batch,
+                                       sai_vm_rtnl_msg_cb_t cb, void *ctx);
+
+/**
+ * @brief Map the error of a batch message to a SAI status.
+ *
+ * @param[in] err Positive errno value
+ * @return SAI status matching err, SAI_STATUS_SUCCESS for 0
+ */
+sai_status_t sai_vm_rtnl_errno_to_sai_status (int err);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SAI_VM_RTNL_H__ */
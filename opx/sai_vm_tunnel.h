@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_vm_tunnel.h
+ *
+ * @brief This file contains the APIs backing the SAI tunnel objects with
+ *        kernel tunnel devices in the switch namespace.
+ *
+ *        A VXLAN tunnel is an external (VNI filtering) vxlan device, whose
+ *        VNI filter holds the VNIs of the tunnel maps and whose flood list
+ *        holds the remote of each encap next hop. An IP in IP tunnel is an
+ *        ipip or ip6tnl device and its encap next hops are kernel nexthop
+ *        objects through the device.
+ *
+ *        VNI filter and flood list changes are queued and coalesced, then
+ *        sent to the kernel as one rtnetlink batch by a flusher thread. The
+ *        VNI filter changes of a device share a single message.
+ */
+
+#ifndef __SAI_VM_TUNNEL_H__
+#define __SAI_VM_TUNNEL_H__
+
+#include "saitypes.h"
+#include "saistatus.h"
+#include "sai_l3_common.h"
+
+/* Names of the tunnel devices, from the index of the tunnel object */
+#define SAI_VM_TUNNEL_VXLAN_DEV_NAME_FMT   "saivxlan%u"
+#define SAI_VM_TUNNEL_IPIP_DEV_NAME_FMT    "saiipip%u"
+#define SAI_VM_TUNNEL_IP6TNL_DEV_NAME_FMT  "saiip6tnl%u"
+
+/* IANA VXLAN UDP port */
+#define SAI_VM_TUNNEL_VXLAN_UDP_PORT       (4789)
+
+/* Kernel nexthop object id of an IP in IP encap next hop, from its index */
+#define SAI_VM_TUNNEL_KERNEL_NH_ID_BASE    (0x5a000000)
+
+/* VNI filter entries sent in one rtnetlink message */
+#define SAI_VM_TUNNEL_VNIS_PER_MSG         (1024)
+
+/* Time the flusher waits after the first queued change, to batch a burst */
+#define SAI_VM_TUNNEL_FLUSH_DELAY_US       (10*1000)
+
+/**
+ * @brief Send the queued VNI filter and flood list changes to the kernel and
+ *        wait for the outcome.
+ * @return SAI_STATUS_SUCCESS if every change was applied, error otherwise
+ */
+sai_status_t sai_vm_tunnel_flush (void);
+
+/**
+ * @brief Render a tunnel encap next hop on the device of its tunnel.
+ * Called with the FIB lock held.
+ * @param[in] p_encap_nh Tunnel encap next hop
+ * @param[in] nh_index Index of the next hop
+ * @return SAI_STATUS_SUCCESS on success, error otherwise
+ */
+sai_status_t sai_vm_tunnel_encap_nh_create (sai_fib_nh_t *p_encap_nh, uint_t nh_index);
+
+/**
+ * @brief Remove a tunnel encap next hop from the device of its tunnel.
+ * Called with the FIB lock held.
+ * @param[in] p_encap_nh Tunnel encap next hop
+ * @param[in] nh_index Index of the next hop
+ */
+void sai_vm_tunnel_encap_nh_remove (sai_fib_nh_t *p_encap_nh, uint_t nh_index);
+
+#endif /* __SAI_VM_TUNNEL_H__ */
@@ -27,14 +27,31 @@
 #define __SAI_VM_VPORT_H__
 
 #include "saitypes.h"
+#include "saiqosmap.h"
 #include "sai_port_common.h"
 #include "std_error_codes.h"
 
+#include <stddef.h>
+#include <sys/types.h>
+
 /* Virtual front panel name space
  * See also, in platform-VM: config/scripts/common/bin/vport.sh
  */
 #define VPORT_NAME_SPACE "vportnetns"
 
+/* Sizes of the per port QoS classification arrays */
+#define SAI_VM_VPORT_QOS_DOT1P_MAX     (8)
+#define SAI_VM_VPORT_QOS_DSCP_MAX      (64)
+#define SAI_VM_VPORT_QOS_TC_MAX        (16)
+#define SAI_VM_VPORT_QOS_COLOR_MAX     (3)
+
+/* Queues of a port sent on a socket of their own, whose skb priority is the
+ * tc class of the queue. Frames of higher queues go out of the data socket. */
+#define SAI_VM_VPORT_QOS_TX_QUEUES     (8)
+
+/* DSCP or PCP of a frame left as is */
+#define SAI_VM_VPORT_QOS_NO_REMARK     (0xff)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -48,8 +65,20 @@ typedef struct _vport_desc_t {
     int data_sock;
     /* HW NPU port identifier */
     unsigned int npu_port_id;
+    /* QoS classification arrays and TX queue sockets */
+    struct _sai_vm_vport_qos_t *qos;
 } vport_desc_t;
 
+/* Outcome of the QoS classification of a frame on a port */
+typedef struct _sai_vm_vport_qos_class_t {
+    uint8_t tc;
+    uint8_t color;
+    uint8_t queue;
+    /* Egress DSCP and PCP, or SAI_VM_VPORT_QOS_NO_REMARK */
+    uint8_t dscp;
+    uint8_t dot1p;
+} sai_vm_vport_qos_class_t;
+
 typedef void (*vport_packet_rx_t)(vport_desc_t *desc);
 
 /**************************************************************************
@@ -92,6 +121,13 @@ sai_status_t sai_vport_set_switch_mac_address (const sai_mac_t *mac_address);
  ****************************************************************************/
 vport_desc_t* sai_vm_vport_get_desc(sai_npu_port_id_t port_id);
 
+/***************************************************************************
+ *  Get the front panel interface name of a virtual port, given the
+ *  associated HW NPU Port Id. This is the name of the switch interface
+ *  enslaved to the VLAN bridges, outside the virtual port namespace.
+ ****************************************************************************/
+const char* sai_vm_vport_get_if_name(sai_npu_port_id_t port_id);
+
 /***************************************************************************
  * Initialize packet I/O of the Virtual ports (opens sockets, etc.)
  ****************************************************************************/
@@ -102,6 +138,67 @@ t_std_error sai_vport_init_packet_io(void);
  ****************************************************************************/
 void sai_vport_do_packet_rx_loop(vport_packet_rx_t rx_func);
 
+/***************************************************************************
+ * Rebuild the QoS classification arrays of a virtual port from a map bound
+ * to it, generation being that of the map values. A NULL map list unbinds
+ * the maps of that type. Called with the QoS lock held, whenever a map is
+ * bound or unbound, or has its values set and no delta could be built.
+ ****************************************************************************/
+sai_status_t sai_vm_vport_qos_map_set(sai_npu_port_id_t port_id,
+                                      sai_qos_map_type_t map_type,
+                                      sai_object_id_t map_id,
+                                      uint64_t generation,
+                                      const sai_qos_map_list_t *map_list);
+
+/***************************************************************************
+ * Apply the changed entries of a map bound to a virtual port, index_list
+ * holding their index in the map value list. Ignored if the map is no
+ * longer bound or if a newer generation is already applied. Called after
+ * the QoS lock is released.
+ ****************************************************************************/
+sai_status_t sai_vm_vport_qos_map_update(sai_npu_port_id_t port_id,
+                                         sai_qos_map_type_t map_type,
+                                         sai_object_id_t map_id,
+                                         uint64_t generation,
+                                         const uint_t *index_list,
+                                         const sai_qos_map_t *entry_list,
+                                         uint_t count);
+
+/***************************************************************************
+ * Get the generation of the map values a virtual port last applied for a
+ * map type, 0 if no map of that type is bound to it.
+ ****************************************************************************/
+uint64_t sai_vm_vport_qos_map_generation_get(sai_npu_port_id_t port_id,
+                                             sai_qos_map_type_t map_type);
+
+/***************************************************************************
+ * Set the TC of frames no bound map classifies
+ ****************************************************************************/
+void sai_vm_vport_qos_default_tc_set(uint_t tc);
+
+/***************************************************************************
+ * Classify a frame on a virtual port: TC and color from its DSCP, else its
+ * PCP, then the queue and the egress DSCP/PCP from the TC and color. The
+ * tag of a frame received untagged with the tag in aux data is vlan_tci.
+ ****************************************************************************/
+void sai_vm_vport_qos_classify(const vport_desc_t *desc, const uint8_t *frame,
+                               size_t len, const uint16_t *vlan_tci,
+                               sai_vm_vport_qos_class_t *qos_class);
+
+/***************************************************************************
+ * Rewrite the DSCP and PCP of a frame as classified. IPv4 header checksum
+ * is updated. Returns true if the frame was changed.
+ ****************************************************************************/
+bool sai_vm_vport_qos_remark(uint8_t *frame, size_t len,
+                             const sai_vm_vport_qos_class_t *qos_class);
+
+/***************************************************************************
+ * Send a frame out of a virtual port, remarked and on the socket of its
+ * queue. Returns as sendto.
+ ****************************************************************************/
+ssize_t sai_vm_vport_qos_send(const vport_desc_t *desc, const void *frame,
+                              size_t len);
+
 
 #ifdef __cplusplus
 }
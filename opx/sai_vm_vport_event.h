@@ -31,6 +31,10 @@
 typedef sai_status_t (*sai_vport_oper_status_cb_t)(const sai_npu_port_id_t npu_port_id,
                                            const sai_port_oper_status_t oper_status);
 
+/* Type definition for callback function to notify the LAG module of link changes,
+ * master_if_index is the interface index of the bond the device is enslaved to, 0 if none */
+typedef void (*sai_vport_link_cb_t)(int if_index, int master_if_index, bool oper_up);
+
 /*
  * This function initializes a thread that listens to netlink events relevant to the SAI VM implementation.
  */
@@ -40,6 +44,9 @@ void sai_vm_vport_event_init(void);
 /* Set the callback function for reporting a virtual port status change */
 void sai_vm_vport_event_oper_status_callback (sai_vport_oper_status_cb_t func);
 
+/* Set the callback function for reporting link changes of LAG member and bond devices */
+void sai_vm_vport_event_link_callback (sai_vport_link_cb_t func);
+
 
 
 #endif /* __SAI_VM_VPORT_EVENT_H__ */
@@ -33,6 +33,7 @@
 #include "std_type_defs.h"
 #include "std_rbtree.h"
 #include "sai_common_infra.h"
+#include "sai_api_stats.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -169,43 +170,46 @@ static inline sai_status_t sai_acl_cntr_insert(
             == STD_ERR_OK ? SAI_STATUS_SUCCESS: SAI_STATUS_FAILURE);
 }
 
-sai_status_t sai_create_acl_counter(sai_object_id_t *acl_counter_id,
-                                    sai_object_id_t switch_id,
-                                    uint32_t attr_count,
-                                    const sai_attribute_t *attr_list)
+/*
+ * Check the attributes of an ACL counter to be created, build its node and
+ * give it an id. The table found is passed back in acl_table, which may
+ * hold the table of the previous counter of a batch to skip the lookup.
+ * Called with the ACL lock held.
+ */
+static sai_status_t sai_acl_cntr_entry_prepare(uint32_t attr_count,
+                                               const sai_attribute_t *attr_list,
+                                               sai_acl_table_t **acl_table,
+                                               sai_acl_counter_t **acl_cntr)
 {
     sai_status_t rc = SAI_STATUS_FAILURE;
-    sai_acl_table_t *acl_table = NULL;
-    sai_acl_counter_t *acl_cntr = NULL;
-    acl_node_pt acl_node = NULL;
+    sai_acl_table_t *cntr_table = NULL;
+    sai_acl_counter_t *new_cntr = NULL;
+    acl_node_pt acl_node = sai_acl_get_acl_node();
 
-    if (attr_count == 0) {
+    STD_ASSERT(acl_table != NULL);
+    STD_ASSERT(acl_cntr != NULL);
+
+    if ((attr_count == 0) || (attr_list == NULL)) {
         SAI_ACL_LOG_ERR ("Parameter attr_count is 0");
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    STD_ASSERT(attr_list != NULL);
-    STD_ASSERT(acl_counter_id != NULL);
-
-    acl_cntr = (sai_acl_counter_t *)calloc(1, sizeof(sai_acl_counter_t));
-    if (acl_cntr == NULL) {
+    new_cntr = (sai_acl_counter_t *)calloc(1, sizeof(sai_acl_counter_t));
+    if (new_cntr == NULL) {
 
         SAI_ACL_LOG_ERR ("Allocation of Memory failed for ACL Counter");
         return SAI_STATUS_NO_MEMORY;
     }
 
     do {
-        sai_acl_lock();
-        acl_node = sai_acl_get_acl_node();
-
-        rc = sai_acl_cntr_populate(acl_cntr, attr_count, attr_list);
+        rc = sai_acl_cntr_populate(new_cntr, attr_count, attr_list);
         if (rc != SAI_STATUS_SUCCESS) {
 
             SAI_ACL_LOG_ERR (" ACL Counter populate function failed");
             break;
         }
 
-        if (acl_cntr->table_id == SAI_ACL_INVALID_TABLE_ID) {
+        if (new_cntr->table_id == SAI_ACL_INVALID_TABLE_ID) {
 
             SAI_ACL_LOG_ERR ("Counter creation failed as "
                              "Table Id is not specified");
@@ -214,9 +218,13 @@ sai_status_t sai_create_acl_counter(sai_object_id_t *acl_counter_id,
             break;
         }
 
-        acl_table = sai_acl_table_find(acl_node->sai_acl_table_tree,
-                                       acl_cntr->table_id);
-        if (acl_table == NULL) {
+        cntr_table = *acl_table;
+        if ((cntr_table == NULL) ||
+            (cntr_table->table_key.acl_table_id != new_cntr->table_id)) {
+            cntr_table = sai_acl_table_find(acl_node->sai_acl_table_tree,
+                                            new_cntr->table_id);
+        }
+        if (cntr_table == NULL) {
 
             SAI_ACL_LOG_ERR ("ACL Table not present, "
                              "Counter creation failed");
@@ -225,61 +233,139 @@ sai_status_t sai_create_acl_counter(sai_object_id_t *acl_counter_id,
             break;
         }
 
-         /* If Acl table is not present, it needs to be created in the h/w*/
-        if (acl_table->npu_table_info == NULL) {
-
-            SAI_ACL_LOG_TRACE ("Table Id 0x%"PRIx64" not created in "
-                               "h/w yet", acl_cntr->table_id);
-
-            rc = sai_acl_npu_api_get()->create_acl_table(acl_table);
-            if (rc != SAI_STATUS_SUCCESS) {
-
-                SAI_ACL_LOG_ERR (" Table Creation failed "
-                           "for ACL Counter creation Table Id 0x%"PRIx64"",
-                           acl_cntr->table_id);
-                break;
-            }
-        }
-        acl_cntr->counter_key.counter_id = sai_acl_counter_id_create();
+        new_cntr->counter_key.counter_id = sai_acl_counter_id_create();
 
-        if(acl_cntr->counter_key.counter_id == SAI_NULL_OBJECT_ID)
+        if(new_cntr->counter_key.counter_id == SAI_NULL_OBJECT_ID)
         {
             rc = SAI_STATUS_FAILURE;
             break;
         }
+    } while(0);
+
+    if (rc != SAI_STATUS_SUCCESS) {
+        sai_acl_cntr_free(new_cntr);
+        return rc;
+    }
+
+    *acl_table = cntr_table;
+    *acl_cntr = new_cntr;
 
-        /* Before creating SAI ACL Software database, program the hardware.*/
-        rc = sai_acl_npu_api_get()->create_acl_cntr(acl_table, acl_cntr);
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Create the ACL table in hardware, if not done yet, for its counters */
+static sai_status_t sai_acl_cntr_table_install(sai_acl_table_t *acl_table)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+
+     /* If Acl table is not present, it needs to be created in the h/w*/
+    if (acl_table->npu_table_info == NULL) {
+
+        SAI_ACL_LOG_TRACE ("Table Id 0x%"PRIx64" not created in "
+                           "h/w yet", acl_table->table_key.acl_table_id);
+
+        rc = sai_acl_npu_api_get()->create_acl_table(acl_table);
         if (rc != SAI_STATUS_SUCCESS) {
 
-            SAI_ACL_LOG_ERR ("ACL Counter Creation failed "
-                             "in hardware for Table Id 0x%"PRIx64"",
-                             acl_cntr->table_id);
-            break;
+            SAI_ACL_LOG_ERR (" Table Creation failed "
+                       "for ACL Counter creation Table Id 0x%"PRIx64"",
+                       acl_table->table_key.acl_table_id);
         }
+    }
+
+    return rc;
+}
+
+static sai_status_t sai_acl_cntr_install(sai_acl_table_t *acl_table,
+                                         sai_acl_counter_t *acl_cntr)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+
+    rc = sai_acl_cntr_table_install(acl_table);
+    if (rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    /* Before creating SAI ACL Software database, program the hardware.*/
+    rc = sai_acl_npu_api_get()->create_acl_cntr(acl_table, acl_cntr);
+    if (rc != SAI_STATUS_SUCCESS) {
+
+        SAI_ACL_LOG_ERR ("ACL Counter Creation failed "
+                         "in hardware for Table Id 0x%"PRIx64"",
+                         acl_cntr->table_id);
+    }
+
+    return rc;
+}
+
+/*
+ * Add an ACL counter installed in hardware to the counter database. On
+ * failure the counter is removed from hardware, the node is left to the
+ * caller.
+ */
+static sai_status_t sai_acl_cntr_entry_commit(sai_acl_table_t *acl_table,
+                                              sai_acl_counter_t *acl_cntr)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    acl_node_pt acl_node = sai_acl_get_acl_node();
+
+    SAI_ACL_LOG_INFO ("ACL Counter Id 0x%"PRIx64" successfully created in hardware",
+                      acl_cntr->counter_key.counter_id);
 
-        SAI_ACL_LOG_INFO ("ACL Counter Id 0x%"PRIx64" successfully created in hardware",
-                          acl_cntr->counter_key.counter_id);
+    /* Insert the ACL counter node in the RB Tree. */
+    rc = sai_acl_cntr_insert(acl_node->sai_acl_counter_tree, acl_cntr);
+    if (rc != SAI_STATUS_SUCCESS) {
 
-        /* Insert the ACL counter node in the RB Tree. */
-        rc = sai_acl_cntr_insert(acl_node->sai_acl_counter_tree, acl_cntr);
+        SAI_ACL_LOG_ERR ("Insertion of ACL Counter "
+                         "Id 0x%"PRIx64" failed rc %d",
+                         acl_cntr->counter_key.counter_id, rc);
+
+        sai_acl_npu_api_get()->delete_acl_cntr(acl_cntr);
+        return rc;
+    }
+
+    acl_table->num_counters++;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_create_acl_counter(sai_object_id_t *acl_counter_id,
+                                    sai_object_id_t switch_id,
+                                    uint32_t attr_count,
+                                    const sai_attribute_t *attr_list)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    sai_acl_table_t *acl_table = NULL;
+    sai_acl_counter_t *acl_cntr = NULL;
+
+    if (attr_count == 0) {
+        SAI_ACL_LOG_ERR ("Parameter attr_count is 0");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    STD_ASSERT(attr_list != NULL);
+    STD_ASSERT(acl_counter_id != NULL);
+
+    sai_acl_lock();
+    do {
+        rc = sai_acl_cntr_entry_prepare(attr_count, attr_list,
+                                        &acl_table, &acl_cntr);
         if (rc != SAI_STATUS_SUCCESS) {
+            break;
+        }
 
-            SAI_ACL_LOG_ERR ("Insertion of ACL Counter "
-                             "Id 0x%"PRIx64" failed rc %d",
-                             acl_cntr->counter_key.counter_id, rc);
+        rc = sai_acl_cntr_install(acl_table, acl_cntr);
+        if (rc == SAI_STATUS_SUCCESS) {
+            rc = sai_acl_cntr_entry_commit(acl_table, acl_cntr);
+        }
+        if (rc != SAI_STATUS_SUCCESS) {
+            sai_acl_cntr_free(acl_cntr);
             break;
         }
 
         *acl_counter_id = acl_cntr->counter_key.counter_id;
-        acl_table->num_counters++;
-
     } while(0);
 
-    if (rc != SAI_STATUS_SUCCESS) {
-        sai_acl_cntr_free(acl_cntr);
-    }
-
     sai_acl_unlock();
     return rc;
 }
@@ -294,12 +380,17 @@ static sai_acl_counter_t *sai_acl_cntr_remove(rbtree_handle sai_acl_counter_tree
                                                    acl_cntr);
 }
 
-sai_status_t sai_delete_acl_counter(sai_object_id_t acl_counter_id)
+/*
+ * Find an ACL counter to be deleted and take it out of the counter
+ * database, so that it is found only once in a batch. On success the
+ * counter is to be deleted from hardware, then released or put back in
+ * the counter database. Called with the ACL lock held.
+ */
+static sai_status_t sai_acl_cntr_entry_detach(sai_object_id_t acl_counter_id,
+                                              sai_acl_counter_t **acl_cntr)
 {
-    sai_status_t rc = SAI_STATUS_SUCCESS;
     sai_acl_counter_t *acl_counter = NULL;
-    sai_acl_table_t *acl_table = NULL;
-    acl_node_pt acl_node = NULL;
+    acl_node_pt acl_node = sai_acl_get_acl_node();
 
     if (!sai_is_obj_id_acl_counter(acl_counter_id)) {
         SAI_ACL_LOG_ERR ("ACL Counter Id 0x%"PRIx64" is not "
@@ -307,29 +398,81 @@ sai_status_t sai_delete_acl_counter(sai_object_id_t acl_counter_id)
         return SAI_STATUS_INVALID_OBJECT_TYPE;
     }
 
-    do {
-        sai_acl_lock();
+    acl_counter = sai_acl_cntr_find(acl_node->sai_acl_counter_tree,
+                                    acl_counter_id);
+    if (acl_counter == NULL) {
 
-        acl_node = sai_acl_get_acl_node();
+       /* ACL Counter deletion request is invalid as the counter id
+        * does not exist */
+        SAI_ACL_LOG_ERR ("ACL Counter Id 0x%"PRIx64" not present",
+                         acl_counter_id);
 
-        acl_counter = sai_acl_cntr_find(acl_node->sai_acl_counter_tree,
-                                        acl_counter_id);
-        if (acl_counter == NULL) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
 
-           /* ACL Counter deletion request is invalid as the counter id
-            * does not exist */
-            SAI_ACL_LOG_ERR ("ACL Counter Id 0x%"PRIx64" not present",
-                             acl_counter_id);
+    if (acl_counter->shared_count != 0) {
+         SAI_ACL_LOG_ERR ("Failed to delete Counter 0x%"PRIx64" "
+                          " as it is still in use",
+                          acl_counter->counter_key.counter_id);
+        return SAI_STATUS_OBJECT_IN_USE;
+    }
 
-            rc= SAI_STATUS_INVALID_OBJECT_ID;
-            break;
-        }
+    if (sai_acl_cntr_remove(acl_node->sai_acl_counter_tree,
+                            acl_counter) == NULL) {
+
+        /*Removal from RB Tree failed */
+        SAI_ACL_LOG_ERR ("Failure removing ACL Counter Id 0x%"PRIx64" "
+                         "from Counter DB, counter deletion failed",
+                         acl_counter_id);
+
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    *acl_cntr = acl_counter;
+
+    return SAI_STATUS_SUCCESS;
+}
 
-        if (acl_counter->shared_count != 0) {
-             SAI_ACL_LOG_ERR ("Failed to delete Counter 0x%"PRIx64" "
-                              " as it is still in use",
-                              acl_counter->counter_key.counter_id);
-            rc = SAI_STATUS_OBJECT_IN_USE;
+/* Put back an ACL counter which could not be deleted from hardware */
+static void sai_acl_cntr_entry_restore(sai_acl_counter_t *acl_cntr)
+{
+    acl_node_pt acl_node = sai_acl_get_acl_node();
+
+    if (sai_acl_cntr_insert(acl_node->sai_acl_counter_tree, acl_cntr)
+        != SAI_STATUS_SUCCESS) {
+        SAI_ACL_LOG_ERR ("Failed to restore ACL Counter Id 0x%"PRIx64" "
+                         "in Counter DB", acl_cntr->counter_key.counter_id);
+    }
+}
+
+/* Release an ACL counter detached and deleted from hardware */
+static void sai_acl_cntr_entry_release(sai_acl_counter_t *acl_cntr)
+{
+    sai_acl_table_t *acl_table = NULL;
+    acl_node_pt acl_node = sai_acl_get_acl_node();
+    sai_object_id_t acl_counter_id = acl_cntr->counter_key.counter_id;
+
+    acl_table = sai_acl_table_find(acl_node->sai_acl_table_tree,
+                                   acl_cntr->table_id);
+    STD_ASSERT(acl_table != NULL);
+    acl_table->num_counters--;
+
+    /* Finally free the ACL counter memory */
+    sai_acl_cntr_free(acl_cntr);
+
+    SAI_ACL_LOG_INFO ("ACL Counter Id 0x%"PRIx64" successfully removed "
+                      "from hardware", acl_counter_id);
+}
+
+sai_status_t sai_delete_acl_counter(sai_object_id_t acl_counter_id)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+    sai_acl_counter_t *acl_counter = NULL;
+
+    sai_acl_lock();
+    do {
+        rc = sai_acl_cntr_entry_detach(acl_counter_id, &acl_counter);
+        if (rc != SAI_STATUS_SUCCESS) {
             break;
         }
 
@@ -341,37 +484,274 @@ sai_status_t sai_delete_acl_counter(sai_object_id_t acl_counter_id)
             SAI_ACL_LOG_ERR ("Failure deleting ACL Counter "
                              "Id 0x%"PRIx64" from hardware, counter deletion failed",
                              acl_counter_id);
+            sai_acl_cntr_entry_restore(acl_counter);
             break;
         }
 
-        /* Update all the SAI ACL data structures */
-        acl_counter = sai_acl_cntr_remove(acl_node->sai_acl_counter_tree,
-                                          acl_counter);
-        if (acl_counter == NULL) {
+        sai_acl_cntr_entry_release(acl_counter);
+    } while(0);
 
-            /*Removal from RB Tree failed */
-            SAI_ACL_LOG_ERR ("Failure removing ACL Counter Id 0x%"PRIx64" "
-                             "from Counter DB, counter deletion failed",
-                             acl_counter_id);
+    sai_acl_unlock();
+    return rc;
+}
 
-            rc = SAI_STATUS_ITEM_NOT_FOUND;
-            break;
+/*
+ * Install a run of counters of one table in hardware with one NPU call.
+ * On failure none of the counters is installed and the caller installs
+ * them one at a time.
+ */
+static sai_status_t sai_acl_cntr_batch_install(sai_acl_table_t *acl_table,
+                                               uint_t count,
+                                               sai_acl_counter_t **cntr_list)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+
+    if (sai_acl_npu_api_get()->create_acl_cntrs == NULL) {
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    rc = sai_acl_cntr_table_install(acl_table);
+    if (rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    rc = sai_acl_npu_api_get()->create_acl_cntrs(acl_table, count, cntr_list);
+    if (rc != SAI_STATUS_SUCCESS) {
+        SAI_ACL_LOG_TRACE ("Batch of %u ACL Counters failed in Table Id "
+                           "0x%"PRIx64", installing one at a time", count,
+                           acl_table->table_key.acl_table_id);
+    }
+
+    return rc;
+}
+
+/*
+ * Bulk ACL counter APIs, on the model of the bulk ACL rule APIs. Counters
+ * of the same table following each other in a create batch, and all the
+ * counters of a remove batch, go to the NPU with one call.
+ */
+static sai_status_t sai_acl_counters_create(sai_object_id_t switch_id,
+                                            uint32_t object_count,
+                                            const uint32_t *attr_count,
+                                            const sai_attribute_t **attr_list,
+                                            sai_bulk_op_error_mode_t mode,
+                                            sai_object_id_t *object_id,
+                                            sai_status_t *object_statuses)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    sai_status_t batch_rc = SAI_STATUS_FAILURE;
+    sai_acl_table_t *acl_table = NULL;
+    sai_acl_table_t **table_list = NULL;
+    sai_acl_counter_t **cntr_list = NULL;
+    uint32_t *index_list = NULL;
+    uint32_t valid_count = 0;
+    uint32_t idx = 0, run_end = 0;
+    bool stop = false;
+
+    rc = sai_acl_bulk_params_validate(object_count, mode, object_statuses);
+    if (rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    if ((attr_count == NULL) || (attr_list == NULL) || (object_id == NULL)) {
+        SAI_ACL_LOG_ERR ("Invalid bulk ACL Counter create parameters");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for (idx = 0; idx < object_count; idx++) {
+        object_id[idx] = SAI_NULL_OBJECT_ID;
+    }
+
+    table_list = (sai_acl_table_t **)calloc(object_count, sizeof(*table_list));
+    cntr_list = (sai_acl_counter_t **)calloc(object_count, sizeof(*cntr_list));
+    index_list = (uint32_t *)calloc(object_count, sizeof(*index_list));
+
+    if ((table_list == NULL) || (cntr_list == NULL) || (index_list == NULL)) {
+        SAI_ACL_LOG_ERR ("No memory for bulk create of %u ACL Counters",
+                         object_count);
+        free(table_list);
+        free(cntr_list);
+        free(index_list);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_acl_lock();
+
+    for (idx = 0; idx < object_count; idx++) {
+        rc = sai_acl_cntr_entry_prepare(attr_count[idx], attr_list[idx],
+                                        &acl_table, &cntr_list[valid_count]);
+        if (rc != SAI_STATUS_SUCCESS) {
+            object_statuses[idx] = rc;
+            if (mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                break;
+            }
+            continue;
         }
+        table_list[valid_count] = acl_table;
+        index_list[valid_count] = idx;
+        valid_count++;
+    }
 
-        acl_table = sai_acl_table_find(acl_node->sai_acl_table_tree,
-                                       acl_counter->table_id);
-        STD_ASSERT(acl_table != NULL);
-        acl_table->num_counters--;
+    idx = 0;
+    while ((idx < valid_count) && !stop) {
+        acl_table = table_list[idx];
+        for (run_end = idx + 1;
+             (run_end < valid_count) && (table_list[run_end] == acl_table);
+             run_end++);
 
-        /* Finally free the ACL counter memory */
-        sai_acl_cntr_free(acl_counter);
+        batch_rc = sai_acl_cntr_batch_install(acl_table, run_end - idx,
+                                              &cntr_list[idx]);
 
-        SAI_ACL_LOG_INFO ("ACL Counter Id 0x%"PRIx64" successfully removed "
-                          "from hardware", acl_counter_id);
-    } while(0);
+        for (; idx < run_end; idx++) {
+            rc = batch_rc;
+            if (rc != SAI_STATUS_SUCCESS) {
+                rc = sai_acl_cntr_install(acl_table, cntr_list[idx]);
+            }
+            if (rc == SAI_STATUS_SUCCESS) {
+                rc = sai_acl_cntr_entry_commit(acl_table, cntr_list[idx]);
+            }
+            object_statuses[index_list[idx]] = rc;
+
+            if (rc != SAI_STATUS_SUCCESS) {
+                sai_acl_cntr_free(cntr_list[idx]);
+                if (mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                    stop = true;
+                    idx++;
+                    break;
+                }
+                continue;
+            }
+            object_id[index_list[idx]] = cntr_list[idx]->counter_key.counter_id;
+        }
+    }
+
+    /* Counters not executed after a stop on error */
+    for (; idx < valid_count; idx++) {
+        if ((batch_rc == SAI_STATUS_SUCCESS) && (idx < run_end)) {
+            sai_acl_npu_api_get()->delete_acl_cntr(cntr_list[idx]);
+        }
+        sai_acl_cntr_free(cntr_list[idx]);
+    }
 
     sai_acl_unlock();
-    return rc;
+
+    free(table_list);
+    free(cntr_list);
+    free(index_list);
+
+    return sai_acl_bulk_status_get(object_count, object_statuses);
+}
+
+sai_status_t sai_bulk_create_acl_counter(sai_object_id_t switch_id,
+                                         uint32_t object_count,
+                                         const uint32_t *attr_count,
+                                         const sai_attribute_t **attr_list,
+                                         sai_bulk_op_error_mode_t mode,
+                                         sai_object_id_t *object_id,
+                                         sai_status_t *object_statuses)
+{
+    SAI_API_STATS_BULK_CALL (SAI_API_STATS_BULK_ACL_COUNTER_CREATE, object_count,
+                             sai_acl_counters_create(switch_id, object_count, attr_count,
+                                                     attr_list, mode, object_id,
+                                                     object_statuses));
+}
+
+static sai_status_t sai_acl_counters_remove(uint32_t object_count,
+                                            const sai_object_id_t *object_id,
+                                            sai_bulk_op_error_mode_t mode,
+                                            sai_status_t *object_statuses)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    sai_status_t batch_rc = SAI_STATUS_NOT_SUPPORTED;
+    sai_acl_counter_t **cntr_list = NULL;
+    uint32_t *index_list = NULL;
+    uint32_t valid_count = 0;
+    uint32_t idx = 0;
+
+    rc = sai_acl_bulk_params_validate(object_count, mode, object_statuses);
+    if (rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    if (object_id == NULL) {
+        SAI_ACL_LOG_ERR ("Invalid bulk ACL Counter remove parameters");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    cntr_list = (sai_acl_counter_t **)calloc(object_count, sizeof(*cntr_list));
+    index_list = (uint32_t *)calloc(object_count, sizeof(*index_list));
+
+    if ((cntr_list == NULL) || (index_list == NULL)) {
+        SAI_ACL_LOG_ERR ("No memory for bulk remove of %u ACL Counters",
+                         object_count);
+        free(cntr_list);
+        free(index_list);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_acl_lock();
+
+    for (idx = 0; idx < object_count; idx++) {
+        rc = sai_acl_cntr_entry_detach(object_id[idx], &cntr_list[valid_count]);
+        if (rc != SAI_STATUS_SUCCESS) {
+            object_statuses[idx] = rc;
+            if (mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                break;
+            }
+            continue;
+        }
+        index_list[valid_count] = idx;
+        valid_count++;
+    }
+
+    if ((valid_count != 0) &&
+        (sai_acl_npu_api_get()->delete_acl_cntrs != NULL)) {
+        batch_rc = sai_acl_npu_api_get()->delete_acl_cntrs(valid_count,
+                                                           cntr_list);
+    }
+
+    for (idx = 0; idx < valid_count; idx++) {
+        rc = batch_rc;
+        if (rc != SAI_STATUS_SUCCESS) {
+            rc = sai_acl_npu_api_get()->delete_acl_cntr(cntr_list[idx]);
+        }
+        object_statuses[index_list[idx]] = rc;
+
+        if (rc != SAI_STATUS_SUCCESS) {
+            SAI_ACL_LOG_ERR ("Failure deleting ACL Counter "
+                             "Id 0x%"PRIx64" from hardware",
+                             object_id[index_list[idx]]);
+            sai_acl_cntr_entry_restore(cntr_list[idx]);
+            if (mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                idx++;
+                break;
+            }
+            continue;
+        }
+        sai_acl_cntr_entry_release(cntr_list[idx]);
+    }
+
+    /* Counters not executed after a stop on error are still in hardware */
+    for (; idx < valid_count; idx++) {
+        sai_acl_cntr_entry_restore(cntr_list[idx]);
+    }
+
+    sai_acl_unlock();
+
+    free(cntr_list);
+    free(index_list);
+
+    return sai_acl_bulk_status_get(object_count, object_statuses);
+}
+
+sai_status_t sai_bulk_remove_acl_counter(uint32_t object_count,
+                                         const sai_object_id_t *object_id,
+                                         sai_bulk_op_error_mode_t mode,
+                                         sai_status_t *object_statuses)
+{
+    SAI_API_STATS_BULK_CALL (SAI_API_STATS_BULK_ACL_COUNTER_REMOVE, object_count,
+                             sai_acl_counters_remove(object_count, object_id, mode,
+                                                     object_statuses));
 }
 
 static sai_status_t sai_acl_cntr_util_get_attr_count_value(
@@ -31,6 +31,18 @@
 
 #include <inttypes.h>
 #include <arpa/inet.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ACL objects walked per hold of the ACL lock by the ACL dumps */
+#define SAI_ACL_DBG_DUMP_CHUNK (256)
+
+/* ACL trees walked by the ACL dumps */
+typedef enum _sai_acl_dump_tree_t {
+    SAI_ACL_DUMP_TREE_RULE,
+    SAI_ACL_DUMP_TREE_COUNTER,
+    SAI_ACL_DUMP_TREE_TABLE
+} sai_acl_dump_tree_t;
 
 static const struct {
     sai_acl_table_attr_t table_field;
@@ -384,87 +396,270 @@ void sai_acl_dump_rule_action(sai_acl_rule_t *acl_rule)
         }
     }
 }
+
+/*
+ * Walks an ACL tree in chunks under short holds of the ACL lock, each hold
+ * resuming with a getnext from the id of the last node walked. The ids
+ * of a chunk are printed with the lock released, each dump taking its
+ * own copy of the object under a short hold, so ACL programming is not
+ * held off for the whole dump. Only the rules of table_id are collected
+ * from the rule tree.
+ */
+static uint_t sai_acl_dump_ids_get(sai_acl_dump_tree_t tree_type,
+                                   sai_object_id_t table_id,
+                                   sai_object_id_t *last_id,
+                                   sai_object_id_t *id_list, bool *is_end)
+{
+    acl_node_pt acl_node = NULL;
+    rbtree_handle tree = NULL;
+    sai_acl_rule_t key_rule;
+    sai_acl_counter_t key_counter;
+    sai_acl_table_t key_table;
+    void *node = NULL;
+    void *key = NULL;
+    uint_t walked = 0;
+    uint_t id_count = 0;
+
+    memset(&key_rule, 0, sizeof(key_rule));
+    memset(&key_counter, 0, sizeof(key_counter));
+    memset(&key_table, 0, sizeof(key_table));
+
+    sai_acl_lock();
+
+    acl_node = sai_acl_get_acl_node();
+    if (acl_node != NULL) {
+        if (tree_type == SAI_ACL_DUMP_TREE_RULE) {
+            tree = acl_node->sai_acl_rule_tree;
+            key_rule.rule_key.acl_id = *last_id;
+            key = &key_rule;
+        } else if (tree_type == SAI_ACL_DUMP_TREE_COUNTER) {
+            tree = acl_node->sai_acl_counter_tree;
+            key_counter.counter_key.counter_id = *last_id;
+            key = &key_counter;
+        } else {
+            tree = acl_node->sai_acl_table_tree;
+            key_table.table_key.acl_table_id = *last_id;
+            key = &key_table;
+        }
+    }
+
+    if (tree != NULL) {
+        node = std_rbtree_getnext(tree, key);
+    }
+
+    while ((node != NULL) && (walked < SAI_ACL_DBG_DUMP_CHUNK)) {
+        walked++;
+
+        if (tree_type == SAI_ACL_DUMP_TREE_RULE) {
+            *last_id = ((sai_acl_rule_t *)node)->rule_key.acl_id;
+            if (((sai_acl_rule_t *)node)->table_id == table_id) {
+                id_list[id_count++] = *last_id;
+            }
+        } else if (tree_type == SAI_ACL_DUMP_TREE_COUNTER) {
+            *last_id = ((sai_acl_counter_t *)node)->counter_key.counter_id;
+            id_list[id_count++] = *last_id;
+        } else {
+            *last_id = ((sai_acl_table_t *)node)->table_key.acl_table_id;
+            id_list[id_count++] = *last_id;
+        }
+
+        node = std_rbtree_getnext(tree, node);
+    }
+
+    *is_end = (node == NULL);
+
+    sai_acl_unlock();
+
+    return id_count;
+}
+
+static void sai_acl_dump_tree(sai_acl_dump_tree_t tree_type,
+                              sai_object_id_t table_id)
+{
+    sai_object_id_t *id_list = NULL;
+    sai_object_id_t last_id = SAI_NULL_OBJECT_ID;
+    uint_t id_count = 0;
+    uint_t dump_count = 0;
+    uint_t idx = 0;
+    bool is_end = false;
+
+    id_list = (sai_object_id_t *)calloc(SAI_ACL_DBG_DUMP_CHUNK,
+                                        sizeof(sai_object_id_t));
+    if (id_list == NULL) {
+        SAI_DEBUG("Failed to allocate the ACL dump buffer");
+        return;
+    }
+
+    while (!is_end) {
+        id_count = sai_acl_dump_ids_get(tree_type, table_id, &last_id,
+                                        id_list, &is_end);
+
+        for (idx = 0; idx < id_count; idx++) {
+            if (tree_type == SAI_ACL_DUMP_TREE_RULE) {
+                sai_acl_dump_rule(id_list[idx]);
+            } else if (tree_type == SAI_ACL_DUMP_TREE_COUNTER) {
+                sai_acl_dump_counter(id_list[idx]);
+            } else {
+                sai_acl_dump_table(id_list[idx]);
+            }
+        }
+
+        dump_count += id_count;
+    }
+
+    free(id_list);
+
+    if (dump_count == 0) {
+        if (tree_type == SAI_ACL_DUMP_TREE_RULE) {
+            SAI_DEBUG("No Rules present in Table 0x%"PRIx64"", table_id);
+        } else if (tree_type == SAI_ACL_DUMP_TREE_COUNTER) {
+            SAI_DEBUG("ACL Counter not present in the ACL Counter tree");
+        } else {
+            SAI_DEBUG("No ACL Table present in the ACL Table tree");
+        }
+    }
+}
+
 void sai_acl_dump_counter(sai_object_id_t counter_id)
 {
     acl_node_pt acl_node = NULL;
     sai_acl_counter_t *acl_counter = NULL;
+    sai_acl_counter_t counter_copy;
 
+    sai_acl_lock();
     acl_node = sai_acl_get_acl_node();
     acl_counter = sai_acl_cntr_find(acl_node->sai_acl_counter_tree,
                                        counter_id);
 
     if (acl_counter == NULL) {
+        sai_acl_unlock();
         SAI_DEBUG(" ACL Counter Id 0x%"PRIx64" not found", counter_id);
         return;
     }
 
+    memcpy(&counter_copy, acl_counter, sizeof(counter_copy));
+
+    /* The NPU dump reads the NPU state of the live counter */
+    sai_acl_npu_api_get()->dump_acl_counter(acl_counter);
+    sai_acl_unlock();
+
     SAI_DEBUG("\n ********** Dumping ACL Counter Id: 0x%"PRIx64" ********** \n", counter_id);
 
     SAI_DEBUG("Counter Id: 0x%"PRIx64", Counter Table Id: 0x%"PRIx64" \n"
               "Counter Type: %s, Counter Shared Count: %d",
-              acl_counter->counter_key.counter_id,
-              acl_counter->table_id,
-              (acl_counter->counter_type == SAI_ACL_COUNTER_BYTES ? "Bytes" :
-              acl_counter->counter_type == SAI_ACL_COUNTER_PACKETS ? "Packets" :
-              acl_counter->counter_type == SAI_ACL_COUNTER_BYTES_PACKETS ? "Bytes/Packets"
-              : "Unknown"), acl_counter->shared_count);
-
-    sai_acl_npu_api_get()->dump_acl_counter(acl_counter);
+              counter_copy.counter_key.counter_id,
+              counter_copy.table_id,
+              (counter_copy.counter_type == SAI_ACL_COUNTER_BYTES ? "Bytes" :
+              counter_copy.counter_type == SAI_ACL_COUNTER_PACKETS ? "Packets" :
+              counter_copy.counter_type == SAI_ACL_COUNTER_BYTES_PACKETS ? "Bytes/Packets"
+              : "Unknown"), counter_copy.shared_count);
 
     return;
 }
 
 void sai_acl_dump_all_counters(void)
 {
-    acl_node_pt acl_node = NULL;
-    sai_acl_counter_t *acl_counter = NULL;
-    rbtree_handle acl_counter_tree = NULL;
+    sai_acl_dump_tree(SAI_ACL_DUMP_TREE_COUNTER, SAI_NULL_OBJECT_ID);
 
-    acl_node = sai_acl_get_acl_node();
-    if (acl_node == NULL)
-    {
-        SAI_DEBUG("ACL Parent Node not present");
-        return;
-    }
+    return;
+}
 
-    acl_counter_tree = acl_node->sai_acl_counter_tree;
+static void sai_acl_dump_rule_copy_free(sai_acl_rule_t *acl_rule)
+{
+    uint_t filter = 0, action = 0;
+
+    if (acl_rule->filter_list != NULL) {
+        for (filter = 0; filter < acl_rule->filter_count; filter++) {
+             if (sai_acl_object_list_field_attr(acl_rule->filter_list[filter].field)) {
+                 free(acl_rule->filter_list[filter].match_data.obj_list.list);
+             } else if (sai_acl_rule_udf_field_attr_range(
+                                acl_rule->filter_list[filter].field)) {
+                 free(acl_rule->filter_list[filter].match_data.u8_list.list);
+                 free(acl_rule->filter_list[filter].match_mask.u8_list.list);
+             }
+        }
+        free(acl_rule->filter_list);
+    }
 
-    if(acl_counter_tree == NULL)
-    {
-        SAI_DEBUG("ACL Counter not present");
-        return;
+    if (acl_rule->action_list != NULL) {
+        for (action = 0; action < acl_rule->action_count; action++) {
+             if (sai_acl_object_list_action_attr(acl_rule->action_list[action].action)) {
+                 free(acl_rule->action_list[action].parameter.obj_list.list);
+             }
+        }
+        free(acl_rule->action_list);
     }
+}
 
+/* Copy of a rule and of its filter and action lists, for printing with
+   the ACL lock released */
+static sai_status_t sai_acl_dump_rule_copy(sai_acl_rule_t *dst_rule,
+                                           sai_acl_rule_t *src_rule)
+{
+    uint_t filter = 0, action = 0;
 
-    acl_counter = (sai_acl_counter_t *)std_rbtree_getfirst(acl_counter_tree);
-    if (acl_counter == NULL)
-    {
-        SAI_DEBUG("ACL Counter not present in the ACL Counter tree");
-        return;
+    memcpy(dst_rule, src_rule, sizeof(*dst_rule));
+    dst_rule->npu_rule_info = NULL;
+
+    dst_rule->filter_list = (sai_acl_filter_t *)calloc(src_rule->filter_count + 1,
+                                                       sizeof(sai_acl_filter_t));
+    dst_rule->action_list = (sai_acl_action_t *)calloc(src_rule->action_count + 1,
+                                                       sizeof(sai_acl_action_t));
+
+    if ((dst_rule->filter_list == NULL) || (dst_rule->action_list == NULL)) {
+        sai_acl_dump_rule_copy_free(dst_rule);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    for (filter = 0; filter < src_rule->filter_count; filter++) {
+         if (sai_acl_rule_copy_filter(&dst_rule->filter_list[filter],
+                                      &src_rule->filter_list[filter])
+             != SAI_STATUS_SUCCESS) {
+             sai_acl_dump_rule_copy_free(dst_rule);
+             return SAI_STATUS_NO_MEMORY;
+         }
     }
 
-    for ( ; acl_counter != NULL; acl_counter = (sai_acl_counter_t *)
-          std_rbtree_getnext(acl_counter_tree, acl_counter))
-    {
-        sai_acl_dump_counter(acl_counter->counter_key.counter_id);
+    for (action = 0; action < src_rule->action_count; action++) {
+         if (sai_acl_rule_copy_action(&dst_rule->action_list[action],
+                                      &src_rule->action_list[action])
+             != SAI_STATUS_SUCCESS) {
+             sai_acl_dump_rule_copy_free(dst_rule);
+             return SAI_STATUS_NO_MEMORY;
+         }
     }
 
-    return;
+    return SAI_STATUS_SUCCESS;
 }
 
 void sai_acl_dump_rule(sai_object_id_t rule_id)
 {
     sai_acl_rule_t *acl_rule = NULL;
     acl_node_pt acl_node = NULL;
+    sai_acl_rule_t rule_copy;
+    sai_status_t rc = SAI_STATUS_FAILURE;
 
+    sai_acl_lock();
     acl_node = sai_acl_get_acl_node();
     acl_rule = sai_acl_rule_find(acl_node->sai_acl_rule_tree, rule_id);
 
     if (acl_rule == NULL) {
+        sai_acl_unlock();
         SAI_DEBUG("ACL Rule not present for Rule ID 0x%"PRIx64"", rule_id);
         return;
     }
 
+    rc = sai_acl_dump_rule_copy(&rule_copy, acl_rule);
+
+    /* The NPU dump reads the NPU state of the live rule */
+    sai_acl_npu_api_get()->dump_acl_rule(acl_rule);
+    sai_acl_unlock();
+
+    if (rc != SAI_STATUS_SUCCESS) {
+        SAI_DEBUG("Failed to copy ACL Rule 0x%"PRIx64" for the dump", rule_id);
+        return;
+    }
+
     SAI_DEBUG("\n ******* Dumping ACL Rule Id: 0x%"PRIx64" ******* \n", rule_id);
     SAI_DEBUG("Rule Id: 0x%"PRIx64", Rule Priority: %d, Rule Table Id: 0x%"PRIx64"\n "
               "Rule Admin State: %s, Rule Filter Count: %d, "
@@ -472,59 +667,58 @@ void sai_acl_dump_rule(sai_object_id_t rule_id)
               "Rule Ingress SamplePacket Id: 0x%"PRIx64", \n "
               "Rule Egress SamplePacket Id: 0x%"PRIx64", "
               "Rule Policer Id: 0x%"PRIx64" ",
-              acl_rule->rule_key.acl_id, acl_rule->acl_rule_priority,
-              acl_rule->table_id, acl_rule->acl_rule_state ? "Enable" : "Disable",
-              acl_rule->filter_count, acl_rule->action_count,
-              acl_rule->counter_id, acl_rule->samplepacket_id[0],
-              acl_rule->samplepacket_id[1],
-              acl_rule->policer_id);
+              rule_copy.rule_key.acl_id, rule_copy.acl_rule_priority,
+              rule_copy.table_id, rule_copy.acl_rule_state ? "Enable" : "Disable",
+              rule_copy.filter_count, rule_copy.action_count,
+              rule_copy.counter_id, rule_copy.samplepacket_id[0],
+              rule_copy.samplepacket_id[1],
+              rule_copy.policer_id);
 
     SAI_DEBUG("\nQualifier Set in the Rule");
     SAI_DEBUG("-------------------------");
 
-    sai_acl_dump_rule_qual(acl_rule);
+    sai_acl_dump_rule_qual(&rule_copy);
 
     SAI_DEBUG("\nAction Set in the Rule");
     SAI_DEBUG("-------------------------");
 
-    sai_acl_dump_rule_action(acl_rule);
+    sai_acl_dump_rule_action(&rule_copy);
 
-    sai_acl_npu_api_get()->dump_acl_rule(acl_rule);
+    sai_acl_dump_counter(rule_copy.counter_id);
 
-    sai_acl_dump_counter(acl_rule->counter_id);
+    sai_acl_dump_rule_copy_free(&rule_copy);
     return;
 }
 
 void sai_acl_dump_all_rules_in_table (sai_object_id_t table_id)
 {
     acl_node_pt acl_node = NULL;
-    sai_acl_rule_t *acl_rule = NULL;
     sai_acl_table_t *acl_table = NULL;
+    uint_t rule_count = 0;
 
+    sai_acl_lock();
     acl_node = sai_acl_get_acl_node();
     acl_table = sai_acl_table_find(acl_node->sai_acl_table_tree,
                                    table_id);
+    if (acl_table != NULL) {
+        rule_count = acl_table->rule_count;
+    }
+    sai_acl_unlock();
 
     if (acl_table == NULL) {
         SAI_DEBUG(" ACL Table Id 0x%"PRIx64" not found", table_id);
         return;
     }
 
-    acl_rule = (sai_acl_rule_t *)std_dll_getfirst(&acl_table->rule_head);
-
-    if (acl_rule == NULL) {
+    if (rule_count == 0) {
         SAI_DEBUG("No Rules present in Table 0x%"PRIx64"", table_id);
         return;
     }
 
     SAI_DEBUG("\n ***** Dumping all Rules in ACL Table Id: 0x%"PRIx64" *****", table_id);
     SAI_DEBUG("-------------------------------------------------------------");
-    while (acl_rule != NULL)
-    {
-        sai_acl_dump_rule(acl_rule->rule_key.acl_id);
-        acl_rule = (sai_acl_rule_t *)std_dll_getnext(&acl_table->rule_head,
-                                                     &acl_rule->rule_link);
-    }
+
+    sai_acl_dump_tree(SAI_ACL_DUMP_TREE_RULE, table_id);
 
     return;
 }
@@ -534,45 +728,73 @@ void sai_acl_dump_table(sai_object_id_t table_id)
     uint_t field = 0, field_idx = 0;
     acl_node_pt acl_node = NULL;
     sai_acl_table_t *acl_table = NULL;
+    sai_acl_table_t table_copy;
     uint_t udf_field_cnt = 0;
     bool udf_fields = false;
 
+    memset(&table_copy, 0, sizeof(table_copy));
+
+    sai_acl_lock();
     acl_node = sai_acl_get_acl_node();
     acl_table = sai_acl_table_find(acl_node->sai_acl_table_tree,
                                    table_id);
 
     if (acl_table == NULL) {
+        sai_acl_unlock();
         SAI_DEBUG(" ACL Table Id 0x%"PRIx64" not found", table_id);
         return;
     }
 
+    table_copy.table_key = acl_table->table_key;
+    table_copy.acl_table_priority = acl_table->acl_table_priority;
+    table_copy.acl_stage = acl_table->acl_stage;
+    table_copy.rule_count = acl_table->rule_count;
+    table_copy.num_counters = acl_table->num_counters;
+    table_copy.field_list = (sai_acl_table_attr_t *)calloc(acl_table->field_count + 1,
+                                                     sizeof(sai_acl_table_attr_t));
+    table_copy.udf_field_list = (sai_acl_udf_field_t *)calloc(acl_table->udf_field_count + 1,
+                                                        sizeof(sai_acl_udf_field_t));
+
+    if ((table_copy.field_list != NULL) && (table_copy.udf_field_list != NULL)) {
+        table_copy.field_count = acl_table->field_count;
+        table_copy.udf_field_count = acl_table->udf_field_count;
+        memcpy(table_copy.field_list, acl_table->field_list,
+               acl_table->field_count * sizeof(sai_acl_table_attr_t));
+        memcpy(table_copy.udf_field_list, acl_table->udf_field_list,
+               acl_table->udf_field_count * sizeof(sai_acl_udf_field_t));
+    }
+
+    /* The NPU dump reads the NPU state of the live table */
+    sai_acl_npu_api_get()->dump_acl_table(acl_table);
+    sai_acl_unlock();
+
     SAI_DEBUG("\n ********** Dumping ACL Table Id: 0x%"PRIx64" ********** \n", table_id);
 
     SAI_DEBUG("Table Id: 0x%"PRIx64", Priority: %lu , Stage: %s, \n "
               "Qualifier Count: %d, Number of Rules: %d "
               "Number of Counters: %d, UDF Count : %d\n",
-              acl_table->table_key.acl_table_id,
-              acl_table->acl_table_priority, acl_table->acl_stage ? "Egress" :
-              "Ingress", acl_table->field_count, acl_table->rule_count,
-              acl_table->num_counters, acl_table->udf_field_count);
+              table_copy.table_key.acl_table_id,
+              table_copy.acl_table_priority, table_copy.acl_stage ? "Egress" :
+              "Ingress", table_copy.field_count, table_copy.rule_count,
+              table_copy.num_counters, table_copy.udf_field_count);
 
     SAI_DEBUG("Qualifier Set Description");
     SAI_DEBUG("-------------------------");
 
-    for (field = 0; field < acl_table->field_count; field++) {
-         if (!udf_fields && sai_acl_table_udf_field_attr_range(acl_table->field_list[field])) {
+    for (field = 0; field < table_copy.field_count; field++) {
+         if (!udf_fields && sai_acl_table_udf_field_attr_range(table_copy.field_list[field])) {
              udf_fields = true;
-             for (udf_field_cnt = 0; udf_field_cnt < acl_table->udf_field_count;
+             for (udf_field_cnt = 0; udf_field_cnt < table_copy.udf_field_count;
                   udf_field_cnt++) {
                   SAI_DEBUG("%d> UDF Group Id : 0x%"PRIx64", UDF Attr Index = %d",
-                              (udf_field_cnt+1), acl_table->udf_field_list[udf_field_cnt].udf_group_id,
-                              acl_table->udf_field_list[udf_field_cnt].udf_attr_index);
+                              (udf_field_cnt+1), table_copy.udf_field_list[udf_field_cnt].udf_group_id,
+                              table_copy.udf_field_list[udf_field_cnt].udf_attr_index);
              }
         } else {
             for (field_idx = 0; field < sai_acl_translate_field_to_string_size;
                  field_idx++) {
                  if (sai_acl_translate_field_to_string[field_idx].table_field ==
-                     acl_table->field_list[field]) {
+                     table_copy.field_list[field]) {
                      SAI_DEBUG("%d>  %s", (field+1),
                                sai_acl_translate_field_to_string[field_idx].table_string);
                      break;
@@ -581,7 +803,8 @@ void sai_acl_dump_table(sai_object_id_t table_id)
          }
     }
 
-    sai_acl_npu_api_get()->dump_acl_table(acl_table);
+    free(table_copy.field_list);
+    free(table_copy.udf_field_list);
 
     sai_acl_dump_all_rules_in_table(table_id);
     return;
@@ -589,38 +812,7 @@ void sai_acl_dump_table(sai_object_id_t table_id)
 
 void sai_acl_dump_all_tables(void)
 {
-    acl_node_pt acl_node = NULL;
-    sai_acl_table_t *acl_table = NULL;
-    rbtree_handle acl_table_tree = NULL;
-
-    acl_node = sai_acl_get_acl_node();
-    if (acl_node == NULL)
-    {
-        SAI_DEBUG("ACL Parent Node not present");
-        return;
-    }
-
-    acl_table_tree = acl_node->sai_acl_table_tree;
-
-    if(acl_table_tree == NULL)
-    {
-        SAI_DEBUG("ACL Table not present");
-        return;
-    }
-
-
-    acl_table = (sai_acl_table_t *)std_rbtree_getfirst(acl_table_tree);
-    if (acl_table == NULL)
-    {
-        SAI_DEBUG("No ACL Table present in the ACL Table tree");
-        return;
-    }
-
-    for ( ; acl_table != NULL; acl_table = (sai_acl_table_t *)
-          std_rbtree_getnext(acl_table_tree,acl_table))
-    {
-        sai_acl_dump_table(acl_table->table_key.acl_table_id);
-    }
+    sai_acl_dump_tree(SAI_ACL_DUMP_TREE_TABLE, SAI_NULL_OBJECT_ID);
 
     return;
 }
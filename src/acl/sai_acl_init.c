@@ -33,6 +33,7 @@
 #include "std_type_defs.h"
 #include "std_assert.h"
 #include "std_mutex_lock.h"
+#include "sai_api_stats.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -83,7 +84,7 @@ sai_acl_table_id_node_t *sai_acl_get_table_id_gen(void)
 
 void sai_acl_lock(void)
 {
-    std_mutex_lock (&acl_lock);
+    sai_api_stats_mutex_lock (&acl_lock);
 }
 
 void sai_acl_unlock(void)
@@ -233,6 +234,8 @@ sai_status_t sai_acl_init(void)
 
         sai_acl_table_id_generate();
 
+        sai_acl_rule_index_init();
+
         sai_acl_counter_init();
 
         sai_acl_table_group_init();
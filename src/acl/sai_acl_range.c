@@ -41,40 +41,43 @@
 #include <stdlib.h>
 #include <inttypes.h>
 
-static dn_sai_id_gen_info_t acl_range_info;
+/* Indices of the ACL range ids, kept under the ACL lock */
+static dn_sai_index_pool_t acl_range_index_pool;
 
-bool sai_is_acl_range_id_in_use(uint64_t obj_id)
+static sai_object_id_t sai_acl_range_id_create(void)
 {
-    acl_node_pt acl_node = NULL;
-
-    acl_node = sai_acl_get_acl_node();
+    uint64_t index = 0;
 
-    sai_object_id_t acl_range_id = sai_uoid_create(SAI_OBJECT_TYPE_ACL_RANGE,obj_id);
-
-    if(sai_acl_range_find(acl_node->sai_acl_range_tree,
-                                acl_range_id) != NULL) {
-        return true;
-    } else {
-        return false;
+    if(SAI_STATUS_SUCCESS ==
+       dn_sai_index_pool_alloc(&acl_range_index_pool, &index)) {
+        return (sai_uoid_create(SAI_OBJECT_TYPE_ACL_RANGE, index));
     }
+    return SAI_NULL_OBJECT_ID;
 }
 
-static sai_object_id_t sai_acl_range_id_create(void)
+static void sai_acl_range_id_free(sai_object_id_t acl_range_id)
 {
-    if(SAI_STATUS_SUCCESS ==
-       dn_sai_get_next_free_id(&acl_range_info)) {
-        return (sai_uoid_create(SAI_OBJECT_TYPE_ACL_RANGE,
-                                acl_range_info.cur_id));
-    }
-    return SAI_NULL_OBJECT_ID;
+    dn_sai_index_pool_free(&acl_range_index_pool,
+                           sai_uoid_npu_obj_id_get(acl_range_id));
 }
 
 void sai_acl_range_init(void)
 {
-    acl_range_info.cur_id = 0;
-    acl_range_info.is_wrappped = false;
-    acl_range_info.mask = SAI_UOID_NPU_OBJ_ID_MASK;
-    acl_range_info.is_id_in_use = sai_is_acl_range_id_in_use;
+    acl_node_pt      acl_node = sai_acl_get_acl_node();
+    sai_acl_range_t *p_range_node = NULL;
+
+    dn_sai_index_pool_deinit(&acl_range_index_pool);
+    dn_sai_index_pool_init(&acl_range_index_pool, 1, SAI_UOID_NPU_OBJ_ID_MASK);
+
+    /* Ranges already present keep their id */
+    for(p_range_node = (sai_acl_range_t *)
+                       std_rbtree_getfirst(acl_node->sai_acl_range_tree);
+        p_range_node != NULL;
+        p_range_node = (sai_acl_range_t *)
+                       std_rbtree_getnext(acl_node->sai_acl_range_tree, p_range_node)) {
+        dn_sai_index_pool_reserve(&acl_range_index_pool,
+                                  sai_uoid_npu_obj_id_get(p_range_node->acl_range_id));
+    }
 }
 
 static sai_status_t sai_acl_range_attr_set(sai_acl_range_t *p_range_node,
@@ -213,6 +216,10 @@ sai_status_t sai_create_acl_range(sai_object_id_t *acl_range_id,
     }
     else{
         SAI_ACL_LOG_ERR("Range create failed");
+        if((p_range_node != NULL) &&
+           (p_range_node->acl_range_id != SAI_NULL_OBJECT_ID)) {
+            sai_acl_range_id_free(p_range_node->acl_range_id);
+        }
         sai_acl_range_free(p_range_node);
     }
 
@@ -285,6 +292,7 @@ sai_status_t sai_delete_acl_range(sai_object_id_t acl_range_id)
     }
     else {
         SAI_ACL_LOG_TRACE ("Removed acl range 0x%"PRIx64"", acl_range_id);
+        sai_acl_range_id_free(acl_range_id);
         sai_acl_range_free(p_range_node);
     }
 
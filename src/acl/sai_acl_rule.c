@@ -32,6 +32,8 @@
 #include "saiacl.h"
 #include "saistatus.h"
 #include "sai_common_infra.h"
+#include "sai_api_stats.h"
+#include "sai_gen_utils.h"
 
 #include "std_type_defs.h"
 #include "std_assert.h"
@@ -42,49 +44,97 @@
 #include <string.h>
 #include <inttypes.h>
 
-static bool sai_is_acl_rule_index_used(uint_t acl_rule_index)
+/* Indices of the ACL rule ids, kept under the ACL lock */
+static dn_sai_index_pool_t acl_rule_index_pool;
+
+/* Undo record of an ACL Rule set, holding only what the set changes */
+typedef struct _sai_acl_rule_undo_t {
+    uint_t            acl_rule_priority;
+    uint_t            acl_rule_state;
+    sai_object_id_t   counter_id;
+    uint_t            filter_count;
+    uint_t            action_count;
+    /* Old value of the filter and action changed in place */
+    bool              filter_saved;
+    uint_t            filter_index;
+    sai_acl_filter_t  old_filter;
+    bool              action_saved;
+    uint_t            action_index;
+    sai_acl_action_t  old_action;
+} sai_acl_rule_undo_t;
+
+void sai_acl_rule_index_init(void)
 {
-    sai_object_id_t acl_id = 0;
-    acl_node_pt acl_node = NULL;
-    sai_acl_rule_t *acl_rule_present = NULL;
-
-    acl_id = sai_uoid_create (SAI_OBJECT_TYPE_ACL_ENTRY,
-                              (sai_npu_object_id_t)acl_rule_index);
-
-    acl_node = sai_acl_get_acl_node();
+    acl_node_pt acl_node = sai_acl_get_acl_node();
+    sai_acl_rule_t *acl_rule = NULL;
 
-    acl_rule_present = sai_acl_rule_find(acl_node->sai_acl_rule_tree,
-                                         acl_id);
-    if (acl_rule_present == NULL) {
-        return false;
+    dn_sai_index_pool_deinit(&acl_rule_index_pool);
+    dn_sai_index_pool_init(&acl_rule_index_pool, 0, UINT32_MAX);
+
+    /* Rules already present, as after a warm boot, keep their index */
+    for (acl_rule = (sai_acl_rule_t *)
+                    std_rbtree_getfirst(acl_node->sai_acl_rule_tree);
+         acl_rule != NULL;
+         acl_rule = (sai_acl_rule_t *)
+                    std_rbtree_getnext(acl_node->sai_acl_rule_tree, acl_rule)) {
+        if (dn_sai_index_pool_reserve(&acl_rule_index_pool,
+                    sai_uoid_npu_obj_id_get(acl_rule->rule_key.acl_id))
+                != SAI_STATUS_SUCCESS) {
+            SAI_ACL_LOG_ERR("Failed to restore index of ACL Rule Id 0x%"PRIx64"",
+                            acl_rule->rule_key.acl_id);
+        }
     }
-    return true;
 }
+
 /**
- * This function allocates the next free index available for rule id creation.
- * Free function is not used intentionally since the acl rule tree is walked to
- * find out the free index available.
+ * This function allocates the lowest free index for rule id creation.
+ * The index is returned to the pool on rule removal.
  */
 static sai_status_t sai_allocate_acl_rule_index(uint_t *alloc_index)
 {
+    uint64_t index = 0;
 
-    while(sai_is_acl_rule_index_used(*alloc_index)) {
-       (*alloc_index) ++;
-
-       /**
-        * Wrap around has occured. No more free indices are present.
-        *  */
-       if(*alloc_index == 0)
-       {
-           SAI_ACL_LOG_ERR("All entries are exhausted");
-           return SAI_STATUS_FAILURE;
-       }
+    if (dn_sai_index_pool_alloc(&acl_rule_index_pool, &index)
+            != SAI_STATUS_SUCCESS) {
+        SAI_ACL_LOG_ERR("All entries are exhausted");
+        return SAI_STATUS_FAILURE;
     }
 
+    *alloc_index = (uint_t)index;
+
     SAI_ACL_LOG_TRACE("Rule index allocated is %d",*alloc_index);
     return SAI_STATUS_SUCCESS;
 }
 
+static void sai_free_acl_rule_index(sai_object_id_t acl_id)
+{
+    dn_sai_index_pool_free(&acl_rule_index_pool,
+                           sai_uoid_npu_obj_id_get(acl_id));
+}
+
+static void sai_acl_filter_lists_free(sai_acl_filter_t *acl_filter)
+{
+    if (sai_acl_object_list_field_attr(acl_filter->field) &&
+        acl_filter->match_data.obj_list.list) {
+        free(acl_filter->match_data.obj_list.list);
+    } else if (sai_acl_rule_udf_field_attr_range(acl_filter->field)) {
+        if (acl_filter->match_data.u8_list.list) {
+            free(acl_filter->match_data.u8_list.list);
+        }
+        if (acl_filter->match_mask.u8_list.list) {
+            free(acl_filter->match_mask.u8_list.list);
+        }
+    }
+}
+
+static void sai_acl_action_lists_free(sai_acl_action_t *acl_action)
+{
+    if (sai_acl_object_list_action_attr(acl_action->action) &&
+        acl_action->parameter.obj_list.list) {
+        free(acl_action->parameter.obj_list.list);
+    }
+}
+
 static void sai_acl_rule_free(sai_acl_rule_t *acl_rule)
 {
     uint_t filter_count = 0, action_count = 0;
@@ -94,17 +144,7 @@ static void sai_acl_rule_free(sai_acl_rule_t *acl_rule)
     if (acl_rule->filter_list) {
         for (filter_count = 0; filter_count < acl_rule->filter_count;
              filter_count++) {
-             if (sai_acl_object_list_field_attr(acl_rule->filter_list[filter_count].field) &&
-                  acl_rule->filter_list[filter_count].match_data.obj_list.list) {
-                  free(acl_rule->filter_list[filter_count].match_data.obj_list.list);
-             } else if (sai_acl_rule_udf_field_attr_range(acl_rule->filter_list[filter_count].field)) {
-                  if (acl_rule->filter_list[filter_count].match_data.u8_list.list) {
-                      free(acl_rule->filter_list[filter_count].match_data.u8_list.list);
-                  }
-                  if (acl_rule->filter_list[filter_count].match_mask.u8_list.list) {
-                      free(acl_rule->filter_list[filter_count].match_mask.u8_list.list);
-                  }
-             }
+             sai_acl_filter_lists_free(&acl_rule->filter_list[filter_count]);
         }
         free(acl_rule->filter_list);
         acl_rule->filter_list = NULL;
@@ -112,10 +152,7 @@ static void sai_acl_rule_free(sai_acl_rule_t *acl_rule)
     if (acl_rule->action_list) {
         for (action_count = 0; action_count < acl_rule->action_count;
              action_count++) {
-             if (sai_acl_object_list_action_attr(acl_rule->action_list[action_count].action) &&
-                  acl_rule->action_list[action_count].parameter.obj_list.list) {
-                  free(acl_rule->action_list[action_count].parameter.obj_list.list);
-             }
+             sai_acl_action_lists_free(&acl_rule->action_list[action_count]);
         }
         free(acl_rule->action_list);
         acl_rule->action_list = NULL;
@@ -495,28 +532,33 @@ static sai_status_t sai_install_acl_rule(sai_acl_table_t *acl_table,
     return rc;
 }
 
-sai_status_t sai_create_acl_rule(sai_object_id_t *acl_rule_id,
-                                 sai_object_id_t switch_id,
-                                 uint32_t attr_count,
-                                 const sai_attribute_t *attr_list)
+/*
+ * Check the attributes of an ACL rule to be created, build its node and
+ * give it an id. The table found is passed back in acl_table, which may
+ * hold the table of the previous rule of a batch to skip the lookup.
+ * Called with the ACL lock held.
+ */
+static sai_status_t sai_acl_rule_entry_prepare(uint32_t attr_count,
+                                               const sai_attribute_t *attr_list,
+                                               sai_acl_table_t **acl_table,
+                                               sai_acl_rule_t **acl_rule)
 {
     sai_status_t rc = SAI_STATUS_FAILURE;
-    sai_acl_table_t *acl_table = NULL;
-    sai_acl_rule_t *acl_rule = NULL;
-    acl_node_pt acl_node = NULL;
+    sai_acl_table_t *rule_table = NULL;
+    sai_acl_rule_t *new_rule = NULL;
+    acl_node_pt acl_node = sai_acl_get_acl_node();
     uint_t field_count = 0, action_count = 0;
-    bool rule_installed = false, samplepacket_installed = false;
     sai_object_id_t acl_table_id = 0;
     uint_t acl_rule_index = 0;
 
-    if (attr_count == 0) {
+    STD_ASSERT(acl_table != NULL);
+    STD_ASSERT(acl_rule != NULL);
+
+    if ((attr_count == 0) || (attr_list == NULL)) {
         SAI_ACL_LOG_ERR ("Parameter attr_count is 0");
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    STD_ASSERT(acl_rule_id != NULL);
-    STD_ASSERT(attr_list != NULL);
-
     rc = sai_acl_check_rule_attributes(attr_count, attr_list,
                                        &field_count,
                                        &action_count,
@@ -532,30 +574,32 @@ sai_status_t sai_create_acl_rule(sai_object_id_t *acl_rule_id,
         return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
     }
 
-    acl_node = sai_acl_get_acl_node();
-    acl_table = sai_acl_table_find(acl_node->sai_acl_table_tree,
-                                   acl_table_id);
-    if (acl_table == NULL) {
-        return SAI_STATUS_INVALID_OBJECT_ID;
+    rule_table = *acl_table;
+    if ((rule_table == NULL) ||
+        (rule_table->table_key.acl_table_id != acl_table_id)) {
+        rule_table = sai_acl_table_find(acl_node->sai_acl_table_tree,
+                                        acl_table_id);
+        if (rule_table == NULL) {
+            return SAI_STATUS_INVALID_OBJECT_ID;
+        }
     }
 
-    acl_rule = (sai_acl_rule_t *)calloc(1,sizeof(sai_acl_rule_t));
-    if (acl_rule == NULL) {
+    new_rule = (sai_acl_rule_t *)calloc(1,sizeof(sai_acl_rule_t));
+    if (new_rule == NULL) {
         SAI_ACL_LOG_ERR ("Allocation of Memory failed for "
                          "ACL Rule");
         return SAI_STATUS_NO_MEMORY;
     }
 
-    sai_acl_lock();
     do {
-        rc = sai_acl_rule_populate(acl_table, acl_rule, attr_count, attr_list,
+        rc = sai_acl_rule_populate(rule_table, new_rule, attr_count, attr_list,
                                    field_count, action_count);
         if (rc != SAI_STATUS_SUCCESS) {
             SAI_ACL_LOG_ERR ("ACL Rule populate failed");
             break;
         }
 
-        if ((rc = sai_acl_validate_create_rule(acl_table, acl_rule)) != SAI_STATUS_SUCCESS) {
+        if ((rc = sai_acl_validate_create_rule(rule_table, new_rule)) != SAI_STATUS_SUCCESS) {
             SAI_ACL_LOG_ERR ("ACL Rule validate failed");
             break;
         }
@@ -565,15 +609,48 @@ sai_status_t sai_create_acl_rule(sai_object_id_t *acl_rule_id,
             break;
         }
 
-        acl_rule->rule_key.acl_id = sai_uoid_create (SAI_OBJECT_TYPE_ACL_ENTRY,
+        new_rule->rule_key.acl_id = sai_uoid_create (SAI_OBJECT_TYPE_ACL_ENTRY,
                                                      (sai_npu_object_id_t)acl_rule_index);
+    } while(0);
 
-        rc = sai_install_acl_rule(acl_table, acl_rule);
-        if (rc != SAI_STATUS_SUCCESS) {
-            break;
-        }
-        rule_installed = true;
+    if (rc != SAI_STATUS_SUCCESS) {
+        sai_acl_rule_free(new_rule);
+        return rc;
+    }
+
+    *acl_table = rule_table;
+    *acl_rule = new_rule;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Free an ACL rule node which is not in the rule database, and its id */
+static void sai_acl_rule_discard(sai_acl_rule_t *acl_rule)
+{
+    STD_ASSERT(acl_rule != NULL);
+
+    if (acl_rule->rule_key.acl_id != SAI_NULL_OBJECT_ID) {
+        sai_free_acl_rule_index(acl_rule->rule_key.acl_id);
+    }
+    sai_acl_rule_free(acl_rule);
+}
+
+/*
+ * Attach the samplepacket, counter and policer of an ACL rule installed in
+ * hardware and add it to the rule database. On failure the rule is removed
+ * from hardware, the node is left to the caller.
+ */
+static sai_status_t sai_acl_rule_entry_commit(sai_acl_table_t *acl_table,
+                                              sai_acl_rule_t *acl_rule)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+    acl_node_pt acl_node = sai_acl_get_acl_node();
+    bool samplepacket_installed = false;
+
+    STD_ASSERT(acl_table != NULL);
+    STD_ASSERT(acl_rule != NULL);
 
+    do {
         /* Check whether samplepacket needs to be created */
         if ((acl_rule->samplepacket_id[SAI_SAMPLEPACKET_DIR_INGRESS] != 0) ||
            (acl_rule->samplepacket_id[SAI_SAMPLEPACKET_DIR_EGRESS]) != 0) {
@@ -617,49 +694,120 @@ sai_status_t sai_create_acl_rule(sai_object_id_t *acl_rule_id,
                              acl_rule->table_id, rc);
             break;
         }
-
-
     } while(0);
 
     if (rc != SAI_STATUS_SUCCESS) {
-       if (rule_installed) {
-           sai_acl_npu_api_get()->delete_acl_rule(acl_table, acl_rule);
-       }
+       sai_acl_npu_api_get()->delete_acl_rule(acl_table, acl_rule);
        if (samplepacket_installed) {
            sai_acl_rule_remove_samplepacket(acl_rule);
        }
-       sai_acl_rule_free(acl_rule);
-    } else {
-       sai_acl_rule_link(acl_table, acl_rule);
-       acl_table->rule_count++;
-       *acl_rule_id = acl_rule->rule_key.acl_id;
-       SAI_ACL_LOG_INFO ("ACL entry 0x%"PRIx64" successfully programmed "
-                         "in hardware", *acl_rule_id);
+       return rc;
+    }
+
+    sai_acl_rule_link(acl_table, acl_rule);
+    acl_table->rule_count++;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_create_acl_rule(sai_object_id_t *acl_rule_id,
+                                 sai_object_id_t switch_id,
+                                 uint32_t attr_count,
+                                 const sai_attribute_t *attr_list)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    sai_acl_table_t *acl_table = NULL;
+    sai_acl_rule_t *acl_rule = NULL;
+
+    if (attr_count == 0) {
+        SAI_ACL_LOG_ERR ("Parameter attr_count is 0");
+        return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    STD_ASSERT(acl_rule_id != NULL);
+    STD_ASSERT(attr_list != NULL);
+
+    sai_acl_lock();
+    do {
+        rc = sai_acl_rule_entry_prepare(attr_count, attr_list,
+                                        &acl_table, &acl_rule);
+        if (rc != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        rc = sai_install_acl_rule(acl_table, acl_rule);
+        if (rc == SAI_STATUS_SUCCESS) {
+            rc = sai_acl_rule_entry_commit(acl_table, acl_rule);
+        }
+        if (rc != SAI_STATUS_SUCCESS) {
+            sai_acl_rule_discard(acl_rule);
+            break;
+        }
+
+        *acl_rule_id = acl_rule->rule_key.acl_id;
+        SAI_ACL_LOG_INFO ("ACL entry 0x%"PRIx64" successfully programmed "
+                          "in hardware", *acl_rule_id);
+    } while(0);
 
     sai_acl_unlock();
     return rc;
 }
 
-sai_status_t sai_delete_acl_rule(sai_object_id_t acl_id)
+/* Re-attach the samplepacket, counter and policer of an ACL rule which
+ * could not be deleted and put it back in the rule database */
+static void sai_acl_rule_entry_restore(sai_acl_rule_t *acl_rule)
+{
+    acl_node_pt acl_node = sai_acl_get_acl_node();
+
+    STD_ASSERT(acl_rule != NULL);
+
+    if (sai_acl_rule_insert(acl_node->sai_acl_rule_tree, acl_rule)
+        != SAI_STATUS_SUCCESS) {
+        SAI_ACL_LOG_ERR ("Failed to restore ACL Rule Id 0x%"PRIx64" "
+                         "in Rule Database", acl_rule->rule_key.acl_id);
+    }
+    if ((acl_rule->samplepacket_id[SAI_SAMPLEPACKET_DIR_INGRESS] != 0) ||
+       (acl_rule->samplepacket_id[SAI_SAMPLEPACKET_DIR_EGRESS]) != 0) {
+        sai_acl_rule_create_samplepacket(acl_rule);
+    }
+    if (acl_rule->counter_id != 0) {
+        sai_attach_cntr_to_acl_rule(acl_rule);
+    }
+    if (acl_rule->policer_id != 0) {
+        sai_attach_policer_to_acl_rule(acl_rule);
+    }
+}
+
+/*
+ * Find an ACL rule to be deleted, detach its samplepacket, counter and
+ * policer and take it out of the rule database, so that it is found only
+ * once in a batch. On success the rule is to be deleted from hardware, then
+ * released or restored. A batch checks the rule is linked in its table
+ * rather than searching the rule list of the table for every rule.
+ * Called with the ACL lock held.
+ */
+static sai_status_t sai_acl_rule_entry_detach(sai_object_id_t acl_id,
+                                              bool is_batch,
+                                              sai_acl_table_t **acl_table,
+                                              sai_acl_rule_t **acl_rule)
 {
     sai_status_t rc = SAI_STATUS_FAILURE;
-    sai_acl_rule_t *acl_rule = NULL;
-    sai_acl_table_t *acl_table = NULL;
-    acl_node_pt acl_node = NULL;
+    sai_acl_rule_t *del_rule = NULL;
+    sai_acl_table_t *rule_table = NULL;
+    acl_node_pt acl_node = sai_acl_get_acl_node();
     bool cntr_detached = false, samplepacket_removed = false, policer_detached = false;
 
+    STD_ASSERT(acl_table != NULL);
+    STD_ASSERT(acl_rule != NULL);
+
     if (!sai_is_obj_id_acl_entry(acl_id)) {
         SAI_ACL_LOG_ERR ("ACL Id 0x%"PRIx64" is not a ACL Entry Object", acl_id);
         return SAI_STATUS_INVALID_OBJECT_TYPE;
     }
 
-    sai_acl_lock();
     do {
-        acl_node = sai_acl_get_acl_node();
-        acl_rule = sai_acl_rule_find(acl_node->sai_acl_rule_tree, acl_id);
-        if (acl_rule == NULL) {
+        del_rule = sai_acl_rule_find(acl_node->sai_acl_rule_tree, acl_id);
+        if (del_rule == NULL) {
             SAI_ACL_LOG_ERR ("ACL Rule not present for "
                              "Rule ID 0x%"PRIx64"", acl_id);
             rc = SAI_STATUS_INVALID_OBJECT_ID;
@@ -668,13 +816,17 @@ sai_status_t sai_delete_acl_rule(sai_object_id_t acl_id)
 
         /* Retrieve the ACL table node in the RB tree from the
          * table id present in the ACL rule structure. */
-        acl_table = sai_acl_table_find(acl_node->sai_acl_table_tree,
-                                               acl_rule->table_id);
-        if (acl_table == NULL) {
+        rule_table = *acl_table;
+        if ((rule_table == NULL) ||
+            (rule_table->table_key.acl_table_id != del_rule->table_id)) {
+            rule_table = sai_acl_table_find(acl_node->sai_acl_table_tree,
+                                            del_rule->table_id);
+        }
+        if (rule_table == NULL) {
             /* This is a fatal error as the table for the provided acl_id
              * is not present in ACL database. */
             SAI_ACL_LOG_ERR ("ACL Table  0x%"PRIx64" not present for "
-                             "Rule ID  0x%"PRIx64"",acl_rule->table_id, acl_id);
+                             "Rule ID  0x%"PRIx64"",del_rule->table_id, acl_id);
             rc = SAI_STATUS_INVALID_OBJECT_ID;
             break;
         }
@@ -682,17 +834,18 @@ sai_status_t sai_delete_acl_rule(sai_object_id_t acl_id)
         /* Both rule and table are present in there respective RB trees.
          * Proceed to validate rule DLL in ACL table node to avoid any
          * ACL data-structures inconsistency. */
-        if (acl_rule != (sai_acl_rule_validate(acl_table, acl_rule->rule_key.acl_id))) {
+        if ((is_batch) ? (!std_dll_islinked(&del_rule->rule_link)) :
+            (del_rule != (sai_acl_rule_validate(rule_table, del_rule->rule_key.acl_id)))) {
             SAI_ACL_LOG_ERR ("ACL Rule absent in the Rule DLL "
                              "stored in table Id  0x%"PRIx64" for ACL rule ID 0x%"PRIx64"",
-                             acl_table->table_key.acl_table_id, acl_id);
+                             rule_table->table_key.acl_table_id, acl_id);
             rc = SAI_STATUS_FAILURE;
             break;
         }
 
-        if ((acl_rule->samplepacket_id[SAI_SAMPLEPACKET_DIR_INGRESS] != 0) ||
-           (acl_rule->samplepacket_id[SAI_SAMPLEPACKET_DIR_EGRESS]) != 0) {
-            rc = sai_acl_rule_remove_samplepacket(acl_rule);
+        if ((del_rule->samplepacket_id[SAI_SAMPLEPACKET_DIR_INGRESS] != 0) ||
+           (del_rule->samplepacket_id[SAI_SAMPLEPACKET_DIR_EGRESS]) != 0) {
+            rc = sai_acl_rule_remove_samplepacket(del_rule);
             if (rc != SAI_STATUS_SUCCESS) {
                  SAI_ACL_LOG_ERR ("Unable to remove SamplePacket Config");
                  break;
@@ -701,75 +854,391 @@ sai_status_t sai_delete_acl_rule(sai_object_id_t acl_id)
         }
 
         /* Check whether counter needs to be detached */
-        if (acl_rule->counter_id != 0) {
-            rc = sai_detach_cntr_from_acl_rule(acl_rule);
+        if (del_rule->counter_id != 0) {
+            rc = sai_detach_cntr_from_acl_rule(del_rule);
             if (rc != SAI_STATUS_SUCCESS) {
                 SAI_ACL_LOG_ERR ("ACL Counter 0x%"PRIx64" failed to detach with "
                                  "ACL rule ID 0x%"PRIx64" in Table Id 0x%"PRIx64"",
-                                 acl_rule->counter_id,
-                                 acl_rule->rule_key.acl_id,
-                                 acl_rule->table_id);
+                                 del_rule->counter_id,
+                                 del_rule->rule_key.acl_id,
+                                 del_rule->table_id);
                 break;
             }
             cntr_detached = true;
         }
-        if (acl_rule->policer_id != 0) {
-            rc = sai_detach_policer_from_acl_rule(acl_rule);
+        if (del_rule->policer_id != 0) {
+            rc = sai_detach_policer_from_acl_rule(del_rule);
             if (rc != SAI_STATUS_SUCCESS) {
                 SAI_ACL_LOG_ERR ("Policer 0x%"PRIx64" failed to "
                                  "detach with ACL rule ID 0x%"PRIx64" in Table Id 0x%"PRIx64"",
-                                 acl_rule->policer_id,
-                                 acl_rule->rule_key.acl_id,
-                                 acl_rule->table_id);
+                                 del_rule->policer_id,
+                                 del_rule->rule_key.acl_id,
+                                 del_rule->table_id);
                 break;
             }
             policer_detached = true;
         }
 
-        /* Delete the entry in the hardware*/
-        rc = sai_acl_npu_api_get()->delete_acl_rule(acl_table, acl_rule);
-        if (rc != SAI_STATUS_SUCCESS) {
-            SAI_ACL_LOG_ERR ("Failure deleting ACL Rule Id 0x%"PRIx64" "
-                             "from hardware", acl_id);
-            break;
-        }
-
-        /* Update all the SAI ACL data structures */
-        acl_rule = sai_acl_rule_remove(acl_node->sai_acl_rule_tree, acl_rule);
-        if (acl_rule == NULL) {
+        if (sai_acl_rule_remove(acl_node->sai_acl_rule_tree, del_rule) == NULL) {
             /* Some internal error in RB tree, log an error */
             SAI_ACL_LOG_ERR ("Failure removing ACL Rule Id 0x%"PRIx64" "
                              "from Rule Database", acl_id);
+            rc = SAI_STATUS_FAILURE;
             break;
         }
     } while(0);
 
     if (rc != SAI_STATUS_SUCCESS) {
         if (samplepacket_removed) {
-            sai_acl_rule_create_samplepacket(acl_rule);
+            sai_acl_rule_create_samplepacket(del_rule);
         }
         if (cntr_detached) {
-            sai_attach_cntr_to_acl_rule(acl_rule);
+            sai_attach_cntr_to_acl_rule(del_rule);
         }
         if (policer_detached) {
-            sai_attach_policer_to_acl_rule(acl_rule);
+            sai_attach_policer_to_acl_rule(del_rule);
         }
-    } else {
-        sai_acl_rule_unlink(acl_table, acl_rule);
-        acl_table->rule_count--;
-        sai_acl_rule_free(acl_rule);
-        SAI_ACL_LOG_INFO ("ACL Rule Id 0x%"PRIx64" successfully deleted "
-                          "from hardware", acl_id);
+        return rc;
     }
+
+    *acl_table = rule_table;
+    *acl_rule = del_rule;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Release an ACL rule detached and deleted from hardware */
+static void sai_acl_rule_entry_release(sai_acl_table_t *acl_table,
+                                       sai_acl_rule_t *acl_rule)
+{
+    sai_object_id_t acl_id = acl_rule->rule_key.acl_id;
+
+    sai_acl_rule_unlink(acl_table, acl_rule);
+    acl_table->rule_count--;
+    sai_free_acl_rule_index(acl_id);
+    sai_acl_rule_free(acl_rule);
+    SAI_ACL_LOG_INFO ("ACL Rule Id 0x%"PRIx64" successfully deleted "
+                      "from hardware", acl_id);
+}
+
+sai_status_t sai_delete_acl_rule(sai_object_id_t acl_id)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    sai_acl_rule_t *acl_rule = NULL;
+    sai_acl_table_t *acl_table = NULL;
+
+    sai_acl_lock();
+    do {
+        rc = sai_acl_rule_entry_detach(acl_id, false, &acl_table, &acl_rule);
+        if (rc != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        /* Delete the entry in the hardware*/
+        rc = sai_acl_npu_api_get()->delete_acl_rule(acl_table, acl_rule);
+        if (rc != SAI_STATUS_SUCCESS) {
+            SAI_ACL_LOG_ERR ("Failure deleting ACL Rule Id 0x%"PRIx64" "
+                             "from hardware", acl_id);
+            sai_acl_rule_entry_restore(acl_rule);
+            break;
+        }
+
+        sai_acl_rule_entry_release(acl_table, acl_rule);
+    } while(0);
+
     sai_acl_unlock();
     return rc;
 }
 
-static void sai_acl_rule_update(sai_acl_rule_t *rule_scan,
-                                sai_acl_rule_t *given_rule,
-                                uint_t new_fields, uint_t new_actions,
-                                bool rule_priority_change,
-                                bool rule_state_change)
+/*
+ * Install a run of rules of one table in hardware with one NPU call. The
+ * table is created in hardware once for the run. On failure none of the
+ * rules is installed and the caller installs them one at a time.
+ */
+static sai_status_t sai_acl_rule_batch_install(sai_acl_table_t *acl_table,
+                                               uint_t count,
+                                               sai_acl_rule_t **rule_list)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+
+    if (sai_acl_npu_api_get()->create_acl_rules == NULL) {
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    if (acl_table->npu_table_info == NULL) {
+        rc = sai_acl_npu_api_get()->create_acl_table(acl_table);
+        if (rc != SAI_STATUS_SUCCESS) {
+            SAI_ACL_LOG_ERR ("Table Creation failed for %u ACL Rules "
+                             "in Table Id 0x%"PRIx64"", count,
+                             acl_table->table_key.acl_table_id);
+            return rc;
+        }
+    }
+
+    rc = sai_acl_npu_api_get()->create_acl_rules(acl_table, count, rule_list);
+    if (rc != SAI_STATUS_SUCCESS) {
+        SAI_ACL_LOG_TRACE ("Batch of %u ACL Rules failed in Table Id 0x%"PRIx64", "
+                           "installing one at a time", count,
+                           acl_table->table_key.acl_table_id);
+    }
+
+    return rc;
+}
+
+/*
+ * Bulk ACL rule APIs. The rules of a batch are validated, installed and
+ * added to the rule database under one hold of the ACL lock. Rules of the
+ * same table following each other in the batch are installed in hardware
+ * with one NPU call; if it fails they are retried one at a time to get
+ * their own status.
+ */
+static sai_status_t sai_acl_rules_create(sai_object_id_t switch_id,
+                                         uint32_t object_count,
+                                         const uint32_t *attr_count,
+                                         const sai_attribute_t **attr_list,
+                                         sai_bulk_op_error_mode_t mode,
+                                         sai_object_id_t *object_id,
+                                         sai_status_t *object_statuses)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    sai_status_t batch_rc = SAI_STATUS_FAILURE;
+    sai_acl_table_t *acl_table = NULL;
+    sai_acl_table_t **table_list = NULL;
+    sai_acl_rule_t **rule_list = NULL;
+    uint32_t *index_list = NULL;
+    uint32_t valid_count = 0;
+    uint32_t idx = 0, run_end = 0;
+    bool stop = false;
+
+    rc = sai_acl_bulk_params_validate(object_count, mode, object_statuses);
+    if (rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    if ((attr_count == NULL) || (attr_list == NULL) || (object_id == NULL)) {
+        SAI_ACL_LOG_ERR ("Invalid bulk ACL Rule create parameters");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for (idx = 0; idx < object_count; idx++) {
+        object_id[idx] = SAI_NULL_OBJECT_ID;
+    }
+
+    table_list = (sai_acl_table_t **)calloc(object_count, sizeof(*table_list));
+    rule_list = (sai_acl_rule_t **)calloc(object_count, sizeof(*rule_list));
+    index_list = (uint32_t *)calloc(object_count, sizeof(*index_list));
+
+    if ((table_list == NULL) || (rule_list == NULL) || (index_list == NULL)) {
+        SAI_ACL_LOG_ERR ("No memory for bulk create of %u ACL Rules",
+                         object_count);
+        free(table_list);
+        free(rule_list);
+        free(index_list);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_acl_lock();
+
+    for (idx = 0; idx < object_count; idx++) {
+        rc = sai_acl_rule_entry_prepare(attr_count[idx], attr_list[idx],
+                                        &acl_table, &rule_list[valid_count]);
+        if (rc != SAI_STATUS_SUCCESS) {
+            object_statuses[idx] = rc;
+            if (mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                break;
+            }
+            continue;
+        }
+        table_list[valid_count] = acl_table;
+        index_list[valid_count] = idx;
+        valid_count++;
+    }
+
+    idx = 0;
+    while ((idx < valid_count) && !stop) {
+        acl_table = table_list[idx];
+        for (run_end = idx + 1;
+             (run_end < valid_count) && (table_list[run_end] == acl_table);
+             run_end++);
+
+        batch_rc = sai_acl_rule_batch_install(acl_table, run_end - idx,
+                                              &rule_list[idx]);
+
+        for (; idx < run_end; idx++) {
+            rc = batch_rc;
+            if (rc != SAI_STATUS_SUCCESS) {
+                rc = sai_install_acl_rule(acl_table, rule_list[idx]);
+            }
+            if (rc == SAI_STATUS_SUCCESS) {
+                rc = sai_acl_rule_entry_commit(acl_table, rule_list[idx]);
+            }
+            object_statuses[index_list[idx]] = rc;
+
+            if (rc != SAI_STATUS_SUCCESS) {
+                sai_acl_rule_discard(rule_list[idx]);
+                if (mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                    stop = true;
+                    idx++;
+                    break;
+                }
+                continue;
+            }
+            object_id[index_list[idx]] = rule_list[idx]->rule_key.acl_id;
+        }
+    }
+
+    /* Rules not executed after a stop on error */
+    for (; idx < valid_count; idx++) {
+        if ((batch_rc == SAI_STATUS_SUCCESS) && (idx < run_end)) {
+            sai_acl_npu_api_get()->delete_acl_rule(table_list[idx], rule_list[idx]);
+        }
+        sai_acl_rule_discard(rule_list[idx]);
+    }
+
+    sai_acl_unlock();
+
+    free(table_list);
+    free(rule_list);
+    free(index_list);
+
+    return sai_acl_bulk_status_get(object_count, object_statuses);
+}
+
+sai_status_t sai_bulk_create_acl_rule(sai_object_id_t switch_id,
+                                      uint32_t object_count,
+                                      const uint32_t *attr_count,
+                                      const sai_attribute_t **attr_list,
+                                      sai_bulk_op_error_mode_t mode,
+                                      sai_object_id_t *object_id,
+                                      sai_status_t *object_statuses)
+{
+    SAI_API_STATS_BULK_CALL (SAI_API_STATS_BULK_ACL_ENTRY_CREATE, object_count,
+                             sai_acl_rules_create(switch_id, object_count, attr_count,
+                                                  attr_list, mode, object_id,
+                                                  object_statuses));
+}
+
+static sai_status_t sai_acl_rules_remove(uint32_t object_count,
+                                         const sai_object_id_t *object_id,
+                                         sai_bulk_op_error_mode_t mode,
+                                         sai_status_t *object_statuses)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    sai_status_t batch_rc = SAI_STATUS_FAILURE;
+    sai_acl_table_t *acl_table = NULL;
+    sai_acl_table_t **table_list = NULL;
+    sai_acl_rule_t **rule_list = NULL;
+    uint32_t *index_list = NULL;
+    uint32_t valid_count = 0;
+    uint32_t idx = 0, run_end = 0;
+    bool stop = false;
+
+    rc = sai_acl_bulk_params_validate(object_count, mode, object_statuses);
+    if (rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    if (object_id == NULL) {
+        SAI_ACL_LOG_ERR ("Invalid bulk ACL Rule remove parameters");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    table_list = (sai_acl_table_t **)calloc(object_count, sizeof(*table_list));
+    rule_list = (sai_acl_rule_t **)calloc(object_count, sizeof(*rule_list));
+    index_list = (uint32_t *)calloc(object_count, sizeof(*index_list));
+
+    if ((table_list == NULL) || (rule_list == NULL) || (index_list == NULL)) {
+        SAI_ACL_LOG_ERR ("No memory for bulk remove of %u ACL Rules",
+                         object_count);
+        free(table_list);
+        free(rule_list);
+        free(index_list);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_acl_lock();
+
+    for (idx = 0; idx < object_count; idx++) {
+        rc = sai_acl_rule_entry_detach(object_id[idx], true, &acl_table,
+                                       &rule_list[valid_count]);
+        if (rc != SAI_STATUS_SUCCESS) {
+            object_statuses[idx] = rc;
+            if (mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                break;
+            }
+            continue;
+        }
+        table_list[valid_count] = acl_table;
+        index_list[valid_count] = idx;
+        valid_count++;
+    }
+
+    idx = 0;
+    while ((idx < valid_count) && !stop) {
+        acl_table = table_list[idx];
+        for (run_end = idx + 1;
+             (run_end < valid_count) && (table_list[run_end] == acl_table);
+             run_end++);
+
+        batch_rc = SAI_STATUS_NOT_SUPPORTED;
+        if (sai_acl_npu_api_get()->delete_acl_rules != NULL) {
+            batch_rc = sai_acl_npu_api_get()->delete_acl_rules(acl_table,
+                                                               run_end - idx,
+                                                               &rule_list[idx]);
+        }
+
+        for (; idx < run_end; idx++) {
+            rc = batch_rc;
+            if (rc != SAI_STATUS_SUCCESS) {
+                rc = sai_acl_npu_api_get()->delete_acl_rule(acl_table,
+                                                            rule_list[idx]);
+            }
+            object_statuses[index_list[idx]] = rc;
+
+            if (rc != SAI_STATUS_SUCCESS) {
+                SAI_ACL_LOG_ERR ("Failure deleting ACL Rule Id 0x%"PRIx64" "
+                                 "from hardware", object_id[index_list[idx]]);
+                sai_acl_rule_entry_restore(rule_list[idx]);
+                if (mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                    stop = true;
+                    idx++;
+                    break;
+                }
+                continue;
+            }
+            sai_acl_rule_entry_release(acl_table, rule_list[idx]);
+        }
+    }
+
+    /* Rules not executed after a stop on error are still in hardware */
+    for (; idx < valid_count; idx++) {
+        sai_acl_rule_entry_restore(rule_list[idx]);
+    }
+
+    sai_acl_unlock();
+
+    free(table_list);
+    free(rule_list);
+    free(index_list);
+
+    return sai_acl_bulk_status_get(object_count, object_statuses);
+}
+
+sai_status_t sai_bulk_remove_acl_rule(uint32_t object_count,
+                                      const sai_object_id_t *object_id,
+                                      sai_bulk_op_error_mode_t mode,
+                                      sai_status_t *object_statuses)
+{
+    SAI_API_STATS_BULK_CALL (SAI_API_STATS_BULK_ACL_ENTRY_REMOVE, object_count,
+                             sai_acl_rules_remove(object_count, object_id, mode,
+                                                  object_statuses));
+}
+
+static sai_status_t sai_acl_rule_update(sai_acl_rule_t *rule_scan,
+                                        sai_acl_rule_t *given_rule,
+                                        uint_t new_fields, uint_t new_actions,
+                                        bool rule_priority_change,
+                                        bool rule_state_change)
 {
     sai_status_t rc = SAI_STATUS_FAILURE;
 
@@ -792,74 +1261,202 @@ static void sai_acl_rule_update(sai_acl_rule_t *rule_scan,
     if (rc != SAI_STATUS_SUCCESS) {
         SAI_ACL_LOG_ERR ("ACL rule field/action set failed");
     }
+
+    return rc;
 }
 
-static sai_status_t sai_acl_rule_copy(sai_acl_rule_t *dst_rule,
-                               sai_acl_rule_t *src_rule)
+static sai_status_t sai_acl_rule_undo_save(sai_acl_rule_t *rule_scan,
+                                           sai_acl_rule_t *given_rule,
+                                           sai_acl_rule_undo_t *undo)
 {
-    uint_t filter_count = 0, action_count = 0;
-    sai_status_t rc = SAI_STATUS_FAILURE;
-
-    STD_ASSERT(dst_rule != NULL);
-    STD_ASSERT(src_rule != NULL);
+    uint_t scan_count = 0, given_count = 0;
+    sai_status_t rc = SAI_STATUS_SUCCESS;
 
-    if (dst_rule->filter_list == NULL) {
-        dst_rule->filter_list = (sai_acl_filter_t *)
-                                     calloc(src_rule->filter_count,
-                                            sizeof(sai_acl_filter_t));
-
-        if (dst_rule->filter_list == NULL) {
-            return SAI_STATUS_NO_MEMORY;
+    STD_ASSERT(rule_scan != NULL);
+    STD_ASSERT(given_rule != NULL);
+    STD_ASSERT(undo != NULL);
+
+    memset(undo, 0, sizeof(*undo));
+
+    undo->acl_rule_priority = given_rule->acl_rule_priority;
+    undo->acl_rule_state = given_rule->acl_rule_state;
+    undo->counter_id = given_rule->counter_id;
+    undo->filter_count = given_rule->filter_count;
+    undo->action_count = given_rule->action_count;
+
+    /* Only the filter and the action changed by the set are saved, a set
+     * carries a single attribute */
+    for (scan_count = 0; (scan_count < rule_scan->filter_count) &&
+         !undo->filter_saved; scan_count++) {
+        if (!rule_scan->filter_list[scan_count].field_change) {
+            continue;
         }
-    } else {
-        if (dst_rule->filter_count != src_rule->filter_count) {
-            return SAI_STATUS_FAILURE;
+        for (given_count = 0; given_count < given_rule->filter_count;
+             given_count++) {
+            if (given_rule->filter_list[given_count].field ==
+                rule_scan->filter_list[scan_count].field) {
+                rc = sai_acl_rule_copy_filter(&undo->old_filter,
+                                     &given_rule->filter_list[given_count]);
+                if (rc != SAI_STATUS_SUCCESS) {
+                    return rc;
+                }
+                undo->filter_index = given_count;
+                undo->filter_saved = true;
+                break;
+            }
         }
-        memset((uint8_t *)dst_rule->filter_list, 0,
-               dst_rule->filter_count * sizeof(sai_acl_filter_t));
     }
 
-    if (dst_rule->action_list == NULL) {
-        dst_rule->action_list = (sai_acl_action_t *)
-                                 calloc(src_rule->action_count,
-                                        sizeof(sai_acl_action_t));
-
-        if (dst_rule->action_list == NULL) {
-            return SAI_STATUS_NO_MEMORY;
+    for (scan_count = 0; (scan_count < rule_scan->action_count) &&
+         !undo->action_saved; scan_count++) {
+        if (!rule_scan->action_list[scan_count].action_change) {
+            continue;
         }
-    } else {
-        if (dst_rule->action_count != src_rule->action_count) {
-            return SAI_STATUS_FAILURE;
+        for (given_count = 0; given_count < given_rule->action_count;
+             given_count++) {
+            if (given_rule->action_list[given_count].action ==
+                rule_scan->action_list[scan_count].action) {
+                rc = sai_acl_rule_copy_action(&undo->old_action,
+                                     &given_rule->action_list[given_count]);
+                if (rc != SAI_STATUS_SUCCESS) {
+                    if (undo->filter_saved) {
+                        sai_acl_filter_lists_free(&undo->old_filter);
+                        undo->filter_saved = false;
+                    }
+                    return rc;
+                }
+                undo->action_index = given_count;
+                undo->action_saved = true;
+                break;
+            }
         }
-        memset((uint8_t *)dst_rule->action_list, 0,
-               dst_rule->action_count * sizeof(sai_acl_action_t));
     }
 
-    for (filter_count = 0; filter_count < src_rule->filter_count;
-         filter_count++) {
-         if ((rc = sai_acl_rule_copy_filter(&dst_rule->filter_list[filter_count],
-                   &src_rule->filter_list[filter_count])) != SAI_STATUS_SUCCESS) {
-             return rc;
-         }
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_acl_rule_undo_free(sai_acl_rule_undo_t *undo)
+{
+    STD_ASSERT(undo != NULL);
+
+    if (undo->filter_saved) {
+        sai_acl_filter_lists_free(&undo->old_filter);
+        undo->filter_saved = false;
     }
 
-    for (action_count = 0; action_count < src_rule->action_count;
-         action_count++) {
-         if ((rc = sai_acl_rule_copy_action(&dst_rule->action_list[action_count],
-                   &src_rule->action_list[action_count])) != SAI_STATUS_SUCCESS) {
-             return rc;
-         }
+    if (undo->action_saved) {
+        sai_acl_action_lists_free(&undo->old_action);
+        undo->action_saved = false;
     }
+}
 
-    sai_acl_rule_copy_fields(dst_rule, src_rule);
+/* Restore the rule from the undo record, after a partial update. The
+ * filters and actions appended by the update are dropped. */
+static void sai_acl_rule_undo_restore(sai_acl_rule_undo_t *undo,
+                                      sai_acl_rule_t *given_rule)
+{
+    uint_t count = 0;
 
-    rc = sai_acl_npu_api_get()->copy_acl_rule(dst_rule, src_rule);
+    STD_ASSERT(undo != NULL);
+    STD_ASSERT(given_rule != NULL);
 
-    if (rc != SAI_STATUS_SUCCESS) {
-        SAI_ACL_LOG_ERR ("ACL BCM Rule Copy failed");
+    for (count = undo->filter_count; count < given_rule->filter_count;
+         count++) {
+        sai_acl_filter_lists_free(&given_rule->filter_list[count]);
     }
+    given_rule->filter_count = undo->filter_count;
 
-    return rc;
+    for (count = undo->action_count; count < given_rule->action_count;
+         count++) {
+        sai_acl_action_lists_free(&given_rule->action_list[count]);
+    }
+    given_rule->action_count = undo->action_count;
+
+    if (undo->filter_saved) {
+        sai_acl_filter_lists_free(&given_rule->filter_list[undo->filter_index]);
+        given_rule->filter_list[undo->filter_index] = undo->old_filter;
+        undo->filter_saved = false;
+    }
+
+    if (undo->action_saved) {
+        sai_acl_action_lists_free(&given_rule->action_list[undo->action_index]);
+        given_rule->action_list[undo->action_index] = undo->old_action;
+        undo->action_saved = false;
+    }
+
+    if (given_rule->counter_id != undo->counter_id) {
+        /* The counter update stopped after detaching the old counter */
+        given_rule->counter_id = undo->counter_id;
+        if ((given_rule->counter_id != 0) &&
+            (sai_attach_cntr_to_acl_rule(given_rule) != SAI_STATUS_SUCCESS)) {
+            SAI_ACL_LOG_ERR ("ACL Counter 0x%"PRIx64" failed to re-attach "
+                             "to ACL Rule Id 0x%"PRIx64"",
+                             given_rule->counter_id,
+                             given_rule->rule_key.acl_id);
+        }
+    }
+
+    given_rule->acl_rule_priority = undo->acl_rule_priority;
+    given_rule->acl_rule_state = undo->acl_rule_state;
+}
+
+/* Set the restored rule back in NPU. A filter or action the set appended
+ * is put back disabled, the NPU set has no removal of a single entry. */
+static sai_status_t sai_acl_rule_undo_npu_revert(sai_acl_table_t *acl_table,
+                                                 sai_acl_rule_t *rule_scan,
+                                                 sai_acl_rule_t *given_rule,
+                                                 sai_acl_rule_undo_t *undo)
+{
+    sai_acl_rule_t revert_rule = *given_rule;
+    sai_acl_rule_t compare_rule = *given_rule;
+    sai_acl_filter_t revert_filter;
+    sai_acl_action_t revert_action;
+    uint_t count = 0;
+
+    STD_ASSERT(acl_table != NULL);
+    STD_ASSERT(rule_scan != NULL);
+    STD_ASSERT(given_rule != NULL);
+    STD_ASSERT(undo != NULL);
+
+    revert_rule.filter_count = 0;
+    revert_rule.filter_list = NULL;
+    revert_rule.action_count = 0;
+    revert_rule.action_list = NULL;
+
+    for (count = 0; count < rule_scan->filter_count; count++) {
+        if (rule_scan->filter_list[count].new_field) {
+            revert_filter = rule_scan->filter_list[count];
+            revert_filter.enable = false;
+        } else if (rule_scan->filter_list[count].field_change) {
+            revert_filter = given_rule->filter_list[undo->filter_index];
+        } else {
+            continue;
+        }
+        revert_filter.new_field = false;
+        revert_filter.field_change = true;
+        revert_rule.filter_list = &revert_filter;
+        revert_rule.filter_count = 1;
+        break;
+    }
+
+    for (count = 0; count < rule_scan->action_count; count++) {
+        if (rule_scan->action_list[count].new_action) {
+            revert_action = rule_scan->action_list[count];
+            revert_action.enable = false;
+        } else if (rule_scan->action_list[count].action_change) {
+            revert_action = given_rule->action_list[undo->action_index];
+        } else {
+            continue;
+        }
+        revert_action.new_action = false;
+        revert_action.action_change = true;
+        revert_rule.action_list = &revert_action;
+        revert_rule.action_count = 1;
+        break;
+    }
+
+    return sai_acl_npu_api_get()->set_acl_rule(acl_table, &revert_rule,
+                                               &compare_rule, given_rule);
 }
 
 static sai_status_t sai_acl_rule_scan_and_mod(sai_acl_rule_t *rule_scan,
@@ -867,7 +1464,8 @@ static sai_status_t sai_acl_rule_scan_and_mod(sai_acl_rule_t *rule_scan,
 {
     sai_acl_table_t *acl_table = NULL;
     uint_t new_fields = 0, new_actions = 0;
-    sai_acl_rule_t *compare_rule = NULL;
+    sai_acl_rule_t compare_rule;
+    sai_acl_rule_undo_t undo;
     sai_status_t rc = SAI_STATUS_FAILURE;
     acl_node_pt acl_node = NULL;
     bool rule_priority_change = false, rule_state_change = false;
@@ -881,73 +1479,80 @@ static sai_status_t sai_acl_rule_scan_and_mod(sai_acl_rule_t *rule_scan,
                                            given_rule->table_id);
     STD_ASSERT(acl_table != NULL);
 
-    compare_rule = (sai_acl_rule_t *)calloc(1, sizeof(sai_acl_rule_t));
-    if (compare_rule == NULL) {
-        SAI_ACL_LOG_ERR ("Allocation of Memory "
-                         "failed for ACL Rule");
-        return SAI_STATUS_NO_MEMORY;
+    /* The given rule is left untouched until NPU accepts the set, so the
+     * rule compared against is a snapshot sharing its lists */
+    compare_rule = *given_rule;
+
+    if (rule_scan->acl_rule_priority != given_rule->acl_rule_priority) {
+        SAI_ACL_LOG_TRACE ("Set ACL Rule Priority Attribute "
+                           "[Old Pri = %d, New Pri = %d]",
+                           given_rule->acl_rule_priority,
+                           rule_scan->acl_rule_priority);
+        rule_priority_change = true;
     }
 
-    do {
-        /* Copy the contents of given rule to fallback rule. This is
-         * required as a fallback mechanism in case rule modification fails */
-        rc = sai_acl_rule_copy(compare_rule, given_rule);
-        if (rc != SAI_STATUS_SUCCESS) {
-           break;
-        }
+    if ((rule_scan->acl_rule_state != SAI_ACL_RULE_DEFAULT_ADMIN_STATE) &&
+        rule_scan->acl_rule_state != given_rule->acl_rule_state) {
+        SAI_ACL_LOG_TRACE ("Set ACL Rule Admin State "
+                           "Attribute [Old State = %s, New State = %s]",
+                           (given_rule->acl_rule_state ?
+                           "ENABLE" : "DISABLE"),
+                           (rule_scan->acl_rule_state ?
+                           "ENABLE" : "DISABLE" ));
+        rule_state_change = true;
+    }
 
-        if (rule_scan->acl_rule_priority != given_rule->acl_rule_priority) {
-            SAI_ACL_LOG_TRACE ("Set ACL Rule Priority Attribute "
-                               "[Old Pri = %d, New Pri = %d]",
-                               given_rule->acl_rule_priority,
-                               rule_scan->acl_rule_priority);
-            rule_priority_change = true;
-        }
+    /* Both filter and action list present in the ACL rule contains
+     * double booleans.
+     *
+     * First boolean (filter/action)_change indicates that as part of
+     * set rule attribute there is a change required in the existing
+     * field/action already present in the given rule.
+     *
+     * Second boolean new_(filter/action) indicates that a new field
+     * or action needs to be added to the existing set of filters/actions.
+     *
+     * Following function would set these booleans */
+    sai_acl_rule_set_field_action(rule_scan, &compare_rule, &new_fields,
+                                  &new_actions);
+
+    /* Save the old value of what the set changes, as a fallback in case
+     * the rule update fails after NPU has been modified */
+    rc = sai_acl_rule_undo_save(rule_scan, given_rule, &undo);
+    if (rc != SAI_STATUS_SUCCESS) {
+        SAI_ACL_LOG_ERR ("ACL rule undo record allocation failed");
+        return rc;
+    }
 
-        if ((rule_scan->acl_rule_state != SAI_ACL_RULE_DEFAULT_ADMIN_STATE) &&
-            rule_scan->acl_rule_state != given_rule->acl_rule_state) {
-            SAI_ACL_LOG_TRACE ("Set ACL Rule Admin State "
-                               "Attribute [Old State = %s, New State = %s]",
-                               (given_rule->acl_rule_state ?
-                               "ENABLE" : "DISABLE"),
-                               (rule_scan->acl_rule_state ?
-                               "ENABLE" : "DISABLE" ));
-            rule_state_change = true;
-        }
+    /* Rule scan has been relevantly marked with the field/action change or
+     * new field/action which needs to be added. Now modify ACL BCM
+     * structures and update in NPU */
+    rc = sai_acl_npu_api_get()->set_acl_rule(acl_table, rule_scan,
+                                             &compare_rule, given_rule);
 
-        /* Both filter and action list present in the ACL rule contains
-         * double booleans.
-         *
-         * First boolean (filter/action)_change indicates that as part of
-         * set rule attribute there is a change required in the existing
-         * field/action already present in the given rule.
-         *
-         * Second boolean new_(filter/action) indicates that a new field
-         * or action needs to be added to the existing set of filters/actions.
-         *
-         * Following function would set these booleans */
-         sai_acl_rule_set_field_action(rule_scan, compare_rule, &new_fields,
-                                           &new_actions);
-
-        /* Rule scan has been relevantly marked with the field/action change or
-         * new field/action which needs to be added. Now modify ACL BCM
-         * structures and update in NPU */
-        rc = sai_acl_npu_api_get()->set_acl_rule(acl_table, rule_scan,
-                                                 compare_rule, given_rule);
+    if (rc != SAI_STATUS_SUCCESS) {
+        SAI_ACL_LOG_ERR ("ACL rule set attribute "
+                         "failed in NPU");
+        sai_acl_rule_undo_free(&undo);
+        return rc;
+    }
 
-        if (rc != SAI_STATUS_SUCCESS) {
-            SAI_ACL_LOG_ERR ("ACL rule set attribute "
-                             "failed in NPU");
-            break;
-        }
+    /* Rule was successfully modified in NPU. ACL rule now needs to
+     * be modified */
+    rc = sai_acl_rule_update(rule_scan, given_rule, new_fields, new_actions,
+                             rule_priority_change, rule_state_change);
 
-        /* Rule was successfully modified in NPU. ACL rule now needs to
-         * be modified */
-        sai_acl_rule_update(rule_scan, given_rule, new_fields, new_actions,
-                            rule_priority_change, rule_state_change);
-    } while(0);
+    if (rc != SAI_STATUS_SUCCESS) {
+        sai_acl_rule_undo_restore(&undo, given_rule);
+
+        if (sai_acl_rule_undo_npu_revert(acl_table, rule_scan, given_rule,
+                                         &undo) != SAI_STATUS_SUCCESS) {
+            SAI_ACL_LOG_ERR ("ACL rule 0x%"PRIx64" set attribute revert "
+                             "failed in NPU", given_rule->rule_key.acl_id);
+        }
+    }
 
-    sai_acl_rule_free(compare_rule);
+    sai_acl_rule_undo_free(&undo);
 
     return rc;
 }
@@ -1160,9 +1160,6 @@ sai_status_t sai_acl_rule_update_field_action(sai_acl_rule_t *rule_scan,
                                             total_actions);
 
         if(rc != SAI_STATUS_SUCCESS) {
-            if (new_fields) {
-                free (given_rule->filter_list);
-            }
             return rc;
         }
     }
@@ -40,31 +40,17 @@
 #include "sai_common_infra.h"
 #include <stdlib.h>
 #include <inttypes.h>
-static dn_sai_id_gen_info_t acl_slice_info;
 
-bool sai_is_acl_slice_id_in_use(uint64_t obj_id)
-{
-    acl_node_pt acl_node = NULL;
-
-    acl_node = sai_acl_get_acl_node();
-
-    sai_object_id_t acl_slice_id = sai_uoid_create(
-                SAI_OBJECT_TYPE_EXTENSIONS_ACL_SLICE,obj_id);
-
-    if(sai_acl_slice_find(acl_node->sai_acl_slice_tree,
-                                acl_slice_id) != NULL) {
-        return true;
-    } else {
-        return false;
-    }
-}
+/* Indices of the ACL slice ids, kept under the ACL lock */
+static dn_sai_index_pool_t acl_slice_index_pool;
 
 static sai_object_id_t sai_acl_slice_id_create(void)
 {
+    uint64_t index = 0;
+
     if(SAI_STATUS_SUCCESS ==
-       dn_sai_get_next_free_id(&acl_slice_info)) {
-        return (sai_uoid_create(SAI_OBJECT_TYPE_EXTENSIONS_ACL_SLICE,
-                                acl_slice_info.cur_id));
+       dn_sai_index_pool_alloc(&acl_slice_index_pool, &index)) {
+        return (sai_uoid_create(SAI_OBJECT_TYPE_EXTENSIONS_ACL_SLICE, index));
     }
     return SAI_NULL_OBJECT_ID;
 }
@@ -102,6 +88,8 @@ static sai_status_t sai_acl_slice_node_create(  sai_acl_slice_t *acl_slice_node,
 
     if (sai_acl_slice_insert(acl_node->sai_acl_slice_tree, acl_slice_node) != STD_ERR_OK){
         SAI_ACL_LOG_ERR("Slice id insertion failed in RB tree");
+        dn_sai_index_pool_free(&acl_slice_index_pool,
+                               sai_uoid_npu_obj_id_get(acl_slice_node->acl_slice_id));
         sai_rc = SAI_STATUS_FAILURE;
         sai_acl_unlock();
         return sai_rc;
@@ -112,10 +100,21 @@ static sai_status_t sai_acl_slice_node_create(  sai_acl_slice_t *acl_slice_node,
 }
 void sai_acl_slice_init(void)
 {
-    acl_slice_info.cur_id = 0;
-    acl_slice_info.is_wrappped = false;
-    acl_slice_info.mask = SAI_UOID_NPU_OBJ_ID_MASK;
-    acl_slice_info.is_id_in_use = sai_is_acl_slice_id_in_use;
+    acl_node_pt      acl_node = sai_acl_get_acl_node();
+    sai_acl_slice_t *acl_slice_node = NULL;
+
+    dn_sai_index_pool_deinit(&acl_slice_index_pool);
+    dn_sai_index_pool_init(&acl_slice_index_pool, 1, SAI_UOID_NPU_OBJ_ID_MASK);
+
+    /* Slices already present keep their id */
+    for(acl_slice_node = (sai_acl_slice_t *)
+                         std_rbtree_getfirst(acl_node->sai_acl_slice_tree);
+        acl_slice_node != NULL;
+        acl_slice_node = (sai_acl_slice_t *)
+                         std_rbtree_getnext(acl_node->sai_acl_slice_tree, acl_slice_node)) {
+        dn_sai_index_pool_reserve(&acl_slice_index_pool,
+                                  sai_uoid_npu_obj_id_get(acl_slice_node->acl_slice_id));
+    }
 }
 
 sai_status_t sai_acl_slice_create_objects(void)
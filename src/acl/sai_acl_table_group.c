@@ -41,7 +41,8 @@
 #include <stdlib.h>
 #include <inttypes.h>
 
-static dn_sai_id_gen_info_t acl_table_group_obj_info;
+/* Indices of the ACL table group ids, kept under the ACL lock */
+static dn_sai_index_pool_t acl_table_group_index_pool;
 
 static const dn_sai_attribute_entry_t dn_sai_acl_table_group_attr[] = {
     {SAI_ACL_TABLE_GROUP_ATTR_ACL_STAGE, true, true, false, true, true, true},
@@ -49,39 +50,41 @@ static const dn_sai_attribute_entry_t dn_sai_acl_table_group_attr[] = {
     {SAI_ACL_TABLE_GROUP_ATTR_TYPE, false, true, false, true, true, true},
 };
 
-bool sai_is_acl_table_group_id_in_use(uint64_t obj_id)
+static sai_object_id_t sai_acl_table_group_id_create(void)
 {
-    acl_node_pt acl_node = NULL;
-
-    acl_node = sai_acl_get_acl_node();
+    uint64_t index = 0;
 
-    sai_object_id_t acl_table_group_id =
-        sai_uoid_create(SAI_OBJECT_TYPE_ACL_TABLE_GROUP,obj_id);
-
-    if(sai_acl_table_group_find(acl_node->sai_acl_table_group_tree,
-                                acl_table_group_id) != NULL) {
-        return true;
-    } else {
-        return false;
+    if(SAI_STATUS_SUCCESS ==
+       dn_sai_index_pool_alloc(&acl_table_group_index_pool, &index)) {
+        return (sai_uoid_create(SAI_OBJECT_TYPE_ACL_TABLE_GROUP, index));
     }
+    return SAI_NULL_OBJECT_ID;
 }
 
-static sai_object_id_t sai_acl_table_group_id_create(void)
+static void sai_acl_table_group_id_free(sai_object_id_t acl_table_group_id)
 {
-    if(SAI_STATUS_SUCCESS ==
-       dn_sai_get_next_free_id(&acl_table_group_obj_info)) {
-        return (sai_uoid_create(SAI_OBJECT_TYPE_ACL_TABLE_GROUP,
-                                acl_table_group_obj_info.cur_id));
-    }
-    return SAI_NULL_OBJECT_ID;
+    dn_sai_index_pool_free(&acl_table_group_index_pool,
+                           sai_uoid_npu_obj_id_get(acl_table_group_id));
 }
 
 void sai_acl_table_group_init(void)
 {
-    acl_table_group_obj_info.cur_id = 0;
-    acl_table_group_obj_info.is_wrappped = false;
-    acl_table_group_obj_info.mask = SAI_UOID_NPU_OBJ_ID_MASK;
-    acl_table_group_obj_info.is_id_in_use = sai_is_acl_table_group_id_in_use;
+    acl_node_pt            acl_node = sai_acl_get_acl_node();
+    sai_acl_table_group_t *p_acl_table_group_node = NULL;
+
+    dn_sai_index_pool_deinit(&acl_table_group_index_pool);
+    dn_sai_index_pool_init(&acl_table_group_index_pool, 1, SAI_UOID_NPU_OBJ_ID_MASK);
+
+    /* Table groups already present keep their id */
+    for(p_acl_table_group_node = (sai_acl_table_group_t *)
+            std_rbtree_getfirst(acl_node->sai_acl_table_group_tree);
+        p_acl_table_group_node != NULL;
+        p_acl_table_group_node = (sai_acl_table_group_t *)
+            std_rbtree_getnext(acl_node->sai_acl_table_group_tree,
+                               p_acl_table_group_node)) {
+        dn_sai_index_pool_reserve(&acl_table_group_index_pool,
+                sai_uoid_npu_obj_id_get(p_acl_table_group_node->acl_table_group_id));
+    }
 }
 
 static inline void dn_sai_acl_table_group_attr_table_get (const dn_sai_attribute_entry_t **p_attr_table,
@@ -319,6 +322,10 @@ sai_status_t sai_acl_table_group_create(sai_object_id_t *acl_table_group_id,
     }
     else{
         SAI_ACL_LOG_ERR("Acl table group create failed");
+        if((p_acl_table_group_node != NULL) &&
+           (p_acl_table_group_node->acl_table_group_id != SAI_NULL_OBJECT_ID)) {
+            sai_acl_table_group_id_free(p_acl_table_group_node->acl_table_group_id);
+        }
         sai_acl_table_group_free(p_acl_table_group_node);
     }
 
@@ -378,6 +385,7 @@ sai_status_t sai_acl_table_group_delete(sai_object_id_t acl_table_group_id)
     }
     else {
         SAI_ACL_LOG_TRACE ("Removed acl table group 0x%"PRIx64"", acl_table_group_id);
+        sai_acl_table_group_id_free(acl_table_group_id);
         sai_acl_table_group_free(p_acl_table_group_node);
     }
 
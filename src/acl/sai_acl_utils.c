@@ -181,3 +181,40 @@ uint_t sai_acl_fp_slice_depth_get (sai_acl_stage_t stage, sai_uint32_t slice_id)
     return 0;
 }
 
+sai_status_t sai_acl_bulk_params_validate(uint32_t object_count,
+                                          sai_bulk_op_error_mode_t mode,
+                                          sai_status_t *object_statuses)
+{
+    uint32_t idx;
+
+    if ((object_count == 0) || (object_statuses == NULL)) {
+        SAI_ACL_LOG_ERR ("Invalid bulk ACL parameters, count %u", object_count);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if ((mode != SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) &&
+        (mode != SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR)) {
+        SAI_ACL_LOG_ERR ("Invalid bulk ACL error mode %d", mode);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for (idx = 0; idx < object_count; idx++) {
+        object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_acl_bulk_status_get(uint32_t object_count,
+                                     const sai_status_t *object_statuses)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < object_count; idx++) {
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS) {
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
@@ -135,6 +135,106 @@ sai_status_t sai_npu_delete_acl_cntr (sai_acl_counter_t *acl_cntr)
     return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t sai_npu_create_acl_cntrs (sai_acl_table_t *acl_table, uint_t count,
+                                       sai_acl_counter_t **cntr_list)
+{
+    sai_status_t        sai_rc = SAI_STATUS_SUCCESS;
+    sai_npu_object_id_t table_id = 0;
+    uint_t              cntr_id = 0;
+    uint_t              idx = 0;
+    int                 free_idx = -1;
+
+    STD_ASSERT(acl_table != NULL);
+    STD_ASSERT(cntr_list != NULL);
+
+    SAI_ACL_LOG_TRACE ("NPU ACL Counter batch Creation API, %u counters.",
+                       count);
+
+    table_id = sai_uoid_npu_obj_id_get (acl_table->table_key.acl_table_id);
+
+    /* Take the counter indices of the batch in one pass over the bitmap */
+    for (idx = 0; idx < count; idx++) {
+        free_idx = std_find_first_bit (sai_vm_access_acl_cntr_bitmap (table_id),
+                                       SAI_VM_ACL_TABLE_MAX_COUNTERS,
+                                       free_idx + 1);
+
+        if (free_idx < 0) {
+            SAI_ACL_LOG_ERR ("No free counters available for %u counters on "
+                             "ACL TABLE 0x%"PRIx64" (object Id: 0x%"PRIx64").",
+                             count, table_id, acl_table->table_key.acl_table_id);
+
+            return SAI_STATUS_TABLE_FULL;
+        }
+
+        cntr_id = sai_vm_acl_bmp_idx_to_counter_id_get (table_id, free_idx);
+
+        cntr_list [idx]->counter_key.counter_id =
+            sai_uoid_create (SAI_OBJECT_TYPE_ACL_COUNTER,
+                             (sai_npu_object_id_t) cntr_id);
+    }
+
+    /* Insert the ACL Counter object records of the batch to DB. */
+    sai_rc = sai_acl_counter_create_db_entries (count, cntr_list);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_ACL_LOG_ERR ("Error inserting %u entries to DB for ACL Counters on "
+                         "Table Obj Id: 0x%"PRIx64".", count,
+                         acl_table->table_key.acl_table_id);
+
+        return sai_rc;
+    }
+
+    for (idx = 0; idx < count; idx++) {
+        cntr_id = sai_uoid_npu_obj_id_get (cntr_list [idx]->counter_key.counter_id);
+
+        STD_BIT_ARRAY_CLR (sai_vm_access_acl_cntr_bitmap (table_id),
+                           sai_vm_acl_counter_id_to_bmp_idx_get (cntr_id));
+    }
+
+    SAI_ACL_LOG_TRACE ("ACL Counter batch Creation success, %u counters on "
+                       "Table Obj Id: 0x%"PRIx64".", count,
+                       acl_table->table_key.acl_table_id);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_npu_delete_acl_cntrs (uint_t count,
+                                       sai_acl_counter_t **cntr_list)
+{
+    sai_status_t        sai_rc = SAI_STATUS_SUCCESS;
+    sai_npu_object_id_t table_id = 0;
+    sai_npu_object_id_t cntr_id = 0;
+    uint_t              idx = 0;
+
+    SAI_ACL_LOG_TRACE ("NPU ACL Counter batch deletion API, %u counters.",
+                       count);
+
+    STD_ASSERT(cntr_list != NULL);
+
+    /* Remove the ACL Counter object records of the batch from DB. */
+    sai_rc = sai_acl_counter_delete_db_entries (count, cntr_list);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_ACL_LOG_ERR ("Error removing %u entries from DB for ACL Counters.",
+                         count);
+
+        return sai_rc;
+    }
+
+    for (idx = 0; idx < count; idx++) {
+        table_id = sai_uoid_npu_obj_id_get (cntr_list [idx]->table_id);
+        cntr_id = sai_uoid_npu_obj_id_get (cntr_list [idx]->counter_key.counter_id);
+
+        STD_BIT_ARRAY_SET (sai_vm_access_acl_cntr_bitmap (table_id),
+                           sai_vm_acl_counter_id_to_bmp_idx_get (cntr_id));
+    }
+
+    SAI_ACL_LOG_TRACE ("ACL Counter batch deletion success, %u counters.",
+                       count);
+
+    return SAI_STATUS_SUCCESS;
+}
+
 sai_status_t sai_npu_set_acl_cntr (sai_acl_counter_t *acl_cntr,
                                    uint64_t count_value, bool byte_set)
 {
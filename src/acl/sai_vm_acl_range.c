@@ -26,11 +26,83 @@
 #include "sai_acl_npu_api.h"
 #include "sai_acl_type_defs.h"
 #include "sai_acl_utils.h"
+#include "sai_vm_acl_util.h"
 #include "saitypes.h"
 #include "saistatus.h"
 #include "std_bit_masks.h"
 #include "std_assert.h"
 #include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Values of a L4 port, the bits of a port range membership bitmap */
+#define SAI_VM_ACL_RANGE_L4_PORT_MAX      (0xffff)
+#define SAI_VM_ACL_RANGE_BMP_WORD_BITS    (64)
+#define SAI_VM_ACL_RANGE_BMP_WORDS \
+        ((SAI_VM_ACL_RANGE_L4_PORT_MAX + 1) / SAI_VM_ACL_RANGE_BMP_WORD_BITS)
+
+/**
+ * Compiled range checker of an ACL range, hung off npu_range_info.
+ * L4 port ranges are compiled into a 64K bit membership bitmap so a port
+ * is checked with a single bit test. Other range types keep their limits.
+ */
+typedef struct _sai_vm_acl_range_checker_t {
+    int32_t   min;
+    int32_t   max;
+    uint64_t *port_bmp;
+} sai_vm_acl_range_checker_t;
+
+static inline bool sai_vm_acl_range_is_l4_port (sai_acl_range_type_t range_type)
+{
+    return ((range_type == SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE) ||
+            (range_type == SAI_ACL_RANGE_TYPE_L4_DST_PORT_RANGE));
+}
+
+/* Fill the port bitmap with the limits, clamped to the L4 port values */
+static void sai_vm_acl_range_port_bmp_fill (uint64_t *port_bmp,
+                                            int32_t min, int32_t max)
+{
+    uint_t first_word = 0;
+    uint_t last_word = 0;
+    uint_t word = 0;
+
+    memset (port_bmp, 0, SAI_VM_ACL_RANGE_BMP_WORDS * sizeof (uint64_t));
+
+    if (min < 0) {
+        min = 0;
+    }
+
+    if (max > SAI_VM_ACL_RANGE_L4_PORT_MAX) {
+        max = SAI_VM_ACL_RANGE_L4_PORT_MAX;
+    }
+
+    if (min > max) {
+        return;
+    }
+
+    first_word = min / SAI_VM_ACL_RANGE_BMP_WORD_BITS;
+    last_word = max / SAI_VM_ACL_RANGE_BMP_WORD_BITS;
+
+    for (word = first_word; word <= last_word; word++) {
+        port_bmp [word] = ~0ULL;
+    }
+
+    port_bmp [first_word] &= ~0ULL << (min % SAI_VM_ACL_RANGE_BMP_WORD_BITS);
+    port_bmp [last_word] &= ~0ULL >> ((SAI_VM_ACL_RANGE_BMP_WORD_BITS - 1) -
+                                      (max % SAI_VM_ACL_RANGE_BMP_WORD_BITS));
+}
+
+static void sai_vm_acl_range_checker_compile (sai_vm_acl_range_checker_t *checker,
+                                              const sai_acl_range_t *acl_range)
+{
+    checker->min = acl_range->range_limit.min;
+    checker->max = acl_range->range_limit.max;
+
+    if (checker->port_bmp != NULL) {
+        sai_vm_acl_range_port_bmp_fill (checker->port_bmp, checker->min,
+                                        checker->max);
+    }
+}
 
 
 /**
@@ -39,7 +111,8 @@
  */
 static const dn_sai_attribute_entry_t sai_range_attr[] = {
     {SAI_ACL_RANGE_ATTR_TYPE, true, true, false, true, true, true},
-    {SAI_ACL_RANGE_ATTR_LIMIT, true, true, false, true, true, true},
+    /* Limits are settable, a set rebuilds the range checker of the range */
+    {SAI_ACL_RANGE_ATTR_LIMIT, true, true, true, true, true, true},
 };
 
 
@@ -56,24 +129,72 @@ void sai_npu_range_attribute_table_get(const dn_sai_attribute_entry_t
 
 sai_status_t sai_npu_create_acl_range(sai_acl_range_t *acl_range)
 {
+    sai_vm_acl_range_checker_t *checker = NULL;
+
     STD_ASSERT(acl_range != NULL);
 
+    checker = (sai_vm_acl_range_checker_t *) calloc (1, sizeof (*checker));
+
+    if (checker == NULL) {
+        SAI_ACL_LOG_ERR ("Failed to allocate range checker for range 0x%"PRIx64".",
+                         acl_range->acl_range_id);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    if (sai_vm_acl_range_is_l4_port (acl_range->range_type)) {
+        checker->port_bmp = (uint64_t *) calloc (SAI_VM_ACL_RANGE_BMP_WORDS,
+                                                 sizeof (uint64_t));
+
+        if (checker->port_bmp == NULL) {
+            SAI_ACL_LOG_ERR ("Failed to allocate port bitmap for range "
+                             "0x%"PRIx64".", acl_range->acl_range_id);
+            free (checker);
+            return SAI_STATUS_NO_MEMORY;
+        }
+    }
+
+    sai_vm_acl_range_checker_compile (checker, acl_range);
+
+    acl_range->npu_range_info = checker;
+
     return SAI_STATUS_SUCCESS;
 }
 
 
 sai_status_t sai_npu_delete_acl_range(sai_acl_range_t *acl_range)
 {
+    sai_vm_acl_range_checker_t *checker = NULL;
+
     STD_ASSERT(acl_range != NULL);
 
+    checker = (sai_vm_acl_range_checker_t *) acl_range->npu_range_info;
+
+    if (checker != NULL) {
+        free (checker->port_bmp);
+        free (checker);
+        acl_range->npu_range_info = NULL;
+    }
+
     return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t sai_npu_set_acl_range(sai_acl_range_t *acl_range, uint_t attr_count,
                                    const sai_attribute_t *p_attr)
 {
+    sai_vm_acl_range_checker_t *checker = NULL;
+
     STD_ASSERT(acl_range != NULL);
 
+    checker = (sai_vm_acl_range_checker_t *) acl_range->npu_range_info;
+
+    /*
+     * The range node passed holds the new limits and shares the checker
+     * of the range in the tree, only the checker of this range is rebuilt.
+     */
+    if (checker != NULL) {
+        sai_vm_acl_range_checker_compile (checker, acl_range);
+    }
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -86,3 +207,24 @@ sai_status_t sai_npu_get_acl_range(sai_acl_range_t *acl_range, uint_t attr_count
     return SAI_STATUS_SUCCESS;
 }
 
+bool sai_vm_acl_range_match(const sai_acl_range_t *acl_range, uint_t value)
+{
+    const sai_vm_acl_range_checker_t *checker = NULL;
+
+    STD_ASSERT(acl_range != NULL);
+
+    checker = (const sai_vm_acl_range_checker_t *) acl_range->npu_range_info;
+
+    if (checker == NULL) {
+        return false;
+    }
+
+    if (checker->port_bmp != NULL) {
+        return ((value <= SAI_VM_ACL_RANGE_L4_PORT_MAX) &&
+                ((checker->port_bmp [value / SAI_VM_ACL_RANGE_BMP_WORD_BITS] >>
+                  (value % SAI_VM_ACL_RANGE_BMP_WORD_BITS)) & 1));
+    }
+
+    return (((int64_t) value >= checker->min) &&
+            ((int64_t) value <= checker->max));
+}
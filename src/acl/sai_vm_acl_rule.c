@@ -236,6 +236,73 @@ sai_status_t sai_npu_delete_acl_rule (sai_acl_table_t *acl_table,
     return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t sai_npu_create_acl_rules (sai_acl_table_t *acl_table, uint_t count,
+                                       sai_acl_rule_t **rule_list)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    uint_t       idx = 0;
+
+    SAI_ACL_LOG_TRACE ("NPU ACL Rule batch Creation API, %u rules.", count);
+
+    STD_ASSERT (acl_table != NULL);
+    STD_ASSERT (rule_list != NULL);
+
+    for (idx = 0; idx < count; idx++) {
+        if (!sai_is_acl_rule_fields_in_table (acl_table, rule_list [idx],
+                                              true /* isCreate */)) {
+            SAI_ACL_LOG_ERR ("All Rule filters of ACL Entry 0x%"PRIx64" not "
+                             "present in table Obj ID: 0x%"PRIx64".",
+                             rule_list [idx]->rule_key.acl_id,
+                             acl_table->table_key.acl_table_id);
+
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+    }
+
+    /* Insert the ACL Entry object records of the batch to DB. */
+    sai_rc = sai_acl_rule_create_db_entries (count, rule_list);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_ACL_LOG_ERR ("Error inserting %u entries to DB on Table Obj Id: "
+                         "0x%"PRIx64".", count, acl_table->table_key.acl_table_id);
+
+        return sai_rc;
+    }
+
+    SAI_ACL_LOG_TRACE ("ACL Entry batch Creation success, %u entries on Table "
+                       "Obj Id: 0x%"PRIx64".", count,
+                       acl_table->table_key.acl_table_id);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_npu_delete_acl_rules (sai_acl_table_t *acl_table, uint_t count,
+                                       sai_acl_rule_t **rule_list)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    SAI_ACL_LOG_TRACE ("NPU ACL Rule batch deletion API, %u rules.", count);
+
+    STD_ASSERT (acl_table != NULL);
+    STD_ASSERT (rule_list != NULL);
+
+    /* Remove the ACL Entry object records of the batch from DB. */
+    sai_rc = sai_acl_rule_delete_db_entries (count, rule_list);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_ACL_LOG_ERR ("Error removing %u entries from DB on Table Obj Id: "
+                         "0x%"PRIx64".", count, acl_table->table_key.acl_table_id);
+
+        return sai_rc;
+    }
+
+    SAI_ACL_LOG_TRACE ("ACL Entry batch deletion success, %u entries from Table "
+                       "Obj Id: 0x%"PRIx64".", count,
+                       acl_table->table_key.acl_table_id);
+
+    return SAI_STATUS_SUCCESS;
+}
+
 sai_status_t sai_npu_set_acl_rule (sai_acl_table_t *acl_table,
                                    sai_acl_rule_t *set_rule,
                                    sai_acl_rule_t *compare_rule,
@@ -195,6 +195,10 @@ static sai_npu_acl_api_t sai_vm_acl_api_table = {
     sai_npu_acl_dump_all_counters,
     sai_npu_acl_dump_counter_per_entry,
     sai_npu_get_acl_slice_attribute,
+    sai_npu_create_acl_rules,
+    sai_npu_delete_acl_rules,
+    sai_npu_create_acl_cntrs,
+    sai_npu_delete_acl_cntrs,
 };
 
 sai_npu_acl_api_t* sai_vm_acl_api_query (void)
@@ -205,6 +205,7 @@ static sai_status_t sai_bridge_set_attribute (sai_object_id_t bridge_id,
         return sai_rc;
     }
     sai_bridge_update_attr_value_in_cache (p_bridge_info, attr);
+    sai_bridge_cache_publish (bridge_id);
 
     return sai_rc;
 }
@@ -22,6 +22,7 @@
 #include "sai_map_utl.h"
 #include <unordered_map>
 #include <vector>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -31,9 +32,256 @@
 #include "sai_bridge_common.h"
 
 
+/*
+ * Lock free read index of a cache.
+ *
+ * The caches are only updated with the bridge lock held and hand out pointers
+ * to their entries, which the bridge lock holder may change in place. Each
+ * cache is mirrored by an open addressing table under a sequence count: the
+ * writer makes the count odd, changes the table and makes it even again. A
+ * reader copies an entry out of the table without taking any lock and retries
+ * when the count moved meanwhile, so it never sees a half written entry.
+ *
+ * Entries are copied as 64 bit words with atomic accesses. Deletion shifts the
+ * following entries back, leaving no tombstones, so a table only grows when
+ * the live entries need it. A grown out table is kept, since a reader may still
+ * be probing it; what is kept is bounded by the size of the current table.
+ */
+template <typename T>
+class sai_bridge_index {
+
+    static_assert ((sizeof (T) % sizeof (uint64_t)) == 0,
+                   "Indexed entry must be a whole number of 64 bit words");
+
+    static const size_t words = sizeof (T) / sizeof (uint64_t);
+    static const size_t min_size = 64;
+
+    struct slot {
+        sai_object_id_t key;
+        uint64_t        value [words];
+    };
+
+    struct table {
+        size_t            mask;
+        std::vector<slot> slots;
+
+        table (size_t size) : mask (size - 1), slots (size) {}
+    };
+
+    uint_t               seq = 0;
+    uint_t               cnt = 0;
+    table               *tbl = new table (min_size);
+    std::vector<table *> retired;
+
+    static size_t home (const table *t, sai_object_id_t key)
+    {
+        uint64_t hash = key * 0x9e3779b97f4a7c15ULL;
+
+        return (size_t)(hash ^ (hash >> 32)) & t->mask;
+    }
+
+    static void slot_set (slot *s, sai_object_id_t key, const uint64_t *value)
+    {
+        for (size_t idx = 0; idx < words; idx++) {
+            __atomic_store_n (&s->value [idx], value [idx], __ATOMIC_RELAXED);
+        }
+        __atomic_store_n (&s->key, key, __ATOMIC_RELAXED);
+    }
+
+    /* Slot of key, or the empty slot ending its probe sequence */
+    static size_t probe (const table *t, sai_object_id_t key)
+    {
+        size_t idx = home (t, key);
+
+        while ((t->slots [idx].key != key) &&
+               (t->slots [idx].key != SAI_NULL_OBJECT_ID)) {
+            idx = (idx + 1) & t->mask;
+        }
+        return idx;
+    }
+
+    void write_begin (void)
+    {
+        __atomic_store_n (&seq, seq + 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence (__ATOMIC_RELEASE);
+    }
+
+    void write_end (void)
+    {
+        __atomic_store_n (&seq, seq + 1, __ATOMIC_RELEASE);
+    }
+
+    uint_t read_begin (void) const
+    {
+        uint_t start;
+
+        while ((start = __atomic_load_n (&seq, __ATOMIC_ACQUIRE)) & 1) {
+            /* A writer is in the table, for a few stores only */
+        }
+        return start;
+    }
+
+    bool read_retry (uint_t start) const
+    {
+        __atomic_thread_fence (__ATOMIC_ACQUIRE);
+        return (__atomic_load_n (&seq, __ATOMIC_RELAXED) != start);
+    }
+
+  public:
+
+    /* Make room for one more entry. Writer only, may throw. */
+    void reserve (void)
+    {
+        if (((cnt + 1) * 2) <= tbl->slots.size()) {
+            return;
+        }
+
+        table *grown = new table (tbl->slots.size() * 2);
+
+        retired.reserve (retired.size() + 1);
+
+        for (const slot &s : tbl->slots) {
+            if (s.key != SAI_NULL_OBJECT_ID) {
+                grown->slots [probe (grown, s.key)] = s;
+            }
+        }
+        retired.push_back (tbl);
+        __atomic_store_n (&tbl, grown, __ATOMIC_RELEASE);
+    }
+
+    /* Add or replace the entry of key. Writer only, after reserve. */
+    void write (sai_object_id_t key, const T &entry)
+    {
+        uint64_t value [words];
+        size_t   idx = probe (tbl, key);
+
+        memcpy (value, &entry, sizeof (T));
+
+        write_begin ();
+        if (tbl->slots [idx].key == SAI_NULL_OBJECT_ID) {
+            __atomic_store_n (&cnt, cnt + 1, __ATOMIC_RELAXED);
+        }
+        slot_set (&tbl->slots [idx], key, value);
+        write_end ();
+    }
+
+    /* Remove the entry of key. Writer only. */
+    void erase (sai_object_id_t key)
+    {
+        table  *t = tbl;
+        size_t  hole = probe (t, key);
+        size_t  idx = hole;
+
+        if (t->slots [hole].key == SAI_NULL_OBJECT_ID) {
+            return;
+        }
+
+        write_begin ();
+        for (;;) {
+            idx = (idx + 1) & t->mask;
+
+            const slot &next = t->slots [idx];
+
+            if (next.key == SAI_NULL_OBJECT_ID) {
+                break;
+            }
+            /* Move back the entries whose home is not between the hole and them */
+            size_t dist_hole = (hole - home (t, next.key)) & t->mask;
+            size_t dist_idx = (idx - home (t, next.key)) & t->mask;
+
+            if (dist_hole <= dist_idx) {
+                slot_set (&t->slots [hole], next.key, next.value);
+                hole = idx;
+            }
+        }
+        __atomic_store_n (&t->slots [hole].key, SAI_NULL_OBJECT_ID, __ATOMIC_RELAXED);
+        __atomic_store_n (&cnt, cnt - 1, __ATOMIC_RELAXED);
+        write_end ();
+    }
+
+    /* Copy out the entry of key, if any. Lock free. */
+    bool read (sai_object_id_t key, T *entry) const
+    {
+        uint64_t value [words];
+        bool     found;
+        uint_t   start;
+
+        do {
+            start = read_begin ();
+
+            const table *t = __atomic_load_n (&tbl, __ATOMIC_ACQUIRE);
+            size_t       idx = home (t, key);
+
+            found = false;
+            for (size_t probes = 0; probes <= t->mask; probes++) {
+                const slot      &s = t->slots [idx];
+                sai_object_id_t  s_key = __atomic_load_n (&s.key, __ATOMIC_RELAXED);
+
+                if (s_key == SAI_NULL_OBJECT_ID) {
+                    break;
+                }
+                if (s_key == key) {
+                    for (size_t word = 0; word < words; word++) {
+                        value [word] = __atomic_load_n (&s.value [word], __ATOMIC_RELAXED);
+                    }
+                    found = true;
+                    break;
+                }
+                idx = (idx + 1) & t->mask;
+            }
+        } while (read_retry (start));
+
+        if (found && (entry != NULL)) {
+            memcpy (entry, value, sizeof (T));
+        }
+        return found;
+    }
+
+    /* Entry count. Lock free. */
+    uint_t count (void) const
+    {
+        return __atomic_load_n (&cnt, __ATOMIC_RELAXED);
+    }
+
+    /*
+     * Copy out the keys of one consistent snapshot. Lock free. Returns false,
+     * with the entry count in total, when they do not fit in max_count.
+     */
+    bool keys_get (uint_t max_count, uint_t *total, sai_object_id_t *key_list) const
+    {
+        uint_t start;
+        uint_t idx;
+
+        do {
+            start = read_begin ();
+
+            const table *t = __atomic_load_n (&tbl, __ATOMIC_ACQUIRE);
+
+            idx = 0;
+            for (const slot &s : t->slots) {
+                sai_object_id_t s_key = __atomic_load_n (&s.key, __ATOMIC_RELAXED);
+
+                if (s_key == SAI_NULL_OBJECT_ID) {
+                    continue;
+                }
+                if (idx < max_count) {
+                    key_list [idx] = s_key;
+                }
+                idx++;
+            }
+        } while (read_retry (start));
+
+        *total = idx;
+        return (idx <= max_count);
+    }
+};
+
 static std::unordered_map<sai_object_id_t, dn_sai_bridge_info_t> bridge_db;
 static std::unordered_map<sai_object_id_t, dn_sai_bridge_port_info_t> bridge_port_db;
 
+static sai_bridge_index<dn_sai_bridge_info_t> bridge_index;
+static sai_bridge_index<dn_sai_bridge_port_info_t> bridge_port_index;
+
 extern "C" {
 
 sai_status_t sai_bridge_cache_write (sai_object_id_t bridge_id, const dn_sai_bridge_info_t *bridge_info)
@@ -46,6 +294,8 @@ sai_status_t sai_bridge_cache_write (sai_object_id_t bridge_id, const dn_sai_bri
         return SAI_STATUS_INVALID_PARAMETER;
     }
     try {
+        bridge_index.reserve ();
+
         auto map_it = bridge_db.find (bridge_id);
 
         if (map_it != bridge_db.end()) {
@@ -55,6 +305,7 @@ sai_status_t sai_bridge_cache_write (sai_object_id_t bridge_id, const dn_sai_bri
         else {
             bridge_db.insert (std::make_pair (bridge_id, *bridge_info));
         }
+        bridge_index.write (bridge_id, *bridge_info);
     }
     catch (...) {
         SAI_BRIDGE_LOG_WARN("Error condition encountered in bridge cache write");
@@ -71,6 +322,7 @@ sai_status_t sai_bridge_cache_delete (sai_object_id_t bridge_id)
     try {
         auto map_it = bridge_db.find (bridge_id);
         if (map_it != bridge_db.end()) {
+            bridge_index.erase (bridge_id);
             bridge_db.erase (map_it);
         }
     }
@@ -107,20 +359,31 @@ sai_status_t sai_bridge_cache_read (sai_object_id_t bridge_id, dn_sai_bridge_inf
     return rc;
 }
 
-bool sai_is_bridge_created (sai_object_id_t bridge_id)
+sai_status_t sai_bridge_cache_snapshot_read (sai_object_id_t bridge_id,
+                                             dn_sai_bridge_info_t *bridge_info)
 {
+    if(bridge_info == NULL) {
+        SAI_BRIDGE_LOG_TRACE("NULL bridge_info passed in bridge cache snapshot read");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+    if(!bridge_index.read (bridge_id, bridge_info)) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+    return SAI_STATUS_SUCCESS;
+}
 
+void sai_bridge_cache_publish (sai_object_id_t bridge_id)
+{
     auto map_it = bridge_db.find (bridge_id);
 
-    try {
-        if(map_it != bridge_db.end()) {
-            return true;
-        }
+    if (map_it != bridge_db.end()) {
+        bridge_index.write (bridge_id, map_it->second);
     }
-    catch (...) {
-        SAI_BRIDGE_LOG_WARN("Error condition encountered in is bridge created");
-    }
-    return false;
+}
+
+bool sai_is_bridge_created (sai_object_id_t bridge_id)
+{
+    return bridge_index.read (bridge_id, NULL);
 }
 
 sai_status_t sai_bridge_port_cache_write (sai_object_id_t bridge_port_id,
@@ -134,6 +397,8 @@ sai_status_t sai_bridge_port_cache_write (sai_object_id_t bridge_port_id,
         return SAI_STATUS_INVALID_PARAMETER;
     }
     try {
+        bridge_port_index.reserve ();
+
         rc = sai_bridge_map_insert(bridge_port_info->bridge_id,
                                    bridge_port_info->bridge_port_id);
 
@@ -151,6 +416,7 @@ sai_status_t sai_bridge_port_cache_write (sai_object_id_t bridge_port_id,
         else {
             bridge_port_db.insert (std::make_pair (bridge_port_id, *bridge_port_info));
         }
+        bridge_port_index.write (bridge_port_id, *bridge_port_info);
     }
     catch (...) {
         SAI_BRIDGE_LOG_WARN("Error condition encountered in bridge port cache write");
@@ -175,6 +441,7 @@ sai_status_t sai_bridge_port_cache_delete (sai_object_id_t bridge_port_id)
                 SAI_BRIDGE_LOG_ERR("Error %d in bridge to bridge port map remove", rc);
                 return rc;
             }
+            bridge_port_index.erase (bridge_port_id);
             bridge_port_db.erase (map_it);
         }
     }
@@ -213,84 +480,77 @@ sai_status_t sai_bridge_port_cache_read (sai_object_id_t bridge_port_id,
     return rc;
 }
 
-bool sai_is_bridge_port_created (sai_object_id_t bridge_port_id)
+sai_status_t sai_bridge_port_cache_snapshot_read (sai_object_id_t bridge_port_id,
+                                                  dn_sai_bridge_port_info_t *bridge_port_info)
 {
+    if(bridge_port_info == NULL) {
+        SAI_BRIDGE_LOG_TRACE("NULL bridge_port_info passed in bridge port cache snapshot read");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+    if(!bridge_port_index.read (bridge_port_id, bridge_port_info)) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+    return SAI_STATUS_SUCCESS;
+}
 
+void sai_bridge_port_cache_publish (sai_object_id_t bridge_port_id)
+{
     auto map_it = bridge_port_db.find (bridge_port_id);
 
-    try {
-        if(map_it != bridge_port_db.end()) {
-            return true;
-        }
+    if (map_it != bridge_port_db.end()) {
+        bridge_port_index.write (bridge_port_id, map_it->second);
     }
-    catch (...) {
-        SAI_BRIDGE_LOG_WARN("Error condition encountered in is bridge port created");
-    }
-    return false;
+}
+
+bool sai_is_bridge_port_created (sai_object_id_t bridge_port_id)
+{
+    return bridge_port_index.read (bridge_port_id, NULL);
 }
 
 uint_t sai_bridge_total_count(void)
 {
-    return bridge_db.size();
+    return bridge_index.count();
 }
 
 uint_t sai_bridge_port_total_count(void)
 {
-    return bridge_port_db.size();
+    return bridge_port_index.count();
 }
 
 sai_status_t sai_bridge_list_get(uint_t *count, sai_object_id_t *bridge_list)
 {
-    uint_t idx = 0;
+    uint_t total = 0;
 
     if((count == NULL) || (bridge_list == NULL)) {
         SAI_BRIDGE_LOG_TRACE("count is %p bridge list is %p in bridge list get",
                              count, bridge_list);
+        return SAI_STATUS_INVALID_PARAMETER;
     }
-    if(*count < sai_bridge_total_count()) {
+    if(!bridge_index.keys_get(*count, &total, bridge_list)) {
         SAI_BRIDGE_LOG_ERR("Expected %d count but actual count is %d",
-                           sai_bridge_total_count(),*count);
+                           total, *count);
         return SAI_STATUS_BUFFER_OVERFLOW;
     }
-    try {
-        for(auto map_it = bridge_db.begin(); map_it != bridge_db.end();map_it++) {
-            bridge_list[idx] = map_it->first;
-            idx++;
-        }
-    }
-    catch (...) {
-        SAI_BRIDGE_LOG_WARN("Error condition encountered in is bridge list get");
-        return SAI_STATUS_FAILURE;
-    }
-    *count = idx;
+    *count = total;
     return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t sai_bridge_port_list_get(uint_t *count, sai_object_id_t *bridge_port_list)
 {
-    uint_t idx = 0;
+    uint_t total = 0;
 
     if((count == NULL) || (bridge_port_list == NULL)) {
         SAI_BRIDGE_LOG_TRACE("count is %p bridge port list is %p in bridge port list get",
                              count, bridge_port_list);
+        return SAI_STATUS_INVALID_PARAMETER;
     }
-    if(*count < sai_bridge_port_total_count()) {
+    if(!bridge_port_index.keys_get(*count, &total, bridge_port_list)) {
         SAI_BRIDGE_LOG_ERR("Expected %d count but actual count is %d",
-                           sai_bridge_port_total_count(),*count);
-        *count = sai_bridge_port_total_count();
+                           total, *count);
+        *count = total;
         return SAI_STATUS_BUFFER_OVERFLOW;
     }
-    try {
-        for(auto map_it = bridge_port_db.begin(); map_it != bridge_port_db.end();map_it++) {
-            bridge_port_list[idx] = map_it->first;
-            idx++;
-        }
-    }
-    catch (...) {
-        SAI_BRIDGE_LOG_WARN("Error condition encountered in is bridge port list get");
-        return SAI_STATUS_FAILURE;
-    }
-    *count = idx;
+    *count = total;
     return SAI_STATUS_SUCCESS;
 }
 
@@ -633,6 +633,7 @@ static sai_status_t sai_bridge_port_set_attribute (sai_object_id_t bridge_port_i
         return sai_rc;
     }
     sai_bridge_port_update_attr_value_in_cache (p_bridge_port_info, attr);
+    sai_bridge_port_cache_publish (bridge_port_id);
 
     return sai_rc;
 }
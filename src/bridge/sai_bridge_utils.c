@@ -38,12 +38,13 @@
 #include "sai_gen_utils.h"
 #include "sai_map_utl.h"
 #include "sai_l2mc_api.h"
+#include "sai_api_stats.h"
 
 static std_mutex_lock_create_static_init_fast(bridge_lock);
 
 void sai_bridge_lock(void)
 {
-    std_mutex_lock(&bridge_lock);
+    sai_api_stats_mutex_lock(&bridge_lock);
 }
 
 void sai_bridge_unlock(void)
@@ -1058,6 +1059,7 @@ sai_status_t sai_bridge_increment_ref_count(sai_object_id_t bridge_id)
         return SAI_STATUS_INVALID_PARAMETER;
     }
     p_bridge_info->ref_count++;
+    sai_bridge_cache_publish(bridge_id);
     return SAI_STATUS_SUCCESS;
 }
 
@@ -1072,6 +1074,7 @@ sai_status_t sai_bridge_decrement_ref_count(sai_object_id_t bridge_id)
         return SAI_STATUS_INVALID_PARAMETER;
     }
     p_bridge_info->ref_count--;
+    sai_bridge_cache_publish(bridge_id);
     return SAI_STATUS_SUCCESS;
 }
 
@@ -1087,6 +1090,7 @@ sai_status_t sai_bridge_port_increment_ref_count(sai_object_id_t bridge_port_id)
         return SAI_STATUS_INVALID_PARAMETER;
     }
     p_bridge_port_info->ref_count++;
+    sai_bridge_port_cache_publish(bridge_port_id);
     return SAI_STATUS_SUCCESS;
 }
 
@@ -1102,6 +1106,7 @@ sai_status_t sai_bridge_port_decrement_ref_count(sai_object_id_t bridge_port_id)
         return SAI_STATUS_INVALID_PARAMETER;
     }
     p_bridge_port_info->ref_count--;
+    sai_bridge_port_cache_publish(bridge_port_id);
     return SAI_STATUS_SUCCESS;
 }
 
@@ -1116,6 +1121,7 @@ sai_status_t sai_bridge_port_increment_fdb_count(sai_object_id_t bridge_port_id)
         return SAI_STATUS_INVALID_PARAMETER;
     }
     p_bridge_port_info->fdb_count++;
+    sai_bridge_port_cache_publish(bridge_port_id);
     return SAI_STATUS_SUCCESS;
 }
 
@@ -1134,6 +1140,7 @@ sai_status_t sai_bridge_port_decrement_fdb_count(sai_object_id_t bridge_port_id)
         return SAI_STATUS_INVALID_PARAMETER;
     }
     p_bridge_port_info->fdb_count--;
+    sai_bridge_port_cache_publish(bridge_port_id);
     return SAI_STATUS_SUCCESS;
 }
 
@@ -1309,7 +1316,7 @@ bool sai_bridge_port_is_duplicate_attr_val(const dn_sai_bridge_port_info_t *brid
 sai_status_t sai_bridge_port_get_bridge_id(sai_object_id_t bridge_port_id,
                                            sai_object_id_t *bridge_id)
 {
-    dn_sai_bridge_port_info_t *p_bridge_port_info = NULL;
+    dn_sai_bridge_port_info_t  bridge_port_info;
     sai_status_t               sai_rc = SAI_STATUS_FAILURE;
 
     if(bridge_id == NULL) {
@@ -1318,20 +1325,20 @@ sai_status_t sai_bridge_port_get_bridge_id(sai_object_id_t bridge_port_id,
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    sai_rc = sai_bridge_port_cache_read(bridge_port_id, &p_bridge_port_info);
+    sai_rc = sai_bridge_port_cache_snapshot_read(bridge_port_id, &bridge_port_info);
 
     if(sai_rc != SAI_STATUS_SUCCESS) {
         SAI_BRIDGE_LOG_ERR("Error %d in reading bridge port cache for bridge port"
                            " 0x%"PRIx64"", sai_rc, bridge_port_id);
         return sai_rc;
     }
-    *bridge_id = p_bridge_port_info->bridge_id;
+    *bridge_id = bridge_port_info.bridge_id;
     return SAI_STATUS_SUCCESS;
 }
 sai_status_t sai_bridge_port_get_port_id(sai_object_id_t bridge_port_id,
                                          sai_object_id_t *sai_port_id)
 {
-    dn_sai_bridge_port_info_t *p_bridge_port_info = NULL;
+    dn_sai_bridge_port_info_t  bridge_port_info;
     sai_status_t               sai_rc = SAI_STATUS_FAILURE;
 
     if(sai_port_id == NULL) {
@@ -1340,21 +1347,21 @@ sai_status_t sai_bridge_port_get_port_id(sai_object_id_t bridge_port_id,
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    sai_rc = sai_bridge_port_cache_read(bridge_port_id, &p_bridge_port_info);
+    sai_rc = sai_bridge_port_cache_snapshot_read(bridge_port_id, &bridge_port_info);
 
     if(sai_rc != SAI_STATUS_SUCCESS) {
         SAI_BRIDGE_LOG_ERR("Error %d in reading bridge port cache for bridge port"
                            " 0x%"PRIx64"", sai_rc, bridge_port_id);
         return sai_rc;
     }
-    *sai_port_id = sai_bridge_port_info_get_port_id(p_bridge_port_info);
+    *sai_port_id = sai_bridge_port_info_get_port_id(&bridge_port_info);
     return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t sai_bridge_port_get_vlan_id(sai_object_id_t  bridge_port_id,
                                          uint16_t        *vlan_id)
 {
-    dn_sai_bridge_port_info_t *p_bridge_port_info = NULL;
+    dn_sai_bridge_port_info_t  bridge_port_info;
     sai_status_t               sai_rc = SAI_STATUS_FAILURE;
 
     if(vlan_id == NULL) {
@@ -1363,21 +1370,21 @@ sai_status_t sai_bridge_port_get_vlan_id(sai_object_id_t  bridge_port_id,
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    sai_rc = sai_bridge_port_cache_read(bridge_port_id, &p_bridge_port_info);
+    sai_rc = sai_bridge_port_cache_snapshot_read(bridge_port_id, &bridge_port_info);
 
     if(sai_rc != SAI_STATUS_SUCCESS) {
         SAI_BRIDGE_LOG_ERR("Error %d in reading bridge port cache for bridge port"
                            " 0x%"PRIx64"", sai_rc, bridge_port_id);
         return sai_rc;
     }
-    *vlan_id = sai_bridge_port_info_get_vlan_id(p_bridge_port_info);
+    *vlan_id = sai_bridge_port_info_get_vlan_id(&bridge_port_info);
     return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t sai_bridge_port_get_rif_id(sai_object_id_t  bridge_port_id,
                                         sai_object_id_t *rif_id)
 {
-    dn_sai_bridge_port_info_t *p_bridge_port_info = NULL;
+    dn_sai_bridge_port_info_t  bridge_port_info;
     sai_status_t               sai_rc = SAI_STATUS_FAILURE;
 
     if(rif_id == NULL) {
@@ -1386,21 +1393,21 @@ sai_status_t sai_bridge_port_get_rif_id(sai_object_id_t  bridge_port_id,
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    sai_rc = sai_bridge_port_cache_read(bridge_port_id, &p_bridge_port_info);
+    sai_rc = sai_bridge_port_cache_snapshot_read(bridge_port_id, &bridge_port_info);
 
     if(sai_rc != SAI_STATUS_SUCCESS) {
         SAI_BRIDGE_LOG_ERR("Error %d in reading bridge port cache for bridge port"
                            " 0x%"PRIx64"", sai_rc, bridge_port_id);
         return sai_rc;
     }
-    *rif_id = sai_bridge_port_info_get_rif_id(p_bridge_port_info);
+    *rif_id = sai_bridge_port_info_get_rif_id(&bridge_port_info);
     return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t sai_bridge_port_get_tunnel_id(sai_object_id_t  bridge_port_id,
                                            sai_object_id_t *tunnel_id)
 {
-    dn_sai_bridge_port_info_t *p_bridge_port_info = NULL;
+    dn_sai_bridge_port_info_t  bridge_port_info;
     sai_status_t               sai_rc = SAI_STATUS_FAILURE;
 
     if(tunnel_id == NULL) {
@@ -1409,14 +1416,14 @@ sai_status_t sai_bridge_port_get_tunnel_id(sai_object_id_t  bridge_port_id,
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    sai_rc = sai_bridge_port_cache_read(bridge_port_id, &p_bridge_port_info);
+    sai_rc = sai_bridge_port_cache_snapshot_read(bridge_port_id, &bridge_port_info);
 
     if(sai_rc != SAI_STATUS_SUCCESS) {
         SAI_BRIDGE_LOG_ERR("Error %d in reading bridge port cache for bridge port"
                            " 0x%"PRIx64"", sai_rc, bridge_port_id);
         return sai_rc;
     }
-    *tunnel_id = sai_bridge_port_info_get_tunnel_id(p_bridge_port_info);
+    *tunnel_id = sai_bridge_port_info_get_tunnel_id(&bridge_port_info);
     return SAI_STATUS_SUCCESS;
 }
 
@@ -1443,16 +1450,16 @@ void *sai_bridge_port_info_get_bridge_hw_info(dn_sai_bridge_port_info_t  *bridge
 bool sai_is_bridge_port_type_port(sai_object_id_t bridge_port_id)
 {
     sai_status_t sai_rc = SAI_STATUS_FAILURE;;
-    dn_sai_bridge_port_info_t *p_bridge_port_info = NULL;
+    dn_sai_bridge_port_info_t  bridge_port_info;
 
-    sai_rc = sai_bridge_port_cache_read(bridge_port_id, &p_bridge_port_info);
+    sai_rc = sai_bridge_port_cache_snapshot_read(bridge_port_id, &bridge_port_info);
 
-    if((sai_rc != SAI_STATUS_SUCCESS) || (p_bridge_port_info == NULL)) {
+    if(sai_rc != SAI_STATUS_SUCCESS) {
         SAI_BRIDGE_LOG_ERR("Error in reading cache for bridge port id 0x%"PRIx64"",
                            bridge_port_id);
         return false;
     }
-    return (p_bridge_port_info->bridge_port_type == SAI_BRIDGE_PORT_TYPE_PORT);
+    return (bridge_port_info.bridge_port_type == SAI_BRIDGE_PORT_TYPE_PORT);
 }
 
 bool sai_bridge_is_bridge_connected_to_tunnel(sai_object_id_t bridge_id,
@@ -1463,7 +1470,7 @@ bool sai_bridge_is_bridge_connected_to_tunnel(sai_object_id_t bridge_id,
     uint_t bridge_port_count = 0;
     sai_object_id_t bridge_port_id = SAI_NULL_OBJECT_ID;
     sai_status_t sai_rc = SAI_STATUS_FAILURE;
-    dn_sai_bridge_port_info_t *p_bridge_port_info = NULL;
+    dn_sai_bridge_port_info_t  bridge_port_info;
 
     sai_rc = sai_tunnel_to_bridge_port_count_get(tunnel_id, &bridge_port_count);
 
@@ -1489,8 +1496,8 @@ bool sai_bridge_is_bridge_connected_to_tunnel(sai_object_id_t bridge_id,
             continue;
         }
 
-        sai_rc = sai_bridge_port_cache_read(bridge_port_id,
-                                            &p_bridge_port_info);
+        sai_rc = sai_bridge_port_cache_snapshot_read(bridge_port_id,
+                                                     &bridge_port_info);
 
         if(sai_rc != SAI_STATUS_SUCCESS) {
             SAI_BRIDGE_LOG_ERR("Error %d in reading bridge port cache for bridge port"
@@ -1498,7 +1505,7 @@ bool sai_bridge_is_bridge_connected_to_tunnel(sai_object_id_t bridge_id,
             continue;
         }
 
-        if(p_bridge_port_info->bridge_id == bridge_id) {
+        if(bridge_port_info.bridge_id == bridge_id) {
             is_connected = true;
             break;
         }
@@ -1511,7 +1518,7 @@ sai_status_t sai_bridge_port_get_type(sai_object_id_t bridge_port_id,
                                       sai_bridge_port_type_t *bridge_port_type)
 {
     sai_status_t sai_rc = SAI_STATUS_FAILURE;;
-    dn_sai_bridge_port_info_t *p_bridge_port_info = NULL;
+    dn_sai_bridge_port_info_t  bridge_port_info;
 
     if(bridge_port_type == NULL) {
         SAI_BRIDGE_LOG_TRACE("Error bridge port type is null for bridge port 0x%"PRIx64""
@@ -1519,14 +1526,14 @@ sai_status_t sai_bridge_port_get_type(sai_object_id_t bridge_port_id,
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    sai_rc = sai_bridge_port_cache_read(bridge_port_id, &p_bridge_port_info);
+    sai_rc = sai_bridge_port_cache_snapshot_read(bridge_port_id, &bridge_port_info);
 
-    if((sai_rc != SAI_STATUS_SUCCESS) || (p_bridge_port_info == NULL)) {
+    if(sai_rc != SAI_STATUS_SUCCESS) {
         SAI_BRIDGE_LOG_ERR("Error in reading cache for bridge port id 0x%"PRIx64"",
                            bridge_port_id);
         return sai_rc;
     }
-    *bridge_port_type = p_bridge_port_info->bridge_port_type;
+    *bridge_port_type = bridge_port_info.bridge_port_type;
     return SAI_STATUS_SUCCESS;
 }
 
@@ -1656,47 +1663,47 @@ sai_status_t sai_bridge_port_to_l2mc_member_count_get(sai_object_id_t  bridge_po
 bool sai_is_bridge_port_type_sub_port(sai_object_id_t bridge_port_id)
 {
     sai_status_t sai_rc = SAI_STATUS_FAILURE;;
-    dn_sai_bridge_port_info_t *p_bridge_port_info = NULL;
+    dn_sai_bridge_port_info_t  bridge_port_info;
 
-    sai_rc = sai_bridge_port_cache_read(bridge_port_id, &p_bridge_port_info);
+    sai_rc = sai_bridge_port_cache_snapshot_read(bridge_port_id, &bridge_port_info);
 
-    if((sai_rc != SAI_STATUS_SUCCESS) || (p_bridge_port_info == NULL)) {
+    if(sai_rc != SAI_STATUS_SUCCESS) {
         SAI_BRIDGE_LOG_ERR("Error in reading cache for bridge port id 0x%"PRIx64"",
                            bridge_port_id);
         return false;
     }
-    return (p_bridge_port_info->bridge_port_type == SAI_BRIDGE_PORT_TYPE_SUB_PORT);
+    return (bridge_port_info.bridge_port_type == SAI_BRIDGE_PORT_TYPE_SUB_PORT);
 }
 
 bool sai_is_bridge_port_type_tunnel(sai_object_id_t bridge_port_id)
 {
     sai_status_t sai_rc = SAI_STATUS_FAILURE;;
-    dn_sai_bridge_port_info_t *p_bridge_port_info = NULL;
+    dn_sai_bridge_port_info_t  bridge_port_info;
 
-    sai_rc = sai_bridge_port_cache_read(bridge_port_id, &p_bridge_port_info);
+    sai_rc = sai_bridge_port_cache_snapshot_read(bridge_port_id, &bridge_port_info);
 
-    if((sai_rc != SAI_STATUS_SUCCESS) || (p_bridge_port_info == NULL)) {
+    if(sai_rc != SAI_STATUS_SUCCESS) {
         SAI_BRIDGE_LOG_ERR("Error in reading cache for bridge port id 0x%"PRIx64"",
                            bridge_port_id);
         return false;
     }
-    return (p_bridge_port_info->bridge_port_type == SAI_BRIDGE_PORT_TYPE_TUNNEL);
+    return (bridge_port_info.bridge_port_type == SAI_BRIDGE_PORT_TYPE_TUNNEL);
 }
 
 bool sai_is_bridge_port_obj_lag(sai_object_id_t bridge_port_id)
 {
     sai_status_t sai_rc = SAI_STATUS_FAILURE;;
-    dn_sai_bridge_port_info_t *p_bridge_port_info = NULL;
+    dn_sai_bridge_port_info_t  bridge_port_info;
     sai_object_id_t port_id = SAI_NULL_OBJECT_ID;
-    sai_rc = sai_bridge_port_cache_read(bridge_port_id, &p_bridge_port_info);
+    sai_rc = sai_bridge_port_cache_snapshot_read(bridge_port_id, &bridge_port_info);
 
-    if((sai_rc != SAI_STATUS_SUCCESS) || (p_bridge_port_info == NULL)) {
+    if(sai_rc != SAI_STATUS_SUCCESS) {
         SAI_BRIDGE_LOG_ERR("Error in reading cache for bridge port id 0x%"PRIx64"",
                            bridge_port_id);
         return false;
     }
-    if (p_bridge_port_info->bridge_port_type == SAI_BRIDGE_PORT_TYPE_PORT) {
-        port_id = sai_bridge_port_info_get_port_id(p_bridge_port_info);
+    if (bridge_port_info.bridge_port_type == SAI_BRIDGE_PORT_TYPE_PORT) {
+        port_id = sai_bridge_port_info_get_port_id(&bridge_port_info);
         return sai_is_obj_id_lag(port_id);
     }
     return false;
@@ -1706,7 +1713,7 @@ sai_status_t sai_bridge_port_get_admin_state(sai_object_id_t bridge_port_id,
                                              bool *admin_state)
 {
     sai_status_t               sai_rc = SAI_STATUS_FAILURE;;
-    dn_sai_bridge_port_info_t *p_bridge_port_info = NULL;
+    dn_sai_bridge_port_info_t  bridge_port_info;
 
     if(admin_state == NULL) {
         SAI_BRIDGE_LOG_TRACE("Error admin state is null for bridge port 0x%"PRIx64""
@@ -1714,14 +1721,14 @@ sai_status_t sai_bridge_port_get_admin_state(sai_object_id_t bridge_port_id,
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    sai_rc = sai_bridge_port_cache_read(bridge_port_id, &p_bridge_port_info);
+    sai_rc = sai_bridge_port_cache_snapshot_read(bridge_port_id, &bridge_port_info);
 
-    if((sai_rc != SAI_STATUS_SUCCESS) || (p_bridge_port_info == NULL)) {
+    if(sai_rc != SAI_STATUS_SUCCESS) {
         SAI_BRIDGE_LOG_ERR("Error in reading cache for bridge port id 0x%"PRIx64"",
                            bridge_port_id);
         return sai_rc;
     }
-    *admin_state = p_bridge_port_info->admin_state;
+    *admin_state = bridge_port_info.admin_state;
     return SAI_STATUS_SUCCESS;
 }
 
@@ -31,6 +31,9 @@
 #include "sai_oid_utils.h"
 #include "sai_common_infra.h"
 #include "sai_switch_utils.h"
+#include "sai_port_utils.h"
+#include "sai_lag_api.h"
+#include "sai_vlan_api.h"
 
 #include "std_type_defs.h"
 #include "std_assert.h"
@@ -43,6 +46,14 @@
 #include <stdlib.h>
 #include <inttypes.h>
 
+static const dn_sai_hostif_attr_property_t hostif_attrs[] = {
+    {SAI_HOSTIF_ATTR_TYPE, true, true, false},
+    {SAI_HOSTIF_ATTR_OBJ_ID, false, true, false},
+    {SAI_HOSTIF_ATTR_NAME, false, true, false},
+    {SAI_HOSTIF_ATTR_OPER_STATUS, false, true, true},
+    {SAI_HOSTIF_ATTR_QUEUE, false, true, true}
+};
+
 static const dn_sai_hostif_pkt_attr_property_t packet_attrs[] = {
     { SAI_HOSTIF_PACKET_ATTR_HOSTIF_TRAP_ID, false, false},
     { SAI_HOSTIF_PACKET_ATTR_INGRESS_PORT, false, false},
@@ -118,6 +129,8 @@ sai_status_t sai_hostintf_init(void)
                           /sizeof(trap_attrs[0]);
     g_hostif_info.max_user_def_trap_attrs = sizeof(user_def_trap_attrs)
                           /sizeof(user_def_trap_attrs[0]);
+    g_hostif_info.max_hostif_attrs = sizeof(hostif_attrs)
+                          /sizeof(hostif_attrs[0]);
 
     for(index=0; index < g_hostif_info.max_pkt_attrs; index++) {
         if(packet_attrs[index].mandatory_on_send) {
@@ -155,6 +168,22 @@ sai_status_t sai_hostintf_init(void)
                         g_hostif_info.max_user_def_traps);
 
     do {
+        g_hostif_info.hostif_tree = std_rbtree_create_simple("hostif_tree",
+                                STD_STR_OFFSET_OF(dn_sai_hostif_node_t, key),
+                                STD_STR_SIZE_OF(dn_sai_hostif_node_t, key));
+        if (NULL == g_hostif_info.hostif_tree) {
+            SAI_HOSTIF_LOG_CRIT("Failed to allocate memory for hostif database");
+            rc = SAI_STATUS_UNINITIALIZED;
+            break;
+        }
+
+        g_hostif_info.hostif_bitmap = std_bitmap_create_array(DN_HOSTIF_MAX_HOSTIFS);
+        if (NULL == g_hostif_info.hostif_bitmap) {
+            SAI_HOSTIF_LOG_CRIT("Failed to initialize hostif id generator");
+            rc = SAI_STATUS_UNINITIALIZED;
+            break;
+        }
+
         g_hostif_info.trap_tree = std_rbtree_create_simple("trap_tree",
                                 STD_STR_OFFSET_OF(dn_sai_trap_node_t, key),
                                 STD_STR_SIZE_OF(dn_sai_trap_node_t,key));
@@ -201,6 +230,10 @@ sai_status_t sai_hostintf_init(void)
    } while(0);
 
     if (rc != SAI_STATUS_SUCCESS) {
+        if (g_hostif_info.hostif_tree != NULL) {
+            std_rbtree_destroy(g_hostif_info.hostif_tree);
+        }
+
         if (g_hostif_info.trap_tree != NULL) {
             std_rbtree_destroy(g_hostif_info.trap_tree);
         }
@@ -260,30 +293,415 @@ sai_status_t sai_hostintf_init(void)
     return rc;
 }
 
+static sai_status_t dn_sai_hostif_validate_hostif_attrlist(
+                                        uint_t attr_count,
+                                        const sai_attribute_t *attr_list,
+                                        dn_sai_hostif_op_t operation)
+{
+    uint_t attr_idx = 0, valid_idx = 0;
+    uint_t dup_index = 0, mand_attr_count = 0;
+
+    STD_ASSERT(attr_list != NULL);
+
+    SAI_HOSTIF_LOG_TRACE("Validating hostif attributes");
+
+    if (0 == attr_count) {
+        SAI_HOSTIF_LOG_ERR("Invalid hostif attribute count");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (dn_sai_check_duplicate_attr(attr_count, attr_list, &dup_index)) {
+        SAI_HOSTIF_LOG_ERR("Duplicate hostif attribute at index %u", dup_index);
+        return sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTRIBUTE_0,
+                                       dup_index);
+    }
+
+    for (attr_idx = 0; attr_idx < attr_count; attr_idx++) {
+        for (valid_idx = 0; valid_idx < g_hostif_info.max_hostif_attrs;
+             valid_idx++) {
+            if (attr_list[attr_idx].id == hostif_attrs[valid_idx].attr_id) {
+                break;
+            }
+        }
+
+        if (valid_idx == g_hostif_info.max_hostif_attrs) {
+            SAI_HOSTIF_LOG_ERR("Unknown hostif attribute %u",
+                               attr_list[attr_idx].id);
+            return sai_get_indexed_ret_val(SAI_STATUS_UNKNOWN_ATTRIBUTE_0,
+                                           attr_idx);
+        }
+
+        if (DN_SAI_HOSTIF_CREATE == operation) {
+            if (!hostif_attrs[valid_idx].valid_in_create) {
+                SAI_HOSTIF_LOG_ERR("Invalid hostif attribute %u for create "
+                                   "operation", attr_list[attr_idx].id);
+                return sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTRIBUTE_0,
+                                               attr_idx);
+            }
+
+            if (hostif_attrs[valid_idx].mandatory_in_create) {
+                mand_attr_count++;
+            }
+        } else if (DN_SAI_HOSTIF_SET == operation) {
+            if (!hostif_attrs[valid_idx].valid_in_set) {
+                SAI_HOSTIF_LOG_ERR("Invalid hostif attribute %u for set "
+                                   "operation", attr_list[attr_idx].id);
+                return sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTRIBUTE_0,
+                                               attr_idx);
+            }
+        }
+    }
+
+    if ((DN_SAI_HOSTIF_CREATE == operation) && (0 == mand_attr_count)) {
+        SAI_HOSTIF_LOG_ERR("Missing mandatory hostif attributes");
+        return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* A netdev host interface is bound to a port, a LAG or a VLAN */
+static bool dn_sai_hostif_is_valid_netdev_obj(sai_object_id_t obj_id)
+{
+    if (sai_is_obj_id_port(obj_id)) {
+        return sai_is_port_valid(obj_id);
+    } else if (sai_is_obj_id_lag(obj_id)) {
+        return sai_is_lag_created(obj_id);
+    } else if (sai_is_obj_id_vlan(obj_id)) {
+        return sai_is_vlan_created(sai_vlan_obj_id_to_vlan_id(obj_id));
+    }
+
+    return false;
+}
+
+static dn_sai_hostif_node_t *dn_sai_hostif_find_hostif_by_name(const char *name)
+{
+    dn_sai_hostif_node_t *hostif_node = NULL;
+
+    for (hostif_node = std_rbtree_getfirst(g_hostif_info.hostif_tree);
+         hostif_node != NULL;
+         hostif_node = std_rbtree_getnext(g_hostif_info.hostif_tree, hostif_node)) {
+        if (strncmp(hostif_node->name, name, sizeof(hostif_node->name)) == 0) {
+            return hostif_node;
+        }
+    }
+
+    return NULL;
+}
+
+static sai_status_t dn_sai_hostif_fill_hostif(dn_sai_hostif_node_t *hostif_node,
+                                              uint_t attr_count,
+                                              const sai_attribute_t *attr_list)
+{
+    uint_t attr_idx = 0;
+    int obj_idx = -1;
+    int name_idx = -1;
+
+    STD_ASSERT(hostif_node != NULL);
+    STD_ASSERT(attr_list != NULL);
+
+    for (attr_idx = 0; attr_idx < attr_count; attr_idx++) {
+        switch (attr_list[attr_idx].id) {
+            case SAI_HOSTIF_ATTR_TYPE:
+                hostif_node->type = attr_list[attr_idx].value.s32;
+                break;
+
+            case SAI_HOSTIF_ATTR_OBJ_ID:
+                hostif_node->obj_id = attr_list[attr_idx].value.oid;
+                obj_idx = attr_idx;
+                break;
+
+            case SAI_HOSTIF_ATTR_NAME:
+                if (strnlen(attr_list[attr_idx].value.chardata,
+                            sizeof(attr_list[attr_idx].value.chardata))
+                    >= sizeof(hostif_node->name)) {
+                    SAI_HOSTIF_LOG_ERR("Hostif name is longer than %u characters",
+                                       SAI_HOSTIF_NAME_SIZE - 1);
+                    return sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTR_VALUE_0,
+                                                   attr_idx);
+                }
+                strncpy(hostif_node->name, attr_list[attr_idx].value.chardata,
+                        sizeof(hostif_node->name) - 1);
+                name_idx = attr_idx;
+                break;
+
+            case SAI_HOSTIF_ATTR_OPER_STATUS:
+                hostif_node->oper_status = attr_list[attr_idx].value.booldata;
+                break;
+
+            case SAI_HOSTIF_ATTR_QUEUE:
+                hostif_node->queue = attr_list[attr_idx].value.u32;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (SAI_HOSTIF_TYPE_FD == hostif_node->type) {
+        /* FD hostifs receive the packets punted from every port */
+        hostif_node->obj_id = SAI_NULL_OBJECT_ID;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (SAI_HOSTIF_TYPE_NETDEV != hostif_node->type) {
+        SAI_HOSTIF_LOG_ERR("Hostif type %d not supported", hostif_node->type);
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    if ((obj_idx < 0) || (name_idx < 0)) {
+        SAI_HOSTIF_LOG_ERR("Netdev hostif needs an object id and a name");
+        return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    }
+
+    if (!dn_sai_hostif_is_valid_netdev_obj(hostif_node->obj_id)) {
+        SAI_HOSTIF_LOG_ERR("Invalid netdev hostif object 0x%"PRIx64"",
+                           hostif_node->obj_id);
+        return sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTR_VALUE_0, obj_idx);
+    }
+
+    if (hostif_node->name[0] == '\0') {
+        SAI_HOSTIF_LOG_ERR("Empty netdev hostif name");
+        return sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTR_VALUE_0, name_idx);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
 static sai_status_t sai_create_hostif(sai_object_id_t * hif_id,
                                       _In_ sai_object_id_t switch_id,
                                       uint_t attr_count,
                                       const sai_attribute_t *attr_list)
 {
-    return SAI_STATUS_NOT_SUPPORTED;
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    dn_sai_hostif_node_t *hostif_node = NULL;
+    int id = 0;
+
+    STD_ASSERT(hif_id != NULL);
+    STD_ASSERT(attr_list != NULL);
+
+    SAI_HOSTIF_LOG_INFO("Create a new hostif(attr_count=%u)", attr_count);
+
+    rc = dn_sai_hostif_validate_hostif_attrlist(attr_count, attr_list,
+                                                DN_SAI_HOSTIF_CREATE);
+    if (rc != SAI_STATUS_SUCCESS) {
+        SAI_HOSTIF_LOG_ERR("Failed validation of create hostif attributes");
+        return rc;
+    }
+
+    hostif_node = (dn_sai_hostif_node_t *) calloc(1, sizeof(dn_sai_hostif_node_t));
+    if (NULL == hostif_node) {
+        SAI_HOSTIF_LOG_ERR("No memory for hostif allocation");
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_hostif_lock();
+    do {
+        rc = dn_sai_hostif_fill_hostif(hostif_node, attr_count, attr_list);
+        if (rc != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        if ((hostif_node->name[0] != '\0') &&
+            (dn_sai_hostif_find_hostif_by_name(hostif_node->name) != NULL)) {
+            SAI_HOSTIF_LOG_ERR("Hostif %s already exists", hostif_node->name);
+            rc = SAI_STATUS_ITEM_ALREADY_EXISTS;
+            break;
+        }
+
+        id = std_find_first_bit(g_hostif_info.hostif_bitmap,
+                                DN_HOSTIF_MAX_HOSTIFS, 1);
+        if (id < 0) {
+            SAI_HOSTIF_LOG_ERR("Max hostifs %u reached", DN_HOSTIF_MAX_HOSTIFS);
+            rc = SAI_STATUS_INSUFFICIENT_RESOURCES;
+            break;
+        }
+
+        hostif_node->key.hostif_id = sai_uoid_create(SAI_OBJECT_TYPE_HOSTIF, id);
+
+        rc = sai_hostif_npu_api_get()->npu_hostif_create(hostif_node);
+        if (rc != SAI_STATUS_SUCCESS) {
+            SAI_HOSTIF_LOG_ERR("Failed to create hostif %s at NPU",
+                               hostif_node->name);
+            break;
+        }
+
+        if (std_rbtree_insert(g_hostif_info.hostif_tree, hostif_node) != STD_ERR_OK) {
+            SAI_HOSTIF_LOG_ERR("Failed to add hostif 0x%"PRIx64" to database",
+                               hostif_node->key.hostif_id);
+            sai_hostif_npu_api_get()->npu_hostif_remove(hostif_node);
+            rc = SAI_STATUS_FAILURE;
+            break;
+        }
+
+        STD_BIT_ARRAY_CLR(g_hostif_info.hostif_bitmap, id);
+    } while(0);
+
+    if (rc != SAI_STATUS_SUCCESS) {
+        free(hostif_node);
+    } else {
+        *hif_id = hostif_node->key.hostif_id;
+        SAI_HOSTIF_LOG_INFO("Successful creation of hostif %s 0x%"PRIx64".",
+                            hostif_node->name, *hif_id);
+    }
+    sai_hostif_unlock();
+
+    return rc;
 }
 
 static sai_status_t sai_remove_hostif(sai_object_id_t hif_id)
 {
-    return SAI_STATUS_NOT_SUPPORTED;
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    dn_sai_hostif_node_t *hostif_node = NULL;
+
+    SAI_HOSTIF_LOG_INFO("Remove hostif 0x%"PRIx64".", hif_id);
+
+    if (!sai_is_obj_id_hostif(hif_id)) {
+        SAI_HOSTIF_LOG_ERR("Invalid hostif object type id=0x%"PRIx64".", hif_id);
+        return SAI_STATUS_INVALID_OBJECT_TYPE;
+    }
+
+    sai_hostif_lock();
+    do {
+        hostif_node = dn_sai_hostif_find_hostif(g_hostif_info.hostif_tree, hif_id);
+        if (NULL == hostif_node) {
+            SAI_HOSTIF_LOG_ERR("Hostif 0x%"PRIx64" not present", hif_id);
+            rc = SAI_STATUS_INVALID_OBJECT_ID;
+            break;
+        }
+
+        rc = sai_hostif_npu_api_get()->npu_hostif_remove(hostif_node);
+        if (rc != SAI_STATUS_SUCCESS) {
+            SAI_HOSTIF_LOG_ERR("Failed to remove hostif 0x%"PRIx64" at NPU", hif_id);
+            break;
+        }
+
+        std_rbtree_remove(g_hostif_info.hostif_tree, hostif_node);
+        STD_BIT_ARRAY_SET(g_hostif_info.hostif_bitmap,
+                          sai_uoid_npu_obj_id_get(hif_id));
+        free(hostif_node);
+
+        SAI_HOSTIF_LOG_INFO("Successful removal of hostif 0x%"PRIx64".", hif_id);
+    } while(0);
+    sai_hostif_unlock();
+
+    return rc;
 }
 
 static sai_status_t sai_set_hostif(sai_object_id_t hif_id,
                                    const sai_attribute_t *attr)
 {
-    return SAI_STATUS_NOT_SUPPORTED;
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    dn_sai_hostif_node_t *hostif_node = NULL;
+
+    STD_ASSERT(attr != NULL);
+
+    SAI_HOSTIF_LOG_INFO("Set hostif attribute %d", attr->id);
+
+    if (!sai_is_obj_id_hostif(hif_id)) {
+        SAI_HOSTIF_LOG_ERR("Invalid hostif object type id=0x%"PRIx64".", hif_id);
+        return SAI_STATUS_INVALID_OBJECT_TYPE;
+    }
+
+    rc = dn_sai_hostif_validate_hostif_attrlist(1, attr, DN_SAI_HOSTIF_SET);
+    if (rc != SAI_STATUS_SUCCESS) {
+        SAI_HOSTIF_LOG_ERR("Failed to validate hostif for set operation");
+        return rc;
+    }
+
+    sai_hostif_lock();
+    do {
+        hostif_node = dn_sai_hostif_find_hostif(g_hostif_info.hostif_tree, hif_id);
+        if (NULL == hostif_node) {
+            SAI_HOSTIF_LOG_ERR("Hostif 0x%"PRIx64" not present", hif_id);
+            rc = SAI_STATUS_INVALID_OBJECT_ID;
+            break;
+        }
+
+        rc = sai_hostif_npu_api_get()->npu_hostif_set(hostif_node, attr);
+        if (rc != SAI_STATUS_SUCCESS) {
+            SAI_HOSTIF_LOG_ERR("Failed to set hostif 0x%"PRIx64" attribute %d "
+                               "at NPU", hif_id, attr->id);
+            break;
+        }
+
+        if (SAI_HOSTIF_ATTR_OPER_STATUS == attr->id) {
+            hostif_node->oper_status = attr->value.booldata;
+        } else if (SAI_HOSTIF_ATTR_QUEUE == attr->id) {
+            hostif_node->queue = attr->value.u32;
+        }
+    } while(0);
+    sai_hostif_unlock();
+
+    return rc;
 }
 
 static sai_status_t sai_get_hostif(sai_object_id_t hif_id,
                                    uint_t attr_count,
                                    sai_attribute_t *attr_list)
 {
-    return SAI_STATUS_NOT_SUPPORTED;
+    sai_status_t rc = SAI_STATUS_FAILURE;
+    dn_sai_hostif_node_t *hostif_node = NULL;
+    uint_t attr_idx = 0;
+
+    STD_ASSERT(attr_list != NULL);
+
+    SAI_HOSTIF_LOG_INFO("Get hostif attributes (attribute count = %u)", attr_count);
+
+    if (!sai_is_obj_id_hostif(hif_id)) {
+        SAI_HOSTIF_LOG_ERR("Invalid hostif object type id=0x%"PRIx64".", hif_id);
+        return SAI_STATUS_INVALID_OBJECT_TYPE;
+    }
+
+    rc = dn_sai_hostif_validate_hostif_attrlist(attr_count, attr_list,
+                                                DN_SAI_HOSTIF_GET);
+    if (rc != SAI_STATUS_SUCCESS) {
+        SAI_HOSTIF_LOG_ERR("Failed to validate hostif for get operation");
+        return rc;
+    }
+
+    sai_hostif_lock();
+    do {
+        hostif_node = dn_sai_hostif_find_hostif(g_hostif_info.hostif_tree, hif_id);
+        if (NULL == hostif_node) {
+            SAI_HOSTIF_LOG_ERR("Hostif 0x%"PRIx64" not present", hif_id);
+            rc = SAI_STATUS_INVALID_OBJECT_ID;
+            break;
+        }
+
+        for (attr_idx = 0; attr_idx < attr_count; attr_idx++) {
+            switch (attr_list[attr_idx].id) {
+                case SAI_HOSTIF_ATTR_TYPE:
+                    attr_list[attr_idx].value.s32 = hostif_node->type;
+                    break;
+
+                case SAI_HOSTIF_ATTR_OBJ_ID:
+                    attr_list[attr_idx].value.oid = hostif_node->obj_id;
+                    break;
+
+                case SAI_HOSTIF_ATTR_NAME:
+                    memset(attr_list[attr_idx].value.chardata, 0,
+                           sizeof(attr_list[attr_idx].value.chardata));
+                    strncpy(attr_list[attr_idx].value.chardata, hostif_node->name,
+                            sizeof(hostif_node->name));
+                    break;
+
+                case SAI_HOSTIF_ATTR_OPER_STATUS:
+                    attr_list[attr_idx].value.booldata = hostif_node->oper_status;
+                    break;
+
+                case SAI_HOSTIF_ATTR_QUEUE:
+                    attr_list[attr_idx].value.u32 = hostif_node->queue;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    } while(0);
+    sai_hostif_unlock();
+
+    return rc;
 }
 
 static sai_status_t dn_sai_hostif_validate_trapgroup_attrlist(
@@ -1903,13 +2321,91 @@ static sai_status_t sai_hostif_validate_pkt_attrlist(
     return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t sai_hostif_packets_recv(sai_object_id_t hif_id,
+                                     dn_sai_hostif_packet_t *pkt_list,
+                                     uint_t *pkt_count)
+{
+    STD_ASSERT(pkt_list != NULL);
+    STD_ASSERT(pkt_count != NULL);
+
+    if (!sai_is_obj_id_hostif(hif_id)) {
+        SAI_HOSTIF_LOG_ERR("Invalid hostif object type id=0x%"PRIx64".", hif_id);
+        return SAI_STATUS_INVALID_OBJECT_TYPE;
+    }
+
+    /* The NPU keeps the FD hostifs alive while they are drained, the hostif
+     * lock is not taken on the receive path */
+    return sai_hostif_npu_api_get()->npu_hostif_recv(hif_id, pkt_list, pkt_count);
+}
+
+sai_status_t sai_hostif_event_fd_get(sai_object_id_t hif_id, int *event_fd)
+{
+    STD_ASSERT(event_fd != NULL);
+
+    if (!sai_is_obj_id_hostif(hif_id)) {
+        SAI_HOSTIF_LOG_ERR("Invalid hostif object type id=0x%"PRIx64".", hif_id);
+        return SAI_STATUS_INVALID_OBJECT_TYPE;
+    }
+
+    return sai_hostif_npu_api_get()->npu_hostif_fd_info_get(hif_id, event_fd, NULL);
+}
+
+sai_status_t sai_hostif_rx_drops_get(sai_object_id_t hif_id, uint64_t *rx_drops)
+{
+    STD_ASSERT(rx_drops != NULL);
+
+    if (!sai_is_obj_id_hostif(hif_id)) {
+        SAI_HOSTIF_LOG_ERR("Invalid hostif object type id=0x%"PRIx64".", hif_id);
+        return SAI_STATUS_INVALID_OBJECT_TYPE;
+    }
+
+    return sai_hostif_npu_api_get()->npu_hostif_fd_info_get(hif_id, NULL, rx_drops);
+}
+
 static sai_status_t sai_recv_hostif_packet(sai_object_id_t  hif_id,
                                     void *buffer, sai_size_t *buffer_size,
                                     uint_t *attr_count, sai_attribute_t *attr_list)
 {
-    /* This SAI API is meant for receiving  pkts from device fds which some
-     * NPUs support */
-    return SAI_STATUS_NOT_SUPPORTED;
+    dn_sai_hostif_packet_t pkt;
+    uint_t pkt_count = 1;
+    sai_status_t rc = SAI_STATUS_FAILURE;
+
+    STD_ASSERT(buffer != NULL);
+    STD_ASSERT(buffer_size != NULL);
+    STD_ASSERT(attr_count != NULL);
+    STD_ASSERT(attr_list != NULL);
+
+    if (*attr_count < DN_SAI_HOSTIF_PKT_MAX_ATTRS) {
+        SAI_HOSTIF_LOG_ERR("Room for %u attributes needed on pkt receive",
+                           DN_SAI_HOSTIF_PKT_MAX_ATTRS);
+        *attr_count = DN_SAI_HOSTIF_PKT_MAX_ATTRS;
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    memset(&pkt, 0, sizeof(pkt));
+    pkt.buffer = buffer;
+    pkt.buffer_size = *buffer_size;
+
+    rc = sai_hostif_packets_recv(hif_id, &pkt, &pkt_count);
+    if (SAI_STATUS_BUFFER_OVERFLOW == rc) {
+        *buffer_size = pkt.buffer_size;
+        return rc;
+    }
+
+    if (rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    /* Nothing queued, the event fd of the hostif was cleared */
+    if (0 == pkt_count) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    *buffer_size = pkt.buffer_size;
+    *attr_count = pkt.attr_count;
+    memcpy(attr_list, pkt.attr_list, pkt.attr_count * sizeof(sai_attribute_t));
+
+    return SAI_STATUS_SUCCESS;
 }
 
 static sai_status_t sai_send_hostif_packet(sai_object_id_t  hif_id,
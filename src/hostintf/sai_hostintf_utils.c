@@ -31,6 +31,7 @@
 #include "saiswitch.h"
 #include "saitypes.h"
 #include "saistatus.h"
+#include "sai_api_stats.h"
 
 #include<inttypes.h>
 
@@ -70,7 +71,7 @@ static std_mutex_lock_create_static_init_fast(sai_hostintf_lock);
 
 void sai_hostif_lock()
 {
-    std_mutex_lock (&sai_hostintf_lock);
+    sai_api_stats_mutex_lock (&sai_hostintf_lock);
 }
 
 void sai_hostif_unlock()
@@ -32,6 +32,8 @@
 #include "std_thread_tools.h"
 #include "std_socket_tools.h"
 #include "sai_vm_vport.h"
+#include "sai_vm_hostif_tap.h"
+#include "sai_vm_hostif_fd.h"
 #include "std_system.h"
 
 
@@ -57,106 +59,124 @@ static sai_packet_event_notification_fn vm_pkt_rx_fn = NULL;
 
 static void packet_rx(vport_desc_t *pdesc)
 {
-    if (vm_pkt_rx_fn != NULL) {
-        sai_attribute_t attr;
-        struct cmsghdr      *cmsg;
-        union {
-            struct cmsghdr  cmsg;
-            char        buf[CMSG_SPACE(sizeof(struct tpacket_auxdata))];
-        } cmsg_buf;
+    sai_attribute_t attr;
+    struct cmsghdr      *cmsg;
+    union {
+        struct cmsghdr  cmsg;
+        char        buf[CMSG_SPACE(sizeof(struct tpacket_auxdata))];
+    } cmsg_buf;
 
-        // Static buffers - function does not need to be re-entrant
-        static uint8_t buf[16*1024+VLAN_TAG_LEN ];
-        static uint16_t *vtag_offset     = (uint16_t *)&buf[VLAN_TAG_OFFSET];
-        static uint16_t *vlan_tci_offset = (uint16_t *)&buf[VLAN_TAG_OFFSET+sizeof(uint16_t)];
+    // Static buffers - function does not need to be re-entrant
+    static uint8_t buf[16*1024+VLAN_TAG_LEN ];
+    static uint16_t *vtag_offset     = (uint16_t *)&buf[VLAN_TAG_OFFSET];
+    static uint16_t *vlan_tci_offset = (uint16_t *)&buf[VLAN_TAG_OFFSET+sizeof(uint16_t)];
 
-        uint8_t *msgdata = &buf[VLAN_TAG_LEN];
+    uint8_t *msgdata = &buf[VLAN_TAG_LEN];
 
-        struct sockaddr_ll  from;
-        struct tpacket_auxdata *aux = NULL;
+    struct sockaddr_ll  from;
+    struct tpacket_auxdata *aux = NULL;
 
-        struct iovec        iov;
-        iov.iov_base = msgdata;
-        iov.iov_len  = MSGSZ;
+    struct iovec        iov;
+    iov.iov_base = msgdata;
+    iov.iov_len  = MSGSZ;
 
-        struct msghdr message;
+    struct msghdr message;
 
-        message.msg_name=&from;
-        message.msg_namelen=sizeof(from);
-        message.msg_iov=&iov;
-        message.msg_iovlen=1;
-        message.msg_control     = &cmsg_buf;
-        message.msg_controllen  = sizeof(cmsg_buf);
-        message.msg_flags       = 0;
+    message.msg_name=&from;
+    message.msg_namelen=sizeof(from);
+    message.msg_iov=&iov;
+    message.msg_iovlen=1;
+    message.msg_control     = &cmsg_buf;
+    message.msg_controllen  = sizeof(cmsg_buf);
+    message.msg_flags       = 0;
 
-        ssize_t num_bytes=recvmsg(pdesc->data_sock, &message, MSG_TRUNC);
+    ssize_t num_bytes=recvmsg(pdesc->data_sock, &message, MSG_TRUNC);
 
-        if ((num_bytes < 0) && (errno != EINTR) && (errno != ENETDOWN)) {
+    if (num_bytes < 0) {
 
-            // EINTR (signal) and ENETDOWN (interface down) are valid cases, so we do not log
+        // EINTR (signal) and ENETDOWN (interface down) are valid cases, so we do not log
+        if ((errno != EINTR) && (errno != ENETDOWN)) {
             EV_LOGGING(SAI_HOSTIF,ERR,"SAIHOSTIF","recv failed fpp id=%u ifindex=%u errno=%s(%d)",
                     (unsigned int)pdesc->fpp_id, pdesc->if_index,
                     strerror(errno), errno);
-            return;
         }
+        return;
+    }
 
-        if (from.sll_ifindex != pdesc->if_index) {
-            EV_LOGGING(SAI_HOSTIF,ERR,"SAIHOSTIF","if_index mismatch fpp_id=%u ifindex=%u recv_if_index=%d",
-                    (unsigned int)pdesc->fpp_id, pdesc->if_index, from.sll_ifindex);
-            return;
-        }
+    if (from.sll_ifindex != pdesc->if_index) {
+        EV_LOGGING(SAI_HOSTIF,ERR,"SAIHOSTIF","if_index mismatch fpp_id=%u ifindex=%u recv_if_index=%d",
+                (unsigned int)pdesc->fpp_id, pdesc->if_index, from.sll_ifindex);
+        return;
+    }
 
-        if(message.msg_flags & MSG_CTRUNC) {
-            EV_LOGGING(SAI_HOSTIF,ERR,"SAIHOSTIF","recv truncated fpp_id=%u ifindex=%u cnt=%lu",
-                    (unsigned int)pdesc->fpp_id, pdesc->if_index, (unsigned long)num_bytes);
+    if(message.msg_flags & MSG_CTRUNC) {
+        EV_LOGGING(SAI_HOSTIF,ERR,"SAIHOSTIF","recv truncated fpp_id=%u ifindex=%u cnt=%lu",
+                (unsigned int)pdesc->fpp_id, pdesc->if_index, (unsigned long)num_bytes);
 
+    }
+
+    if (num_bytes > sizeof(buf)) {
+        EV_LOGGING(SAI_HOSTIF,ERR,"SAIHOSTIF", "Recv Buf MSG_TRUNC:  from fpp_id (%d) cnt=%lu",
+                pdesc->fpp_id, pdesc->if_index, (unsigned long)num_bytes);
+        num_bytes = sizeof(buf);
+    }
+
+    for (cmsg = CMSG_FIRSTHDR(&message); cmsg != NULL; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+
+        if (cmsg->cmsg_len < CMSG_LEN(sizeof(struct tpacket_auxdata)) ||
+                (cmsg->cmsg_level != SOL_PACKET) ||
+                (cmsg->cmsg_type != PACKET_AUXDATA)) {
+
+            continue;
+        }
+        aux = (struct tpacket_auxdata *)CMSG_DATA(cmsg);
+        if (aux == NULL) {
+            EV_LOGGING(SAI_HOSTIF,ERR,"SAIHOSTIF", "Recv Buf AUX=NULL: npu port (%d) index=%u cnt=%lu CMSG len=%u level=%u type=%d",
+                    pdesc->npu_port_id, pdesc->if_index, (unsigned long)num_bytes,
+                    (unsigned int)cmsg->cmsg_len, (unsigned int)cmsg->cmsg_level, (unsigned int)cmsg->cmsg_type);
+            continue;
         }
 
-        if (num_bytes > sizeof(buf)) {
-            EV_LOGGING(SAI_HOSTIF,ERR,"SAIHOSTIF", "Recv Buf MSG_TRUNC:  from fpp_id (%d) cnt=%lu",
-                    pdesc->fpp_id, pdesc->if_index, (unsigned long)num_bytes);
-            num_bytes = sizeof(buf);
+        if ((aux->tp_vlan_tci != 0) || ((aux->tp_status & TP_STATUS_VLAN_VALID) != 0)) {
+            break;
         }
+        aux = NULL;
+    }
 
-        for (cmsg = CMSG_FIRSTHDR(&message); cmsg != NULL; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+    sai_port_info_t  *port_info = sai_port_info_get_from_npu_phy_port((sai_npu_port_id_t)pdesc->npu_port_id);
+    if(port_info == NULL) {
+        EV_LOGGING(SAI_HOSTIF,ERR,"SAIHOSTIF", "Recv failed retrieving port information from npu port (%d) if_index=%u",
+                pdesc->npu_port_id, pdesc->if_index);
+        return;
+    }
 
-            if (cmsg->cmsg_len < CMSG_LEN(sizeof(struct tpacket_auxdata)) ||
-                    (cmsg->cmsg_level != SOL_PACKET) ||
-                    (cmsg->cmsg_type != PACKET_AUXDATA)) {
+    // Netdev hostifs take the frame untagged, before the tag is put back for the trap path
+    if (sai_vm_hostif_tap_rx(port_info, (aux != NULL),
+                (aux != NULL) ? (aux->tp_vlan_tci & 0xfff) : 0,
+                msgdata, (size_t)num_bytes)) {
+        return;
+    }
 
-                continue;
-            }
-            aux = (struct tpacket_auxdata *)CMSG_DATA(cmsg);
-            if (aux == NULL) {
-                EV_LOGGING(SAI_HOSTIF,ERR,"SAIHOSTIF", "Recv Buf AUX=NULL: npu port (%d) index=%u cnt=%lu CMSG len=%u level=%u type=%d",
-                        pdesc->npu_port_id, pdesc->if_index, (unsigned long)num_bytes,
-                        (unsigned int)cmsg->cmsg_len, (unsigned int)cmsg->cmsg_level, (unsigned int)cmsg->cmsg_type);
-                continue;
-            }
+    if (aux != NULL) {
+        memmove(buf, msgdata, VLAN_TAG_OFFSET);
 
-            if ((aux->tp_vlan_tci != 0) || ((aux->tp_status & TP_STATUS_VLAN_VALID) != 0)) {
-                memmove(buf, msgdata, VLAN_TAG_OFFSET);
+        *vtag_offset = htons(VLAN_TPID);
+        *vlan_tci_offset = htons(aux->tp_vlan_tci);
+        num_bytes += VLAN_TAG_LEN;
+        msgdata = buf;
+    }
 
-                *vtag_offset = htons(VLAN_TPID);
-                *vlan_tci_offset = htons(aux->tp_vlan_tci);
-                num_bytes += VLAN_TAG_LEN;
-                msgdata = buf;
-                break;
-            }
-        }
+    // FD hostifs queue the frame as the packet event callback gets it
+    sai_vm_hostif_fd_rx(port_info, msgdata, (size_t)num_bytes);
 
-        sai_port_info_t  *port_info = sai_port_info_get_from_npu_phy_port((sai_npu_port_id_t)pdesc->npu_port_id);
-        if(port_info == NULL) {
-            EV_LOGGING(SAI_HOSTIF,ERR,"SAIHOSTIF", "Recv failed retrieving port information from npu port (%d) if_index=%u",
-                    pdesc->npu_port_id, pdesc->if_index);
-            return;
-        }
+    if (vm_pkt_rx_fn == NULL) {
+        return;
+    }
 
-        attr.id = SAI_HOSTIF_PACKET_ATTR_INGRESS_PORT;
-        attr.value.oid = port_info->sai_port_id;
+    attr.id = SAI_HOSTIF_PACKET_ATTR_INGRESS_PORT;
+    attr.value.oid = port_info->sai_port_id;
 
-        vm_pkt_rx_fn(sai_switch_id_get(), (const void*)msgdata, (sai_size_t)num_bytes, 1, &attr);
-    }
+    vm_pkt_rx_fn(sai_switch_id_get(), (const void*)msgdata, (sai_size_t)num_bytes, 1, &attr);
 }
 
 
@@ -178,6 +198,11 @@ static sai_status_t sai_vm_hostif_init()
 
     EV_LOGGING(SAI_HOSTIF,INFO,"SAIHOSTIF", "VMHOSTIF (%s)", __FUNCTION__);
 
+    if ((sai_vm_hostif_tap_init() != SAI_STATUS_SUCCESS) ||
+        (sai_vm_hostif_fd_init() != SAI_STATUS_SUCCESS)) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
     std_thread_init_struct (&thread_param);
     thread_param.name = "sai-vm-packet-rx",
             thread_param.thread_function = (std_thread_function_t)vm_packet_rx_thread_func;
@@ -240,16 +265,8 @@ static sai_status_t sai_vm_hostintf_send_packet(
         return rc;
     }
 
-    struct sockaddr_ll socket_address;
-
-    memset(&socket_address, 0, sizeof(socket_address));
-    /* Index of the network device */
-    socket_address.sll_ifindex = pdesc->if_index;
-    socket_address.sll_halen = ETH_ALEN;
-    memcpy(socket_address.sll_addr, buffer, ETH_ALEN);
-    /* Send packet */
-
-    if (sendto(pdesc->data_sock, buffer, buff_size, 0, (struct sockaddr*)&socket_address, sizeof(struct sockaddr_ll)) < 0) {
+    /* Send packet, remarked and on the queue of its egress classification */
+    if (sai_vm_vport_qos_send(pdesc, buffer, buff_size) < 0) {
         EV_LOGGING(SAI_HOSTIF,ERR,"SAIHOSTIF","Send Error npu port=%u ifindex=%u num_bytes=%lu errno=%s(%d)",
                 (unsigned int)egress_port, pdesc->if_index, (unsigned long)buff_size,
                 strerror(errno), errno);
@@ -305,7 +322,7 @@ static void sai_vm_hostif_debug_set(sai_hostif_debug_attr_t attr_id, int value)
 
 static uint64_t sai_vm_hosif_rx_errors_get(void)
 {
-    return 0;
+    return sai_vm_hostif_tap_rx_drops_get() + sai_vm_hostif_fd_rx_drops_total_get();
 }
 
 static uint32_t sai_vm_hostif_get_max_user_def_traps(void)
@@ -313,6 +330,46 @@ static uint32_t sai_vm_hostif_get_max_user_def_traps(void)
     return 256;
 }
 
+static sai_status_t sai_vm_hostif_create(dn_sai_hostif_node_t *hostif_node)
+{
+    switch (hostif_node->type) {
+    case SAI_HOSTIF_TYPE_NETDEV:
+        return sai_vm_hostif_tap_create(hostif_node);
+    case SAI_HOSTIF_TYPE_FD:
+        return sai_vm_hostif_fd_create(hostif_node);
+    default:
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+}
+
+static sai_status_t sai_vm_hostif_remove(dn_sai_hostif_node_t *hostif_node)
+{
+    if (hostif_node->type == SAI_HOSTIF_TYPE_NETDEV) {
+        sai_vm_hostif_tap_remove(hostif_node);
+    } else if (hostif_node->type == SAI_HOSTIF_TYPE_FD) {
+        sai_vm_hostif_fd_remove(hostif_node);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_vm_hostif_set(dn_sai_hostif_node_t *hostif_node,
+        const sai_attribute_t *attr)
+{
+    switch (attr->id) {
+    case SAI_HOSTIF_ATTR_OPER_STATUS:
+        if (hostif_node->type != SAI_HOSTIF_TYPE_NETDEV) {
+            return SAI_STATUS_SUCCESS;
+        }
+        return sai_vm_hostif_tap_oper_status_set(hostif_node, attr->value.booldata);
+    case SAI_HOSTIF_ATTR_QUEUE:
+        // Punted frames are not queued per CPU queue in the VM
+        return SAI_STATUS_SUCCESS;
+    default:
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+}
+
 static sai_npu_hostif_api_t sai_vm_hostif_api_table = {
 
         sai_vm_hostif_init,
@@ -325,7 +382,12 @@ static sai_npu_hostif_api_t sai_vm_hostif_api_table = {
         sai_vm_hostintf_dump_trap,
         sai_vm_hostif_debug_set,
         sai_vm_hosif_rx_errors_get,
-        sai_vm_hostif_get_max_user_def_traps
+        sai_vm_hostif_get_max_user_def_traps,
+        sai_vm_hostif_create,
+        sai_vm_hostif_remove,
+        sai_vm_hostif_set,
+        sai_vm_hostif_fd_recv,
+        sai_vm_hostif_fd_info_get
 };
 
 sai_npu_hostif_api_t* sai_vm_hostif_api_query (void)
@@ -0,0 +1,586 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file sai_vm_hostif_fd.c
+*
+* @brief This file contains the per host interface receive rings of the FD
+*        host interfaces for sai-vm.
+*************************************************************************/
+
+#include "sai_vm_hostif_fd.h"
+#include "sai_hostif_common.h"
+#include "sai_port_utils.h"
+#include "sai_oid_utils.h"
+
+#include "std_assert.h"
+#include "std_mutex_lock.h"
+#include "std_rbtree.h"
+#include "std_struct_utils.h"
+#include "std_socket_tools.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <inttypes.h>
+#include <sys/eventfd.h>
+#include <netinet/in.h>
+#include <linux/if_ether.h>
+
+#define SAI_VM_HOSTIF_FD_RING_MASK  (SAI_VM_HOSTIF_FD_RING_SIZE - 1)
+
+typedef struct _sai_vm_hostif_fd_pkt_t {
+    uint8_t         *data;
+    uint32_t         len;
+    int              trap_type;
+    sai_object_id_t  port_id;
+    sai_object_id_t  lag_id;
+} sai_vm_hostif_fd_pkt_t;
+
+typedef struct _sai_vm_hostif_fd_t {
+    sai_object_id_t         hostif_id;
+    int                     event_fd;
+    /* Next slot to dequeue, owned by the receivers */
+    uint32_t                head;
+    /* Next slot to fill, owned by the RX thread */
+    uint32_t                tail;
+    /* Set once the event fd is signalled, cleared by a receiver finding the ring empty */
+    uint32_t                notified;
+    uint64_t                rx_drops;
+    /* Receivers of the same host interface dequeue one at a time */
+    pthread_mutex_t         recv_lock;
+    sai_vm_hostif_fd_pkt_t  ring [SAI_VM_HOSTIF_FD_RING_SIZE];
+} sai_vm_hostif_fd_t;
+
+/* FD host interfaces seen by the RX thread, replaced as a whole on change */
+typedef struct _sai_vm_hostif_fd_set_t {
+    uint_t               count;
+    sai_vm_hostif_fd_t  *fds [];
+} sai_vm_hostif_fd_set_t;
+
+/* FD host interfaces by id, used by the receivers */
+static rbtree_handle sai_vm_hostif_fd_tree = NULL;
+
+static sai_vm_hostif_fd_set_t *sai_vm_hostif_fd_set = NULL;
+
+/* Odd while the RX thread is queueing a frame on the current set */
+static uint64_t sai_vm_hostif_fd_rx_seq = 0;
+
+/* Drops of the removed FD host interfaces */
+static uint64_t sai_vm_hostif_fd_rx_drops_base = 0;
+
+static std_mutex_lock_create_static_init_fast(sai_vm_hostif_fd_lock);
+
+/* Trap type of the well known control protocols, -1 otherwise */
+static int sai_vm_hostif_fd_trap_type_get (const uint8_t *frame, size_t len)
+{
+    static const uint8_t stp_mac [ETH_ALEN] = {0x01, 0x80, 0xc2, 0x00, 0x00, 0x00};
+    static const uint8_t pvrst_mac [ETH_ALEN] = {0x01, 0x00, 0x0c, 0xcc, 0xcc, 0xcd};
+    const uint8_t *l3 = NULL;
+    const uint8_t *l4 = NULL;
+    size_t         off = 2 * ETH_ALEN;
+    uint16_t       ether_type;
+    uint16_t       dport = 0;
+    uint16_t       sport = 0;
+    uint8_t        proto;
+
+    if (len < ETH_HLEN) {
+        return -1;
+    }
+
+    if (memcmp (frame, stp_mac, ETH_ALEN) == 0) {
+        return SAI_HOSTIF_TRAP_TYPE_STP;
+    }
+
+    if (memcmp (frame, pvrst_mac, ETH_ALEN) == 0) {
+        return SAI_HOSTIF_TRAP_TYPE_PVRST;
+    }
+
+    ether_type = (frame [off] << 8) | frame [off + 1];
+
+    if ((ether_type == ETH_P_8021Q) && (len >= (ETH_HLEN + 4))) {
+        off += 4;
+        ether_type = (frame [off] << 8) | frame [off + 1];
+    }
+
+    off += 2;
+    l3 = frame + off;
+    len -= off;
+
+    switch (ether_type) {
+        case ETH_P_SLOW:
+            return ((len >= 1) && (l3 [0] == 1)) ? SAI_HOSTIF_TRAP_TYPE_LACP : -1;
+
+        case ETH_P_PAE:
+            return SAI_HOSTIF_TRAP_TYPE_EAPOL;
+
+        case 0x88cc:
+            return SAI_HOSTIF_TRAP_TYPE_LLDP;
+
+        case ETH_P_ARP:
+            if (len < 8) {
+                return -1;
+            }
+            return (l3 [7] == 1) ? SAI_HOSTIF_TRAP_TYPE_ARP_REQUEST :
+                SAI_HOSTIF_TRAP_TYPE_ARP_RESPONSE;
+
+        case ETH_P_IP:
+            if ((len < 20) || ((size_t) ((l3 [0] & 0xf) * 4) + 4 > len)) {
+                return -1;
+            }
+            proto = l3 [9];
+            l4 = l3 + ((l3 [0] & 0xf) * 4);
+            sport = (l4 [0] << 8) | l4 [1];
+            dport = (l4 [2] << 8) | l4 [3];
+
+            switch (proto) {
+                case IPPROTO_IGMP:
+                    switch (l4 [0]) {
+                        case 0x11: return SAI_HOSTIF_TRAP_TYPE_IGMP_TYPE_QUERY;
+                        case 0x12: return SAI_HOSTIF_TRAP_TYPE_IGMP_TYPE_V1_REPORT;
+                        case 0x16: return SAI_HOSTIF_TRAP_TYPE_IGMP_TYPE_V2_REPORT;
+                        case 0x17: return SAI_HOSTIF_TRAP_TYPE_IGMP_TYPE_LEAVE;
+                        case 0x22: return SAI_HOSTIF_TRAP_TYPE_IGMP_TYPE_V3_REPORT;
+                        default: return -1;
+                    }
+                case 89:
+                    return SAI_HOSTIF_TRAP_TYPE_OSPF;
+                case IPPROTO_PIM:
+                    return SAI_HOSTIF_TRAP_TYPE_PIM;
+                case 112:
+                    return SAI_HOSTIF_TRAP_TYPE_VRRP;
+                case IPPROTO_UDP:
+                    return ((dport == 67) || (dport == 68)) ?
+                        SAI_HOSTIF_TRAP_TYPE_DHCP : -1;
+                case IPPROTO_TCP:
+                    return ((dport == 179) || (sport == 179)) ?
+                        SAI_HOSTIF_TRAP_TYPE_BGP : -1;
+                default:
+                    return -1;
+            }
+
+        case ETH_P_IPV6:
+            if (len < 44) {
+                return -1;
+            }
+            proto = l3 [6];
+            l4 = l3 + 40;
+            sport = (l4 [0] << 8) | l4 [1];
+            dport = (l4 [2] << 8) | l4 [3];
+
+            switch (proto) {
+                case IPPROTO_ICMPV6:
+                    return ((l4 [0] >= 133) && (l4 [0] <= 137)) ?
+                        SAI_HOSTIF_TRAP_TYPE_IPV6_NEIGHBOR_DISCOVERY : -1;
+                case 89:
+                    return SAI_HOSTIF_TRAP_TYPE_OSPFV6;
+                case 112:
+                    return SAI_HOSTIF_TRAP_TYPE_VRRPV6;
+                case IPPROTO_UDP:
+                    return ((dport == 546) || (dport == 547)) ?
+                        SAI_HOSTIF_TRAP_TYPE_DHCPV6 : -1;
+                case IPPROTO_TCP:
+                    return ((dport == 179) || (sport == 179)) ?
+                        SAI_HOSTIF_TRAP_TYPE_BGPV6 : -1;
+                default:
+                    return -1;
+            }
+
+        default:
+            return -1;
+    }
+}
+
+static void sai_vm_hostif_fd_push (sai_vm_hostif_fd_t *p_fd, const void *frame,
+                                   size_t len, int trap_type,
+                                   const sai_port_info_t *port_info)
+{
+    sai_vm_hostif_fd_pkt_t *p_pkt = NULL;
+    uint32_t                tail = p_fd->tail;
+    uint64_t                one = 1;
+
+    if ((tail - __atomic_load_n (&p_fd->head, __ATOMIC_ACQUIRE)) >=
+        SAI_VM_HOSTIF_FD_RING_SIZE) {
+        __atomic_add_fetch (&p_fd->rx_drops, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    p_pkt = &p_fd->ring [tail & SAI_VM_HOSTIF_FD_RING_MASK];
+    p_pkt->data = malloc (len);
+
+    if (p_pkt->data == NULL) {
+        __atomic_add_fetch (&p_fd->rx_drops, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    memcpy (p_pkt->data, frame, len);
+    p_pkt->len = len;
+    p_pkt->trap_type = trap_type;
+    p_pkt->port_id = port_info->sai_port_id;
+    p_pkt->lag_id = port_info->lag_id;
+
+    __atomic_store_n (&p_fd->tail, tail + 1, __ATOMIC_SEQ_CST);
+
+    /* Only the first frame after the ring was drained wakes up the receiver */
+    if (__atomic_exchange_n (&p_fd->notified, 1, __ATOMIC_SEQ_CST) == 0) {
+        if (write (p_fd->event_fd, &one, sizeof (one)) < 0) {
+            SAI_HOSTIF_LOG_TRACE ("Event fd write failed for hostif 0x%"PRIx64,
+                                  p_fd->hostif_id);
+        }
+    }
+}
+
+void sai_vm_hostif_fd_rx (const sai_port_info_t *port_info, const void *frame,
+                          size_t len)
+{
+    sai_vm_hostif_fd_set_t *p_set = NULL;
+    int                     trap_type;
+    uint_t                  idx;
+
+    STD_ASSERT (port_info != NULL);
+
+    __atomic_add_fetch (&sai_vm_hostif_fd_rx_seq, 1, __ATOMIC_SEQ_CST);
+
+    p_set = __atomic_load_n (&sai_vm_hostif_fd_set, __ATOMIC_SEQ_CST);
+
+    if ((p_set != NULL) && (p_set->count > 0)) {
+        trap_type = sai_vm_hostif_fd_trap_type_get (frame, len);
+
+        for (idx = 0; idx < p_set->count; idx++) {
+            sai_vm_hostif_fd_push (p_set->fds [idx], frame, len, trap_type, port_info);
+        }
+    }
+
+    __atomic_add_fetch (&sai_vm_hostif_fd_rx_seq, 1, __ATOMIC_RELEASE);
+}
+
+/* Wait until the RX thread no longer uses the set replaced before the call */
+static void sai_vm_hostif_fd_rx_quiesce (void)
+{
+    uint64_t seq = __atomic_load_n (&sai_vm_hostif_fd_rx_seq, __ATOMIC_SEQ_CST);
+
+    if ((seq & 1) == 0) {
+        return;
+    }
+
+    while (__atomic_load_n (&sai_vm_hostif_fd_rx_seq, __ATOMIC_ACQUIRE) == seq) {
+        sched_yield ();
+    }
+}
+
+/* Called with the FD lock held */
+static sai_status_t sai_vm_hostif_fd_set_publish (void)
+{
+    sai_vm_hostif_fd_set_t *p_new_set = NULL;
+    sai_vm_hostif_fd_set_t *p_old_set = NULL;
+    sai_vm_hostif_fd_t     *p_fd = NULL;
+    uint_t                  count = 0;
+
+    for (p_fd = std_rbtree_getfirst (sai_vm_hostif_fd_tree); p_fd != NULL;
+         p_fd = std_rbtree_getnext (sai_vm_hostif_fd_tree, p_fd)) {
+        count++;
+    }
+
+    p_new_set = calloc (1, sizeof (sai_vm_hostif_fd_set_t) +
+                        (count * sizeof (sai_vm_hostif_fd_t *)));
+
+    if (p_new_set == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    for (p_fd = std_rbtree_getfirst (sai_vm_hostif_fd_tree); p_fd != NULL;
+         p_fd = std_rbtree_getnext (sai_vm_hostif_fd_tree, p_fd)) {
+        p_new_set->fds [p_new_set->count++] = p_fd;
+    }
+
+    p_old_set = __atomic_exchange_n (&sai_vm_hostif_fd_set, p_new_set, __ATOMIC_SEQ_CST);
+
+    sai_vm_hostif_fd_rx_quiesce ();
+    free (p_old_set);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_vm_hostif_fd_free (sai_vm_hostif_fd_t *p_fd)
+{
+    uint32_t idx;
+
+    for (idx = p_fd->head; idx != p_fd->tail; idx++) {
+        free (p_fd->ring [idx & SAI_VM_HOSTIF_FD_RING_MASK].data);
+    }
+
+    if (p_fd->event_fd != STD_INVALID_FD) {
+        close (p_fd->event_fd);
+    }
+
+    pthread_mutex_destroy (&p_fd->recv_lock);
+    free (p_fd);
+}
+
+sai_status_t sai_vm_hostif_fd_create (dn_sai_hostif_node_t *hostif_node)
+{
+    sai_vm_hostif_fd_t *p_fd = NULL;
+    sai_status_t        sai_rc = SAI_STATUS_SUCCESS;
+
+    STD_ASSERT (hostif_node != NULL);
+
+    p_fd = calloc (1, sizeof (sai_vm_hostif_fd_t));
+
+    if (p_fd == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_fd->hostif_id = hostif_node->key.hostif_id;
+    pthread_mutex_init (&p_fd->recv_lock, NULL);
+
+    p_fd->event_fd = eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (p_fd->event_fd < 0) {
+        SAI_HOSTIF_LOG_ERR ("Cannot create event fd of hostif 0x%"PRIx64" %s(%d)",
+                            p_fd->hostif_id, strerror (errno), errno);
+        p_fd->event_fd = STD_INVALID_FD;
+        sai_vm_hostif_fd_free (p_fd);
+        return SAI_STATUS_FAILURE;
+    }
+
+    std_mutex_lock (&sai_vm_hostif_fd_lock);
+
+    if (std_rbtree_insert (sai_vm_hostif_fd_tree, p_fd) != STD_ERR_OK) {
+        sai_rc = SAI_STATUS_FAILURE;
+    } else {
+        sai_rc = sai_vm_hostif_fd_set_publish ();
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            std_rbtree_remove (sai_vm_hostif_fd_tree, p_fd);
+        }
+    }
+
+    std_mutex_unlock (&sai_vm_hostif_fd_lock);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        sai_vm_hostif_fd_free (p_fd);
+        return sai_rc;
+    }
+
+    hostif_node->npu_hostif_info = p_fd;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_vm_hostif_fd_remove (dn_sai_hostif_node_t *hostif_node)
+{
+    sai_vm_hostif_fd_t *p_fd = NULL;
+
+    STD_ASSERT (hostif_node != NULL);
+
+    p_fd = hostif_node->npu_hostif_info;
+
+    if (p_fd == NULL) {
+        return;
+    }
+
+    std_mutex_lock (&sai_vm_hostif_fd_lock);
+
+    std_rbtree_remove (sai_vm_hostif_fd_tree, p_fd);
+
+    /* Without memory for a smaller set, the RX thread is stopped from using it in place */
+    if (sai_vm_hostif_fd_set_publish () != SAI_STATUS_SUCCESS) {
+        __atomic_store_n (&sai_vm_hostif_fd_set, NULL, __ATOMIC_SEQ_CST);
+        sai_vm_hostif_fd_rx_quiesce ();
+    }
+
+    sai_vm_hostif_fd_rx_drops_base += __atomic_load_n (&p_fd->rx_drops, __ATOMIC_RELAXED);
+
+    std_mutex_unlock (&sai_vm_hostif_fd_lock);
+
+    /* A receiver that found the host interface before the removal holds the lock */
+    pthread_mutex_lock (&p_fd->recv_lock);
+    pthread_mutex_unlock (&p_fd->recv_lock);
+
+    sai_vm_hostif_fd_free (p_fd);
+    hostif_node->npu_hostif_info = NULL;
+}
+
+/* Returns with the receive lock of the FD host interface held */
+static sai_vm_hostif_fd_t *sai_vm_hostif_fd_acquire (sai_object_id_t hif_id)
+{
+    sai_vm_hostif_fd_t *p_fd = NULL;
+    sai_vm_hostif_fd_t  fd_key;
+
+    fd_key.hostif_id = hif_id;
+
+    std_mutex_lock (&sai_vm_hostif_fd_lock);
+
+    p_fd = std_rbtree_getexact (sai_vm_hostif_fd_tree, &fd_key);
+
+    if (p_fd != NULL) {
+        pthread_mutex_lock (&p_fd->recv_lock);
+    }
+
+    std_mutex_unlock (&sai_vm_hostif_fd_lock);
+
+    return p_fd;
+}
+
+static void sai_vm_hostif_fd_attrs_fill (const sai_vm_hostif_fd_pkt_t *p_pkt,
+                                         dn_sai_hostif_packet_t *p_out)
+{
+    p_out->attr_count = 0;
+
+    if (p_pkt->trap_type >= 0) {
+        p_out->attr_list [p_out->attr_count].id = SAI_HOSTIF_PACKET_ATTR_HOSTIF_TRAP_ID;
+        p_out->attr_list [p_out->attr_count].value.oid =
+            sai_uoid_create (SAI_OBJECT_TYPE_HOSTIF_TRAP, p_pkt->trap_type);
+        p_out->attr_count++;
+    }
+
+    p_out->attr_list [p_out->attr_count].id = SAI_HOSTIF_PACKET_ATTR_INGRESS_PORT;
+    p_out->attr_list [p_out->attr_count].value.oid = p_pkt->port_id;
+    p_out->attr_count++;
+
+    if (p_pkt->lag_id != SAI_NULL_OBJECT_ID) {
+        p_out->attr_list [p_out->attr_count].id = SAI_HOSTIF_PACKET_ATTR_INGRESS_LAG;
+        p_out->attr_list [p_out->attr_count].value.oid = p_pkt->lag_id;
+        p_out->attr_count++;
+    }
+}
+
+sai_status_t sai_vm_hostif_fd_recv (sai_object_id_t hif_id,
+                                    dn_sai_hostif_packet_t *pkt_list,
+                                    uint_t *pkt_count)
+{
+    sai_vm_hostif_fd_t     *p_fd = NULL;
+    sai_vm_hostif_fd_pkt_t *p_pkt = NULL;
+    sai_status_t            sai_rc = SAI_STATUS_SUCCESS;
+    uint64_t                value;
+    uint32_t                head;
+    uint_t                  count = 0;
+
+    STD_ASSERT (pkt_list != NULL);
+    STD_ASSERT (pkt_count != NULL);
+
+    p_fd = sai_vm_hostif_fd_acquire (hif_id);
+
+    if (p_fd == NULL) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    head = p_fd->head;
+
+    while (count < *pkt_count) {
+        if (head == __atomic_load_n (&p_fd->tail, __ATOMIC_ACQUIRE)) {
+            /*
+             * Rearm the event fd, then look again: a frame queued meanwhile
+             * either is seen here or signals the event fd again.
+             */
+            __atomic_store_n (&p_fd->notified, 0, __ATOMIC_SEQ_CST);
+
+            if (read (p_fd->event_fd, &value, sizeof (value)) < 0) {
+                /* EAGAIN, the event fd was already clear */
+            }
+
+            if (head == __atomic_load_n (&p_fd->tail, __ATOMIC_SEQ_CST)) {
+                break;
+            }
+            continue;
+        }
+
+        p_pkt = &p_fd->ring [head & SAI_VM_HOSTIF_FD_RING_MASK];
+
+        if (p_pkt->len > pkt_list [count].buffer_size) {
+            pkt_list [count].buffer_size = p_pkt->len;
+            sai_rc = (count == 0) ? SAI_STATUS_BUFFER_OVERFLOW : SAI_STATUS_SUCCESS;
+            break;
+        }
+
+        memcpy (pkt_list [count].buffer, p_pkt->data, p_pkt->len);
+        pkt_list [count].buffer_size = p_pkt->len;
+        sai_vm_hostif_fd_attrs_fill (p_pkt, &pkt_list [count]);
+
+        free (p_pkt->data);
+        p_pkt->data = NULL;
+
+        head++;
+        __atomic_store_n (&p_fd->head, head, __ATOMIC_RELEASE);
+        count++;
+    }
+
+    pthread_mutex_unlock (&p_fd->recv_lock);
+
+    *pkt_count = count;
+
+    return sai_rc;
+}
+
+sai_status_t sai_vm_hostif_fd_info_get (sai_object_id_t hif_id, int *event_fd,
+                                        uint64_t *rx_drops)
+{
+    sai_vm_hostif_fd_t *p_fd = NULL;
+
+    p_fd = sai_vm_hostif_fd_acquire (hif_id);
+
+    if (p_fd == NULL) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    if (event_fd != NULL) {
+        *event_fd = p_fd->event_fd;
+    }
+
+    if (rx_drops != NULL) {
+        *rx_drops = __atomic_load_n (&p_fd->rx_drops, __ATOMIC_RELAXED);
+    }
+
+    pthread_mutex_unlock (&p_fd->recv_lock);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+uint64_t sai_vm_hostif_fd_rx_drops_total_get (void)
+{
+    sai_vm_hostif_fd_t *p_fd = NULL;
+    uint64_t            drops;
+
+    std_mutex_lock (&sai_vm_hostif_fd_lock);
+
+    drops = sai_vm_hostif_fd_rx_drops_base;
+
+    for (p_fd = std_rbtree_getfirst (sai_vm_hostif_fd_tree); p_fd != NULL;
+         p_fd = std_rbtree_getnext (sai_vm_hostif_fd_tree, p_fd)) {
+        drops += __atomic_load_n (&p_fd->rx_drops, __ATOMIC_RELAXED);
+    }
+
+    std_mutex_unlock (&sai_vm_hostif_fd_lock);
+
+    return drops;
+}
+
+sai_status_t sai_vm_hostif_fd_init (void)
+{
+    sai_vm_hostif_fd_tree = std_rbtree_create_simple ("sai_vm_hostif_fd_tree",
+                                STD_STR_OFFSET_OF (sai_vm_hostif_fd_t, hostif_id),
+                                STD_STR_SIZE_OF (sai_vm_hostif_fd_t, hostif_id));
+
+    if (sai_vm_hostif_fd_tree == NULL) {
+        SAI_HOSTIF_LOG_CRIT ("Failed to allocate memory for the FD hostif database");
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
@@ -0,0 +1,658 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file sai_vm_hostif_tap.c
+*
+* @brief This file contains the multiqueue TAP devices backing the netdev
+*        host interfaces for sai-vm.
+*************************************************************************/
+
+#include "sai_vm_hostif_tap.h"
+#include "sai_vm_vport.h"
+#include "sai_vm_rtnl.h"
+#include "sai_vm_bridge_link.h"
+#include "sai_hostif_common.h"
+#include "sai_port_utils.h"
+#include "sai_lag_api.h"
+#include "sai_vlan_api.h"
+#include "sai_oid_utils.h"
+
+#include "std_assert.h"
+#include "std_mutex_lock.h"
+#include "std_rbtree.h"
+#include "std_struct_utils.h"
+#include "std_socket_tools.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <inttypes.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <linux/if_tun.h>
+#include <linux/virtio_net.h>
+
+#define SAI_VM_HOSTIF_TAP_DEV  "/dev/net/tun"
+
+/* Largest frame read from a TAP queue, behind its virtio header */
+#define SAI_VM_HOSTIF_TAP_FRAME_MAX  (64*1024)
+
+struct _sai_vm_hostif_tap_t;
+
+typedef struct _sai_vm_hostif_tap_queue_t {
+    struct _sai_vm_hostif_tap_t *p_tap;
+    int                          fd;
+    pthread_t                    tx_thread;
+    bool                         tx_running;
+} sai_vm_hostif_tap_queue_t;
+
+typedef struct _sai_vm_hostif_tap_t {
+    /* Port, LAG or VLAN the TAP is bound to, key of the RX lookup */
+    sai_object_id_t           obj_id;
+    sai_object_id_t           hostif_id;
+    char                      name [IFNAMSIZ];
+    /* Virtual port of a port binding */
+    vport_desc_t             *p_vport;
+    /* VLAN of a VLAN binding, sent to through its bridge */
+    sai_vlan_id_t             vlan_id;
+    int                       br_if_index;
+    int                       tx_sock;
+    /* Closed to stop the TX threads */
+    int                       stop_fd [2];
+    uint_t                    queue_count;
+    sai_vm_hostif_tap_queue_t queues [SAI_VM_HOSTIF_TAP_MAX_QUEUES];
+    uint64_t                  rx_drops;
+    uint64_t                  tx_drops;
+} sai_vm_hostif_tap_t;
+
+/* TAPs by bound object, used by the RX path */
+static rbtree_handle sai_vm_hostif_tap_tree = NULL;
+
+static std_mutex_lock_create_static_init_fast(sai_vm_hostif_tap_lock);
+
+/* TAPs in the tree, read without the lock on RX */
+static uint_t sai_vm_hostif_tap_count = 0;
+
+/* RX drops of the removed TAPs */
+static uint64_t sai_vm_hostif_tap_rx_drops_base = 0;
+
+static uint32_t sai_vm_hostif_tap_hash_add (uint32_t hash, const uint8_t *p_data,
+                                            size_t len)
+{
+    size_t idx;
+
+    /* FNV-1a */
+    for (idx = 0; idx < len; idx++) {
+        hash = (hash ^ p_data [idx]) * 16777619;
+    }
+
+    return hash;
+}
+
+/* Hash of the MACs, IP addresses and L4 ports of a frame */
+static uint32_t sai_vm_hostif_tap_flow_hash (const uint8_t *frame, size_t len)
+{
+    const uint8_t *l3 = frame + ETH_HLEN;
+    uint32_t       hash = 2166136261u;
+    uint16_t       ether_type;
+    size_t         l3_len;
+    size_t         l4_off = 0;
+    uint8_t        proto = 0;
+
+    if (len < ETH_HLEN) {
+        return 0;
+    }
+
+    hash = sai_vm_hostif_tap_hash_add (hash, frame, 2 * ETH_ALEN);
+
+    ether_type = (frame [2 * ETH_ALEN] << 8) | frame [2 * ETH_ALEN + 1];
+    l3_len = len - ETH_HLEN;
+
+    if ((ether_type == ETH_P_IP) && (l3_len >= 20)) {
+        hash = sai_vm_hostif_tap_hash_add (hash, l3 + 12, 8);
+        proto = l3 [9];
+        l4_off = (l3 [0] & 0xf) * 4;
+    } else if ((ether_type == ETH_P_IPV6) && (l3_len >= 40)) {
+        hash = sai_vm_hostif_tap_hash_add (hash, l3 + 8, 32);
+        proto = l3 [6];
+        l4_off = 40;
+    }
+
+    if (((proto == IPPROTO_TCP) || (proto == IPPROTO_UDP)) && (l3_len >= l4_off + 4)) {
+        hash = sai_vm_hostif_tap_hash_add (hash, l3 + l4_off, 4);
+    }
+
+    return hash;
+}
+
+static uint_t sai_vm_hostif_tap_queue_count_get (void)
+{
+    const char *env = getenv (SAI_VM_HOSTIF_TAP_QUEUES_ENV);
+    long        count = 0;
+
+    if ((env != NULL) && (*env != '\0')) {
+        count = strtol (env, NULL, 0);
+    } else {
+        count = sysconf (_SC_NPROCESSORS_ONLN);
+        if (count > SAI_VM_HOSTIF_TAP_DEFAULT_QUEUES) {
+            count = SAI_VM_HOSTIF_TAP_DEFAULT_QUEUES;
+        }
+    }
+
+    if (count < 1) {
+        return 1;
+    }
+
+    return (count > SAI_VM_HOSTIF_TAP_MAX_QUEUES) ? SAI_VM_HOSTIF_TAP_MAX_QUEUES : count;
+}
+
+static void sai_vm_hostif_tap_port_send (sai_vm_hostif_tap_t *p_tap,
+                                         const vport_desc_t *p_vport,
+                                         const uint8_t *frame, size_t len)
+{
+    if ((p_vport == NULL) || (p_vport->if_index == 0) ||
+        (p_vport->data_sock == STD_INVALID_FD)) {
+        __sync_fetch_and_add (&p_tap->tx_drops, 1);
+        return;
+    }
+
+    if (sai_vm_vport_qos_send (p_vport, frame, len) < 0) {
+        __sync_fetch_and_add (&p_tap->tx_drops, 1);
+    }
+}
+
+static const vport_desc_t *sai_vm_hostif_tap_port_vport_get (sai_object_id_t port_id)
+{
+    sai_port_info_t *port_info = sai_port_info_get (port_id);
+
+    if (port_info == NULL) {
+        return NULL;
+    }
+
+    return sai_vm_vport_get_desc (port_info->phy_port_id);
+}
+
+/* LAG member picked by flow hash, as the bond of the LAG would */
+static const vport_desc_t *sai_vm_hostif_tap_lag_vport_get (sai_object_id_t lag_id,
+                                                            uint32_t hash)
+{
+    sai_object_id_t   ports [SAI_VM_HOSTIF_TAP_MAX_LAG_PORTS];
+    sai_object_list_t port_list;
+    sai_status_t      sai_rc;
+
+    port_list.count = SAI_VM_HOSTIF_TAP_MAX_LAG_PORTS;
+    port_list.list = ports;
+
+    sai_lag_lock ();
+    sai_rc = sai_lag_port_list_get (lag_id, &port_list);
+    sai_lag_unlock ();
+
+    if ((sai_rc != SAI_STATUS_SUCCESS) || (port_list.count == 0)) {
+        return NULL;
+    }
+
+    return sai_vm_hostif_tap_port_vport_get (ports [hash % port_list.count]);
+}
+
+/* Frames of a VLAN binding enter the VLAN bridge, which forwards or floods them */
+static void sai_vm_hostif_tap_vlan_send (sai_vm_hostif_tap_t *p_tap,
+                                         const uint8_t *frame, size_t len)
+{
+    struct sockaddr_ll addr;
+    char               br_name [IFNAMSIZ];
+
+    if (p_tap->br_if_index == 0) {
+        snprintf (br_name, sizeof (br_name), SAI_VM_BRIDGE_VLAN_NAME_FMT, p_tap->vlan_id);
+        p_tap->br_if_index = (int) if_nametoindex (br_name);
+    }
+
+    if ((p_tap->br_if_index == 0) || (p_tap->tx_sock == STD_INVALID_FD)) {
+        __sync_fetch_and_add (&p_tap->tx_drops, 1);
+        return;
+    }
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_ifindex = p_tap->br_if_index;
+    addr.sll_halen = ETH_ALEN;
+    memcpy (addr.sll_addr, frame, ETH_ALEN);
+
+    if (sendto (p_tap->tx_sock, frame, len, 0, (struct sockaddr *) &addr,
+                sizeof (addr)) < 0) {
+        __sync_fetch_and_add (&p_tap->tx_drops, 1);
+    }
+}
+
+static void sai_vm_hostif_tap_tx (sai_vm_hostif_tap_t *p_tap, const uint8_t *frame,
+                                  size_t len)
+{
+    if (len < ETH_HLEN) {
+        __sync_fetch_and_add (&p_tap->tx_drops, 1);
+        return;
+    }
+
+    if (sai_is_obj_id_port (p_tap->obj_id)) {
+        sai_vm_hostif_tap_port_send (p_tap, p_tap->p_vport, frame, len);
+    } else if (sai_is_obj_id_lag (p_tap->obj_id)) {
+        sai_vm_hostif_tap_port_send (p_tap, sai_vm_hostif_tap_lag_vport_get (
+                                         p_tap->obj_id,
+                                         sai_vm_hostif_tap_flow_hash (frame, len)),
+                                     frame, len);
+    } else {
+        sai_vm_hostif_tap_vlan_send (p_tap, frame, len);
+    }
+}
+
+static void *sai_vm_hostif_tap_tx_thread (void *param)
+{
+    sai_vm_hostif_tap_queue_t *p_queue = (sai_vm_hostif_tap_queue_t *) param;
+    sai_vm_hostif_tap_t       *p_tap = p_queue->p_tap;
+    const size_t               hdr_len = sizeof (struct virtio_net_hdr);
+    struct pollfd              pfd [2];
+    uint8_t                   *buf = NULL;
+    ssize_t                    len;
+    uint_t                     burst;
+
+    buf = malloc (hdr_len + SAI_VM_HOSTIF_TAP_FRAME_MAX);
+
+    if (buf == NULL) {
+        SAI_HOSTIF_LOG_ERR ("No memory for TAP %s TX buffer", p_tap->name);
+        return NULL;
+    }
+
+    pfd [0].fd = p_queue->fd;
+    pfd [0].events = POLLIN;
+    pfd [1].fd = p_tap->stop_fd [0];
+    pfd [1].events = POLLIN;
+
+    while (true) {
+        if (poll (pfd, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            SAI_HOSTIF_LOG_ERR ("TAP %s TX poll error %s(%d)", p_tap->name,
+                                strerror (errno), errno);
+            break;
+        }
+
+        if (pfd [1].revents != 0) {
+            break;
+        }
+
+        for (burst = 0; burst < SAI_VM_HOSTIF_TAP_TX_BURST; burst++) {
+            len = read (p_queue->fd, buf, hdr_len + SAI_VM_HOSTIF_TAP_FRAME_MAX);
+
+            if (len < 0) {
+                break;
+            }
+
+            /* Offloads are off, the virtio header never asks for GSO or checksum */
+            if ((size_t) len > hdr_len) {
+                sai_vm_hostif_tap_tx (p_tap, buf + hdr_len, len - hdr_len);
+            }
+        }
+    }
+
+    free (buf);
+    return NULL;
+}
+
+static sai_status_t sai_vm_hostif_tap_queue_open (sai_vm_hostif_tap_t *p_tap, int *p_fd)
+{
+    struct ifreq ifr;
+    int          hdr_len = sizeof (struct virtio_net_hdr);
+    int          fd;
+
+    fd = open (SAI_VM_HOSTIF_TAP_DEV, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+
+    if (fd < 0) {
+        SAI_HOSTIF_LOG_ERR ("Cannot open %s %s(%d)", SAI_VM_HOSTIF_TAP_DEV,
+                            strerror (errno), errno);
+        return sai_vm_rtnl_errno_to_sai_status (errno);
+    }
+
+    memset (&ifr, 0, sizeof (ifr));
+    ifr.ifr_flags = IFF_TAP | IFF_NO_PI | IFF_VNET_HDR | IFF_MULTI_QUEUE;
+    strncpy (ifr.ifr_name, p_tap->name, sizeof (ifr.ifr_name) - 1);
+
+    /* Every open of the same name attaches one more queue to the device */
+    if ((ioctl (fd, TUNSETIFF, &ifr) < 0) ||
+        (ioctl (fd, TUNSETVNETHDRSZ, &hdr_len) < 0) ||
+        (ioctl (fd, TUNSETOFFLOAD, 0) < 0)) {
+        SAI_HOSTIF_LOG_ERR ("TAP %s queue setup failed %s(%d)", p_tap->name,
+                            strerror (errno), errno);
+        close (fd);
+        return (errno == EBUSY) ? SAI_STATUS_ITEM_ALREADY_EXISTS :
+            sai_vm_rtnl_errno_to_sai_status (errno);
+    }
+
+    *p_fd = fd;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_vm_hostif_tap_free (sai_vm_hostif_tap_t *p_tap)
+{
+    uint_t queue;
+
+    /* The TX threads see the hang up of the stop pipe */
+    if (p_tap->stop_fd [1] != STD_INVALID_FD) {
+        close (p_tap->stop_fd [1]);
+    }
+
+    for (queue = 0; queue < p_tap->queue_count; queue++) {
+        if (p_tap->queues [queue].tx_running) {
+            pthread_join (p_tap->queues [queue].tx_thread, NULL);
+        }
+    }
+
+    /* The device goes away with its last queue */
+    for (queue = 0; queue < p_tap->queue_count; queue++) {
+        if (p_tap->queues [queue].fd != STD_INVALID_FD) {
+            close (p_tap->queues [queue].fd);
+        }
+    }
+
+    if (p_tap->stop_fd [0] != STD_INVALID_FD) {
+        close (p_tap->stop_fd [0]);
+    }
+
+    if (p_tap->tx_sock != STD_INVALID_FD) {
+        close (p_tap->tx_sock);
+    }
+
+    free (p_tap);
+}
+
+static sai_status_t sai_vm_hostif_tap_carrier_set (sai_vm_hostif_tap_t *p_tap,
+                                                   bool oper_status)
+{
+#ifdef TUNSETCARRIER
+    int carrier = oper_status ? 1 : 0;
+
+    if (ioctl (p_tap->queues [0].fd, TUNSETCARRIER, &carrier) < 0) {
+        SAI_HOSTIF_LOG_ERR ("TAP %s carrier set failed %s(%d)", p_tap->name,
+                            strerror (errno), errno);
+        return sai_vm_rtnl_errno_to_sai_status (errno);
+    }
+#endif
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_vm_hostif_tap_create (dn_sai_hostif_node_t *hostif_node)
+{
+    sai_vm_hostif_tap_t *p_tap = NULL;
+    sai_port_info_t     *port_info = NULL;
+    sai_status_t         sai_rc = SAI_STATUS_SUCCESS;
+    uint_t               queue;
+
+    STD_ASSERT (hostif_node != NULL);
+
+    p_tap = calloc (1, sizeof (sai_vm_hostif_tap_t));
+
+    if (p_tap == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_tap->obj_id = hostif_node->obj_id;
+    p_tap->hostif_id = hostif_node->key.hostif_id;
+    strncpy (p_tap->name, hostif_node->name, sizeof (p_tap->name) - 1);
+    p_tap->tx_sock = STD_INVALID_FD;
+    p_tap->stop_fd [0] = STD_INVALID_FD;
+    p_tap->stop_fd [1] = STD_INVALID_FD;
+    p_tap->queue_count = sai_vm_hostif_tap_queue_count_get ();
+
+    for (queue = 0; queue < p_tap->queue_count; queue++) {
+        p_tap->queues [queue].p_tap = p_tap;
+        p_tap->queues [queue].fd = STD_INVALID_FD;
+    }
+
+    do {
+        if (sai_is_obj_id_port (p_tap->obj_id)) {
+            port_info = sai_port_info_get (p_tap->obj_id);
+            p_tap->p_vport = (port_info != NULL) ?
+                sai_vm_vport_get_desc (port_info->phy_port_id) : NULL;
+        } else if (sai_is_obj_id_vlan (p_tap->obj_id)) {
+            p_tap->vlan_id = sai_vlan_obj_id_to_vlan_id (p_tap->obj_id);
+            p_tap->tx_sock = socket (AF_PACKET, SOCK_RAW | SOCK_CLOEXEC, 0);
+
+            if (p_tap->tx_sock < 0) {
+                SAI_HOSTIF_LOG_ERR ("Cannot open TAP %s VLAN socket %s(%d)",
+                                    p_tap->name, strerror (errno), errno);
+                p_tap->tx_sock = STD_INVALID_FD;
+                sai_rc = SAI_STATUS_FAILURE;
+                break;
+            }
+        }
+
+        if (pipe (p_tap->stop_fd) != 0) {
+            p_tap->stop_fd [0] = STD_INVALID_FD;
+            p_tap->stop_fd [1] = STD_INVALID_FD;
+            sai_rc = SAI_STATUS_FAILURE;
+            break;
+        }
+
+        for (queue = 0; queue < p_tap->queue_count; queue++) {
+            sai_rc = sai_vm_hostif_tap_queue_open (p_tap, &p_tap->queues [queue].fd);
+            if (sai_rc != SAI_STATUS_SUCCESS) {
+                break;
+            }
+        }
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        sai_rc = sai_vm_hostif_tap_carrier_set (p_tap, hostif_node->oper_status);
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        for (queue = 0; queue < p_tap->queue_count; queue++) {
+            if (pthread_create (&p_tap->queues [queue].tx_thread, NULL,
+                                sai_vm_hostif_tap_tx_thread,
+                                &p_tap->queues [queue]) != 0) {
+                SAI_HOSTIF_LOG_ERR ("Cannot start TAP %s TX thread %u", p_tap->name,
+                                    queue);
+                sai_rc = SAI_STATUS_FAILURE;
+                break;
+            }
+            p_tap->queues [queue].tx_running = true;
+        }
+    } while (0);
+
+    if (sai_rc == SAI_STATUS_SUCCESS) {
+        std_mutex_lock (&sai_vm_hostif_tap_lock);
+
+        if (std_rbtree_getexact (sai_vm_hostif_tap_tree, p_tap) != NULL) {
+            SAI_HOSTIF_LOG_ERR ("Object 0x%"PRIx64" already has a netdev hostif",
+                                p_tap->obj_id);
+            sai_rc = SAI_STATUS_ITEM_ALREADY_EXISTS;
+        } else if (std_rbtree_insert (sai_vm_hostif_tap_tree, p_tap) != STD_ERR_OK) {
+            sai_rc = SAI_STATUS_FAILURE;
+        } else {
+            __sync_fetch_and_add (&sai_vm_hostif_tap_count, 1);
+        }
+
+        std_mutex_unlock (&sai_vm_hostif_tap_lock);
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        sai_vm_hostif_tap_free (p_tap);
+        return sai_rc;
+    }
+
+    hostif_node->npu_hostif_info = p_tap;
+
+    SAI_HOSTIF_LOG_INFO ("Hostif %s is a TAP with %u queues", p_tap->name,
+                         p_tap->queue_count);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_vm_hostif_tap_remove (dn_sai_hostif_node_t *hostif_node)
+{
+    sai_vm_hostif_tap_t *p_tap = NULL;
+
+    STD_ASSERT (hostif_node != NULL);
+
+    p_tap = hostif_node->npu_hostif_info;
+
+    if (p_tap == NULL) {
+        return;
+    }
+
+    /* The RX path writes to the TAP with the lock held */
+    std_mutex_lock (&sai_vm_hostif_tap_lock);
+    std_rbtree_remove (sai_vm_hostif_tap_tree, p_tap);
+    __sync_fetch_and_sub (&sai_vm_hostif_tap_count, 1);
+    sai_vm_hostif_tap_rx_drops_base += p_tap->rx_drops;
+    std_mutex_unlock (&sai_vm_hostif_tap_lock);
+
+    sai_vm_hostif_tap_free (p_tap);
+    hostif_node->npu_hostif_info = NULL;
+}
+
+sai_status_t sai_vm_hostif_tap_oper_status_set (dn_sai_hostif_node_t *hostif_node,
+                                                bool oper_status)
+{
+    STD_ASSERT (hostif_node != NULL);
+
+    if (hostif_node->npu_hostif_info == NULL) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    return sai_vm_hostif_tap_carrier_set (hostif_node->npu_hostif_info, oper_status);
+}
+
+/* Called with the TAP lock held */
+static sai_vm_hostif_tap_t *sai_vm_hostif_tap_find (sai_object_id_t obj_id)
+{
+    sai_vm_hostif_tap_t tap;
+
+    if (obj_id == SAI_NULL_OBJECT_ID) {
+        return NULL;
+    }
+
+    tap.obj_id = obj_id;
+
+    return std_rbtree_getexact (sai_vm_hostif_tap_tree, &tap);
+}
+
+bool sai_vm_hostif_tap_rx (const sai_port_info_t *port_info, bool vlan_tagged,
+                           sai_vlan_id_t vlan_id, const void *frame, size_t len)
+{
+    static const struct virtio_net_hdr hdr;
+    sai_vm_hostif_tap_t *p_tap = NULL;
+    struct iovec         iov [2];
+    uint16_t             pvid = 0;
+    uint_t               queue;
+
+    STD_ASSERT (port_info != NULL);
+
+    if (__sync_fetch_and_add (&sai_vm_hostif_tap_count, 0) == 0) {
+        return false;
+    }
+
+    std_mutex_lock (&sai_vm_hostif_tap_lock);
+
+    p_tap = sai_vm_hostif_tap_find (port_info->sai_port_id);
+
+    if (p_tap == NULL) {
+        p_tap = sai_vm_hostif_tap_find (port_info->lag_id);
+    }
+
+    if (p_tap == NULL) {
+        /* Untagged frames belong to the port VLAN of the port or of its LAG */
+        if (!vlan_tagged) {
+            if (port_info->lag_id != SAI_NULL_OBJECT_ID) {
+                sai_lag_pvid_get (port_info->lag_id, &pvid);
+            } else {
+                pvid = port_info->port_attr_info.default_vlan;
+            }
+            vlan_id = pvid;
+        }
+
+        if (sai_is_valid_vlan_id (vlan_id)) {
+            p_tap = sai_vm_hostif_tap_find (sai_vlan_id_to_vlan_obj_id (vlan_id));
+        }
+    }
+
+    if (p_tap == NULL) {
+        std_mutex_unlock (&sai_vm_hostif_tap_lock);
+        return false;
+    }
+
+    /* The frames of a flow stay in order on one queue */
+    queue = sai_vm_hostif_tap_flow_hash (frame, len) % p_tap->queue_count;
+
+    iov [0].iov_base = (void *) &hdr;
+    iov [0].iov_len = sizeof (hdr);
+    iov [1].iov_base = (void *) frame;
+    iov [1].iov_len = len;
+
+    /* EAGAIN when the queue is full, or EIO while the TAP is down */
+    if (writev (p_tap->queues [queue].fd, iov, 2) < 0) {
+        p_tap->rx_drops++;
+    }
+
+    std_mutex_unlock (&sai_vm_hostif_tap_lock);
+
+    return true;
+}
+
+uint64_t sai_vm_hostif_tap_rx_drops_get (void)
+{
+    sai_vm_hostif_tap_t *p_tap = NULL;
+    uint64_t             drops;
+
+    std_mutex_lock (&sai_vm_hostif_tap_lock);
+
+    drops = sai_vm_hostif_tap_rx_drops_base;
+
+    for (p_tap = std_rbtree_getfirst (sai_vm_hostif_tap_tree); p_tap != NULL;
+         p_tap = std_rbtree_getnext (sai_vm_hostif_tap_tree, p_tap)) {
+        drops += p_tap->rx_drops;
+    }
+
+    std_mutex_unlock (&sai_vm_hostif_tap_lock);
+
+    return drops;
+}
+
+sai_status_t sai_vm_hostif_tap_init (void)
+{
+    sai_vm_hostif_tap_tree = std_rbtree_create_simple ("sai_vm_hostif_tap_tree",
+                                 STD_STR_OFFSET_OF (sai_vm_hostif_tap_t, obj_id),
+                                 STD_STR_SIZE_OF (sai_vm_hostif_tap_t, obj_id));
+
+    if (sai_vm_hostif_tap_tree == NULL) {
+        SAI_HOSTIF_LOG_CRIT ("Failed to allocate memory for the TAP database");
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
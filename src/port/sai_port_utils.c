@@ -38,12 +38,13 @@
 #include "std_assert.h"
 #include "std_mutex_lock.h"
 #include "std_struct_utils.h"
+#include "sai_api_stats.h"
 
 static std_mutex_lock_create_static_init_fast(port_lock);
 
 void sai_port_lock(void)
 {
-    std_mutex_lock(&port_lock);
+    sai_api_stats_mutex_lock(&port_lock);
 }
 
 void sai_port_unlock(void)
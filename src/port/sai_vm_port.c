@@ -329,6 +329,9 @@ static sai_status_t sai_npu_port_get_attribute (sai_object_id_t port_id,
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    /* The QoS attributes are read without the QoS lock */
+    sai_qos_port_all_init_wait ();
+
     const sai_port_attr_info_t *port_attr_info = sai_port_attr_info_read_only_get(port_id, sai_port_info);
 
     if (port_attr_info == NULL) {
@@ -1123,8 +1123,16 @@ sai_status_t sai_qos_buffer_pool_stats_get (sai_object_id_t pool_id, uint32_t nu
                                             const sai_buffer_pool_stat_t *counter_ids,
                                             uint64_t* counters)
 {
-    return sai_buffer_npu_api_get()->buffer_pool_stats_get(pool_id, counter_ids,
-                                                           number_of_counters, counters);
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    sai_qos_lock();
+
+    sai_rc = sai_buffer_npu_api_get()->buffer_pool_stats_get(pool_id, counter_ids,
+                                                             number_of_counters, counters);
+
+    sai_qos_unlock();
+
+    return sai_rc;
 }
 
 static sai_status_t sai_qos_buffer_pool_stats_extn_get (sai_object_id_t pool_id, uint32_t number_of_counters,
@@ -36,6 +36,7 @@
 #include "std_utils.h"
 #include "std_assert.h"
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 
 sai_status_t sai_qos_map_port_list_update(dn_sai_qos_map_t *p_map)
@@ -65,6 +66,140 @@ sai_status_t sai_qos_map_port_list_update(dn_sai_qos_map_t *p_map)
     return sai_rc;
 
 }
+
+/*
+ * Collect the entries of the map value list that differ from the old list.
+ * Entries past the end of the old list count as changed.
+ */
+sai_status_t sai_qos_map_delta_get(const sai_qos_map_list_t *p_old_list,
+                                   const dn_sai_qos_map_t *p_map,
+                                   dn_sai_qos_map_delta_t *p_delta)
+{
+    const sai_qos_map_list_t *p_new_list = NULL;
+    uint_t                    index = 0;
+    uint_t                    count = 0;
+
+    STD_ASSERT(p_old_list != NULL);
+    STD_ASSERT(p_map != NULL);
+    STD_ASSERT(p_delta != NULL);
+
+    p_new_list = &p_map->map_to_value;
+
+    memset(p_delta, 0, sizeof(dn_sai_qos_map_delta_t));
+    p_delta->generation = p_map->generation;
+
+    if((p_new_list->list == NULL) || (p_new_list->count == 0)){
+        return SAI_STATUS_SUCCESS;
+    }
+
+    p_delta->index_list = (uint_t *)calloc(p_new_list->count, sizeof(uint_t));
+    p_delta->entry_list = (sai_qos_map_t *)calloc(p_new_list->count,
+                                                  sizeof(sai_qos_map_t));
+
+    if((p_delta->index_list == NULL) || (p_delta->entry_list == NULL)){
+        sai_qos_map_delta_free(p_delta);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    for(index = 0; index < p_new_list->count; index++){
+        if((index < p_old_list->count) &&
+           (memcmp(&p_old_list->list[index], &p_new_list->list[index],
+                   sizeof(sai_qos_map_t)) == 0)){
+            continue;
+        }
+        p_delta->index_list[count] = index;
+        p_delta->entry_list[count] = p_new_list->list[index];
+        count++;
+    }
+
+    p_delta->count = count;
+
+    SAI_MAPS_LOG_TRACE("Map 0x%"PRIx64" generation %"PRIu64" has %u changed entries",
+                       p_map->key.map_id, p_map->generation, count);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_qos_map_delta_free(dn_sai_qos_map_delta_t *p_delta)
+{
+    STD_ASSERT(p_delta != NULL);
+
+    free(p_delta->index_list);
+    free(p_delta->entry_list);
+    p_delta->index_list = NULL;
+    p_delta->entry_list = NULL;
+    p_delta->count = 0;
+}
+
+/* Snapshot the ports the map is bound to, for an update without the lock */
+sai_status_t sai_qos_map_port_ids_get(dn_sai_qos_map_t *p_map,
+                                      sai_object_id_t **p_port_list,
+                                      uint_t *p_port_count)
+{
+    dn_sai_qos_port_t *p_qos_port_node = NULL;
+    uint_t             count = 0;
+
+    STD_ASSERT(p_map != NULL);
+    STD_ASSERT(p_port_list != NULL);
+    STD_ASSERT(p_port_count != NULL);
+
+    *p_port_list = NULL;
+    *p_port_count = 0;
+
+    for(p_qos_port_node = sai_qos_maps_get_port_node_from_map(p_map);
+        p_qos_port_node != NULL;
+        p_qos_port_node = sai_qos_maps_next_port_node_from_map_get(p_map, p_qos_port_node)){
+        count++;
+    }
+
+    if(count == 0){
+        return SAI_STATUS_SUCCESS;
+    }
+
+    *p_port_list = (sai_object_id_t *)calloc(count, sizeof(sai_object_id_t));
+
+    if(*p_port_list == NULL){
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    for(p_qos_port_node = sai_qos_maps_get_port_node_from_map(p_map);
+        p_qos_port_node != NULL;
+        p_qos_port_node = sai_qos_maps_next_port_node_from_map_get(p_map, p_qos_port_node)){
+        (*p_port_list)[*p_port_count] = p_qos_port_node->port_id;
+        (*p_port_count)++;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Push the changed entries of a map to the ports it was bound to when it
+ * changed. Runs without the Qos lock; the ports drop a delta that a later
+ * bind, unbind or map change has overtaken.
+ */
+void sai_qos_map_port_list_delta_update(sai_object_id_t map_id,
+                                        sai_qos_map_type_t map_type,
+                                        const dn_sai_qos_map_delta_t *p_delta,
+                                        const sai_object_id_t *p_port_list,
+                                        uint_t port_count)
+{
+    uint_t       port_idx = 0;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    STD_ASSERT(p_delta != NULL);
+
+    for(port_idx = 0; port_idx < port_count; port_idx++){
+        sai_rc = sai_qos_map_npu_api_get()->port_map_delta_set(p_port_list[port_idx],
+                                                               map_id, map_type,
+                                                               p_delta);
+        if(sai_rc != SAI_STATUS_SUCCESS){
+            SAI_MAPS_LOG_ERR("Map 0x%"PRIx64" generation %"PRIu64" update failed "
+                             "on port 0x%"PRIx64"", map_id, p_delta->generation,
+                             p_port_list[port_idx]);
+        }
+    }
+}
+
 void sai_qos_map_free_resources(dn_sai_qos_map_t *p_map_node)
 {
 
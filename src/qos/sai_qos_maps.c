@@ -36,9 +36,13 @@
 #include "std_type_defs.h"
 #include "std_utils.h"
 #include "std_assert.h"
+#include "std_mutex_lock.h"
 #include <stdlib.h>
 #include <inttypes.h>
 
+/* Orders the map deltas pushed to the ports outside the Qos lock */
+static std_mutex_lock_create_static_init_fast(qos_map_delta_lock);
+
 static inline uint_t sai_qos_maps_get_index(uint_t value, uint_t tc)
 {
     return (value * SAI_QOS_MAX_TC) + tc;
@@ -887,6 +891,11 @@ sai_object_id_t map_id, const sai_attribute_t *p_attr)
 {
     dn_sai_qos_map_t   map_new_node;
     dn_sai_qos_map_t  *p_map_exist_node = NULL;
+    sai_qos_map_list_t old_value;
+    dn_sai_qos_map_delta_t map_delta;
+    sai_object_id_t   *p_port_list = NULL;
+    uint_t             port_count = 0;
+    sai_qos_map_type_t map_type = 0;
     sai_status_t      sai_rc = SAI_STATUS_SUCCESS;
     uint_t            attr_flags = 0;
     uint_t            attr_count = 1;
@@ -901,6 +910,9 @@ sai_object_id_t map_id, const sai_attribute_t *p_attr)
     SAI_MAPS_LOG_TRACE("Setting attribute Id: %d on Map Id 0x%"PRIx64"",
            p_attr->id, map_id);
 
+    memset(&old_value, 0, sizeof(old_value));
+    memset(&map_delta, 0, sizeof(map_delta));
+
     sai_qos_lock();
 
     do{
@@ -917,11 +929,25 @@ sai_object_id_t map_id, const sai_attribute_t *p_attr)
 
         map_new_node.map_type = p_map_exist_node->map_type;
         map_new_node.key.map_id = map_id;
+        map_type = p_map_exist_node->map_type;
 
         if(p_map_exist_node->map_to_value.list != NULL){
 
             memcpy(&map_new_node.map_to_value,
                    &p_map_exist_node->map_to_value, sizeof(p_map_exist_node->map_to_value));
+
+            /* The value list is updated in place, keep the old values to
+             * diff the bound ports against and to restore on failure */
+            old_value.list = (sai_qos_map_t *)calloc(p_map_exist_node->map_to_value.count,
+                                                     sizeof(sai_qos_map_t));
+            if(old_value.list == NULL){
+                SAI_MAPS_LOG_ERR("Failed to allocate memory for old map values.");
+                sai_rc = SAI_STATUS_NO_MEMORY;
+                break;
+            }
+            old_value.count = p_map_exist_node->map_to_value.count;
+            memcpy(old_value.list, p_map_exist_node->map_to_value.list,
+                   old_value.count * sizeof(sai_qos_map_t));
         }
 
         sai_rc = sai_qos_parse_update_attributes(&map_new_node, attr_count,
@@ -951,19 +977,50 @@ sai_object_id_t map_id, const sai_attribute_t *p_attr)
     if(sai_rc == SAI_STATUS_SUCCESS){
         memcpy(&p_map_exist_node->map_to_value,
                &map_new_node.map_to_value, sizeof(p_map_exist_node->map_to_value));
+        p_map_exist_node->generation++;
 
         /*TC to Queue map alone is not hardware generated id. So when the
          * map values are modified update the associated ports on which the
-         * map is applied.
+         * map is applied. Only the changed entries are pushed, after the
+         * lock is released; the full map is re-applied if the delta can
+         * not be built.
          */
 
         if(!sai_qos_map_npu_api_get()->map_is_hw_object(p_map_exist_node->map_type)){
-            sai_qos_map_port_list_update(p_map_exist_node);
+            if((sai_qos_map_npu_api_get()->port_map_delta_set == NULL) ||
+               (sai_qos_map_delta_get(&old_value, p_map_exist_node,
+                                      &map_delta) != SAI_STATUS_SUCCESS) ||
+               ((map_delta.count > 0) &&
+                (sai_qos_map_port_ids_get(p_map_exist_node, &p_port_list,
+                                          &port_count) != SAI_STATUS_SUCCESS))){
+                sai_qos_map_delta_free(&map_delta);
+                sai_qos_map_port_list_update(p_map_exist_node);
+            }
         }
+    } else if((p_map_exist_node != NULL) && (old_value.list != NULL) &&
+              (p_map_exist_node->map_to_value.list != NULL)){
+        memcpy(p_map_exist_node->map_to_value.list, old_value.list,
+               old_value.count * sizeof(sai_qos_map_t));
+    }
+
+    if(port_count > 0){
+        /* Taken before the Qos lock is released so that deltas reach the
+         * ports in generation order */
+        std_mutex_lock(&qos_map_delta_lock);
     }
 
     sai_qos_unlock();
 
+    if(port_count > 0){
+        sai_qos_map_port_list_delta_update(map_id, map_type, &map_delta,
+                                           p_port_list, port_count);
+        std_mutex_unlock(&qos_map_delta_lock);
+    }
+
+    sai_qos_map_delta_free(&map_delta);
+    free(p_port_list);
+    free(old_value.list);
+
     return sai_rc;
 }
 
@@ -27,6 +27,8 @@
 #include "sai_debug_utils.h"
 #include "std_type_defs.h"
 #include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
 
 void sai_qos_maps_dump_help (void)
 {
@@ -91,60 +93,172 @@ void sai_qos_maps_dump_map_list(sai_qos_map_type_t map_type, sai_qos_map_list_t
         SAI_DEBUG("Map type not supported/not implemented");
     }
 }
-void sai_qos_maps_dump_node(dn_sai_qos_map_t *p_map_node)
+/*
+ * Copies a map node and the ids of the ports it is applied on under the
+ * Qos lock, so it is printed with the lock released.
+ */
+static sai_status_t sai_qos_maps_dump_copy_get(sai_object_id_t map_id,
+                                               dn_sai_qos_map_t *p_map_copy,
+                                               sai_object_id_t **p_port_list,
+                                               uint_t *p_port_count)
 {
+    dn_sai_qos_map_t *p_map_node = NULL;
     dn_sai_qos_port_t *p_qos_port_node = NULL;
-    SAI_DEBUG("Map Id : 0x%"PRIx64"",p_map_node->key.map_id);
-    SAI_DEBUG("Map type : %d",p_map_node->map_type);
+    sai_qos_map_t *p_map_list = NULL;
+    sai_object_id_t *p_ports = NULL;
+    uint_t port_count = 0;
 
-    SAI_DEBUG("Map list contents:");
-    if(p_map_node->map_to_value.list == NULL){
-        SAI_DEBUG("Map list is NULL");
+    sai_qos_lock();
+
+    p_map_node = sai_qos_map_node_get(map_id);
+
+    if(p_map_node == NULL){
+        sai_qos_unlock();
+        return SAI_STATUS_ITEM_NOT_FOUND;
     }
-    else{
-        sai_qos_maps_dump_map_list(p_map_node->map_type, p_map_node->map_to_value);
+
+    p_qos_port_node  = sai_qos_maps_get_port_node_from_map(p_map_node);
+
+    while(p_qos_port_node != NULL)
+    {
+        port_count++;
+        p_qos_port_node  = sai_qos_maps_next_port_node_from_map_get(p_map_node, p_qos_port_node);
     }
 
-    SAI_DEBUG("Map applied on portlist:");
+    p_map_list = (sai_qos_map_t *)calloc(p_map_node->map_to_value.count + 1,
+                                         sizeof(sai_qos_map_t));
+    p_ports = (sai_object_id_t *)calloc(port_count + 1, sizeof(sai_object_id_t));
+
+    if((p_map_list == NULL) || (p_ports == NULL)){
+        sai_qos_unlock();
+        free(p_map_list);
+        free(p_ports);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    memcpy(p_map_copy, p_map_node, sizeof(*p_map_copy));
+
+    if(p_map_node->map_to_value.list != NULL){
+        memcpy(p_map_list, p_map_node->map_to_value.list,
+               p_map_node->map_to_value.count * sizeof(sai_qos_map_t));
+        p_map_copy->map_to_value.list = p_map_list;
+    }
+    else{
+        free(p_map_list);
+        p_map_copy->map_to_value.list = NULL;
+    }
 
+    port_count = 0;
     p_qos_port_node  = sai_qos_maps_get_port_node_from_map(p_map_node);
 
     while(p_qos_port_node != NULL)
     {
-        SAI_DEBUG("Portid: 0x%"PRIx64"",p_qos_port_node->port_id);
+        p_ports[port_count++] = p_qos_port_node->port_id;
         p_qos_port_node  = sai_qos_maps_next_port_node_from_map_get(p_map_node, p_qos_port_node);
-
     }
 
+    sai_qos_unlock();
+
+    *p_port_list = p_ports;
+    *p_port_count = port_count;
+
+    return SAI_STATUS_SUCCESS;
 }
 
 void sai_qos_maps_dump(sai_object_id_t map_id)
 {
-    dn_sai_qos_map_t *p_map_node = NULL;
+    dn_sai_qos_map_t map_copy;
+    sai_object_id_t *p_port_list = NULL;
+    uint_t port_count = 0;
+    uint_t idx = 0;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
 
     SAI_DEBUG("Dumping the map node contents: ");
-    p_map_node = sai_qos_map_node_get(map_id);
 
-    if(p_map_node != NULL){
-        sai_qos_maps_dump_node(p_map_node);
+    sai_rc = sai_qos_maps_dump_copy_get(map_id, &map_copy, &p_port_list,
+                                        &port_count);
+
+    if(sai_rc == SAI_STATUS_ITEM_NOT_FOUND){
+        SAI_DEBUG("Map id not in tree");
+        return;
+    }
+    else if(sai_rc != SAI_STATUS_SUCCESS){
+        SAI_DEBUG("Failed to copy map id 0x%"PRIx64" for the dump", map_id);
+        return;
+    }
+
+    SAI_DEBUG("Map Id : 0x%"PRIx64"",map_copy.key.map_id);
+    SAI_DEBUG("Map type : %d",map_copy.map_type);
+
+    SAI_DEBUG("Map list contents:");
+    if(map_copy.map_to_value.list == NULL){
+        SAI_DEBUG("Map list is NULL");
     }
     else{
-        SAI_DEBUG("Map id not in tree");
+        sai_qos_maps_dump_map_list(map_copy.map_type, map_copy.map_to_value);
     }
+
+    SAI_DEBUG("Map applied on portlist:");
+
+    for(idx = 0; idx < port_count; idx++){
+        SAI_DEBUG("Portid: 0x%"PRIx64"",p_port_list[idx]);
+    }
+
+    free(map_copy.map_to_value.list);
+    free(p_port_list);
 }
 
+/*
+ * Walks the map tree in chunks under short holds of the Qos lock, each
+ * hold resuming with a getnext from the id of the last map walked, and
+ * dumps the maps of a chunk with the lock released.
+ */
 void sai_qos_maps_dump_all(void)
 {
     rbtree_handle  map_tree;
     dn_sai_qos_map_t *p_map_node = NULL;
+    dn_sai_qos_map_t map_key;
+    sai_object_id_t *p_map_ids = NULL;
+    uint_t map_count = 0;
+    uint_t idx = 0;
+    bool is_end = false;
+
+    p_map_ids = (sai_object_id_t *)calloc(SAI_QOS_DBG_DUMP_CHUNK,
+                                          sizeof(sai_object_id_t));
+    if(p_map_ids == NULL){
+        SAI_DEBUG("Failed to allocate the map dump buffer");
+        return;
+    }
+
+    memset(&map_key, 0, sizeof(map_key));
+
+    while(!is_end){
+        map_count = 0;
+
+        sai_qos_lock();
+
+        map_tree = sai_qos_access_global_config()->map_tree;
 
-    map_tree = sai_qos_access_global_config()->map_tree;
+        p_map_node = std_rbtree_getnext (map_tree, &map_key);
 
-    p_map_node = std_rbtree_getfirst (map_tree);
+        while ((p_map_node != NULL) && (map_count < SAI_QOS_DBG_DUMP_CHUNK)) {
+            p_map_ids[map_count++] = p_map_node->key.map_id;
 
-    while (p_map_node) {
-        sai_qos_maps_dump_node (p_map_node);
+            p_map_node = std_rbtree_getnext (map_tree, p_map_node);
+        }
+
+        is_end = (p_map_node == NULL);
 
-        p_map_node = std_rbtree_getnext (map_tree, p_map_node);
+        sai_qos_unlock();
+
+        for(idx = 0; idx < map_count; idx++){
+            sai_qos_maps_dump(p_map_ids[idx]);
+        }
+
+        if(map_count > 0){
+            map_key.key.map_id = p_map_ids[map_count - 1];
+        }
     }
+
+    free(p_map_ids);
 }
@@ -27,6 +27,8 @@
 #include "sai_debug_utils.h"
 #include "std_type_defs.h"
 #include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
 
 void sai_qos_policer_dump_help (void)
 {
@@ -37,65 +39,173 @@ void sai_qos_policer_dump_help (void)
 }
 
 
-void sai_qos_policer_dump_node(dn_sai_qos_policer_t *p_policer_node)
+/* Port a policer is applied on, copied for the policer dump */
+typedef struct _sai_qos_policer_dump_port_t {
+    uint_t           type;
+    sai_object_id_t  port_id;
+} sai_qos_policer_dump_port_t;
+
+/*
+ * Copies a policer node and the ports it is applied on under the Qos lock,
+ * so it is printed with the lock released.
+ */
+static sai_status_t sai_qos_policer_dump_copy_get(sai_object_id_t policer_id,
+                                                  dn_sai_qos_policer_t *p_policer_copy,
+                                                  sai_qos_policer_dump_port_t **p_port_list,
+                                                  uint_t *p_port_count)
 {
-    size_t count = 0;
-    size_t type = 0;
+    uint_t type = 0;
+    dn_sai_qos_policer_t *p_policer_node = NULL;
     dn_sai_qos_port_t *p_port_node = NULL;
+    sai_qos_policer_dump_port_t *p_ports = NULL;
+    uint_t port_count = 0;
 
-    SAI_DEBUG("Policer Id : 0x%"PRIx64" Policer mode: %d Meter_type: %d "
-              "Color source : %d Cbs %lu Pbs %lu Cir %lu Pir %lu actioncount %d",
-              p_policer_node->key.policer_id, p_policer_node->policer_mode,
-              p_policer_node->meter_type, p_policer_node->color_source,
-              p_policer_node->cbs, p_policer_node->pbs, p_policer_node->cir,
-              p_policer_node->pir, p_policer_node->action_count);
+    sai_qos_lock();
 
-    SAI_DEBUG("Policer action list:");
+    p_policer_node = sai_qos_policer_node_get(policer_id);
 
-    for(count = 0; count < SAI_POLICER_MAX_ACTION_COUNT; count ++){
-        SAI_DEBUG("Action %d Enable %d Value %d",p_policer_node->action_list[count].action,
-                  p_policer_node->action_list[count].enable,
-                  p_policer_node->action_list[count].value);
+    if(p_policer_node == NULL){
+        sai_qos_unlock();
+        return SAI_STATUS_ITEM_NOT_FOUND;
     }
-    SAI_DEBUG("Policer applied on portlist:");
 
     for(type = 0; type < SAI_QOS_POLICER_TYPE_MAX; type ++){
         p_port_node = sai_qos_port_node_from_policer_get(p_policer_node, type);
 
         while(p_port_node != NULL){
-            SAI_DEBUG("Policer type %ld Portid: 0x%"PRIx64"",type, p_port_node->port_id);
+            port_count++;
             p_port_node = sai_qos_next_port_node_from_policer_get(p_policer_node,
                                                                   p_port_node, type);
         }
     }
+
+    p_ports = (sai_qos_policer_dump_port_t *)calloc(port_count + 1,
+                                                    sizeof(sai_qos_policer_dump_port_t));
+    if(p_ports == NULL){
+        sai_qos_unlock();
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    memcpy(p_policer_copy, p_policer_node, sizeof(*p_policer_copy));
+
+    port_count = 0;
+    for(type = 0; type < SAI_QOS_POLICER_TYPE_MAX; type ++){
+        p_port_node = sai_qos_port_node_from_policer_get(p_policer_node, type);
+
+        while(p_port_node != NULL){
+            p_ports[port_count].type = type;
+            p_ports[port_count].port_id = p_port_node->port_id;
+            port_count++;
+            p_port_node = sai_qos_next_port_node_from_policer_get(p_policer_node,
+                                                                  p_port_node, type);
+        }
+    }
+
+    sai_qos_unlock();
+
+    *p_port_list = p_ports;
+    *p_port_count = port_count;
+
+    return SAI_STATUS_SUCCESS;
 }
 
 void sai_qos_policer_dump(sai_object_id_t policer_id)
 {
-    dn_sai_qos_policer_t *p_policer_node = NULL;
+    size_t count = 0;
+    dn_sai_qos_policer_t policer_copy;
+    sai_qos_policer_dump_port_t *p_port_list = NULL;
+    uint_t port_count = 0;
+    uint_t idx = 0;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
 
     SAI_DEBUG("Dumping the policer node contents: ");
-    p_policer_node = sai_qos_policer_node_get(policer_id);
 
-    if(p_policer_node != NULL){
-        sai_qos_policer_dump_node(p_policer_node);
-    }
-    else{
+    sai_rc = sai_qos_policer_dump_copy_get(policer_id, &policer_copy,
+                                           &p_port_list, &port_count);
+
+    if(sai_rc == SAI_STATUS_ITEM_NOT_FOUND){
         SAI_DEBUG("Policer id not in tree");
+        return;
     }
+    else if(sai_rc != SAI_STATUS_SUCCESS){
+        SAI_DEBUG("Failed to copy policer id 0x%"PRIx64" for the dump", policer_id);
+        return;
+    }
+
+    SAI_DEBUG("Policer Id : 0x%"PRIx64" Policer mode: %d Meter_type: %d "
+              "Color source : %d Cbs %lu Pbs %lu Cir %lu Pir %lu actioncount %d",
+              policer_copy.key.policer_id, policer_copy.policer_mode,
+              policer_copy.meter_type, policer_copy.color_source,
+              policer_copy.cbs, policer_copy.pbs, policer_copy.cir,
+              policer_copy.pir, policer_copy.action_count);
+
+    SAI_DEBUG("Policer action list:");
+
+    for(count = 0; count < SAI_POLICER_MAX_ACTION_COUNT; count ++){
+        SAI_DEBUG("Action %d Enable %d Value %d",policer_copy.action_list[count].action,
+                  policer_copy.action_list[count].enable,
+                  policer_copy.action_list[count].value);
+    }
+    SAI_DEBUG("Policer applied on portlist:");
+
+    for(idx = 0; idx < port_count; idx ++){
+        SAI_DEBUG("Policer type %u Portid: 0x%"PRIx64"",p_port_list[idx].type,
+                  p_port_list[idx].port_id);
+    }
+
+    free(p_port_list);
 }
 
+/*
+ * Walks the policer tree in chunks under short holds of the Qos lock, each
+ * hold resuming with a getnext from the id of the last policer walked, and
+ * dumps the policers of a chunk with the lock released.
+ */
 void sai_qos_policer_dump_all(void)
 {
     rbtree_handle  policer_tree;
     dn_sai_qos_policer_t *p_policer_node = NULL;
+    dn_sai_qos_policer_t policer_key;
+    sai_object_id_t *p_policer_ids = NULL;
+    uint_t policer_count = 0;
+    uint_t idx = 0;
+    bool is_end = false;
+
+    p_policer_ids = (sai_object_id_t *)calloc(SAI_QOS_DBG_DUMP_CHUNK,
+                                              sizeof(sai_object_id_t));
+    if(p_policer_ids == NULL){
+        SAI_DEBUG("Failed to allocate the policer dump buffer");
+        return;
+    }
+
+    memset(&policer_key, 0, sizeof(policer_key));
+
+    while(!is_end){
+        policer_count = 0;
+
+        sai_qos_lock();
+
+        policer_tree = sai_qos_access_global_config()->policer_tree;
 
-    policer_tree = sai_qos_access_global_config()->policer_tree;
+        p_policer_node = std_rbtree_getnext (policer_tree, &policer_key);
+        while((p_policer_node != NULL) && (policer_count < SAI_QOS_DBG_DUMP_CHUNK)){
+            p_policer_ids[policer_count++] = p_policer_node->key.policer_id;
 
-    p_policer_node = std_rbtree_getfirst (policer_tree);
-    while(p_policer_node != NULL){
-        sai_qos_policer_dump_node (p_policer_node);
+            p_policer_node = std_rbtree_getnext (policer_tree, p_policer_node);
+        }
+
+        is_end = (p_policer_node == NULL);
 
-        p_policer_node = std_rbtree_getnext (policer_tree, p_policer_node);
+        sai_qos_unlock();
+
+        for(idx = 0; idx < policer_count; idx++){
+            sai_qos_policer_dump(p_policer_ids[idx]);
+        }
+
+        if(policer_count > 0){
+            policer_key.key.policer_id = p_policer_ids[policer_count - 1];
+        }
     }
+
+    free(p_policer_ids);
 }
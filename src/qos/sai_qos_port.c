@@ -34,10 +34,12 @@
 #include "saistatus.h"
 
 #include "std_assert.h"
+#include "std_thread_tools.h"
 
 #include <string.h>
 #include <inttypes.h>
 #include <stdlib.h>
+#include <unistd.h>
 
 static const dn_sai_attribute_entry_t sai_port_pool_attr_table[] = {
     {SAI_PORT_POOL_ATTR_PORT_ID,                true, true, false, true, true, true},
@@ -47,6 +49,21 @@ static const dn_sai_attribute_entry_t sai_port_pool_attr_table[] = {
 
 static dn_sai_id_gen_info_t port_pool_obj_gen_info;
 
+/*
+ * Ports whose QoS init was deferred at switch init, in port list order.
+ * They are built under the QoS lock, by the builder thread or by the first
+ * QoS lock holder, always in this order so that their object ids come out
+ * as with a serial init.
+ */
+static sai_object_id_t *sai_qos_port_deferred_list = NULL;
+static uint_t           sai_qos_port_deferred_count = 0;
+static uint_t           sai_qos_port_deferred_next = 0;
+static bool             sai_qos_port_deferred_pending = false;
+
+/* Builder thread, woken through a pipe when ports get deferred */
+static std_thread_create_param_t sai_qos_port_deferred_thread;
+static int sai_qos_port_deferred_wake_fd [2] = {-1, -1};
+
 bool sai_is_port_pool_id_in_use(uint64_t obj_id)
 {
     sai_object_id_t port_pool_oid =
@@ -832,6 +849,150 @@ sai_status_t sai_qos_port_deinit (sai_object_id_t port_id)
     return sai_rc;
 }
 
+void sai_qos_port_deferred_init_flush (void)
+{
+    sai_object_id_t port_id = SAI_NULL_OBJECT_ID;
+
+    if (! __atomic_load_n (&sai_qos_port_deferred_pending, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+
+    while (sai_qos_port_deferred_next < sai_qos_port_deferred_count) {
+        port_id = sai_qos_port_deferred_list [sai_qos_port_deferred_next];
+        sai_qos_port_deferred_next++;
+
+        /* Removed by a port breakout since switch init */
+        if (! sai_is_port_valid (port_id)) {
+            continue;
+        }
+
+        if (sai_qos_port_init_internal (port_id) != SAI_STATUS_SUCCESS) {
+            SAI_QOS_LOG_CRIT ("SAI QOS Port 0x%"PRIx64" deferred init failed.",
+                              port_id);
+        }
+    }
+
+    SAI_QOS_LOG_INFO ("Deferred Qos init of %u ports complete.",
+                      sai_qos_port_deferred_count);
+
+    free (sai_qos_port_deferred_list);
+    sai_qos_port_deferred_list = NULL;
+    sai_qos_port_deferred_count = 0;
+    sai_qos_port_deferred_next = 0;
+
+    __atomic_store_n (&sai_qos_port_deferred_pending, false, __ATOMIC_RELEASE);
+}
+
+void sai_qos_port_all_init_wait (void)
+{
+    if (! __atomic_load_n (&sai_qos_port_deferred_pending, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+
+    /* The lock holder builds the deferred ports */
+    sai_qos_lock ();
+    sai_qos_unlock ();
+}
+
+static void *sai_qos_port_deferred_init_thread (void *param)
+{
+    char wake;
+
+    while (read (sai_qos_port_deferred_wake_fd [0], &wake, sizeof (wake)) > 0) {
+        sai_qos_port_all_init_wait ();
+    }
+
+    SAI_QOS_LOG_ERR ("Qos port builder event queue closed, exiting.");
+    return NULL;
+}
+
+static bool sai_qos_port_init_defer_enabled (void)
+{
+    const char *env = getenv (SAI_QOS_PORT_INIT_DEFER_ENV);
+
+    return ((env == NULL) || (*env == '\0') || (strtol (env, NULL, 0) != 0));
+}
+
+/* Start the builder thread once, false if it can not run */
+static bool sai_qos_port_deferred_thread_start (void)
+{
+    if (sai_qos_port_deferred_wake_fd [1] != -1) {
+        return true;
+    }
+
+    if (pipe (sai_qos_port_deferred_wake_fd) != 0) {
+        SAI_QOS_LOG_ERR ("Qos port builder event queue initialization failed.");
+        sai_qos_port_deferred_wake_fd [0] = sai_qos_port_deferred_wake_fd [1] = -1;
+        return false;
+    }
+
+    std_thread_init_struct (&sai_qos_port_deferred_thread);
+    sai_qos_port_deferred_thread.name = "sai-qos-port-init";
+    sai_qos_port_deferred_thread.thread_function = sai_qos_port_deferred_init_thread;
+
+    if (std_thread_create (&sai_qos_port_deferred_thread) != STD_ERR_OK) {
+        SAI_QOS_LOG_ERR ("Qos port builder thread creation failed.");
+        close (sai_qos_port_deferred_wake_fd [0]);
+        close (sai_qos_port_deferred_wake_fd [1]);
+        sai_qos_port_deferred_wake_fd [0] = sai_qos_port_deferred_wake_fd [1] = -1;
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Queue the valid ports for a deferred init and wake the builder thread.
+ * Called with the QoS lock held, false if the ports must be built now.
+ */
+static bool sai_qos_port_all_init_defer (void)
+{
+    sai_port_info_t *port_info = NULL;
+    uint_t           count = 0;
+    char             wake = 0;
+
+    if ((! sai_qos_port_init_defer_enabled ()) ||
+        (! sai_qos_port_deferred_thread_start ())) {
+        return false;
+    }
+
+    for (port_info = sai_port_info_getfirst(); (port_info != NULL);
+         port_info = sai_port_info_getnext(port_info)) {
+        count++;
+    }
+
+    sai_qos_port_deferred_list = (sai_object_id_t *) calloc (count ? count : 1,
+                                                             sizeof (sai_object_id_t));
+
+    if (sai_qos_port_deferred_list == NULL) {
+        return false;
+    }
+
+    sai_qos_port_deferred_count = 0;
+    sai_qos_port_deferred_next = 0;
+
+    for (port_info = sai_port_info_getfirst(); (port_info != NULL);
+         port_info = sai_port_info_getnext(port_info)) {
+
+        if (! sai_is_port_valid (port_info->sai_port_id)) {
+            continue;
+        }
+        sai_qos_port_deferred_list [sai_qos_port_deferred_count++] =
+            port_info->sai_port_id;
+    }
+
+    __atomic_store_n (&sai_qos_port_deferred_pending, true, __ATOMIC_RELEASE);
+
+    if (write (sai_qos_port_deferred_wake_fd [1], &wake, sizeof (wake)) != sizeof (wake)) {
+        SAI_QOS_LOG_ERR ("Qos port builder wake up failed, ports are built "
+                         "on first use.");
+    }
+
+    SAI_QOS_LOG_INFO ("Qos init of %u ports deferred.", sai_qos_port_deferred_count);
+
+    return true;
+}
+
 sai_status_t sai_qos_port_all_init (void)
 {
     sai_status_t    sai_rc = SAI_STATUS_FAILURE;
@@ -850,6 +1011,10 @@ sai_status_t sai_qos_port_all_init (void)
         return sai_rc;
     }
 
+    if (sai_qos_port_all_init_defer ()) {
+        return SAI_STATUS_SUCCESS;
+    }
+
     for (port_info = sai_port_info_getfirst(); (port_info != NULL);
          port_info = sai_port_info_getnext(port_info)) {
 
@@ -885,6 +1050,13 @@ sai_status_t sai_qos_port_all_deinit (void)
 
     SAI_QOS_LOG_TRACE ("Port All Qos De-Init.");
 
+    /* Ports not built yet have nothing to tear down */
+    free (sai_qos_port_deferred_list);
+    sai_qos_port_deferred_list = NULL;
+    sai_qos_port_deferred_count = 0;
+    sai_qos_port_deferred_next = 0;
+    __atomic_store_n (&sai_qos_port_deferred_pending, false, __ATOMIC_RELEASE);
+
     cpu_port_id = sai_switch_cpu_port_obj_id_get();
 
     sai_rc = sai_qos_port_deinit_internal (cpu_port_id);
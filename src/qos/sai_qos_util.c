@@ -38,6 +38,7 @@
 #include "std_llist.h"
 #include "std_struct_utils.h"
 #include "sai_qos_port_util.h"
+#include "sai_api_stats.h"
 
 #include <string.h>
 #include <inttypes.h>
@@ -144,7 +145,10 @@ void sai_qos_default_sched_id_set(sai_object_id_t sched_id)
 
 void sai_qos_lock (void)
 {
-    std_mutex_lock (&g_sai_qos_lock);
+    sai_api_stats_mutex_lock (&g_sai_qos_lock);
+
+    /* Ports deferred at switch init are built before any other QoS change */
+    sai_qos_port_deferred_init_flush ();
 }
 
 void sai_qos_unlock (void)
@@ -27,6 +27,8 @@
 #include "sai_debug_utils.h"
 #include "std_type_defs.h"
 #include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
 
 void sai_qos_wred_dump_help (void)
 {
@@ -36,69 +38,174 @@ void sai_qos_wred_dump_help (void)
     SAI_DEBUG ("  void sai_qos_wred_dump_all (void)");
 }
 
-void sai_qos_wred_dump_node(dn_sai_qos_wred_t  *p_wred_node)
+/* Object a WRED profile is applied on, copied for the WRED dump */
+typedef struct _sai_qos_wred_dump_link_t {
+    dn_sai_qos_wred_link_t  link_type;
+    sai_object_id_t         oid;
+} sai_qos_wred_dump_link_t;
+
+/*
+ * Copies a WRED node and the objects it is applied on under the Qos lock,
+ * so it is printed with the lock released.
+ */
+static sai_status_t sai_qos_wred_dump_copy_get(sai_object_id_t wred_id,
+                                               dn_sai_qos_wred_t *p_wred_copy,
+                                               sai_qos_wred_dump_link_t **p_link_list,
+                                               uint_t *p_link_count)
 {
-    size_t color = 0;
+    dn_sai_qos_wred_t *p_wred_node = NULL;
     void *p_wred_link_node = NULL;
     dn_sai_qos_wred_link_t  wred_link_type = DN_SAI_QOS_WRED_LINK_QUEUE;
+    sai_qos_wred_dump_link_t *p_links = NULL;
+    uint_t link_count = 0;
+
+    sai_qos_lock();
+
+    p_wred_node = sai_qos_wred_node_get(wred_id);
 
     if(p_wred_node == NULL){
-        SAI_DEBUG("WRED node is NULL");
-        return;
+        sai_qos_unlock();
+        return SAI_STATUS_ITEM_NOT_FOUND;
     }
 
-    SAI_DEBUG("WRED ID : 0x%"PRIx64" weight: %d ecn_mark_mode: %d",
-              p_wred_node->key.wred_id, p_wred_node->weight, p_wred_node->ecn_mark_mode);
+    for(wred_link_type = DN_SAI_QOS_WRED_LINK_QUEUE;
+            wred_link_type < DN_SAI_QOS_WRED_LINK_MAX;
+            wred_link_type++) {
+        p_wred_link_node = sai_qos_wred_link_node_get_first(p_wred_node, wred_link_type);
 
-    SAI_DEBUG("WRED Thresholds:");
-    for(color = 0; color < SAI_QOS_MAX_PACKET_COLORS; color ++){
-        SAI_DEBUG("Color %ld", color);
-        SAI_DEBUG("Enable: %d Minlimit: %d Maxlimit: %d Drop Probability: %d",
-                  p_wred_node->threshold[color].enable, p_wred_node->threshold[color].min_limit,
-                  p_wred_node->threshold[color].max_limit,p_wred_node->threshold[color].drop_probability);
+        while(p_wred_link_node != NULL) {
+            link_count++;
+            p_wred_link_node =
+                sai_qos_wred_link_node_get_next(p_wred_node, p_wred_link_node, wred_link_type);
+        }
     }
 
+    p_links = (sai_qos_wred_dump_link_t *)calloc(link_count + 1,
+                                                 sizeof(sai_qos_wred_dump_link_t));
+    if(p_links == NULL){
+        sai_qos_unlock();
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    memcpy(p_wred_copy, p_wred_node, sizeof(*p_wred_copy));
+
+    link_count = 0;
     for(wred_link_type = DN_SAI_QOS_WRED_LINK_QUEUE;
             wred_link_type < DN_SAI_QOS_WRED_LINK_MAX;
             wred_link_type++) {
         p_wred_link_node = sai_qos_wred_link_node_get_first(p_wred_node, wred_link_type);
 
         while(p_wred_link_node != NULL) {
-            SAI_DEBUG("WRED applied on %s ID 0x%"PRIx64"",
-                    sai_qos_wred_link_str(wred_link_type),
-                    sai_qos_wred_link_oid_get(p_wred_link_node, wred_link_type));
+            p_links[link_count].link_type = wred_link_type;
+            p_links[link_count].oid =
+                sai_qos_wred_link_oid_get(p_wred_link_node, wred_link_type);
+            link_count++;
             p_wred_link_node =
                 sai_qos_wred_link_node_get_next(p_wred_node, p_wred_link_node, wred_link_type);
         }
     }
+
+    sai_qos_unlock();
+
+    *p_link_list = p_links;
+    *p_link_count = link_count;
+
+    return SAI_STATUS_SUCCESS;
 }
 
 void sai_qos_wred_dump(sai_object_id_t wred_id)
 {
-    dn_sai_qos_wred_t *p_wred_node = NULL;
+    size_t color = 0;
+    dn_sai_qos_wred_t wred_copy;
+    sai_qos_wred_dump_link_t *p_link_list = NULL;
+    uint_t link_count = 0;
+    uint_t idx = 0;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
 
     SAI_DEBUG("Dumping the wred node contents: ");
-    p_wred_node = sai_qos_wred_node_get(wred_id);
 
-    if(p_wred_node != NULL){
-        sai_qos_wred_dump_node(p_wred_node);
+    sai_rc = sai_qos_wred_dump_copy_get(wred_id, &wred_copy, &p_link_list,
+                                        &link_count);
+
+    if(sai_rc == SAI_STATUS_ITEM_NOT_FOUND){
+        SAI_DEBUG("Wred id not in tree");
+        return;
     }
-    else{
-        SAI_DEBUG("Policer id not in tree");
+    else if(sai_rc != SAI_STATUS_SUCCESS){
+        SAI_DEBUG("Failed to copy wred id 0x%"PRIx64" for the dump", wred_id);
+        return;
     }
+
+    SAI_DEBUG("WRED ID : 0x%"PRIx64" weight: %d ecn_mark_mode: %d",
+              wred_copy.key.wred_id, wred_copy.weight, wred_copy.ecn_mark_mode);
+
+    SAI_DEBUG("WRED Thresholds:");
+    for(color = 0; color < SAI_QOS_MAX_PACKET_COLORS; color ++){
+        SAI_DEBUG("Color %ld", color);
+        SAI_DEBUG("Enable: %d Minlimit: %d Maxlimit: %d Drop Probability: %d",
+                  wred_copy.threshold[color].enable, wred_copy.threshold[color].min_limit,
+                  wred_copy.threshold[color].max_limit,wred_copy.threshold[color].drop_probability);
+    }
+
+    for(idx = 0; idx < link_count; idx++) {
+        SAI_DEBUG("WRED applied on %s ID 0x%"PRIx64"",
+                sai_qos_wred_link_str(p_link_list[idx].link_type),
+                p_link_list[idx].oid);
+    }
+
+    free(p_link_list);
 }
 
+/*
+ * Walks the WRED tree in chunks under short holds of the Qos lock, each
+ * hold resuming with a getnext from the id of the last WRED walked, and
+ * dumps the WREDs of a chunk with the lock released.
+ */
 void sai_qos_wred_dump_all(void)
 {
     rbtree_handle  wred_tree;
     dn_sai_qos_wred_t *p_wred_node = NULL;
+    dn_sai_qos_wred_t wred_key;
+    sai_object_id_t *p_wred_ids = NULL;
+    uint_t wred_count = 0;
+    uint_t idx = 0;
+    bool is_end = false;
+
+    p_wred_ids = (sai_object_id_t *)calloc(SAI_QOS_DBG_DUMP_CHUNK,
+                                           sizeof(sai_object_id_t));
+    if(p_wred_ids == NULL){
+        SAI_DEBUG("Failed to allocate the wred dump buffer");
+        return;
+    }
 
-    wred_tree = sai_qos_access_global_config()->wred_tree;
+    memset(&wred_key, 0, sizeof(wred_key));
 
-    p_wred_node = std_rbtree_getfirst (wred_tree);
-    while(p_wred_node != NULL){
-        sai_qos_wred_dump_node (p_wred_node);
+    while(!is_end){
+        wred_count = 0;
 
-        p_wred_node = std_rbtree_getnext (wred_tree, p_wred_node);
+        sai_qos_lock();
+
+        wred_tree = sai_qos_access_global_config()->wred_tree;
+
+        p_wred_node = std_rbtree_getnext (wred_tree, &wred_key);
+        while((p_wred_node != NULL) && (wred_count < SAI_QOS_DBG_DUMP_CHUNK)){
+            p_wred_ids[wred_count++] = p_wred_node->key.wred_id;
+
+            p_wred_node = std_rbtree_getnext (wred_tree, p_wred_node);
+        }
+
+        is_end = (p_wred_node == NULL);
+
+        sai_qos_unlock();
+
+        for(idx = 0; idx < wred_count; idx++){
+            sai_qos_wred_dump(p_wred_ids[idx]);
+        }
+
+        if(wred_count > 0){
+            wred_key.key.wred_id = p_wred_ids[wred_count - 1];
+        }
     }
+
+    free(p_wred_ids);
 }
@@ -29,6 +29,7 @@
 #include "sai_qos_common.h"
 #include "saibuffer.h"
 #include <inttypes.h>
+#include <string.h>
 #include "sai_qos_util.h"
 #include "sai_qos_buffer_util.h"
 #include "std_bit_masks.h"
@@ -387,9 +388,40 @@ static sai_status_t sai_vm_buffer_pool_stats_get (sai_object_id_t pool_id,
                                                   uint32_t number_of_counters,
                                                   uint64_t* counters)
 {
+    dn_sai_qos_buffer_pool_t *p_buf_pool_node = NULL;
+    uint64_t                  curr_bytes = 0;
+    uint64_t                  watermark_bytes = 0;
+    uint_t                    list_index = 0;
+
     STD_ASSERT (counter_ids != NULL);
     STD_ASSERT (counters != NULL);
 
+    p_buf_pool_node = sai_qos_buffer_pool_node_get (pool_id);
+    if (p_buf_pool_node == NULL) {
+        SAI_BUFFER_LOG_ERR ("Buffer pool 0x%"PRIx64" not found", pool_id);
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    /* The VM has a single shared buffer per direction; every pool of a
+     * direction reports the occupancy of all the port qdiscs. */
+    sai_vm_qos_tc_pool_stats_get (p_buf_pool_node->pool_type, &curr_bytes,
+                                  &watermark_bytes);
+
+    for (list_index = 0; list_index < number_of_counters; list_index++) {
+        switch (counter_ids [list_index]) {
+            case SAI_BUFFER_POOL_STAT_CURR_OCCUPANCY_BYTES:
+                counters [list_index] = curr_bytes;
+                break;
+
+            case SAI_BUFFER_POOL_STAT_WATERMARK_BYTES:
+                counters [list_index] = watermark_bytes;
+                break;
+
+            default:
+                return SAI_STATUS_NOT_SUPPORTED;
+        }
+    }
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -404,14 +436,93 @@ static sai_status_t sai_vm_pg_attr_get (dn_sai_qos_pg_t *p_pg_node,
 }
 
 
+/* Map a SAI PG counter to the tc counter of the port ingress qdisc */
+static sai_status_t sai_vm_pg_stat_to_tc_stat (sai_ingress_priority_group_stat_t counter_id,
+                                               sai_vm_qos_tc_stat_t *tc_stat)
+{
+    switch (counter_id) {
+        case SAI_INGRESS_PRIORITY_GROUP_STAT_PACKETS:
+            *tc_stat = SAI_VM_QOS_TC_STAT_PACKETS;
+            break;
+
+        case SAI_INGRESS_PRIORITY_GROUP_STAT_BYTES:
+            *tc_stat = SAI_VM_QOS_TC_STAT_BYTES;
+            break;
+
+        case SAI_INGRESS_PRIORITY_GROUP_STAT_CURR_OCCUPANCY_BYTES:
+        case SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_CURR_OCCUPANCY_BYTES:
+            *tc_stat = SAI_VM_QOS_TC_STAT_BACKLOG;
+            break;
+
+        case SAI_INGRESS_PRIORITY_GROUP_STAT_WATERMARK_BYTES:
+        case SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES:
+            *tc_stat = SAI_VM_QOS_TC_STAT_WATERMARK;
+            break;
+
+        case SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_CURR_OCCUPANCY_BYTES:
+        case SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES:
+            /* No headroom on the VM, always reported as zero */
+            *tc_stat = SAI_VM_QOS_TC_STAT_MAX;
+            break;
+
+        default:
+            return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * All traffic of a VM port is received into PG 0, which is accounted by the
+ * ingress qdisc of the port device. The other PGs stay at zero.
+ */
+static bool sai_vm_pg_tc_key_get (sai_object_id_t pg_id, int *if_index)
+{
+    dn_sai_qos_pg_t *p_pg_node = NULL;
+
+    if (SAI_VM_PG_NUM_GET (sai_uoid_npu_obj_id_get (pg_id)) != 0) {
+        return false;
+    }
+
+    p_pg_node = sai_qos_pg_node_get (pg_id);
+    if (p_pg_node == NULL) {
+        return false;
+    }
+
+    return (sai_vm_qos_port_if_index_get (p_pg_node->port_id, if_index)
+            == SAI_STATUS_SUCCESS);
+}
+
 static sai_status_t sai_vm_pg_stats_get (sai_object_id_t pg_id,
                                          const sai_ingress_priority_group_stat_t
                                          *counter_ids, uint32_t number_of_counters,
                                          uint64_t* counters)
 {
+    sai_status_t         sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_qos_tc_stat_t tc_stat = SAI_VM_QOS_TC_STAT_PACKETS;
+    uint64_t             stats [SAI_VM_QOS_TC_STAT_MAX];
+    int                  if_index = 0;
+    uint_t               list_index = 0;
+
     STD_ASSERT (counter_ids != NULL);
     STD_ASSERT (counters != NULL);
 
+    memset (stats, 0, sizeof (stats));
+
+    if (sai_vm_pg_tc_key_get (pg_id, &if_index)) {
+        sai_vm_qos_tc_stats_get (if_index, TC_H_INGRESS, stats);
+    }
+
+    for (list_index = 0; list_index < number_of_counters; list_index++) {
+        sai_rc = sai_vm_pg_stat_to_tc_stat (counter_ids [list_index], &tc_stat);
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            return sai_rc;
+        }
+
+        counters [list_index] = (tc_stat < SAI_VM_QOS_TC_STAT_MAX) ?
+                                stats [tc_stat] : 0;
+    }
+
     return SAI_STATUS_SUCCESS;
 
 }
@@ -420,7 +531,27 @@ static sai_status_t sai_vm_buffer_pg_stats_clear (sai_object_id_t pg_id,
                                                   const sai_ingress_priority_group_stat_t
                                                   *counter_ids, uint32_t number_of_counters)
 {
+    sai_status_t         sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_qos_tc_stat_t tc_stat = SAI_VM_QOS_TC_STAT_PACKETS;
+    int                  if_index = 0;
+    bool                 has_qdisc = false;
+    uint_t               list_index = 0;
+
     STD_ASSERT (counter_ids != NULL);
+
+    has_qdisc = sai_vm_pg_tc_key_get (pg_id, &if_index);
+
+    for (list_index = 0; list_index < number_of_counters; list_index++) {
+        sai_rc = sai_vm_pg_stat_to_tc_stat (counter_ids [list_index], &tc_stat);
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            return sai_rc;
+        }
+
+        if (has_qdisc && (tc_stat < SAI_VM_QOS_TC_STAT_MAX)) {
+            sai_vm_qos_tc_stats_clear (if_index, TC_H_INGRESS, &tc_stat, 1);
+        }
+    }
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -27,6 +27,7 @@
 #include "saistatus.h"
 #include "saitypes.h"
 #include "sai_vm_qos.h"
+#include "sai_vm_vport.h"
 #include "std_bit_masks.h"
 #include "sai_qos_util.h"
 #include "std_assert.h"
@@ -98,6 +99,8 @@ static sai_status_t sai_vm_qos_global_init (void)
         return SAI_STATUS_NO_MEMORY;
     }
 
+    status = sai_vm_qos_stats_init ();
+
     return status;
 }
 
@@ -195,7 +198,7 @@ static sai_status_t sai_vm_qos_switch_default_tc_set(uint_t default_tc)
 {
     sai_status_t sai_rc = SAI_STATUS_SUCCESS;
 
-    /* TODO */
+    sai_vm_vport_qos_default_tc_set (default_tc);
     return sai_rc;
 }
 
@@ -27,6 +27,7 @@
 #include "sai_qos_util.h"
 #include "sai_event_log.h"
 #include "sai_vm_qos.h"
+#include "sai_vm_vport.h"
 #include "std_assert.h"
 #include <string.h>
 #include <stdlib.h>
@@ -166,8 +167,58 @@ static sai_status_t sai_vm_qos_port_map_set(sai_object_id_t port_id,
                                       sai_qos_map_type_t map_type,
                                       bool map_set)
 {
-    /** @TODO: to be implemented */
-    return SAI_STATUS_SUCCESS;
+    sai_port_info_t          *p_port_info = NULL;
+    dn_sai_qos_map_t         *p_map = NULL;
+    const sai_qos_map_list_t *p_map_list = NULL;
+
+    p_port_info = sai_port_info_get (port_id);
+
+    if (p_port_info == NULL) {
+        /* Maps bound to the switch or a LAG have no virtual port */
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (map_set && (map_id != SAI_NULL_OBJECT_ID)) {
+        p_map = sai_qos_map_node_get (map_id);
+
+        if (p_map == NULL) {
+            SAI_MAPS_LOG_ERR ("Map 0x%"PRIx64" not found", map_id);
+            return SAI_STATUS_INVALID_OBJECT_ID;
+        }
+        p_map_list = &p_map->map_to_value;
+    }
+
+    SAI_MAPS_LOG_TRACE ("Map 0x%"PRIx64" type %d %s port 0x%"PRIx64"",
+                        map_id, map_type, (p_map_list != NULL) ? "set on" : "cleared on",
+                        port_id);
+
+    return sai_vm_vport_qos_map_set (p_port_info->phy_port_id, map_type, map_id,
+                                     (p_map != NULL) ? p_map->generation : 0,
+                                     p_map_list);
+}
+
+static sai_status_t sai_vm_qos_port_map_delta_set(sai_object_id_t port_id,
+                                                  sai_object_id_t map_id,
+                                                  sai_qos_map_type_t map_type,
+                                                  const dn_sai_qos_map_delta_t *p_delta)
+{
+    sai_port_info_t *p_port_info = NULL;
+
+    STD_ASSERT (p_delta != NULL);
+
+    p_port_info = sai_port_info_get (port_id);
+
+    if (p_port_info == NULL) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    SAI_MAPS_LOG_TRACE ("Map 0x%"PRIx64" type %d generation %"PRIu64" %u entries "
+                        "updated on port 0x%"PRIx64"", map_id, map_type,
+                        p_delta->generation, p_delta->count, port_id);
+
+    return sai_vm_vport_qos_map_update (p_port_info->phy_port_id, map_type, map_id,
+                                        p_delta->generation, p_delta->index_list,
+                                        p_delta->entry_list, p_delta->count);
 }
 
 static bool sai_vm_qos_is_map_type_supported(sai_qos_map_type_t map_type)
@@ -200,7 +251,8 @@ static sai_npu_qos_map_api_t sai_vm_qos_map_api_table = {
     sai_vm_qos_port_map_set,
     sai_vm_qos_map_is_hw_object,
     sai_vm_qos_is_map_type_supported,
-    sai_vm_qos_maps_attr_table_get
+    sai_vm_qos_maps_attr_table_get,
+    sai_vm_qos_port_map_delta_set
 };
 
 sai_npu_qos_map_api_t* sai_vm_qos_map_api_query (void)
@@ -0,0 +1,486 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_vm_qos_stats.c
+ *
+ * @brief This file contains the tc statistics poller backing the queue,
+ *        buffer pool and priority group counters in VM Environment.
+ *
+ *        A single RTM_GETQDISC dump per poll interval returns the root,
+ *        per queue leaf and ingress qdiscs of every virtual port device.
+ *        The replies are kept in a snapshot sorted by (ifindex, parent)
+ *        and all the stats getters are served from it, so the number of
+ *        kernel round trips does not depend on the number of queues read.
+ */
+
+#include "sai_vm_qos.h"
+#include "sai_vm_rtnl.h"
+#include "sai_vm_vport.h"
+#include "sai_qos_util.h"
+#include "sai_port_utils.h"
+
+#include "saistatus.h"
+#include "saitypes.h"
+#include "std_assert.h"
+#include "std_mutex_lock.h"
+#include "std_thread_tools.h"
+#include "std_file_utils.h"
+
+#include <sys/socket.h>
+#include <linux/gen_stats.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Initial number of snapshot entries allocated by the poller */
+#define SAI_VM_QOS_TC_SNAPSHOT_CHUNK  (256)
+
+/* Lowest accepted poll interval in milliseconds */
+#define SAI_VM_QOS_STATS_POLL_INTERVAL_MIN  (100)
+
+typedef struct _sai_vm_qos_tc_entry_t {
+    int       if_index;
+    uint32_t  parent;
+    /** Counters as last read from the kernel */
+    uint64_t  raw [SAI_VM_QOS_TC_STAT_MAX];
+    /** Counter values at the time of the last clear */
+    uint64_t  base [SAI_VM_QOS_TC_STAT_MAX];
+} sai_vm_qos_tc_entry_t;
+
+typedef struct _sai_vm_qos_tc_snapshot_t {
+    sai_vm_qos_tc_entry_t *entries;
+    uint_t                 count;
+    uint_t                 size;
+    uint64_t               egr_backlog;
+    uint64_t               ing_backlog;
+    uint64_t               egr_watermark;
+    uint64_t               ing_watermark;
+} sai_vm_qos_tc_snapshot_t;
+
+static std_mutex_lock_create_static_init_fast(sai_vm_qos_stats_lock);
+static sai_vm_qos_tc_snapshot_t sai_vm_qos_tc_snapshot;
+static uint_t sai_vm_qos_stats_interval_ms = SAI_VM_QOS_STATS_POLL_INTERVAL_DFLT;
+static std_thread_create_param_t sai_vm_qos_stats_thread;
+
+/* Counters that keep growing and are cleared by moving the base */
+static inline bool sai_vm_qos_tc_stat_is_counter (uint_t stat)
+{
+    return ((stat == SAI_VM_QOS_TC_STAT_PACKETS) ||
+            (stat == SAI_VM_QOS_TC_STAT_BYTES) ||
+            (stat == SAI_VM_QOS_TC_STAT_DROPS) ||
+            (stat == SAI_VM_QOS_TC_STAT_OVERLIMITS));
+}
+
+static inline bool sai_vm_qos_tc_parent_is_ingress (uint32_t parent)
+{
+    return (parent == TC_H_INGRESS);
+}
+
+static int sai_vm_qos_tc_entry_cmp (const void *a, const void *b)
+{
+    const sai_vm_qos_tc_entry_t *p_a = (const sai_vm_qos_tc_entry_t *) a;
+    const sai_vm_qos_tc_entry_t *p_b = (const sai_vm_qos_tc_entry_t *) b;
+
+    if (p_a->if_index != p_b->if_index) {
+        return (p_a->if_index < p_b->if_index) ? -1 : 1;
+    }
+    if (p_a->parent != p_b->parent) {
+        return (p_a->parent < p_b->parent) ? -1 : 1;
+    }
+    return 0;
+}
+
+static sai_vm_qos_tc_entry_t *sai_vm_qos_tc_entry_find (
+                                    const sai_vm_qos_tc_snapshot_t *p_snap,
+                                    int if_index, uint32_t parent)
+{
+    sai_vm_qos_tc_entry_t key;
+
+    if (p_snap->count == 0) {
+        return NULL;
+    }
+
+    key.if_index = if_index;
+    key.parent = parent;
+
+    return (sai_vm_qos_tc_entry_t *) bsearch (&key, p_snap->entries,
+                                              p_snap->count,
+                                              sizeof (sai_vm_qos_tc_entry_t),
+                                              sai_vm_qos_tc_entry_cmp);
+}
+
+static void sai_vm_qos_tc_stats2_parse (struct rtattr *stats2,
+                                        sai_vm_qos_tc_entry_t *p_entry)
+{
+    struct rtattr *tb [TCA_STATS_MAX + 1];
+
+    sai_vm_rtnl_attr_parse (tb, TCA_STATS_MAX, RTA_DATA (stats2),
+                            RTA_PAYLOAD (stats2));
+
+    if ((tb [TCA_STATS_BASIC] != NULL) &&
+        (RTA_PAYLOAD (tb [TCA_STATS_BASIC]) >= sizeof (struct gnet_stats_basic))) {
+        struct gnet_stats_basic basic;
+
+        memcpy (&basic, RTA_DATA (tb [TCA_STATS_BASIC]), sizeof (basic));
+        p_entry->raw [SAI_VM_QOS_TC_STAT_BYTES] = basic.bytes;
+        p_entry->raw [SAI_VM_QOS_TC_STAT_PACKETS] = basic.packets;
+    }
+
+    if ((tb [TCA_STATS_QUEUE] != NULL) &&
+        (RTA_PAYLOAD (tb [TCA_STATS_QUEUE]) >= sizeof (struct gnet_stats_queue))) {
+        struct gnet_stats_queue queue;
+
+        memcpy (&queue, RTA_DATA (tb [TCA_STATS_QUEUE]), sizeof (queue));
+        p_entry->raw [SAI_VM_QOS_TC_STAT_DROPS] = queue.drops;
+        p_entry->raw [SAI_VM_QOS_TC_STAT_OVERLIMITS] = queue.overlimits;
+        p_entry->raw [SAI_VM_QOS_TC_STAT_BACKLOG] = queue.backlog;
+        p_entry->raw [SAI_VM_QOS_TC_STAT_QLEN] = queue.qlen;
+    }
+}
+
+static void sai_vm_qos_tc_stats_parse (struct rtattr *stats,
+                                       sai_vm_qos_tc_entry_t *p_entry)
+{
+    struct tc_stats legacy;
+
+    if (RTA_PAYLOAD (stats) < sizeof (legacy)) {
+        return;
+    }
+
+    memcpy (&legacy, RTA_DATA (stats), sizeof (legacy));
+    p_entry->raw [SAI_VM_QOS_TC_STAT_BYTES] = legacy.bytes;
+    p_entry->raw [SAI_VM_QOS_TC_STAT_PACKETS] = legacy.packets;
+    p_entry->raw [SAI_VM_QOS_TC_STAT_DROPS] = legacy.drops;
+    p_entry->raw [SAI_VM_QOS_TC_STAT_OVERLIMITS] = legacy.overlimits;
+    p_entry->raw [SAI_VM_QOS_TC_STAT_BACKLOG] = legacy.backlog;
+    p_entry->raw [SAI_VM_QOS_TC_STAT_QLEN] = legacy.qlen;
+}
+
+/* Dump callback, appends one snapshot entry per qdisc */
+static void sai_vm_qos_tc_qdisc_msg_handler (struct nlmsghdr *hdr, void *ctx)
+{
+    sai_vm_qos_tc_snapshot_t *p_snap = (sai_vm_qos_tc_snapshot_t *) ctx;
+    struct tcmsg             *tcm = NLMSG_DATA (hdr);
+    struct rtattr            *tb [TCA_MAX + 1];
+    sai_vm_qos_tc_entry_t    *p_entry = NULL;
+    int                       len = hdr->nlmsg_len - NLMSG_LENGTH (sizeof (*tcm));
+
+    if ((hdr->nlmsg_type != RTM_NEWQDISC) || (len < 0)) {
+        return;
+    }
+
+    if (p_snap->count == p_snap->size) {
+        uint_t new_size = p_snap->size + SAI_VM_QOS_TC_SNAPSHOT_CHUNK;
+        sai_vm_qos_tc_entry_t *p_new =
+            realloc (p_snap->entries, new_size * sizeof (sai_vm_qos_tc_entry_t));
+
+        if (p_new == NULL) {
+            SAI_QOS_LOG_ERR ("Failed to grow tc stats snapshot to %u entries",
+                             new_size);
+            return;
+        }
+        p_snap->entries = p_new;
+        p_snap->size = new_size;
+    }
+
+    p_entry = &p_snap->entries [p_snap->count];
+    memset (p_entry, 0, sizeof (*p_entry));
+    p_entry->if_index = tcm->tcm_ifindex;
+    p_entry->parent = tcm->tcm_parent;
+
+    sai_vm_rtnl_attr_parse (tb, TCA_MAX, TCA_RTA (tcm), len);
+
+    if (tb [TCA_STATS2] != NULL) {
+        sai_vm_qos_tc_stats2_parse (tb [TCA_STATS2], p_entry);
+    } else if (tb [TCA_STATS] != NULL) {
+        sai_vm_qos_tc_stats_parse (tb [TCA_STATS], p_entry);
+    }
+
+    p_snap->count++;
+}
+
+/*
+ * Sum the backlog of the sorted snapshot into the pool occupancy. Leaf
+ * qdiscs of the port queues make up the egress pool; the root qdisc is only
+ * counted for single queue devices, as it already includes its leaves.
+ */
+static void sai_vm_qos_tc_snapshot_backlog_sum (sai_vm_qos_tc_snapshot_t *p_snap)
+{
+    uint_t   idx = 0;
+    int      if_index = 0;
+    uint64_t root_backlog = 0;
+    uint64_t leaf_backlog = 0;
+    bool     has_leaf = false;
+
+    for (idx = 0; idx <= p_snap->count; idx++) {
+        const sai_vm_qos_tc_entry_t *p_entry =
+            (idx < p_snap->count) ? &p_snap->entries [idx] : NULL;
+
+        if ((idx > 0) && ((p_entry == NULL) || (p_entry->if_index != if_index))) {
+            p_snap->egr_backlog += has_leaf ? leaf_backlog : root_backlog;
+            root_backlog = 0;
+            leaf_backlog = 0;
+            has_leaf = false;
+        }
+
+        if (p_entry == NULL) {
+            break;
+        }
+
+        if_index = p_entry->if_index;
+
+        if (sai_vm_qos_tc_parent_is_ingress (p_entry->parent)) {
+            p_snap->ing_backlog += p_entry->raw [SAI_VM_QOS_TC_STAT_BACKLOG];
+        } else if (p_entry->parent == TC_H_ROOT) {
+            root_backlog = p_entry->raw [SAI_VM_QOS_TC_STAT_BACKLOG];
+        } else if (TC_H_MAJ (p_entry->parent) ==
+                   (SAI_VM_QOS_TC_ROOT_MAJOR << 16)) {
+            leaf_backlog += p_entry->raw [SAI_VM_QOS_TC_STAT_BACKLOG];
+            has_leaf = true;
+        }
+    }
+}
+
+/*
+ * Carry the clear bases and watermarks of the published snapshot over to the
+ * new one. Both are sorted by the same key, so a single merge pass suffices.
+ * Called with the stats lock held.
+ */
+static void sai_vm_qos_tc_snapshot_merge (const sai_vm_qos_tc_snapshot_t *p_old,
+                                          sai_vm_qos_tc_snapshot_t *p_new)
+{
+    uint_t old_idx = 0;
+    uint_t new_idx = 0;
+    uint_t stat = 0;
+
+    while ((old_idx < p_old->count) && (new_idx < p_new->count)) {
+        const sai_vm_qos_tc_entry_t *p_o = &p_old->entries [old_idx];
+        sai_vm_qos_tc_entry_t       *p_n = &p_new->entries [new_idx];
+        int cmp = sai_vm_qos_tc_entry_cmp (p_o, p_n);
+
+        if (cmp < 0) {
+            old_idx++;
+            continue;
+        }
+
+        if (cmp == 0) {
+            for (stat = 0; stat < SAI_VM_QOS_TC_STAT_MAX; stat++) {
+                if (sai_vm_qos_tc_stat_is_counter (stat) &&
+                    (p_n->raw [stat] >= p_o->base [stat])) {
+                    /* A smaller raw value means the qdisc was replaced
+                     * and its counters restarted from zero. */
+                    p_n->base [stat] = p_o->base [stat];
+                }
+            }
+            if (p_o->raw [SAI_VM_QOS_TC_STAT_WATERMARK] >
+                p_n->raw [SAI_VM_QOS_TC_STAT_WATERMARK]) {
+                p_n->raw [SAI_VM_QOS_TC_STAT_WATERMARK] =
+                    p_o->raw [SAI_VM_QOS_TC_STAT_WATERMARK];
+            }
+            old_idx++;
+        }
+        new_idx++;
+    }
+
+    p_new->egr_watermark = (p_old->egr_watermark > p_new->egr_backlog) ?
+        p_old->egr_watermark : p_new->egr_backlog;
+    p_new->ing_watermark = (p_old->ing_watermark > p_new->ing_backlog) ?
+        p_old->ing_watermark : p_new->ing_backlog;
+}
+
+static void sai_vm_qos_tc_snapshot_poll (int sock)
+{
+    sai_vm_qos_tc_snapshot_t new_snap;
+    uint_t                   idx = 0;
+    struct {
+        struct nlmsghdr hdr;
+        struct tcmsg    tcm;
+    } req;
+
+    memset (&new_snap, 0, sizeof (new_snap));
+    memset (&req, 0, sizeof (req));
+
+    req.hdr.nlmsg_len = NLMSG_LENGTH (sizeof (struct tcmsg));
+    req.hdr.nlmsg_type = RTM_GETQDISC;
+    req.tcm.tcm_family = AF_UNSPEC;
+
+    if (sai_vm_rtnl_dump (sock, &req.hdr, sai_vm_qos_tc_qdisc_msg_handler,
+                          &new_snap) != SAI_STATUS_SUCCESS) {
+        /* Keep serving the previous snapshot */
+        free (new_snap.entries);
+        return;
+    }
+
+    qsort (new_snap.entries, new_snap.count, sizeof (sai_vm_qos_tc_entry_t),
+           sai_vm_qos_tc_entry_cmp);
+
+    for (idx = 0; idx < new_snap.count; idx++) {
+        new_snap.entries [idx].raw [SAI_VM_QOS_TC_STAT_WATERMARK] =
+            new_snap.entries [idx].raw [SAI_VM_QOS_TC_STAT_BACKLOG];
+    }
+
+    sai_vm_qos_tc_snapshot_backlog_sum (&new_snap);
+
+    std_mutex_lock (&sai_vm_qos_stats_lock);
+
+    sai_vm_qos_tc_snapshot_merge (&sai_vm_qos_tc_snapshot, &new_snap);
+    free (sai_vm_qos_tc_snapshot.entries);
+    sai_vm_qos_tc_snapshot = new_snap;
+
+    std_mutex_unlock (&sai_vm_qos_stats_lock);
+}
+
+static void *sai_vm_qos_stats_thread_func (void *param)
+{
+    int sock = STD_INVALID_FD;
+
+    while (true) {
+        if (sock == STD_INVALID_FD) {
+            sock = sai_vm_rtnl_open (0);
+        }
+
+        if (sock != STD_INVALID_FD) {
+            sai_vm_qos_tc_snapshot_poll (sock);
+        }
+
+        usleep (sai_vm_qos_stats_interval_ms * 1000);
+    }
+
+    return NULL;
+}
+
+sai_status_t sai_vm_qos_stats_init (void)
+{
+    std_thread_init_struct (&sai_vm_qos_stats_thread);
+    sai_vm_qos_stats_thread.name = "sai-vm-qos-stats";
+    sai_vm_qos_stats_thread.thread_function =
+        (std_thread_function_t) sai_vm_qos_stats_thread_func;
+
+    if (std_thread_create (&sai_vm_qos_stats_thread) != STD_ERR_OK) {
+        SAI_QOS_LOG_ERR ("Failed to create tc stats poller thread");
+        return SAI_STATUS_FAILURE;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_vm_qos_stats_poll_interval_set (uint_t interval_ms)
+{
+    if (interval_ms == 0) {
+        interval_ms = SAI_VM_QOS_STATS_POLL_INTERVAL_DFLT;
+    } else if (interval_ms < SAI_VM_QOS_STATS_POLL_INTERVAL_MIN) {
+        interval_ms = SAI_VM_QOS_STATS_POLL_INTERVAL_MIN;
+    }
+
+    sai_vm_qos_stats_interval_ms = interval_ms;
+}
+
+sai_status_t sai_vm_qos_port_if_index_get (sai_object_id_t port_id,
+                                           int *if_index)
+{
+    sai_port_info_t *p_port_info = NULL;
+    vport_desc_t    *p_desc = NULL;
+
+    STD_ASSERT (if_index != NULL);
+
+    p_port_info = sai_port_info_get (port_id);
+    if (p_port_info == NULL) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    p_desc = sai_vm_vport_get_desc (p_port_info->phy_port_id);
+    if (p_desc == NULL) {
+        /* Not an error - the VM may have fewer adapters than ports */
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    *if_index = p_desc->if_index;
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_vm_qos_tc_stats_get (int if_index, uint32_t parent,
+                                      uint64_t *stats)
+{
+    sai_vm_qos_tc_entry_t *p_entry = NULL;
+    uint_t                 stat = 0;
+
+    STD_ASSERT (stats != NULL);
+
+    std_mutex_lock (&sai_vm_qos_stats_lock);
+
+    p_entry = sai_vm_qos_tc_entry_find (&sai_vm_qos_tc_snapshot, if_index,
+                                        parent);
+    if (p_entry != NULL) {
+        for (stat = 0; stat < SAI_VM_QOS_TC_STAT_MAX; stat++) {
+            stats [stat] = p_entry->raw [stat] - p_entry->base [stat];
+        }
+    }
+
+    std_mutex_unlock (&sai_vm_qos_stats_lock);
+
+    return (p_entry != NULL) ? SAI_STATUS_SUCCESS : SAI_STATUS_ITEM_NOT_FOUND;
+}
+
+sai_status_t sai_vm_qos_tc_stats_clear (int if_index, uint32_t parent,
+                                        const sai_vm_qos_tc_stat_t *stat_ids,
+                                        uint_t count)
+{
+    sai_vm_qos_tc_entry_t *p_entry = NULL;
+    uint_t                 idx = 0;
+
+    STD_ASSERT (stat_ids != NULL);
+
+    std_mutex_lock (&sai_vm_qos_stats_lock);
+
+    p_entry = sai_vm_qos_tc_entry_find (&sai_vm_qos_tc_snapshot, if_index,
+                                        parent);
+    if (p_entry != NULL) {
+        for (idx = 0; idx < count; idx++) {
+            sai_vm_qos_tc_stat_t stat = stat_ids [idx];
+
+            if (sai_vm_qos_tc_stat_is_counter (stat)) {
+                p_entry->base [stat] = p_entry->raw [stat];
+            } else if (stat == SAI_VM_QOS_TC_STAT_WATERMARK) {
+                p_entry->raw [stat] = p_entry->raw [SAI_VM_QOS_TC_STAT_BACKLOG];
+            }
+        }
+    }
+
+    std_mutex_unlock (&sai_vm_qos_stats_lock);
+
+    return (p_entry != NULL) ? SAI_STATUS_SUCCESS : SAI_STATUS_ITEM_NOT_FOUND;
+}
+
+void sai_vm_qos_tc_pool_stats_get (sai_buffer_pool_type_t pool_type,
+                                   uint64_t *curr_bytes,
+                                   uint64_t *watermark_bytes)
+{
+    STD_ASSERT (curr_bytes != NULL);
+    STD_ASSERT (watermark_bytes != NULL);
+
+    std_mutex_lock (&sai_vm_qos_stats_lock);
+
+    if (pool_type == SAI_BUFFER_POOL_TYPE_INGRESS) {
+        *curr_bytes = sai_vm_qos_tc_snapshot.ing_backlog;
+        *watermark_bytes = sai_vm_qos_tc_snapshot.ing_watermark;
+    } else {
+        *curr_bytes = sai_vm_qos_tc_snapshot.egr_backlog;
+        *watermark_bytes = sai_vm_qos_tc_snapshot.egr_watermark;
+    }
+
+    std_mutex_unlock (&sai_vm_qos_stats_lock);
+}
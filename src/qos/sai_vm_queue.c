@@ -32,6 +32,7 @@
 #include "sai_qos_util.h"
 
 #include <inttypes.h>
+#include <string.h>
 
 /**
  * Vendor attribute array for queue containing the attribute
@@ -372,11 +373,102 @@ static sai_status_t sai_vm_queue_attribute_get (dn_sai_qos_queue_t *p_queue_node
     return sai_rc;
 }
 
+/* Map a SAI queue counter to the tc counter of the queue leaf qdisc */
+static sai_status_t sai_vm_queue_stat_to_tc_stat (sai_queue_stat_t counter_id,
+                                                  sai_vm_qos_tc_stat_t *tc_stat)
+{
+    switch (counter_id)
+    {
+        case SAI_QUEUE_STAT_PACKETS:
+            *tc_stat = SAI_VM_QOS_TC_STAT_PACKETS;
+            break;
+
+        case SAI_QUEUE_STAT_BYTES:
+            *tc_stat = SAI_VM_QOS_TC_STAT_BYTES;
+            break;
+
+        case SAI_QUEUE_STAT_DROPPED_PACKETS:
+            *tc_stat = SAI_VM_QOS_TC_STAT_DROPS;
+            break;
+
+        case SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES:
+        case SAI_QUEUE_STAT_SHARED_CURR_OCCUPANCY_BYTES:
+            *tc_stat = SAI_VM_QOS_TC_STAT_BACKLOG;
+            break;
+
+        case SAI_QUEUE_STAT_WATERMARK_BYTES:
+        case SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES:
+            *tc_stat = SAI_VM_QOS_TC_STAT_WATERMARK;
+            break;
+
+        default:
+            /* tc does not account dropped bytes or per color counters */
+            return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Locate the qdisc backing the queue in the tc stats snapshot. The first
+ * queue of a single queue device is served by the root qdisc.
+ */
+static sai_status_t sai_vm_queue_tc_key_get (const dn_sai_qos_queue_t *p_queue_node,
+                                             int *if_index, uint32_t *parent)
+{
+    uint64_t     stats [SAI_VM_QOS_TC_STAT_MAX];
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    sai_rc = sai_vm_qos_port_if_index_get (p_queue_node->port_id, if_index);
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        return sai_rc;
+    }
+
+    *parent = SAI_VM_QOS_QUEUE_CLASSID (p_queue_node->queue_index);
+
+    if ((p_queue_node->queue_index == 0) &&
+        (sai_vm_qos_tc_stats_get (*if_index, *parent, stats) != SAI_STATUS_SUCCESS)) {
+        *parent = TC_H_ROOT;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
 static sai_status_t sai_vm_queue_stats_get (dn_sai_qos_queue_t *p_queue_node,
                                             const sai_queue_stat_t *counter_ids,
                                             uint_t number_of_counters, uint64_t* counters)
 {
-    /* TODO */
+    sai_status_t         sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_qos_tc_stat_t tc_stat = SAI_VM_QOS_TC_STAT_PACKETS;
+    uint64_t             stats [SAI_VM_QOS_TC_STAT_MAX];
+    int                  if_index = 0;
+    uint32_t             parent = 0;
+    uint_t               list_index = 0;
+
+    STD_ASSERT (p_queue_node != NULL);
+    STD_ASSERT (counter_ids != NULL);
+    STD_ASSERT (counters != NULL);
+
+    memset (stats, 0, sizeof (stats));
+
+    /* Queues without a kernel qdisc (yet) read as zero */
+    if (sai_vm_queue_tc_key_get (p_queue_node, &if_index, &parent)
+        == SAI_STATUS_SUCCESS) {
+        sai_vm_qos_tc_stats_get (if_index, parent, stats);
+    }
+
+    for (list_index = 0; list_index < number_of_counters; list_index++) {
+        sai_rc = sai_vm_queue_stat_to_tc_stat (counter_ids [list_index], &tc_stat);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_QUEUE_LOG_TRACE ("Queue counter %d not supported",
+                                 counter_ids [list_index]);
+            return sai_rc;
+        }
+
+        counters [list_index] = stats [tc_stat];
+    }
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -384,9 +476,34 @@ static sai_status_t sai_vm_queue_stats_clear (dn_sai_qos_queue_t *p_queue_node,
                                             const sai_queue_stat_t *counter_ids,
                                             uint_t number_of_counters)
 {
-    /* TODO */
+    sai_status_t         sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_qos_tc_stat_t tc_stat = SAI_VM_QOS_TC_STAT_PACKETS;
+    int                  if_index = 0;
+    uint32_t             parent = 0;
+    bool                 has_qdisc = false;
+    uint_t               list_index = 0;
+
+    STD_ASSERT (p_queue_node != NULL);
+    STD_ASSERT (counter_ids != NULL);
+
+    has_qdisc = (sai_vm_queue_tc_key_get (p_queue_node, &if_index, &parent)
+                 == SAI_STATUS_SUCCESS);
+
+    for (list_index = 0; list_index < number_of_counters; list_index++) {
+        sai_rc = sai_vm_queue_stat_to_tc_stat (counter_ids [list_index], &tc_stat);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            return sai_rc;
+        }
+
+        if (has_qdisc) {
+            sai_vm_qos_tc_stats_clear (if_index, parent, &tc_stat, 1);
+        }
+    }
+
     return SAI_STATUS_SUCCESS;
 }
+
 static sai_npu_queue_api_t sai_vm_queue_api_table = {
     sai_vm_queue_create,
     sai_vm_queue_remove,
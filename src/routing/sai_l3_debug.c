@@ -29,11 +29,27 @@
 #include "std_mac_utils.h"
 #include "std_struct_utils.h"
 #include <arpa/inet.h>
+#include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
 
 #define SAI_FIB_DBG_MAX_BUFSZ  (256)
 
+/* Routes walked per hold of the FIB lock by the route dump */
+#define SAI_FIB_DBG_ROUTE_DUMP_CHUNK (256)
+
+/* Route fields copied under the FIB lock, printed with the lock released */
+typedef struct _sai_fib_route_dump_rec_t {
+    const sai_fib_route_t *p_route;
+    sai_fib_route_key_t    key;
+    uint_t                 prefix_len;
+    sai_object_id_t        vrf_id;
+    uint_t                 nh_type;
+    sai_object_id_t        nh_id;
+    sai_packet_action_t    packet_action;
+    uint_t                 trap_priority;
+} sai_fib_route_dump_rec_t;
+
 static inline uint_t sai_fib_addr_family_bitlen (void)
 {
     return ((STD_STR_SIZE_OF(sai_ip_address_t, addr_family)) * BITS_PER_BYTE);
@@ -59,6 +75,10 @@ void sai_fib_dump_help (void)
     SAI_DEBUG ("  void sai_fib_dump_route_entry (sai_object_id_t vrf, ");
     SAI_DEBUG ("       int af, char *ip_str, uint_t prefix_len)");
     SAI_DEBUG ("  void sai_fib_dump_all_route_in_vr (sai_object_id_t vr_id)");
+    SAI_DEBUG ("  void sai_fib_dump_route_page_in_vr (sai_object_id_t vr_id, ");
+    SAI_DEBUG ("       sai_object_id_t nh_id, uint_t start, uint_t count)");
+    SAI_DEBUG ("  void sai_fib_dump_lpm_lookup (sai_object_id_t vrf, ");
+    SAI_DEBUG ("       int af, char *ip_str)");
     SAI_DEBUG ("  void sai_fib_dump_neighbor_mac_entry_tree (void)");
     SAI_DEBUG ("  void sai_fib_dump_dep_encap_nh_list_for_route (");
     SAI_DEBUG ("  sai_object_id_t vr, int af, char *ip_str, uint_t prefix_len)");
@@ -216,24 +236,44 @@ void sai_fib_dump_all_rif (void)
     }
 }
 
-void sai_fib_dump_route_node (sai_fib_route_t *p_route)
+static void sai_fib_route_dump_rec_fill (sai_fib_route_dump_rec_t *p_rec,
+                                         sai_fib_route_t *p_route)
+{
+    p_rec->p_route = p_route;
+    memcpy (&p_rec->key, &p_route->key, sizeof (sai_fib_route_key_t));
+    p_rec->prefix_len = p_route->prefix_len;
+    p_rec->vrf_id = p_route->vrf_id;
+    p_rec->nh_type = p_route->nh_type;
+    p_rec->nh_id = sai_fib_route_node_nh_id_get (p_route);
+    p_rec->packet_action = p_route->packet_action;
+    p_rec->trap_priority = p_route->trap_priority;
+}
+
+static void sai_fib_dump_route_rec (const sai_fib_route_dump_rec_t *p_rec)
 {
     char addr_str [SAI_FIB_DBG_MAX_BUFSZ];
 
+    SAI_DEBUG ("************ Dumping Route information *************");
+    SAI_DEBUG ("%p, IP Prefix: %s/%d, VRF: 0x%"PRIx64", NH obj Type: %s, "
+               "NH Obj Id: 0x%"PRIx64", Packet-action: %s, Trap Prio: %d.",
+               p_rec->p_route, sai_ip_addr_to_str (&p_rec->key.prefix, addr_str,
+               SAI_FIB_DBG_MAX_BUFSZ), p_rec->prefix_len, p_rec->vrf_id,
+               sai_fib_route_nh_type_to_str (p_rec->nh_type), p_rec->nh_id,
+               sai_packet_action_str (p_rec->packet_action),
+               p_rec->trap_priority);
+}
+
+void sai_fib_dump_route_node (sai_fib_route_t *p_route)
+{
+    sai_fib_route_dump_rec_t rec;
+
     if (p_route == NULL) {
         SAI_DEBUG ("Route node is NULL.");
         return;
     }
 
-    SAI_DEBUG ("************ Dumping Route information *************");
-    SAI_DEBUG ("%p, IP Prefix: %s/%d, VRF: 0x%"PRIx64", NH obj Type: %s, "
-               "NH Obj Id: 0x%"PRIx64", Packet-action: %s, Trap Prio: %d.",
-               p_route, sai_ip_addr_to_str (&p_route->key.prefix, addr_str,
-               SAI_FIB_DBG_MAX_BUFSZ), p_route->prefix_len, p_route->vrf_id,
-               sai_fib_route_nh_type_to_str (p_route->nh_type),
-               sai_fib_route_node_nh_id_get (p_route),
-               sai_packet_action_str (p_route->packet_action),
-               p_route->trap_priority);
+    sai_fib_route_dump_rec_fill (&rec, p_route);
+    sai_fib_dump_route_rec (&rec);
 }
 
 void sai_fib_dump_route_entry (sai_object_id_t vrf, int af_family, char *ip_str,
@@ -287,52 +327,179 @@ void sai_fib_dump_route_entry (sai_object_id_t vrf, int af_family, char *ip_str,
     sai_fib_dump_route_node (p_route);
 }
 
-void sai_fib_dump_all_route_in_vr (sai_object_id_t vrf)
+void sai_fib_dump_lpm_lookup (sai_object_id_t vrf, int af_family, char *ip_str)
 {
-    sai_fib_route_key_t  route_node_key;
+    sai_fib_route_key_t  key;
     sai_fib_vrf_t       *p_vrf_node = NULL;
     sai_fib_route_t     *p_route = NULL;
-    uint_t               key_len = 0;
-    unsigned int         count = 0;
+    sai_fib_lpm_nh_t     lpm_nh;
+    sai_fib_lpm_stats_t  lpm_stats;
+
+    memset (&key, 0, sizeof (sai_fib_route_key_t));
 
     p_vrf_node = sai_fib_vrf_node_get (vrf);
 
-    if (p_vrf_node == NULL) {
+    if ((p_vrf_node == NULL) || (p_vrf_node->route_lpm == NULL)) {
         SAI_DEBUG ("VR node does not exist with VRF ID 0x%"PRIx64".",
                    vrf);
         return;
     }
 
-    memset (&route_node_key, 0, sizeof (sai_fib_route_key_t));
+    if (af_family == AF_INET) {
+        key.prefix.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
 
-    key_len  =  sai_fib_addr_family_bitlen();
+        inet_pton (AF_INET, (const char *)ip_str,
+                   (void *)&key.prefix.addr.ip4);
+    } else if (af_family == AF_INET6) {
+        key.prefix.addr_family = SAI_IP_ADDR_FAMILY_IPV6;
 
-    p_route =
-        (sai_fib_route_t *) std_radix_getexact (p_vrf_node->sai_route_tree,
-                                                (uint8_t *)&route_node_key,
-                                                 key_len);
+        inet_pton (AF_INET6, (const char *)ip_str,
+                   (void *)&key.prefix.addr.ip6);
+    } else {
+        SAI_DEBUG ("af_family must be AF_INET or AF_INET6. af_family %d is not valid.",
+                   af_family);
 
-    if (p_route == NULL) {
-        p_route =
-            (sai_fib_route_t *) std_radix_getnext (p_vrf_node->sai_route_tree,
-                                                   (uint8_t *)&route_node_key,
-                                                   key_len);
+        return;
     }
 
+    if (sai_fib_lpm_lookup (p_vrf_node->route_lpm, &key.prefix, &lpm_nh)) {
+        SAI_DEBUG ("LPM lookup of %s in VRF 0x%"PRIx64": prefix len: %d, "
+                   "NH obj Type: %s, NH Obj Id: 0x%"PRIx64", Packet-action: %s.",
+                   ip_str, vrf, lpm_nh.prefix_len,
+                   sai_fib_route_nh_type_to_str (lpm_nh.nh_type), lpm_nh.nh_id,
+                   sai_packet_action_str (lpm_nh.packet_action));
+    } else {
+        SAI_DEBUG ("LPM lookup of %s in VRF 0x%"PRIx64": no route.", ip_str, vrf);
+    }
+
+    /* Cross check against the route tree */
+    p_route = (sai_fib_route_t *)
+        std_radix_getbest (p_vrf_node->sai_route_tree, (uint8_t *)&key,
+                           sai_fib_addr_family_bitlen () +
+                           sai_fib_ip_addr_family_len_get (&key.prefix));
+
+    sai_fib_dump_route_node (p_route);
+
+    sai_fib_lpm_stats_get (p_vrf_node->route_lpm, &lpm_stats);
+
+    SAI_DEBUG ("LPM table: leaves: %d, IPv4 groups: %d, IPv6 groups: %d, "
+               "memory: %lu bytes.", lpm_stats.leaf_count,
+               lpm_stats.ipv4_group_count, lpm_stats.ipv6_group_count,
+               (unsigned long) lpm_stats.mem_bytes);
+}
+
+/*
+ * The routes are walked in chunks under short holds of the FIB read lock,
+ * each hold resuming from the key of the last route walked, and the routes
+ * copied in a chunk are printed with the lock released so route programming
+ * is not held off for the whole dump.
+ */
+void sai_fib_dump_route_page_in_vr (sai_object_id_t vrf, sai_object_id_t nh_id,
+                                    uint_t start, uint_t count)
+{
+    sai_fib_route_dump_rec_t *p_chunk = NULL;
+    sai_fib_route_key_t       route_node_key;
+    sai_fib_vrf_t            *p_vrf_node = NULL;
+    sai_fib_route_t          *p_route = NULL;
+    uint_t                    key_len = 0;
+    uint_t                    chunk_len = 0;
+    uint_t                    walked = 0;
+    uint_t                    matched = 0;
+    uint_t                    dumped = 0;
+    uint_t                    idx = 0;
+    bool                      is_first = true;
+    bool                      is_end = false;
+
+    p_chunk = (sai_fib_route_dump_rec_t *)
+        calloc (SAI_FIB_DBG_ROUTE_DUMP_CHUNK, sizeof (sai_fib_route_dump_rec_t));
+
+    if (p_chunk == NULL) {
+        SAI_DEBUG ("Failed to allocate the route dump buffer.");
+        return;
+    }
+
+    memset (&route_node_key, 0, sizeof (sai_fib_route_key_t));
+
+    key_len  =  sai_fib_addr_family_bitlen();
+
     SAI_DEBUG ("******* Dumping all Route nodes *******");
-    while (p_route != NULL) {
-        SAI_DEBUG (" Route Node %d.", ++count);
-        sai_fib_dump_route_node (p_route);
+    while (!is_end) {
+        chunk_len = 0;
+        walked = 0;
+
+        sai_fib_read_lock ();
+
+        p_vrf_node = sai_fib_vrf_node_get (vrf);
+
+        if (p_vrf_node == NULL) {
+            sai_fib_read_unlock ();
+
+            SAI_DEBUG ("VR node does not exist with VRF ID 0x%"PRIx64".",
+                       vrf);
+            break;
+        }
+
+        p_route = NULL;
+
+        if (is_first) {
+            p_route =
+                (sai_fib_route_t *) std_radix_getexact (p_vrf_node->sai_route_tree,
+                                                        (uint8_t *)&route_node_key,
+                                                        key_len);
+            is_first = false;
+        }
+
+        if (p_route == NULL) {
+            p_route =
+                (sai_fib_route_t *) std_radix_getnext (p_vrf_node->sai_route_tree,
+                                                       (uint8_t *)&route_node_key,
+                                                       key_len);
+        }
 
-        memcpy (&route_node_key, &p_route->key, sizeof (sai_fib_route_key_t));
+        while ((p_route != NULL) && (walked < SAI_FIB_DBG_ROUTE_DUMP_CHUNK)) {
+            memcpy (&route_node_key, &p_route->key, sizeof (sai_fib_route_key_t));
+
+            key_len = sai_fib_addr_family_bitlen() + p_route->prefix_len;
+            walked++;
+
+            if ((nh_id == SAI_NULL_OBJECT_ID) ||
+                (sai_fib_route_node_nh_id_get (p_route) == nh_id)) {
+                if (matched >= start) {
+                    sai_fib_route_dump_rec_fill (&p_chunk [chunk_len], p_route);
+                    chunk_len++;
+                }
+                matched++;
+            }
+
+            if ((count != 0) && ((dumped + chunk_len) >= count)) {
+                is_end = true;
+                break;
+            }
+
+            p_route =
+                (sai_fib_route_t *) std_radix_getnext (p_vrf_node->sai_route_tree,
+                                                       (uint8_t *)&route_node_key,
+                                                       key_len);
+        }
 
-        key_len = sai_fib_addr_family_bitlen() + p_route->prefix_len;
+        if (p_route == NULL) {
+            is_end = true;
+        }
 
-        p_route =
-            (sai_fib_route_t *) std_radix_getnext (p_vrf_node->sai_route_tree,
-                                                   (uint8_t *)&route_node_key,
-                                                   key_len);
+        sai_fib_read_unlock ();
+
+        for (idx = 0; idx < chunk_len; idx++) {
+            SAI_DEBUG (" Route Node %d.", start + (++dumped));
+            sai_fib_dump_route_rec (&p_chunk [idx]);
+        }
     }
+
+    free (p_chunk);
+}
+
+void sai_fib_dump_all_route_in_vr (sai_object_id_t vrf)
+{
+    sai_fib_dump_route_page_in_vr (vrf, SAI_NULL_OBJECT_ID, 0, 0);
 }
 
 void sai_fib_dump_ip_nh_node (sai_fib_nh_t *p_next_hop)
@@ -33,6 +33,7 @@
 #include "std_thread_tools.h"
 #include <inttypes.h>
 #include <string.h>
+#include <stdlib.h>
 
 static std_thread_create_param_t thread;
 static int sai_fib_encap_nh_route_walker_fd [SAI_FIB_MAX_FD];
@@ -905,6 +906,101 @@ void sai_fib_neighbor_affected_encap_nh_resolve (sai_fib_nh_t *p_neighbor,
     }
 }
 
+static int sai_fib_neighbor_dep_key_cmp (const void *p_key_1,
+                                         const void *p_key_2)
+{
+    return (memcmp (p_key_1, p_key_2, sizeof (sai_fib_neighbor_dep_key_t)));
+}
+
+/*
+ * Encap Next Hop resolution for a batch of underlay neighbor create/remove.
+ * Each encap next hop on the neighbor IP addresses is resolved once, against
+ * the neighbors left after the whole batch, and the dependent route walk is
+ * signalled once.
+ */
+void sai_fib_neighbor_list_affected_encap_nh_resolve (
+                                      sai_fib_neighbor_dep_key_t *p_key_list,
+                                      uint_t key_count)
+{
+    sai_fib_nh_t      *p_encap_nh;
+    sai_fib_nh_t      *p_neighbor;
+    sai_fib_vrf_t     *p_vrf_node = NULL;
+    sai_fib_nh_key_t   key;
+    uint_t             index;
+    bool               encap_nh_resolved = false;
+
+    STD_ASSERT (p_key_list != NULL);
+
+    qsort (p_key_list, key_count, sizeof (sai_fib_neighbor_dep_key_t),
+           sai_fib_neighbor_dep_key_cmp);
+
+    for (index = 0; index < key_count; index++) {
+
+        if ((index != 0) &&
+            (sai_fib_neighbor_dep_key_cmp (&p_key_list [index - 1],
+                                           &p_key_list [index]) == 0)) {
+            continue;
+        }
+
+        p_vrf_node = sai_fib_vrf_node_get (p_key_list [index].vrf_id);
+
+        if (p_vrf_node == NULL) {
+
+            SAI_NEXTHOP_LOG_ERR ("Underlay VRF node not found for VRF Id: "
+                                 "0x%"PRIx64".", p_key_list [index].vrf_id);
+            continue;
+        }
+
+        memset (&key, 0, sizeof (sai_fib_nh_key_t));
+
+        key.nh_type = SAI_NEXT_HOP_TYPE_TUNNEL_ENCAP;
+
+        sai_fib_ip_addr_copy (&key.info.ip_nh.ip_addr,
+                              &p_key_list [index].ip_addr);
+
+        p_encap_nh = (sai_fib_nh_t *)
+            std_radix_getnext (p_vrf_node->sai_nh_tree, (uint8_t *) &key,
+                               SAI_FIB_NH_IP_ADDR_TREE_KEY_LEN);
+
+        while (p_encap_nh != NULL) {
+
+            if (memcmp (&p_key_list [index].ip_addr,
+                        sai_fib_next_hop_ip_addr (p_encap_nh),
+                        sizeof (sai_ip_address_t)) != 0) {
+
+                break;
+            }
+
+            /* Remove from the old underlay route object if there is any */
+            sai_fib_encap_next_hop_remove_from_underlay_obj (p_encap_nh);
+
+            p_neighbor = sai_fib_encap_nh_neighbor_find (p_vrf_node, p_encap_nh);
+
+            if (p_neighbor != NULL) {
+
+                sai_fib_encap_nh_neighbor_resolve (p_encap_nh, p_neighbor);
+
+            } else {
+
+                /* Resolve a LPM route for the IP address */
+                sai_fib_encap_nh_lpm_route_resolve (p_vrf_node, p_encap_nh);
+            }
+
+            encap_nh_resolved = true;
+
+            memcpy (&key, &p_encap_nh->key, sizeof (sai_fib_nh_key_t));
+
+            p_encap_nh = (sai_fib_nh_t *)
+                std_radix_getnext (p_vrf_node->sai_nh_tree, (uint8_t *) &key,
+                                   SAI_FIB_NH_IP_ADDR_TREE_KEY_LEN);
+        }
+    }
+
+    if (encap_nh_resolved) {
+        sai_fib_encap_nh_signal_dep_route_walk();
+    }
+}
+
 /* Encap Next Hop resolution for underlay neighbor attribute set */
 void sai_fib_neighbor_dep_encap_nh_list_update (sai_fib_nh_t *p_neighbor,
                                                 sai_fib_nh_t *p_attr_info,
@@ -21,13 +21,18 @@
 *
 *************************************************************************/
 
+/* For the writer preferring read write lock initializer */
+#define _GNU_SOURCE
+
 #include "sai_l3_util.h"
 #include "sai_l3_api.h"
 #include "sai_switch_utils.h"
 #include "saitypes.h"
 #include "saistatus.h"
 #include "std_mutex_lock.h"
+#include "sai_api_stats.h"
 #include <string.h>
+#include <pthread.h>
 
 /**************************************************************************
  *                            GLOBALS
@@ -36,8 +41,15 @@ static sai_fib_global_t g_sai_fib_config = {
     is_init_complete: false,
 };
 
-/* Simple Mutex lock for accessing FIB resources */
-static std_mutex_lock_create_static_init_fast (g_sai_fib_lock);
+/*
+ * Read write lock for accessing FIB resources. Writers are preferred, so that
+ * a stream of attribute gets and dumps does not hold off route programming.
+ */
+#ifdef PTHREAD_RWLOCK_WRITER_NONRECURSIVE_INITIALIZER_NP
+static pthread_rwlock_t g_sai_fib_lock = PTHREAD_RWLOCK_WRITER_NONRECURSIVE_INITIALIZER_NP;
+#else
+static pthread_rwlock_t g_sai_fib_lock = PTHREAD_RWLOCK_INITIALIZER;
+#endif
 
 /***************************************************************************
  *                          Accessor Functions
@@ -52,12 +64,22 @@ sai_fib_global_t *sai_fib_access_global_config (void)
  ***************************************************************************/
 void sai_fib_lock (void)
 {
-    std_mutex_lock (&g_sai_fib_lock);
+    sai_api_stats_rwlock_lock (&g_sai_fib_lock, true);
 }
 
 void sai_fib_unlock (void)
 {
-    std_mutex_unlock (&g_sai_fib_lock);
+    pthread_rwlock_unlock (&g_sai_fib_lock);
+}
+
+void sai_fib_read_lock (void)
+{
+    sai_api_stats_rwlock_lock (&g_sai_fib_lock, false);
+}
+
+void sai_fib_read_unlock (void)
+{
+    pthread_rwlock_unlock (&g_sai_fib_lock);
 }
 
 sai_status_t sai_fib_global_init (void)
@@ -37,6 +37,141 @@
 #include "sai_bridge_main.h"
 #include "sai_l3_util.h"
 
+static void sai_ipmc_l3_mcast_lock(void)
+{
+    sai_ipmc_lock();
+    sai_l3_mcast_lock();
+}
+
+static void sai_ipmc_l3_mcast_unlock(void)
+{
+    sai_l3_mcast_unlock();
+    sai_ipmc_unlock();
+}
+
+void sai_l3_ipmc_entry_log (int loglevel, dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node,
+                            char *p_info_str)
+{
+    char addr_str [SAI_FIB_MAX_BUFSZ];
+    char addr_str1 [SAI_FIB_MAX_BUFSZ];
+
+    SAI_L3_MCAST_LOG (loglevel, "%s, VRF: 0x%"PRIx64", Group: %s, Source: %s, "
+                      "IPMC group: 0x%"PRIx64", RPF group: 0x%"PRIx64", Packet-action: %s",
+                      p_info_str, l3_mcast_entry_node->mcast_key.vrf_id, sai_ip_addr_to_str
+                      (&l3_mcast_entry_node->mcast_key.grp_addr, addr_str, SAI_FIB_MAX_BUFSZ),
+                      sai_ip_addr_to_str (&l3_mcast_entry_node->mcast_key.src_addr, addr_str1,
+                      SAI_FIB_MAX_BUFSZ), l3_mcast_entry_node->mcast_ipmc_group_id,
+                      l3_mcast_entry_node->mcast_rpf_group_id,
+                      sai_packet_action_str (l3_mcast_entry_node->action));
+}
+
+static void sai_l3_ipmc_entry_node_init (dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node,
+                                         const sai_ipmc_entry_t *ipmc_entry)
+{
+    memset(l3_mcast_entry_node, 0, sizeof(dn_sai_l3_mcast_entry_node_t));
+    l3_mcast_entry_node->mcast_key.switch_id = ipmc_entry->switch_id;
+    l3_mcast_entry_node->mcast_key.vrf_id = ipmc_entry->vr_id;
+    l3_mcast_entry_node->mcast_key.entry_type = (ipmc_entry->type == SAI_IPMC_ENTRY_TYPE_SG)?
+        SAI_L3_MCAST_ENTRY_TYPE_SG : SAI_L3_MCAST_ENTRY_TYPE_XG;
+    sai_fib_ip_addr_copy(&l3_mcast_entry_node->mcast_key.grp_addr, &ipmc_entry->destination);
+
+    /* The source of a (*,G) entry is not part of the key */
+    if(ipmc_entry->type == SAI_IPMC_ENTRY_TYPE_SG) {
+        sai_fib_ip_addr_copy(&l3_mcast_entry_node->mcast_key.src_addr, &ipmc_entry->source);
+    }
+}
+
+static sai_status_t sai_l3_ipmc_entry_attr_set (dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node,
+                                                const sai_attribute_t *attr)
+{
+    switch(attr->id) {
+        case SAI_IPMC_ENTRY_ATTR_PACKET_ACTION:
+            switch(attr->value.s32) {
+                case SAI_PACKET_ACTION_FORWARD:
+                case SAI_PACKET_ACTION_DROP:
+                case SAI_PACKET_ACTION_TRAP:
+                case SAI_PACKET_ACTION_LOG:
+                    l3_mcast_entry_node->action = attr->value.s32;
+                    break;
+                default:
+                    return SAI_STATUS_INVALID_ATTR_VALUE_0;
+            }
+            break;
+        case SAI_IPMC_ENTRY_ATTR_OUTPUT_GROUP_ID:
+            if((attr->value.oid != SAI_NULL_OBJECT_ID) &&
+               (sai_find_ipmc_group_node(attr->value.oid) == NULL)) {
+                return SAI_STATUS_INVALID_ATTR_VALUE_0;
+            }
+            l3_mcast_entry_node->mcast_ipmc_group_id = attr->value.oid;
+            break;
+        case SAI_IPMC_ENTRY_ATTR_RPF_GROUP_ID:
+            if(sai_find_ipmc_rpf_group_node(attr->value.oid) == NULL) {
+                return SAI_STATUS_INVALID_ATTR_VALUE_0;
+            }
+            l3_mcast_entry_node->mcast_rpf_group_id = attr->value.oid;
+            break;
+        default:
+            return SAI_STATUS_UNKNOWN_ATTRIBUTE_0;
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_ipmc_init(void)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    if((sai_rc = sai_ipmc_tree_init()) != SAI_STATUS_SUCCESS) {
+        SAI_IPMC_LOG_ERR(SAI_API_IPMC, "IPMC Tree init failed");
+        return sai_rc;
+    }
+
+    if((sai_rc = sai_l3_mcast_init()) != SAI_STATUS_SUCCESS) {
+        SAI_IPMC_LOG_ERR(SAI_API_IPMC, "L3 MCAST Cache init failed");
+        return sai_rc;
+    }
+
+    if((sai_rc = sai_l3_ipmc_npu_api_get()->ipmc_init()) != SAI_STATUS_SUCCESS) {
+        SAI_IPMC_LOG_ERR(SAI_API_IPMC, "IPMC NPU init failed");
+        return sai_rc;
+    }
+
+    if((sai_rc = sai_l3_mcast_npu_api_get()->l3_mcast_init()) != SAI_STATUS_SUCCESS) {
+        SAI_IPMC_LOG_ERR(SAI_API_IPMC, "L3 MCAST NPU init failed");
+    }
+    return sai_rc;
+}
+
+sai_status_t sai_ipmc_group_entries_update(sai_object_id_t group_id)
+{
+    dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node = NULL;
+    dn_sai_l3_mcast_entry_key_t   l3_mcast_key;
+    sai_status_t                  sai_rc = SAI_STATUS_SUCCESS;
+    sai_status_t                  rc;
+
+    memset(&l3_mcast_key, 0, sizeof(l3_mcast_key));
+
+    sai_l3_mcast_lock();
+    while((l3_mcast_entry_node = sai_get_next_l3_mcast_entry_node(&l3_mcast_key)) != NULL) {
+        l3_mcast_key = l3_mcast_entry_node->mcast_key;
+
+        if((l3_mcast_entry_node->mcast_ipmc_group_id != group_id) &&
+           (l3_mcast_entry_node->mcast_rpf_group_id != group_id)) {
+            continue;
+        }
+
+        /* Every entry of the group is refreshed even if one fails */
+        rc = sai_l3_mcast_npu_api_get()->l3_mcast_entry_update(l3_mcast_entry_node);
+        if(rc != SAI_STATUS_SUCCESS) {
+            sai_l3_ipmc_entry_log(SAI_LOG_LEVEL_ERROR, l3_mcast_entry_node,
+                                  "Unable to refresh IPMC entry");
+            sai_rc = rc;
+        }
+    }
+    sai_l3_mcast_unlock();
+
+    return sai_rc;
+}
+
 /**
  * @brief Create IPMC entry
  *
@@ -51,10 +186,66 @@ sai_status_t sai_ipmc_create_entry(
         uint32_t attr_count,
         const sai_attribute_t *attr_list)
 {
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    dn_sai_l3_mcast_entry_node_t l3_mcast_entry_node;
+    bool pkt_action_present = false;
+    bool rpf_grp_attr_present = false;
+    uint32_t attr_idx = 0;
+
     STD_ASSERT (ipmc_entry != NULL);
-    STD_ASSERT (attr_list != NULL);
 
-    return SAI_STATUS_SUCCESS;
+    if (attr_count == 0) {
+        return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    } else {
+        STD_ASSERT (attr_list != NULL);
+    }
+
+    sai_l3_ipmc_entry_node_init(&l3_mcast_entry_node, ipmc_entry);
+
+    sai_ipmc_l3_mcast_lock();
+    do {
+        for(attr_idx = 0; attr_idx < attr_count; attr_idx++) {
+            sai_rc = sai_l3_ipmc_entry_attr_set(&l3_mcast_entry_node, &attr_list[attr_idx]);
+            if(sai_rc != SAI_STATUS_SUCCESS) {
+                sai_rc = sai_get_indexed_ret_val(sai_rc, attr_idx);
+                break;
+            }
+            pkt_action_present |= (attr_list[attr_idx].id == SAI_IPMC_ENTRY_ATTR_PACKET_ACTION);
+            rpf_grp_attr_present |= (attr_list[attr_idx].id == SAI_IPMC_ENTRY_ATTR_RPF_GROUP_ID);
+        }
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            sai_l3_ipmc_entry_log(SAI_LOG_LEVEL_ERROR, &l3_mcast_entry_node,
+                                  "Invalid IPMC entry attribute");
+            break;
+        }
+        if(!(pkt_action_present) || !(rpf_grp_attr_present)) {
+            sai_rc = SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+            break;
+        }
+
+        if(sai_find_l3_mcast_entry(&l3_mcast_entry_node) != NULL) {
+            sai_rc = SAI_STATUS_ITEM_ALREADY_EXISTS;
+            break;
+        }
+
+        sai_rc = sai_l3_mcast_npu_api_get()->l3_mcast_entry_create(&l3_mcast_entry_node);
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        if((sai_rc = sai_insert_l3_mcast_entry_node(&l3_mcast_entry_node))
+                != SAI_STATUS_SUCCESS) {
+            sai_l3_ipmc_entry_log(SAI_LOG_LEVEL_ERROR, &l3_mcast_entry_node,
+                                  "Unable to add IPMC entry");
+            sai_l3_mcast_npu_api_get()->l3_mcast_entry_remove(&l3_mcast_entry_node);
+        }
+    } while(0);
+    sai_ipmc_l3_mcast_unlock();
+
+    if(sai_rc == SAI_STATUS_SUCCESS) {
+        sai_l3_ipmc_entry_log(SAI_LOG_LEVEL_DEBUG, &l3_mcast_entry_node, "Created IPMC entry");
+    }
+    return sai_rc;
 }
 
 /**
@@ -67,9 +258,30 @@ sai_status_t sai_ipmc_create_entry(
 sai_status_t sai_ipmc_remove_entry(
         const sai_ipmc_entry_t *ipmc_entry)
 {
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node = NULL;
+    dn_sai_l3_mcast_entry_node_t tmp_node;
+
     STD_ASSERT(ipmc_entry != NULL);
 
-    return SAI_STATUS_SUCCESS;
+    sai_l3_ipmc_entry_node_init(&tmp_node, ipmc_entry);
+
+    sai_ipmc_l3_mcast_lock();
+    do {
+        if((l3_mcast_entry_node = sai_find_l3_mcast_entry(&tmp_node)) == NULL) {
+            sai_rc = SAI_STATUS_ITEM_NOT_FOUND;
+            break;
+        }
+
+        if((sai_rc = sai_l3_mcast_npu_api_get()->l3_mcast_entry_remove(l3_mcast_entry_node))
+                != SAI_STATUS_SUCCESS) {
+            break;
+        }
+        sai_remove_l3_mcast_entry_node(l3_mcast_entry_node);
+    } while(0);
+    sai_ipmc_l3_mcast_unlock();
+
+    return sai_rc;
 }
 
 /**
@@ -84,7 +296,40 @@ sai_status_t sai_ipmc_set_entry_attribute(
         const sai_ipmc_entry_t *ipmc_entry,
         const sai_attribute_t *attr)
 {
-    return SAI_STATUS_SUCCESS;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node = NULL;
+    dn_sai_l3_mcast_entry_node_t tmp_node;
+
+    STD_ASSERT(ipmc_entry != NULL);
+    STD_ASSERT(attr != NULL);
+
+    sai_l3_ipmc_entry_node_init(&tmp_node, ipmc_entry);
+
+    sai_ipmc_l3_mcast_lock();
+    do {
+        if((l3_mcast_entry_node = sai_find_l3_mcast_entry(&tmp_node)) == NULL) {
+            sai_rc = SAI_STATUS_ITEM_NOT_FOUND;
+            break;
+        }
+
+        /* The cache is changed only once the NPU accepted the new values */
+        tmp_node = *l3_mcast_entry_node;
+        if((sai_rc = sai_l3_ipmc_entry_attr_set(&tmp_node, attr)) != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        if((sai_rc = sai_l3_mcast_npu_api_get()->l3_mcast_entry_update(&tmp_node))
+                != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        l3_mcast_entry_node->action = tmp_node.action;
+        l3_mcast_entry_node->mcast_ipmc_group_id = tmp_node.mcast_ipmc_group_id;
+        l3_mcast_entry_node->mcast_rpf_group_id = tmp_node.mcast_rpf_group_id;
+    } while(0);
+    sai_ipmc_l3_mcast_unlock();
+
+    return sai_rc;
 }
 
 /**
@@ -101,7 +346,48 @@ sai_status_t sai_ipmc_get_entry_attribute(
         uint32_t attr_count,
         sai_attribute_t *attr_list)
 {
-    return SAI_STATUS_SUCCESS;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node = NULL;
+    dn_sai_l3_mcast_entry_node_t tmp_node;
+    uint32_t attr_idx = 0;
+
+    STD_ASSERT(ipmc_entry != NULL);
+
+    if (attr_count == 0) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    } else {
+        STD_ASSERT (attr_list != NULL);
+    }
+
+    sai_l3_ipmc_entry_node_init(&tmp_node, ipmc_entry);
+
+    sai_ipmc_l3_mcast_lock();
+    if((l3_mcast_entry_node = sai_find_l3_mcast_entry(&tmp_node)) == NULL) {
+        sai_rc = SAI_STATUS_ITEM_NOT_FOUND;
+    } else {
+        for(attr_idx = 0; attr_idx < attr_count; attr_idx++) {
+            switch(attr_list[attr_idx].id) {
+                case SAI_IPMC_ENTRY_ATTR_PACKET_ACTION:
+                    attr_list[attr_idx].value.s32 = l3_mcast_entry_node->action;
+                    break;
+                case SAI_IPMC_ENTRY_ATTR_OUTPUT_GROUP_ID:
+                    attr_list[attr_idx].value.oid = l3_mcast_entry_node->mcast_ipmc_group_id;
+                    break;
+                case SAI_IPMC_ENTRY_ATTR_RPF_GROUP_ID:
+                    attr_list[attr_idx].value.oid = l3_mcast_entry_node->mcast_rpf_group_id;
+                    break;
+                default:
+                    sai_rc = sai_get_indexed_ret_val(SAI_STATUS_UNKNOWN_ATTRIBUTE_0, attr_idx);
+                    break;
+            }
+            if(sai_rc != SAI_STATUS_SUCCESS) {
+                break;
+            }
+        }
+    }
+    sai_ipmc_l3_mcast_unlock();
+
+    return sai_rc;
 }
 
 static sai_ipmc_api_t sai_ipmc_method_table =
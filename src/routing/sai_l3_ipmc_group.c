@@ -37,6 +37,32 @@
 #include "sai_bridge_main.h"
 #include "sai_l3_util.h"
 
+/*
+ * A member holds a reference on its router interface, which cannot be
+ * removed while it replicates traffic of the group.
+ */
+static sai_status_t sai_ipmc_member_rif_ref_take(sai_object_id_t router_intf_id)
+{
+    sai_status_t sai_rc;
+
+    if(!sai_is_obj_id_rif(router_intf_id)) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    sai_fib_lock();
+    sai_rc = sai_rif_increment_ref_count(router_intf_id);
+    sai_fib_unlock();
+
+    return sai_rc;
+}
+
+static void sai_ipmc_member_rif_ref_release(sai_object_id_t router_intf_id)
+{
+    sai_fib_lock();
+    sai_rif_decrement_ref_count(router_intf_id);
+    sai_fib_unlock();
+}
+
 /**
  * @brief Create IPMC group
  *
@@ -54,8 +80,38 @@ sai_status_t sai_ipmc_create_group(
         const sai_attribute_t *attr_list)
 {
     sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    dn_sai_ipmc_group_node_t ipmc_group_node;
+
+    STD_ASSERT(ipmc_group_id != NULL);
+
     *ipmc_group_id = SAI_NULL_OBJECT_ID;
-    return (sai_rc);
+
+    if (attr_count > 0) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset(&ipmc_group_node, 0, sizeof(ipmc_group_node));
+    sai_ipmc_lock();
+    do {
+        if((sai_rc = sai_l3_ipmc_npu_api_get()->ipmc_group_create(&ipmc_group_node))
+                != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        if((sai_rc = sai_add_ipmc_group_node(&ipmc_group_node)) != SAI_STATUS_SUCCESS) {
+            SAI_IPMC_LOG_ERR(SAI_API_IPMC_GROUP, "Unable to add IPMC Group id 0x%"PRIx64"",
+                             ipmc_group_node.ipmc_group_id);
+            sai_l3_ipmc_npu_api_get()->ipmc_group_remove(&ipmc_group_node);
+            break;
+        }
+
+        *ipmc_group_id = ipmc_group_node.ipmc_group_id;
+        SAI_IPMC_LOG_TRACE(SAI_API_IPMC_GROUP, "Created IPMC Group id 0x%"PRIx64"",
+                           ipmc_group_node.ipmc_group_id);
+    } while(0);
+    sai_ipmc_unlock();
+
+    return sai_rc;
 }
 
 /**
@@ -69,7 +125,33 @@ sai_status_t sai_ipmc_remove_group(
         sai_object_id_t ipmc_group_id)
 {
     sai_status_t sai_rc = SAI_STATUS_SUCCESS;
-    return (sai_rc);
+    dn_sai_ipmc_group_node_t *ipmc_group_node = NULL;
+
+    if(!sai_is_obj_id_ipmc_group(ipmc_group_id)) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    sai_ipmc_lock();
+    do {
+        if((ipmc_group_node = sai_find_ipmc_group_node(ipmc_group_id)) == NULL) {
+            sai_rc = SAI_STATUS_ITEM_NOT_FOUND;
+            break;
+        }
+
+        if(ipmc_group_node->l3_oif_count > 0) {
+            sai_rc = SAI_STATUS_OBJECT_IN_USE;
+            break;
+        }
+
+        if((sai_rc = sai_l3_ipmc_npu_api_get()->ipmc_group_remove(ipmc_group_node))
+                != SAI_STATUS_SUCCESS) {
+            break;
+        }
+        sai_rc = sai_remove_ipmc_group_node(ipmc_group_node);
+    } while(0);
+    sai_ipmc_unlock();
+
+    return sai_rc;
 }
 
 /**
@@ -84,8 +166,8 @@ sai_status_t sai_ipmc_set_group_attribute(
         sai_object_id_t ipmc_group_id,
         const sai_attribute_t *attr)
 {
-    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
-    return (sai_rc);
+    /* No set attribute present for IPMC group */
+    return SAI_STATUS_INVALID_ATTRIBUTE_0;
 }
 
 /**
@@ -103,14 +185,53 @@ sai_status_t sai_ipmc_get_group_attribute(
         sai_attribute_t *attr_list)
 {
     sai_status_t sai_rc = SAI_STATUS_SUCCESS;
-    return (sai_rc);
+    dn_sai_ipmc_group_node_t *ipmc_group_node = NULL;
+    uint32_t attr_idx = 0;
+
+    if(!sai_is_obj_id_ipmc_group(ipmc_group_id)) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    if(attr_count == 0) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    } else {
+        STD_ASSERT(attr_list != NULL);
+    }
+
+    sai_ipmc_lock();
+    if((ipmc_group_node = sai_find_ipmc_group_node(ipmc_group_id)) == NULL) {
+        sai_ipmc_unlock();
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    for(attr_idx = 0; attr_idx < attr_count; attr_idx++) {
+        switch(attr_list[attr_idx].id) {
+            case SAI_IPMC_GROUP_ATTR_IPMC_OUTPUT_COUNT:
+                attr_list[attr_idx].value.u32 = ipmc_group_node->l3_oif_count;
+                break;
+            case SAI_IPMC_GROUP_ATTR_IPMC_MEMBER_LIST:
+                sai_rc = sai_ipmc_group_rtr_intf_list_get(ipmc_group_node,
+                                                          &attr_list[attr_idx].value.objlist);
+                break;
+            default:
+                sai_rc = SAI_STATUS_UNKNOWN_ATTRIBUTE_0;
+                break;
+        }
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            sai_rc = sai_get_indexed_ret_val(sai_rc, attr_idx);
+            break;
+        }
+    }
+    sai_ipmc_unlock();
+
+    return sai_rc;
 }
 
 /**
  * @brief Create IPMC group member
  *
  * @param[out] ipmc_group_member_id IPMC group member id
- * @param[in] switch_id Switch ID
+ * @param[in] switch_id Switch id
  * @param[in] attr_count Number of attributes
  * @param[in] attr_list Array of attributes
  *
@@ -123,8 +244,98 @@ sai_status_t sai_ipmc_create_group_member(
         const sai_attribute_t *attr_list)
 {
     sai_status_t sai_rc = SAI_STATUS_SUCCESS;
-    *ipmc_group_member_id = SAI_NULL_OBJECT_ID;
-    return (sai_rc);
+    dn_sai_ipmc_group_member_node_t ipmc_member_node;
+    dn_sai_ipmc_group_node_t *ipmc_group_node = NULL;
+    bool ipmc_grp_attr_present = false;
+    bool output_id_attr_present = false;
+    uint32_t attr_idx = 0;
+
+    STD_ASSERT(ipmc_group_member_id != NULL);
+
+    *ipmc_group_member_id = SAI_INVALID_IPMC_MEMBER_ID;
+
+    if(attr_count == 0) {
+        return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    } else {
+        STD_ASSERT(attr_list != NULL);
+    }
+
+    memset(&ipmc_member_node, 0, sizeof(ipmc_member_node));
+    ipmc_member_node.switch_id = switch_id;
+
+    for(attr_idx = 0; attr_idx < attr_count; attr_idx++) {
+        switch(attr_list[attr_idx].id) {
+            case SAI_IPMC_GROUP_MEMBER_ATTR_IPMC_GROUP_ID:
+                if(!sai_is_obj_id_ipmc_group(attr_list[attr_idx].value.oid)) {
+                    sai_rc = SAI_STATUS_INVALID_ATTR_VALUE_0;
+                    break;
+                }
+                ipmc_member_node.ipmc_group_id = attr_list[attr_idx].value.oid;
+                ipmc_grp_attr_present = true;
+                break;
+            case SAI_IPMC_GROUP_MEMBER_ATTR_IPMC_OUTPUT_ID:
+                if(!sai_is_obj_id_rif(attr_list[attr_idx].value.oid)) {
+                    sai_rc = SAI_STATUS_INVALID_ATTR_VALUE_0;
+                    break;
+                }
+                ipmc_member_node.router_intf_id = attr_list[attr_idx].value.oid;
+                output_id_attr_present = true;
+                break;
+            default:
+                sai_rc = SAI_STATUS_UNKNOWN_ATTRIBUTE_0;
+                break;
+        }
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            return sai_get_indexed_ret_val(sai_rc, attr_idx);
+        }
+    }
+
+    if(!(ipmc_grp_attr_present) || !(output_id_attr_present)) {
+        return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    }
+
+    sai_ipmc_lock();
+    do {
+        if((ipmc_group_node = sai_find_ipmc_group_node(ipmc_member_node.ipmc_group_id)) == NULL) {
+            sai_rc = SAI_STATUS_ITEM_NOT_FOUND;
+            break;
+        }
+
+        if(sai_find_ipmc_group_member_node_from_router_intf(ipmc_group_node,
+                    ipmc_member_node.router_intf_id) != NULL) {
+            sai_rc = SAI_STATUS_ITEM_ALREADY_EXISTS;
+            break;
+        }
+
+        if((sai_rc = sai_ipmc_member_rif_ref_take(ipmc_member_node.router_intf_id))
+                != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        if((sai_rc = sai_l3_ipmc_npu_api_get()->ipmc_group_member_create(ipmc_group_node,
+                        &ipmc_member_node)) != SAI_STATUS_SUCCESS) {
+            sai_ipmc_member_rif_ref_release(ipmc_member_node.router_intf_id);
+            break;
+        }
+
+        if((sai_rc = sai_add_ipmc_group_member_node(&ipmc_member_node)) != SAI_STATUS_SUCCESS) {
+            SAI_IPMC_LOG_ERR(SAI_API_IPMC_GROUP, "Unable to add IPMC member 0x%"PRIx64" to "
+                             "Group:0x%"PRIx64" cache", ipmc_member_node.ipmc_grp_member_id,
+                             ipmc_member_node.ipmc_group_id);
+            sai_l3_ipmc_npu_api_get()->ipmc_group_member_remove(ipmc_group_node,
+                                                                &ipmc_member_node);
+            sai_ipmc_member_rif_ref_release(ipmc_member_node.router_intf_id);
+            break;
+        }
+
+        *ipmc_group_member_id = ipmc_member_node.ipmc_grp_member_id;
+
+        /* The member is in the group, the entries pick it up as an output */
+        sai_ipmc_group_entries_update(ipmc_member_node.ipmc_group_id);
+    } while(0);
+    sai_ipmc_unlock();
+
+    return sai_rc;
 }
 
 /**
@@ -138,11 +349,45 @@ sai_status_t sai_ipmc_remove_group_member(
         sai_object_id_t ipmc_group_member_id)
 {
     sai_status_t sai_rc = SAI_STATUS_SUCCESS;
-    return (sai_rc);
+    dn_sai_ipmc_group_member_node_t *ipmc_member_node = NULL;
+    dn_sai_ipmc_group_node_t *ipmc_group_node = NULL;
+    sai_object_id_t ipmc_group_id = SAI_NULL_OBJECT_ID;
+    sai_object_id_t router_intf_id = SAI_NULL_OBJECT_ID;
+
+    if(!sai_is_obj_id_ipmc_group_member(ipmc_group_member_id)) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    sai_ipmc_lock();
+    do {
+        if((ipmc_member_node = sai_find_ipmc_group_member_node(ipmc_group_member_id)) == NULL) {
+            sai_rc = SAI_STATUS_ITEM_NOT_FOUND;
+            break;
+        }
+
+        ipmc_group_id = ipmc_member_node->ipmc_group_id;
+        router_intf_id = ipmc_member_node->router_intf_id;
+        ipmc_group_node = sai_find_ipmc_group_node(ipmc_group_id);
+
+        if((sai_rc = sai_l3_ipmc_npu_api_get()->ipmc_group_member_remove(ipmc_group_node,
+                        ipmc_member_node)) != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        if((sai_rc = sai_remove_ipmc_group_member_node(ipmc_member_node)) != SAI_STATUS_SUCCESS) {
+            break;
+        }
+        sai_ipmc_member_rif_ref_release(router_intf_id);
+
+        sai_ipmc_group_entries_update(ipmc_group_id);
+    } while(0);
+    sai_ipmc_unlock();
+
+    return sai_rc;
 }
 
 /**
- * @brief Set IPMC Group attribute
+ * @brief Set IPMC Group member attribute
  *
  * @param[in] ipmc_group_member_id IPMC group member id
  * @param[in] attr Attribute
@@ -153,14 +398,14 @@ sai_status_t sai_ipmc_set_group_member_attribute(
         sai_object_id_t ipmc_group_member_id,
         const sai_attribute_t *attr)
 {
-    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
-    return (sai_rc);
+    /* There is no set attribute for the group member */
+    return SAI_STATUS_INVALID_ATTRIBUTE_0;
 }
 
 /**
- * @brief Get IPMC Group attribute
+ * @brief Get IPMC Group member attribute
  *
- * @param[in] ipmc_group_member_id IPMC group member ID
+ * @param[in] ipmc_group_member_id IPMC group member id
  * @param[in] attr_count Number of attributes
  * @param[inout] attr_list Array of attributes
  *
@@ -172,7 +417,43 @@ sai_status_t sai_ipmc_get_group_member_attribute(
         sai_attribute_t *attr_list)
 {
     sai_status_t sai_rc = SAI_STATUS_SUCCESS;
-    return (sai_rc);
+    dn_sai_ipmc_group_member_node_t *ipmc_member_node = NULL;
+    uint32_t attr_idx = 0;
+
+    if(!sai_is_obj_id_ipmc_group_member(ipmc_group_member_id)) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    if(attr_count == 0) {
+        return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    } else {
+        STD_ASSERT(attr_list != NULL);
+    }
+
+    sai_ipmc_lock();
+    if((ipmc_member_node = sai_find_ipmc_group_member_node(ipmc_group_member_id)) == NULL) {
+        sai_rc = SAI_STATUS_ITEM_NOT_FOUND;
+    } else {
+        for(attr_idx = 0; attr_idx < attr_count; attr_idx++) {
+            switch(attr_list[attr_idx].id) {
+                case SAI_IPMC_GROUP_MEMBER_ATTR_IPMC_GROUP_ID:
+                    attr_list[attr_idx].value.oid = ipmc_member_node->ipmc_group_id;
+                    break;
+                case SAI_IPMC_GROUP_MEMBER_ATTR_IPMC_OUTPUT_ID:
+                    attr_list[attr_idx].value.oid = ipmc_member_node->router_intf_id;
+                    break;
+                default:
+                    sai_rc = sai_get_indexed_ret_val(SAI_STATUS_UNKNOWN_ATTRIBUTE_0, attr_idx);
+                    break;
+            }
+            if(sai_rc != SAI_STATUS_SUCCESS) {
+                break;
+            }
+        }
+    }
+    sai_ipmc_unlock();
+
+    return sai_rc;
 }
 
 static sai_ipmc_group_api_t sai_ipmc_group_method_table =
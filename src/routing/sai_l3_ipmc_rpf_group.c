@@ -40,6 +40,28 @@
 #include "sai_l3_api_utils.h"
 #include "sai_port_utils.h"
 
+static sai_status_t sai_ipmc_rpf_member_rif_ref_take(sai_object_id_t router_intf_id)
+{
+    sai_status_t sai_rc;
+
+    if(!sai_is_obj_id_rif(router_intf_id)) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    sai_fib_lock();
+    sai_rc = sai_rif_increment_ref_count(router_intf_id);
+    sai_fib_unlock();
+
+    return sai_rc;
+}
+
+static void sai_ipmc_rpf_member_rif_ref_release(sai_object_id_t router_intf_id)
+{
+    sai_fib_lock();
+    sai_rif_decrement_ref_count(router_intf_id);
+    sai_fib_unlock();
+}
+
 /**
  * @brief Create RPF interface group
  *
@@ -56,7 +78,39 @@ sai_status_t sai_ipmc_rpf_create_group(
         uint32_t attr_count,
         const sai_attribute_t *attr_list)
 {
-    return SAI_STATUS_SUCCESS;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    dn_sai_ipmc_rpf_group_node_t rpf_group_node;
+
+    STD_ASSERT(rpf_group_id != NULL);
+
+    *rpf_group_id = SAI_NULL_OBJECT_ID;
+
+    if (attr_count > 0) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset(&rpf_group_node, 0, sizeof(rpf_group_node));
+    sai_ipmc_lock();
+    do {
+        if((sai_rc = sai_l3_ipmc_npu_api_get()->ipmc_rpf_group_create(&rpf_group_node))
+                != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        if((sai_rc = sai_add_ipmc_rpf_group_node(&rpf_group_node)) != SAI_STATUS_SUCCESS) {
+            SAI_IPMC_LOG_ERR(SAI_API_RPF_GROUP, "Unable to add RPF Group id 0x%"PRIx64"",
+                             rpf_group_node.ipmc_rpf_group_id);
+            sai_l3_ipmc_npu_api_get()->ipmc_rpf_group_remove(&rpf_group_node);
+            break;
+        }
+
+        *rpf_group_id = rpf_group_node.ipmc_rpf_group_id;
+        SAI_IPMC_LOG_TRACE(SAI_API_RPF_GROUP, "Created RPF Group id 0x%"PRIx64"",
+                           rpf_group_node.ipmc_rpf_group_id);
+    } while(0);
+    sai_ipmc_unlock();
+
+    return sai_rc;
 }
 
 /**
@@ -68,7 +122,34 @@ sai_status_t sai_ipmc_rpf_create_group(
  */
 sai_status_t sai_ipmc_rpf_remove_group( sai_object_id_t rpf_group_id)
 {
-    return SAI_STATUS_SUCCESS;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    dn_sai_ipmc_rpf_group_node_t *rpf_group_node = NULL;
+
+    if(!sai_is_obj_id_rpf_group(rpf_group_id)) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    sai_ipmc_lock();
+    do {
+        if((rpf_group_node = sai_find_ipmc_rpf_group_node(rpf_group_id)) == NULL) {
+            sai_rc = SAI_STATUS_ITEM_NOT_FOUND;
+            break;
+        }
+
+        if(rpf_group_node->l3_iif_count > 0) {
+            sai_rc = SAI_STATUS_OBJECT_IN_USE;
+            break;
+        }
+
+        if((sai_rc = sai_l3_ipmc_npu_api_get()->ipmc_rpf_group_remove(rpf_group_node))
+                != SAI_STATUS_SUCCESS) {
+            break;
+        }
+        sai_rc = sai_remove_ipmc_rpf_group_node(rpf_group_node);
+    } while(0);
+    sai_ipmc_unlock();
+
+    return sai_rc;
 }
 
 /**
@@ -85,7 +166,47 @@ sai_status_t sai_ipmc_rpf_get_group_attribute(
         uint32_t attr_count,
         sai_attribute_t *attr_list)
 {
-    return SAI_STATUS_SUCCESS;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    dn_sai_ipmc_rpf_group_node_t *rpf_group_node = NULL;
+    uint32_t attr_idx = 0;
+
+    if(!sai_is_obj_id_rpf_group(rpf_group_id)) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    if(attr_count == 0) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    } else {
+        STD_ASSERT(attr_list != NULL);
+    }
+
+    sai_ipmc_lock();
+    if((rpf_group_node = sai_find_ipmc_rpf_group_node(rpf_group_id)) == NULL) {
+        sai_ipmc_unlock();
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    for(attr_idx = 0; attr_idx < attr_count; attr_idx++) {
+        switch(attr_list[attr_idx].id) {
+            case SAI_RPF_GROUP_ATTR_RPF_INTERFACE_COUNT:
+                attr_list[attr_idx].value.u32 = rpf_group_node->l3_iif_count;
+                break;
+            case SAI_RPF_GROUP_ATTR_RPF_MEMBER_LIST:
+                sai_rc = sai_ipmc_rpf_group_rtr_intf_list_get(rpf_group_node,
+                                                              &attr_list[attr_idx].value.objlist);
+                break;
+            default:
+                sai_rc = SAI_STATUS_UNKNOWN_ATTRIBUTE_0;
+                break;
+        }
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            sai_rc = sai_get_indexed_ret_val(sai_rc, attr_idx);
+            break;
+        }
+    }
+    sai_ipmc_unlock();
+
+    return sai_rc;
 }
 
 /**
@@ -100,7 +221,8 @@ sai_status_t sai_ipmc_rpf_set_group_attribute(
         sai_object_id_t rpf_group_id,
         const sai_attribute_t *attr)
 {
-    return SAI_STATUS_SUCCESS;
+    /* No set attribute present for RPF group */
+    return SAI_STATUS_INVALID_ATTRIBUTE_0;
 }
 
 /**
@@ -119,7 +241,101 @@ sai_status_t sai_ipmc_rpf_create_group_member(
     uint32_t attr_count,
     const sai_attribute_t *attr_list)
 {
-    return SAI_STATUS_SUCCESS;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    dn_sai_ipmc_rpf_group_member_node_t rpf_member_node;
+    dn_sai_ipmc_rpf_group_node_t *rpf_group_node = NULL;
+    bool rpf_grp_attr_present = false;
+    bool rpf_intf_attr_present = false;
+    uint32_t attr_idx = 0;
+
+    STD_ASSERT(rpf_group_member_id != NULL);
+
+    *rpf_group_member_id = SAI_INVALID_IPMC_MEMBER_ID;
+
+    if(attr_count == 0) {
+        return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    } else {
+        STD_ASSERT(attr_list != NULL);
+    }
+
+    memset(&rpf_member_node, 0, sizeof(rpf_member_node));
+    rpf_member_node.switch_id = switch_id;
+
+    for(attr_idx = 0; attr_idx < attr_count; attr_idx++) {
+        switch(attr_list[attr_idx].id) {
+            case SAI_RPF_GROUP_MEMBER_ATTR_RPF_GROUP_ID:
+                if(!sai_is_obj_id_rpf_group(attr_list[attr_idx].value.oid)) {
+                    sai_rc = SAI_STATUS_INVALID_ATTR_VALUE_0;
+                    break;
+                }
+                rpf_member_node.ipmc_rpf_group_id = attr_list[attr_idx].value.oid;
+                rpf_grp_attr_present = true;
+                break;
+            case SAI_RPF_GROUP_MEMBER_ATTR_RPF_INTERFACE_ID:
+                if(!sai_is_obj_id_rif(attr_list[attr_idx].value.oid)) {
+                    sai_rc = SAI_STATUS_INVALID_ATTR_VALUE_0;
+                    break;
+                }
+                rpf_member_node.router_intf_id = attr_list[attr_idx].value.oid;
+                rpf_intf_attr_present = true;
+                break;
+            default:
+                sai_rc = SAI_STATUS_UNKNOWN_ATTRIBUTE_0;
+                break;
+        }
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            return sai_get_indexed_ret_val(sai_rc, attr_idx);
+        }
+    }
+
+    if(!(rpf_grp_attr_present) || !(rpf_intf_attr_present)) {
+        return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    }
+
+    sai_ipmc_lock();
+    do {
+        if((rpf_group_node = sai_find_ipmc_rpf_group_node(rpf_member_node.ipmc_rpf_group_id))
+                == NULL) {
+            sai_rc = SAI_STATUS_ITEM_NOT_FOUND;
+            break;
+        }
+
+        if(sai_find_ipmc_rpf_group_member_node_from_router_intf(rpf_group_node,
+                    rpf_member_node.router_intf_id) != NULL) {
+            sai_rc = SAI_STATUS_ITEM_ALREADY_EXISTS;
+            break;
+        }
+
+        if((sai_rc = sai_ipmc_rpf_member_rif_ref_take(rpf_member_node.router_intf_id))
+                != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        if((sai_rc = sai_l3_ipmc_npu_api_get()->ipmc_rpf_group_member_create(rpf_group_node,
+                        &rpf_member_node)) != SAI_STATUS_SUCCESS) {
+            sai_ipmc_rpf_member_rif_ref_release(rpf_member_node.router_intf_id);
+            break;
+        }
+
+        if((sai_rc = sai_add_ipmc_rpf_group_member_node(&rpf_member_node))
+                != SAI_STATUS_SUCCESS) {
+            SAI_IPMC_LOG_ERR(SAI_API_RPF_GROUP, "Unable to add RPF member 0x%"PRIx64" to "
+                             "Group:0x%"PRIx64" cache", rpf_member_node.ipmc_rpf_grp_member_id,
+                             rpf_member_node.ipmc_rpf_group_id);
+            sai_l3_ipmc_npu_api_get()->ipmc_rpf_group_member_remove(rpf_group_node,
+                                                                    &rpf_member_node);
+            sai_ipmc_rpf_member_rif_ref_release(rpf_member_node.router_intf_id);
+            break;
+        }
+
+        *rpf_group_member_id = rpf_member_node.ipmc_rpf_grp_member_id;
+
+        /* The RPF interface of the entries may change with the new member */
+        sai_ipmc_group_entries_update(rpf_member_node.ipmc_rpf_group_id);
+    } while(0);
+    sai_ipmc_unlock();
+
+    return sai_rc;
 }
 
 /**
@@ -132,7 +348,44 @@ sai_status_t sai_ipmc_rpf_create_group_member(
 sai_status_t sai_ipmc_rpf_remove_group_member(
         sai_object_id_t rpf_group_member_id)
 {
-    return SAI_STATUS_SUCCESS;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    dn_sai_ipmc_rpf_group_member_node_t *rpf_member_node = NULL;
+    dn_sai_ipmc_rpf_group_node_t *rpf_group_node = NULL;
+    sai_object_id_t rpf_group_id = SAI_NULL_OBJECT_ID;
+    sai_object_id_t router_intf_id = SAI_NULL_OBJECT_ID;
+
+    if(!sai_is_obj_id_rpf_group_member(rpf_group_member_id)) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    sai_ipmc_lock();
+    do {
+        if((rpf_member_node = sai_find_ipmc_rpf_group_member_node(rpf_group_member_id))
+                == NULL) {
+            sai_rc = SAI_STATUS_ITEM_NOT_FOUND;
+            break;
+        }
+
+        rpf_group_id = rpf_member_node->ipmc_rpf_group_id;
+        router_intf_id = rpf_member_node->router_intf_id;
+        rpf_group_node = sai_find_ipmc_rpf_group_node(rpf_group_id);
+
+        if((sai_rc = sai_l3_ipmc_npu_api_get()->ipmc_rpf_group_member_remove(rpf_group_node,
+                        rpf_member_node)) != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        if((sai_rc = sai_remove_ipmc_rpf_group_member_node(rpf_member_node))
+                != SAI_STATUS_SUCCESS) {
+            break;
+        }
+        sai_ipmc_rpf_member_rif_ref_release(router_intf_id);
+
+        sai_ipmc_group_entries_update(rpf_group_id);
+    } while(0);
+    sai_ipmc_unlock();
+
+    return sai_rc;
 }
 
 /**
@@ -147,7 +400,8 @@ sai_status_t sai_ipmc_rpf_set_group_member_attribute(
     sai_object_id_t rpf_group_member_id,
     const sai_attribute_t *attr)
 {
-    return SAI_STATUS_SUCCESS;
+    /* There is no set attribute for the group member */
+    return SAI_STATUS_INVALID_ATTRIBUTE_0;
 }
 
 /**
@@ -164,7 +418,44 @@ sai_status_t sai_ipmc_rpf_get_group_member_attribute(
     uint32_t attr_count,
     sai_attribute_t *attr_list)
 {
-    return SAI_STATUS_SUCCESS;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    dn_sai_ipmc_rpf_group_member_node_t *rpf_member_node = NULL;
+    uint32_t attr_idx = 0;
+
+    if(!sai_is_obj_id_rpf_group_member(rpf_group_member_id)) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    if(attr_count == 0) {
+        return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    } else {
+        STD_ASSERT(attr_list != NULL);
+    }
+
+    sai_ipmc_lock();
+    if((rpf_member_node = sai_find_ipmc_rpf_group_member_node(rpf_group_member_id)) == NULL) {
+        sai_rc = SAI_STATUS_ITEM_NOT_FOUND;
+    } else {
+        for(attr_idx = 0; attr_idx < attr_count; attr_idx++) {
+            switch(attr_list[attr_idx].id) {
+                case SAI_RPF_GROUP_MEMBER_ATTR_RPF_GROUP_ID:
+                    attr_list[attr_idx].value.oid = rpf_member_node->ipmc_rpf_group_id;
+                    break;
+                case SAI_RPF_GROUP_MEMBER_ATTR_RPF_INTERFACE_ID:
+                    attr_list[attr_idx].value.oid = rpf_member_node->router_intf_id;
+                    break;
+                default:
+                    sai_rc = sai_get_indexed_ret_val(SAI_STATUS_UNKNOWN_ATTRIBUTE_0, attr_idx);
+                    break;
+            }
+            if(sai_rc != SAI_STATUS_SUCCESS) {
+                break;
+            }
+        }
+    }
+    sai_ipmc_unlock();
+
+    return sai_rc;
 }
 
 static sai_rpf_group_api_t sai_ipmc_rpf_group_method_table =
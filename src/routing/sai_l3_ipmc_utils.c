@@ -0,0 +1,647 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file sai_l3_ipmc_utils.c
+*
+* @brief This file contains utility APIs for the SAI IPMC group, RPF group
+*        and IPMC entry caches
+*************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "saitypes.h"
+#include "saistatus.h"
+#include "std_llist.h"
+#include "std_mutex_lock.h"
+#include "std_assert.h"
+#include "std_rbtree.h"
+#include "std_radix.h"
+#include "sai_gen_utils.h"
+#include "sai_oid_utils.h"
+#include "sai_ipmc_common.h"
+#include "sai_l3_mcast_common.h"
+#include "sai_ipmc_api.h"
+
+static rbtree_handle global_ipmc_group_tree;
+static rbtree_handle global_ipmc_group_member_tree;
+static rbtree_handle global_ipmc_rpf_group_tree;
+static rbtree_handle global_ipmc_rpf_group_member_tree;
+static std_mutex_lock_create_static_init_fast(ipmc_lock);
+
+static dn_sai_l3_mcast_global_data_t sai_l3_mcast_global_cache;
+static std_mutex_lock_create_static_init_fast(l3_mcast_lock);
+
+void sai_ipmc_lock(void)
+{
+    std_mutex_lock(&ipmc_lock);
+}
+
+void sai_ipmc_unlock(void)
+{
+    std_mutex_unlock(&ipmc_lock);
+}
+
+sai_status_t sai_ipmc_tree_init(void)
+{
+    SAI_IPMC_LOG_TRACE(SAI_API_IPMC_GROUP, "Performing IPMC Module Init");
+
+    global_ipmc_group_tree = std_rbtree_create_simple("SAI IPMC group tree",
+            STD_STR_OFFSET_OF(dn_sai_ipmc_group_node_t, ipmc_group_id),
+            STD_STR_SIZE_OF(dn_sai_ipmc_group_node_t, ipmc_group_id));
+
+    global_ipmc_group_member_tree = std_rbtree_create_simple("SAI IPMC group member tree",
+            STD_STR_OFFSET_OF(dn_sai_ipmc_group_member_node_t, ipmc_grp_member_id),
+            STD_STR_SIZE_OF(dn_sai_ipmc_group_member_node_t, ipmc_grp_member_id));
+
+    global_ipmc_rpf_group_tree = std_rbtree_create_simple("SAI IPMC RPF group tree",
+            STD_STR_OFFSET_OF(dn_sai_ipmc_rpf_group_node_t, ipmc_rpf_group_id),
+            STD_STR_SIZE_OF(dn_sai_ipmc_rpf_group_node_t, ipmc_rpf_group_id));
+
+    global_ipmc_rpf_group_member_tree = std_rbtree_create_simple("SAI IPMC RPF group member tree",
+            STD_STR_OFFSET_OF(dn_sai_ipmc_rpf_group_member_node_t, ipmc_rpf_grp_member_id),
+            STD_STR_SIZE_OF(dn_sai_ipmc_rpf_group_member_node_t, ipmc_rpf_grp_member_id));
+
+    if((global_ipmc_group_tree == NULL) || (global_ipmc_group_member_tree == NULL) ||
+       (global_ipmc_rpf_group_tree == NULL) || (global_ipmc_rpf_group_member_tree == NULL)) {
+        SAI_IPMC_LOG_CRIT(SAI_API_IPMC_GROUP, "Unable to create the IPMC trees");
+        return SAI_STATUS_UNINITIALIZED;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_add_ipmc_group_node(dn_sai_ipmc_group_node_t *ipmc_group_info)
+{
+    dn_sai_ipmc_group_node_t *ipmc_group_node = NULL;
+
+    STD_ASSERT(ipmc_group_info != NULL);
+
+    if((ipmc_group_node = (dn_sai_ipmc_group_node_t *)
+                calloc(1, sizeof(dn_sai_ipmc_group_node_t))) == NULL) {
+        SAI_IPMC_LOG_CRIT(SAI_API_IPMC_GROUP, "Unable to add IPMC group Id 0x%"PRIx64" "
+                          "memory %lu unavailable", ipmc_group_info->ipmc_group_id,
+                          sizeof(dn_sai_ipmc_group_node_t));
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    memcpy(ipmc_group_node, ipmc_group_info, sizeof(dn_sai_ipmc_group_node_t));
+    std_dll_init(&(ipmc_group_node->member_list));
+    ipmc_group_node->l3_oif_count = 0;
+
+    if(std_rbtree_insert(global_ipmc_group_tree, ipmc_group_node) != STD_ERR_OK) {
+        free(ipmc_group_node);
+        return SAI_STATUS_FAILURE;
+    }
+
+    SAI_IPMC_LOG_TRACE(SAI_API_IPMC_GROUP, "Added IPMC Group id 0x%"PRIx64"",
+                       ipmc_group_info->ipmc_group_id);
+    return SAI_STATUS_SUCCESS;
+}
+
+dn_sai_ipmc_group_node_t * sai_find_ipmc_group_node(sai_object_id_t ipmc_group_id)
+{
+    dn_sai_ipmc_group_node_t ipmc_group_info;
+
+    if(!sai_is_obj_id_ipmc_group(ipmc_group_id)) {
+        return NULL;
+    }
+
+    memset(&ipmc_group_info, 0, sizeof(ipmc_group_info));
+    ipmc_group_info.ipmc_group_id = ipmc_group_id;
+
+    return (dn_sai_ipmc_group_node_t *)
+        std_rbtree_getexact(global_ipmc_group_tree, &ipmc_group_info);
+}
+
+dn_sai_ipmc_group_node_t *sai_ipmc_group_get_next(dn_sai_ipmc_group_node_t *ipmc_group_node)
+{
+    STD_ASSERT(ipmc_group_node != NULL);
+    return (dn_sai_ipmc_group_node_t *)std_rbtree_getnext(global_ipmc_group_tree,
+                                                           ipmc_group_node);
+}
+
+sai_status_t sai_remove_ipmc_group_node(dn_sai_ipmc_group_node_t *ipmc_group_info)
+{
+    dn_sai_ipmc_group_node_t *ipmc_group_node = NULL;
+
+    STD_ASSERT(ipmc_group_info != NULL);
+
+    if(!sai_is_obj_id_ipmc_group(ipmc_group_info->ipmc_group_id)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    ipmc_group_node = (dn_sai_ipmc_group_node_t *)
+        std_rbtree_getexact(global_ipmc_group_tree, ipmc_group_info);
+    if(ipmc_group_node == NULL) {
+        SAI_IPMC_LOG_WARN(SAI_API_IPMC_GROUP, "IPMC Group Id 0x%"PRIx64" not found",
+                          ipmc_group_info->ipmc_group_id);
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    if(ipmc_group_node->l3_oif_count > 0) {
+        return SAI_STATUS_OBJECT_IN_USE;
+    }
+
+    std_rbtree_remove(global_ipmc_group_tree, ipmc_group_node);
+    SAI_IPMC_LOG_TRACE(SAI_API_IPMC_GROUP, "Deleted IPMC Group Id 0x%"PRIx64"",
+                       ipmc_group_node->ipmc_group_id);
+    free(ipmc_group_node);
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_add_ipmc_group_member_node(dn_sai_ipmc_group_member_node_t *ipmc_group_member_info)
+{
+    dn_sai_ipmc_group_member_node_t *ipmc_member_node = NULL;
+    dn_sai_ipmc_group_member_dll_node_t *ipmc_member_dll_node = NULL;
+    dn_sai_ipmc_group_node_t *ipmc_group_node = NULL;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    STD_ASSERT(ipmc_group_member_info != NULL);
+
+    if((ipmc_group_node = sai_find_ipmc_group_node(ipmc_group_member_info->ipmc_group_id))
+            == NULL) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    do {
+        if((ipmc_member_node = (dn_sai_ipmc_group_member_node_t *)
+                    calloc(1, sizeof(dn_sai_ipmc_group_member_node_t))) == NULL) {
+            sai_rc = SAI_STATUS_NO_MEMORY;
+            break;
+        }
+
+        if((ipmc_member_dll_node = (dn_sai_ipmc_group_member_dll_node_t *)
+                    calloc(1, sizeof(dn_sai_ipmc_group_member_dll_node_t))) == NULL) {
+            sai_rc = SAI_STATUS_NO_MEMORY;
+            break;
+        }
+
+        *ipmc_member_node = *ipmc_group_member_info;
+        ipmc_member_dll_node->ipmc_group_member_info = ipmc_member_node;
+
+        if(std_rbtree_insert(global_ipmc_group_member_tree, ipmc_member_node)
+                != STD_ERR_OK) {
+            sai_rc = SAI_STATUS_FAILURE;
+            break;
+        }
+
+        std_dll_insertatback(&(ipmc_group_node->member_list),
+                             &(ipmc_member_dll_node->node));
+        ipmc_group_node->l3_oif_count++;
+
+        SAI_IPMC_LOG_TRACE(SAI_API_IPMC_GROUP, "Added RIF 0x%"PRIx64" to IPMC Group Id 0x%"PRIx64"",
+                           ipmc_group_member_info->router_intf_id,
+                           ipmc_group_member_info->ipmc_group_id);
+    } while(0);
+
+    if(sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_IPMC_LOG_CRIT(SAI_API_IPMC_GROUP, "Unable to add RIF 0x%"PRIx64" to IPMC Group "
+                          "Id 0x%"PRIx64"", ipmc_group_member_info->router_intf_id,
+                          ipmc_group_member_info->ipmc_group_id);
+        free(ipmc_member_node);
+        free(ipmc_member_dll_node);
+    }
+
+    return sai_rc;
+}
+
+dn_sai_ipmc_group_member_node_t* sai_find_ipmc_group_member_node(sai_object_id_t ipmc_group_member_id)
+{
+    dn_sai_ipmc_group_member_node_t ipmc_member_info;
+
+    if(!sai_is_obj_id_ipmc_group_member(ipmc_group_member_id)) {
+        return NULL;
+    }
+
+    memset(&ipmc_member_info, 0, sizeof(ipmc_member_info));
+    ipmc_member_info.ipmc_grp_member_id = ipmc_group_member_id;
+
+    return (dn_sai_ipmc_group_member_node_t *)
+        std_rbtree_getexact(global_ipmc_group_member_tree, &ipmc_member_info);
+}
+
+dn_sai_ipmc_group_member_node_t *sai_ipmc_group_member_get_next(
+        dn_sai_ipmc_group_member_node_t *ipmc_group_member_node)
+{
+    STD_ASSERT(ipmc_group_member_node != NULL);
+    return (dn_sai_ipmc_group_member_node_t *)std_rbtree_getnext(global_ipmc_group_member_tree,
+                                                                  ipmc_group_member_node);
+}
+
+dn_sai_ipmc_group_member_dll_node_t* sai_find_ipmc_group_member_node_from_router_intf(
+        dn_sai_ipmc_group_node_t *ipmc_group_node, sai_object_id_t rtr_intf)
+{
+    dn_sai_ipmc_group_member_dll_node_t *ipmc_member_dll_node = NULL;
+    std_dll *node = NULL;
+
+    if(ipmc_group_node == NULL) {
+        return NULL;
+    }
+
+    for(node = std_dll_getfirst(&(ipmc_group_node->member_list));
+            node != NULL;
+            node = std_dll_getnext(&(ipmc_group_node->member_list), node)) {
+        ipmc_member_dll_node = (dn_sai_ipmc_group_member_dll_node_t *)node;
+        if(ipmc_member_dll_node->ipmc_group_member_info->router_intf_id == rtr_intf) {
+            return ipmc_member_dll_node;
+        }
+    }
+
+    return NULL;
+}
+
+sai_status_t sai_remove_ipmc_group_member_node(dn_sai_ipmc_group_member_node_t *ipmc_group_member_info)
+{
+    dn_sai_ipmc_group_member_dll_node_t *ipmc_member_dll_node = NULL;
+    dn_sai_ipmc_group_member_node_t *ipmc_member_node = NULL;
+    dn_sai_ipmc_group_node_t *ipmc_group_node = NULL;
+
+    STD_ASSERT(ipmc_group_member_info != NULL);
+
+    if((ipmc_group_node = sai_find_ipmc_group_node(ipmc_group_member_info->ipmc_group_id))
+            == NULL) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    ipmc_member_dll_node = sai_find_ipmc_group_member_node_from_router_intf(
+            ipmc_group_node, ipmc_group_member_info->router_intf_id);
+    if(ipmc_member_dll_node == NULL) {
+        return SAI_STATUS_INVALID_PORT_MEMBER;
+    }
+
+    std_dll_remove(&(ipmc_group_node->member_list), &(ipmc_member_dll_node->node));
+    ipmc_group_node->l3_oif_count--;
+
+    ipmc_member_node = std_rbtree_remove(global_ipmc_group_member_tree,
+                                         ipmc_member_dll_node->ipmc_group_member_info);
+
+    SAI_IPMC_LOG_TRACE(SAI_API_IPMC_GROUP, "RIF 0x%"PRIx64" removed from IPMC Group Id 0x%"PRIx64"",
+                       ipmc_group_member_info->router_intf_id, ipmc_group_node->ipmc_group_id);
+    free(ipmc_member_dll_node);
+    free(ipmc_member_node);
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_ipmc_group_rtr_intf_list_get(dn_sai_ipmc_group_node_t *ipmc_group_node,
+        sai_object_list_t *ipmc_rtr_intf_list)
+{
+    dn_sai_ipmc_group_member_dll_node_t *ipmc_member_dll_node = NULL;
+    std_dll *node = NULL;
+    unsigned int member_idx = 0;
+
+    STD_ASSERT(ipmc_group_node != NULL);
+    STD_ASSERT(ipmc_rtr_intf_list != NULL);
+
+    if(ipmc_rtr_intf_list->count < ipmc_group_node->l3_oif_count) {
+        ipmc_rtr_intf_list->count = ipmc_group_node->l3_oif_count;
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    for(node = std_dll_getfirst(&(ipmc_group_node->member_list));
+            node != NULL;
+            node = std_dll_getnext(&(ipmc_group_node->member_list), node)) {
+        ipmc_member_dll_node = (dn_sai_ipmc_group_member_dll_node_t *)node;
+        ipmc_rtr_intf_list->list[member_idx++] =
+            ipmc_member_dll_node->ipmc_group_member_info->ipmc_grp_member_id;
+    }
+
+    ipmc_rtr_intf_list->count = member_idx;
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_add_ipmc_rpf_group_node(dn_sai_ipmc_rpf_group_node_t *ipmc_rpf_group_info)
+{
+    dn_sai_ipmc_rpf_group_node_t *ipmc_rpf_group_node = NULL;
+
+    STD_ASSERT(ipmc_rpf_group_info != NULL);
+
+    if((ipmc_rpf_group_node = (dn_sai_ipmc_rpf_group_node_t *)
+                calloc(1, sizeof(dn_sai_ipmc_rpf_group_node_t))) == NULL) {
+        SAI_IPMC_LOG_CRIT(SAI_API_RPF_GROUP, "Unable to add RPF group Id 0x%"PRIx64" "
+                          "memory %lu unavailable", ipmc_rpf_group_info->ipmc_rpf_group_id,
+                          sizeof(dn_sai_ipmc_rpf_group_node_t));
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    memcpy(ipmc_rpf_group_node, ipmc_rpf_group_info, sizeof(dn_sai_ipmc_rpf_group_node_t));
+    std_dll_init(&(ipmc_rpf_group_node->member_list));
+    ipmc_rpf_group_node->l3_iif_count = 0;
+
+    if(std_rbtree_insert(global_ipmc_rpf_group_tree, ipmc_rpf_group_node) != STD_ERR_OK) {
+        free(ipmc_rpf_group_node);
+        return SAI_STATUS_FAILURE;
+    }
+
+    SAI_IPMC_LOG_TRACE(SAI_API_RPF_GROUP, "Added RPF Group id 0x%"PRIx64"",
+                       ipmc_rpf_group_info->ipmc_rpf_group_id);
+    return SAI_STATUS_SUCCESS;
+}
+
+dn_sai_ipmc_rpf_group_node_t * sai_find_ipmc_rpf_group_node(sai_object_id_t ipmc_rpf_group_id)
+{
+    dn_sai_ipmc_rpf_group_node_t ipmc_rpf_group_info;
+
+    if(!sai_is_obj_id_rpf_group(ipmc_rpf_group_id)) {
+        return NULL;
+    }
+
+    memset(&ipmc_rpf_group_info, 0, sizeof(ipmc_rpf_group_info));
+    ipmc_rpf_group_info.ipmc_rpf_group_id = ipmc_rpf_group_id;
+
+    return (dn_sai_ipmc_rpf_group_node_t *)
+        std_rbtree_getexact(global_ipmc_rpf_group_tree, &ipmc_rpf_group_info);
+}
+
+dn_sai_ipmc_rpf_group_node_t *sai_ipmc_rpf_group_get_next(dn_sai_ipmc_rpf_group_node_t *ipmc_rpf_group_node)
+{
+    STD_ASSERT(ipmc_rpf_group_node != NULL);
+    return (dn_sai_ipmc_rpf_group_node_t *)std_rbtree_getnext(global_ipmc_rpf_group_tree,
+                                                               ipmc_rpf_group_node);
+}
+
+sai_status_t sai_remove_ipmc_rpf_group_node(dn_sai_ipmc_rpf_group_node_t *ipmc_rpf_group_info)
+{
+    dn_sai_ipmc_rpf_group_node_t *ipmc_rpf_group_node = NULL;
+
+    STD_ASSERT(ipmc_rpf_group_info != NULL);
+
+    if(!sai_is_obj_id_rpf_group(ipmc_rpf_group_info->ipmc_rpf_group_id)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    ipmc_rpf_group_node = (dn_sai_ipmc_rpf_group_node_t *)
+        std_rbtree_getexact(global_ipmc_rpf_group_tree, ipmc_rpf_group_info);
+    if(ipmc_rpf_group_node == NULL) {
+        SAI_IPMC_LOG_WARN(SAI_API_RPF_GROUP, "RPF Group Id 0x%"PRIx64" not found",
+                          ipmc_rpf_group_info->ipmc_rpf_group_id);
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    if(ipmc_rpf_group_node->l3_iif_count > 0) {
+        return SAI_STATUS_OBJECT_IN_USE;
+    }
+
+    std_rbtree_remove(global_ipmc_rpf_group_tree, ipmc_rpf_group_node);
+    SAI_IPMC_LOG_TRACE(SAI_API_RPF_GROUP, "Deleted RPF Group Id 0x%"PRIx64"",
+                       ipmc_rpf_group_node->ipmc_rpf_group_id);
+    free(ipmc_rpf_group_node);
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_add_ipmc_rpf_group_member_node(
+        dn_sai_ipmc_rpf_group_member_node_t *ipmc_rpf_group_member_info)
+{
+    dn_sai_ipmc_rpf_group_member_node_t *rpf_member_node = NULL;
+    dn_sai_ipmc_rpf_group_member_dll_node_t *rpf_member_dll_node = NULL;
+    dn_sai_ipmc_rpf_group_node_t *ipmc_rpf_group_node = NULL;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    STD_ASSERT(ipmc_rpf_group_member_info != NULL);
+
+    if((ipmc_rpf_group_node = sai_find_ipmc_rpf_group_node(
+                    ipmc_rpf_group_member_info->ipmc_rpf_group_id)) == NULL) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    do {
+        if((rpf_member_node = (dn_sai_ipmc_rpf_group_member_node_t *)
+                    calloc(1, sizeof(dn_sai_ipmc_rpf_group_member_node_t))) == NULL) {
+            sai_rc = SAI_STATUS_NO_MEMORY;
+            break;
+        }
+
+        if((rpf_member_dll_node = (dn_sai_ipmc_rpf_group_member_dll_node_t *)
+                    calloc(1, sizeof(dn_sai_ipmc_rpf_group_member_dll_node_t))) == NULL) {
+            sai_rc = SAI_STATUS_NO_MEMORY;
+            break;
+        }
+
+        *rpf_member_node = *ipmc_rpf_group_member_info;
+        rpf_member_dll_node->ipmc_rpf_group_member_info = rpf_member_node;
+
+        if(std_rbtree_insert(global_ipmc_rpf_group_member_tree, rpf_member_node)
+                != STD_ERR_OK) {
+            sai_rc = SAI_STATUS_FAILURE;
+            break;
+        }
+
+        std_dll_insertatback(&(ipmc_rpf_group_node->member_list),
+                             &(rpf_member_dll_node->node));
+        ipmc_rpf_group_node->l3_iif_count++;
+
+        SAI_IPMC_LOG_TRACE(SAI_API_RPF_GROUP, "Added RIF 0x%"PRIx64" to RPF Group Id 0x%"PRIx64"",
+                           ipmc_rpf_group_member_info->router_intf_id,
+                           ipmc_rpf_group_member_info->ipmc_rpf_group_id);
+    } while(0);
+
+    if(sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_IPMC_LOG_CRIT(SAI_API_RPF_GROUP, "Unable to add RIF 0x%"PRIx64" to RPF Group "
+                          "Id 0x%"PRIx64"", ipmc_rpf_group_member_info->router_intf_id,
+                          ipmc_rpf_group_member_info->ipmc_rpf_group_id);
+        free(rpf_member_node);
+        free(rpf_member_dll_node);
+    }
+
+    return sai_rc;
+}
+
+dn_sai_ipmc_rpf_group_member_node_t *sai_find_ipmc_rpf_group_member_node(
+        sai_object_id_t ipmc_rpf_group_member_id)
+{
+    dn_sai_ipmc_rpf_group_member_node_t rpf_member_info;
+
+    if(!sai_is_obj_id_rpf_group_member(ipmc_rpf_group_member_id)) {
+        return NULL;
+    }
+
+    memset(&rpf_member_info, 0, sizeof(rpf_member_info));
+    rpf_member_info.ipmc_rpf_grp_member_id = ipmc_rpf_group_member_id;
+
+    return (dn_sai_ipmc_rpf_group_member_node_t *)
+        std_rbtree_getexact(global_ipmc_rpf_group_member_tree, &rpf_member_info);
+}
+
+dn_sai_ipmc_rpf_group_member_node_t *sai_ipmc_rpf_group_member_get_next(
+        dn_sai_ipmc_rpf_group_member_node_t *ipmc_rpf_group_member_node)
+{
+    STD_ASSERT(ipmc_rpf_group_member_node != NULL);
+    return (dn_sai_ipmc_rpf_group_member_node_t *)std_rbtree_getnext(
+            global_ipmc_rpf_group_member_tree, ipmc_rpf_group_member_node);
+}
+
+dn_sai_ipmc_rpf_group_member_dll_node_t* sai_find_ipmc_rpf_group_member_node_from_router_intf(
+        dn_sai_ipmc_rpf_group_node_t *ipmc_rpf_group_node, sai_object_id_t rtr_intf)
+{
+    dn_sai_ipmc_rpf_group_member_dll_node_t *rpf_member_dll_node = NULL;
+    std_dll *node = NULL;
+
+    if(ipmc_rpf_group_node == NULL) {
+        return NULL;
+    }
+
+    for(node = std_dll_getfirst(&(ipmc_rpf_group_node->member_list));
+            node != NULL;
+            node = std_dll_getnext(&(ipmc_rpf_group_node->member_list), node)) {
+        rpf_member_dll_node = (dn_sai_ipmc_rpf_group_member_dll_node_t *)node;
+        if(rpf_member_dll_node->ipmc_rpf_group_member_info->router_intf_id == rtr_intf) {
+            return rpf_member_dll_node;
+        }
+    }
+
+    return NULL;
+}
+
+sai_status_t sai_remove_ipmc_rpf_group_member_node(
+        dn_sai_ipmc_rpf_group_member_node_t *ipmc_rpf_group_member_info)
+{
+    dn_sai_ipmc_rpf_group_member_dll_node_t *rpf_member_dll_node = NULL;
+    dn_sai_ipmc_rpf_group_member_node_t *rpf_member_node = NULL;
+    dn_sai_ipmc_rpf_group_node_t *ipmc_rpf_group_node = NULL;
+
+    STD_ASSERT(ipmc_rpf_group_member_info != NULL);
+
+    if((ipmc_rpf_group_node = sai_find_ipmc_rpf_group_node(
+                    ipmc_rpf_group_member_info->ipmc_rpf_group_id)) == NULL) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    rpf_member_dll_node = sai_find_ipmc_rpf_group_member_node_from_router_intf(
+            ipmc_rpf_group_node, ipmc_rpf_group_member_info->router_intf_id);
+    if(rpf_member_dll_node == NULL) {
+        return SAI_STATUS_INVALID_PORT_MEMBER;
+    }
+
+    std_dll_remove(&(ipmc_rpf_group_node->member_list), &(rpf_member_dll_node->node));
+    ipmc_rpf_group_node->l3_iif_count--;
+
+    rpf_member_node = std_rbtree_remove(global_ipmc_rpf_group_member_tree,
+                                        rpf_member_dll_node->ipmc_rpf_group_member_info);
+
+    SAI_IPMC_LOG_TRACE(SAI_API_RPF_GROUP, "RIF 0x%"PRIx64" removed from RPF Group Id 0x%"PRIx64"",
+                       ipmc_rpf_group_member_info->router_intf_id,
+                       ipmc_rpf_group_node->ipmc_rpf_group_id);
+    free(rpf_member_dll_node);
+    free(rpf_member_node);
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_ipmc_rpf_group_rtr_intf_list_get(dn_sai_ipmc_rpf_group_node_t *ipmc_rpf_group_node,
+        sai_object_list_t *ipmc_rtr_intf_list)
+{
+    dn_sai_ipmc_rpf_group_member_dll_node_t *rpf_member_dll_node = NULL;
+    std_dll *node = NULL;
+    unsigned int member_idx = 0;
+
+    STD_ASSERT(ipmc_rpf_group_node != NULL);
+    STD_ASSERT(ipmc_rtr_intf_list != NULL);
+
+    if(ipmc_rtr_intf_list->count < ipmc_rpf_group_node->l3_iif_count) {
+        ipmc_rtr_intf_list->count = ipmc_rpf_group_node->l3_iif_count;
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    for(node = std_dll_getfirst(&(ipmc_rpf_group_node->member_list));
+            node != NULL;
+            node = std_dll_getnext(&(ipmc_rpf_group_node->member_list), node)) {
+        rpf_member_dll_node = (dn_sai_ipmc_rpf_group_member_dll_node_t *)node;
+        ipmc_rtr_intf_list->list[member_idx++] =
+            rpf_member_dll_node->ipmc_rpf_group_member_info->ipmc_rpf_grp_member_id;
+    }
+
+    ipmc_rtr_intf_list->count = member_idx;
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_l3_mcast_lock(void)
+{
+    std_mutex_lock(&l3_mcast_lock);
+}
+
+void sai_l3_mcast_unlock(void)
+{
+    std_mutex_unlock(&l3_mcast_lock);
+}
+
+sai_status_t sai_l3_mcast_init(void)
+{
+    SAI_L3_MCAST_LOG_TRACE("Performing L3 MCAST Cache Init");
+
+    sai_l3_mcast_global_cache.sai_global_mcast_tree = std_radix_create("L3MCASTCache",
+            SAI_L3_MCAST_ENTRY_KEY_SIZE, NULL, NULL, 0);
+    if(sai_l3_mcast_global_cache.sai_global_mcast_tree == NULL) {
+        SAI_L3_MCAST_LOG_CRIT("Unable to create L3 MCAST Cache");
+        return SAI_STATUS_UNINITIALIZED;
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
+dn_sai_l3_mcast_entry_node_t * sai_find_l3_mcast_entry(dn_sai_l3_mcast_entry_node_t *entry_node)
+{
+    STD_ASSERT(entry_node != NULL);
+
+    return (dn_sai_l3_mcast_entry_node_t *)std_radix_getexact(
+            sai_l3_mcast_global_cache.sai_global_mcast_tree,
+            (u_char *)&entry_node->mcast_key, SAI_L3_MCAST_ENTRY_KEY_SIZE);
+}
+
+dn_sai_l3_mcast_entry_node_t *sai_get_next_l3_mcast_entry_node(dn_sai_l3_mcast_entry_key_t *l3_mcast_key)
+{
+    STD_ASSERT(l3_mcast_key != NULL);
+
+    return (dn_sai_l3_mcast_entry_node_t *)std_radix_getnext(
+            sai_l3_mcast_global_cache.sai_global_mcast_tree,
+            (u_char *)l3_mcast_key, SAI_L3_MCAST_ENTRY_KEY_SIZE);
+}
+
+sai_status_t sai_insert_l3_mcast_entry_node(dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node)
+{
+    dn_sai_l3_mcast_entry_node_t *tmp_node = NULL;
+
+    STD_ASSERT(l3_mcast_entry_node != NULL);
+
+    if(sai_find_l3_mcast_entry(l3_mcast_entry_node) != NULL) {
+        return SAI_STATUS_ITEM_ALREADY_EXISTS;
+    }
+
+    if((tmp_node = (dn_sai_l3_mcast_entry_node_t *)
+                calloc(1, sizeof(dn_sai_l3_mcast_entry_node_t))) == NULL) {
+        SAI_L3_MCAST_LOG_ERR("Failed to allocate memory for L3 MCAST Entry node");
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    memcpy(tmp_node, l3_mcast_entry_node, sizeof(dn_sai_l3_mcast_entry_node_t));
+    tmp_node->mcast_rt_head.rth_addr = (unsigned char *) &tmp_node->mcast_key;
+    if(std_radix_insert(sai_l3_mcast_global_cache.sai_global_mcast_tree,
+                        &(tmp_node->mcast_rt_head), SAI_L3_MCAST_ENTRY_KEY_SIZE) == NULL) {
+        SAI_L3_MCAST_LOG_CRIT("Unable to add L3 MCAST Node");
+        free(tmp_node);
+        return SAI_STATUS_FAILURE;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_remove_l3_mcast_entry_node(dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node)
+{
+    STD_ASSERT(l3_mcast_entry_node != NULL);
+
+    std_radix_remove(sai_l3_mcast_global_cache.sai_global_mcast_tree,
+                     &(l3_mcast_entry_node->mcast_rt_head));
+    free(l3_mcast_entry_node);
+    return SAI_STATUS_SUCCESS;
+}
@@ -0,0 +1,816 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file sai_l3_lpm.c
+*
+* @brief This file contains function definitions for the compiled longest
+*        prefix match table mirroring the route tree of a VRF.
+*
+*************************************************************************/
+#include "sai_l3_lpm.h"
+#include "sai_l3_util.h"
+#include "saitypes.h"
+#include "saistatus.h"
+#include "std_assert.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Table entry encoding:
+ *   bit 31     - entry points to a group of the next stride
+ *   bits 30-24 - length minus one of the prefix owning the entry
+ *   bits 23-0  - leaf index, or group index for group entries
+ * An all zero entry has no prefix and resolves to the default route.
+ */
+#define SAI_FIB_LPM_ENTRY_GROUP          (0x80000000)
+#define SAI_FIB_LPM_ENTRY_DEPTH_SHIFT    (24)
+#define SAI_FIB_LPM_ENTRY_DEPTH_MASK     (0x7f)
+#define SAI_FIB_LPM_ENTRY_INDEX_MASK     (0x00ffffff)
+
+#define SAI_FIB_LPM_MAX_GROUPS \
+        (SAI_FIB_LPM_GROUPS_PER_CHUNK * SAI_FIB_LPM_MAX_GROUP_CHUNKS)
+
+#define SAI_FIB_LPM_MAX_LEAVES \
+        (SAI_FIB_LPM_LEAVES_PER_CHUNK * SAI_FIB_LPM_MAX_LEAF_CHUNKS)
+
+/*
+ * Lookups register in the reader count of the parity of the epoch they
+ * start in. The writer moves to the next epoch only once no lookup of the
+ * epoch before the current one is left, so once the epoch is two past the
+ * one an index was freed in, no lookup that could have reached it is left.
+ */
+typedef struct _sai_fib_lpm_epoch_t {
+    uint32_t epoch;
+    uint32_t readers [2];
+} sai_fib_lpm_epoch_t;
+
+/* Freed index and the epoch it was freed in */
+typedef struct _sai_fib_lpm_free_idx_t {
+    uint32_t idx;
+    uint32_t epoch;
+} sai_fib_lpm_free_idx_t;
+
+/* Index queue; freed indices are reused oldest first */
+typedef struct _sai_fib_lpm_idx_fifo_t {
+    sai_fib_lpm_free_idx_t *idx;
+    uint_t                  head;
+    uint_t                  count;
+    uint_t                  size;
+} sai_fib_lpm_idx_fifo_t;
+
+typedef struct _sai_fib_lpm_leaf_t {
+    /* Odd while the leaf is being written */
+    uint32_t          seq;
+    sai_fib_lpm_nh_t  nh;
+} sai_fib_lpm_leaf_t;
+
+typedef struct _sai_fib_lpm_table_t {
+    uint_t                  key_bits;
+    uint_t                  root_bits;
+    uint32_t               *root;
+    /* Leaf of the default route */
+    uint32_t                default_leaf;
+    uint32_t               *group_chunks [SAI_FIB_LPM_MAX_GROUP_CHUNKS];
+    /* Groups ever handed out */
+    uint32_t                group_hwm;
+    uint_t                  group_count;
+    sai_fib_lpm_idx_fifo_t  free_groups;
+    /* Reader epoch of the LPM table holding this table */
+    sai_fib_lpm_epoch_t    *p_epoch;
+} sai_fib_lpm_table_t;
+
+struct _sai_fib_lpm_t {
+    sai_fib_lpm_table_t     ipv4;
+    sai_fib_lpm_table_t     ipv6;
+    sai_fib_lpm_leaf_t     *leaf_chunks [SAI_FIB_LPM_MAX_LEAF_CHUNKS];
+    uint32_t                leaf_hwm;
+    uint_t                  leaf_count;
+    sai_fib_lpm_idx_fifo_t  free_leaves;
+    sai_fib_lpm_epoch_t     epoch;
+};
+
+static inline uint32_t sai_fib_lpm_load (const uint32_t *p_entry)
+{
+    return __atomic_load_n (p_entry, __ATOMIC_ACQUIRE);
+}
+
+static inline void sai_fib_lpm_store (uint32_t *p_entry, uint32_t entry)
+{
+    __atomic_store_n (p_entry, entry, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t sai_fib_lpm_entry_make (uint_t leaf, uint_t depth)
+{
+    if (leaf == SAI_FIB_LPM_LEAF_NONE) {
+        return 0;
+    }
+
+    /* Prefixes in the entries are never of length 0, see the default leaf */
+    return (((depth - 1) & SAI_FIB_LPM_ENTRY_DEPTH_MASK) << SAI_FIB_LPM_ENTRY_DEPTH_SHIFT) |
+           (leaf & SAI_FIB_LPM_ENTRY_INDEX_MASK);
+}
+
+static inline uint_t sai_fib_lpm_entry_depth (uint32_t entry)
+{
+    if (entry == 0) {
+        return 0;
+    }
+
+    return ((entry >> SAI_FIB_LPM_ENTRY_DEPTH_SHIFT) & SAI_FIB_LPM_ENTRY_DEPTH_MASK) + 1;
+}
+
+static inline bool sai_fib_lpm_entry_is_group (uint32_t entry)
+{
+    return ((entry & SAI_FIB_LPM_ENTRY_GROUP) != 0);
+}
+
+static inline uint_t sai_fib_lpm_entry_index (uint32_t entry)
+{
+    return (entry & SAI_FIB_LPM_ENTRY_INDEX_MASK);
+}
+
+/* Strides are byte aligned, so a table index is a run of key bytes */
+static inline uint_t sai_fib_lpm_key_index (const uint8_t *key, uint_t off,
+                                            uint_t bits)
+{
+    uint_t index = 0;
+    uint_t byte;
+
+    for (byte = off / BITS_PER_BYTE; byte < (off + bits) / BITS_PER_BYTE; byte++) {
+        index = (index << BITS_PER_BYTE) | key [byte];
+    }
+
+    return index;
+}
+
+static inline const uint8_t *sai_fib_lpm_key_get (const sai_ip_address_t *p_addr)
+{
+    return ((p_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV4) ?
+            (const uint8_t *) &p_addr->addr.ip4 : p_addr->addr.ip6);
+}
+
+static inline sai_fib_lpm_table_t *sai_fib_lpm_table_get (sai_fib_lpm_t *p_lpm,
+                                                          const sai_ip_address_t *p_addr)
+{
+    return ((p_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV4) ?
+            &p_lpm->ipv4 : &p_lpm->ipv6);
+}
+
+static inline uint32_t *sai_fib_lpm_group_get (const sai_fib_lpm_table_t *p_table,
+                                               uint_t group)
+{
+    uint32_t *p_chunk =
+        __atomic_load_n (&p_table->group_chunks [group / SAI_FIB_LPM_GROUPS_PER_CHUNK],
+                         __ATOMIC_ACQUIRE);
+
+    return p_chunk + ((group % SAI_FIB_LPM_GROUPS_PER_CHUNK) * SAI_FIB_LPM_GROUP_SIZE);
+}
+
+static inline sai_fib_lpm_leaf_t *sai_fib_lpm_leaf_get (const sai_fib_lpm_t *p_lpm,
+                                                        uint_t leaf)
+{
+    sai_fib_lpm_leaf_t *p_chunk =
+        __atomic_load_n (&p_lpm->leaf_chunks [leaf / SAI_FIB_LPM_LEAVES_PER_CHUNK],
+                         __ATOMIC_ACQUIRE);
+
+    return p_chunk + (leaf % SAI_FIB_LPM_LEAVES_PER_CHUNK);
+}
+
+static inline uint32_t sai_fib_lpm_reader_enter (sai_fib_lpm_epoch_t *p_epoch)
+{
+    uint32_t epoch;
+
+    for (;;) {
+        epoch = __atomic_load_n (&p_epoch->epoch, __ATOMIC_SEQ_CST);
+
+        __atomic_fetch_add (&p_epoch->readers [epoch & 1], 1, __ATOMIC_SEQ_CST);
+
+        /* Counted in the epoch it started in, or the writer may miss it */
+        if (__atomic_load_n (&p_epoch->epoch, __ATOMIC_SEQ_CST) == epoch) {
+            return epoch;
+        }
+
+        __atomic_fetch_sub (&p_epoch->readers [epoch & 1], 1, __ATOMIC_RELEASE);
+    }
+}
+
+static inline void sai_fib_lpm_reader_exit (sai_fib_lpm_epoch_t *p_epoch,
+                                            uint32_t epoch)
+{
+    __atomic_fetch_sub (&p_epoch->readers [epoch & 1], 1, __ATOMIC_RELEASE);
+}
+
+/* Move to the next epoch once no lookup of the epoch before is left */
+static bool sai_fib_lpm_epoch_advance (sai_fib_lpm_epoch_t *p_epoch)
+{
+    uint32_t epoch = p_epoch->epoch;
+
+    if (__atomic_load_n (&p_epoch->readers [(epoch + 1) & 1], __ATOMIC_SEQ_CST) != 0) {
+        return false;
+    }
+
+    __atomic_store_n (&p_epoch->epoch, epoch + 1, __ATOMIC_SEQ_CST);
+
+    return true;
+}
+
+static bool sai_fib_lpm_idx_push (sai_fib_lpm_idx_fifo_t *p_fifo,
+                                  sai_fib_lpm_epoch_t *p_epoch, uint32_t idx)
+{
+    if (p_fifo->count == p_fifo->size) {
+        uint_t                  size = (p_fifo->size != 0) ? (p_fifo->size * 2) : 64;
+        sai_fib_lpm_free_idx_t *p_idx = calloc (size, sizeof (sai_fib_lpm_free_idx_t));
+        uint_t                  i;
+
+        if (p_idx == NULL) {
+            return false;
+        }
+
+        for (i = 0; i < p_fifo->count; i++) {
+            p_idx [i] = p_fifo->idx [(p_fifo->head + i) % p_fifo->size];
+        }
+
+        free (p_fifo->idx);
+        p_fifo->idx = p_idx;
+        p_fifo->head = 0;
+        p_fifo->size = size;
+    }
+
+    p_fifo->idx [(p_fifo->head + p_fifo->count) % p_fifo->size].idx = idx;
+    p_fifo->idx [(p_fifo->head + p_fifo->count) % p_fifo->size].epoch = p_epoch->epoch;
+    p_fifo->count++;
+
+    /* Let the grace period run, so that a later pop seldom finds it running */
+    sai_fib_lpm_epoch_advance (p_epoch);
+
+    return true;
+}
+
+/*
+ * Pop the oldest freed index if no lookup can still be reading it. The
+ * caller holds the FIB lock, so the lookups are not waited for; the caller
+ * takes a never used index instead.
+ */
+static bool sai_fib_lpm_idx_pop (sai_fib_lpm_idx_fifo_t *p_fifo,
+                                 sai_fib_lpm_epoch_t *p_epoch, uint32_t *p_idx)
+{
+    if (p_fifo->count == 0) {
+        return false;
+    }
+
+    /* At most two advances, each failing at once on a lookup in flight */
+    while ((p_epoch->epoch - p_fifo->idx [p_fifo->head].epoch) < 2) {
+        if (!sai_fib_lpm_epoch_advance (p_epoch)) {
+            return false;
+        }
+    }
+
+    *p_idx = p_fifo->idx [p_fifo->head].idx;
+    p_fifo->head = (p_fifo->head + 1) % p_fifo->size;
+    p_fifo->count--;
+
+    return true;
+}
+
+/*
+ * Lookups are lock free, so a freed group or leaf may still be read by a
+ * lookup that started before it was unlinked. A freed index is handed out
+ * again once the lookups that could reach it are done, see
+ * sai_fib_lpm_epoch_t. Until then a never used index is handed out, from a
+ * new chunk if need be.
+ */
+static bool sai_fib_lpm_group_alloc (sai_fib_lpm_table_t *p_table, uint32_t *p_group)
+{
+    uint_t chunk = p_table->group_hwm / SAI_FIB_LPM_GROUPS_PER_CHUNK;
+
+    if (sai_fib_lpm_idx_pop (&p_table->free_groups, p_table->p_epoch, p_group)) {
+        p_table->group_count++;
+        return true;
+    }
+
+    if (p_table->group_hwm < SAI_FIB_LPM_MAX_GROUPS) {
+
+        if (p_table->group_chunks [chunk] == NULL) {
+            uint32_t *p_chunk = calloc (SAI_FIB_LPM_GROUPS_PER_CHUNK *
+                                        SAI_FIB_LPM_GROUP_SIZE, sizeof (uint32_t));
+
+            if (p_chunk != NULL) {
+                __atomic_store_n (&p_table->group_chunks [chunk], p_chunk,
+                                  __ATOMIC_RELEASE);
+            }
+        }
+
+        if (p_table->group_chunks [chunk] != NULL) {
+            *p_group = p_table->group_hwm++;
+            p_table->group_count++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void sai_fib_lpm_group_free (sai_fib_lpm_table_t *p_table, uint32_t group)
+{
+    p_table->group_count--;
+
+    if (!sai_fib_lpm_idx_push (&p_table->free_groups, p_table->p_epoch, group)) {
+        /* Leaked until the table is destroyed */
+        SAI_ROUTE_LOG_ERR ("Failed to queue freed LPM group %u.", group);
+    }
+}
+
+static uint_t sai_fib_lpm_leaf_alloc (sai_fib_lpm_t *p_lpm)
+{
+    uint_t   chunk = p_lpm->leaf_hwm / SAI_FIB_LPM_LEAVES_PER_CHUNK;
+    uint32_t leaf;
+
+    if (sai_fib_lpm_idx_pop (&p_lpm->free_leaves, &p_lpm->epoch, &leaf)) {
+        p_lpm->leaf_count++;
+        return leaf;
+    }
+
+    if (p_lpm->leaf_hwm < SAI_FIB_LPM_MAX_LEAVES) {
+
+        if (p_lpm->leaf_chunks [chunk] == NULL) {
+            sai_fib_lpm_leaf_t *p_chunk = calloc (SAI_FIB_LPM_LEAVES_PER_CHUNK,
+                                                  sizeof (sai_fib_lpm_leaf_t));
+
+            if (p_chunk != NULL) {
+                __atomic_store_n (&p_lpm->leaf_chunks [chunk], p_chunk,
+                                  __ATOMIC_RELEASE);
+            }
+        }
+
+        if (p_lpm->leaf_chunks [chunk] != NULL) {
+            p_lpm->leaf_count++;
+            return p_lpm->leaf_hwm++;
+        }
+    }
+
+    return SAI_FIB_LPM_LEAF_NONE;
+}
+
+static void sai_fib_lpm_leaf_free (sai_fib_lpm_t *p_lpm, uint_t leaf)
+{
+    p_lpm->leaf_count--;
+
+    if (!sai_fib_lpm_idx_push (&p_lpm->free_leaves, &p_lpm->epoch, leaf)) {
+        SAI_ROUTE_LOG_ERR ("Failed to queue freed LPM leaf %u.", leaf);
+    }
+}
+
+/* Sequence lock writer side, lookups retry while a leaf is being written */
+static void sai_fib_lpm_leaf_write (sai_fib_lpm_leaf_t *p_leaf,
+                                    const sai_fib_lpm_nh_t *p_nh, uint_t prefix_len)
+{
+    uint32_t seq = p_leaf->seq;
+
+    __atomic_store_n (&p_leaf->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence (__ATOMIC_RELEASE);
+
+    p_leaf->nh = *p_nh;
+    p_leaf->nh.prefix_len = prefix_len;
+
+    __atomic_store_n (&p_leaf->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+static void sai_fib_lpm_leaf_read (const sai_fib_lpm_leaf_t *p_leaf,
+                                   sai_fib_lpm_nh_t *p_nh)
+{
+    uint32_t seq;
+
+    do {
+        seq = __atomic_load_n (&p_leaf->seq, __ATOMIC_ACQUIRE);
+
+        *p_nh = p_leaf->nh;
+
+        __atomic_thread_fence (__ATOMIC_ACQUIRE);
+    } while ((seq & 1) || (seq != __atomic_load_n (&p_leaf->seq, __ATOMIC_RELAXED)));
+}
+
+/* Overwrite the entries owned by prefixes no longer than depth */
+static void sai_fib_lpm_entry_fill (sai_fib_lpm_table_t *p_table, uint32_t *p_entry,
+                                    uint_t depth, uint32_t entry)
+{
+    uint32_t cur = *p_entry;
+    uint32_t *p_group = NULL;
+    uint_t    idx;
+
+    if (sai_fib_lpm_entry_is_group (cur)) {
+        p_group = sai_fib_lpm_group_get (p_table, sai_fib_lpm_entry_index (cur));
+
+        for (idx = 0; idx < SAI_FIB_LPM_GROUP_SIZE; idx++) {
+            sai_fib_lpm_entry_fill (p_table, &p_group [idx], depth, entry);
+        }
+    } else if (sai_fib_lpm_entry_depth (cur) <= depth) {
+        sai_fib_lpm_store (p_entry, entry);
+    }
+}
+
+/* Fold a group back in its parent entry once all its entries are the same */
+static void sai_fib_lpm_group_collapse (sai_fib_lpm_table_t *p_table,
+                                        uint32_t *p_parent)
+{
+    uint32_t  cur = *p_parent;
+    uint32_t *p_group = NULL;
+    uint_t    idx;
+
+    if (!sai_fib_lpm_entry_is_group (cur)) {
+        return;
+    }
+
+    p_group = sai_fib_lpm_group_get (p_table, sai_fib_lpm_entry_index (cur));
+
+    if (sai_fib_lpm_entry_is_group (p_group [0])) {
+        return;
+    }
+
+    for (idx = 1; idx < SAI_FIB_LPM_GROUP_SIZE; idx++) {
+        if (p_group [idx] != p_group [0]) {
+            return;
+        }
+    }
+
+    sai_fib_lpm_store (p_parent, p_group [0]);
+
+    sai_fib_lpm_group_free (p_table, sai_fib_lpm_entry_index (cur));
+}
+
+/* Restore the entries owned by the prefix of length depth to the cover */
+static void sai_fib_lpm_entry_unfill (sai_fib_lpm_table_t *p_table, uint32_t *p_entry,
+                                      uint_t depth, uint32_t cover)
+{
+    uint32_t cur = *p_entry;
+    uint32_t *p_group = NULL;
+    uint_t    idx;
+
+    if (sai_fib_lpm_entry_is_group (cur)) {
+        p_group = sai_fib_lpm_group_get (p_table, sai_fib_lpm_entry_index (cur));
+
+        for (idx = 0; idx < SAI_FIB_LPM_GROUP_SIZE; idx++) {
+            sai_fib_lpm_entry_unfill (p_table, &p_group [idx], depth, cover);
+        }
+
+        sai_fib_lpm_group_collapse (p_table, p_entry);
+
+    } else if (sai_fib_lpm_entry_depth (cur) == depth) {
+        sai_fib_lpm_store (p_entry, cover);
+    }
+}
+
+static sai_status_t sai_fib_lpm_table_add (sai_fib_lpm_table_t *p_table,
+                                           const uint8_t *key, uint_t depth,
+                                           uint32_t entry)
+{
+    uint32_t *p_tbl = p_table->root;
+    uint_t    off = 0;
+    uint_t    stride = p_table->root_bits;
+    uint_t    span;
+    uint_t    idx;
+    uint_t    i;
+
+    if (p_tbl == NULL) {
+        /* Lazily allocated; only the pages that get written are backed */
+        p_tbl = calloc (1 << p_table->root_bits, sizeof (uint32_t));
+
+        if (p_tbl == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        __atomic_store_n (&p_table->root, p_tbl, __ATOMIC_RELEASE);
+    }
+
+    /* Walk down to the table holding the last bits of the prefix */
+    while (depth > (off + stride)) {
+        uint32_t *p_entry = &p_tbl [sai_fib_lpm_key_index (key, off, stride)];
+        uint32_t  group;
+
+        if (!sai_fib_lpm_entry_is_group (*p_entry)) {
+            uint32_t *p_group = NULL;
+
+            if (!sai_fib_lpm_group_alloc (p_table, &group)) {
+                return SAI_STATUS_NO_MEMORY;
+            }
+
+            /* The new group inherits the entry it replaces */
+            p_group = sai_fib_lpm_group_get (p_table, group);
+            for (i = 0; i < SAI_FIB_LPM_GROUP_SIZE; i++) {
+                p_group [i] = *p_entry;
+            }
+
+            sai_fib_lpm_store (p_entry, SAI_FIB_LPM_ENTRY_GROUP | group);
+        }
+
+        p_tbl = sai_fib_lpm_group_get (p_table, sai_fib_lpm_entry_index (*p_entry));
+        off += stride;
+        stride = SAI_FIB_LPM_GROUP_BITS;
+    }
+
+    span = 1 << (off + stride - depth);
+    idx = sai_fib_lpm_key_index (key, off, stride) & ~(span - 1);
+
+    for (i = idx; i < (idx + span); i++) {
+        sai_fib_lpm_entry_fill (p_table, &p_tbl [i], depth, entry);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_fib_lpm_table_remove (sai_fib_lpm_table_t *p_table,
+                                      const uint8_t *key, uint_t depth,
+                                      uint32_t cover)
+{
+    /* Entries on the path to the prefix, deepest last */
+    uint32_t *path [SAI_IPV6_ADDR_PREFIX_LEN / SAI_FIB_LPM_GROUP_BITS];
+    uint_t    path_len = 0;
+    uint32_t *p_tbl = p_table->root;
+    uint_t    off = 0;
+    uint_t    stride = p_table->root_bits;
+    uint_t    span;
+    uint_t    idx;
+    uint_t    i;
+
+    if (p_tbl == NULL) {
+        return;
+    }
+
+    while (depth > (off + stride)) {
+        uint32_t *p_entry = &p_tbl [sai_fib_lpm_key_index (key, off, stride)];
+
+        if (!sai_fib_lpm_entry_is_group (*p_entry)) {
+            /* Prefix was never compiled */
+            return;
+        }
+
+        path [path_len++] = p_entry;
+
+        p_tbl = sai_fib_lpm_group_get (p_table, sai_fib_lpm_entry_index (*p_entry));
+        off += stride;
+        stride = SAI_FIB_LPM_GROUP_BITS;
+    }
+
+    span = 1 << (off + stride - depth);
+    idx = sai_fib_lpm_key_index (key, off, stride) & ~(span - 1);
+
+    for (i = idx; i < (idx + span); i++) {
+        sai_fib_lpm_entry_unfill (p_table, &p_tbl [i], depth, cover);
+    }
+
+    while (path_len > 0) {
+        sai_fib_lpm_group_collapse (p_table, path [--path_len]);
+    }
+}
+
+static void sai_fib_lpm_table_init (sai_fib_lpm_table_t *p_table,
+                                    sai_fib_lpm_epoch_t *p_epoch,
+                                    uint_t key_bits, uint_t root_bits)
+{
+    p_table->key_bits = key_bits;
+    p_table->root_bits = root_bits;
+    p_table->p_epoch = p_epoch;
+}
+
+static void sai_fib_lpm_table_free (sai_fib_lpm_table_t *p_table)
+{
+    uint_t chunk;
+
+    free (p_table->root);
+
+    for (chunk = 0; chunk < SAI_FIB_LPM_MAX_GROUP_CHUNKS; chunk++) {
+        free (p_table->group_chunks [chunk]);
+    }
+
+    free (p_table->free_groups.idx);
+}
+
+sai_fib_lpm_t *sai_fib_lpm_create (void)
+{
+    sai_fib_lpm_t *p_lpm = calloc (1, sizeof (sai_fib_lpm_t));
+
+    if (p_lpm == NULL) {
+        return NULL;
+    }
+
+    sai_fib_lpm_table_init (&p_lpm->ipv4, &p_lpm->epoch, SAI_IPV4_ADDR_PREFIX_LEN,
+                            SAI_FIB_LPM_IPV4_ROOT_BITS);
+    sai_fib_lpm_table_init (&p_lpm->ipv6, &p_lpm->epoch, SAI_IPV6_ADDR_PREFIX_LEN,
+                            SAI_FIB_LPM_IPV6_ROOT_BITS);
+
+    /* Leaf 0 stands for no route */
+    p_lpm->leaf_hwm = 1;
+
+    return p_lpm;
+}
+
+void sai_fib_lpm_destroy (sai_fib_lpm_t *p_lpm)
+{
+    uint_t chunk;
+
+    if (p_lpm == NULL) {
+        return;
+    }
+
+    sai_fib_lpm_table_free (&p_lpm->ipv4);
+    sai_fib_lpm_table_free (&p_lpm->ipv6);
+
+    for (chunk = 0; chunk < SAI_FIB_LPM_MAX_LEAF_CHUNKS; chunk++) {
+        free (p_lpm->leaf_chunks [chunk]);
+    }
+
+    free (p_lpm->free_leaves.idx);
+    free (p_lpm);
+}
+
+sai_status_t sai_fib_lpm_prefix_add (sai_fib_lpm_t *p_lpm,
+                                     const sai_ip_address_t *p_prefix,
+                                     uint_t prefix_len,
+                                     const sai_fib_lpm_nh_t *p_nh,
+                                     uint_t *p_leaf)
+{
+    sai_fib_lpm_table_t *p_table = NULL;
+    sai_status_t         sai_rc = SAI_STATUS_SUCCESS;
+    uint_t               leaf;
+
+    STD_ASSERT (p_lpm != NULL);
+    STD_ASSERT (p_prefix != NULL);
+    STD_ASSERT (p_nh != NULL);
+    STD_ASSERT (p_leaf != NULL);
+
+    p_table = sai_fib_lpm_table_get (p_lpm, p_prefix);
+
+    if (prefix_len > p_table->key_bits) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    leaf = sai_fib_lpm_leaf_alloc (p_lpm);
+
+    if (leaf == SAI_FIB_LPM_LEAF_NONE) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_fib_lpm_leaf_write (sai_fib_lpm_leaf_get (p_lpm, leaf), p_nh, prefix_len);
+
+    if (prefix_len == 0) {
+        /* The default route does not take any table entry */
+        sai_fib_lpm_store (&p_table->default_leaf, leaf);
+    } else {
+        sai_rc = sai_fib_lpm_table_add (p_table, sai_fib_lpm_key_get (p_prefix),
+                                        prefix_len,
+                                        sai_fib_lpm_entry_make (leaf, prefix_len));
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        sai_fib_lpm_leaf_free (p_lpm, leaf);
+        return sai_rc;
+    }
+
+    *p_leaf = leaf;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_fib_lpm_prefix_update (sai_fib_lpm_t *p_lpm, uint_t leaf,
+                                const sai_fib_lpm_nh_t *p_nh)
+{
+    sai_fib_lpm_leaf_t *p_leaf = NULL;
+
+    STD_ASSERT (p_lpm != NULL);
+    STD_ASSERT (p_nh != NULL);
+
+    if ((leaf == SAI_FIB_LPM_LEAF_NONE) || (leaf >= p_lpm->leaf_hwm)) {
+        return;
+    }
+
+    p_leaf = sai_fib_lpm_leaf_get (p_lpm, leaf);
+
+    sai_fib_lpm_leaf_write (p_leaf, p_nh, p_leaf->nh.prefix_len);
+}
+
+void sai_fib_lpm_prefix_remove (sai_fib_lpm_t *p_lpm,
+                                const sai_ip_address_t *p_prefix,
+                                uint_t prefix_len, uint_t leaf,
+                                uint_t cover_leaf, uint_t cover_len)
+{
+    sai_fib_lpm_table_t *p_table = NULL;
+
+    STD_ASSERT (p_lpm != NULL);
+    STD_ASSERT (p_prefix != NULL);
+
+    if ((leaf == SAI_FIB_LPM_LEAF_NONE) || (leaf >= p_lpm->leaf_hwm)) {
+        return;
+    }
+
+    p_table = sai_fib_lpm_table_get (p_lpm, p_prefix);
+
+    if (prefix_len == 0) {
+        sai_fib_lpm_store (&p_table->default_leaf, SAI_FIB_LPM_LEAF_NONE);
+    } else {
+        /* The default route is not held in the entries, see lookup */
+        sai_fib_lpm_table_remove (p_table, sai_fib_lpm_key_get (p_prefix),
+                                  prefix_len,
+                                  (cover_len == 0) ? 0 :
+                                  sai_fib_lpm_entry_make (cover_leaf, cover_len));
+    }
+
+    sai_fib_lpm_leaf_free (p_lpm, leaf);
+}
+
+bool sai_fib_lpm_lookup (const sai_fib_lpm_t *p_lpm,
+                         const sai_ip_address_t *p_addr,
+                         sai_fib_lpm_nh_t *p_nh)
+{
+    const sai_fib_lpm_table_t *p_table = NULL;
+    const uint8_t             *key = NULL;
+    const uint32_t            *p_root = NULL;
+    sai_fib_lpm_epoch_t       *p_epoch = NULL;
+    uint32_t                   epoch;
+    uint32_t                   entry = 0;
+    uint_t                     off;
+    uint_t                     leaf;
+
+    STD_ASSERT (p_lpm != NULL);
+    STD_ASSERT (p_addr != NULL);
+    STD_ASSERT (p_nh != NULL);
+
+    p_table = ((p_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV4) ?
+               &p_lpm->ipv4 : &p_lpm->ipv6);
+    key = sai_fib_lpm_key_get (p_addr);
+
+    /* The reader counts are the only state a lookup writes */
+    p_epoch = (sai_fib_lpm_epoch_t *) &p_lpm->epoch;
+    epoch = sai_fib_lpm_reader_enter (p_epoch);
+
+    p_root = __atomic_load_n (&p_table->root, __ATOMIC_ACQUIRE);
+
+    if (p_root != NULL) {
+        entry = sai_fib_lpm_load (&p_root [sai_fib_lpm_key_index (key, 0,
+                                                                  p_table->root_bits)]);
+
+        for (off = p_table->root_bits / BITS_PER_BYTE;
+             sai_fib_lpm_entry_is_group (entry); off++) {
+            entry = sai_fib_lpm_load (&sai_fib_lpm_group_get (p_table,
+                                       sai_fib_lpm_entry_index (entry)) [key [off]]);
+        }
+    }
+
+    leaf = sai_fib_lpm_entry_index (entry);
+
+    if (leaf == SAI_FIB_LPM_LEAF_NONE) {
+        leaf = sai_fib_lpm_load (&p_table->default_leaf);
+    }
+
+    if (leaf != SAI_FIB_LPM_LEAF_NONE) {
+        sai_fib_lpm_leaf_read (sai_fib_lpm_leaf_get (p_lpm, leaf), p_nh);
+    }
+
+    sai_fib_lpm_reader_exit (p_epoch, epoch);
+
+    return (leaf != SAI_FIB_LPM_LEAF_NONE);
+}
+
+void sai_fib_lpm_stats_get (const sai_fib_lpm_t *p_lpm,
+                            sai_fib_lpm_stats_t *p_stats)
+{
+    const sai_fib_lpm_table_t *tables [] = { &p_lpm->ipv4, &p_lpm->ipv6 };
+    uint_t                     i;
+
+    STD_ASSERT (p_lpm != NULL);
+    STD_ASSERT (p_stats != NULL);
+
+    memset (p_stats, 0, sizeof (*p_stats));
+
+    p_stats->leaf_count = p_lpm->leaf_count;
+    p_stats->ipv4_group_count = p_lpm->ipv4.group_count;
+    p_stats->ipv6_group_count = p_lpm->ipv6.group_count;
+
+    p_stats->mem_bytes = sizeof (sai_fib_lpm_t) +
+        (((p_lpm->leaf_hwm + SAI_FIB_LPM_LEAVES_PER_CHUNK - 1) /
+          SAI_FIB_LPM_LEAVES_PER_CHUNK) * SAI_FIB_LPM_LEAVES_PER_CHUNK *
+         sizeof (sai_fib_lpm_leaf_t));
+
+    for (i = 0; i < (sizeof (tables) / sizeof (tables [0])); i++) {
+        if (tables [i]->root != NULL) {
+            p_stats->mem_bytes += (1 << tables [i]->root_bits) * sizeof (uint32_t);
+        }
+
+        p_stats->mem_bytes +=
+            ((tables [i]->group_hwm + SAI_FIB_LPM_GROUPS_PER_CHUNK - 1) /
+             SAI_FIB_LPM_GROUPS_PER_CHUNK) * SAI_FIB_LPM_GROUPS_PER_CHUNK *
+            SAI_FIB_LPM_GROUP_SIZE * sizeof (uint32_t);
+    }
+}
@@ -34,11 +34,13 @@
 #include "sai_l3_mem.h"
 #include "sai_l3_api_utils.h"
 #include "sai_common_infra.h"
+#include "sai_api_stats.h"
 #include "sai_fdb_main.h"
 #include "sai_fdb_common.h"
 #include "sai_bridge_api.h"
 #include "sai_vlan_api.h"
 #include <string.h>
+#include <stdlib.h>
 #include <inttypes.h>
 
 static sai_status_t sai_fib_neighbor_mac_entry_remove (sai_fib_nh_t *p_neighbor);
@@ -444,9 +446,7 @@ static sai_status_t sai_fib_neighbor_port_id_resolve (sai_fib_nh_t *p_neighbor)
             p_neighbor->port_id = SAI_NULL_OBJECT_ID;
 
         } else {
-            sai_bridge_lock();
             status = sai_bridge_port_get_port_id(fdb_port_attr.value.oid, &port_obj_id);
-            sai_bridge_unlock();
             if(status != SAI_STATUS_SUCCESS) {
                 SAI_NEIGHBOR_LOG_ERR ("Error %d in getting port obj from bridge port id "
                                       "0x%"PRIx64" for mac %s, vlan 0x%"PRIx64".", status,
@@ -719,11 +719,15 @@ static sai_status_t sai_fib_neighbor_node_create (sai_fib_nh_t *nh_info,
     return SAI_STATUS_SUCCESS;
 }
 
-/* Neighbor IPv4 address is expected in Network Byte Order */
-static sai_status_t sai_fib_neighbor_create (
+/*
+ * Create a neighbor entry with the FIB lock held. The encap next hops on the
+ * neighbor IP address are resolved by the caller.
+ */
+static sai_status_t sai_fib_neighbor_entry_create (
                                     const sai_neighbor_entry_t *neighbor_entry,
                                     uint32_t attr_count,
-                                    const sai_attribute_t *attr_list)
+                                    const sai_attribute_t *attr_list,
+                                    sai_fib_nh_t **p_out_nh_node)
 {
     sai_status_t       status = SAI_STATUS_FAILURE;
     sai_fib_nh_t      *p_nh_node = NULL;
@@ -731,14 +735,10 @@ static sai_status_t sai_fib_neighbor_create (
     uint_t             attr_flag = 0;
     bool               mac_inserted = false;
 
-    SAI_NEIGHBOR_LOG_TRACE ("SAI Neighbor creation.");
-
     memset (&nh_info, 0, sizeof (sai_fib_nh_t));
 
     sai_fib_neighbor_default_attr_set (&nh_info);
 
-    sai_fib_lock ();
-
     do {
         /* Validate the input neighbor entry key */
         status = sai_fib_neighbor_key_validate_and_fill (neighbor_entry,
@@ -800,7 +800,7 @@ static sai_status_t sai_fib_neighbor_create (
                                     "entry creation.");
         SAI_NEIGHBOR_LOG_INFO ("Neighbor entry created.");
 
-        sai_fib_neighbor_affected_encap_nh_resolve (p_nh_node, SAI_OP_CREATE);
+        *p_out_nh_node = p_nh_node;
 
     } else {
 
@@ -818,24 +818,49 @@ static sai_status_t sai_fib_neighbor_create (
         }
     }
 
+    return status;
+}
+
+/* Neighbor IPv4 address is expected in Network Byte Order */
+static sai_status_t sai_fib_neighbor_create (
+                                    const sai_neighbor_entry_t *neighbor_entry,
+                                    uint32_t attr_count,
+                                    const sai_attribute_t *attr_list)
+{
+    sai_status_t       status;
+    sai_fib_nh_t      *p_nh_node = NULL;
+
+    SAI_NEIGHBOR_LOG_TRACE ("SAI Neighbor creation.");
+
+    sai_fib_lock ();
+
+    status = sai_fib_neighbor_entry_create (neighbor_entry, attr_count,
+                                            attr_list, &p_nh_node);
+
+    if (status == SAI_STATUS_SUCCESS) {
+
+        sai_fib_neighbor_affected_encap_nh_resolve (p_nh_node, SAI_OP_CREATE);
+    }
+
     sai_fib_unlock ();
 
     return status;
 }
 
-/* Neighbor IPv4 address is expected in Network Byte Order */
-static sai_status_t sai_fib_neighbor_remove (
-                                const sai_neighbor_entry_t *neighbor_entry)
+/*
+ * Remove a neighbor entry with the FIB lock held. The next hop node is left
+ * for the caller to resolve the encap next hops on the neighbor IP address
+ * and to free.
+ */
+static sai_status_t sai_fib_neighbor_entry_remove (
+                                const sai_neighbor_entry_t *neighbor_entry,
+                                sai_fib_nh_t **p_out_nh_node)
 {
     sai_status_t       status = SAI_STATUS_FAILURE;
     sai_fib_nh_t      *p_nh_node = NULL;
     sai_fib_nh_t       nh_node_copy;
     sai_fib_nh_key_t   nh_key;
 
-    SAI_NEIGHBOR_LOG_TRACE ("SAI Neighbor remove.");
-
-    sai_fib_lock ();
-
     do {
         /* Validate the input neighbor entry key */
         status = sai_fib_neighbor_entry_validate (neighbor_entry);
@@ -908,6 +933,27 @@ static sai_status_t sai_fib_neighbor_remove (
         sai_fib_next_hop_log_trace (p_nh_node, "Next Hop node after "
                                     "neighbor entry deletion.");
 
+        *p_out_nh_node = p_nh_node;
+    }
+
+    return status;
+}
+
+/* Neighbor IPv4 address is expected in Network Byte Order */
+static sai_status_t sai_fib_neighbor_remove (
+                                const sai_neighbor_entry_t *neighbor_entry)
+{
+    sai_status_t       status;
+    sai_fib_nh_t      *p_nh_node = NULL;
+
+    SAI_NEIGHBOR_LOG_TRACE ("SAI Neighbor remove.");
+
+    sai_fib_lock ();
+
+    status = sai_fib_neighbor_entry_remove (neighbor_entry, &p_nh_node);
+
+    if (status == SAI_STATUS_SUCCESS) {
+
         sai_fib_neighbor_affected_encap_nh_resolve (p_nh_node, SAI_OP_REMOVE);
 
         /* Free the next hop node */
@@ -921,6 +967,222 @@ static sai_status_t sai_fib_neighbor_remove (
     return status;
 }
 
+static inline void sai_fib_neighbor_dep_key_fill (sai_fib_nh_t *p_nh_node,
+                                                  sai_fib_neighbor_dep_key_t *p_key)
+{
+    memset (p_key, 0, sizeof (sai_fib_neighbor_dep_key_t));
+
+    p_key->vrf_id = p_nh_node->vrf_id;
+
+    sai_fib_ip_addr_copy (&p_key->ip_addr, sai_fib_next_hop_ip_addr (p_nh_node));
+}
+
+static sai_status_t sai_fib_neighbor_bulk_status_get (
+                                         uint32_t object_count,
+                                         const sai_status_t *object_statuses)
+{
+    uint32_t index;
+
+    for (index = 0; index < object_count; index++) {
+
+        if (object_statuses [index] != SAI_STATUS_SUCCESS) {
+
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_fib_neighbor_entries_create (
+                                    uint32_t object_count,
+                                    const sai_neighbor_entry_t *neighbor_entry,
+                                    const uint32_t *attr_count,
+                                    const sai_attribute_t **attr_list,
+                                    sai_bulk_op_error_mode_t mode,
+                                    sai_status_t *object_statuses)
+{
+    sai_fib_neighbor_dep_key_t *p_key_list = NULL;
+    sai_fib_nh_t               *p_nh_node = NULL;
+    uint_t                      key_count = 0;
+    uint32_t                    index;
+
+    if ((object_count == 0) || (neighbor_entry == NULL) || (attr_count == NULL) ||
+        (attr_list == NULL) || (object_statuses == NULL)) {
+
+        SAI_NEIGHBOR_LOG_ERR ("SAI Neighbor bulk creation. Invalid input, "
+                              "object_count: %d.", object_count);
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    SAI_NEIGHBOR_LOG_TRACE ("SAI Neighbor bulk creation, object_count: %d.",
+                            object_count);
+
+    p_key_list = (sai_fib_neighbor_dep_key_t *)
+                 calloc (object_count, sizeof (sai_fib_neighbor_dep_key_t));
+
+    if (p_key_list == NULL) {
+
+        SAI_NEIGHBOR_LOG_ERR ("SAI Neighbor bulk creation. Memory alloc "
+                              "failed for %d entries.", object_count);
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    for (index = 0; index < object_count; index++) {
+        object_statuses [index] = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    sai_fib_lock ();
+
+    for (index = 0; index < object_count; index++) {
+
+        object_statuses [index] =
+            sai_fib_neighbor_entry_create (&neighbor_entry [index],
+                                           attr_count [index], attr_list [index],
+                                           &p_nh_node);
+
+        if (object_statuses [index] == SAI_STATUS_SUCCESS) {
+
+            sai_fib_neighbor_dep_key_fill (p_nh_node, &p_key_list [key_count]);
+            key_count++;
+
+        } else if (mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+
+            break;
+        }
+    }
+
+    /* Resolve the encap next hops once for the whole batch */
+    if (key_count != 0) {
+        sai_fib_neighbor_list_affected_encap_nh_resolve (p_key_list, key_count);
+    }
+
+    sai_fib_unlock ();
+
+    free (p_key_list);
+
+    SAI_NEIGHBOR_LOG_INFO ("Neighbor bulk creation, %d of %d entries created.",
+                           key_count, object_count);
+
+    return (sai_fib_neighbor_bulk_status_get (object_count, object_statuses));
+}
+
+sai_status_t sai_fib_neighbor_bulk_create (
+                                    uint32_t object_count,
+                                    const sai_neighbor_entry_t *neighbor_entry,
+                                    const uint32_t *attr_count,
+                                    const sai_attribute_t **attr_list,
+                                    sai_bulk_op_error_mode_t mode,
+                                    sai_status_t *object_statuses)
+{
+    SAI_API_STATS_BULK_CALL (SAI_API_STATS_BULK_NEIGHBOR_ENTRY_CREATE, object_count,
+                             sai_fib_neighbor_entries_create (object_count,
+                                                              neighbor_entry, attr_count,
+                                                              attr_list, mode,
+                                                              object_statuses));
+}
+
+static sai_status_t sai_fib_neighbor_entries_remove (
+                                    uint32_t object_count,
+                                    const sai_neighbor_entry_t *neighbor_entry,
+                                    sai_bulk_op_error_mode_t mode,
+                                    sai_status_t *object_statuses)
+{
+    sai_fib_neighbor_dep_key_t *p_key_list = NULL;
+    sai_fib_nh_t              **p_nh_list = NULL;
+    uint_t                      key_count = 0;
+    uint32_t                    index;
+
+    if ((object_count == 0) || (neighbor_entry == NULL) ||
+        (object_statuses == NULL)) {
+
+        SAI_NEIGHBOR_LOG_ERR ("SAI Neighbor bulk remove. Invalid input, "
+                              "object_count: %d.", object_count);
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    SAI_NEIGHBOR_LOG_TRACE ("SAI Neighbor bulk remove, object_count: %d.",
+                            object_count);
+
+    p_key_list = (sai_fib_neighbor_dep_key_t *)
+                 calloc (object_count, sizeof (sai_fib_neighbor_dep_key_t));
+    p_nh_list = (sai_fib_nh_t **) calloc (object_count, sizeof (sai_fib_nh_t *));
+
+    if ((p_key_list == NULL) || (p_nh_list == NULL)) {
+
+        SAI_NEIGHBOR_LOG_ERR ("SAI Neighbor bulk remove. Memory alloc "
+                              "failed for %d entries.", object_count);
+
+        free (p_key_list);
+        free (p_nh_list);
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    for (index = 0; index < object_count; index++) {
+        object_statuses [index] = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    sai_fib_lock ();
+
+    for (index = 0; index < object_count; index++) {
+
+        object_statuses [index] =
+            sai_fib_neighbor_entry_remove (&neighbor_entry [index],
+                                           &p_nh_list [key_count]);
+
+        if (object_statuses [index] == SAI_STATUS_SUCCESS) {
+
+            sai_fib_neighbor_dep_key_fill (p_nh_list [key_count],
+                                           &p_key_list [key_count]);
+            key_count++;
+
+        } else if (mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+
+            break;
+        }
+    }
+
+    /*
+     * Resolve the encap next hops once for the whole batch, before the
+     * removed neighbor nodes they point to are freed.
+     */
+    if (key_count != 0) {
+        sai_fib_neighbor_list_affected_encap_nh_resolve (p_key_list, key_count);
+    }
+
+    for (index = 0; index < key_count; index++) {
+
+        sai_fib_check_and_delete_ip_next_hop_node (p_nh_list [index]->vrf_id,
+                                                   p_nh_list [index]);
+    }
+
+    sai_fib_unlock ();
+
+    free (p_key_list);
+    free (p_nh_list);
+
+    SAI_NEIGHBOR_LOG_INFO ("Neighbor bulk remove, %d of %d entries removed.",
+                           key_count, object_count);
+
+    return (sai_fib_neighbor_bulk_status_get (object_count, object_statuses));
+}
+
+sai_status_t sai_fib_neighbor_bulk_remove (
+                                    uint32_t object_count,
+                                    const sai_neighbor_entry_t *neighbor_entry,
+                                    sai_bulk_op_error_mode_t mode,
+                                    sai_status_t *object_statuses)
+{
+    SAI_API_STATS_BULK_CALL (SAI_API_STATS_BULK_NEIGHBOR_ENTRY_REMOVE, object_count,
+                             sai_fib_neighbor_entries_remove (object_count,
+                                                              neighbor_entry, mode,
+                                                              object_statuses));
+}
+
 static sai_status_t sai_fib_neighbor_attribute_set (
                                    const sai_neighbor_entry_t *neighbor_entry,
                                    const sai_attribute_t *p_attr)
@@ -1067,7 +1329,7 @@ static sai_status_t sai_fib_neighbor_attribute_get (
     STD_ASSERT (neighbor_entry != NULL);
     STD_ASSERT (attr_list != NULL);
 
-    sai_fib_lock ();
+    sai_fib_read_lock ();
 
     do {
         sai_fib_neighbor_entry_log_trace (neighbor_entry, "SAI Neighbor "
@@ -1119,7 +1381,7 @@ static sai_status_t sai_fib_neighbor_attribute_get (
         SAI_NEIGHBOR_LOG_ERR ("SAI Neighbor Get Attribute failed.");
     }
 
-    sai_fib_unlock ();
+    sai_fib_read_unlock ();
 
     return status;
 }
@@ -1151,9 +1413,7 @@ static sai_status_t sai_fib_neighbor_port_id_set (const sai_fdb_entry_t *fdb_ent
         if(bridge_port_id == SAI_NULL_OBJECT_ID) {
             port_id = SAI_NULL_OBJECT_ID;
         } else {
-            sai_bridge_lock();
             status = sai_bridge_port_get_port_id(bridge_port_id, &port_id);
-            sai_bridge_unlock();
             if(status != SAI_STATUS_SUCCESS) {
                 SAI_NEIGHBOR_LOG_ERR ("Error %d in getting port obj from bridge port id "
                         "0x%"PRIx64"", status, bridge_port_id);
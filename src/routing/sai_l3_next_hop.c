@@ -32,6 +32,7 @@
 #include "sai_l3_mem.h"
 #include "sai_l3_api_utils.h"
 #include "sai_common_infra.h"
+#include "sai_api_stats.h"
 #include <string.h>
 #include <inttypes.h>
 
@@ -813,27 +814,21 @@ sai_status_t sai_fib_ip_next_hop_remove (sai_fib_nh_t *p_nh_node)
     return SAI_STATUS_SUCCESS;
 }
 
-/* Next Hop IPv4 address attribute is expected in Network Byte Order */
-static sai_status_t sai_fib_next_hop_create (sai_object_id_t *p_next_hop_id,
-                                             sai_object_id_t switch_id,
-                                             uint32_t attr_count,
-                                             const sai_attribute_t *attr_list)
+/* Create a next hop with the FIB lock held */
+static sai_status_t sai_fib_next_hop_entry_create (sai_object_id_t *p_next_hop_id,
+                                                   uint32_t attr_count,
+                                                   const sai_attribute_t *attr_list)
 {
     sai_status_t   status;
     sai_fib_nh_t  *p_nh_node = NULL;
     sai_fib_nh_t   nh_info;
 
-    SAI_NEXTHOP_LOG_TRACE ("SAI Next Hop creation, attr_count: %d.",
-                           attr_count);
-
     STD_ASSERT (p_next_hop_id != NULL);
 
     memset (&nh_info, 0, sizeof (sai_fib_nh_t));
 
     sai_fib_next_hop_default_attr_set (&nh_info);
 
-    sai_fib_lock ();
-
     do {
         status = sai_fib_next_hop_info_fill (&nh_info, attr_count, attr_list,
                                              true);
@@ -892,19 +887,37 @@ static sai_status_t sai_fib_next_hop_create (sai_object_id_t *p_next_hop_id,
         SAI_NEXTHOP_LOG_INFO ("Next Hop: 0x%"PRIx64" created.", (*p_next_hop_id));
     }
 
+    return status;
+}
+
+/* Next Hop IPv4 address attribute is expected in Network Byte Order */
+static sai_status_t sai_fib_next_hop_create (sai_object_id_t *p_next_hop_id,
+                                             sai_object_id_t switch_id,
+                                             uint32_t attr_count,
+                                             const sai_attribute_t *attr_list)
+{
+    sai_status_t   status;
+
+    SAI_NEXTHOP_LOG_TRACE ("SAI Next Hop creation, attr_count: %d.",
+                           attr_count);
+
+    STD_ASSERT (p_next_hop_id != NULL);
+
+    sai_fib_lock ();
+
+    status = sai_fib_next_hop_entry_create (p_next_hop_id, attr_count, attr_list);
+
     sai_fib_unlock ();
 
     return status;
 }
 
-static sai_status_t sai_fib_next_hop_remove (sai_object_id_t next_hop_id)
+/* Remove a next hop with the FIB lock held */
+static sai_status_t sai_fib_next_hop_entry_remove (sai_object_id_t next_hop_id)
 {
     sai_status_t   status;
     sai_fib_nh_t  *p_nh_node = NULL;
 
-    SAI_NEXTHOP_LOG_TRACE ("SAI Next Hop deletion, next_hop_id: 0x%"PRIx64".",
-                           next_hop_id);
-
     if (!sai_is_obj_id_next_hop (next_hop_id)) {
         SAI_NEXTHOP_LOG_ERR ("0x%"PRIx64" is not a valid Next Hop obj id.",
                              next_hop_id);
@@ -912,8 +925,6 @@ static sai_status_t sai_fib_next_hop_remove (sai_object_id_t next_hop_id)
         return SAI_STATUS_INVALID_OBJECT_TYPE;
     }
 
-    sai_fib_lock ();
-
     do {
         /* Get the next hop node */
         p_nh_node = sai_fib_next_hop_node_get_from_id (next_hop_id);
@@ -985,11 +996,153 @@ static sai_status_t sai_fib_next_hop_remove (sai_object_id_t next_hop_id)
         }
     } while (0);
 
+    return status;
+}
+
+static sai_status_t sai_fib_next_hop_remove (sai_object_id_t next_hop_id)
+{
+    sai_status_t   status;
+
+    SAI_NEXTHOP_LOG_TRACE ("SAI Next Hop deletion, next_hop_id: 0x%"PRIx64".",
+                           next_hop_id);
+
+    sai_fib_lock ();
+
+    status = sai_fib_next_hop_entry_remove (next_hop_id);
+
     sai_fib_unlock ();
 
     return status;
 }
 
+static sai_status_t sai_fib_next_hop_bulk_status_get (
+                                         uint32_t object_count,
+                                         const sai_status_t *object_statuses)
+{
+    uint32_t index;
+
+    for (index = 0; index < object_count; index++) {
+
+        if (object_statuses [index] != SAI_STATUS_SUCCESS) {
+
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_fib_next_hops_create (sai_object_id_t switch_id,
+                                              uint32_t object_count,
+                                              const uint32_t *attr_count,
+                                              const sai_attribute_t **attr_list,
+                                              sai_bulk_op_error_mode_t mode,
+                                              sai_object_id_t *object_id,
+                                              sai_status_t *object_statuses)
+{
+    uint32_t  index;
+
+    if ((object_count == 0) || (attr_count == NULL) || (attr_list == NULL) ||
+        (object_id == NULL) || (object_statuses == NULL)) {
+
+        SAI_NEXTHOP_LOG_ERR ("SAI Next Hop bulk creation. Invalid input, "
+                             "object_count: %d.", object_count);
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    SAI_NEXTHOP_LOG_TRACE ("SAI Next Hop bulk creation, object_count: %d.",
+                           object_count);
+
+    for (index = 0; index < object_count; index++) {
+        object_id [index] = SAI_NULL_OBJECT_ID;
+        object_statuses [index] = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    sai_fib_lock ();
+
+    for (index = 0; index < object_count; index++) {
+
+        object_statuses [index] =
+            sai_fib_next_hop_entry_create (&object_id [index],
+                                           attr_count [index], attr_list [index]);
+
+        if ((object_statuses [index] != SAI_STATUS_SUCCESS) &&
+            (mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR)) {
+
+            break;
+        }
+    }
+
+    sai_fib_unlock ();
+
+    return (sai_fib_next_hop_bulk_status_get (object_count, object_statuses));
+}
+
+sai_status_t sai_fib_next_hop_bulk_create (sai_object_id_t switch_id,
+                                           uint32_t object_count,
+                                           const uint32_t *attr_count,
+                                           const sai_attribute_t **attr_list,
+                                           sai_bulk_op_error_mode_t mode,
+                                           sai_object_id_t *object_id,
+                                           sai_status_t *object_statuses)
+{
+    SAI_API_STATS_BULK_CALL (SAI_API_STATS_BULK_NEXT_HOP_CREATE, object_count,
+                             sai_fib_next_hops_create (switch_id, object_count,
+                                                       attr_count, attr_list, mode,
+                                                       object_id, object_statuses));
+}
+
+static sai_status_t sai_fib_next_hops_remove (uint32_t object_count,
+                                              const sai_object_id_t *object_id,
+                                              sai_bulk_op_error_mode_t mode,
+                                              sai_status_t *object_statuses)
+{
+    uint32_t  index;
+
+    if ((object_count == 0) || (object_id == NULL) || (object_statuses == NULL)) {
+
+        SAI_NEXTHOP_LOG_ERR ("SAI Next Hop bulk remove. Invalid input, "
+                             "object_count: %d.", object_count);
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    SAI_NEXTHOP_LOG_TRACE ("SAI Next Hop bulk remove, object_count: %d.",
+                           object_count);
+
+    for (index = 0; index < object_count; index++) {
+        object_statuses [index] = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    sai_fib_lock ();
+
+    for (index = 0; index < object_count; index++) {
+
+        object_statuses [index] = sai_fib_next_hop_entry_remove (object_id [index]);
+
+        if ((object_statuses [index] != SAI_STATUS_SUCCESS) &&
+            (mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR)) {
+
+            break;
+        }
+    }
+
+    sai_fib_unlock ();
+
+    return (sai_fib_next_hop_bulk_status_get (object_count, object_statuses));
+}
+
+sai_status_t sai_fib_next_hop_bulk_remove (uint32_t object_count,
+                                           const sai_object_id_t *object_id,
+                                           sai_bulk_op_error_mode_t mode,
+                                           sai_status_t *object_statuses)
+{
+    SAI_API_STATS_BULK_CALL (SAI_API_STATS_BULK_NEXT_HOP_REMOVE, object_count,
+                             sai_fib_next_hops_remove (object_count, object_id, mode,
+                                                       object_statuses));
+}
+
 static sai_status_t sai_fib_next_hop_attribute_set (
                                                 sai_object_id_t next_hop_id,
                                                 const sai_attribute_t *p_attr)
@@ -1027,7 +1180,7 @@ static sai_status_t sai_fib_next_hop_attribute_get (
 
     STD_ASSERT (attr_list != NULL);
 
-    sai_fib_lock ();
+    sai_fib_read_lock ();
 
     do {
         /* Get the next hop node */
@@ -1072,7 +1225,7 @@ static sai_status_t sai_fib_next_hop_attribute_get (
         SAI_NEXTHOP_LOG_ERR ("SAI Next Hop Get Attribute failed.");
     }
 
-    sai_fib_unlock ();
+    sai_fib_read_unlock ();
 
     return status;
 }
@@ -1238,7 +1238,7 @@ static sai_status_t sai_fib_next_hop_group_attribute_get (
 
     STD_ASSERT (p_attr_list != NULL);
 
-    sai_fib_lock ();
+    sai_fib_read_lock ();
 
     do {
         p_nh_group_node = sai_fib_next_hop_group_get (nh_group_id);
@@ -1288,7 +1288,7 @@ static sai_status_t sai_fib_next_hop_group_attribute_get (
         SAI_NH_GROUP_LOG_ERR ("SAI Next Hop Group Get Attribute failed.");
     }
 
-    sai_fib_unlock ();
+    sai_fib_read_unlock ();
 
     return status;
 }
@@ -1452,7 +1452,7 @@ static sai_status_t sai_fib_next_hop_group_member_attribute_get (
 
     STD_ASSERT (p_attr_list != NULL);
 
-    sai_fib_lock ();
+    sai_fib_read_lock ();
 
     do {
         status = sai_next_hop_map_get_ids_from_member_id (member_id,
@@ -1507,7 +1507,7 @@ static sai_status_t sai_fib_next_hop_group_member_attribute_get (
         SAI_NH_GROUP_LOG_ERR ("SAI NH Group Member Get Attribute failed.");
     }
 
-    sai_fib_unlock ();
+    sai_fib_read_unlock ();
 
     return status;
 }
@@ -495,6 +495,63 @@ sai_fib_route_t *p_route_node, std_rt_table *sai_route_tree)
     return SAI_STATUS_SUCCESS;
 }
 
+static void sai_fib_route_lpm_nh_fill (sai_fib_route_t *p_route_node,
+                                       sai_fib_lpm_nh_t *p_lpm_nh)
+{
+    memset (p_lpm_nh, 0, sizeof (sai_fib_lpm_nh_t));
+
+    p_lpm_nh->packet_action = p_route_node->packet_action;
+    p_lpm_nh->nh_type = p_route_node->nh_type;
+    p_lpm_nh->nh_id = sai_fib_route_node_nh_id_get (p_route_node);
+}
+
+static void sai_fib_route_lpm_add (sai_fib_vrf_t *p_vrf_node,
+                                   sai_fib_route_t *p_route_node)
+{
+    sai_fib_lpm_nh_t lpm_nh;
+
+    sai_fib_route_lpm_nh_fill (p_route_node, &lpm_nh);
+
+    /* The LPM table only mirrors the route tree, it never fails the route */
+    if (sai_fib_lpm_prefix_add (p_vrf_node->route_lpm, &p_route_node->key.prefix,
+                                p_route_node->prefix_len, &lpm_nh,
+                                &p_route_node->lpm_leaf) != SAI_STATUS_SUCCESS) {
+        sai_fib_route_log_error (p_route_node, "Failed to add Route to LPM table");
+
+        p_route_node->lpm_leaf = SAI_FIB_LPM_LEAF_NONE;
+    }
+}
+
+static void sai_fib_route_lpm_update (sai_fib_vrf_t *p_vrf_node,
+                                      sai_fib_route_t *p_route_node)
+{
+    sai_fib_lpm_nh_t lpm_nh;
+
+    sai_fib_route_lpm_nh_fill (p_route_node, &lpm_nh);
+
+    sai_fib_lpm_prefix_update (p_vrf_node->route_lpm, p_route_node->lpm_leaf,
+                               &lpm_nh);
+}
+
+/* To be called while the route is still in the route tree */
+static void sai_fib_route_lpm_remove (sai_fib_vrf_t *p_vrf_node,
+                                      sai_fib_route_t *p_route_node)
+{
+    sai_fib_route_t *p_cover = NULL;
+
+    p_cover = (sai_fib_route_t *)
+        std_radix_getlessspecific (p_vrf_node->sai_route_tree,
+                                   (std_rt_head *)&p_route_node->rt_head);
+
+    sai_fib_lpm_prefix_remove (p_vrf_node->route_lpm, &p_route_node->key.prefix,
+                               p_route_node->prefix_len, p_route_node->lpm_leaf,
+                               (p_cover != NULL) ? p_cover->lpm_leaf :
+                               SAI_FIB_LPM_LEAF_NONE,
+                               (p_cover != NULL) ? p_cover->prefix_len : 0);
+
+    p_route_node->lpm_leaf = SAI_FIB_LPM_LEAF_NONE;
+}
+
 static inline bool sai_fib_is_default_route_entry (
 const sai_route_entry_t *uc_route)
 {
@@ -624,6 +681,10 @@ const sai_attribute_t *attr_list)
             if (sai_rc != SAI_STATUS_SUCCESS) {
                 break;
             }
+
+            sai_fib_route_lpm_add (p_vrf_node, p_route_node);
+        } else {
+            sai_fib_route_lpm_update (p_vrf_node, p_route_node);
         }
 
         sai_fib_route_affected_encap_nh_update (p_route_node, SAI_OP_CREATE);
@@ -706,6 +767,8 @@ const sai_route_entry_t *uc_route_entry)
 
         if (!sai_fib_is_default_route_entry (uc_route_entry)) {
 
+            sai_fib_route_lpm_remove (p_vrf_node, p_route_node);
+
             std_radix_remove (p_vrf_node->sai_route_tree,
                               (std_rt_head *)&p_route_node->rt_head);
         } else {
@@ -723,6 +786,8 @@ const sai_route_entry_t *uc_route_entry)
         if (!sai_fib_is_default_route_entry (uc_route_entry)) {
 
             sai_fib_route_node_free (p_route_node);
+        } else {
+            sai_fib_route_lpm_update (p_vrf_node, p_route_node);
         }
 
     } while (0);
@@ -830,6 +895,8 @@ const sai_route_entry_t *uc_route_entry, const sai_attribute_t *attr)
             sai_fib_encap_nh_dep_route_add (p_route_node);
         }
 
+        sai_fib_route_lpm_update (p_vrf_node, p_route_node);
+
     } while (0);
 
     if (sai_rc == SAI_STATUS_SUCCESS) {
@@ -864,7 +931,7 @@ sai_attribute_t *attr_list)
     STD_ASSERT (uc_route_entry != NULL);
     STD_ASSERT (attr_list != NULL);
 
-    sai_fib_lock ();
+    sai_fib_read_lock ();
 
     do {
         p_route_node = sai_fib_route_node_get (uc_route_entry);
@@ -894,7 +961,7 @@ sai_attribute_t *attr_list)
         SAI_ROUTE_LOG_ERR ("Route attributes Get failed.");
     }
 
-    sai_fib_unlock ();
+    sai_fib_read_unlock ();
 
     return sai_rc;
 }
@@ -932,6 +999,8 @@ sai_status_t sai_fib_internal_default_route_node_add (sai_fib_vrf_t *p_vrf_node,
         return status;
     }
 
+    sai_fib_route_lpm_add (p_vrf_node, p_route_node);
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -955,6 +1024,8 @@ sai_status_t sai_fib_internal_default_route_node_del (sai_fib_vrf_t *p_vrf_node,
         return SAI_STATUS_ITEM_NOT_FOUND;
     }
 
+    sai_fib_route_lpm_remove (p_vrf_node, p_route_node);
+
     std_radix_remove (p_vrf_node->sai_route_tree,
                       (std_rt_head *)&p_route_node->rt_head);
 
@@ -1244,7 +1244,7 @@ sai_attribute_t *attr_list)
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    sai_fib_lock ();
+    sai_fib_read_lock ();
 
     do {
         p_rif_node = sai_fib_router_interface_node_get (rif_id);
@@ -1275,7 +1275,7 @@ sai_attribute_t *attr_list)
         SAI_RIF_LOG_ERR ("Failed to get RIF attributes.");
     }
 
-    sai_fib_unlock ();
+    sai_fib_read_unlock ();
 
     return sai_rc;
 }
@@ -333,6 +333,12 @@ static void sai_fib_vrf_free_resources (sai_fib_vrf_t *p_vrf_node)
         p_vrf_node->sai_route_tree = NULL;
     }
 
+    if (p_vrf_node->route_lpm) {
+        sai_fib_lpm_destroy (p_vrf_node->route_lpm);
+
+        p_vrf_node->route_lpm = NULL;
+    }
+
     sai_fib_vrf_node_free (p_vrf_node);
 
     return;
@@ -386,6 +392,19 @@ static sai_status_t sai_fib_vrf_node_trees_create (sai_fib_vrf_t *p_vrf_node)
         return SAI_STATUS_NO_MEMORY;
     }
 
+    p_vrf_node->route_lpm = sai_fib_lpm_create ();
+
+    if (!p_vrf_node->route_lpm) {
+        SAI_ROUTER_LOG_ERR ("Failed to create Route LPM table for VRF 0x%"PRIx64".",
+                            p_vrf_node->vrf_id);
+
+        sai_router_npu_api_get()->vr_remove (p_vrf_node);
+
+        sai_fib_vrf_free_resources (p_vrf_node);
+
+        return SAI_STATUS_NO_MEMORY;
+    }
+
     std_radix_enable_radical (p_vrf_node->sai_route_tree);
 
     std_radical_walkconstructor (p_vrf_node->sai_route_tree,
@@ -771,7 +790,7 @@ sai_object_id_t vr_id, uint32_t attr_count, sai_attribute_t *attr_list)
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    sai_fib_lock ();
+    sai_fib_read_lock ();
 
     do {
         p_vrf_node = sai_fib_vrf_node_get (vr_id);
@@ -802,7 +821,7 @@ sai_object_id_t vr_id, uint32_t attr_count, sai_attribute_t *attr_list)
         SAI_ROUTER_LOG_ERR ("Failed to get VRF attributes.");
     }
 
-    sai_fib_unlock ();
+    sai_fib_read_unlock ();
 
     return sai_rc;
 }
@@ -922,7 +941,7 @@ sai_status_t sai_fib_get_vr_id_for_rif (sai_object_id_t rif_id,
 {
     sai_status_t  status = SAI_STATUS_SUCCESS;
 
-    sai_fib_lock ();
+    sai_fib_read_lock ();
 
     sai_fib_vrf_t *p_vrf_node = sai_fib_get_vrf_node_for_rif (rif_id);
 
@@ -935,7 +954,7 @@ sai_status_t sai_fib_get_vr_id_for_rif (sai_object_id_t rif_id,
         status = SAI_STATUS_INVALID_OBJECT_ID;
     }
 
-    sai_fib_unlock();
+    sai_fib_read_unlock();
 
     return status;
 }
@@ -33,9 +33,152 @@
 #include "sai_oid_utils.h"
 #include "sai_l3_util.h"
 #include "sai_lag_api.h"
+#include "sai_port_utils.h"
+#include "sai_vlan_api.h"
+#include "sai_vm_vport.h"
+#include "sai_vm_bridge_link.h"
+#include "sai_vm_mroute.h"
+#include "sai_vm_ipmc.h"
+#include "sai_debug_utils.h"
+#include <net/if.h>
+
+static dn_sai_id_gen_info_t ipmc_group_obj_gen_info;
+static dn_sai_id_gen_info_t ipmc_member_obj_gen_info;
+static dn_sai_id_gen_info_t rpf_group_obj_gen_info;
+static dn_sai_id_gen_info_t rpf_member_obj_gen_info;
+
+static bool sai_vm_is_ipmc_group_id_in_use(uint64_t obj_id)
+{
+    return (sai_find_ipmc_group_node(
+                sai_uoid_create(SAI_OBJECT_TYPE_IPMC_GROUP, obj_id)) != NULL);
+}
+
+static bool sai_vm_is_ipmc_member_id_in_use(uint64_t obj_id)
+{
+    return (sai_find_ipmc_group_member_node(
+                sai_uoid_create(SAI_OBJECT_TYPE_IPMC_GROUP_MEMBER, obj_id)) != NULL);
+}
+
+static bool sai_vm_is_rpf_group_id_in_use(uint64_t obj_id)
+{
+    return (sai_find_ipmc_rpf_group_node(
+                sai_uoid_create(SAI_OBJECT_TYPE_RPF_GROUP, obj_id)) != NULL);
+}
+
+static bool sai_vm_is_rpf_member_id_in_use(uint64_t obj_id)
+{
+    return (sai_find_ipmc_rpf_group_member_node(
+                sai_uoid_create(SAI_OBJECT_TYPE_RPF_GROUP_MEMBER, obj_id)) != NULL);
+}
+
+static sai_object_id_t sai_vm_ipmc_id_create(dn_sai_id_gen_info_t *gen_info,
+                                             sai_object_type_t obj_type)
+{
+    if(SAI_STATUS_SUCCESS == dn_sai_get_next_free_id(gen_info)) {
+        return (sai_uoid_create(obj_type, gen_info->cur_id));
+    }
+    return SAI_NULL_OBJECT_ID;
+}
+
+static void sai_vm_ipmc_id_gen_init(dn_sai_id_gen_info_t *gen_info,
+                                    dn_sai_id_in_use_check_fn is_id_in_use)
+{
+    gen_info->cur_id = 0;
+    gen_info->is_wrappped = false;
+    gen_info->mask = SAI_UOID_NPU_OBJ_ID_MASK;
+    gen_info->is_id_in_use = is_id_in_use;
+}
+
+int sai_vm_ipmc_rif_if_index_get(sai_object_id_t rif_id)
+{
+    sai_fib_router_interface_t *p_rif_node = NULL;
+    sai_port_info_t            *p_port_info = NULL;
+    const char                 *if_name = NULL;
+    char                        vlan_if_name [IFNAMSIZ];
+    int                         if_index = 0;
+
+    sai_fib_lock();
+    do {
+        p_rif_node = sai_fib_router_interface_node_get(rif_id);
+        if(p_rif_node == NULL) {
+            break;
+        }
+
+        if(p_rif_node->type == SAI_ROUTER_INTERFACE_TYPE_VLAN) {
+            snprintf(vlan_if_name, sizeof(vlan_if_name), SAI_VM_BRIDGE_VLAN_NAME_FMT,
+                     sai_vlan_obj_id_to_vlan_id(p_rif_node->attachment.vlan_id));
+            if_index = (int) if_nametoindex(vlan_if_name);
+            break;
+        }
+
+        /* LAG members have no kernel device standing for the whole LAG */
+        if((p_rif_node->type != SAI_ROUTER_INTERFACE_TYPE_PORT) ||
+           sai_fib_rif_is_attachment_lag(p_rif_node)) {
+            break;
+        }
+
+        p_port_info = sai_port_info_get(p_rif_node->attachment.port_id);
+        if(p_port_info == NULL) {
+            break;
+        }
+
+        if_name = sai_vm_vport_get_if_name(p_port_info->phy_port_id);
+        if(if_name != NULL) {
+            if_index = (int) if_nametoindex(if_name);
+        }
+    } while(0);
+    sai_fib_unlock();
+
+    return if_index;
+}
+
+/* Adds the VIF of the member RIF, entries without it keep software state only */
+static sai_status_t sai_vm_ipmc_member_hw_info_create(sai_object_id_t rif_id,
+                                                      void **hw_info)
+{
+    sai_vm_ipmc_member_hw_info_t *p_hw_info = NULL;
+
+    p_hw_info = (sai_vm_ipmc_member_hw_info_t *) calloc(1, sizeof(*p_hw_info));
+    if(p_hw_info == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    p_hw_info->if_index = sai_vm_ipmc_rif_if_index_get(rif_id);
+    p_hw_info->vif = sai_vm_mroute_vif_get(p_hw_info->if_index);
+
+    if(p_hw_info->vif == SAI_VM_MROUTE_INVALID_VIF) {
+        SAI_IPMC_LOG_INFO(SAI_API_IPMC_GROUP, "RIF 0x%"PRIx64" interface %d has no VIF",
+                          rif_id, p_hw_info->if_index);
+    }
+
+    *hw_info = p_hw_info;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_vm_ipmc_member_hw_info_free(void **hw_info)
+{
+    sai_vm_ipmc_member_hw_info_t *p_hw_info = (sai_vm_ipmc_member_hw_info_t *) *hw_info;
+
+    if(p_hw_info == NULL) {
+        return;
+    }
+
+    if(p_hw_info->vif != SAI_VM_MROUTE_INVALID_VIF) {
+        sai_vm_mroute_vif_put(p_hw_info->if_index);
+    }
+
+    free(p_hw_info);
+    *hw_info = NULL;
+}
 
 static sai_status_t sai_vm_l3_ipmc_init(void)
 {
+    sai_vm_ipmc_id_gen_init(&ipmc_group_obj_gen_info, sai_vm_is_ipmc_group_id_in_use);
+    sai_vm_ipmc_id_gen_init(&ipmc_member_obj_gen_info, sai_vm_is_ipmc_member_id_in_use);
+    sai_vm_ipmc_id_gen_init(&rpf_group_obj_gen_info, sai_vm_is_rpf_group_id_in_use);
+    sai_vm_ipmc_id_gen_init(&rpf_member_obj_gen_info, sai_vm_is_rpf_member_id_in_use);
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -51,6 +194,13 @@ static sai_status_t sai_vm_l3_ipmc_repl_group_delete(dn_sai_ipmc_repl_group_node
 
 static sai_status_t sai_vm_l3_ipmc_rpf_group_create(dn_sai_ipmc_rpf_group_node_t *ipmc_rpf_group_node)
 {
+    STD_ASSERT(ipmc_rpf_group_node != NULL);
+
+    ipmc_rpf_group_node->ipmc_rpf_group_id =
+        sai_vm_ipmc_id_create(&rpf_group_obj_gen_info, SAI_OBJECT_TYPE_RPF_GROUP);
+    if(ipmc_rpf_group_node->ipmc_rpf_group_id == SAI_NULL_OBJECT_ID) {
+        return SAI_STATUS_TABLE_FULL;
+    }
     return SAI_STATUS_SUCCESS;
 }
 
@@ -68,7 +218,19 @@ static sai_status_t sai_vm_l3_ipmc_rpf_group_member_create(
                      dn_sai_ipmc_rpf_group_node_t *ipmc_rpf_group_node,
                      dn_sai_ipmc_rpf_group_member_node_t *ipmc_rpf_group_member_node)
 {
-    return SAI_STATUS_SUCCESS;
+    sai_status_t sai_rc;
+
+    STD_ASSERT(ipmc_rpf_group_member_node != NULL);
+
+    ipmc_rpf_group_member_node->ipmc_rpf_grp_member_id =
+        sai_vm_ipmc_id_create(&rpf_member_obj_gen_info, SAI_OBJECT_TYPE_RPF_GROUP_MEMBER);
+    if(ipmc_rpf_group_member_node->ipmc_rpf_grp_member_id == SAI_NULL_OBJECT_ID) {
+        return SAI_STATUS_TABLE_FULL;
+    }
+
+    sai_rc = sai_vm_ipmc_member_hw_info_create(ipmc_rpf_group_member_node->router_intf_id,
+                                               &ipmc_rpf_group_member_node->hw_info);
+    return sai_rc;
 }
 
 static sai_status_t sai_vm_l3_ipmc_rpf_group_member_delete(
@@ -76,6 +238,9 @@ static sai_status_t sai_vm_l3_ipmc_rpf_group_member_delete(
                          dn_sai_ipmc_rpf_group_member_node_t *ipmc_rpf_group_member_node)
 
 {
+    STD_ASSERT(ipmc_rpf_group_member_node != NULL);
+
+    sai_vm_ipmc_member_hw_info_free(&ipmc_rpf_group_member_node->hw_info);
     return SAI_STATUS_SUCCESS;
 }
 
@@ -97,7 +262,63 @@ static sai_status_t sai_vm_l3_ipmc_rpf_group_member_port_del(
 
 void sai_vm_l3_ipmc_rpf_group_member_dump_hw_info(const void *hw_info)
 {
-    return;
+    const sai_vm_ipmc_member_hw_info_t *p_hw_info =
+        (const sai_vm_ipmc_member_hw_info_t *) hw_info;
+
+    if(p_hw_info == NULL) {
+        return;
+    }
+    SAI_DEBUG("    Interface index: %d, VIF: %d", p_hw_info->if_index, p_hw_info->vif);
+}
+
+static sai_status_t sai_vm_l3_ipmc_group_create(dn_sai_ipmc_group_node_t *ipmc_group_node)
+{
+    STD_ASSERT(ipmc_group_node != NULL);
+
+    ipmc_group_node->ipmc_group_id =
+        sai_vm_ipmc_id_create(&ipmc_group_obj_gen_info, SAI_OBJECT_TYPE_IPMC_GROUP);
+    if(ipmc_group_node->ipmc_group_id == SAI_NULL_OBJECT_ID) {
+        return SAI_STATUS_TABLE_FULL;
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_vm_l3_ipmc_group_delete(dn_sai_ipmc_group_node_t *ipmc_group_node)
+{
+    STD_ASSERT(ipmc_group_node != NULL);
+
+    if(!sai_is_obj_id_ipmc_group(ipmc_group_node->ipmc_group_id)) {
+        SAI_IPMC_LOG_ERR(SAI_API_IPMC_GROUP, "Wrong ipmc_group_id 0x%"PRIx64"",
+                         ipmc_group_node->ipmc_group_id);
+        return SAI_STATUS_FAILURE;
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_vm_l3_ipmc_group_member_create(
+                     dn_sai_ipmc_group_node_t *ipmc_group_node,
+                     dn_sai_ipmc_group_member_node_t *ipmc_group_member_node)
+{
+    STD_ASSERT(ipmc_group_member_node != NULL);
+
+    ipmc_group_member_node->ipmc_grp_member_id =
+        sai_vm_ipmc_id_create(&ipmc_member_obj_gen_info, SAI_OBJECT_TYPE_IPMC_GROUP_MEMBER);
+    if(ipmc_group_member_node->ipmc_grp_member_id == SAI_NULL_OBJECT_ID) {
+        return SAI_STATUS_TABLE_FULL;
+    }
+
+    return sai_vm_ipmc_member_hw_info_create(ipmc_group_member_node->router_intf_id,
+                                             &ipmc_group_member_node->hw_info);
+}
+
+static sai_status_t sai_vm_l3_ipmc_group_member_delete(
+                     dn_sai_ipmc_group_node_t *ipmc_group_node,
+                     dn_sai_ipmc_group_member_node_t *ipmc_group_member_node)
+{
+    STD_ASSERT(ipmc_group_member_node != NULL);
+
+    sai_vm_ipmc_member_hw_info_free(&ipmc_group_member_node->hw_info);
+    return SAI_STATUS_SUCCESS;
 }
 
 static sai_npu_l3_ipmc_api_t sai_vm_l3_ipmc_api_table = {
@@ -112,6 +333,10 @@ static sai_npu_l3_ipmc_api_t sai_vm_l3_ipmc_api_table = {
     sai_vm_l3_ipmc_rpf_group_member_port_add,
     sai_vm_l3_ipmc_rpf_group_member_port_del,
     sai_vm_l3_ipmc_rpf_group_member_dump_hw_info,
+    sai_vm_l3_ipmc_group_create,
+    sai_vm_l3_ipmc_group_delete,
+    sai_vm_l3_ipmc_group_member_create,
+    sai_vm_l3_ipmc_group_member_delete,
 };
 
 sai_npu_l3_ipmc_api_t* sai_vm_l3_ipmc_api_query (void)
@@ -40,25 +40,305 @@
 #include "sai_mcast_api.h"
 #include "saiipmc.h"
 #include "sai_npu_l3_mcast.h"
+#include "sai_npu_ipmc.h"
+#include "sai_vm_mroute.h"
+#include "sai_vm_ipmc.h"
+#include "std_rbtree.h"
+#include "std_struct_utils.h"
+
+/*
+ * Kernel MFC state of an IPMC entry. An entry change is applied as the
+ * difference with this state, so that a membership change is one in place
+ * MFC update and the kernel counters of the entry are kept.
+ * Accessed with the L3 multicast lock held by the callers.
+ */
+typedef struct _sai_vm_l3_mcast_mfc_t {
+    dn_sai_l3_mcast_entry_key_t  key;
+    /* Same (S,G) as an entry of another virtual router, which owns the kernel entry */
+    bool                         shadowed;
+    bool                         installed;
+    int                          parent_vif;
+    uint8_t                      ttls [SAI_VM_MROUTE_MAX_VIFS];
+} sai_vm_l3_mcast_mfc_t;
+
+static rbtree_handle sai_vm_l3_mcast_mfc_tree = NULL;
 
 static sai_status_t sai_vm_l3_mcast_init(void)
 {
+    if (sai_vm_l3_mcast_mfc_tree != NULL) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_vm_l3_mcast_mfc_tree = std_rbtree_create_simple ("SAI VM L3 mcast MFC tree",
+            STD_STR_OFFSET_OF (sai_vm_l3_mcast_mfc_t, key),
+            STD_STR_SIZE_OF (sai_vm_l3_mcast_mfc_t, key));
+
+    if (sai_vm_l3_mcast_mfc_tree == NULL) {
+        SAI_L3_MCAST_LOG_CRIT ("Unable to create L3 mcast MFC tree.");
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    return sai_vm_mroute_init ();
+}
+
+/* Parent VIF of the entry: the first RPF member with a VIF */
+static int sai_vm_l3_mcast_parent_vif_get(const dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node)
+{
+    dn_sai_ipmc_rpf_group_node_t            *rpf_group_node = NULL;
+    dn_sai_ipmc_rpf_group_member_dll_node_t *rpf_member_dll_node = NULL;
+    std_dll *node = NULL;
+    int      vif;
+
+    rpf_group_node = sai_find_ipmc_rpf_group_node(l3_mcast_entry_node->mcast_rpf_group_id);
+    if (rpf_group_node == NULL) {
+        return SAI_VM_MROUTE_INVALID_VIF;
+    }
+
+    for (node = std_dll_getfirst(&(rpf_group_node->member_list)); node != NULL;
+         node = std_dll_getnext(&(rpf_group_node->member_list), node)) {
+        rpf_member_dll_node = (dn_sai_ipmc_rpf_group_member_dll_node_t *)node;
+        vif = sai_vm_ipmc_member_vif_get(rpf_member_dll_node->ipmc_rpf_group_member_info->hw_info);
+        if (vif != SAI_VM_MROUTE_INVALID_VIF) {
+            return vif;
+        }
+    }
+
+    return SAI_VM_MROUTE_INVALID_VIF;
+}
+
+/*
+ * Renders the kernel MFC entry of an IPMC entry.
+ * Returns false if the entry is not programmed in the kernel: IPv6 entries,
+ * shadowed entries, entries trapped to the CPU and entries without an RPF
+ * interface VIF.
+ */
+static bool sai_vm_l3_mcast_mfc_render(const dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node,
+                                       sai_vm_l3_mcast_mfc_t *mfc)
+{
+    dn_sai_ipmc_group_node_t            *ipmc_group_node = NULL;
+    dn_sai_ipmc_group_member_dll_node_t *ipmc_member_dll_node = NULL;
+    std_dll *node = NULL;
+    int      vif;
+
+    memset (mfc->ttls, SAI_VM_MROUTE_NO_OIF_TTL, sizeof (mfc->ttls));
+    mfc->parent_vif = SAI_VM_MROUTE_INVALID_VIF;
+
+    if (mfc->shadowed) {
+        return false;
+    }
+
+    if (l3_mcast_entry_node->mcast_key.grp_addr.addr_family != SAI_IP_ADDR_FAMILY_IPV4) {
+        return false;
+    }
+
+    if ((l3_mcast_entry_node->action != SAI_PACKET_ACTION_FORWARD) &&
+        (l3_mcast_entry_node->action != SAI_PACKET_ACTION_DROP)) {
+        return false;
+    }
+
+    mfc->parent_vif = sai_vm_l3_mcast_parent_vif_get(l3_mcast_entry_node);
+    if (mfc->parent_vif == SAI_VM_MROUTE_INVALID_VIF) {
+        return false;
+    }
+
+    /* A dropped entry is kept with an empty output list */
+    if (l3_mcast_entry_node->action == SAI_PACKET_ACTION_DROP) {
+        return true;
+    }
+
+    ipmc_group_node = sai_find_ipmc_group_node(l3_mcast_entry_node->mcast_ipmc_group_id);
+    if (ipmc_group_node == NULL) {
+        return true;
+    }
+
+    for (node = std_dll_getfirst(&(ipmc_group_node->member_list)); node != NULL;
+         node = std_dll_getnext(&(ipmc_group_node->member_list), node)) {
+        ipmc_member_dll_node = (dn_sai_ipmc_group_member_dll_node_t *)node;
+        vif = sai_vm_ipmc_member_vif_get(ipmc_member_dll_node->ipmc_group_member_info->hw_info);
+
+        /* Traffic is not sent back on its RPF interface */
+        if ((vif != SAI_VM_MROUTE_INVALID_VIF) && (vif != mfc->parent_vif)) {
+            mfc->ttls [vif] = SAI_VM_MROUTE_OIF_TTL;
+        }
+    }
+
+    return true;
+}
+
+static bool sai_vm_l3_mcast_mfc_same_sg(const dn_sai_l3_mcast_entry_key_t *key1,
+                                        const dn_sai_l3_mcast_entry_key_t *key2)
+{
+    return ((key1->entry_type == key2->entry_type) &&
+            (memcmp (&key1->grp_addr, &key2->grp_addr, sizeof (key1->grp_addr)) == 0) &&
+            (memcmp (&key1->src_addr, &key2->src_addr, sizeof (key1->src_addr)) == 0));
+}
+
+/*
+ * The kernel has a single multicast routing table for all the virtual
+ * routers, the first entry of an (S,G) owns the kernel entry.
+ */
+static bool sai_vm_l3_mcast_mfc_is_shadowed(const dn_sai_l3_mcast_entry_key_t *key)
+{
+    sai_vm_l3_mcast_mfc_t *mfc = NULL;
+
+    for (mfc = (sai_vm_l3_mcast_mfc_t *) std_rbtree_getfirst (sai_vm_l3_mcast_mfc_tree);
+         mfc != NULL;
+         mfc = (sai_vm_l3_mcast_mfc_t *) std_rbtree_getnext (sai_vm_l3_mcast_mfc_tree, mfc)) {
+        if (!mfc->shadowed && sai_vm_l3_mcast_mfc_same_sg (&mfc->key, key)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static const sai_ip_address_t *sai_vm_l3_mcast_src_addr_get(const dn_sai_l3_mcast_entry_key_t *key)
+{
+    return ((key->entry_type == SAI_L3_MCAST_ENTRY_TYPE_SG) ? &key->src_addr : NULL);
+}
+
+/* Applies the difference between the rendered and the installed MFC entry */
+static sai_status_t sai_vm_l3_mcast_mfc_sync(const dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node,
+                                             sai_vm_l3_mcast_mfc_t *mfc)
+{
+    sai_vm_l3_mcast_mfc_t  new_mfc;
+    sai_status_t           sai_rc = SAI_STATUS_SUCCESS;
+    bool                   install;
+
+    install = sai_vm_l3_mcast_mfc_render(l3_mcast_entry_node, &new_mfc);
+
+    if (install) {
+        if (mfc->installed && (mfc->parent_vif == new_mfc.parent_vif) &&
+            (memcmp (mfc->ttls, new_mfc.ttls, sizeof (mfc->ttls)) == 0)) {
+            return SAI_STATUS_SUCCESS;
+        }
+
+        sai_rc = sai_vm_mroute_mfc_set (sai_vm_l3_mcast_src_addr_get (&mfc->key),
+                                        &mfc->key.grp_addr, new_mfc.parent_vif, new_mfc.ttls);
+    } else if (mfc->installed) {
+        sai_rc = sai_vm_mroute_mfc_del (sai_vm_l3_mcast_src_addr_get (&mfc->key),
+                                        &mfc->key.grp_addr);
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        return sai_rc;
+    }
+
+    mfc->installed = install;
+    mfc->parent_vif = new_mfc.parent_vif;
+    memcpy (mfc->ttls, new_mfc.ttls, sizeof (mfc->ttls));
+
     return SAI_STATUS_SUCCESS;
 }
 
+/* Hands the kernel entry of a removed (S,G) over to a shadowed entry */
+static void sai_vm_l3_mcast_mfc_owner_elect(const dn_sai_l3_mcast_entry_key_t *key)
+{
+    dn_sai_l3_mcast_entry_node_t  entry_node;
+    dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node = NULL;
+    sai_vm_l3_mcast_mfc_t        *mfc = NULL;
+
+    for (mfc = (sai_vm_l3_mcast_mfc_t *) std_rbtree_getfirst (sai_vm_l3_mcast_mfc_tree);
+         mfc != NULL;
+         mfc = (sai_vm_l3_mcast_mfc_t *) std_rbtree_getnext (sai_vm_l3_mcast_mfc_tree, mfc)) {
+        if (mfc->shadowed && sai_vm_l3_mcast_mfc_same_sg (&mfc->key, key)) {
+            break;
+        }
+    }
+
+    if (mfc == NULL) {
+        return;
+    }
+
+    memset (&entry_node, 0, sizeof (entry_node));
+    entry_node.mcast_key = mfc->key;
+    l3_mcast_entry_node = sai_find_l3_mcast_entry (&entry_node);
+
+    mfc->shadowed = false;
+    if ((l3_mcast_entry_node != NULL) &&
+        (sai_vm_l3_mcast_mfc_sync (l3_mcast_entry_node, mfc) != SAI_STATUS_SUCCESS)) {
+        SAI_L3_MCAST_LOG_ERR ("Kernel entry hand over to VRF 0x%"PRIx64" failed",
+                              mfc->key.vrf_id);
+    }
+}
+
 static sai_status_t sai_vm_l3_mcast_entry_create(const dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node)
 {
+    sai_vm_l3_mcast_mfc_t *mfc = NULL;
+    sai_status_t           sai_rc;
+
+    STD_ASSERT (l3_mcast_entry_node != NULL);
+
+    mfc = (sai_vm_l3_mcast_mfc_t *) calloc (1, sizeof (*mfc));
+    if (mfc == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+    mfc->key = l3_mcast_entry_node->mcast_key;
+    mfc->shadowed = sai_vm_l3_mcast_mfc_is_shadowed (&mfc->key);
+
+    sai_rc = sai_vm_l3_mcast_mfc_sync (l3_mcast_entry_node, mfc);
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        free (mfc);
+        return sai_rc;
+    }
+
+    if (std_rbtree_insert (sai_vm_l3_mcast_mfc_tree, mfc) != STD_ERR_OK) {
+        if (mfc->installed) {
+            sai_vm_mroute_mfc_del (sai_vm_l3_mcast_src_addr_get (&mfc->key), &mfc->key.grp_addr);
+        }
+        free (mfc);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
     return SAI_STATUS_SUCCESS;
 }
 
 static sai_status_t sai_vm_l3_mcast_entry_remove(const dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node)
 {
+    sai_vm_l3_mcast_mfc_t  key_mfc;
+    sai_vm_l3_mcast_mfc_t *mfc = NULL;
+    sai_status_t           sai_rc = SAI_STATUS_SUCCESS;
+
+    STD_ASSERT (l3_mcast_entry_node != NULL);
+
+    key_mfc.key = l3_mcast_entry_node->mcast_key;
+    mfc = (sai_vm_l3_mcast_mfc_t *) std_rbtree_getexact (sai_vm_l3_mcast_mfc_tree, &key_mfc);
+    if (mfc == NULL) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (mfc->installed) {
+        sai_rc = sai_vm_mroute_mfc_del (sai_vm_l3_mcast_src_addr_get (&mfc->key),
+                                        &mfc->key.grp_addr);
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            return sai_rc;
+        }
+    }
+
+    std_rbtree_remove (sai_vm_l3_mcast_mfc_tree, mfc);
+
+    if (!mfc->shadowed) {
+        sai_vm_l3_mcast_mfc_owner_elect (&mfc->key);
+    }
+    free (mfc);
+
     return SAI_STATUS_SUCCESS;
 }
 
 static sai_status_t sai_vm_l3_mcast_entry_update(const dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node)
 {
-    return SAI_STATUS_SUCCESS;
+    sai_vm_l3_mcast_mfc_t  key_mfc;
+    sai_vm_l3_mcast_mfc_t *mfc = NULL;
+
+    STD_ASSERT (l3_mcast_entry_node != NULL);
+
+    key_mfc.key = l3_mcast_entry_node->mcast_key;
+    mfc = (sai_vm_l3_mcast_mfc_t *) std_rbtree_getexact (sai_vm_l3_mcast_mfc_tree, &key_mfc);
+    if (mfc == NULL) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    return sai_vm_l3_mcast_mfc_sync (l3_mcast_entry_node, mfc);
 }
 
 static sai_status_t sai_vm_l3_mcast_entry_get(const dn_sai_l3_mcast_entry_node_t *l3_mcast_entry_node)
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file sai_vm_mroute.c
+*
+* @brief This file contains the VIF and MFC programming of the kernel
+*        IPv4 multicast routing table for sai-vm.
+*************************************************************************/
+
+#include "std_assert.h"
+#include "std_mutex_lock.h"
+#include "std_socket_tools.h"
+#include "saistatus.h"
+#include "sai_event_log.h"
+#include "sai_l3_mcast_common.h"
+#include "sai_vm_mroute.h"
+#include "sai_vm_rtnl.h"
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <linux/mroute.h>
+
+#if (SAI_VM_MROUTE_MAX_VIFS != MAXVIFS)
+#error "SAI_VM_MROUTE_MAX_VIFS does not match the kernel VIF table size"
+#endif
+
+/* Kernel VIF and the interface it stands for */
+typedef struct _sai_vm_mroute_vif_t {
+    int    if_index;
+    uint_t ref_count;
+} sai_vm_mroute_vif_t;
+
+static sai_vm_mroute_vif_t sai_vm_mroute_vifs [SAI_VM_MROUTE_MAX_VIFS];
+
+/* mroute socket, invalid when the entries are kept in software only */
+static int sai_vm_mroute_sock = STD_INVALID_FD;
+
+static std_mutex_lock_create_static_init_fast(sai_vm_mroute_lock);
+
+sai_status_t sai_vm_mroute_init (void)
+{
+    int one = 1;
+    int sock;
+
+    memset (sai_vm_mroute_vifs, 0, sizeof (sai_vm_mroute_vifs));
+
+    /* Upcalls for unresolved packets are never read, they are dropped */
+    sock = socket (AF_INET, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_IGMP);
+    if (sock < 0) {
+        SAI_L3_MCAST_LOG_ERR ("Cannot open mroute socket %s(%d), IPMC entries "
+                              "are kept in software only", strerror (errno), errno);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    /* EADDRINUSE if a multicast routing daemon owns the table */
+    if (setsockopt (sock, IPPROTO_IP, MRT_INIT, &one, sizeof (one)) != 0) {
+        SAI_L3_MCAST_LOG_ERR ("Cannot own the multicast routing table %s(%d), IPMC "
+                              "entries are kept in software only", strerror (errno), errno);
+        close (sock);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_vm_mroute_sock = sock;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static int sai_vm_mroute_vif_find_locked (int if_index)
+{
+    int vif;
+
+    for (vif = 0; vif < SAI_VM_MROUTE_MAX_VIFS; vif++) {
+        if ((sai_vm_mroute_vifs [vif].ref_count > 0) &&
+            (sai_vm_mroute_vifs [vif].if_index == if_index)) {
+            return vif;
+        }
+    }
+
+    return SAI_VM_MROUTE_INVALID_VIF;
+}
+
+int sai_vm_mroute_vif_find (int if_index)
+{
+    int vif;
+
+    std_mutex_lock (&sai_vm_mroute_lock);
+    vif = sai_vm_mroute_vif_find_locked (if_index);
+    std_mutex_unlock (&sai_vm_mroute_lock);
+
+    return vif;
+}
+
+int sai_vm_mroute_vif_get (int if_index)
+{
+    struct vifctl vc;
+    int           vif;
+
+    if ((sai_vm_mroute_sock == STD_INVALID_FD) || (if_index <= 0)) {
+        return SAI_VM_MROUTE_INVALID_VIF;
+    }
+
+    std_mutex_lock (&sai_vm_mroute_lock);
+
+    do {
+        vif = sai_vm_mroute_vif_find_locked (if_index);
+        if (vif != SAI_VM_MROUTE_INVALID_VIF) {
+            sai_vm_mroute_vifs [vif].ref_count++;
+            break;
+        }
+
+        for (vif = 0; vif < SAI_VM_MROUTE_MAX_VIFS; vif++) {
+            if (sai_vm_mroute_vifs [vif].ref_count == 0) {
+                break;
+            }
+        }
+
+        if (vif == SAI_VM_MROUTE_MAX_VIFS) {
+            SAI_L3_MCAST_LOG_ERR ("No free VIF for interface %d", if_index);
+            vif = SAI_VM_MROUTE_INVALID_VIF;
+            break;
+        }
+
+        memset (&vc, 0, sizeof (vc));
+        vc.vifc_vifi = vif;
+        vc.vifc_flags = VIFF_USE_IFINDEX;
+        vc.vifc_threshold = SAI_VM_MROUTE_OIF_TTL;
+        vc.vifc_lcl_ifindex = if_index;
+
+        if (setsockopt (sai_vm_mroute_sock, IPPROTO_IP, MRT_ADD_VIF, &vc, sizeof (vc)) != 0) {
+            SAI_L3_MCAST_LOG_ERR ("VIF %d add for interface %d failed %s(%d)",
+                                  vif, if_index, strerror (errno), errno);
+            vif = SAI_VM_MROUTE_INVALID_VIF;
+            break;
+        }
+
+        sai_vm_mroute_vifs [vif].if_index = if_index;
+        sai_vm_mroute_vifs [vif].ref_count = 1;
+
+        SAI_L3_MCAST_LOG_TRACE ("Added VIF %d for interface %d", vif, if_index);
+    } while (0);
+
+    std_mutex_unlock (&sai_vm_mroute_lock);
+
+    return vif;
+}
+
+void sai_vm_mroute_vif_put (int if_index)
+{
+    struct vifctl vc;
+    int           vif;
+
+    std_mutex_lock (&sai_vm_mroute_lock);
+
+    vif = sai_vm_mroute_vif_find_locked (if_index);
+
+    if ((vif != SAI_VM_MROUTE_INVALID_VIF) &&
+        (--sai_vm_mroute_vifs [vif].ref_count == 0)) {
+        memset (&vc, 0, sizeof (vc));
+        vc.vifc_vifi = vif;
+
+        /* The kernel drops the VIF from the output list of the MFC entries */
+        if (setsockopt (sai_vm_mroute_sock, IPPROTO_IP, MRT_DEL_VIF, &vc, sizeof (vc)) != 0) {
+            SAI_L3_MCAST_LOG_ERR ("VIF %d delete for interface %d failed %s(%d)",
+                                  vif, if_index, strerror (errno), errno);
+        }
+
+        SAI_L3_MCAST_LOG_TRACE ("Deleted VIF %d of interface %d", vif, if_index);
+    }
+
+    std_mutex_unlock (&sai_vm_mroute_lock);
+}
+
+static void sai_vm_mroute_mfcctl_init (struct mfcctl *mc, const sai_ip_address_t *src_addr,
+                                       const sai_ip_address_t *grp_addr)
+{
+    memset (mc, 0, sizeof (*mc));
+
+    mc->mfcc_mcastgrp.s_addr = grp_addr->addr.ip4;
+
+    /* INADDR_ANY origin is a (*,G) entry */
+    if (src_addr != NULL) {
+        mc->mfcc_origin.s_addr = src_addr->addr.ip4;
+    }
+}
+
+sai_status_t sai_vm_mroute_mfc_set (const sai_ip_address_t *src_addr,
+                                    const sai_ip_address_t *grp_addr, int parent_vif,
+                                    const uint8_t ttls [SAI_VM_MROUTE_MAX_VIFS])
+{
+    struct mfcctl mc;
+
+    STD_ASSERT (grp_addr != NULL);
+    STD_ASSERT (ttls != NULL);
+
+    if (sai_vm_mroute_sock == STD_INVALID_FD) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if ((parent_vif < 0) || (parent_vif >= SAI_VM_MROUTE_MAX_VIFS)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_vm_mroute_mfcctl_init (&mc, src_addr, grp_addr);
+    mc.mfcc_parent = parent_vif;
+    memcpy (mc.mfcc_ttls, ttls, sizeof (mc.mfcc_ttls));
+
+    /* An existing entry gets the new parent and TTLs, its counters are kept */
+    if (setsockopt (sai_vm_mroute_sock, IPPROTO_IP, MRT_ADD_MFC, &mc, sizeof (mc)) != 0) {
+        SAI_L3_MCAST_LOG_ERR ("MFC entry set failed %s(%d)", strerror (errno), errno);
+        return sai_vm_rtnl_errno_to_sai_status (errno);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_vm_mroute_mfc_del (const sai_ip_address_t *src_addr,
+                                    const sai_ip_address_t *grp_addr)
+{
+    struct mfcctl mc;
+
+    STD_ASSERT (grp_addr != NULL);
+
+    if (sai_vm_mroute_sock == STD_INVALID_FD) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_vm_mroute_mfcctl_init (&mc, src_addr, grp_addr);
+
+    if ((setsockopt (sai_vm_mroute_sock, IPPROTO_IP, MRT_DEL_MFC, &mc, sizeof (mc)) != 0) &&
+        (errno != ENOENT)) {
+        SAI_L3_MCAST_LOG_ERR ("MFC entry delete failed %s(%d)", strerror (errno), errno);
+        return sai_vm_rtnl_errno_to_sai_status (errno);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
@@ -27,6 +27,7 @@
 #include "sai_l3_api.h"
 #include "sai_l3_util.h"
 #include "sai_l3_common.h"
+#include "sai_vm_tunnel.h"
 #include "sainexthop.h"
 #include "saitypes.h"
 #include "saistatus.h"
@@ -69,6 +70,19 @@ static sai_status_t sai_npu_next_hop_create (sai_fib_nh_t *p_next_hop,
         return SAI_STATUS_FAILURE;
     }
 
+    if (sai_fib_is_tunnel_encap_next_hop (p_next_hop)) {
+        sai_rc = sai_vm_tunnel_encap_nh_create (p_next_hop, nh_id);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_NEXTHOP_LOG_ERR ("Error rendering encap NH ID %d on the tunnel device.",
+                                 nh_id);
+
+            sai_nexthop_delete_db_entry (nh_obj_id);
+
+            return sai_rc;
+        }
+    }
+
     *p_next_hop_id = (sai_npu_object_id_t) nh_id;
 
     STD_BIT_ARRAY_CLR (sai_vm_access_nh_bitmap (), nh_id);
@@ -90,6 +104,10 @@ static sai_status_t sai_npu_next_hop_remove (sai_fib_nh_t *p_next_hop)
 
     SAI_NEXTHOP_LOG_TRACE ("Next Hop Deletion, Next Hop ID: 0x%"PRIx64".", nh_id);
 
+    if (sai_fib_is_tunnel_encap_next_hop (p_next_hop)) {
+        sai_vm_tunnel_encap_nh_remove (p_next_hop, nh_id);
+    }
+
     /* Remove Next Hop record from DB. */
     sai_rc = sai_nexthop_delete_db_entry (p_next_hop->next_hop_id);
 
@@ -43,9 +43,78 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 #include <stdlib.h>
 #include <stdint.h>
 
+/* ACL rows written by one SQL statement of the batch APIs */
+#define SAI_ACL_DB_BATCH_SIZE 256
+
+/* Insert rows in a table, with multi row statements */
+static sai_status_t sai_acl_db_rows_insert (const char *table_name,
+                                            const std::vector<std::string> &rows)
+{
+    size_t idx = 0;
+    size_t batch_idx = 0;
+
+    for (idx = 0; idx < rows.size(); idx += SAI_ACL_DB_BATCH_SIZE) {
+        std::string insert_str;
+
+        for (batch_idx = idx; (batch_idx < rows.size()) &&
+             (batch_idx < (idx + SAI_ACL_DB_BATCH_SIZE)); batch_idx++) {
+            if (batch_idx != idx) {
+                insert_str += ", ";
+            }
+
+            insert_str += rows [batch_idx];
+        }
+
+        if (db_sql_insert (sai_vm_get_db_handle(), table_name,
+                           insert_str.c_str()) != STD_ERR_OK) {
+            SAI_VM_DB_LOG_ERR ("Error inserting rows %zu to %zu of %zu to %s.",
+                               idx, batch_idx - 1, rows.size(), table_name);
+
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Delete the rows of a table whose key column is in a list of ids */
+static sai_status_t sai_acl_db_rows_delete (const char *table_name,
+                                            const char *key_str,
+                                            const std::vector<uint_t> &ids)
+{
+    size_t idx = 0;
+    size_t batch_idx = 0;
+
+    for (idx = 0; idx < ids.size(); idx += SAI_ACL_DB_BATCH_SIZE) {
+        std::string delete_str = std::string ("( ") + key_str + " IN (";
+
+        for (batch_idx = idx; (batch_idx < ids.size()) &&
+             (batch_idx < (idx + SAI_ACL_DB_BATCH_SIZE)); batch_idx++) {
+            if (batch_idx != idx) {
+                delete_str += ", ";
+            }
+
+            delete_str += std::to_string (ids [batch_idx]);
+        }
+
+        delete_str += "))";
+
+        if (db_sql_delete (sai_vm_get_db_handle(), table_name,
+                           delete_str.c_str()) != STD_ERR_OK) {
+            SAI_VM_DB_LOG_ERR ("Error deleting rows %zu to %zu of %zu from %s.",
+                               idx, batch_idx - 1, ids.size(), table_name);
+
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
 static sai_status_t sai_acl_table_qualifier_list_db_populate (
 uint_t table_id, uint_t qual_count, sai_acl_table_attr_t *qual_list)
 {
@@ -77,7 +146,7 @@ uint_t table_id, uint_t qual_count, sai_acl_table_attr_t *qual_list)
 }
 
 static sai_status_t sai_acl_table_db_entry_update_usage_count_field (
-sai_object_id_t acl_tbl_obj_id, std::string *p_field_str, bool is_add)
+sai_object_id_t acl_tbl_obj_id, std::string *p_field_str, int delta)
 {
     uint_t      acl_table_id = 0;
     uint_t      num_counters_in_use = 0;
@@ -106,7 +175,7 @@ sai_object_id_t acl_tbl_obj_id, std::string *p_field_str, bool is_add)
 
     /* Update the number of counters in use for the table ID */
     num_counters_in_use = std::atoi (num_counters_str);
-    (is_add)? num_counters_in_use++ : num_counters_in_use--;
+    num_counters_in_use += delta;
     value_str = std::to_string (num_counters_in_use);
 
     if (db_sql_set_attribute (sai_vm_get_db_handle(), "SAI_ACL_TABLE",
@@ -123,23 +192,41 @@ sai_object_id_t acl_tbl_obj_id, std::string *p_field_str, bool is_add)
 }
 
 static sai_status_t sai_acl_table_db_entry_update_total_counters (
-sai_object_id_t acl_tbl_obj_id, bool is_add)
+sai_object_id_t acl_tbl_obj_id, int delta)
 {
     std::string field_str = "num_counters_in_use";
 
     return (sai_acl_table_db_entry_update_usage_count_field (acl_tbl_obj_id,
                                                              &field_str,
-                                                             is_add));
+                                                             delta));
 }
 
 static sai_status_t sai_acl_table_db_entry_update_total_rules (
-sai_object_id_t acl_tbl_obj_id, bool is_add)
+sai_object_id_t acl_tbl_obj_id, int delta)
 {
     std::string field_str = "num_entries_in_use";
 
     return (sai_acl_table_db_entry_update_usage_count_field (acl_tbl_obj_id,
                                                              &field_str,
-                                                             is_add));
+                                                             delta));
+}
+
+/* Values of the filter list row of a rule filter */
+static std::string sai_acl_rule_filter_db_row_str_get (
+const std::string &rule_id_str, sai_acl_filter_t *p_filter)
+{
+    std::string match_data_str;
+    std::string match_mask_str;
+
+    std::string filter_str = sai_acl_rule_filter_attr_str_get (p_filter->field);
+    std::string admin_state_str = (p_filter->enable)? "1" : "0";
+
+    sai_acl_rule_filter_match_info_str_get (p_filter, &match_data_str,
+                                            &match_mask_str);
+
+    return (std::string ("( ") + rule_id_str + ", " + filter_str +
+            ", " + admin_state_str + ", " + match_data_str + ", " +
+            match_mask_str + std::string (")"));
 }
 
 static sai_status_t sai_acl_rule_filter_list_add_db_entry (
@@ -148,9 +235,6 @@ uint_t rule_id, uint_t filter_count, sai_acl_filter_t *p_list)
     size_t      idx = 0;
     std::string insert_str;
     std::string filter_str;
-    std::string admin_state_str;
-    std::string match_data_str;
-    std::string match_mask_str;
 
     STD_ASSERT (p_list != NULL);
 
@@ -159,14 +243,8 @@ uint_t rule_id, uint_t filter_count, sai_acl_filter_t *p_list)
     for (idx = 0; idx < filter_count; idx++) {
         filter_str = sai_acl_rule_filter_attr_str_get (p_list [idx].field);
 
-        admin_state_str = (p_list [idx].enable)? "1" : "0";
-
-        sai_acl_rule_filter_match_info_str_get (&p_list [idx], &match_data_str,
-                                                &match_mask_str);
-
-        insert_str = std::string ("( ") + rule_id_str + ", " + filter_str +
-            ", " + admin_state_str + ", " + match_data_str + ", " +
-            match_mask_str + std::string (")");
+        insert_str = sai_acl_rule_filter_db_row_str_get (rule_id_str,
+                                                         &p_list [idx]);
 
         if (db_sql_insert (sai_vm_get_db_handle(), "SAI_ACL_ENTRY_FILTER_LIST",
                            insert_str.c_str()) != STD_ERR_OK) {
@@ -273,14 +351,24 @@ uint_t *p_new_filter_count)
     return SAI_STATUS_SUCCESS;
 }
 
+/* Values of the action list row of a rule action */
+static std::string sai_acl_rule_action_db_row_str_get (
+const std::string &rule_id_str, sai_acl_action_t *p_action)
+{
+    std::string action_str = sai_acl_rule_action_attr_str_get (p_action->action);
+    std::string admin_state_str = (p_action->enable)? "1" : "0";
+    std::string param_str = sai_acl_rule_action_parameter_str_get (p_action);
+
+    return (std::string ("( ") + rule_id_str + ", " + action_str +
+            ", " + admin_state_str + ", " + param_str + std::string (")"));
+}
+
 static sai_status_t sai_acl_rule_action_list_add_db_entry (
 uint_t rule_id, uint_t action_count, sai_acl_action_t *p_list)
 {
     size_t      idx = 0;
     std::string insert_str;
     std::string action_str;
-    std::string admin_state_str;
-    std::string param_str;
 
     STD_ASSERT (p_list != NULL);
 
@@ -289,12 +377,8 @@ uint_t rule_id, uint_t action_count, sai_acl_action_t *p_list)
     for (idx = 0; idx < action_count; idx++) {
         action_str = sai_acl_rule_action_attr_str_get (p_list [idx].action);
 
-        admin_state_str = (p_list [idx].enable)? "1" : "0";
-
-        param_str = sai_acl_rule_action_parameter_str_get (&p_list [idx]);
-
-        insert_str = std::string ("( ") + rule_id_str + ", " + action_str +
-            ", " + admin_state_str + ", " + param_str + std::string (")");
+        insert_str = sai_acl_rule_action_db_row_str_get (rule_id_str,
+                                                         &p_list [idx]);
 
         if (db_sql_insert (sai_vm_get_db_handle(), "SAI_ACL_ENTRY_ACTION_LIST",
                            insert_str.c_str()) != STD_ERR_OK) {
@@ -492,15 +576,14 @@ sai_status_t sai_acl_table_delete_db_entry (sai_acl_table_t *p_acl_table)
     return SAI_STATUS_SUCCESS;
 }
 
-sai_status_t sai_acl_rule_create_db_entry (sai_acl_rule_t *p_acl_rule)
+/* Values of the ACL ENTRY row of a rule */
+static std::string sai_acl_rule_db_row_str_get (sai_acl_rule_t *p_acl_rule)
 {
     uint_t      acl_rule_id = 0;
     uint_t      acl_table_id = 0;
     uint_t      acl_cntr_id = 0;
     std::string cntr_id_str = "\"-\"";
 
-    STD_ASSERT (p_acl_rule != NULL);
-
     acl_rule_id =
         (uint_t) sai_uoid_npu_obj_id_get (p_acl_rule->rule_key.acl_id);
 
@@ -519,10 +602,28 @@ sai_status_t sai_acl_rule_create_db_entry (sai_acl_rule_t *p_acl_rule)
         cntr_id_str = std::to_string (acl_cntr_id);
     }
 
-    std::string insert_str = std::string ("( ") + rule_id_str + ", " +
-        table_id_str + ", " +  prio_str + ", " + admin_state_str + ", " +
-        num_filter_str + ", " + num_action_str + ", " + cntr_id_str +
-        std::string (")");
+    return (std::string ("( ") + rule_id_str + ", " +
+            table_id_str + ", " +  prio_str + ", " + admin_state_str + ", " +
+            num_filter_str + ", " + num_action_str + ", " + cntr_id_str +
+            std::string (")"));
+}
+
+sai_status_t sai_acl_rule_create_db_entry (sai_acl_rule_t *p_acl_rule)
+{
+    uint_t      acl_rule_id = 0;
+    uint_t      acl_table_id = 0;
+
+    STD_ASSERT (p_acl_rule != NULL);
+
+    acl_rule_id =
+        (uint_t) sai_uoid_npu_obj_id_get (p_acl_rule->rule_key.acl_id);
+
+    acl_table_id = (uint_t) sai_uoid_npu_obj_id_get (p_acl_rule->table_id);
+
+    std::string rule_id_str = std::to_string (acl_rule_id);
+    std::string table_id_str = std::to_string (acl_table_id);
+
+    std::string insert_str = sai_acl_rule_db_row_str_get (p_acl_rule);
 
     if (db_sql_insert (sai_vm_get_db_handle(), "SAI_ACL_ENTRY",
                        insert_str.c_str()) != STD_ERR_OK) {
@@ -557,7 +658,7 @@ sai_status_t sai_acl_rule_create_db_entry (sai_acl_rule_t *p_acl_rule)
 
     /* Increment total rules in use for the ACL TABLE DB entry */
     if (sai_acl_table_db_entry_update_total_rules (p_acl_rule->table_id,
-                                                   true /* add */)
+                                                   1 /* add */)
         != SAI_STATUS_SUCCESS) {
         SAI_VM_DB_LOG_ERR ("Error updating the total rules in use on "
                            "ACL TABLE for obj ID: 0x%" PRIx64 ".",
@@ -594,7 +695,7 @@ sai_status_t sai_acl_rule_delete_db_entry (sai_acl_rule_t *p_acl_rule)
 
     /* Decrement total rules in use for the ACL TABLE DB entry */
     if (sai_acl_table_db_entry_update_total_rules (p_acl_rule->table_id,
-                                                   false /* remove */)
+                                                   -1 /* remove */)
         != SAI_STATUS_SUCCESS) {
         SAI_VM_DB_LOG_ERR ("Error updating the total rules in use on "
                            "ACL TABLE for obj ID: 0x%" PRIx64 ".",
@@ -720,13 +821,12 @@ sai_status_t sai_acl_rule_db_entry_update_counter_id (sai_object_id_t rule_id,
     return SAI_STATUS_SUCCESS;
 }
 
-sai_status_t sai_acl_counter_create_db_entry (sai_acl_counter_t *p_acl_cntr)
+/* Values of the ACL COUNTER row of a counter */
+static std::string sai_acl_counter_db_row_str_get (sai_acl_counter_t *p_acl_cntr)
 {
     uint_t acl_cntr_id = 0;
     uint_t acl_table_id = 0;
 
-    STD_ASSERT (p_acl_cntr != NULL);
-
     acl_cntr_id =
         (uint_t) sai_uoid_npu_obj_id_get (p_acl_cntr->counter_key.counter_id);
 
@@ -739,9 +839,23 @@ sai_status_t sai_acl_counter_create_db_entry (sai_acl_counter_t *p_acl_cntr)
     std::string byte_count_str = "0";
     std::string pkt_count_str = "0";
 
-    std::string insert_str = std::string ("( ") + cntr_id_str + ", " +
-        table_id_str + ", " + type_str + ", " + num_ref_str + ", " +
-        byte_count_str + ", " + pkt_count_str + std::string (")");
+    return (std::string ("( ") + cntr_id_str + ", " +
+            table_id_str + ", " + type_str + ", " + num_ref_str + ", " +
+            byte_count_str + ", " + pkt_count_str + std::string (")"));
+}
+
+sai_status_t sai_acl_counter_create_db_entry (sai_acl_counter_t *p_acl_cntr)
+{
+    uint_t acl_cntr_id = 0;
+
+    STD_ASSERT (p_acl_cntr != NULL);
+
+    acl_cntr_id =
+        (uint_t) sai_uoid_npu_obj_id_get (p_acl_cntr->counter_key.counter_id);
+
+    std::string cntr_id_str = std::to_string (acl_cntr_id);
+
+    std::string insert_str = sai_acl_counter_db_row_str_get (p_acl_cntr);
 
     if (db_sql_insert (sai_vm_get_db_handle(), "SAI_ACL_COUNTER",
                        insert_str.c_str()) != STD_ERR_OK) {
@@ -754,7 +868,7 @@ sai_status_t sai_acl_counter_create_db_entry (sai_acl_counter_t *p_acl_cntr)
 
     /* Increment total counters in use for the ACL TABLE DB entry */
     if (sai_acl_table_db_entry_update_total_counters (p_acl_cntr->table_id,
-                                                      true /* add */)
+                                                      1 /* add */)
         != SAI_STATUS_SUCCESS) {
         SAI_VM_DB_LOG_ERR ("Error updating the total counters in use on "
                            "ACL TABLE for obj ID: 0x%" PRIx64 ".",
@@ -791,7 +905,7 @@ sai_status_t sai_acl_counter_delete_db_entry (sai_acl_counter_t *p_acl_cntr)
 
     /* Decrement total counters in use for the ACL TABLE DB entry */
     if (sai_acl_table_db_entry_update_total_counters (p_acl_cntr->table_id,
-                                                      false /* remove */)
+                                                      -1 /* remove */)
         != SAI_STATUS_SUCCESS) {
         SAI_VM_DB_LOG_ERR ("Error updating the total counters in use on "
                            "ACL TABLE for obj ID: 0x%" PRIx64 ".",
@@ -886,3 +1000,192 @@ sai_acl_counter_t *p_acl_cntr)
 
     return SAI_STATUS_SUCCESS;
 }
+
+/* Apply the rule or counter count changes of a batch to the ACL TABLE rows,
+ * once per run of objects of the same table */
+static sai_status_t sai_acl_table_db_entries_update_totals (
+uint_t count, const sai_object_id_t *table_id_list, int sign, bool is_rule)
+{
+    uint_t idx = 0;
+    uint_t run_start = 0;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+
+    while (idx < count) {
+        run_start = idx;
+
+        while ((idx < count) && (table_id_list [idx] == table_id_list [run_start])) {
+            idx++;
+        }
+
+        if (is_rule) {
+            sai_rc = sai_acl_table_db_entry_update_total_rules (
+                table_id_list [run_start], sign * (int)(idx - run_start));
+        } else {
+            sai_rc = sai_acl_table_db_entry_update_total_counters (
+                table_id_list [run_start], sign * (int)(idx - run_start));
+        }
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_VM_DB_LOG_ERR ("Error updating the totals in use on ACL TABLE "
+                               "for obj ID: 0x%" PRIx64 ".",
+                               table_id_list [run_start]);
+
+            return sai_rc;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_acl_rule_create_db_entries (uint_t count,
+                                             sai_acl_rule_t **rule_list)
+{
+    uint_t                       idx = 0;
+    uint_t                       list_idx = 0;
+    uint_t                       acl_rule_id = 0;
+    sai_acl_rule_t              *p_acl_rule = NULL;
+    std::vector<std::string>     entry_rows;
+    std::vector<std::string>     filter_rows;
+    std::vector<std::string>     action_rows;
+    std::vector<uint_t>          rule_id_list;
+    std::vector<sai_object_id_t> table_id_list;
+
+    STD_ASSERT (rule_list != NULL);
+
+    entry_rows.reserve (count);
+    rule_id_list.reserve (count);
+    table_id_list.reserve (count);
+
+    for (idx = 0; idx < count; idx++) {
+        p_acl_rule = rule_list [idx];
+
+        acl_rule_id =
+            (uint_t) sai_uoid_npu_obj_id_get (p_acl_rule->rule_key.acl_id);
+
+        std::string rule_id_str = std::to_string (acl_rule_id);
+
+        entry_rows.push_back (sai_acl_rule_db_row_str_get (p_acl_rule));
+        rule_id_list.push_back (acl_rule_id);
+        table_id_list.push_back (p_acl_rule->table_id);
+
+        for (list_idx = 0; list_idx < p_acl_rule->filter_count; list_idx++) {
+            filter_rows.push_back (sai_acl_rule_filter_db_row_str_get (
+                rule_id_str, &p_acl_rule->filter_list [list_idx]));
+        }
+
+        for (list_idx = 0; list_idx < p_acl_rule->action_count; list_idx++) {
+            action_rows.push_back (sai_acl_rule_action_db_row_str_get (
+                rule_id_str, &p_acl_rule->action_list [list_idx]));
+        }
+    }
+
+    if ((sai_acl_db_rows_insert ("SAI_ACL_ENTRY", entry_rows)
+         != SAI_STATUS_SUCCESS) ||
+        (sai_acl_db_rows_insert ("SAI_ACL_ENTRY_FILTER_LIST", filter_rows)
+         != SAI_STATUS_SUCCESS) ||
+        (sai_acl_db_rows_insert ("SAI_ACL_ENTRY_ACTION_LIST", action_rows)
+         != SAI_STATUS_SUCCESS)) {
+        SAI_VM_DB_LOG_ERR ("Error inserting a batch of %u ACL Rules.", count);
+
+        /* Leave none of the batch behind, for the rules to be retried */
+        sai_acl_db_rows_delete ("SAI_ACL_ENTRY", "entry_id", rule_id_list);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    return (sai_acl_table_db_entries_update_totals (count, table_id_list.data(),
+                                                    1 /* add */, true));
+}
+
+sai_status_t sai_acl_rule_delete_db_entries (uint_t count,
+                                             sai_acl_rule_t **rule_list)
+{
+    uint_t                       idx = 0;
+    std::vector<uint_t>          rule_id_list;
+    std::vector<sai_object_id_t> table_id_list;
+
+    STD_ASSERT (rule_list != NULL);
+
+    rule_id_list.reserve (count);
+    table_id_list.reserve (count);
+
+    for (idx = 0; idx < count; idx++) {
+        rule_id_list.push_back (
+            (uint_t) sai_uoid_npu_obj_id_get (rule_list [idx]->rule_key.acl_id));
+        table_id_list.push_back (rule_list [idx]->table_id);
+    }
+
+    /* Filter and action list rows go along, by ON DELETE CASCADE */
+    if (sai_acl_db_rows_delete ("SAI_ACL_ENTRY", "entry_id", rule_id_list)
+        != SAI_STATUS_SUCCESS) {
+        SAI_VM_DB_LOG_ERR ("Error deleting a batch of %u ACL Rules.", count);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    return (sai_acl_table_db_entries_update_totals (count, table_id_list.data(),
+                                                    -1 /* remove */, true));
+}
+
+sai_status_t sai_acl_counter_create_db_entries (uint_t count,
+                                                sai_acl_counter_t **cntr_list)
+{
+    uint_t                       idx = 0;
+    std::vector<std::string>     cntr_rows;
+    std::vector<uint_t>          cntr_id_list;
+    std::vector<sai_object_id_t> table_id_list;
+
+    STD_ASSERT (cntr_list != NULL);
+
+    cntr_rows.reserve (count);
+    cntr_id_list.reserve (count);
+    table_id_list.reserve (count);
+
+    for (idx = 0; idx < count; idx++) {
+        cntr_rows.push_back (sai_acl_counter_db_row_str_get (cntr_list [idx]));
+        cntr_id_list.push_back ((uint_t) sai_uoid_npu_obj_id_get (
+            cntr_list [idx]->counter_key.counter_id));
+        table_id_list.push_back (cntr_list [idx]->table_id);
+    }
+
+    if (sai_acl_db_rows_insert ("SAI_ACL_COUNTER", cntr_rows)
+        != SAI_STATUS_SUCCESS) {
+        SAI_VM_DB_LOG_ERR ("Error inserting a batch of %u ACL Counters.", count);
+
+        sai_acl_db_rows_delete ("SAI_ACL_COUNTER", "counter_id", cntr_id_list);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    return (sai_acl_table_db_entries_update_totals (count, table_id_list.data(),
+                                                    1 /* add */, false));
+}
+
+sai_status_t sai_acl_counter_delete_db_entries (uint_t count,
+                                                sai_acl_counter_t **cntr_list)
+{
+    uint_t                       idx = 0;
+    std::vector<uint_t>          cntr_id_list;
+    std::vector<sai_object_id_t> table_id_list;
+
+    STD_ASSERT (cntr_list != NULL);
+
+    cntr_id_list.reserve (count);
+    table_id_list.reserve (count);
+
+    for (idx = 0; idx < count; idx++) {
+        cntr_id_list.push_back ((uint_t) sai_uoid_npu_obj_id_get (
+            cntr_list [idx]->counter_key.counter_id));
+        table_id_list.push_back (cntr_list [idx]->table_id);
+    }
+
+    if (sai_acl_db_rows_delete ("SAI_ACL_COUNTER", "counter_id", cntr_id_list)
+        != SAI_STATUS_SUCCESS) {
+        SAI_VM_DB_LOG_ERR ("Error deleting a batch of %u ACL Counters.", count);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    return (sai_acl_table_db_entries_update_totals (count, table_id_list.data(),
+                                                    -1 /* remove */, false));
+}
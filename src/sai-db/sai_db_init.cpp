@@ -42,6 +42,12 @@
 #define SAI_DB_CREATE_SCRIPT   "create_script"
 #define SAI_DB_DELETE_SCRIPT   "delete_script"
 
+/*
+ * Overrides the DB path of the config file, e.g. to keep the DB mirror on
+ * a tmpfs for benchmark runs.
+ */
+#define SAI_DB_PATH_ENV        "SAI_VM_DB_PATH"
+
 db_sql_handle_t db = NULL;
 
 sai_status_t sai_vm_db_init (void)
@@ -62,9 +68,12 @@ sai_status_t sai_vm_db_init (void)
         return SAI_STATUS_FAILURE;
     }
 
-    const char *db_path =
-        std_config_file_get (cfg_file_handle, SAI_DB_PATH_INFO_GRP,
-                             SAI_DB_PATH);
+    const char *db_path = getenv (SAI_DB_PATH_ENV);
+
+    if ((db_path == NULL) || (*db_path == '\0')) {
+        db_path = std_config_file_get (cfg_file_handle, SAI_DB_PATH_INFO_GRP,
+                                       SAI_DB_PATH);
+    }
 
     const char *sql_script_path =
         std_config_file_get (cfg_file_handle, SAI_DB_PATH_INFO_GRP,
@@ -44,11 +44,16 @@ extern "C" {
 #include "sai_vlan_api.h"
 }
 
+#include <string.h>
+
 #include <map>
 #include <string>
 
 using namespace std;
 
+/* FDB rows written by one SQL statement of the batch APIs */
+#define SAI_FDB_DB_BATCH_SIZE 256
+
 static string sai_fdb_pkt_action_str_get (sai_packet_action_t pkt_action)
 {
     std::map<sai_packet_action_t, std::string> pkt_action_str_map =
@@ -82,12 +87,10 @@ static string sai_vlan_port_tagging_mode_str_get (sai_vlan_tagging_mode_t mode)
     }
 }
 
-sai_status_t sai_fdb_create_db_entry (const sai_fdb_entry_t *fdb_entry,
-                                      sai_fdb_entry_node_t *fdb_entry_node_data)
+/* Values of the FDB table row of an entry */
+static string sai_fdb_db_row_str_get (const sai_fdb_entry_t *fdb_entry,
+                                      const sai_fdb_entry_node_t *fdb_entry_node_data)
 {
-    STD_ASSERT (fdb_entry != NULL);
-    STD_ASSERT (fdb_entry_node_data != NULL);
-
     char   mac_addr [SAI_VM_MAX_BUFSZ];
 
     std_mac_to_string ((const hal_mac_addr_t *)fdb_entry->mac_address,
@@ -100,15 +103,37 @@ sai_status_t sai_fdb_create_db_entry (const sai_fdb_entry_t *fdb_entry,
     string pkt_action_str = sai_fdb_pkt_action_str_get (fdb_entry_node_data->action);
     string metadata_str = std::to_string (fdb_entry_node_data->metadata);
 
-    string insert_str = string ("( ") + mac_addr_str + ", " + bv_id_str +
-        ", " + is_static_str + ", " + bridge_port_id_str + ", " + pkt_action_str +
-        ", " + metadata_str + string(")");
+    return (string ("( ") + mac_addr_str + ", " + bv_id_str +
+            ", " + is_static_str + ", " + bridge_port_id_str + ", " + pkt_action_str +
+            ", " + metadata_str + string(")"));
+}
+
+/* Condition matching the FDB table row of an entry */
+static string sai_fdb_db_key_cond_str_get (const sai_fdb_entry_t *fdb_entry)
+{
+    char mac_addr [SAI_VM_MAX_BUFSZ];
+
+    std_mac_to_string ((const hal_mac_addr_t *)fdb_entry->mac_address,
+                       mac_addr, sizeof (mac_addr));
+
+    string mac_addr_str = "\"" + string (mac_addr) + "\"";
+    string bv_id_str = std::to_string (fdb_entry->bv_id);
+
+    return (string ("( mac_address=") + mac_addr_str +
+            " AND bv_id =" + bv_id_str + string(")"));
+}
+
+sai_status_t sai_fdb_create_db_entry (const sai_fdb_entry_t *fdb_entry,
+                                      sai_fdb_entry_node_t *fdb_entry_node_data)
+{
+    STD_ASSERT (fdb_entry != NULL);
+    STD_ASSERT (fdb_entry_node_data != NULL);
+
+    string insert_str = sai_fdb_db_row_str_get (fdb_entry, fdb_entry_node_data);
 
     if (db_sql_insert (sai_vm_get_db_handle(), "SAI_FDB", insert_str.c_str())
         != STD_ERR_OK) {
-        SAI_VM_DB_LOG_ERR ("Error inserting FDB entry with MAC address: %s and"
-                           " bridge/vlan: %s.", mac_addr_str.c_str(),
-                           bv_id_str.c_str());
+        SAI_VM_DB_LOG_ERR ("Error inserting FDB entry %s.", insert_str.c_str());
 
         return SAI_STATUS_FAILURE;
     }
@@ -116,6 +141,51 @@ sai_status_t sai_fdb_create_db_entry (const sai_fdb_entry_t *fdb_entry,
     return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t sai_fdb_create_db_entries (uint_t count,
+                                        const sai_fdb_entry_t *fdb_entry_list,
+                                        const sai_fdb_entry_node_t *fdb_entry_node_list)
+{
+    uint_t idx;
+    uint_t batch_idx;
+
+    STD_ASSERT (fdb_entry_list != NULL);
+    STD_ASSERT (fdb_entry_node_list != NULL);
+
+    for (idx = 0; idx < count; idx += SAI_FDB_DB_BATCH_SIZE) {
+        string insert_str;
+
+        /* Multi row VALUES, bounded by the SQLite compound select limit */
+        for (batch_idx = idx; (batch_idx < count) &&
+             (batch_idx < (idx + SAI_FDB_DB_BATCH_SIZE)); batch_idx++) {
+            if (batch_idx != idx) {
+                insert_str += ", ";
+            }
+
+            insert_str += sai_fdb_db_row_str_get (&fdb_entry_list [batch_idx],
+                                                  &fdb_entry_node_list [batch_idx]);
+        }
+
+        if (db_sql_insert (sai_vm_get_db_handle(), "SAI_FDB", insert_str.c_str())
+            != STD_ERR_OK) {
+            SAI_VM_DB_LOG_ERR ("Error inserting FDB entries %u to %u of %u.",
+                               idx, batch_idx - 1, count);
+
+            /*
+             * Leave none of the batch behind, for the entries to be retried.
+             * A failed INSERT adds none of its rows, only the earlier
+             * chunks are removed.
+             */
+            if (idx != 0) {
+                sai_fdb_delete_db_entries (idx, fdb_entry_list);
+            }
+
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
 sai_status_t sai_fdb_set_db_entry (const sai_fdb_entry_t *fdb_entry,
                                    sai_object_id_t bridge_port_id,
                                    sai_fdb_entry_type_t entry_type,
@@ -178,24 +248,71 @@ sai_status_t sai_fdb_set_db_entry (const sai_fdb_entry_t *fdb_entry,
     return SAI_STATUS_SUCCESS;
 }
 
-sai_status_t sai_fdb_delete_db_entry (const sai_fdb_entry_t* fdb_entry)
+sai_status_t sai_fdb_set_db_entries (uint_t count,
+                                     const sai_fdb_entry_node_t *const *fdb_entry_node_list)
 {
-    char mac_addr [SAI_VM_MAX_BUFSZ];
+    uint_t idx;
+    uint_t batch_idx;
+
+    STD_ASSERT (fdb_entry_node_list != NULL);
+
+    for (idx = 0; idx < count; idx += SAI_FDB_DB_BATCH_SIZE) {
+        string cond_str = "(";
+        string is_static_str = "CASE";
+        string bridge_port_id_str = "CASE";
+        string pkt_action_str = "CASE";
+
+        /* One UPDATE per group, the columns of each row picked by its key */
+        for (batch_idx = idx; (batch_idx < count) &&
+             (batch_idx < (idx + SAI_FDB_DB_BATCH_SIZE)); batch_idx++) {
+            const sai_fdb_entry_node_t *fdb_entry_node = fdb_entry_node_list [batch_idx];
+            sai_fdb_entry_t             fdb_entry;
+
+            memset (&fdb_entry, 0, sizeof (fdb_entry));
+            memcpy (&fdb_entry.mac_address, &fdb_entry_node->fdb_key.mac_address,
+                    sizeof (sai_mac_t));
+            fdb_entry.bv_id = fdb_entry_node->fdb_key.bv_id;
+
+            string key_str = sai_fdb_db_key_cond_str_get (&fdb_entry);
+
+            if (batch_idx != idx) {
+                cond_str += " OR ";
+            }
+
+            cond_str += key_str;
+            is_static_str += " WHEN " + key_str + " THEN " +
+                ((fdb_entry_node->entry_type == SAI_FDB_ENTRY_TYPE_STATIC) ? "1" : "0");
+            bridge_port_id_str += " WHEN " + key_str + " THEN " +
+                std::to_string (fdb_entry_node->bridge_port_id);
+            pkt_action_str += " WHEN " + key_str + " THEN " +
+                sai_fdb_pkt_action_str_get (fdb_entry_node->action);
+        }
 
-    std_mac_to_string ((const hal_mac_addr_t *)fdb_entry->mac_address,
-                       mac_addr, sizeof (mac_addr));
+        cond_str += ")";
 
-    string mac_addr_str = "\"" + string (mac_addr) + "\"";
-    string bv_id_str = std::to_string (fdb_entry->bv_id);
+        string value_str = "(" + is_static_str + " END, " + bridge_port_id_str +
+            " END, " + pkt_action_str + " END)";
 
-    string delete_str = string ("( mac_address=") + mac_addr_str +
-        " AND bv_id =" + bv_id_str + string(")");
+        if (db_sql_set_attribute (sai_vm_get_db_handle(), "SAI_FDB",
+                                  "(IS_STATIC, BRIDGE_PORT_ID, PACKET_ACTION)",
+                                  value_str.c_str(), cond_str.c_str()) != STD_ERR_OK) {
+            SAI_VM_DB_LOG_ERR ("Error setting FDB entries %u to %u of %u.",
+                               idx, batch_idx - 1, count);
+
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fdb_delete_db_entry (const sai_fdb_entry_t* fdb_entry)
+{
+    string delete_str = sai_fdb_db_key_cond_str_get (fdb_entry);
 
     if (db_sql_delete (sai_vm_get_db_handle(), "SAI_FDB", delete_str.c_str())
         != STD_ERR_OK) {
-        SAI_VM_DB_LOG_ERR ("Error deleting FDB entry with MAC address: %s and"
-                           " vlan/bridge: %s.", mac_addr_str.c_str(),
-                           bv_id_str.c_str());
+        SAI_VM_DB_LOG_ERR ("Error deleting FDB entry %s.", delete_str.c_str());
 
         return SAI_STATUS_FAILURE;
     }
@@ -203,6 +320,40 @@ sai_status_t sai_fdb_delete_db_entry (const sai_fdb_entry_t* fdb_entry)
     return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t sai_fdb_delete_db_entries (uint_t count,
+                                        const sai_fdb_entry_t *fdb_entry_list)
+{
+    uint_t idx;
+    uint_t batch_idx;
+
+    STD_ASSERT (fdb_entry_list != NULL);
+
+    for (idx = 0; idx < count; idx += SAI_FDB_DB_BATCH_SIZE) {
+        string delete_str = "(";
+
+        for (batch_idx = idx; (batch_idx < count) &&
+             (batch_idx < (idx + SAI_FDB_DB_BATCH_SIZE)); batch_idx++) {
+            if (batch_idx != idx) {
+                delete_str += " OR ";
+            }
+
+            delete_str += sai_fdb_db_key_cond_str_get (&fdb_entry_list [batch_idx]);
+        }
+
+        delete_str += ")";
+
+        if (db_sql_delete (sai_vm_get_db_handle(), "SAI_FDB", delete_str.c_str())
+            != STD_ERR_OK) {
+            SAI_VM_DB_LOG_ERR ("Error deleting FDB entries %u to %u of %u.",
+                               idx, batch_idx - 1, count);
+
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
 sai_status_t sai_fdb_delete_all_db_entries (sai_object_id_t bridge_port_id,
                                             sai_object_id_t bv_id, bool flush_all,
                                             sai_fdb_flush_entry_type_t flush_type)
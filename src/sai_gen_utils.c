@@ -21,9 +21,12 @@
 *************************************************************************/
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "saistatus.h"
 #include "sai.h"
 #include "sai_gen_utils.h"
+#include "sai_log_async.h"
 #include "sai_common_utils.h"
 #include "std_type_defs.h"
 #include "std_assert.h"
@@ -32,6 +35,12 @@
 
 #define SAI_SWITCH_ID_STR_LEN 50
 
+/* Indices covered by an index pool when first used, and by each word */
+#define DN_SAI_INDEX_POOL_MIN_SIZE   (4096)
+#define DN_SAI_INDEX_POOL_WORD_BITS  (64)
+#define DN_SAI_INDEX_POOL_WORD_FULL  (~((uint64_t)0))
+#define DN_SAI_INDEX_POOL_MAX_RANGE  (((uint64_t)1) << 48)
+
 sai_log_level_t g_sai_api_log_level [SAI_NUM_API_ID];
 sai_log_level_t g_sai_api_custom_log_level [SAI_NUM_API_CUSTOM_ID];
 
@@ -224,12 +233,6 @@ const char* sai_switch_id_str_get (void)
     return ((const char *) g_sai_switch_id_str);
 }
 
-static inline sai_log_level_t sai_log_level_get (sai_api_t api_id)
-{
-    return ((api_id < SAI_NUM_API_ID) ? g_sai_api_log_level [api_id] :
-    SAI_API_CUSTOM_CHECK(api_id)?g_sai_api_custom_log_level[SAI_API_CUSTOM_INDEX(api_id)]:SAI_LOG_LEVEL_WARN);
-}
-
 void sai_log_level_set (sai_api_t api_id, sai_log_level_t level)
 {
     if (api_id < SAI_NUM_API_ID) {
@@ -242,12 +245,13 @@ void sai_log_level_set (sai_api_t api_id, sai_log_level_t level)
 
 bool sai_is_log_enabled (sai_api_t api_id, sai_log_level_t level)
 {
-    return (level >= sai_log_level_get (api_id));
+    return sai_is_log_enabled_fast (api_id, level);
 }
 
 void sai_log_init (void)
 {
-    uint_t api_id;
+    uint_t      api_id;
+    const char *async_env = NULL;
 
     sai_switch_id_strify ();
 
@@ -261,6 +265,12 @@ void sai_log_init (void)
     {
         sai_log_level_set (api_id, SAI_LOG_LEVEL_WARN);
     }
+
+    async_env = getenv (SAI_LOG_ASYNC_ENV);
+
+    if ((async_env != NULL) && (strtol (async_env, NULL, 0) != 0)) {
+        sai_log_async_enable (true);
+    }
 }
 
 sai_status_t sai_find_attr_in_attrlist(sai_attr_id_t attr_id,
@@ -330,3 +340,257 @@ sai_status_t dn_sai_get_next_free_id(dn_sai_id_gen_info_t *info)
 
     return SAI_STATUS_SUCCESS;
 }
+
+static inline uint64_t dn_sai_index_pool_bit(uint64_t n)
+{
+    return ((uint64_t)1) << (n % DN_SAI_INDEX_POOL_WORD_BITS);
+}
+
+/* Rebuild the levels above level 0 of an index pool covering size indices */
+static sai_status_t dn_sai_index_pool_levels_build(dn_sai_index_pool_t *pool,
+                                                   uint64_t size)
+{
+    uint64_t *level[DN_SAI_INDEX_POOL_MAX_LEVELS] = {NULL};
+    uint64_t  words = size / DN_SAI_INDEX_POOL_WORD_BITS;
+    uint64_t  up_words = 0;
+    uint64_t  n = 0;
+    uint_t    levels = 1;
+    uint_t    l = 0;
+
+    level[0] = pool->level[0];
+
+    while(words > 1) {
+        up_words = (words + DN_SAI_INDEX_POOL_WORD_BITS - 1) /
+                   DN_SAI_INDEX_POOL_WORD_BITS;
+
+        if(levels < DN_SAI_INDEX_POOL_MAX_LEVELS) {
+            level[levels] = (uint64_t *)calloc(up_words, sizeof(uint64_t));
+        }
+        if((levels == DN_SAI_INDEX_POOL_MAX_LEVELS) || (level[levels] == NULL)) {
+            for(l = 1; l < levels; l++) {
+                free(level[l]);
+            }
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        /* Words past the end of the level below count as full */
+        for(n = 0; n < (up_words * DN_SAI_INDEX_POOL_WORD_BITS); n++) {
+            if((n >= words) ||
+               (level[levels - 1][n] == DN_SAI_INDEX_POOL_WORD_FULL)) {
+                level[levels][n / DN_SAI_INDEX_POOL_WORD_BITS] |=
+                    dn_sai_index_pool_bit(n);
+            }
+        }
+
+        words = up_words;
+        levels++;
+    }
+
+    for(l = 1; l < pool->levels; l++) {
+        free(pool->level[l]);
+    }
+    for(l = 1; l < DN_SAI_INDEX_POOL_MAX_LEVELS; l++) {
+        pool->level[l] = level[l];
+    }
+    pool->levels = levels;
+    pool->size = size;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Grow the bitmaps of an index pool to cover at least min_size indices */
+static sai_status_t dn_sai_index_pool_grow(dn_sai_index_pool_t *pool,
+                                           uint64_t min_size)
+{
+    uint64_t  range = pool->max_id - pool->min_id + 1;
+    uint64_t  max_size = (range + DN_SAI_INDEX_POOL_WORD_BITS - 1) &
+                         ~((uint64_t)DN_SAI_INDEX_POOL_WORD_BITS - 1);
+    uint64_t  size = (pool->size != 0) ? pool->size : DN_SAI_INDEX_POOL_MIN_SIZE;
+    uint64_t *bits = NULL;
+    uint64_t  n = 0;
+
+    if(pool->size >= max_size) {
+        return SAI_STATUS_TABLE_FULL;
+    }
+
+    while(size < min_size) {
+        size *= 2;
+    }
+    if(size > max_size) {
+        size = max_size;
+    }
+
+    bits = (uint64_t *)realloc(pool->level[0],
+                               (size / DN_SAI_INDEX_POOL_WORD_BITS) * sizeof(uint64_t));
+    if(bits == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+    memset(bits + (pool->size / DN_SAI_INDEX_POOL_WORD_BITS), 0,
+           ((size - pool->size) / DN_SAI_INDEX_POOL_WORD_BITS) * sizeof(uint64_t));
+
+    /* Indices past max_id stay in use for good */
+    for(n = range; n < size; n++) {
+        bits[n / DN_SAI_INDEX_POOL_WORD_BITS] |= dn_sai_index_pool_bit(n);
+    }
+    pool->level[0] = bits;
+
+    return dn_sai_index_pool_levels_build(pool, size);
+}
+
+static void dn_sai_index_pool_mark(dn_sai_index_pool_t *pool, uint64_t n)
+{
+    uint_t l = 0;
+
+    for(l = 0; l < pool->levels; l++) {
+        pool->level[l][n / DN_SAI_INDEX_POOL_WORD_BITS] |= dn_sai_index_pool_bit(n);
+
+        if(pool->level[l][n / DN_SAI_INDEX_POOL_WORD_BITS] !=
+           DN_SAI_INDEX_POOL_WORD_FULL) {
+            break;
+        }
+        n /= DN_SAI_INDEX_POOL_WORD_BITS;
+    }
+    pool->used++;
+}
+
+static void dn_sai_index_pool_unmark(dn_sai_index_pool_t *pool, uint64_t n)
+{
+    uint_t l = 0;
+    bool   was_full = false;
+
+    for(l = 0; l < pool->levels; l++) {
+        was_full = (pool->level[l][n / DN_SAI_INDEX_POOL_WORD_BITS] ==
+                    DN_SAI_INDEX_POOL_WORD_FULL);
+
+        pool->level[l][n / DN_SAI_INDEX_POOL_WORD_BITS] &= ~dn_sai_index_pool_bit(n);
+
+        if(!was_full) {
+            break;
+        }
+        n /= DN_SAI_INDEX_POOL_WORD_BITS;
+    }
+    pool->used--;
+}
+
+sai_status_t dn_sai_index_pool_init(dn_sai_index_pool_t *pool,
+                                    uint64_t min_id, uint64_t max_id)
+{
+    STD_ASSERT(pool != NULL);
+
+    if((min_id > max_id) ||
+       ((max_id - min_id) >= DN_SAI_INDEX_POOL_MAX_RANGE)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset(pool, 0, sizeof(dn_sai_index_pool_t));
+    pool->min_id = min_id;
+    pool->max_id = max_id;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void dn_sai_index_pool_deinit(dn_sai_index_pool_t *pool)
+{
+    uint_t l = 0;
+
+    STD_ASSERT(pool != NULL);
+
+    for(l = 0; l < DN_SAI_INDEX_POOL_MAX_LEVELS; l++) {
+        free(pool->level[l]);
+        pool->level[l] = NULL;
+    }
+    pool->size = 0;
+    pool->used = 0;
+    pool->levels = 0;
+}
+
+sai_status_t dn_sai_index_pool_alloc(dn_sai_index_pool_t *pool, uint64_t *index)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+    uint64_t     n = 0;
+    uint_t       l = 0;
+
+    STD_ASSERT(pool != NULL);
+    STD_ASSERT(index != NULL);
+
+    if((pool->levels == 0) ||
+       (pool->level[pool->levels - 1][0] == DN_SAI_INDEX_POOL_WORD_FULL)) {
+        rc = dn_sai_index_pool_grow(pool, pool->size * 2);
+        if(rc != SAI_STATUS_SUCCESS) {
+            return rc;
+        }
+    }
+
+    /* Follow the first word that is not full, from the top level down */
+    for(l = pool->levels; l > 0; l--) {
+        n = (n * DN_SAI_INDEX_POOL_WORD_BITS) +
+            (uint64_t)__builtin_ctzll(~pool->level[l - 1][n]);
+    }
+
+    dn_sai_index_pool_mark(pool, n);
+    *index = pool->min_id + n;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t dn_sai_index_pool_reserve(dn_sai_index_pool_t *pool, uint64_t index)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+    uint64_t     n = 0;
+
+    STD_ASSERT(pool != NULL);
+
+    if((index < pool->min_id) || (index > pool->max_id)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    n = index - pool->min_id;
+
+    if(n >= pool->size) {
+        rc = dn_sai_index_pool_grow(pool, n + 1);
+        if(rc != SAI_STATUS_SUCCESS) {
+            return rc;
+        }
+    }
+
+    if(pool->level[0][n / DN_SAI_INDEX_POOL_WORD_BITS] & dn_sai_index_pool_bit(n)) {
+        return SAI_STATUS_ITEM_ALREADY_EXISTS;
+    }
+
+    dn_sai_index_pool_mark(pool, n);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t dn_sai_index_pool_free(dn_sai_index_pool_t *pool, uint64_t index)
+{
+    STD_ASSERT(pool != NULL);
+
+    if(!dn_sai_index_pool_is_used(pool, index)) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    dn_sai_index_pool_unmark(pool, index - pool->min_id);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+bool dn_sai_index_pool_is_used(const dn_sai_index_pool_t *pool, uint64_t index)
+{
+    uint64_t n = 0;
+
+    STD_ASSERT(pool != NULL);
+
+    if((index < pool->min_id) || (index > pool->max_id)) {
+        return false;
+    }
+
+    n = index - pool->min_id;
+
+    if(n >= pool->size) {
+        return false;
+    }
+
+    return ((pool->level[0][n / DN_SAI_INDEX_POOL_WORD_BITS] &
+             dn_sai_index_pool_bit(n)) != 0);
+}
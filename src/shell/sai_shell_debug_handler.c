@@ -36,8 +36,10 @@
 #include "sai_samplepacket_api.h"
 #include "sai_qos_debug.h"
 #include "sai_l3_api_utils.h"
+#include "sai_l3_util.h"
 #include "sai_bridge_main.h"
 #include "sai_l2mc_api.h"
+#include "sai_api_stats.h"
 
 static void sai_shell_debug_vlan_help(void)
 {
@@ -49,8 +51,8 @@ static void sai_shell_debug_vlan_help(void)
 }
 static void sai_shell_debug_fdb_help(void)
 {
-    SAI_DEBUG("::debug fdb global all");
-    SAI_DEBUG("\t- Dumps all the learnt FDB entries");
+    SAI_DEBUG("::debug fdb global all [start <n>] [count <n>]");
+    SAI_DEBUG("\t- Dumps all the learnt FDB entries, count entries from the start-th one if given");
     SAI_DEBUG("::debug fdb global count");
     SAI_DEBUG("\t- Dumps the count of FDB entries");
     SAI_DEBUG("::debug fdb param <sai-port> <vlan-id> ");
@@ -145,8 +147,9 @@ static void sai_shell_debug_nexthop_group_help(void)
 
 static void sai_shell_debug_route_help(void)
 {
-    SAI_DEBUG("::debug l3 router vr <vr_id> ");
-    SAI_DEBUG("\t- Dumps all the route entry data in virtual router vr_id.");
+    SAI_DEBUG("::debug l3 route vr <vr_id> [nh <nh_id>] [start <n>] [count <n>]");
+    SAI_DEBUG("\t- Dumps the route entry data in virtual router vr_id, only the routes");
+    SAI_DEBUG("\t  to nh_id if given, count routes from the start-th one if given.");
 }
 
 static void sai_shell_debug_lag_help(void)
@@ -282,6 +285,16 @@ static void sai_shell_debug_l2mc_help(void)
     SAI_DEBUG("\t- Dumps the specific l2mc group member info");
 }
 
+static void sai_shell_debug_apistats_help(void)
+{
+    SAI_DEBUG("::debug apistats dump");
+    SAI_DEBUG("\t- Dumps the call counters and latencies of the SAI APIs");
+    SAI_DEBUG("::debug apistats reset");
+    SAI_DEBUG("\t- Clears the SAI API stats");
+    SAI_DEBUG("::debug apistats enable/disable");
+    SAI_DEBUG("\t- Starts or stops collecting the SAI API stats");
+}
+
 static void sai_shell_debug_vlan(std_parsed_string_t handle)
 {
     size_t ix=1;
@@ -327,8 +340,11 @@ static void sai_shell_debug_fdb(std_parsed_string_t handle)
 {
     size_t ix=1;
     const char *token = NULL;
+    const char *value = NULL;
     sai_vlan_id_t vlan_id = VLAN_UNDEF;
     sai_object_id_t bridge_port_id = SAI_NULL_OBJECT_ID;
+    uint_t start = 0;
+    uint_t count = 0;
 
     if((std_parse_string_num_tokens(handle)) == 0) {
         return;
@@ -342,7 +358,21 @@ static void sai_shell_debug_fdb(std_parsed_string_t handle)
 
             if(NULL != token) {
                 if(strcmp(token,"all") == 0) {
-                    sai_dump_all_fdb_entry_nodes();
+                    while((token = std_parse_string_next(handle,&ix)) != NULL) {
+                        if((value = std_parse_string_next(handle,&ix)) == NULL) {
+                            SAI_DEBUG("Missing parameter");
+                            return;
+                        }
+                        if(strcmp(token,"start") == 0) {
+                            sscanf(value,"%u",&start);
+                        } else if(strcmp(token,"count") == 0) {
+                            sscanf(value,"%u",&count);
+                        } else {
+                            SAI_DEBUG ("Invalid parameters");
+                            return;
+                        }
+                    }
+                    sai_dump_fdb_entry_nodes_page(start, count);
                 } else if (strcmp(token,"count") == 0) {
                     sai_dump_all_fdb_entry_count();
                 } else {
@@ -542,7 +572,11 @@ static void sai_shell_debug_route(std_parsed_string_t handle)
 {
     size_t ix=2;
     const char *token = NULL;
+    const char *value = NULL;
     sai_object_id_t  vr_id = SAI_NULL_OBJECT_ID;
+    sai_object_id_t  nh_id = SAI_NULL_OBJECT_ID;
+    uint_t           start = 0;
+    uint_t           count = 0;
 
     if((std_parse_string_num_tokens(handle)) == 0) {
         return;
@@ -552,11 +586,29 @@ static void sai_shell_debug_route(std_parsed_string_t handle)
         if(strcmp(token,"help") == 0) {
             sai_shell_debug_route_help();
         } else if(strcmp(token,"vr") == 0){
-            sscanf(std_parse_string_next(handle,&ix),"%lx",&vr_id);
+            if((token = std_parse_string_next(handle,&ix)) != NULL) {
+                sscanf(token,"%lx",&vr_id);
+            }
+            while((token = std_parse_string_next(handle,&ix)) != NULL) {
+                if((value = std_parse_string_next(handle,&ix)) == NULL) {
+                    SAI_DEBUG ("Missing parameter");
+                    return;
+                }
+                if(strcmp(token,"nh") == 0) {
+                    sscanf(value,"%lx",&nh_id);
+                } else if(strcmp(token,"start") == 0) {
+                    sscanf(value,"%u",&start);
+                } else if(strcmp(token,"count") == 0) {
+                    sscanf(value,"%u",&count);
+                } else {
+                    SAI_DEBUG ("Invalid parameter");
+                    return;
+                }
+            }
             if(vr_id == SAI_NULL_OBJECT_ID) {
                 SAI_DEBUG ("Invalid parameters");
             } else {
-                sai_fib_dump_all_route_in_vr (vr_id);
+                sai_fib_dump_route_page_in_vr (vr_id, nh_id, start, count);
             }
         } else {
             SAI_DEBUG ("Invalid parameter");
@@ -576,6 +628,14 @@ static void sai_shell_debug_l3(std_parsed_string_t handle)
     }
 
     if((token = std_parse_string_next(handle,&ix))!= NULL) {
+        if(strcmp(token,"route") == 0) {
+            /* The route dump takes the FIB lock per chunk of routes it copies */
+            sai_shell_debug_route(handle);
+            return;
+        }
+
+        /* The dumps walk the FIB alongside the API readers, not the writers */
+        sai_fib_read_lock();
         if(strcmp(token,"help") == 0) {
             sai_shell_debug_l3_help();
         } else if(strcmp(token,"vr") == 0) {
@@ -588,11 +648,10 @@ static void sai_shell_debug_l3(std_parsed_string_t handle)
             sai_shell_debug_nexthop_group(handle);
         } else if(strcmp(token,"nexthop") == 0) {
             sai_shell_debug_nexthop(handle);
-        } else if(strcmp(token,"route") == 0) {
-            sai_shell_debug_route(handle);
         } else {
             SAI_DEBUG ("Unknown parameter");
         }
+        sai_fib_read_unlock();
     } else {
         sai_shell_debug_l3_help();
     }
@@ -1341,10 +1400,34 @@ static void sai_shell_debug_l2mc(std_parsed_string_t handle)
         sai_shell_debug_l2mc_help();
     }
 }
+static void sai_shell_debug_apistats(std_parsed_string_t handle)
+{
+    size_t ix=1;
+    const char *token = NULL;
+
+    if((token = std_parse_string_next(handle,&ix))!= NULL) {
+        if(strcmp(token,"dump") == 0) {
+            sai_api_stats_dump();
+        } else if(strcmp(token,"reset") == 0) {
+            sai_api_stats_reset();
+        } else if(strcmp(token,"enable") == 0) {
+            sai_api_stats_enable_set(true);
+        } else if(strcmp(token,"disable") == 0) {
+            sai_api_stats_enable_set(false);
+        } else {
+            sai_shell_debug_apistats_help();
+        }
+    } else {
+        sai_shell_debug_apistats_help();
+    }
+}
+
 static void sai_shell_debug_help(void)
 {
     SAI_DEBUG("::debug acl");
     SAI_DEBUG("\t- ACL module debug commands");
+    SAI_DEBUG("::debug apistats");
+    SAI_DEBUG("\t- SAI API call counters and latencies");
     SAI_DEBUG("::debug bridge");
     SAI_DEBUG("\t- Bridge module debug commands");
     SAI_DEBUG("::debug l2mc");
@@ -1402,6 +1485,8 @@ static void sai_shell_debug(std_parsed_string_t handle)
             sai_shell_debug_bridge(handle);
         } else if(strcmp(token,"l2mc") == 0) {
             sai_shell_debug_l2mc(handle);
+        } else if(strcmp(token,"apistats") == 0) {
+            sai_shell_debug_apistats(handle);
         } else {
             sai_shell_debug_help();
         }
@@ -33,6 +33,8 @@
 #include "sai_l3_util.h"
 #include "sai_acl_type_defs.h"
 #include "sai_vm_vport_event.h"
+#include "sai_vm_qos.h"
+#include "sai_vm_lag.h"
 #include "saitypes.h"
 #include "saistatus.h"
 #include "std_bit_masks.h"
@@ -289,6 +291,9 @@ static sai_status_t sai_npu_switch_counter_refresh_interval_set(uint_t cntr_inte
     SAI_SWITCH_LOG_TRACE ("Switch counter refresh interval set to %d.",
                           cntr_interval);
 
+    /* Interval is in seconds, the tc stats poller works in milliseconds */
+    sai_vm_qos_stats_poll_interval_set (cntr_interval * 1000);
+
     /* Update the Switch DB entry with this attribute info. */
     attr.id = SAI_SWITCH_ATTR_COUNTER_REFRESH_INTERVAL;
     attr.value.u32 = cntr_interval;
@@ -330,7 +335,8 @@ static sai_status_t sai_npu_switch_hash_field_set (sai_attr_id_t attr_id,
     STD_ASSERT(native_field_list != NULL);
     STD_ASSERT(udf_group_list != NULL);
 
-    return SAI_STATUS_SUCCESS;
+    /* UDF groups have no equivalent in the bond transmit hash policy */
+    return sai_vm_lag_hash_fields_set (attr_id, native_field_list);
 }
 
 static sai_status_t sai_npu_ecmp_hash_algorithm_get (sai_hash_algorithm_t *ecmp_algo)
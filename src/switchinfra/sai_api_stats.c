@@ -0,0 +1,748 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file sai_api_stats.c
+*
+* @brief This file contains the per API call counters and latency
+*        histograms collected at the SAI method table boundary.
+*
+*        Every thread calling the SAI APIs owns a block of records, one per
+*        wrapped method or exported bulk API, that only it writes. The blocks are linked once in
+*        a global list that the dump walks, summing the records. A reset
+*        bumps a generation number, each thread clears its own block on its
+*        next call and the dump skips the blocks of older generations.
+*
+*        Latencies are kept in log-linear histograms, 8 sub buckets per
+*        power of two of nanoseconds, for a relative error under 12.5%.
+*
+*************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "sai.h"
+#include "saitypes.h"
+#include "saistatus.h"
+
+#include "std_mutex_lock.h"
+
+#include "sai_api_stats.h"
+#include "sai_debug_utils.h"
+#include "sai_switch_utils.h"
+
+/* Objects with the create_X/remove_X/set_X_attribute/get_X_attribute methods */
+#define SAI_API_STATS_OID_OBJECTS(_obj) \
+    _obj (SAI_API_PORT,             sai_port_api_t,             port)                  \
+    _obj (SAI_API_VLAN,             sai_vlan_api_t,             vlan)                  \
+    _obj (SAI_API_VLAN,             sai_vlan_api_t,             vlan_member)           \
+    _obj (SAI_API_LAG,              sai_lag_api_t,              lag)                   \
+    _obj (SAI_API_LAG,              sai_lag_api_t,              lag_member)            \
+    _obj (SAI_API_BRIDGE,           sai_bridge_api_t,           bridge)                \
+    _obj (SAI_API_BRIDGE,           sai_bridge_api_t,           bridge_port)           \
+    _obj (SAI_API_VIRTUAL_ROUTER,   sai_virtual_router_api_t,   virtual_router)        \
+    _obj (SAI_API_ROUTER_INTERFACE, sai_router_interface_api_t, router_interface)      \
+    _obj (SAI_API_NEXT_HOP,         sai_next_hop_api_t,         next_hop)              \
+    _obj (SAI_API_NEXT_HOP_GROUP,   sai_next_hop_group_api_t,   next_hop_group)        \
+    _obj (SAI_API_NEXT_HOP_GROUP,   sai_next_hop_group_api_t,   next_hop_group_member) \
+    _obj (SAI_API_ACL,              sai_acl_api_t,              acl_table)             \
+    _obj (SAI_API_ACL,              sai_acl_api_t,              acl_entry)             \
+    _obj (SAI_API_ACL,              sai_acl_api_t,              acl_counter)           \
+    _obj (SAI_API_HOSTIF,           sai_hostif_api_t,           hostif)                \
+    _obj (SAI_API_STP,              sai_stp_api_t,              stp)                   \
+    _obj (SAI_API_STP,              sai_stp_api_t,              stp_port)
+
+/* Entry keyed objects, with the sai_X_t entry as the key of the methods */
+#define SAI_API_STATS_ENTRY_OBJECTS(_obj) \
+    _obj (SAI_API_FDB,              sai_fdb_api_t,              fdb_entry)             \
+    _obj (SAI_API_NEIGHBOR,         sai_neighbor_api_t,         neighbor_entry)        \
+    _obj (SAI_API_ROUTE,            sai_route_api_t,            route_entry)
+
+/* Objects with the create_Xs/remove_Xs bulk methods in the method table */
+#define SAI_API_STATS_BULK_OBJECTS(_obj) \
+    _obj (SAI_API_STP,              sai_stp_api_t,              stp_port)
+
+/* Method tables wrapped, one per API */
+#define SAI_API_STATS_APIS(_api) \
+    _api (SAI_API_PORT,             sai_port_api_t)             \
+    _api (SAI_API_VLAN,             sai_vlan_api_t)             \
+    _api (SAI_API_LAG,              sai_lag_api_t)              \
+    _api (SAI_API_BRIDGE,           sai_bridge_api_t)           \
+    _api (SAI_API_FDB,              sai_fdb_api_t)              \
+    _api (SAI_API_VIRTUAL_ROUTER,   sai_virtual_router_api_t)   \
+    _api (SAI_API_ROUTER_INTERFACE, sai_router_interface_api_t) \
+    _api (SAI_API_NEIGHBOR,         sai_neighbor_api_t)         \
+    _api (SAI_API_NEXT_HOP,         sai_next_hop_api_t)         \
+    _api (SAI_API_NEXT_HOP_GROUP,   sai_next_hop_group_api_t)   \
+    _api (SAI_API_ROUTE,            sai_route_api_t)            \
+    _api (SAI_API_ACL,              sai_acl_api_t)              \
+    _api (SAI_API_HOSTIF,           sai_hostif_api_t)           \
+    _api (SAI_API_STP,              sai_stp_api_t)
+
+#define SAI_API_STATS_METHOD_IDS(_api_id, _type, _obj) \
+    sai_api_stats_ ## _obj ## _create, \
+    sai_api_stats_ ## _obj ## _remove, \
+    sai_api_stats_ ## _obj ## _set,    \
+    sai_api_stats_ ## _obj ## _get,
+
+#define SAI_API_STATS_BULK_METHOD_IDS(_api_id, _type, _obj) \
+    sai_api_stats_ ## _obj ## _bulk_create, \
+    sai_api_stats_ ## _obj ## _bulk_remove,
+
+/* Exported bulk APIs come last, in the order of sai_api_stats_bulk_t */
+typedef enum _sai_api_stats_method_t {
+    SAI_API_STATS_OID_OBJECTS (SAI_API_STATS_METHOD_IDS)
+    SAI_API_STATS_ENTRY_OBJECTS (SAI_API_STATS_METHOD_IDS)
+    SAI_API_STATS_BULK_OBJECTS (SAI_API_STATS_BULK_METHOD_IDS)
+    SAI_API_STATS_METHOD_EXPORTED_BULK,
+    SAI_API_STATS_METHOD_MAX = SAI_API_STATS_METHOD_EXPORTED_BULK + SAI_API_STATS_BULK_MAX
+} sai_api_stats_method_t;
+
+typedef struct _sai_api_stats_name_t {
+    const char *object;
+    const char *op;
+} sai_api_stats_name_t;
+
+#define SAI_API_STATS_METHOD_NAMES(_api_id, _type, _obj) \
+    { #_obj, "create" }, { #_obj, "remove" }, { #_obj, "set" }, { #_obj, "get" },
+
+#define SAI_API_STATS_BULK_METHOD_NAMES(_api_id, _type, _obj) \
+    { #_obj, "bulk_create" }, { #_obj, "bulk_remove" },
+
+static const sai_api_stats_name_t sai_api_stats_method_name [SAI_API_STATS_METHOD_MAX] = {
+    SAI_API_STATS_OID_OBJECTS (SAI_API_STATS_METHOD_NAMES)
+    SAI_API_STATS_ENTRY_OBJECTS (SAI_API_STATS_METHOD_NAMES)
+    SAI_API_STATS_BULK_OBJECTS (SAI_API_STATS_BULK_METHOD_NAMES)
+    [SAI_API_STATS_METHOD_EXPORTED_BULK + SAI_API_STATS_BULK_FDB_ENTRY_CREATE] =
+        { "fdb_entry", "bulk_create" },
+    [SAI_API_STATS_METHOD_EXPORTED_BULK + SAI_API_STATS_BULK_FDB_ENTRY_REMOVE] =
+        { "fdb_entry", "bulk_remove" },
+    [SAI_API_STATS_METHOD_EXPORTED_BULK + SAI_API_STATS_BULK_FDB_ENTRY_SET] =
+        { "fdb_entry", "bulk_set" },
+    [SAI_API_STATS_METHOD_EXPORTED_BULK + SAI_API_STATS_BULK_NEIGHBOR_ENTRY_CREATE] =
+        { "neighbor_entry", "bulk_create" },
+    [SAI_API_STATS_METHOD_EXPORTED_BULK + SAI_API_STATS_BULK_NEIGHBOR_ENTRY_REMOVE] =
+        { "neighbor_entry", "bulk_remove" },
+    [SAI_API_STATS_METHOD_EXPORTED_BULK + SAI_API_STATS_BULK_NEXT_HOP_CREATE] =
+        { "next_hop", "bulk_create" },
+    [SAI_API_STATS_METHOD_EXPORTED_BULK + SAI_API_STATS_BULK_NEXT_HOP_REMOVE] =
+        { "next_hop", "bulk_remove" },
+    [SAI_API_STATS_METHOD_EXPORTED_BULK + SAI_API_STATS_BULK_ACL_ENTRY_CREATE] =
+        { "acl_entry", "bulk_create" },
+    [SAI_API_STATS_METHOD_EXPORTED_BULK + SAI_API_STATS_BULK_ACL_ENTRY_REMOVE] =
+        { "acl_entry", "bulk_remove" },
+    [SAI_API_STATS_METHOD_EXPORTED_BULK + SAI_API_STATS_BULK_ACL_COUNTER_CREATE] =
+        { "acl_counter", "bulk_create" },
+    [SAI_API_STATS_METHOD_EXPORTED_BULK + SAI_API_STATS_BULK_ACL_COUNTER_REMOVE] =
+        { "acl_counter", "bulk_remove" },
+};
+
+/* Sub buckets per power of two */
+#define SAI_API_STATS_SUB_BUCKET_BITS  3
+#define SAI_API_STATS_SUB_BUCKETS      (1 << SAI_API_STATS_SUB_BUCKET_BITS)
+
+/* Latencies are clamped to 2^40 ns, about 18 minutes */
+#define SAI_API_STATS_MAX_MSB          39
+
+#define SAI_API_STATS_BUCKETS \
+    ((SAI_API_STATS_MAX_MSB - SAI_API_STATS_SUB_BUCKET_BITS + 2) * \
+     SAI_API_STATS_SUB_BUCKETS)
+
+#define SAI_API_STATS_NSEC_PER_SEC     1000000000ULL
+
+typedef struct _sai_api_stats_rec_t {
+    uint64_t calls;
+    uint64_t objects;
+    uint64_t errors;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t lock_waits;
+    uint64_t lock_wait_ns;
+    uint32_t hist [SAI_API_STATS_BUCKETS];
+} sai_api_stats_rec_t;
+
+typedef struct _sai_api_stats_thread_t {
+    struct _sai_api_stats_thread_t *next;
+    uint32_t                        gen;
+    sai_api_stats_rec_t             rec [SAI_API_STATS_METHOD_MAX];
+} sai_api_stats_thread_t;
+
+static volatile bool sai_api_stats_enabled = false;
+
+/* Bumped on reset, blocks of an older generation are stale */
+static volatile uint32_t sai_api_stats_gen = 0;
+
+/* Blocks of all the threads that ever called a wrapped method */
+static sai_api_stats_thread_t *sai_api_stats_thread_list = NULL;
+
+static std_mutex_lock_create_static_init_fast (sai_api_stats_lock);
+
+static pthread_once_t sai_api_stats_once = PTHREAD_ONCE_INIT;
+
+static __thread sai_api_stats_thread_t *sai_api_stats_thread = NULL;
+
+/* Record of the API call in progress on this thread, charged for lock waits */
+static __thread sai_api_stats_rec_t *sai_api_stats_cur_rec = NULL;
+
+static inline uint64_t sai_api_stats_now_ns (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+
+    return (((uint64_t) ts.tv_sec * SAI_API_STATS_NSEC_PER_SEC) + ts.tv_nsec);
+}
+
+static inline uint_t sai_api_stats_bucket_get (uint64_t ns)
+{
+    uint_t msb;
+
+    if (ns < SAI_API_STATS_SUB_BUCKETS) {
+        return (uint_t) ns;
+    }
+
+    msb = 63 - __builtin_clzll (ns);
+
+    if (msb > SAI_API_STATS_MAX_MSB) {
+        return (SAI_API_STATS_BUCKETS - 1);
+    }
+
+    return (((msb - SAI_API_STATS_SUB_BUCKET_BITS + 1) * SAI_API_STATS_SUB_BUCKETS) +
+            ((ns >> (msb - SAI_API_STATS_SUB_BUCKET_BITS)) &
+             (SAI_API_STATS_SUB_BUCKETS - 1)));
+}
+
+/* Lowest latency counted in a bucket */
+static uint64_t sai_api_stats_bucket_ns (uint_t bucket)
+{
+    uint_t msb;
+    uint_t sub;
+
+    if (bucket < SAI_API_STATS_SUB_BUCKETS) {
+        return bucket;
+    }
+
+    msb = (bucket / SAI_API_STATS_SUB_BUCKETS) + SAI_API_STATS_SUB_BUCKET_BITS - 1;
+    sub = bucket % SAI_API_STATS_SUB_BUCKETS;
+
+    return (((uint64_t) (SAI_API_STATS_SUB_BUCKETS + sub)) <<
+            (msb - SAI_API_STATS_SUB_BUCKET_BITS));
+}
+
+static sai_api_stats_thread_t *sai_api_stats_thread_get (void)
+{
+    sai_api_stats_thread_t *p_thread = sai_api_stats_thread;
+    uint32_t                gen = sai_api_stats_gen;
+
+    if (p_thread != NULL) {
+        if (p_thread->gen != gen) {
+            memset (p_thread->rec, 0, sizeof (p_thread->rec));
+            p_thread->gen = gen;
+        }
+
+        return p_thread;
+    }
+
+    p_thread = (sai_api_stats_thread_t *) calloc (1, sizeof (*p_thread));
+
+    if (p_thread == NULL) {
+        return NULL;
+    }
+
+    p_thread->gen = gen;
+
+    /* Blocks stay linked after the thread exits, to keep its counts */
+    std_mutex_lock (&sai_api_stats_lock);
+    p_thread->next = sai_api_stats_thread_list;
+    sai_api_stats_thread_list = p_thread;
+    std_mutex_unlock (&sai_api_stats_lock);
+
+    sai_api_stats_thread = p_thread;
+
+    return p_thread;
+}
+
+static inline sai_api_stats_rec_t *sai_api_stats_call_start (
+                                   sai_api_stats_method_t method,
+                                   uint64_t *p_start_ns)
+{
+    sai_api_stats_thread_t *p_thread;
+
+    if (!sai_api_stats_enabled) {
+        return NULL;
+    }
+
+    p_thread = sai_api_stats_thread_get ();
+
+    if (p_thread == NULL) {
+        return NULL;
+    }
+
+    sai_api_stats_cur_rec = &p_thread->rec [method];
+    *p_start_ns = sai_api_stats_now_ns ();
+
+    return sai_api_stats_cur_rec;
+}
+
+static inline void sai_api_stats_call_end (sai_api_stats_rec_t *p_rec,
+                                           uint64_t start_ns,
+                                           uint32_t object_count,
+                                           sai_status_t status)
+{
+    uint64_t ns;
+
+    if (p_rec == NULL) {
+        return;
+    }
+
+    ns = sai_api_stats_now_ns () - start_ns;
+
+    sai_api_stats_cur_rec = NULL;
+
+    p_rec->calls++;
+    p_rec->objects += object_count;
+    p_rec->total_ns += ns;
+    p_rec->hist [sai_api_stats_bucket_get (ns)]++;
+
+    if (ns > p_rec->max_ns) {
+        p_rec->max_ns = ns;
+    }
+
+    if (status != SAI_STATUS_SUCCESS) {
+        p_rec->errors++;
+    }
+}
+
+#define SAI_API_STATS_CALL(_method, _object_count, _call)                    \
+    do {                                                                      \
+        sai_api_stats_rec_t *p_rec;                                           \
+        uint64_t             start_ns = 0;                                    \
+        sai_status_t         status;                                          \
+                                                                              \
+        p_rec = sai_api_stats_call_start (_method, &start_ns);                \
+        status = _call;                                                       \
+        sai_api_stats_call_end (p_rec, start_ns, _object_count, status);      \
+                                                                              \
+        return status;                                                        \
+    } while (0)
+
+#define SAI_API_STATS_OID_WRAPPERS(_api_id, _type, _obj)                      \
+static const _type *sai_api_stats_ ## _obj ## _orig = NULL;                   \
+                                                                              \
+static sai_status_t sai_api_stats_ ## _obj ## _create_fn (                    \
+                                   sai_object_id_t *obj_id,                   \
+                                   sai_object_id_t switch_id,                 \
+                                   uint32_t attr_count,                       \
+                                   const sai_attribute_t *attr_list)          \
+{                                                                             \
+    SAI_API_STATS_CALL (sai_api_stats_ ## _obj ## _create, 1,                 \
+                        sai_api_stats_ ## _obj ## _orig->create_ ## _obj      \
+                        (obj_id, switch_id, attr_count, attr_list));          \
+}                                                                             \
+                                                                              \
+static sai_status_t sai_api_stats_ ## _obj ## _remove_fn (                    \
+                                   sai_object_id_t obj_id)                    \
+{                                                                             \
+    SAI_API_STATS_CALL (sai_api_stats_ ## _obj ## _remove, 1,                 \
+                        sai_api_stats_ ## _obj ## _orig->remove_ ## _obj      \
+                        (obj_id));                                            \
+}                                                                             \
+                                                                              \
+static sai_status_t sai_api_stats_ ## _obj ## _set_fn (                       \
+                                   sai_object_id_t obj_id,                    \
+                                   const sai_attribute_t *attr)               \
+{                                                                             \
+    SAI_API_STATS_CALL (sai_api_stats_ ## _obj ## _set, 1,                    \
+                        sai_api_stats_ ## _obj ## _orig->set_ ## _obj ##      \
+                        _attribute (obj_id, attr));                           \
+}                                                                             \
+                                                                              \
+static sai_status_t sai_api_stats_ ## _obj ## _get_fn (                       \
+                                   sai_object_id_t obj_id,                    \
+                                   uint32_t attr_count,                       \
+                                   sai_attribute_t *attr_list)                \
+{                                                                             \
+    SAI_API_STATS_CALL (sai_api_stats_ ## _obj ## _get, 1,                    \
+                        sai_api_stats_ ## _obj ## _orig->get_ ## _obj ##      \
+                        _attribute (obj_id, attr_count, attr_list));          \
+}
+
+#define SAI_API_STATS_ENTRY_WRAPPERS(_api_id, _type, _obj)                    \
+static const _type *sai_api_stats_ ## _obj ## _orig = NULL;                   \
+                                                                              \
+static sai_status_t sai_api_stats_ ## _obj ## _create_fn (                    \
+                                   const sai_ ## _obj ## _t *entry,           \
+                                   uint32_t attr_count,                       \
+                                   const sai_attribute_t *attr_list)          \
+{                                                                             \
+    SAI_API_STATS_CALL (sai_api_stats_ ## _obj ## _create, 1,                 \
+                        sai_api_stats_ ## _obj ## _orig->create_ ## _obj      \
+                        (entry, attr_count, attr_list));                      \
+}                                                                             \
+                                                                              \
+static sai_status_t sai_api_stats_ ## _obj ## _remove_fn (                    \
+                                   const sai_ ## _obj ## _t *entry)           \
+{                                                                             \
+    SAI_API_STATS_CALL (sai_api_stats_ ## _obj ## _remove, 1,                 \
+                        sai_api_stats_ ## _obj ## _orig->remove_ ## _obj      \
+                        (entry));                                             \
+}                                                                             \
+                                                                              \
+static sai_status_t sai_api_stats_ ## _obj ## _set_fn (                       \
+                                   const sai_ ## _obj ## _t *entry,           \
+                                   const sai_attribute_t *attr)               \
+{                                                                             \
+    SAI_API_STATS_CALL (sai_api_stats_ ## _obj ## _set, 1,                    \
+                        sai_api_stats_ ## _obj ## _orig->set_ ## _obj ##      \
+                        _attribute (entry, attr));                            \
+}                                                                             \
+                                                                              \
+static sai_status_t sai_api_stats_ ## _obj ## _get_fn (                       \
+                                   const sai_ ## _obj ## _t *entry,           \
+                                   uint32_t attr_count,                       \
+                                   sai_attribute_t *attr_list)                \
+{                                                                             \
+    SAI_API_STATS_CALL (sai_api_stats_ ## _obj ## _get, 1,                    \
+                        sai_api_stats_ ## _obj ## _orig->get_ ## _obj ##      \
+                        _attribute (entry, attr_count, attr_list));           \
+}
+
+#define SAI_API_STATS_BULK_WRAPPERS(_api_id, _type, _obj)                     \
+static sai_status_t sai_api_stats_ ## _obj ## _bulk_create_fn (               \
+                                   sai_object_id_t switch_id,                 \
+                                   uint32_t object_count,                     \
+                                   const uint32_t *attr_count,                \
+                                   const sai_attribute_t **attr_list,         \
+                                   sai_bulk_op_error_mode_t mode,             \
+                                   sai_object_id_t *object_id,                \
+                                   sai_status_t *object_statuses)             \
+{                                                                             \
+    SAI_API_STATS_CALL (sai_api_stats_ ## _obj ## _bulk_create, object_count, \
+                        sai_api_stats_ ## _obj ## _orig->create_ ## _obj ## s \
+                        (switch_id, object_count, attr_count, attr_list,      \
+                         mode, object_id, object_statuses));                  \
+}                                                                             \
+                                                                              \
+static sai_status_t sai_api_stats_ ## _obj ## _bulk_remove_fn (               \
+                                   uint32_t object_count,                     \
+                                   const sai_object_id_t *object_id,          \
+                                   sai_bulk_op_error_mode_t mode,             \
+                                   sai_status_t *object_statuses)             \
+{                                                                             \
+    SAI_API_STATS_CALL (sai_api_stats_ ## _obj ## _bulk_remove, object_count, \
+                        sai_api_stats_ ## _obj ## _orig->remove_ ## _obj ## s \
+                        (object_count, object_id, mode, object_statuses));    \
+}
+
+SAI_API_STATS_OID_OBJECTS (SAI_API_STATS_OID_WRAPPERS)
+SAI_API_STATS_ENTRY_OBJECTS (SAI_API_STATS_ENTRY_WRAPPERS)
+SAI_API_STATS_BULK_OBJECTS (SAI_API_STATS_BULK_WRAPPERS)
+
+/* Methods the API does not implement are left NULL in the wrapped table */
+#define SAI_API_STATS_METHODS_PATCH(_api_id, _type, _obj)                     \
+    if (api_id == _api_id) {                                                  \
+        const _type *p_orig = (const _type *) method_table;                   \
+        _type       *p_tbl = (_type *) wrapped_table;                         \
+                                                                              \
+        sai_api_stats_ ## _obj ## _orig = p_orig;                             \
+                                                                              \
+        if (p_orig->create_ ## _obj != NULL) {                                \
+            p_tbl->create_ ## _obj = sai_api_stats_ ## _obj ## _create_fn;    \
+        }                                                                     \
+        if (p_orig->remove_ ## _obj != NULL) {                                \
+            p_tbl->remove_ ## _obj = sai_api_stats_ ## _obj ## _remove_fn;    \
+        }                                                                     \
+        if (p_orig->set_ ## _obj ## _attribute != NULL) {                     \
+            p_tbl->set_ ## _obj ## _attribute =                               \
+                sai_api_stats_ ## _obj ## _set_fn;                            \
+        }                                                                     \
+        if (p_orig->get_ ## _obj ## _attribute != NULL) {                     \
+            p_tbl->get_ ## _obj ## _attribute =                               \
+                sai_api_stats_ ## _obj ## _get_fn;                            \
+        }                                                                     \
+    }
+
+/* Set after SAI_API_STATS_METHODS_PATCH, which sets the _orig table */
+#define SAI_API_STATS_BULK_METHODS_PATCH(_api_id, _type, _obj)                \
+    if (api_id == _api_id) {                                                  \
+        const _type *p_orig = (const _type *) method_table;                   \
+        _type       *p_tbl = (_type *) wrapped_table;                         \
+                                                                              \
+        if (p_orig->create_ ## _obj ## s != NULL) {                           \
+            p_tbl->create_ ## _obj ## s =                                     \
+                sai_api_stats_ ## _obj ## _bulk_create_fn;                    \
+        }                                                                     \
+        if (p_orig->remove_ ## _obj ## s != NULL) {                           \
+            p_tbl->remove_ ## _obj ## s =                                     \
+                sai_api_stats_ ## _obj ## _bulk_remove_fn;                    \
+        }                                                                     \
+    }
+
+#define SAI_API_STATS_TABLE_CASE(_api_id, _type)                              \
+    case _api_id:                                                             \
+        {                                                                     \
+            static _type wrapped_tbl;                                         \
+                                                                              \
+            wrapped_table = &wrapped_tbl;                                     \
+            table_size = sizeof (wrapped_tbl);                                \
+        }                                                                     \
+        break;
+
+static void sai_api_stats_init (void)
+{
+    const char *env = getenv (SAI_API_STATS_ENV);
+
+    if ((env != NULL) && (strtol (env, NULL, 0) != 0)) {
+        sai_api_stats_enabled = true;
+    }
+}
+
+void *sai_api_stats_table_wrap (sai_api_t api_id, void *method_table)
+{
+    static bool  wrapped [SAI_API_MAX];
+    void        *wrapped_table = NULL;
+    size_t       table_size = 0;
+
+    if (method_table == NULL) {
+        return method_table;
+    }
+
+    pthread_once (&sai_api_stats_once, sai_api_stats_init);
+
+    switch (api_id) {
+        SAI_API_STATS_APIS (SAI_API_STATS_TABLE_CASE)
+
+        default:
+            return method_table;
+    }
+
+    std_mutex_lock (&sai_api_stats_lock);
+
+    if (!wrapped [api_id]) {
+        memcpy (wrapped_table, method_table, table_size);
+
+        SAI_API_STATS_OID_OBJECTS (SAI_API_STATS_METHODS_PATCH)
+        SAI_API_STATS_ENTRY_OBJECTS (SAI_API_STATS_METHODS_PATCH)
+        SAI_API_STATS_BULK_OBJECTS (SAI_API_STATS_BULK_METHODS_PATCH)
+
+        wrapped [api_id] = true;
+    }
+
+    std_mutex_unlock (&sai_api_stats_lock);
+
+    return wrapped_table;
+}
+
+void sai_api_stats_bulk_start (sai_api_stats_bulk_t bulk,
+                               sai_api_stats_call_t *p_call)
+{
+    sai_api_stats_method_t method = SAI_API_STATS_METHOD_EXPORTED_BULK + bulk;
+
+    p_call->start_ns = 0;
+    p_call->p_rec = sai_api_stats_call_start (method, &p_call->start_ns);
+}
+
+void sai_api_stats_bulk_end (sai_api_stats_call_t *p_call,
+                             uint32_t object_count, sai_status_t status)
+{
+    sai_api_stats_call_end ((sai_api_stats_rec_t *) p_call->p_rec,
+                            p_call->start_ns, object_count, status);
+}
+
+void sai_api_stats_enable_set (bool enable)
+{
+    pthread_once (&sai_api_stats_once, sai_api_stats_init);
+
+    sai_api_stats_enabled = enable;
+}
+
+bool sai_api_stats_is_enabled (void)
+{
+    return sai_api_stats_enabled;
+}
+
+void sai_api_stats_mutex_lock (std_mutex_type_t *lock)
+{
+    sai_api_stats_rec_t *p_rec = sai_api_stats_cur_rec;
+    uint64_t             start_ns;
+
+    if (p_rec == NULL) {
+        std_mutex_lock (lock);
+        return;
+    }
+
+    /* The clock is only read when the lock is contended */
+    if (pthread_mutex_trylock (lock) == 0) {
+        return;
+    }
+
+    start_ns = sai_api_stats_now_ns ();
+
+    std_mutex_lock (lock);
+
+    p_rec->lock_waits++;
+    p_rec->lock_wait_ns += sai_api_stats_now_ns () - start_ns;
+}
+
+void sai_api_stats_rwlock_lock (pthread_rwlock_t *lock, bool write)
+{
+    sai_api_stats_rec_t *p_rec = sai_api_stats_cur_rec;
+    uint64_t             start_ns = 0;
+
+    if (p_rec != NULL) {
+        if ((write ? pthread_rwlock_trywrlock (lock) :
+                     pthread_rwlock_tryrdlock (lock)) == 0) {
+            return;
+        }
+        start_ns = sai_api_stats_now_ns ();
+    }
+
+    if (write) {
+        pthread_rwlock_wrlock (lock);
+    } else {
+        pthread_rwlock_rdlock (lock);
+    }
+
+    if (p_rec != NULL) {
+        p_rec->lock_waits++;
+        p_rec->lock_wait_ns += sai_api_stats_now_ns () - start_ns;
+    }
+}
+
+/* Latency under which pct percent of the calls completed */
+static uint64_t sai_api_stats_percentile_get (const sai_api_stats_rec_t *p_rec,
+                                              uint_t pct)
+{
+    uint64_t target = ((p_rec->calls * pct) + 99) / 100;
+    uint64_t count = 0;
+    uint_t   bucket;
+
+    for (bucket = 0; bucket < SAI_API_STATS_BUCKETS; bucket++) {
+        count += p_rec->hist [bucket];
+
+        if (count >= target) {
+            return ((bucket + 1) < SAI_API_STATS_BUCKETS) ?
+                    sai_api_stats_bucket_ns (bucket + 1) : p_rec->max_ns;
+        }
+    }
+
+    return p_rec->max_ns;
+}
+
+static void sai_api_stats_rec_sum (sai_api_stats_method_t method,
+                                   sai_api_stats_rec_t *p_sum)
+{
+    const sai_api_stats_thread_t *p_thread;
+    const sai_api_stats_rec_t    *p_rec;
+    uint32_t                      gen = sai_api_stats_gen;
+    uint_t                        bucket;
+
+    memset (p_sum, 0, sizeof (*p_sum));
+
+    /* Counters of running threads are read without sync, off by a call */
+    for (p_thread = sai_api_stats_thread_list; p_thread != NULL;
+         p_thread = p_thread->next) {
+
+        if (p_thread->gen != gen) {
+            continue;
+        }
+
+        p_rec = &p_thread->rec [method];
+
+        if (p_rec->calls == 0) {
+            continue;
+        }
+
+        p_sum->calls += p_rec->calls;
+        p_sum->objects += p_rec->objects;
+        p_sum->errors += p_rec->errors;
+        p_sum->total_ns += p_rec->total_ns;
+        p_sum->lock_waits += p_rec->lock_waits;
+        p_sum->lock_wait_ns += p_rec->lock_wait_ns;
+
+        if (p_rec->max_ns > p_sum->max_ns) {
+            p_sum->max_ns = p_rec->max_ns;
+        }
+
+        for (bucket = 0; bucket < SAI_API_STATS_BUCKETS; bucket++) {
+            p_sum->hist [bucket] += p_rec->hist [bucket];
+        }
+    }
+}
+
+void sai_api_stats_dump (void)
+{
+    sai_api_stats_rec_t *p_sum;
+    uint_t               method;
+    bool                 empty = true;
+
+    p_sum = (sai_api_stats_rec_t *) calloc (1, sizeof (*p_sum));
+
+    if (p_sum == NULL) {
+        SAI_DEBUG ("Failed to allocate the API stats dump record");
+        return;
+    }
+
+    SAI_DEBUG ("API stats collection is %s, latencies in usec",
+               sai_api_stats_enabled ? "enabled" : "disabled");
+    SAI_DEBUG ("%-22s %-11s %10s %10s %8s %9s %9s %9s %9s %10s %8s %10s",
+               "Object", "Method", "Calls", "Objects", "Errors", "Avg", "P50",
+               "P90", "P99", "Max", "Lk-waits", "Lk-wait");
+
+    std_mutex_lock (&sai_api_stats_lock);
+
+    for (method = 0; method < SAI_API_STATS_METHOD_MAX; method++) {
+        sai_api_stats_rec_sum (method, p_sum);
+
+        if (p_sum->calls == 0) {
+            continue;
+        }
+
+        empty = false;
+
+        SAI_DEBUG ("%-22s %-11s %10"PRIu64" %10"PRIu64" %8"PRIu64" %9.1f %9.1f "
+                   "%9.1f %9.1f %10.1f %8"PRIu64" %10.1f",
+                   sai_api_stats_method_name [method].object,
+                   sai_api_stats_method_name [method].op, p_sum->calls,
+                   p_sum->objects, p_sum->errors, (p_sum->total_ns / 1000.0) / p_sum->calls,
+                   sai_api_stats_percentile_get (p_sum, 50) / 1000.0,
+                   sai_api_stats_percentile_get (p_sum, 90) / 1000.0,
+                   sai_api_stats_percentile_get (p_sum, 99) / 1000.0,
+                   p_sum->max_ns / 1000.0, p_sum->lock_waits,
+                   p_sum->lock_wait_ns / 1000.0);
+    }
+
+    std_mutex_unlock (&sai_api_stats_lock);
+
+    if (empty) {
+        SAI_DEBUG ("No API calls recorded");
+    }
+
+    free (p_sum);
+}
+
+void sai_api_stats_reset (void)
+{
+    std_mutex_lock (&sai_api_stats_lock);
+
+    sai_api_stats_gen++;
+
+    std_mutex_unlock (&sai_api_stats_lock);
+}
@@ -27,6 +27,7 @@
 #include <stdio.h>
 #include "sai_oid_utils.h"
 #include "sai_npu_api_plugin.h"
+#include "sai_api_stats.h"
 #include "std_assert.h"
 #include <dlfcn.h>
 
@@ -203,6 +204,8 @@ sai_status_t sai_api_query(sai_api_t sai_api_id, void** api_method_table)
             return SAI_STATUS_NOT_SUPPORTED;
     }
 
+    *api_method_table = sai_api_stats_table_wrap (sai_api_id, *api_method_table);
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -0,0 +1,730 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file sai_log_async.c
+*
+* @brief This file contains the asynchronous SAI log sink: per thread
+*        single producer rings of log records, and the log thread
+*        formatting and emitting them.
+*************************************************************************/
+
+#include "sai_log_async.h"
+#include "sai_event_log.h"
+#include "sai_switch_utils.h"
+#include "saistatus.h"
+
+#include "std_type_defs.h"
+#include "std_thread_tools.h"
+#include "std_mutex_lock.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <time.h>
+
+/* Sleep of the log thread when the rings are empty */
+#define SAI_LOG_ASYNC_IDLE_NSEC    (1000000)
+
+/* Records the log thread emits from a ring before moving to the next */
+#define SAI_LOG_ASYNC_BURST        (64)
+
+/* Longest printf conversion specification, as rebuilt by the log thread */
+#define SAI_LOG_ASYNC_SPEC_LEN     (32)
+
+/* String argument passed as NULL */
+#define SAI_LOG_ASYNC_STR_NULL     (UINT64_MAX)
+
+typedef enum _sai_log_async_len_t {
+    SAI_LOG_ASYNC_LEN_NONE,
+    SAI_LOG_ASYNC_LEN_HH,
+    SAI_LOG_ASYNC_LEN_H,
+    SAI_LOG_ASYNC_LEN_L,
+    SAI_LOG_ASYNC_LEN_LL,
+    SAI_LOG_ASYNC_LEN_J,
+    SAI_LOG_ASYNC_LEN_Z,
+    SAI_LOG_ASYNC_LEN_T,
+} sai_log_async_len_t;
+
+/* A printf conversion specification, width and precision -1 if absent */
+typedef struct _sai_log_async_spec_t {
+    char                flags [8];
+    int                 width;
+    bool                width_star;
+    int                 precision;
+    bool                precision_star;
+    sai_log_async_len_t len;
+    char                conv;
+} sai_log_async_spec_t;
+
+/*
+ * A queued log. Integer and pointer arguments are stored as 64 bit values,
+ * doubles by their bits, and strings as their offset in str_buf. A log
+ * whose format can not be stored so has its text in str_buf and no fmt.
+ * file, func and line are the location of the SAI_LOG_UTIL call.
+ */
+typedef struct _sai_log_async_rec_t {
+    const char      *fmt;
+    const char      *file;
+    const char      *func;
+    int              line;
+    int              module;
+    sai_log_level_t  level;
+    uint64_t         args [SAI_LOG_ASYNC_MAX_ARGS];
+    char             str_buf [SAI_LOG_ASYNC_STR_BUF_LEN];
+} sai_log_async_rec_t;
+
+/* Ring of a thread. head is written by the thread, tail by the log thread */
+typedef struct _sai_log_async_ring_t {
+    struct _sai_log_async_ring_t *next;
+    uint64_t                      head;
+    uint64_t                      tail;
+    uint64_t                      drops;
+    /* Set when the thread exits, the log thread frees the drained ring */
+    bool                          orphan;
+    sai_log_async_rec_t           rec [SAI_LOG_ASYNC_RING_SIZE];
+} sai_log_async_ring_t;
+
+bool g_sai_log_async_enabled = false;
+
+static __thread sai_log_async_ring_t *sai_log_async_thread_ring = NULL;
+
+/* Ring list, new rings are added at the head. Unlinked by the log thread */
+static sai_log_async_ring_t *sai_log_async_ring_list = NULL;
+static std_mutex_lock_create_static_init_fast (sai_log_async_lock);
+
+/* Drops of freed rings and of threads without a ring */
+static uint64_t sai_log_async_drops = 0;
+
+static pthread_once_t sai_log_async_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t  sai_log_async_key;
+
+static bool sai_log_async_thread_started = false;
+static std_thread_create_param_t sai_log_async_thread;
+
+/*
+ * Runs in the exiting thread. A log of the thread after this, from another
+ * key destructor, registers a new ring, released on the next destructor
+ * iteration.
+ */
+static void sai_log_async_ring_release (void *arg)
+{
+    sai_log_async_ring_t *ring = (sai_log_async_ring_t *) arg;
+
+    sai_log_async_thread_ring = NULL;
+
+    __atomic_store_n (&ring->orphan, true, __ATOMIC_RELEASE);
+}
+
+static void sai_log_async_key_create (void)
+{
+    pthread_key_create (&sai_log_async_key, sai_log_async_ring_release);
+}
+
+static sai_log_async_ring_t *sai_log_async_ring_get (void)
+{
+    sai_log_async_ring_t *ring = sai_log_async_thread_ring;
+
+    if (ring != NULL) {
+        return ring;
+    }
+
+    pthread_once (&sai_log_async_key_once, sai_log_async_key_create);
+
+    ring = (sai_log_async_ring_t *) calloc (1, sizeof (sai_log_async_ring_t));
+
+    if (ring == NULL) {
+        return NULL;
+    }
+
+    pthread_setspecific (sai_log_async_key, ring);
+
+    std_mutex_lock (&sai_log_async_lock);
+    ring->next = sai_log_async_ring_list;
+    sai_log_async_ring_list = ring;
+    std_mutex_unlock (&sai_log_async_lock);
+
+    sai_log_async_thread_ring = ring;
+
+    return ring;
+}
+
+/*
+ * Parse the conversion specification following a '%' of a format, fmt
+ * pointing past the '%'. Returns the character following the spec, NULL
+ * if the spec is one the sink does not store.
+ */
+static const char *sai_log_async_spec_parse (const char *fmt,
+                                             sai_log_async_spec_t *spec)
+{
+    size_t flag_count = 0;
+
+    memset (spec, 0, sizeof (*spec));
+    spec->width = -1;
+    spec->precision = -1;
+
+    while ((*fmt != '\0') && (strchr ("-+ #0", *fmt) != NULL)) {
+        if (flag_count < (sizeof (spec->flags) - 1)) {
+            spec->flags [flag_count++] = *fmt;
+        }
+        fmt++;
+    }
+
+    if (*fmt == '*') {
+        spec->width_star = true;
+        fmt++;
+    } else if ((*fmt >= '0') && (*fmt <= '9')) {
+        spec->width = (int) strtol (fmt, (char **) &fmt, 10);
+    }
+
+    if (*fmt == '.') {
+        fmt++;
+        if (*fmt == '*') {
+            spec->precision_star = true;
+            fmt++;
+        } else {
+            spec->precision = (int) strtol (fmt, (char **) &fmt, 10);
+        }
+    }
+
+    switch (*fmt) {
+        case 'h':
+            fmt++;
+            spec->len = SAI_LOG_ASYNC_LEN_H;
+            if (*fmt == 'h') {
+                fmt++;
+                spec->len = SAI_LOG_ASYNC_LEN_HH;
+            }
+            break;
+        case 'l':
+            fmt++;
+            spec->len = SAI_LOG_ASYNC_LEN_L;
+            if (*fmt == 'l') {
+                fmt++;
+                spec->len = SAI_LOG_ASYNC_LEN_LL;
+            }
+            break;
+        case 'q':
+            fmt++;
+            spec->len = SAI_LOG_ASYNC_LEN_LL;
+            break;
+        case 'j':
+            fmt++;
+            spec->len = SAI_LOG_ASYNC_LEN_J;
+            break;
+        case 'z':
+            fmt++;
+            spec->len = SAI_LOG_ASYNC_LEN_Z;
+            break;
+        case 't':
+            fmt++;
+            spec->len = SAI_LOG_ASYNC_LEN_T;
+            break;
+        default:
+            break;
+    }
+
+    spec->conv = *fmt;
+
+    switch (spec->conv) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            return (fmt + 1);
+        case 'e': case 'E': case 'f': case 'F':
+        case 'g': case 'G': case 'a': case 'A':
+            return (((spec->len == SAI_LOG_ASYNC_LEN_NONE) ||
+                     (spec->len == SAI_LOG_ASYNC_LEN_L)) ? (fmt + 1) : NULL);
+        case 'c': case 's': case 'p':
+            return ((spec->len == SAI_LOG_ASYNC_LEN_NONE) ? (fmt + 1) : NULL);
+        default:
+            return NULL;
+    }
+}
+
+static uint64_t sai_log_async_signed_arg_get (sai_log_async_len_t len, va_list *ap)
+{
+    switch (len) {
+        case SAI_LOG_ASYNC_LEN_L:  return (uint64_t) (int64_t) va_arg (*ap, long);
+        case SAI_LOG_ASYNC_LEN_LL: return (uint64_t) (int64_t) va_arg (*ap, long long);
+        case SAI_LOG_ASYNC_LEN_J:  return (uint64_t) (int64_t) va_arg (*ap, intmax_t);
+        case SAI_LOG_ASYNC_LEN_Z:  return (uint64_t) (int64_t) va_arg (*ap, ssize_t);
+        case SAI_LOG_ASYNC_LEN_T:  return (uint64_t) (int64_t) va_arg (*ap, ptrdiff_t);
+        default:                   return (uint64_t) (int64_t) va_arg (*ap, int);
+    }
+}
+
+static uint64_t sai_log_async_unsigned_arg_get (sai_log_async_len_t len, va_list *ap)
+{
+    switch (len) {
+        case SAI_LOG_ASYNC_LEN_L:  return (uint64_t) va_arg (*ap, unsigned long);
+        case SAI_LOG_ASYNC_LEN_LL: return (uint64_t) va_arg (*ap, unsigned long long);
+        case SAI_LOG_ASYNC_LEN_J:  return (uint64_t) va_arg (*ap, uintmax_t);
+        case SAI_LOG_ASYNC_LEN_Z:  return (uint64_t) va_arg (*ap, size_t);
+        case SAI_LOG_ASYNC_LEN_T:  return (uint64_t) va_arg (*ap, ptrdiff_t);
+        default:                   return (uint64_t) va_arg (*ap, unsigned int);
+    }
+}
+
+/* Store the arguments of a log in its record, false if the format does not fit */
+static bool sai_log_async_args_store (sai_log_async_rec_t *rec, va_list *ap)
+{
+    const char           *fmt = rec->fmt;
+    sai_log_async_spec_t  spec;
+    uint_t                arg_count = 0;
+    size_t                str_used = 0;
+    size_t                str_len = 0;
+    const char           *str = NULL;
+    double                dbl = 0;
+
+    while (*fmt != '\0') {
+        if (*fmt++ != '%') {
+            continue;
+        }
+        if (*fmt == '%') {
+            fmt++;
+            continue;
+        }
+
+        fmt = sai_log_async_spec_parse (fmt, &spec);
+
+        if (fmt == NULL) {
+            return false;
+        }
+
+        if ((arg_count + spec.width_star + spec.precision_star + 1) >
+            SAI_LOG_ASYNC_MAX_ARGS) {
+            return false;
+        }
+
+        if (spec.width_star) {
+            rec->args [arg_count++] = (uint64_t) (int64_t) va_arg (*ap, int);
+        }
+        if (spec.precision_star) {
+            rec->args [arg_count++] = (uint64_t) (int64_t) va_arg (*ap, int);
+        }
+
+        switch (spec.conv) {
+            case 'd': case 'i':
+                rec->args [arg_count++] = sai_log_async_signed_arg_get (spec.len, ap);
+                break;
+            case 'u': case 'o': case 'x': case 'X':
+                rec->args [arg_count++] = sai_log_async_unsigned_arg_get (spec.len, ap);
+                break;
+            case 'c':
+                rec->args [arg_count++] = (uint64_t) (int64_t) va_arg (*ap, int);
+                break;
+            case 'p':
+                rec->args [arg_count++] = (uint64_t) (uintptr_t) va_arg (*ap, void *);
+                break;
+            case 's':
+                str = va_arg (*ap, const char *);
+                if (str == NULL) {
+                    rec->args [arg_count++] = SAI_LOG_ASYNC_STR_NULL;
+                    break;
+                }
+                /* Truncated to the space left, an empty string once full */
+                if (str_used >= sizeof (rec->str_buf)) {
+                    str_used = sizeof (rec->str_buf) - 1;
+                }
+                str_len = strnlen (str, sizeof (rec->str_buf) - str_used - 1);
+                memcpy (&rec->str_buf [str_used], str, str_len);
+                rec->str_buf [str_used + str_len] = '\0';
+                rec->args [arg_count++] = str_used;
+                str_used += str_len + 1;
+                break;
+            default:
+                dbl = va_arg (*ap, double);
+                memcpy (&rec->args [arg_count++], &dbl, sizeof (dbl));
+                break;
+        }
+    }
+
+    return true;
+}
+
+void sai_log_async_record (int module, sai_log_level_t level,
+                           const char *file, const char *func, int line,
+                           const char *fmt, ...)
+{
+    sai_log_async_ring_t *ring = sai_log_async_ring_get ();
+    sai_log_async_rec_t  *rec = NULL;
+    uint64_t              head = 0;
+    va_list               ap;
+    va_list               ap_copy;
+
+    if (ring == NULL) {
+        __atomic_fetch_add (&sai_log_async_drops, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    head = ring->head;
+
+    if ((head - __atomic_load_n (&ring->tail, __ATOMIC_ACQUIRE)) >=
+        SAI_LOG_ASYNC_RING_SIZE) {
+        __atomic_store_n (&ring->drops, ring->drops + 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    rec = &ring->rec [head & (SAI_LOG_ASYNC_RING_SIZE - 1)];
+    rec->fmt = fmt;
+    rec->file = file;
+    rec->func = func;
+    rec->line = line;
+    rec->module = module;
+    rec->level = level;
+
+    va_start (ap, fmt);
+    va_copy (ap_copy, ap);
+
+    if (! sai_log_async_args_store (rec, &ap_copy)) {
+        /* Formatted here, the log thread only emits it */
+        vsnprintf (rec->str_buf, sizeof (rec->str_buf), fmt, ap);
+        rec->fmt = NULL;
+    }
+
+    va_end (ap_copy);
+    va_end (ap);
+
+    __atomic_store_n (&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/* Format a record, conversion by conversion, into msg */
+static void sai_log_async_rec_format (const sai_log_async_rec_t *rec,
+                                      char *msg, size_t msg_len)
+{
+    const char           *fmt = rec->fmt;
+    const char           *spec_end = NULL;
+    sai_log_async_spec_t  spec;
+    char                  spec_str [SAI_LOG_ASYNC_SPEC_LEN];
+    uint_t                arg_idx = 0;
+    size_t                used = 0;
+    int                   width = 0;
+    int                   precision = 0;
+    uint64_t              arg = 0;
+    double                dbl = 0;
+    int                   rc = 0;
+
+    if (fmt == NULL) {
+        snprintf (msg, msg_len, "%s", rec->str_buf);
+        return;
+    }
+
+    msg [0] = '\0';
+
+    while ((*fmt != '\0') && (used < (msg_len - 1))) {
+        if ((*fmt != '%') || (*(fmt + 1) == '%')) {
+            msg [used++] = *fmt;
+            fmt += (*fmt == '%') ? 2 : 1;
+            continue;
+        }
+
+        spec_end = sai_log_async_spec_parse (fmt + 1, &spec);
+
+        if (spec_end == NULL) {
+            break;
+        }
+        fmt = spec_end;
+
+        width = spec.width;
+        precision = spec.precision;
+
+        if (spec.width_star) {
+            width = (int) (int64_t) rec->args [arg_idx++];
+        }
+        if (spec.precision_star) {
+            precision = (int) (int64_t) rec->args [arg_idx++];
+        }
+
+        arg = rec->args [arg_idx++];
+
+        /* The length modifier is dropped, the argument is passed at its width */
+        snprintf (spec_str, sizeof (spec_str), "%%%s", spec.flags);
+        if (width >= 0) {
+            snprintf (spec_str + strlen (spec_str), sizeof (spec_str) - strlen (spec_str),
+                      "%d", width);
+        } else if (spec.width_star) {
+            /* A negative '*' width left justifies */
+            snprintf (spec_str + strlen (spec_str), sizeof (spec_str) - strlen (spec_str),
+                      "-%d", -width);
+        }
+        if (precision >= 0) {
+            snprintf (spec_str + strlen (spec_str), sizeof (spec_str) - strlen (spec_str),
+                      ".%d", precision);
+        }
+
+        switch (spec.conv) {
+            case 'd': case 'i':
+                snprintf (spec_str + strlen (spec_str), sizeof (spec_str) - strlen (spec_str),
+                          "ll%c", spec.conv);
+                if (spec.len == SAI_LOG_ASYNC_LEN_HH) {
+                    arg = (uint64_t) (int64_t) (signed char) arg;
+                } else if (spec.len == SAI_LOG_ASYNC_LEN_H) {
+                    arg = (uint64_t) (int64_t) (short) arg;
+                }
+                rc = snprintf (msg + used, msg_len - used, spec_str, (long long) arg);
+                break;
+            case 'u': case 'o': case 'x': case 'X':
+                snprintf (spec_str + strlen (spec_str), sizeof (spec_str) - strlen (spec_str),
+                          "ll%c", spec.conv);
+                if (spec.len == SAI_LOG_ASYNC_LEN_HH) {
+                    arg = (unsigned char) arg;
+                } else if (spec.len == SAI_LOG_ASYNC_LEN_H) {
+                    arg = (unsigned short) arg;
+                }
+                rc = snprintf (msg + used, msg_len - used, spec_str,
+                               (unsigned long long) arg);
+                break;
+            case 'c':
+                snprintf (spec_str + strlen (spec_str), sizeof (spec_str) - strlen (spec_str),
+                          "c");
+                rc = snprintf (msg + used, msg_len - used, spec_str, (int) arg);
+                break;
+            case 'p':
+                snprintf (spec_str + strlen (spec_str), sizeof (spec_str) - strlen (spec_str),
+                          "p");
+                rc = snprintf (msg + used, msg_len - used, spec_str,
+                               (void *) (uintptr_t) arg);
+                break;
+            case 's':
+                snprintf (spec_str + strlen (spec_str), sizeof (spec_str) - strlen (spec_str),
+                          "s");
+                rc = snprintf (msg + used, msg_len - used, spec_str,
+                               (arg == SAI_LOG_ASYNC_STR_NULL) ? "(null)" :
+                               &rec->str_buf [arg]);
+                break;
+            default:
+                snprintf (spec_str + strlen (spec_str), sizeof (spec_str) - strlen (spec_str),
+                          "%c", spec.conv);
+                memcpy (&dbl, &arg, sizeof (dbl));
+                rc = snprintf (msg + used, msg_len - used, spec_str, dbl);
+                break;
+        }
+
+        if (rc < 0) {
+            break;
+        }
+        used += (size_t) rc;
+        if (used >= msg_len) {
+            used = msg_len - 1;
+        }
+    }
+
+    msg [used] = '\0';
+}
+
+/*
+ * The EV_LOG macros take the location of their expansion, so the location
+ * given is written at the head of the message.
+ */
+void sai_log_emit_at (int module, sai_log_level_t level, const char *file,
+                      const char *func, int line, const char *msg)
+{
+    switch (level) {
+        case SAI_LOG_LEVEL_DEBUG:
+            SAI_LOG_LEVEL_DEBUG (module, sai_switch_id_str_get (), "%s:%s:%d, %s",
+                                 file, func, line, msg);
+            break;
+        case SAI_LOG_LEVEL_INFO:
+            SAI_LOG_LEVEL_INFO (module, sai_switch_id_str_get (), "%s:%s:%d, %s",
+                                file, func, line, msg);
+            break;
+        case SAI_LOG_LEVEL_NOTICE:
+            SAI_LOG_LEVEL_NOTICE (module, sai_switch_id_str_get (), "%s:%s:%d, %s",
+                                  file, func, line, msg);
+            break;
+        case SAI_LOG_LEVEL_WARN:
+            SAI_LOG_LEVEL_WARN (module, sai_switch_id_str_get (), "%s:%s:%d, %s",
+                                file, func, line, msg);
+            break;
+        case SAI_LOG_LEVEL_ERROR:
+            SAI_LOG_LEVEL_ERROR (module, sai_switch_id_str_get (), "%s:%s:%d, %s",
+                                 file, func, line, msg);
+            break;
+        default:
+            SAI_LOG_LEVEL_CRITICAL (module, sai_switch_id_str_get (), "%s:%s:%d, %s",
+                                    file, func, line, msg);
+            break;
+    }
+}
+
+static void sai_log_async_rec_emit (const sai_log_async_rec_t *rec)
+{
+    char msg [SAI_LOG_ASYNC_MSG_LEN];
+
+    sai_log_async_rec_format (rec, msg, sizeof (msg));
+
+    sai_log_emit_at (rec->module, rec->level, rec->file, rec->func,
+                     rec->line, msg);
+}
+
+/* Emit up to a burst of the records of a ring, returns the count emitted */
+static uint_t sai_log_async_ring_drain (sai_log_async_ring_t *ring)
+{
+    uint64_t head = __atomic_load_n (&ring->head, __ATOMIC_ACQUIRE);
+    uint64_t tail = ring->tail;
+    uint_t   count = 0;
+
+    while ((tail != head) && (count < SAI_LOG_ASYNC_BURST)) {
+        sai_log_async_rec_emit (&ring->rec [tail & (SAI_LOG_ASYNC_RING_SIZE - 1)]);
+        tail++;
+        count++;
+        __atomic_store_n (&ring->tail, tail, __ATOMIC_RELEASE);
+    }
+
+    return count;
+}
+
+/* Unlink and free a ring whose thread exited, once drained */
+static void sai_log_async_ring_free (sai_log_async_ring_t *ring)
+{
+    sai_log_async_ring_t **prev = NULL;
+
+    std_mutex_lock (&sai_log_async_lock);
+
+    for (prev = &sai_log_async_ring_list; *prev != NULL; prev = &(*prev)->next) {
+        if (*prev == ring) {
+            *prev = ring->next;
+            break;
+        }
+    }
+    sai_log_async_drops += __atomic_load_n (&ring->drops, __ATOMIC_RELAXED);
+
+    std_mutex_unlock (&sai_log_async_lock);
+
+    free (ring);
+}
+
+static void *sai_log_async_thread_fn (void *param)
+{
+    sai_log_async_ring_t *ring = NULL;
+    sai_log_async_ring_t *next = NULL;
+    uint_t                count = 0;
+    bool                  orphan = false;
+    struct timespec       idle = {0, SAI_LOG_ASYNC_IDLE_NSEC};
+
+    while (true) {
+        count = 0;
+
+        /* Only this thread unlinks rings, the list is walked unlocked */
+        std_mutex_lock (&sai_log_async_lock);
+        ring = sai_log_async_ring_list;
+        std_mutex_unlock (&sai_log_async_lock);
+
+        for (; ring != NULL; ring = next) {
+            next = ring->next;
+            orphan = __atomic_load_n (&ring->orphan, __ATOMIC_ACQUIRE);
+
+            count += sai_log_async_ring_drain (ring);
+
+            if (orphan && (ring->tail == __atomic_load_n (&ring->head, __ATOMIC_ACQUIRE))) {
+                sai_log_async_ring_free (ring);
+            }
+        }
+
+        if (count == 0) {
+            nanosleep (&idle, NULL);
+        }
+    }
+
+    return NULL;
+}
+
+sai_status_t sai_log_async_enable (bool enable)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+
+    std_mutex_lock (&sai_log_async_lock);
+
+    do {
+        if ((! enable) || sai_log_async_thread_started) {
+            break;
+        }
+
+        std_thread_init_struct (&sai_log_async_thread);
+        sai_log_async_thread.name = "sai-log-async";
+        sai_log_async_thread.thread_function = sai_log_async_thread_fn;
+
+        if (std_thread_create (&sai_log_async_thread) != STD_ERR_OK) {
+            rc = SAI_STATUS_FAILURE;
+            break;
+        }
+        sai_log_async_thread_started = true;
+    } while (0);
+
+    if (rc == SAI_STATUS_SUCCESS) {
+        __atomic_store_n (&g_sai_log_async_enabled, enable, __ATOMIC_RELAXED);
+    }
+
+    std_mutex_unlock (&sai_log_async_lock);
+
+    if (rc != SAI_STATUS_SUCCESS) {
+        SAI_SWITCH_LOG_ERR ("Asynchronous log thread creation failed.");
+    }
+
+    return rc;
+}
+
+bool sai_log_async_flush (uint_t timeout_msec)
+{
+    sai_log_async_ring_t *ring = NULL;
+    struct timespec       idle = {0, SAI_LOG_ASYNC_IDLE_NSEC};
+    uint_t                waited_msec = 0;
+    bool                  empty = false;
+
+    while (true) {
+        empty = true;
+
+        std_mutex_lock (&sai_log_async_lock);
+        for (ring = sai_log_async_ring_list; ring != NULL; ring = ring->next) {
+            if (__atomic_load_n (&ring->tail, __ATOMIC_ACQUIRE) !=
+                __atomic_load_n (&ring->head, __ATOMIC_ACQUIRE)) {
+                empty = false;
+                break;
+            }
+        }
+        std_mutex_unlock (&sai_log_async_lock);
+
+        if (empty || (! sai_log_async_thread_started) ||
+            (waited_msec >= timeout_msec)) {
+            return empty;
+        }
+
+        nanosleep (&idle, NULL);
+        waited_msec++;
+    }
+}
+
+uint64_t sai_log_async_drops_get (void)
+{
+    sai_log_async_ring_t *ring = NULL;
+    uint64_t              drops = 0;
+
+    std_mutex_lock (&sai_log_async_lock);
+
+    drops = __atomic_load_n (&sai_log_async_drops, __ATOMIC_RELAXED);
+
+    for (ring = sai_log_async_ring_list; ring != NULL; ring = ring->next) {
+        drops += __atomic_load_n (&ring->drops, __ATOMIC_RELAXED);
+    }
+
+    std_mutex_unlock (&sai_log_async_lock);
+
+    return drops;
+}
@@ -851,6 +851,11 @@ static sai_status_t sai_switch_modules_initialize(void)
         return ret_val;
     }
 
+    if ((ret_val = sai_ipmc_init ()) != SAI_STATUS_SUCCESS) {
+        SAI_SWITCH_LOG_CRIT("SAI IPMC init failed with error %d", ret_val);
+        return ret_val;
+    }
+
     if ((ret_val = sai_acl_init()) != SAI_STATUS_SUCCESS) {
         SAI_SWITCH_LOG_CRIT("SAI ACL init failed with error %d",ret_val);
         return ret_val;
@@ -37,6 +37,7 @@
 #include "sai_oid_utils.h"
 #include "sai_l3_util.h"
 #include "sai_infra_api.h"
+#include "sai_api_stats.h"
 
 
 /*
@@ -58,7 +59,7 @@ static sai_int32_t sai_default_hash_fields [SAI_SWITCH_DEFAULT_HASH_FIELDS_COUNT
 
 void sai_switch_lock (void)
 {
-    std_mutex_lock (&switch_lock);
+    sai_api_stats_mutex_lock (&switch_lock);
 }
 
 void sai_switch_unlock (void)
@@ -45,6 +45,7 @@
 #include "sai_stp_api.h"
 #include "sai_lag_api.h"
 #include "sai_bridge_api.h"
+#include "sai_api_stats.h"
 
 
 static std_thread_create_param_t _thread;
@@ -448,9 +449,12 @@ static sai_status_t sai_l2_remove_fdb_entry(const sai_fdb_entry_t *fdb_entry)
     return ret_val;
 }
 
-static sai_status_t sai_l2_create_fdb_entry(const sai_fdb_entry_t *fdb_entry,
-                uint32_t attr_count,
-                const sai_attribute_t *attr_list)
+/* Validate the create attributes of an FDB entry and fill its node data,
+   with the FDB and bridge locks held */
+static sai_status_t sai_fdb_entry_node_data_fill(const sai_fdb_entry_t *fdb_entry,
+                                                 uint32_t attr_count,
+                                                 const sai_attribute_t *attr_list,
+                                                 sai_fdb_entry_node_t *fdb_entry_node_data)
 {
     unsigned int attr_index = 0;
     bool port_attr_init = false;
@@ -461,6 +465,75 @@ static sai_status_t sai_l2_create_fdb_entry(const sai_fdb_entry_t *fdb_entry,
     bool is_forwarding_action = true;
     sai_status_t ret_val = SAI_STATUS_FAILURE;
     char mac_str[SAI_MAC_STR_LEN] = {0};
+
+    if(!sai_is_valid_bv_id(fdb_entry->bv_id)) {
+        SAI_FDB_LOG_ERR("Invalid vlan/bridge id 0x%"PRIx64"", fdb_entry->bv_id);
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    SAI_FDB_LOG_TRACE("Create FDB entry for MAC:%s vlan:0x%"PRIx64"",
+                      std_mac_to_string(&(fdb_entry->mac_address),
+                      mac_str, sizeof(mac_str)), fdb_entry->bv_id);
+
+    memset(fdb_entry_node_data, 0, sizeof(*fdb_entry_node_data));
+    for(attr_index = 0; attr_index < attr_count; attr_index++) {
+        ret_val = sai_is_valid_fdb_attribute_val(&attr_list[attr_index]);
+        if(ret_val != SAI_STATUS_SUCCESS) {
+            SAI_FDB_LOG_ERR("Invalid attribute for MAC:%s vlan:0x%"PRIx64"",
+                            std_mac_to_string(&(fdb_entry->mac_address),
+                            mac_str, sizeof(mac_str)), fdb_entry->bv_id);
+            return sai_get_indexed_ret_val(ret_val, attr_index);
+        }
+        if(attr_list[attr_index].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID) {
+            fdb_entry_node_data->bridge_port_id = attr_list[attr_index].value.oid;
+            port_attr_init = true;
+        } else if(attr_list[attr_index].id == SAI_FDB_ENTRY_ATTR_TYPE) {
+            fdb_entry_node_data->entry_type = (sai_fdb_entry_type_t)attr_list[attr_index].value.s32;
+            type_attr_init = true;
+        } else if(attr_list[attr_index].id ==SAI_FDB_ENTRY_ATTR_PACKET_ACTION) {
+            fdb_entry_node_data->action = (sai_packet_action_t)attr_list[attr_index].value.s32;
+            action_attr_init = true;
+            is_forwarding_action = sai_fdb_entry_is_forwarding_action(
+                                                           fdb_entry_node_data->action);
+        } else if(attr_list[attr_index].id == SAI_FDB_ENTRY_ATTR_META_DATA) {
+            fdb_entry_node_data->metadata = attr_list[attr_index].value.u32;
+        } else if(attr_list[attr_index].id == SAI_FDB_ENTRY_ATTR_ENDPOINT_IP) {
+            fdb_entry_node_data->end_point_ip = attr_list[attr_index].value.ipaddr;
+            endpoint_ip_attr_init = true;
+        }
+    }
+    if(!(type_attr_init && action_attr_init)) {
+        if(!port_attr_init && is_forwarding_action) {
+            SAI_FDB_LOG_ERR("Mandatory attr missing for MAC:%s vlan:0x%"PRIx64"",
+                            std_mac_to_string(&(fdb_entry->mac_address),
+                                              mac_str, sizeof(mac_str)), fdb_entry->bv_id);
+            return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+        }
+    }
+
+    if(fdb_entry_node_data->bridge_port_id != SAI_NULL_OBJECT_ID) {
+        is_tunnel_bridge_port = sai_is_bridge_port_type_tunnel(fdb_entry_node_data->bridge_port_id);
+        if(is_tunnel_bridge_port && !endpoint_ip_attr_init) {
+            SAI_FDB_LOG_ERR("Endpoint ip address not provided for tunnel "
+                            "bridge port 0x%"PRIx64, fdb_entry_node_data->bridge_port_id);
+            return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+        }
+    }
+
+    if(endpoint_ip_attr_init && !is_tunnel_bridge_port) {
+        SAI_FDB_LOG_ERR("Endpoint ip address attribute is valid only "
+                        "for tunnel bridge port");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_l2_create_fdb_entry(const sai_fdb_entry_t *fdb_entry,
+                uint32_t attr_count,
+                const sai_attribute_t *attr_list)
+{
+    sai_status_t ret_val = SAI_STATUS_FAILURE;
     sai_fdb_entry_node_t fdb_entry_node_data;
 
     STD_ASSERT(fdb_entry != NULL);
@@ -473,68 +546,9 @@ static sai_status_t sai_l2_create_fdb_entry(const sai_fdb_entry_t *fdb_entry,
     sai_fdb_lock();
     sai_bridge_lock();
     do {
-        if(!sai_is_valid_bv_id(fdb_entry->bv_id)) {
-            SAI_FDB_LOG_ERR("Invalid vlan/bridge id 0x%"PRIx64"", fdb_entry->bv_id);
-            ret_val =  SAI_STATUS_INVALID_OBJECT_ID;
-            break;
-        }
-
-        SAI_FDB_LOG_TRACE("Create FDB entry for MAC:%s vlan:0x%"PRIx64"",
-                          std_mac_to_string(&(fdb_entry->mac_address),
-                          mac_str, sizeof(mac_str)), fdb_entry->bv_id);
-
-        memset(&fdb_entry_node_data, 0, sizeof(fdb_entry_node_data));
-        for(attr_index = 0; attr_index < attr_count; attr_index++) {
-            ret_val = sai_is_valid_fdb_attribute_val(&attr_list[attr_index]);
-            if(ret_val != SAI_STATUS_SUCCESS) {
-                ret_val = sai_get_indexed_ret_val(ret_val, attr_index);
-                SAI_FDB_LOG_ERR("Invalid attribute for MAC:%s vlan:0x%"PRIx64"",
-                                std_mac_to_string(&(fdb_entry->mac_address),
-                                mac_str, sizeof(mac_str)), fdb_entry->bv_id);
-                break;
-            }
-            if(attr_list[attr_index].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID) {
-                fdb_entry_node_data.bridge_port_id = attr_list[attr_index].value.oid;
-                port_attr_init = true;
-            } else if(attr_list[attr_index].id == SAI_FDB_ENTRY_ATTR_TYPE) {
-                fdb_entry_node_data.entry_type = (sai_fdb_entry_type_t)attr_list[attr_index].value.s32;
-                type_attr_init = true;
-            } else if(attr_list[attr_index].id ==SAI_FDB_ENTRY_ATTR_PACKET_ACTION) {
-                fdb_entry_node_data.action = (sai_packet_action_t)attr_list[attr_index].value.s32;
-                action_attr_init = true;
-                is_forwarding_action = sai_fdb_entry_is_forwarding_action(
-                                                               fdb_entry_node_data.action);
-            } else if(attr_list[attr_index].id == SAI_FDB_ENTRY_ATTR_META_DATA) {
-                fdb_entry_node_data.metadata = attr_list[attr_index].value.u32;
-            } else if(attr_list[attr_index].id == SAI_FDB_ENTRY_ATTR_ENDPOINT_IP) {
-                fdb_entry_node_data.end_point_ip = attr_list[attr_index].value.ipaddr;
-                endpoint_ip_attr_init = true;
-            }
-        }
-        if(!(type_attr_init && action_attr_init)) {
-            if(!port_attr_init && is_forwarding_action) {
-                SAI_FDB_LOG_ERR("Mandatory attr missing for MAC:%s vlan:0x%"PRIx64"",
-                                std_mac_to_string(&(fdb_entry->mac_address),
-                                                  mac_str, sizeof(mac_str)), fdb_entry->bv_id);
-                ret_val = SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
-                break;
-            }
-        }
-
-        if(fdb_entry_node_data.bridge_port_id != SAI_NULL_OBJECT_ID) {
-            is_tunnel_bridge_port = sai_is_bridge_port_type_tunnel(fdb_entry_node_data.bridge_port_id);
-            if(is_tunnel_bridge_port && !endpoint_ip_attr_init) {
-                SAI_FDB_LOG_ERR("Endpoint ip address not provided for tunnel "
-                                "bridge port 0x%"PRIx64, fdb_entry_node_data.bridge_port_id);
-                ret_val = SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
-                break;
-            }
-        }
-
-        if(endpoint_ip_attr_init && !is_tunnel_bridge_port) {
-            SAI_FDB_LOG_ERR("Endpoint ip address attribute is valid only "
-                            "for tunnel bridge port");
-            ret_val = SAI_STATUS_INVALID_PARAMETER;
+        ret_val = sai_fdb_entry_node_data_fill(fdb_entry, attr_count, attr_list,
+                                               &fdb_entry_node_data);
+        if(ret_val != SAI_STATUS_SUCCESS) {
             break;
         }
 
@@ -571,13 +585,51 @@ static sai_fdb_entry_node_t *sai_fdb_populate_node_from_hardware(
     return sai_get_fdb_entry_node(fdb_entry);;
 }
 
+/* Apply an attribute to the cached node of an FDB entry, keeping its old
+   data in old_node for a rollback, with the FDB and bridge locks held */
+static sai_status_t sai_fdb_entry_node_attr_update(const sai_fdb_entry_t *fdb_entry,
+                                                   const sai_attribute_t *attr,
+                                                   sai_fdb_entry_node_t **fdb_entry_node,
+                                                   sai_fdb_entry_node_t *old_node)
+{
+    sai_status_t ret_val = SAI_STATUS_FAILURE;
+    char mac_str[SAI_MAC_STR_LEN] = {0};
+
+    if(!sai_is_valid_bv_id(fdb_entry->bv_id)) {
+        SAI_FDB_LOG_ERR("Invalid vlan/bridge id 0x%"PRIx64"", fdb_entry->bv_id);
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    SAI_FDB_LOG_TRACE("Set FDB attribute:%d MAC:%s vlan:0x%"PRIx64"",
+            attr->id,std_mac_to_string(&(fdb_entry->mac_address),
+                mac_str, sizeof(mac_str)), fdb_entry->bv_id);
+    ret_val = sai_is_valid_fdb_attribute_val(attr);
+    if(ret_val != SAI_STATUS_SUCCESS) {
+        memset(mac_str, 0, sizeof(mac_str));
+        SAI_FDB_LOG_ERR("Invalid attribute for MAC:%s vlan:0x%"PRIx64"",
+                        std_mac_to_string(&(fdb_entry->mac_address),
+                        mac_str, sizeof(mac_str)), fdb_entry->bv_id);
+        return ret_val;
+    }
+    *fdb_entry_node = sai_get_fdb_entry_node(fdb_entry);
+    if(*fdb_entry_node == NULL) {
+        *fdb_entry_node = sai_fdb_populate_node_from_hardware(fdb_entry);
+        if(*fdb_entry_node == NULL) {
+            return SAI_STATUS_ADDR_NOT_FOUND;
+        }
+    }
+    memcpy(old_node, *fdb_entry_node, sizeof(*old_node));
+    sai_update_fdb_entry_node(*fdb_entry_node, attr);
+
+    return SAI_STATUS_SUCCESS;
+}
+
 static sai_status_t sai_l2_set_fdb_entry_attribute(const sai_fdb_entry_t *fdb_entry,
                      const sai_attribute_t *attr)
 {
     sai_fdb_entry_node_t *fdb_entry_node = NULL;
     sai_fdb_entry_node_t temp_node;
     sai_status_t ret_val = SAI_STATUS_FAILURE;
-    char mac_str[SAI_MAC_STR_LEN] = {0};
 
     STD_ASSERT(fdb_entry != NULL);
     STD_ASSERT(attr != NULL);
@@ -586,33 +638,11 @@ static sai_status_t sai_l2_set_fdb_entry_attribute(const sai_fdb_entry_t *fdb_en
     sai_fdb_lock();
     sai_bridge_lock();
     do {
-        if(!sai_is_valid_bv_id(fdb_entry->bv_id)) {
-            SAI_FDB_LOG_ERR("Invalid vlan/bridge id 0x%"PRIx64"", fdb_entry->bv_id);
-            ret_val =  SAI_STATUS_INVALID_OBJECT_ID;
-            break;
-        }
-
-        SAI_FDB_LOG_TRACE("Set FDB attribute:%d MAC:%s vlan:0x%"PRIx64"",
-                attr->id,std_mac_to_string(&(fdb_entry->mac_address),
-                    mac_str, sizeof(mac_str)), fdb_entry->bv_id);
-        ret_val = sai_is_valid_fdb_attribute_val(attr);
+        ret_val = sai_fdb_entry_node_attr_update(fdb_entry, attr, &fdb_entry_node,
+                                                 &temp_node);
         if(ret_val != SAI_STATUS_SUCCESS) {
-            memset(mac_str, 0, sizeof(mac_str));
-            SAI_FDB_LOG_ERR("Invalid attribute for MAC:%s vlan:0x%"PRIx64"",
-                            std_mac_to_string(&(fdb_entry->mac_address),
-                            mac_str, sizeof(mac_str)), fdb_entry->bv_id);
             break;
         }
-        fdb_entry_node = sai_get_fdb_entry_node(fdb_entry);
-        if(fdb_entry_node == NULL) {
-            fdb_entry_node = sai_fdb_populate_node_from_hardware(fdb_entry);
-            if(fdb_entry_node == NULL) {
-                ret_val = SAI_STATUS_ADDR_NOT_FOUND;
-                break;
-            }
-        }
-        memcpy(&temp_node, fdb_entry_node, sizeof(temp_node));
-        sai_update_fdb_entry_node(fdb_entry_node, attr);
         ret_val = sai_fdb_npu_api_get()->write_fdb_entry_to_hardware(fdb_entry_node);
         if(ret_val != SAI_STATUS_SUCCESS) {
             memcpy(fdb_entry_node, &temp_node, sizeof(temp_node));
@@ -1028,6 +1058,444 @@ sai_status_t sai_l2_get_fdb_table_size(sai_attribute_t *attr)
     return sai_fdb_npu_api_get()->get_fdb_table_size(attr);
 }
 
+static sai_status_t sai_fdb_bulk_params_validate(uint32_t object_count,
+                                                 const sai_fdb_entry_t *fdb_entry,
+                                                 sai_bulk_op_error_mode_t mode,
+                                                 sai_status_t *object_statuses)
+{
+    uint32_t idx;
+
+    if((object_count == 0) || (fdb_entry == NULL) || (object_statuses == NULL)) {
+        SAI_FDB_LOG_ERR("Invalid bulk FDB parameters, count %u", object_count);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if((mode != SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) &&
+       (mode != SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR)) {
+        SAI_FDB_LOG_ERR("Invalid bulk FDB error mode %d", mode);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for(idx = 0; idx < object_count; idx++) {
+        object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_fdb_bulk_status_get(uint32_t object_count,
+                                            const sai_status_t *object_statuses)
+{
+    uint32_t idx;
+
+    for(idx = 0; idx < object_count; idx++) {
+        if(object_statuses[idx] != SAI_STATUS_SUCCESS) {
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+typedef struct _sai_fdb_bulk_key_t {
+    const sai_fdb_entry_t *fdb_entry;
+    uint32_t idx;
+} sai_fdb_bulk_key_t;
+
+static int sai_fdb_bulk_key_compare(const void *first, const void *second)
+{
+    const sai_fdb_bulk_key_t *first_key = (const sai_fdb_bulk_key_t *)first;
+    const sai_fdb_bulk_key_t *second_key = (const sai_fdb_bulk_key_t *)second;
+    int ret;
+
+    if(first_key->fdb_entry->bv_id != second_key->fdb_entry->bv_id) {
+        return (first_key->fdb_entry->bv_id < second_key->fdb_entry->bv_id) ? -1 : 1;
+    }
+    ret = memcmp(first_key->fdb_entry->mac_address, second_key->fdb_entry->mac_address,
+                 sizeof(sai_mac_t));
+    if(ret != 0) {
+        return ret;
+    }
+    /* Equal entries stay in batch order, the first one is kept */
+    return (first_key->idx < second_key->idx) ? -1 : 1;
+}
+
+/* Flag the entries of a batch that repeat an earlier entry of the batch */
+static sai_status_t sai_fdb_bulk_duplicates_get(uint32_t object_count,
+                                                const sai_fdb_entry_t *fdb_entry,
+                                                bool *is_duplicate)
+{
+    sai_fdb_bulk_key_t *key_list = NULL;
+    uint32_t idx;
+
+    key_list = (sai_fdb_bulk_key_t *)calloc(object_count, sizeof(*key_list));
+    if(key_list == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    for(idx = 0; idx < object_count; idx++) {
+        key_list[idx].fdb_entry = &fdb_entry[idx];
+        key_list[idx].idx = idx;
+    }
+
+    qsort(key_list, object_count, sizeof(*key_list), sai_fdb_bulk_key_compare);
+
+    for(idx = 1; idx < object_count; idx++) {
+        is_duplicate[key_list[idx].idx] =
+            ((key_list[idx].fdb_entry->bv_id == key_list[idx - 1].fdb_entry->bv_id) &&
+             (memcmp(key_list[idx].fdb_entry->mac_address,
+                     key_list[idx - 1].fdb_entry->mac_address, sizeof(sai_mac_t)) == 0));
+    }
+
+    free(key_list);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Bulk FDB APIs. The entries are validated and committed under one hold of
+ * the FDB and bridge locks, written to the NPU in one batch and notified in
+ * one changelist pass. If the batch fails the entries are retried one at a
+ * time to get their own status.
+ *
+ * Only the entries that execute if the batch succeeds are passed to it. A
+ * remove or set that repeats an earlier entry of the batch therefore fails
+ * validation, and stops a STOP_ON_ERROR batch there.
+ */
+static sai_status_t sai_l2_fdb_entries_create(uint32_t object_count,
+                                              const sai_fdb_entry_t *fdb_entry,
+                                              const uint32_t *attr_count,
+                                              const sai_attribute_t **attr_list,
+                                              sai_bulk_op_error_mode_t mode,
+                                              sai_status_t *object_statuses)
+{
+    sai_fdb_entry_node_t *node_data_list = NULL;
+    sai_fdb_entry_t *entry_list = NULL;
+    uint32_t *index_list = NULL;
+    uint32_t valid_count = 0;
+    uint32_t idx;
+    sai_status_t ret_val;
+    sai_status_t batch_ret_val = SAI_STATUS_FAILURE;
+    bool stop = false;
+
+    ret_val = sai_fdb_bulk_params_validate(object_count, fdb_entry, mode, object_statuses);
+    if(ret_val != SAI_STATUS_SUCCESS) {
+        return ret_val;
+    }
+
+    if((attr_count == NULL) || (attr_list == NULL)) {
+        SAI_FDB_LOG_ERR("Invalid bulk FDB create attribute list");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    node_data_list = (sai_fdb_entry_node_t *)calloc(object_count, sizeof(*node_data_list));
+    entry_list = (sai_fdb_entry_t *)calloc(object_count, sizeof(*entry_list));
+    index_list = (uint32_t *)calloc(object_count, sizeof(*index_list));
+
+    if((node_data_list == NULL) || (entry_list == NULL) || (index_list == NULL)) {
+        SAI_FDB_LOG_CRIT("No memory for bulk create of %u FDB entries", object_count);
+        free(node_data_list);
+        free(entry_list);
+        free(index_list);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_fdb_lock();
+    sai_bridge_lock();
+
+    for(idx = 0; idx < object_count; idx++) {
+        if((attr_count[idx] == 0) || (attr_list[idx] == NULL)) {
+            ret_val = SAI_STATUS_INVALID_PARAMETER;
+        } else {
+            ret_val = sai_fdb_entry_node_data_fill(&fdb_entry[idx], attr_count[idx],
+                                                   attr_list[idx],
+                                                   &node_data_list[valid_count]);
+        }
+        if(ret_val != SAI_STATUS_SUCCESS) {
+            object_statuses[idx] = ret_val;
+            if(mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                break;
+            }
+            continue;
+        }
+        entry_list[valid_count] = fdb_entry[idx];
+        index_list[valid_count] = idx;
+        valid_count++;
+    }
+
+    if((valid_count != 0) && (sai_fdb_npu_api_get()->create_fdb_entries != NULL)) {
+        batch_ret_val = sai_fdb_npu_api_get()->create_fdb_entries(valid_count, entry_list,
+                                                                  node_data_list);
+    }
+
+    for(idx = 0; idx < valid_count; idx++) {
+        if(stop) {
+            break;
+        }
+        ret_val = batch_ret_val;
+        if(ret_val != SAI_STATUS_SUCCESS) {
+            ret_val = sai_fdb_npu_api_get()->create_fdb_entry(&entry_list[idx],
+                                                              &node_data_list[idx]);
+        }
+        if(ret_val == SAI_STATUS_SUCCESS) {
+            sai_insert_fdb_entry_node(&entry_list[idx], &node_data_list[idx]);
+        } else if(mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+            stop = true;
+        }
+        object_statuses[index_list[idx]] = ret_val;
+    }
+
+    sai_bridge_unlock();
+    sai_fdb_unlock();
+    sai_fdb_wake_notification_thread ();
+
+    free(node_data_list);
+    free(entry_list);
+    free(index_list);
+
+    return sai_fdb_bulk_status_get(object_count, object_statuses);
+}
+
+sai_status_t sai_l2_bulk_create_fdb_entry(uint32_t object_count,
+                                          const sai_fdb_entry_t *fdb_entry,
+                                          const uint32_t *attr_count,
+                                          const sai_attribute_t **attr_list,
+                                          sai_bulk_op_error_mode_t mode,
+                                          sai_status_t *object_statuses)
+{
+    SAI_API_STATS_BULK_CALL (SAI_API_STATS_BULK_FDB_ENTRY_CREATE, object_count,
+                             sai_l2_fdb_entries_create(object_count, fdb_entry,
+                                                       attr_count, attr_list, mode,
+                                                       object_statuses));
+}
+
+static sai_status_t sai_l2_fdb_entries_remove(uint32_t object_count,
+                                              const sai_fdb_entry_t *fdb_entry,
+                                              sai_bulk_op_error_mode_t mode,
+                                              sai_status_t *object_statuses)
+{
+    sai_fdb_entry_node_t **node_list = NULL;
+    sai_fdb_entry_t *entry_list = NULL;
+    uint32_t *index_list = NULL;
+    bool *is_duplicate = NULL;
+    uint32_t valid_count = 0;
+    uint32_t idx;
+    sai_status_t ret_val;
+    sai_status_t batch_ret_val = SAI_STATUS_FAILURE;
+    bool stop = false;
+
+    ret_val = sai_fdb_bulk_params_validate(object_count, fdb_entry, mode, object_statuses);
+    if(ret_val != SAI_STATUS_SUCCESS) {
+        return ret_val;
+    }
+
+    node_list = (sai_fdb_entry_node_t **)calloc(object_count, sizeof(*node_list));
+    entry_list = (sai_fdb_entry_t *)calloc(object_count, sizeof(*entry_list));
+    index_list = (uint32_t *)calloc(object_count, sizeof(*index_list));
+    is_duplicate = (bool *)calloc(object_count, sizeof(*is_duplicate));
+
+    if((node_list == NULL) || (entry_list == NULL) || (index_list == NULL) ||
+       (is_duplicate == NULL) ||
+       (sai_fdb_bulk_duplicates_get(object_count, fdb_entry, is_duplicate) !=
+        SAI_STATUS_SUCCESS)) {
+        SAI_FDB_LOG_CRIT("No memory for bulk remove of %u FDB entries", object_count);
+        free(node_list);
+        free(entry_list);
+        free(index_list);
+        free(is_duplicate);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_fdb_lock();
+    sai_bridge_lock();
+
+    for(idx = 0; idx < object_count; idx++) {
+        ret_val = SAI_STATUS_SUCCESS;
+        if(!sai_is_valid_bv_id(fdb_entry[idx].bv_id)) {
+            SAI_FDB_LOG_ERR("Invalid vlan/bridge id 0x%"PRIx64"", fdb_entry[idx].bv_id);
+            ret_val = SAI_STATUS_INVALID_OBJECT_ID;
+        } else if(is_duplicate[idx]) {
+            /* Removed by the earlier entry of the batch */
+            ret_val = SAI_STATUS_ADDR_NOT_FOUND;
+        } else {
+            node_list[valid_count] = sai_get_fdb_entry_node(&fdb_entry[idx]);
+            if(node_list[valid_count] == NULL) {
+                ret_val = SAI_STATUS_ADDR_NOT_FOUND;
+            }
+        }
+        if(ret_val != SAI_STATUS_SUCCESS) {
+            object_statuses[idx] = ret_val;
+            if(mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                break;
+            }
+            continue;
+        }
+        entry_list[valid_count] = fdb_entry[idx];
+        index_list[valid_count] = idx;
+        valid_count++;
+    }
+
+    if((valid_count != 0) && (sai_fdb_npu_api_get()->flush_fdb_entries != NULL)) {
+        batch_ret_val = sai_fdb_npu_api_get()->flush_fdb_entries(valid_count, entry_list);
+    }
+
+    for(idx = 0; idx < valid_count; idx++) {
+        if(stop) {
+            /* Not executed, put back the row a failed batch may have removed */
+            sai_fdb_npu_api_get()->create_fdb_entry(&entry_list[idx], node_list[idx]);
+            continue;
+        }
+        ret_val = batch_ret_val;
+        if(ret_val != SAI_STATUS_SUCCESS) {
+            ret_val = sai_fdb_npu_api_get()->flush_fdb_entry(&entry_list[idx], false);
+        }
+        if(ret_val == SAI_STATUS_SUCCESS) {
+            sai_remove_fdb_entry_node(node_list[idx]);
+        } else if(mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+            stop = true;
+        }
+        object_statuses[index_list[idx]] = ret_val;
+    }
+
+    sai_bridge_unlock();
+    sai_fdb_unlock();
+    sai_fdb_wake_notification_thread ();
+
+    free(node_list);
+    free(entry_list);
+    free(index_list);
+    free(is_duplicate);
+
+    return sai_fdb_bulk_status_get(object_count, object_statuses);
+}
+
+sai_status_t sai_l2_bulk_remove_fdb_entry(uint32_t object_count,
+                                          const sai_fdb_entry_t *fdb_entry,
+                                          sai_bulk_op_error_mode_t mode,
+                                          sai_status_t *object_statuses)
+{
+    SAI_API_STATS_BULK_CALL (SAI_API_STATS_BULK_FDB_ENTRY_REMOVE, object_count,
+                             sai_l2_fdb_entries_remove(object_count, fdb_entry, mode,
+                                                       object_statuses));
+}
+
+static sai_status_t sai_l2_fdb_entries_attribute_set(uint32_t object_count,
+                                                     const sai_fdb_entry_t *fdb_entry,
+                                                     const sai_attribute_t *attr_list,
+                                                     sai_bulk_op_error_mode_t mode,
+                                                     sai_status_t *object_statuses)
+{
+    sai_fdb_entry_node_t **node_list = NULL;
+    sai_fdb_entry_node_t *old_node_list = NULL;
+    uint32_t *index_list = NULL;
+    bool *is_duplicate = NULL;
+    uint32_t valid_count = 0;
+    uint32_t idx;
+    sai_status_t ret_val;
+    sai_status_t batch_ret_val = SAI_STATUS_FAILURE;
+    bool stop = false;
+
+    ret_val = sai_fdb_bulk_params_validate(object_count, fdb_entry, mode, object_statuses);
+    if(ret_val != SAI_STATUS_SUCCESS) {
+        return ret_val;
+    }
+
+    if(attr_list == NULL) {
+        SAI_FDB_LOG_ERR("Invalid bulk FDB set attribute list");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    node_list = (sai_fdb_entry_node_t **)calloc(object_count, sizeof(*node_list));
+    old_node_list = (sai_fdb_entry_node_t *)calloc(object_count, sizeof(*old_node_list));
+    index_list = (uint32_t *)calloc(object_count, sizeof(*index_list));
+    is_duplicate = (bool *)calloc(object_count, sizeof(*is_duplicate));
+
+    if((node_list == NULL) || (old_node_list == NULL) || (index_list == NULL) ||
+       (is_duplicate == NULL) ||
+       (sai_fdb_bulk_duplicates_get(object_count, fdb_entry, is_duplicate) !=
+        SAI_STATUS_SUCCESS)) {
+        SAI_FDB_LOG_CRIT("No memory for bulk set of %u FDB entries", object_count);
+        free(node_list);
+        free(old_node_list);
+        free(index_list);
+        free(is_duplicate);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_fdb_lock();
+    sai_bridge_lock();
+
+    for(idx = 0; idx < object_count; idx++) {
+        if(is_duplicate[idx]) {
+            /* The cache update of each entry must be undone on its own */
+            SAI_FDB_LOG_ERR("FDB entry %u repeats an earlier entry of the batch", idx);
+            ret_val = SAI_STATUS_INVALID_PARAMETER;
+        } else {
+            ret_val = sai_fdb_entry_node_attr_update(&fdb_entry[idx], &attr_list[idx],
+                                                     &node_list[valid_count],
+                                                     &old_node_list[valid_count]);
+        }
+        if(ret_val != SAI_STATUS_SUCCESS) {
+            object_statuses[idx] = ret_val;
+            if(mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+                break;
+            }
+            continue;
+        }
+        index_list[valid_count] = idx;
+        valid_count++;
+    }
+
+    if((valid_count != 0) &&
+       (sai_fdb_npu_api_get()->write_fdb_entries_to_hardware != NULL)) {
+        batch_ret_val = sai_fdb_npu_api_get()->write_fdb_entries_to_hardware(valid_count,
+                                                                             node_list);
+    }
+
+    for(idx = 0; idx < valid_count; idx++) {
+        ret_val = SAI_STATUS_NOT_EXECUTED;
+        if(!stop) {
+            ret_val = batch_ret_val;
+            if(ret_val != SAI_STATUS_SUCCESS) {
+                ret_val = sai_fdb_npu_api_get()->write_fdb_entry_to_hardware(node_list[idx]);
+            }
+            if((ret_val != SAI_STATUS_SUCCESS) &&
+               (mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR)) {
+                stop = true;
+            }
+            object_statuses[index_list[idx]] = ret_val;
+        }
+        if(ret_val != SAI_STATUS_SUCCESS) {
+            /* Undo the cache update, and the row a failed batch may have written */
+            memcpy(node_list[idx], &old_node_list[idx], sizeof(old_node_list[idx]));
+            sai_fdb_npu_api_get()->write_fdb_entry_to_hardware(node_list[idx]);
+        }
+    }
+
+    sai_bridge_unlock();
+    sai_fdb_unlock();
+    sai_fdb_wake_notification_thread ();
+
+    free(node_list);
+    free(old_node_list);
+    free(index_list);
+    free(is_duplicate);
+
+    return sai_fdb_bulk_status_get(object_count, object_statuses);
+}
+
+sai_status_t sai_l2_bulk_set_fdb_entry_attribute(uint32_t object_count,
+                                                 const sai_fdb_entry_t *fdb_entry,
+                                                 const sai_attribute_t *attr_list,
+                                                 sai_bulk_op_error_mode_t mode,
+                                                 sai_status_t *object_statuses)
+{
+    SAI_API_STATS_BULK_CALL (SAI_API_STATS_BULK_FDB_ENTRY_SET, object_count,
+                             sai_l2_fdb_entries_attribute_set(object_count, fdb_entry,
+                                                              attr_list, mode,
+                                                              object_statuses));
+}
+
 static sai_fdb_api_t sai_fdb_method_table =
 {
     sai_l2_create_fdb_entry,
@@ -34,6 +34,9 @@
 #include "std_mac_utils.h"
 #include "sai_l3_util.h"
 
+/* FDB entries walked per hold of the FDB lock by the FDB entry dumps */
+#define SAI_FDB_DBG_DUMP_CHUNK (256)
+
 static inline void print_fdb_header(void)
 {
     SAI_DEBUG("%-20s %-20s %-20s %-20s %-5s %-5s %-5s","MAC","VLAN/BRIDGE","End point IP",
@@ -47,47 +50,119 @@ static inline void print_fdb_notification_header(void)
     SAI_DEBUG("------------------------------------------------------------");
 }
 
-void sai_dump_all_fdb_entry_nodes (void)
+static inline void print_fdb_entry(const sai_fdb_entry_node_t *fdb_entry_node)
+{
+    char mac_str[SAI_MAC_STR_LEN] = {0};
+    char ip_addr_str[SAI_FIB_MAX_BUFSZ] = {0};
+
+    SAI_DEBUG("%-20s 0x%-20"PRIx64" %-20s 0x%-20"PRIx64" %-5d %-5d %-5d",
+              std_mac_to_string((const sai_mac_t*)&(fdb_entry_node->fdb_key.mac_address),
+              mac_str, sizeof(mac_str)), fdb_entry_node->fdb_key.bv_id,
+              sai_ip_addr_to_str(&fdb_entry_node->end_point_ip, ip_addr_str, SAI_FIB_MAX_BUFSZ),
+              fdb_entry_node->bridge_port_id,fdb_entry_node->entry_type,
+              fdb_entry_node->action,fdb_entry_node->is_pending_entry);
+}
+
+/*
+ * Walks the FDB entries in chunks under short holds of the FDB lock, each
+ * hold resuming from the key of the last entry walked, and prints the
+ * entries copied in a chunk with the lock released so learning and FDB
+ * programming are not held off for the whole dump. Only the entries of
+ * bv_id and bridge_port_id are dumped when they are set, and only count
+ * of them from the start-th one when count is set. Returns the number of
+ * entries matching.
+ */
+static uint_t sai_fdb_dump_entry_nodes (sai_object_id_t bridge_port_id,
+                                        sai_object_id_t bv_id, uint_t start,
+                                        uint_t count, bool is_print)
 {
     sai_fdb_entry_node_t *fdb_entry_node = NULL;
+    sai_fdb_entry_node_t *chunk = NULL;
     sai_fdb_entry_key_t   fdb_key;
-    char                  mac_str[SAI_MAC_STR_LEN] = {0};
-    char                  ip_addr_str[SAI_FIB_MAX_BUFSZ] = {0};
+    uint_t                chunk_len = 0;
+    uint_t                walked = 0;
+    uint_t                matched = 0;
+    uint_t                dumped = 0;
+    uint_t                idx = 0;
+    bool                  is_end = false;
+
+    if(is_print) {
+        chunk = (sai_fdb_entry_node_t *)calloc(SAI_FDB_DBG_DUMP_CHUNK,
+                                               sizeof(sai_fdb_entry_node_t));
+        if(chunk == NULL) {
+            SAI_DEBUG("Failed to allocate the FDB dump buffer");
+            return 0;
+        }
+        print_fdb_header();
+    }
 
     memset(&fdb_key, 0, sizeof(fdb_key));
+    fdb_key.bv_id = bv_id;
 
-    fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
+    while(!is_end) {
+        chunk_len = 0;
+        walked = 0;
 
-    print_fdb_header();
-    while(fdb_entry_node != NULL) {
-        memcpy(&fdb_key,&(fdb_entry_node->fdb_key),
-               sizeof(sai_fdb_entry_key_t));
-        SAI_DEBUG("%-20s 0x%-20"PRIx64" %-20s 0x%-20"PRIx64" %-5d %-5d %-5d",
-                  std_mac_to_string((const sai_mac_t*)&(fdb_entry_node->fdb_key.mac_address),
-                  mac_str, sizeof(mac_str)), fdb_entry_node->fdb_key.bv_id,
-                  sai_ip_addr_to_str(&fdb_entry_node->end_point_ip, ip_addr_str, SAI_FIB_MAX_BUFSZ),
-                  fdb_entry_node->bridge_port_id,fdb_entry_node->entry_type,
-                  fdb_entry_node->action,fdb_entry_node->is_pending_entry);
+        sai_fdb_lock();
         fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
+
+        while((fdb_entry_node != NULL) && (walked < SAI_FDB_DBG_DUMP_CHUNK)) {
+            memcpy(&fdb_key,&(fdb_entry_node->fdb_key),
+                   sizeof(sai_fdb_entry_key_t));
+            walked++;
+
+            if((bv_id != SAI_NULL_OBJECT_ID) && (fdb_key.bv_id != bv_id)) {
+                fdb_entry_node = NULL;
+                break;
+            }
+            if((bridge_port_id == SAI_NULL_OBJECT_ID) ||
+               (fdb_entry_node->bridge_port_id == bridge_port_id)) {
+                if(is_print && (matched >= start)) {
+                    memcpy(&chunk[chunk_len], fdb_entry_node,
+                           sizeof(sai_fdb_entry_node_t));
+                    chunk_len++;
+                }
+                matched++;
+            }
+            if((count != 0) && ((dumped + chunk_len) >= count)) {
+                is_end = true;
+                break;
+            }
+            fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
+        }
+
+        if(fdb_entry_node == NULL) {
+            is_end = true;
+        }
+        sai_fdb_unlock();
+
+        for(idx = 0; idx < chunk_len; idx++) {
+            print_fdb_entry(&chunk[idx]);
+        }
+        dumped += chunk_len;
     }
+
+    free(chunk);
+    return matched;
 }
 
-void sai_dump_all_fdb_entry_count (void)
+void sai_dump_all_fdb_entry_nodes (void)
 {
-    sai_fdb_entry_node_t *fdb_entry_node = NULL;
-    sai_fdb_entry_key_t fdb_key;
-    uint_t count = 0;
+    sai_fdb_dump_entry_nodes(SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID, 0, 0, true);
+}
 
-    memset(&fdb_key, 0, sizeof(fdb_key));
+void sai_dump_fdb_entry_nodes_page (uint_t start, uint_t count)
+{
+    sai_fdb_dump_entry_nodes(SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID, start,
+                             count, true);
+}
 
-    fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
+void sai_dump_all_fdb_entry_count (void)
+{
+    uint_t count = 0;
 
-    while(fdb_entry_node != NULL) {
-        memcpy(&fdb_key,&(fdb_entry_node->fdb_key),
-               sizeof(sai_fdb_entry_key_t));
-        fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
-        count++;
-    }
+    count = sai_fdb_dump_entry_nodes(SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID,
+                                     0, 0, false);
     SAI_DEBUG("Number of MAC entries: %d", count);
 }
 void sai_dump_all_fdb_registered_nodes (void)
@@ -139,86 +214,16 @@ void sai_dump_pending_fdb_to_l3_notifs (void)
 
 void sai_dump_fdb_entry_nodes_per_bridge_port (sai_object_id_t bridge_port_id)
 {
-    sai_fdb_entry_node_t *fdb_entry_node = NULL;
-    sai_fdb_entry_key_t   fdb_key;
-    char                  mac_str[SAI_MAC_STR_LEN] = {0};
-    char                  ip_addr_str[SAI_FIB_MAX_BUFSZ] = {0};
-
-    memset(&fdb_key, 0, sizeof(fdb_key));
-    fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
-    print_fdb_header();
-    while(fdb_entry_node != NULL) {
-        memcpy(&fdb_key,&(fdb_entry_node->fdb_key),
-               sizeof(sai_fdb_entry_key_t));
-        if(fdb_entry_node->bridge_port_id == bridge_port_id){
-            SAI_DEBUG("%-20s 0x%-20"PRIx64" %-20s 0x%-20"PRIx64" %-5d %-5d %-5d",
-                      std_mac_to_string((const sai_mac_t*)&(fdb_entry_node->fdb_key.mac_address),
-                      mac_str, sizeof(mac_str)), fdb_entry_node->fdb_key.bv_id,
-                      sai_ip_addr_to_str(&fdb_entry_node->end_point_ip, ip_addr_str,
-                      SAI_FIB_MAX_BUFSZ), fdb_entry_node->bridge_port_id,fdb_entry_node->entry_type,
-                      fdb_entry_node->action,fdb_entry_node->is_pending_entry);
-
-        }
-        fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
-    }
+    sai_fdb_dump_entry_nodes(bridge_port_id, SAI_NULL_OBJECT_ID, 0, 0, true);
 }
 
 void sai_dump_fdb_entry_nodes_per_vlan (sai_object_id_t bv_id)
 {
-    sai_fdb_entry_node_t *fdb_entry_node = NULL;
-    sai_fdb_entry_key_t   fdb_key;
-    char                  mac_str[SAI_MAC_STR_LEN] = {0};
-    char                  ip_addr_str[SAI_FIB_MAX_BUFSZ] = {0};
-
-    memset(&fdb_key, 0, sizeof(fdb_key));
-    fdb_key.bv_id = bv_id;
-
-    fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
-
-    print_fdb_header();
-    while(fdb_entry_node != NULL) {
-        memcpy(&fdb_key,&(fdb_entry_node->fdb_key),
-              sizeof(sai_fdb_entry_key_t));
-        if(fdb_key.bv_id != bv_id){
-            break;
-        }
-        SAI_DEBUG("%-20s 0x%-20"PRIx64" %-20s 0x%-20"PRIx64" %-5d %-5d %-5d",
-                  std_mac_to_string((const sai_mac_t*)&(fdb_entry_node->fdb_key.mac_address),
-                  mac_str, sizeof(mac_str)), fdb_entry_node->fdb_key.bv_id,
-                  sai_ip_addr_to_str(&fdb_entry_node->end_point_ip,ip_addr_str,
-                  SAI_FIB_MAX_BUFSZ), fdb_entry_node->bridge_port_id,fdb_entry_node->entry_type,
-                  fdb_entry_node->action,fdb_entry_node->is_pending_entry);
-        fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
-    }
+    sai_fdb_dump_entry_nodes(SAI_NULL_OBJECT_ID, bv_id, 0, 0, true);
 }
 
 void sai_dump_fdb_entry_nodes_per_bridge_port_vlan (sai_object_id_t bridge_port_id,
                                                     sai_object_id_t bv_id)
 {
-    sai_fdb_entry_node_t *fdb_entry_node = NULL;
-    sai_fdb_entry_key_t   fdb_key;
-    char                  mac_str[SAI_MAC_STR_LEN] = {0};
-    char                  ip_addr_str[SAI_FIB_MAX_BUFSZ] = {0};
-
-    memset(&fdb_key, 0, sizeof(fdb_key));
-    fdb_key.bv_id = bv_id;
-
-    fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
-    print_fdb_header();
-    while(fdb_entry_node != NULL) {
-        memcpy(&fdb_key,&(fdb_entry_node->fdb_key),
-               sizeof(sai_fdb_entry_key_t));
-        if(fdb_key.bv_id != bv_id){
-            break;
-        }
-        if((fdb_entry_node->bridge_port_id == bridge_port_id)){
-            SAI_DEBUG("%-20s 0x%-20"PRIx64" %-20s 0x%-20"PRIx64" %-5d %-5d %-5d",
-                      std_mac_to_string((const sai_mac_t*)&(fdb_entry_node->fdb_key.mac_address),
-                      mac_str, sizeof(mac_str)), fdb_entry_node->fdb_key.bv_id,
-                      sai_ip_addr_to_str(&fdb_entry_node->end_point_ip, ip_addr_str,
-                      SAI_FIB_MAX_BUFSZ), fdb_entry_node->bridge_port_id,fdb_entry_node->entry_type,
-                      fdb_entry_node->action,fdb_entry_node->is_pending_entry);
-        }
-        fdb_entry_node = sai_get_next_fdb_entry_node (&fdb_key);
-    }
+    sai_fdb_dump_entry_nodes(bridge_port_id, bv_id, 0, 0, true);
 }
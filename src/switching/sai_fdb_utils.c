@@ -39,6 +39,7 @@
 #include "sai_npu_fdb.h"
 #include "sai_bridge_api.h"
 #include "sai_l3_util.h"
+#include "sai_api_stats.h"
 
 
 static sai_fdb_global_data_t sai_fdb_global_cache;
@@ -48,7 +49,7 @@ static sai_npu_flush_fdb_entry_fn sai_npu_flush_fdb_entry = NULL;
 
 void sai_fdb_lock(void)
 {
-    std_mutex_lock(&fdb_lock);
+    sai_api_stats_mutex_lock(&fdb_lock);
 }
 
 void sai_fdb_unlock(void)
@@ -32,6 +32,7 @@
 #include "sai_gen_utils.h"
 #include "sai_lag_api.h"
 #include "sai_oid_utils.h"
+#include "sai_api_stats.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -42,7 +43,7 @@ static std_mutex_lock_create_static_init_fast(lag_lock);
 
 void sai_lag_lock(void)
 {
-    std_mutex_lock(&lag_lock);
+    sai_api_stats_mutex_lock(&lag_lock);
 }
 
 void sai_lag_unlock(void)
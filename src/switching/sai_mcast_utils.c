@@ -77,6 +77,16 @@ dn_sai_mcast_entry_node_t * sai_find_mcast_entry(dn_sai_mcast_entry_node_t *entr
     return mcast_entry_node;
 }
 
+dn_sai_mcast_entry_node_t * sai_get_next_mcast_entry(const dn_sai_mcast_entry_key_t *mcast_key)
+{
+    STD_ASSERT(mcast_key != NULL);
+
+    return (dn_sai_mcast_entry_node_t *)std_radix_getnext(
+            sai_mcast_global_cache.sai_global_mcast_tree,
+            (u_char *)mcast_key,
+            SAI_MCAST_ENTRY_KEY_SIZE);
+}
+
 sai_status_t sai_insert_mcast_entry_node(dn_sai_mcast_entry_node_t *mcast_entry_node)
 {
     dn_sai_mcast_entry_node_t *tmp_node = NULL;
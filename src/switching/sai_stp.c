@@ -621,14 +621,83 @@ sai_status_t sai_stp_port_create(sai_object_id_t *stp_port_id, sai_object_id_t s
     sai_bridge_port_to_stp_port_map_insert(bridge_port_id, *stp_port_id);
     return SAI_STATUS_SUCCESS;
 }
-sai_status_t sai_api_stp_port_create(sai_object_id_t *stp_port_id,  sai_object_id_t switch_id,
-                                     uint32_t attr_count,  const sai_attribute_t *attr_list)
+/* Validate the attributes of an STP port create, run with the locks held */
+static sai_status_t sai_stp_port_attr_list_parse(uint32_t attr_count,
+                                                 const sai_attribute_t *attr_list,
+                                                 sai_object_id_t *stp_inst_id,
+                                                 sai_object_id_t *bridge_port_id,
+                                                 sai_stp_port_state_t *port_state)
 {
     sai_status_t         ret_val = SAI_STATUS_SUCCESS;
     bool                 stp_id_attr_present = false;
     bool                 bridge_port_present = false;
     bool                 port_state_attr_present = false;
     uint32_t             attr_idx = 0;
+
+    for(attr_idx = 0; attr_idx < attr_count; attr_idx++) {
+        switch(attr_list[attr_idx].id) {
+            case SAI_STP_PORT_ATTR_STP:
+                *stp_inst_id = attr_list[attr_idx].value.oid;
+
+                if(!sai_is_obj_id_stp_instance(*stp_inst_id)) {
+                    SAI_STP_LOG_ERR ("0x%"PRIx64" is not a valid STP obj", *stp_inst_id);
+                    ret_val =  sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTR_VALUE_0,
+                                                       attr_idx);
+                }
+
+                stp_id_attr_present = true;
+                break;
+
+            case SAI_STP_PORT_ATTR_BRIDGE_PORT:
+                *bridge_port_id = attr_list[attr_idx].value.oid;
+
+                if(!sai_stp_port_is_valid_bridge_port(*bridge_port_id)){
+                    SAI_STP_LOG_ERR("STP invalid bridge port UOID type 0x%"PRIx64"",
+                            *bridge_port_id);
+                    ret_val = sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTR_VALUE_0,
+                                                      attr_idx);
+                    break;
+                }
+                bridge_port_present = true;
+                break;
+
+            case SAI_STP_PORT_ATTR_STATE:
+                *port_state = attr_list[attr_idx].value.s32;
+
+                if(!sai_stp_port_state_valid(*port_state)) {
+                    SAI_STP_LOG_ERR ("STP invalid port state");
+                    ret_val = sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTR_VALUE_0,
+                                                      attr_idx);
+                    break;
+                }
+
+                port_state_attr_present = true;
+                break;
+
+            default:
+                SAI_STP_LOG_ERR("STP port create unknown attribute");
+                ret_val = sai_get_indexed_ret_val(SAI_STATUS_UNKNOWN_ATTRIBUTE_0, attr_idx);
+        }
+        if(ret_val != SAI_STATUS_SUCCESS) {
+            return ret_val;
+        }
+    }
+
+    if(!(stp_id_attr_present) || !(bridge_port_present) ||
+            !(port_state_attr_present)) {
+        SAI_STP_LOG_ERR("STP port create mandatory attribute missing for"
+                        " STP Inst 0x%"PRIx64" Bridge Port 0x%"PRIx64"",
+                        *stp_inst_id, *bridge_port_id);
+        return SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_api_stp_port_create(sai_object_id_t *stp_port_id,  sai_object_id_t switch_id,
+                                     uint32_t attr_count,  const sai_attribute_t *attr_list)
+{
+    sai_status_t         ret_val = SAI_STATUS_SUCCESS;
     sai_object_id_t      stp_inst_id = SAI_NULL_OBJECT_ID;
     sai_object_id_t      bridge_port_id = SAI_NULL_OBJECT_ID;
     sai_stp_port_state_t port_state = SAI_STP_PORT_STATE_BLOCKING;
@@ -652,64 +721,11 @@ sai_status_t sai_api_stp_port_create(sai_object_id_t *stp_port_id,  sai_object_i
     sai_stp_take_module_lock(bridge_port_id);
 
     do {
-        for(attr_idx = 0; attr_idx < attr_count; attr_idx++) {
-            switch(attr_list[attr_idx].id) {
-                case SAI_STP_PORT_ATTR_STP:
-                    stp_inst_id = attr_list[attr_idx].value.oid;
-
-                    if(!sai_is_obj_id_stp_instance(stp_inst_id)) {
-                        SAI_STP_LOG_ERR ("0x%"PRIx64" is not a valid STP obj", stp_inst_id);
-                        ret_val =  sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTR_VALUE_0,
-                                                           attr_idx);
-                    }
-
-                    stp_id_attr_present = true;
-                    break;
-
-                case SAI_STP_PORT_ATTR_BRIDGE_PORT:
-                    if(!sai_stp_port_is_valid_bridge_port(bridge_port_id)){
-                        SAI_STP_LOG_ERR("STP invalid bridge port UOID type 0x%"PRIx64"",
-                                bridge_port_id);
-                        ret_val = sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTR_VALUE_0,
-                                                          attr_idx);
-                        break;
-                    }
-                    bridge_port_present = true;
-                    break;
-
-                case SAI_STP_PORT_ATTR_STATE:
-                    port_state = attr_list[attr_idx].value.s32;
-
-                    if(!sai_stp_port_state_valid(port_state)) {
-                        SAI_STP_LOG_ERR ("STP invalid port state");
-                        ret_val = sai_get_indexed_ret_val(SAI_STATUS_INVALID_ATTR_VALUE_0,
-                                                          attr_idx);
-                        break;
-                    }
-
-                    port_state_attr_present = true;
-                    break;
-
-                default:
-                    SAI_STP_LOG_ERR("STP port create unknown attribute");
-                    ret_val = sai_get_indexed_ret_val(SAI_STATUS_UNKNOWN_ATTRIBUTE_0, attr_idx);
-            }
-            if(ret_val != SAI_STATUS_SUCCESS) {
-                break;
-            }
-        }
-
+        ret_val = sai_stp_port_attr_list_parse(attr_count, attr_list, &stp_inst_id,
+                                               &bridge_port_id, &port_state);
         if(ret_val != SAI_STATUS_SUCCESS) {
             break;
         }
-        if(!(stp_id_attr_present) || !(bridge_port_present) ||
-                !(port_state_attr_present)) {
-            SAI_STP_LOG_ERR("STP port create mandatory attribute missing for"
-                            " STP Inst 0x%"PRIx64" Bridge Port 0x%"PRIx64"",
-                            stp_inst_id, bridge_port_id);
-            ret_val  = SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
-            break;
-        }
 
         ret_val = sai_stp_port_create(stp_port_id, stp_inst_id, bridge_port_id, port_state);
         if(ret_val != SAI_STATUS_SUCCESS) {
@@ -768,7 +784,7 @@ sai_status_t sai_stp_port_remove(sai_object_id_t stp_port_id)
             break;
         }
         sai_stp_port_info_remove(stp_port_id);
-        sai_bridge_port_to_stp_port_map_remove(p_stp_port_info->bridge_port_id, stp_port_id);
+        sai_bridge_port_to_stp_port_map_remove(bridge_port_id, stp_port_id);
 
     } while(0);
 
@@ -921,6 +937,112 @@ sai_status_t sai_stp_port_attribute_get(sai_object_id_t stp_port_id,
 
 }
 
+/*
+ * The bridge ports of a batch may be ports or LAGs, take the LAG lock for
+ * the whole batch rather than per bridge port.
+ */
+static void sai_stp_take_bulk_module_lock(void)
+{
+    sai_bridge_lock();
+    sai_lag_lock();
+}
+
+static void sai_stp_give_bulk_module_lock(void)
+{
+    sai_lag_unlock();
+    sai_bridge_unlock();
+}
+
+/* NPU states of the entries of a bulk call, in object order */
+typedef struct _sai_stp_port_bulk_npu_t {
+    uint32_t              count;
+    uint32_t             *object_idx;
+    sai_object_id_t      *stp_inst_list;
+    sai_object_id_t      *bridge_port_list;
+    sai_stp_port_state_t *state_list;
+    sai_stp_port_state_t *prev_state_list;
+    sai_status_t         *status_list;
+} sai_stp_port_bulk_npu_t;
+
+static void sai_stp_port_bulk_npu_free(sai_stp_port_bulk_npu_t *p_npu)
+{
+    free(p_npu->object_idx);
+    free(p_npu->stp_inst_list);
+    free(p_npu->bridge_port_list);
+    free(p_npu->state_list);
+    free(p_npu->prev_state_list);
+    free(p_npu->status_list);
+}
+
+static sai_status_t sai_stp_port_bulk_npu_alloc(sai_stp_port_bulk_npu_t *p_npu,
+                                                uint32_t object_count)
+{
+    memset(p_npu, 0, sizeof(*p_npu));
+
+    p_npu->object_idx = calloc(object_count, sizeof(uint32_t));
+    p_npu->stp_inst_list = calloc(object_count, sizeof(sai_object_id_t));
+    p_npu->bridge_port_list = calloc(object_count, sizeof(sai_object_id_t));
+    p_npu->state_list = calloc(object_count, sizeof(sai_stp_port_state_t));
+    p_npu->prev_state_list = calloc(object_count, sizeof(sai_stp_port_state_t));
+    p_npu->status_list = calloc(object_count, sizeof(sai_status_t));
+
+    if((p_npu->object_idx == NULL) || (p_npu->stp_inst_list == NULL) ||
+       (p_npu->bridge_port_list == NULL) || (p_npu->state_list == NULL) ||
+       (p_npu->prev_state_list == NULL) || (p_npu->status_list == NULL)) {
+        sai_stp_port_bulk_npu_free(p_npu);
+        return SAI_STATUS_NO_MEMORY;
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_stp_port_bulk_npu_add(sai_stp_port_bulk_npu_t *p_npu, uint32_t object_idx,
+                                      sai_object_id_t stp_inst_id,
+                                      sai_object_id_t bridge_port_id,
+                                      sai_stp_port_state_t port_state,
+                                      sai_stp_port_state_t prev_port_state)
+{
+    p_npu->object_idx[p_npu->count] = object_idx;
+    p_npu->stp_inst_list[p_npu->count] = stp_inst_id;
+    p_npu->bridge_port_list[p_npu->count] = bridge_port_id;
+    p_npu->state_list[p_npu->count] = port_state;
+    p_npu->prev_state_list[p_npu->count] = prev_port_state;
+    p_npu->count++;
+}
+
+/*
+ * In stop on error mode the entries past the first NPU failure were applied
+ * by the same batch, put their previous state back in one more NPU call.
+ */
+static void sai_stp_port_bulk_npu_rollback(sai_stp_port_bulk_npu_t *p_npu, uint32_t first)
+{
+    if(first >= p_npu->count) {
+        return;
+    }
+
+    if(sai_stp_npu_api_get()->port_state_bulk_set(p_npu->count - first,
+                                                   &p_npu->stp_inst_list[first],
+                                                   &p_npu->bridge_port_list[first],
+                                                   &p_npu->prev_state_list[first],
+                                                   &p_npu->status_list[first])
+       != SAI_STATUS_SUCCESS) {
+        SAI_STP_LOG_ERR("STP port state rollback of %u bulk entries failed",
+                        p_npu->count - first);
+    }
+}
+
+static sai_status_t sai_stp_port_bulk_status_get(uint32_t object_count,
+                                                 const sai_status_t *object_statuses)
+{
+    uint32_t idx;
+
+    for(idx = 0; idx < object_count; idx++) {
+        if(object_statuses[idx] != SAI_STATUS_SUCCESS) {
+            return SAI_STATUS_FAILURE;
+        }
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
 sai_status_t sai_stp_port_bulk_create(
         sai_object_id_t switch_id,
         uint32_t object_count,
@@ -930,7 +1052,115 @@ sai_status_t sai_stp_port_bulk_create(
         sai_object_id_t *object_id,
         sai_status_t *object_statuses)
 {
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    sai_status_t            ret_val = SAI_STATUS_SUCCESS;
+    sai_stp_port_bulk_npu_t npu;
+    sai_object_id_t         stp_inst_id;
+    sai_object_id_t         bridge_port_id;
+    sai_stp_port_state_t    port_state;
+    bool                    stop_on_error = (type == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR);
+    bool                    stopped = false;
+    uint32_t                stop_idx = 0;
+    uint32_t                idx;
+    uint32_t                npu_idx;
+
+    if((object_count == 0) || (attr_count == NULL) || (attrs == NULL) ||
+       (object_id == NULL) || (object_statuses == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for(idx = 0; idx < object_count; idx++) {
+        object_id[idx] = SAI_NULL_OBJECT_ID;
+        object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    if(sai_stp_port_bulk_npu_alloc(&npu, object_count) != SAI_STATUS_SUCCESS) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_stp_lock();
+    sai_stp_take_bulk_module_lock();
+
+    /* Cache all the STP ports first, then set their states in one NPU call */
+    for(idx = 0; idx < object_count; idx++) {
+        stp_inst_id = SAI_NULL_OBJECT_ID;
+        bridge_port_id = SAI_NULL_OBJECT_ID;
+        port_state = SAI_STP_PORT_STATE_BLOCKING;
+
+        if((attr_count[idx] == 0) || (attrs[idx] == NULL)) {
+            ret_val = SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING;
+        } else {
+            ret_val = sai_stp_port_attr_list_parse(attr_count[idx], attrs[idx], &stp_inst_id,
+                                                   &bridge_port_id, &port_state);
+        }
+
+        if(ret_val == SAI_STATUS_SUCCESS) {
+            object_id[idx] = sai_stp_port_id_create();
+            ret_val = sai_stp_port_info_create(object_id[idx], stp_inst_id, bridge_port_id,
+                                               port_state);
+        }
+
+        if(ret_val != SAI_STATUS_SUCCESS) {
+            SAI_STP_LOG_ERR("STP port bulk create failed for entry %u, rc %d", idx, ret_val);
+            object_id[idx] = SAI_NULL_OBJECT_ID;
+            object_statuses[idx] = ret_val;
+
+            if(stop_on_error) {
+                break;
+            }
+            continue;
+        }
+
+        sai_stp_port_bulk_npu_add(&npu, idx, stp_inst_id, bridge_port_id, port_state,
+                                  SAI_STP_PORT_STATE_BLOCKING);
+    }
+
+    if(npu.count > 0) {
+        sai_stp_npu_api_get()->port_state_bulk_set(npu.count, npu.stp_inst_list,
+                                                   npu.bridge_port_list, npu.state_list,
+                                                   npu.status_list);
+    }
+
+    for(npu_idx = 0; npu_idx < npu.count; npu_idx++) {
+        idx = npu.object_idx[npu_idx];
+
+        if(!stopped && (npu.status_list[npu_idx] == SAI_STATUS_SUCCESS)) {
+            sai_bridge_port_to_stp_port_map_insert(npu.bridge_port_list[npu_idx],
+                                                   object_id[idx]);
+            object_statuses[idx] = SAI_STATUS_SUCCESS;
+            continue;
+        }
+
+        if(stopped) {
+            object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
+        } else {
+            SAI_STP_LOG_ERR("STP port state set failed for Bridge Port 0x%"PRIx64"",
+                            npu.bridge_port_list[npu_idx]);
+            object_statuses[idx] = npu.status_list[npu_idx];
+
+            if(stop_on_error) {
+                stopped = true;
+                stop_idx = idx;
+                sai_stp_port_bulk_npu_rollback(&npu, npu_idx + 1);
+            }
+        }
+
+        sai_stp_port_info_remove(object_id[idx]);
+        object_id[idx] = SAI_NULL_OBJECT_ID;
+    }
+
+    /* Entries after the first failure, even those which failed validation */
+    if(stopped) {
+        for(idx = stop_idx + 1; idx < object_count; idx++) {
+            object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
+        }
+    }
+
+    sai_stp_give_bulk_module_lock();
+    sai_stp_unlock();
+
+    sai_stp_port_bulk_npu_free(&npu);
+
+    return sai_stp_port_bulk_status_get(object_count, object_statuses);
 }
 
 sai_status_t sai_stp_port_bulk_remove(
@@ -939,7 +1169,120 @@ sai_status_t sai_stp_port_bulk_remove(
         sai_bulk_op_error_mode_t type,
         sai_status_t *object_statuses)
 {
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    sai_stp_port_bulk_npu_t npu;
+    dn_sai_stp_port_info_t  stp_port_info;
+    dn_sai_stp_port_info_t *p_stp_port_info = NULL;
+    sai_object_id_t         bridge_port_id;
+    bool                    stop_on_error = (type == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR);
+    bool                    stopped = false;
+    uint32_t                stop_idx = 0;
+    uint32_t                idx;
+    uint32_t                npu_idx;
+
+    if((object_count == 0) || (object_id == NULL) || (object_statuses == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for(idx = 0; idx < object_count; idx++) {
+        object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    if(sai_stp_port_bulk_npu_alloc(&npu, object_count) != SAI_STATUS_SUCCESS) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_stp_lock();
+    sai_stp_take_bulk_module_lock();
+
+    for(idx = 0; idx < object_count; idx++) {
+        if(!sai_is_obj_id_stp_port(object_id[idx])) {
+            SAI_STP_LOG_ERR("Invalid STP port object id 0x%"PRIx64" to remove",
+                            object_id[idx]);
+            object_statuses[idx] = SAI_STATUS_INVALID_OBJECT_ID;
+        } else {
+            memset(&stp_port_info, 0, sizeof(stp_port_info));
+            stp_port_info.stp_port_id = object_id[idx];
+
+            p_stp_port_info = (dn_sai_stp_port_info_t *)std_rbtree_getexact(
+                                            global_stp_port_tree, &stp_port_info);
+            if(p_stp_port_info == NULL) {
+                SAI_STP_LOG_ERR("STP port obj 0x%"PRIx64" not found", object_id[idx]);
+                object_statuses[idx] = SAI_STATUS_ITEM_NOT_FOUND;
+            }
+        }
+
+        if(object_statuses[idx] != SAI_STATUS_NOT_EXECUTED) {
+            if(stop_on_error) {
+                break;
+            }
+            continue;
+        }
+
+        sai_stp_port_bulk_npu_add(&npu, idx, p_stp_port_info->stp_inst_id,
+                                  p_stp_port_info->bridge_port_id,
+                                  SAI_STP_PORT_STATE_BLOCKING, p_stp_port_info->port_state);
+    }
+
+    if(npu.count > 0) {
+        sai_stp_npu_api_get()->port_state_bulk_set(npu.count, npu.stp_inst_list,
+                                                   npu.bridge_port_list, npu.state_list,
+                                                   npu.status_list);
+    }
+
+    for(npu_idx = 0; npu_idx < npu.count; npu_idx++) {
+        idx = npu.object_idx[npu_idx];
+
+        if(stopped) {
+            object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
+            continue;
+        }
+
+        if(npu.status_list[npu_idx] != SAI_STATUS_SUCCESS) {
+            SAI_STP_LOG_ERR("STP port state default set failed for port 0x%"PRIx64"",
+                            npu.bridge_port_list[npu_idx]);
+            object_statuses[idx] = npu.status_list[npu_idx];
+
+            if(stop_on_error) {
+                stopped = true;
+                stop_idx = idx;
+                sai_stp_port_bulk_npu_rollback(&npu, npu_idx + 1);
+            }
+            continue;
+        }
+
+        /* Looked up again, the same STP port may be listed twice */
+        memset(&stp_port_info, 0, sizeof(stp_port_info));
+        stp_port_info.stp_port_id = object_id[idx];
+
+        if(std_rbtree_getexact(global_stp_port_tree, &stp_port_info) == NULL) {
+            object_statuses[idx] = SAI_STATUS_ITEM_NOT_FOUND;
+
+            if(stop_on_error) {
+                stopped = true;
+                stop_idx = idx;
+                sai_stp_port_bulk_npu_rollback(&npu, npu_idx + 1);
+            }
+            continue;
+        }
+
+        bridge_port_id = npu.bridge_port_list[npu_idx];
+        sai_stp_port_info_remove(object_id[idx]);
+        sai_bridge_port_to_stp_port_map_remove(bridge_port_id, object_id[idx]);
+        object_statuses[idx] = SAI_STATUS_SUCCESS;
+    }
+
+    if(stopped) {
+        for(idx = stop_idx + 1; idx < object_count; idx++) {
+            object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
+        }
+    }
+
+    sai_stp_give_bulk_module_lock();
+    sai_stp_unlock();
+
+    sai_stp_port_bulk_npu_free(&npu);
+
+    return sai_stp_port_bulk_status_get(object_count, object_statuses);
 }
 
 sai_status_t sai_npu_stp_port_state_get (sai_object_id_t stp_inst_id,
@@ -33,6 +33,7 @@
 #include "sai_stp_util.h"
 #include "saistp.h"
 #include "std_struct_utils.h"
+#include "sai_api_stats.h"
 
 
 static std_mutex_type_t stp_lock;
@@ -79,7 +80,7 @@ void sai_stp_mutex_lock_init(void)
 
 void sai_stp_lock(void)
 {
-    std_mutex_lock (&stp_lock);
+    sai_api_stats_mutex_lock (&stp_lock);
 }
 
 void sai_stp_unlock(void)
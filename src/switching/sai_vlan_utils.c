@@ -38,6 +38,7 @@
 #include "sai_gen_utils.h"
 #include "sai_bridge_api.h"
 #include "sai_lag_api.h"
+#include "sai_api_stats.h"
 
 static sai_vlan_global_cache_node_t *global_vlan_list[SAI_MAX_VLAN_TAG_ID+1];
 static std_mutex_lock_create_static_init_fast(vlan_lock);
@@ -51,7 +52,7 @@ rbtree_handle sai_vlan_global_member_tree_get(void)
 
 void sai_vlan_lock(void)
 {
-    std_mutex_lock(&vlan_lock);
+    sai_api_stats_mutex_lock(&vlan_lock);
 }
 
 void sai_vlan_unlock(void)
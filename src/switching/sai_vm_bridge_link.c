@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_vm_bridge_link.c
+ *
+ * @brief  This file contains the resolution of the kernel VLAN bridges and
+ *         their members, shared by the VM handlers programming them.
+ */
+
+#include "sai_vm_bridge_link.h"
+#include "sai_vm_defs.h"
+#include "sai_vm_rtnl.h"
+#include "sai_vm_vport.h"
+#include "sai_vlan_api.h"
+#include "sai_bridge_api.h"
+#include "sai_port_utils.h"
+#include "sai_switch_utils.h"
+
+#include "std_assert.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <linux/if_link.h>
+
+/* Growth step of the bridge member table */
+#define SAI_VM_BRIDGE_LINK_TABLE_CHUNK  (64)
+
+static int sai_vm_bridge_link_cmp (const void *p_a, const void *p_b)
+{
+    const sai_vm_bridge_link_t *p_link_a = (const sai_vm_bridge_link_t *) p_a;
+    const sai_vm_bridge_link_t *p_link_b = (const sai_vm_bridge_link_t *) p_b;
+
+    return (p_link_a->master_if_index > p_link_b->master_if_index) -
+           (p_link_a->master_if_index < p_link_b->master_if_index);
+}
+
+static void sai_vm_bridge_link_cb (struct nlmsghdr *hdr, void *ctx)
+{
+    sai_vm_bridge_link_table_t *p_tbl = (sai_vm_bridge_link_table_t *) ctx;
+    struct ifinfomsg           *ifi = (struct ifinfomsg *) NLMSG_DATA (hdr);
+    struct rtattr              *tb [IFLA_MAX + 1];
+    sai_vm_bridge_link_t       *p_link = NULL;
+    unsigned int                vlan_id = 0;
+    char                        trail = 0;
+
+    if ((hdr->nlmsg_type != RTM_NEWLINK) || (p_tbl->oom)) {
+        return;
+    }
+
+    sai_vm_rtnl_attr_parse (tb, IFLA_MAX, IFLA_RTA (ifi),
+                            hdr->nlmsg_len - NLMSG_LENGTH (sizeof (*ifi)));
+
+    if ((tb [IFLA_IFNAME] != NULL) &&
+        (sscanf ((const char *) RTA_DATA (tb [IFLA_IFNAME]),
+                 SAI_VM_BRIDGE_VLAN_NAME_FMT "%c", &vlan_id, &trail) == 1) &&
+        (sai_is_valid_vlan_id ((sai_vlan_id_t) vlan_id))) {
+        p_tbl->vlan_br_if_index [vlan_id] = ifi->ifi_index;
+    }
+
+    if (tb [IFLA_MASTER] == NULL) {
+        return;
+    }
+
+    if (p_tbl->count == p_tbl->size) {
+        sai_vm_bridge_link_t *links = realloc (p_tbl->links,
+                                               (p_tbl->size + SAI_VM_BRIDGE_LINK_TABLE_CHUNK) *
+                                               sizeof (sai_vm_bridge_link_t));
+        if (links == NULL) {
+            p_tbl->oom = true;
+            return;
+        }
+        p_tbl->links = links;
+        p_tbl->size += SAI_VM_BRIDGE_LINK_TABLE_CHUNK;
+    }
+
+    p_link = &p_tbl->links [p_tbl->count++];
+    p_link->if_index = ifi->ifi_index;
+    p_link->master_if_index = *(int *) RTA_DATA (tb [IFLA_MASTER]);
+    p_link->link_if_index = (tb [IFLA_LINK] != NULL) ?
+                            *(int *) RTA_DATA (tb [IFLA_LINK]) : 0;
+}
+
+void sai_vm_bridge_link_table_free (sai_vm_bridge_link_table_t *p_tbl)
+{
+    STD_ASSERT (p_tbl != NULL);
+
+    free (p_tbl->links);
+    free (p_tbl->vlan_br_if_index);
+    memset (p_tbl, 0, sizeof (*p_tbl));
+}
+
+sai_status_t sai_vm_bridge_link_table_get (int sock, sai_vm_bridge_link_table_t *p_tbl)
+{
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    struct {
+        struct nlmsghdr  hdr;
+        struct ifinfomsg ifi;
+    } req;
+
+    STD_ASSERT (p_tbl != NULL);
+
+    memset (p_tbl, 0, sizeof (*p_tbl));
+
+    p_tbl->vlan_br_if_index = calloc (SAI_VM_MAX_VLANS, sizeof (int));
+    if (p_tbl->vlan_br_if_index == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    memset (&req, 0, sizeof (req));
+    req.hdr.nlmsg_len = NLMSG_LENGTH (sizeof (req.ifi));
+    req.hdr.nlmsg_type = RTM_GETLINK;
+    req.ifi.ifi_family = AF_UNSPEC;
+
+    sai_rc = sai_vm_rtnl_dump (sock, &req.hdr, sai_vm_bridge_link_cb, p_tbl);
+
+    if ((sai_rc == SAI_STATUS_SUCCESS) && (p_tbl->oom)) {
+        sai_rc = SAI_STATUS_NO_MEMORY;
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_SWITCH_LOG_ERR ("Kernel bridge link dump failed, rc %d.", sai_rc);
+        sai_vm_bridge_link_table_free (p_tbl);
+        return sai_rc;
+    }
+
+    qsort (p_tbl->links, p_tbl->count, sizeof (sai_vm_bridge_link_t),
+           sai_vm_bridge_link_cmp);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void sai_vm_bridge_vlan_members_walk (const sai_vm_bridge_link_table_t *p_tbl,
+                                      sai_vlan_id_t vlan_id, int port_if_index,
+                                      sai_vm_bridge_member_fn fn, void *ctx)
+{
+    const sai_vm_bridge_link_t *p_link = NULL;
+    int                         br_if_index = 0;
+    uint_t                      low = 0;
+    uint_t                      high = 0;
+    uint_t                      mid;
+
+    STD_ASSERT (p_tbl != NULL);
+    STD_ASSERT (fn != NULL);
+
+    if (!sai_is_valid_vlan_id (vlan_id)) {
+        return;
+    }
+
+    br_if_index = p_tbl->vlan_br_if_index [vlan_id];
+    if (br_if_index == 0) {
+        return;
+    }
+
+    /* First member of the bridge */
+    high = p_tbl->count;
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+
+        if (p_tbl->links [mid].master_if_index < br_if_index) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    for (p_link = &p_tbl->links [low];
+         (p_link < &p_tbl->links [p_tbl->count]) &&
+         (p_link->master_if_index == br_if_index); p_link++) {
+        if ((p_link->if_index == port_if_index) ||
+            (p_link->link_if_index == port_if_index)) {
+            fn (br_if_index, p_link->if_index, ctx);
+        }
+    }
+}
+
+int sai_vm_bridge_port_if_index_get (sai_object_id_t bridge_port_id)
+{
+    sai_object_id_t  port_id = SAI_NULL_OBJECT_ID;
+    sai_port_info_t *p_port_info = NULL;
+    const char      *if_name = NULL;
+
+    /* LAG bridge ports have no front panel interface of their own */
+    if (sai_bridge_port_get_port_id (bridge_port_id, &port_id) != SAI_STATUS_SUCCESS) {
+        return 0;
+    }
+
+    p_port_info = sai_port_info_get (port_id);
+    if (p_port_info == NULL) {
+        return 0;
+    }
+
+    if_name = sai_vm_vport_get_if_name (p_port_info->phy_port_id);
+    if (if_name == NULL) {
+        return 0;
+    }
+
+    return (int) if_nametoindex (if_name);
+}
@@ -516,6 +516,81 @@ sai_status_t sai_get_bridge_port_for_fdb_entry (const sai_fdb_entry_t *fdb_entry
     return SAI_STATUS_SUCCESS;
 }
 
+static sai_status_t sai_npu_create_fdb_entries (uint_t count,
+                                                const sai_fdb_entry_t *fdb_entry_list,
+                                                const sai_fdb_entry_node_t *fdb_entry_node_list)
+{
+    sai_status_t sai_rc;
+
+    STD_ASSERT(fdb_entry_list != NULL);
+    STD_ASSERT(fdb_entry_node_list != NULL);
+
+    SAI_FDB_LOG_TRACE ("FDB bulk create of %u entries.", count);
+
+    /* Insert the FDB records to DB in multi row statements. */
+    sai_rc = sai_fdb_create_db_entries (count, fdb_entry_list, fdb_entry_node_list);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_FDB_LOG_ERR ("Error inserting %u FDB entries to DB.", count);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_npu_flush_fdb_entries (uint_t count,
+                                               const sai_fdb_entry_t *fdb_entry_list)
+{
+    static sai_mac_t null_mac_addr = {0,0,0,0,0,0};
+    sai_status_t     sai_rc;
+    uint_t           idx;
+
+    STD_ASSERT(fdb_entry_list != NULL);
+
+    SAI_FDB_LOG_TRACE ("FDB bulk flush of %u entries.", count);
+
+    /* A null MAC flushes the bridge, left to the per entry flush */
+    for (idx = 0; idx < count; idx++) {
+        if (memcmp (fdb_entry_list [idx].mac_address, null_mac_addr,
+                    sizeof (sai_mac_t)) == 0) {
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    sai_rc = sai_fdb_delete_db_entries (count, fdb_entry_list);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_FDB_LOG_ERR ("Error removing %u FDB entries from DB.", count);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_npu_write_fdb_entries_to_hardware (uint_t count,
+                                                           sai_fdb_entry_node_t *const *fdb_entry_node_list)
+{
+    sai_status_t sai_rc;
+
+    STD_ASSERT(fdb_entry_node_list != NULL);
+
+    SAI_FDB_LOG_TRACE ("FDB bulk attribute set of %u entries.", count);
+
+    /* Update the FDB records in DB in multi row statements. */
+    sai_rc = sai_fdb_set_db_entries (count,
+                                     (const sai_fdb_entry_node_t *const *) fdb_entry_node_list);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_FDB_LOG_ERR ("Error updating %u FDB entries in DB.", count);
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
 static sai_npu_fdb_api_t sai_vm_fdb_api_table = {
 
     sai_npu_fdb_init,
@@ -539,7 +614,10 @@ static sai_npu_fdb_api_t sai_vm_fdb_api_table = {
     sai_npu_bcast_cpu_flood_enable_set,
     sai_npu_mcast_cpu_flood_enable_set,
     sai_npu_bcast_cpu_flood_enable_get,
-    sai_npu_mcast_cpu_flood_enable_get
+    sai_npu_mcast_cpu_flood_enable_get,
+    sai_npu_create_fdb_entries,
+    sai_npu_flush_fdb_entries,
+    sai_npu_write_fdb_entries_to_hardware
 };
 
 sai_npu_fdb_api_t* sai_vm_fdb_api_query (void)
@@ -26,6 +26,7 @@
 #include "sai_l2mc_common.h"
 #include "sai_l2mc_api.h"
 #include "sai_port_utils.h"
+#include "sai_vm_mcast.h"
 #include <inttypes.h>
 
 static dn_sai_id_gen_info_t l2mc_obj_gen_info;
@@ -121,6 +122,7 @@ static sai_status_t sai_vm_l2mc_member_remove(
         SAI_L2MC_LOG_ERR("Wrong l2mc_member_id 0x%"PRIx64"", l2mc_member_node->l2mc_member_id);
         return SAI_STATUS_FAILURE;
     }
+    sai_vm_mcast_l2mc_member_update(l2mc_member_node, false);
     return SAI_STATUS_SUCCESS;
 }
 
@@ -134,6 +136,7 @@ static sai_status_t sai_vm_l2mc_member_create(dn_sai_l2mc_member_node_t *l2mc_me
             l2mc_member_node->l2mc_member_id) {
         return SAI_STATUS_FAILURE;
     }
+    sai_vm_mcast_l2mc_member_update(l2mc_member_node, true);
     return SAI_STATUS_SUCCESS;
 }
 
@@ -22,84 +22,568 @@
  */
 
 #include "sailag.h"
+#include "saihash.h"
+#include "saiswitch.h"
 #include "sai_npu_lag.h"
 #include "saitypes.h"
 #include "saistatus.h"
 #include "std_assert.h"
+#include "std_mutex_lock.h"
 #include "sai_lag_common.h"
+#include "sai_port_utils.h"
 #include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
 #include <inttypes.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <linux/if_link.h>
+#include <linux/if_bonding.h>
 #include "sai_oid_utils.h"
 #include "sai_vm_defs.h"
+#include "sai_vm_lag.h"
+#include "sai_vm_rtnl.h"
+#include "sai_vm_vport.h"
+#include "sai_vm_vport_event.h"
 
-static bool lag_id_in_use[SAI_VM_SWITCH_MAX_LAG_NUMBER];
+/* Classes of hash fields deciding the bond transmit hash policy */
+#define SAI_VM_LAG_HASH_CLASS_L3     (1 << 0)
+#define SAI_VM_LAG_HASH_CLASS_L4     (1 << 1)
+#define SAI_VM_LAG_HASH_CLASS_INNER  (1 << 2)
+
+typedef struct _sai_vm_lag_member_t {
+    sai_object_id_t port_id;
+    /* Interface index of the virtual port, 0 if the port has no adapter */
+    int             if_index;
+    bool            ing_disable;
+    bool            egr_disable;
+    /* Virtual port is currently enslaved to the bond device */
+    bool            enslaved;
+    bool            oper_up;
+} sai_vm_lag_member_t;
+
+typedef struct _sai_vm_lag_t {
+    bool                 in_use;
+    /* Interface index of the bond device, 0 if not backed by the kernel */
+    int                  if_index;
+    uint_t               member_count;
+    sai_vm_lag_member_t *members;
+} sai_vm_lag_t;
+
+typedef enum _sai_vm_lag_hash_attr_t {
+    SAI_VM_LAG_HASH_ATTR_DEFAULT,
+    SAI_VM_LAG_HASH_ATTR_IPV4,
+    SAI_VM_LAG_HASH_ATTR_IPV4_IN_IPV4,
+    SAI_VM_LAG_HASH_ATTR_IPV6,
+    SAI_VM_LAG_HASH_ATTR_MAX,
+} sai_vm_lag_hash_attr_t;
+
+static sai_vm_lag_t sai_vm_lag_table[SAI_VM_SWITCH_MAX_LAG_NUMBER];
+
+/* Hash field classes configured per switch LAG hash attribute */
+static uint_t sai_vm_lag_hash_class[SAI_VM_LAG_HASH_ATTR_MAX];
+
+static uint8_t sai_vm_lag_xmit_hash_policy = BOND_XMIT_POLICY_LAYER2;
+
+/* rtnetlink socket, invalid when running without the virtual port namespace */
+static int sai_vm_lag_sock = STD_INVALID_FD;
+
+/* Protects the tables against the link event thread */
+static std_mutex_lock_create_static_init_fast (sai_vm_lag_lock);
+
+static inline sai_vm_lag_t *sai_vm_lag_get (sai_object_id_t lag_id)
+{
+    uint_t lag_idx = (uint_t)sai_uoid_npu_obj_id_get(lag_id);
+
+    if ((lag_idx >= SAI_VM_SWITCH_MAX_LAG_NUMBER) ||
+        (!sai_vm_lag_table[lag_idx].in_use)) {
+        return NULL;
+    }
+    return &sai_vm_lag_table[lag_idx];
+}
+
+static sai_vm_lag_member_t *sai_vm_lag_member_get (sai_vm_lag_t *p_lag,
+                                                   sai_object_id_t port_id)
+{
+    uint_t idx;
+
+    for (idx = 0; idx < p_lag->member_count; idx++) {
+        if (p_lag->members[idx].port_id == port_id) {
+            return &p_lag->members[idx];
+        }
+    }
+    return NULL;
+}
+
+static void sai_vm_lag_member_delete (sai_vm_lag_t *p_lag,
+                                      sai_vm_lag_member_t *p_member)
+{
+    /* Keep the member array dense, order is not significant */
+    p_lag->member_count--;
+    *p_member = p_lag->members[p_lag->member_count];
+}
+
+static int sai_vm_lag_port_if_index_get (sai_object_id_t port_id)
+{
+    sai_port_info_t *p_port_info = sai_port_info_get (port_id);
+    vport_desc_t    *p_desc = NULL;
+
+    if (p_port_info == NULL) {
+        return 0;
+    }
+
+    /* The VM may have fewer adapters than ports */
+    p_desc = sai_vm_vport_get_desc (p_port_info->phy_port_id);
+
+    return (p_desc != NULL) ? p_desc->if_index : 0;
+}
+
+static bool sai_vm_lag_port_admin_state_get (sai_object_id_t port_id)
+{
+    sai_port_info_t *p_port_info = sai_port_info_get (port_id);
+
+    return (p_port_info != NULL) ? p_port_info->admin_state : false;
+}
+
+static void sai_vm_lag_link_msg_add (sai_vm_rtnl_batch_t *batch, int if_index,
+                                     uint_t flags, uint_t change)
+{
+    struct ifinfomsg ifi;
+
+    memset (&ifi, 0, sizeof (ifi));
+    ifi.ifi_family = AF_UNSPEC;
+    ifi.ifi_index = if_index;
+    ifi.ifi_flags = flags;
+    ifi.ifi_change = change;
+
+    sai_vm_rtnl_batch_msg_add (batch, RTM_NEWLINK, 0, &ifi, sizeof (ifi));
+}
+
+static void sai_vm_lag_bond_info_add (sai_vm_rtnl_batch_t *batch, bool create)
+{
+    size_t   linkinfo;
+    size_t   data;
+    uint8_t  mode = BOND_MODE_XOR;
+    uint32_t miimon = SAI_VM_LAG_MIIMON_MS;
+
+    linkinfo = sai_vm_rtnl_nest_begin (batch, IFLA_LINKINFO);
+    sai_vm_rtnl_attr_add (batch, IFLA_INFO_KIND, "bond", strlen ("bond"));
+
+    data = sai_vm_rtnl_nest_begin (batch, IFLA_INFO_DATA);
+    if (create) {
+        sai_vm_rtnl_attr_add (batch, IFLA_BOND_MODE, &mode, sizeof (mode));
+        sai_vm_rtnl_attr_add (batch, IFLA_BOND_MIIMON, &miimon, sizeof (miimon));
+    }
+    sai_vm_rtnl_attr_add (batch, IFLA_BOND_XMIT_HASH_POLICY,
+                          &sai_vm_lag_xmit_hash_policy,
+                          sizeof (sai_vm_lag_xmit_hash_policy));
+    sai_vm_rtnl_nest_end (batch, data);
+
+    sai_vm_rtnl_nest_end (batch, linkinfo);
+}
+
+/*
+ * A slave has to be down to be enslaved; the bond brings it back up, so
+ * restore the port admin state afterwards. Returns the index of the
+ * message setting the master.
+ */
+static uint32_t sai_vm_lag_enslave_msgs_add (sai_vm_rtnl_batch_t *batch,
+                                             const sai_vm_lag_t *p_lag,
+                                             const sai_vm_lag_member_t *p_member)
+{
+    uint32_t master_msg;
+
+    sai_vm_lag_link_msg_add (batch, p_member->if_index, 0, IFF_UP);
+
+    master_msg = batch->msg_count;
+    sai_vm_lag_link_msg_add (batch, p_member->if_index, 0, 0);
+    sai_vm_rtnl_attr_add (batch, IFLA_MASTER, &p_lag->if_index,
+                          sizeof (p_lag->if_index));
+
+    if (!sai_vm_lag_port_admin_state_get (p_member->port_id)) {
+        sai_vm_lag_link_msg_add (batch, p_member->if_index, 0, IFF_UP);
+    }
+
+    return master_msg;
+}
+
+static uint32_t sai_vm_lag_release_msgs_add (sai_vm_rtnl_batch_t *batch,
+                                             const sai_vm_lag_member_t *p_member)
+{
+    uint32_t master_msg = batch->msg_count;
+    int      no_master = 0;
+    bool     admin_up = sai_vm_lag_port_admin_state_get (p_member->port_id);
+
+    sai_vm_lag_link_msg_add (batch, p_member->if_index, 0, 0);
+    sai_vm_rtnl_attr_add (batch, IFLA_MASTER, &no_master, sizeof (no_master));
+
+    /* The bond closes the slave on release */
+    sai_vm_lag_link_msg_add (batch, p_member->if_index,
+                             admin_up ? IFF_UP : 0, IFF_UP);
+
+    return master_msg;
+}
+
+static void sai_vm_lag_bond_if_index_cb (struct nlmsghdr *hdr, void *ctx)
+{
+    if (hdr->nlmsg_type == RTM_NEWLINK) {
+        *(int *) ctx = ((struct ifinfomsg *) NLMSG_DATA (hdr))->ifi_index;
+    }
+}
+
+static sai_status_t sai_vm_lag_bond_create (uint_t lag_idx, int *if_index)
+{
+    sai_vm_rtnl_batch_t batch;
+    sai_status_t        sai_rc;
+    char                name[IFNAMSIZ];
+    struct ifinfomsg    ifi;
+
+    snprintf (name, sizeof (name), SAI_VM_LAG_DEV_NAME_FMT, lag_idx);
+
+    sai_vm_rtnl_batch_init (&batch);
+
+    memset (&ifi, 0, sizeof (ifi));
+    ifi.ifi_family = AF_UNSPEC;
+    ifi.ifi_flags = IFF_UP;
+    ifi.ifi_change = IFF_UP;
+
+    sai_vm_rtnl_batch_msg_add (&batch, RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL,
+                               &ifi, sizeof (ifi));
+    sai_vm_rtnl_attr_add (&batch, IFLA_IFNAME, name, strlen (name) + 1);
+    sai_vm_lag_bond_info_add (&batch, true);
+
+    /* Fetch the index of the new device in the same round trip */
+    memset (&ifi, 0, sizeof (ifi));
+    ifi.ifi_family = AF_UNSPEC;
+    sai_vm_rtnl_batch_msg_add (&batch, RTM_GETLINK, 0, &ifi, sizeof (ifi));
+    sai_vm_rtnl_attr_add (&batch, IFLA_IFNAME, name, strlen (name) + 1);
+
+    *if_index = 0;
+    sai_rc = sai_vm_rtnl_batch_commit (sai_vm_lag_sock, &batch,
+                                       sai_vm_lag_bond_if_index_cb, if_index);
+    sai_vm_rtnl_batch_free (&batch);
+
+    if ((sai_rc == SAI_STATUS_SUCCESS) && (*if_index == 0)) {
+        sai_rc = SAI_STATUS_FAILURE;
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_LAG_LOG_ERR ("Bond device %s creation failed, rc %d.", name, sai_rc);
+    }
+
+    return sai_rc;
+}
+
+static sai_status_t sai_vm_lag_bond_remove (int if_index)
+{
+    sai_vm_rtnl_batch_t batch;
+    sai_status_t        sai_rc;
+    struct ifinfomsg    ifi;
+
+    sai_vm_rtnl_batch_init (&batch);
+
+    memset (&ifi, 0, sizeof (ifi));
+    ifi.ifi_family = AF_UNSPEC;
+    ifi.ifi_index = if_index;
+    sai_vm_rtnl_batch_msg_add (&batch, RTM_DELLINK, 0, &ifi, sizeof (ifi));
+
+    sai_rc = sai_vm_rtnl_batch_commit (sai_vm_lag_sock, &batch, NULL, NULL);
+    sai_vm_rtnl_batch_free (&batch);
+
+    return sai_rc;
+}
+
+static void sai_vm_lag_link_event_handler (int if_index, int master_if_index,
+                                           bool oper_up)
+{
+    uint_t lag_idx;
+    uint_t idx;
+
+    std_mutex_lock (&sai_vm_lag_lock);
+
+    for (lag_idx = 0; lag_idx < SAI_VM_SWITCH_MAX_LAG_NUMBER; lag_idx++) {
+        sai_vm_lag_t *p_lag = &sai_vm_lag_table[lag_idx];
+
+        if ((!p_lag->in_use) || (p_lag->if_index == 0)) {
+            continue;
+        }
+
+        for (idx = 0; idx < p_lag->member_count; idx++) {
+            sai_vm_lag_member_t *p_member = &p_lag->members[idx];
+
+            if (p_member->if_index != if_index) {
+                continue;
+            }
+
+            if (p_member->oper_up != oper_up) {
+                SAI_LAG_LOG_TRACE ("LAG 0x%x member port 0x%"PRIx64" oper %s.",
+                                   lag_idx, p_member->port_id,
+                                   oper_up ? "up" : "down");
+                p_member->oper_up = oper_up;
+            }
+
+            if ((p_member->enslaved) && (master_if_index != p_lag->if_index)) {
+                /* Released behind our back, e.g. the device was re-created */
+                SAI_LAG_LOG_ERR ("LAG 0x%x member port 0x%"PRIx64" no longer "
+                                 "enslaved to the bond.", lag_idx, p_member->port_id);
+                p_member->enslaved = false;
+            }
+
+            std_mutex_unlock (&sai_vm_lag_lock);
+            return;
+        }
+    }
+
+    std_mutex_unlock (&sai_vm_lag_lock);
+}
 
 static void sai_npu_lag_init (void)
 {
+    sai_vm_lag_sock = sai_vm_rtnl_open (0);
+
+    if (sai_vm_lag_sock == STD_INVALID_FD) {
+        SAI_LAG_LOG_ERR ("LAGs are not backed by bond devices, "
+                         "virtual port namespace unavailable.");
+        return;
+    }
+
+    sai_vm_vport_event_link_callback (sai_vm_lag_link_event_handler);
 }
 
 static sai_status_t sai_npu_lag_create (sai_object_id_t *lag_id)
 {
-    uint_t lag_idx;
+    sai_status_t  sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_lag_t *p_lag = NULL;
+    uint_t        lag_idx;
     SAI_LAG_LOG_TRACE ("LAG Creation.");
 
     STD_ASSERT (lag_id != NULL);
     for(lag_idx = 0; lag_idx < SAI_VM_SWITCH_MAX_LAG_NUMBER; lag_idx++) {
-        if(!lag_id_in_use[lag_idx]) {
-            lag_id_in_use[lag_idx] = true;
-            *lag_id = sai_uoid_create(SAI_OBJECT_TYPE_LAG,lag_idx);
-            return SAI_STATUS_SUCCESS;
+        if(!sai_vm_lag_table[lag_idx].in_use) {
+            break;
         }
     }
 
-    SAI_LAG_LOG_ERR("LAG Index unavailable");
-    return SAI_STATUS_INSUFFICIENT_RESOURCES;
+    if (lag_idx == SAI_VM_SWITCH_MAX_LAG_NUMBER) {
+        SAI_LAG_LOG_ERR("LAG Index unavailable");
+        return SAI_STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    p_lag = &sai_vm_lag_table[lag_idx];
+
+    p_lag->members = calloc (SAI_VM_SWITCH_MAX_LAG_MEMBERS,
+                             sizeof (sai_vm_lag_member_t));
+    if (p_lag->members == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    std_mutex_lock (&sai_vm_lag_lock);
+
+    if (sai_vm_lag_sock != STD_INVALID_FD) {
+        sai_rc = sai_vm_lag_bond_create (lag_idx, &p_lag->if_index);
+    }
+
+    if (sai_rc == SAI_STATUS_SUCCESS) {
+        p_lag->in_use = true;
+        p_lag->member_count = 0;
+        *lag_id = sai_uoid_create(SAI_OBJECT_TYPE_LAG,lag_idx);
+    } else {
+        free (p_lag->members);
+        p_lag->members = NULL;
+        p_lag->if_index = 0;
+    }
+
+    std_mutex_unlock (&sai_vm_lag_lock);
+
+    return sai_rc;
 }
 
 static sai_status_t sai_npu_lag_remove (sai_object_id_t lag_id)
 {
-    uint_t lag_idx = (uint_t)sai_uoid_npu_obj_id_get(lag_id);
+    sai_status_t  sai_rc = SAI_STATUS_SUCCESS;
+    uint_t        lag_idx = (uint_t)sai_uoid_npu_obj_id_get(lag_id);
+    sai_vm_lag_t *p_lag = NULL;
     SAI_LAG_LOG_TRACE ("LAG Remove, ID: 0x%"PRIx64".", lag_id);
 
-    if(lag_idx < SAI_VM_SWITCH_MAX_LAG_NUMBER) {
-        if(lag_id_in_use[lag_idx]) {
-            lag_id_in_use[lag_idx] = false;
-            return SAI_STATUS_SUCCESS;
-        } else {
-            return SAI_STATUS_ITEM_NOT_FOUND;
-        }
+    if(lag_idx >= SAI_VM_SWITCH_MAX_LAG_NUMBER) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
     }
-    return SAI_STATUS_INVALID_OBJECT_ID;
+
+    std_mutex_lock (&sai_vm_lag_lock);
+
+    p_lag = &sai_vm_lag_table[lag_idx];
+    if(!p_lag->in_use) {
+        std_mutex_unlock (&sai_vm_lag_lock);
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    if (p_lag->if_index != 0) {
+        /* Deleting the bond releases any remaining slave */
+        sai_rc = sai_vm_lag_bond_remove (p_lag->if_index);
+    }
+
+    if (sai_rc == SAI_STATUS_SUCCESS) {
+        p_lag->in_use = false;
+        p_lag->if_index = 0;
+        p_lag->member_count = 0;
+        free (p_lag->members);
+        p_lag->members = NULL;
+    } else {
+        SAI_LAG_LOG_ERR ("Bond device of LAG 0x%"PRIx64" removal failed, rc %d.",
+                         lag_id, sai_rc);
+    }
+
+    std_mutex_unlock (&sai_vm_lag_lock);
+
+    return sai_rc;
 }
 
 static sai_status_t sai_npu_add_ports_to_lag (sai_object_id_t lag_id,
                                               const sai_object_list_t *lag_port_list,
                                               sai_object_list_t *lag_member_id_list)
 {
-    uint_t index;
+    sai_status_t         sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_lag_t        *p_lag = NULL;
+    sai_vm_lag_member_t *p_member = NULL;
+    sai_vm_rtnl_batch_t  batch;
+    uint32_t            *master_msg = NULL;
+    uint_t               base;
+    uint_t               index;
     SAI_LAG_LOG_TRACE ("LAG Add ports, ID: 0x%"PRIx64".", lag_id);
 
     STD_ASSERT (lag_port_list != NULL);
     STD_ASSERT (lag_member_id_list != NULL);
     STD_ASSERT (lag_port_list->count <= lag_member_id_list->count);
 
+    std_mutex_lock (&sai_vm_lag_lock);
+
+    p_lag = sai_vm_lag_get (lag_id);
+    if (p_lag == NULL) {
+        std_mutex_unlock (&sai_vm_lag_lock);
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    if ((p_lag->member_count + lag_port_list->count) > SAI_VM_SWITCH_MAX_LAG_MEMBERS) {
+        std_mutex_unlock (&sai_vm_lag_lock);
+        return SAI_STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    master_msg = calloc (lag_port_list->count + 1, sizeof (uint32_t));
+    if (master_msg == NULL) {
+        std_mutex_unlock (&sai_vm_lag_lock);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    /* All the new members are enslaved in a single batch */
+    sai_vm_rtnl_batch_init (&batch);
+    base = p_lag->member_count;
+
     for (index = 0; index < lag_port_list->count; index++) {
-        lag_member_id_list->list [index]
-            = sai_uoid_create (SAI_OBJECT_TYPE_LAG_MEMBER,
-                               sai_uoid_npu_obj_id_get (lag_port_list->list[index]));
+        p_member = &p_lag->members[base + index];
+
+        memset (p_member, 0, sizeof (*p_member));
+        p_member->port_id = lag_port_list->list[index];
+
+        if (p_lag->if_index != 0) {
+            p_member->if_index = sai_vm_lag_port_if_index_get (p_member->port_id);
+        }
+
+        if (p_member->if_index != 0) {
+            master_msg[index] = sai_vm_lag_enslave_msgs_add (&batch, p_lag, p_member);
+        }
     }
 
-    return SAI_STATUS_SUCCESS;
+    sai_rc = sai_vm_rtnl_batch_commit (sai_vm_lag_sock, &batch, NULL, NULL);
+
+    if (sai_rc == SAI_STATUS_SUCCESS) {
+        for (index = 0; index < lag_port_list->count; index++) {
+            p_member = &p_lag->members[base + index];
+            p_member->enslaved = (p_member->if_index != 0);
+
+            lag_member_id_list->list [index]
+                = sai_uoid_create (SAI_OBJECT_TYPE_LAG_MEMBER,
+                                   sai_uoid_npu_obj_id_get (lag_port_list->list[index]));
+        }
+        p_lag->member_count += lag_port_list->count;
+    } else {
+        sai_vm_rtnl_batch_t rollback;
+
+        SAI_LAG_LOG_ERR ("LAG 0x%"PRIx64" enslave of %u ports failed, rc %d.",
+                         lag_id, lag_port_list->count, sai_rc);
+
+        /* Release the ports that made it into the bond */
+        sai_vm_rtnl_batch_init (&rollback);
+        for (index = 0; index < lag_port_list->count; index++) {
+            p_member = &p_lag->members[base + index];
+
+            if ((p_member->if_index != 0) &&
+                ((batch.msg_err == NULL) || (batch.msg_err[master_msg[index]] == 0))) {
+                sai_vm_lag_release_msgs_add (&rollback, p_member);
+            }
+        }
+        (void) sai_vm_rtnl_batch_commit (sai_vm_lag_sock, &rollback, NULL, NULL);
+        sai_vm_rtnl_batch_free (&rollback);
+    }
+
+    sai_vm_rtnl_batch_free (&batch);
+    free (master_msg);
+
+    std_mutex_unlock (&sai_vm_lag_lock);
+    return sai_rc;
 }
 
 static sai_status_t sai_npu_remove_ports_from_lag (
 sai_object_id_t lag_id, const sai_object_list_t *lag_port_list)
 {
+    sai_status_t         sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_lag_t        *p_lag = NULL;
+    sai_vm_lag_member_t *p_member = NULL;
+    sai_vm_rtnl_batch_t  batch;
+    uint_t               index;
     SAI_LAG_LOG_TRACE ("LAG Remove ports, ID: 0x%"PRIx64".", lag_id);
 
     STD_ASSERT (lag_port_list != NULL);
 
-    return SAI_STATUS_SUCCESS;
+    std_mutex_lock (&sai_vm_lag_lock);
+
+    p_lag = sai_vm_lag_get (lag_id);
+    if (p_lag == NULL) {
+        std_mutex_unlock (&sai_vm_lag_lock);
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    /* All the members are released in a single batch */
+    sai_vm_rtnl_batch_init (&batch);
+
+    for (index = 0; index < lag_port_list->count; index++) {
+        p_member = sai_vm_lag_member_get (p_lag, lag_port_list->list[index]);
+
+        if ((p_member != NULL) && (p_member->enslaved)) {
+            sai_vm_lag_release_msgs_add (&batch, p_member);
+        }
+    }
+
+    sai_rc = sai_vm_rtnl_batch_commit (sai_vm_lag_sock, &batch, NULL, NULL);
+    sai_vm_rtnl_batch_free (&batch);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        /* The ports are gone from the LAG in SAI regardless; a port failing
+         * to be released is reported by the link event thread. */
+        SAI_LAG_LOG_ERR ("LAG 0x%"PRIx64" release of %u ports failed, rc %d.",
+                         lag_id, lag_port_list->count, sai_rc);
+    }
+
+    for (index = 0; index < lag_port_list->count; index++) {
+        p_member = sai_vm_lag_member_get (p_lag, lag_port_list->list[index]);
+
+        if (p_member != NULL) {
+            sai_vm_lag_member_delete (p_lag, p_member);
+        }
+    }
+
+    std_mutex_unlock (&sai_vm_lag_lock);
+
+    return sai_rc;
 }
 
 static sai_status_t sai_npu_lag_port_flag_set (sai_object_id_t lag_id,
@@ -107,12 +591,61 @@ static sai_status_t sai_npu_lag_port_flag_set (sai_object_id_t lag_id,
                                                bool            is_ingress,
                                                bool            value)
 {
+    sai_status_t         sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_lag_t        *p_lag = NULL;
+    sai_vm_lag_member_t *p_member = NULL;
+    sai_vm_rtnl_batch_t  batch;
     SAI_LAG_LOG_TRACE ("LAG port flag set, LAG ID: 0x%"PRIx64" "
                        "Port ID: 0x%"PRIx64" Direction: %s Value: %s.",
                        lag_id, port_id, (is_ingress) ? "Ingress" : "Egress",
                        (value) ? "true" : "false");
 
-    return SAI_STATUS_SUCCESS;
+    std_mutex_lock (&sai_vm_lag_lock);
+
+    p_lag = sai_vm_lag_get (lag_id);
+    p_member = (p_lag != NULL) ? sai_vm_lag_member_get (p_lag, port_id) : NULL;
+
+    if (p_member == NULL) {
+        std_mutex_unlock (&sai_vm_lag_lock);
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    if (is_ingress) {
+        /* The bond has no per slave receive state, kept in software only */
+        p_member->ing_disable = value;
+        std_mutex_unlock (&sai_vm_lag_lock);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    /*
+     * A bond slave has no writable transmit state: a member not
+     * distributing traffic is released from the bond and enslaved back
+     * once egress is enabled again.
+     */
+    if ((p_member->if_index != 0) && (p_member->enslaved == value)) {
+        sai_vm_rtnl_batch_init (&batch);
+
+        if (value) {
+            sai_vm_lag_release_msgs_add (&batch, p_member);
+        } else {
+            sai_vm_lag_enslave_msgs_add (&batch, p_lag, p_member);
+        }
+
+        sai_rc = sai_vm_rtnl_batch_commit (sai_vm_lag_sock, &batch, NULL, NULL);
+        sai_vm_rtnl_batch_free (&batch);
+
+        if (sai_rc == SAI_STATUS_SUCCESS) {
+            p_member->enslaved = !value;
+        }
+    }
+
+    if (sai_rc == SAI_STATUS_SUCCESS) {
+        p_member->egr_disable = value;
+    }
+
+    std_mutex_unlock (&sai_vm_lag_lock);
+
+    return sai_rc;
 }
 
 static sai_status_t sai_npu_lag_port_flag_get (sai_object_id_t  lag_id,
@@ -120,10 +653,28 @@ static sai_status_t sai_npu_lag_port_flag_get (sai_object_id_t  lag_id,
                                                bool             is_ingress,
                                                bool            *value)
 {
+    sai_vm_lag_t        *p_lag = NULL;
+    sai_vm_lag_member_t *p_member = NULL;
     SAI_LAG_LOG_TRACE ("LAG port flag get, LAG ID: 0x%"PRIx64" "
                        "Port ID: 0x%"PRIx64" Direction: %s.",
                        lag_id, port_id, (is_ingress) ? "Ingress" : "Egress");
 
+    STD_ASSERT (value != NULL);
+
+    std_mutex_lock (&sai_vm_lag_lock);
+
+    p_lag = sai_vm_lag_get (lag_id);
+    p_member = (p_lag != NULL) ? sai_vm_lag_member_get (p_lag, port_id) : NULL;
+
+    if (p_member == NULL) {
+        std_mutex_unlock (&sai_vm_lag_lock);
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    *value = (is_ingress) ? p_member->ing_disable : p_member->egr_disable;
+
+    std_mutex_unlock (&sai_vm_lag_lock);
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -141,6 +692,131 @@ static sai_status_t sai_npu_lag_attr_get_from_member (sai_object_id_t lag_id,
     return SAI_STATUS_SUCCESS;
 }
 
+static uint_t sai_vm_lag_hash_fields_to_class (const sai_s32_list_t *native_field_list)
+{
+    uint_t hash_class = 0;
+    uint_t index;
+
+    for (index = 0; index < native_field_list->count; index++) {
+        switch (native_field_list->list[index]) {
+            case SAI_NATIVE_HASH_FIELD_SRC_IP:
+            case SAI_NATIVE_HASH_FIELD_DST_IP:
+            case SAI_NATIVE_HASH_FIELD_IP_PROTOCOL:
+                hash_class |= SAI_VM_LAG_HASH_CLASS_L3;
+                break;
+
+            case SAI_NATIVE_HASH_FIELD_INNER_SRC_IP:
+            case SAI_NATIVE_HASH_FIELD_INNER_DST_IP:
+                hash_class |= (SAI_VM_LAG_HASH_CLASS_L3 | SAI_VM_LAG_HASH_CLASS_INNER);
+                break;
+
+            case SAI_NATIVE_HASH_FIELD_L4_SRC_PORT:
+            case SAI_NATIVE_HASH_FIELD_L4_DST_PORT:
+                hash_class |= (SAI_VM_LAG_HASH_CLASS_L3 | SAI_VM_LAG_HASH_CLASS_L4);
+                break;
+
+            default:
+                /* MAC, ethertype, VLAN and in port are covered by layer2 */
+                break;
+        }
+    }
+
+    return hash_class;
+}
+
+static uint8_t sai_vm_lag_hash_class_to_policy (uint_t hash_class)
+{
+    if (hash_class & SAI_VM_LAG_HASH_CLASS_INNER) {
+        return (hash_class & SAI_VM_LAG_HASH_CLASS_L4) ?
+            BOND_XMIT_POLICY_ENCAP34 : BOND_XMIT_POLICY_ENCAP23;
+    }
+
+    if (hash_class & SAI_VM_LAG_HASH_CLASS_L4) {
+        return BOND_XMIT_POLICY_LAYER34;
+    }
+
+    if (hash_class & SAI_VM_LAG_HASH_CLASS_L3) {
+        return BOND_XMIT_POLICY_LAYER23;
+    }
+
+    return BOND_XMIT_POLICY_LAYER2;
+}
+
+sai_status_t sai_vm_lag_hash_fields_set (sai_attr_id_t attr_id,
+                                         const sai_s32_list_t *native_field_list)
+{
+    sai_status_t        sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_rtnl_batch_t batch;
+    uint_t              hash_attr;
+    uint_t              hash_class = 0;
+    uint8_t             old_policy;
+    uint_t              lag_idx;
+
+    STD_ASSERT (native_field_list != NULL);
+
+    switch (attr_id) {
+        case SAI_SWITCH_ATTR_LAG_HASH:
+            hash_attr = SAI_VM_LAG_HASH_ATTR_DEFAULT;
+            break;
+        case SAI_SWITCH_ATTR_LAG_HASH_IPV4:
+            hash_attr = SAI_VM_LAG_HASH_ATTR_IPV4;
+            break;
+        case SAI_SWITCH_ATTR_LAG_HASH_IPV4_IN_IPV4:
+            hash_attr = SAI_VM_LAG_HASH_ATTR_IPV4_IN_IPV4;
+            break;
+        case SAI_SWITCH_ATTR_LAG_HASH_IPV6:
+            hash_attr = SAI_VM_LAG_HASH_ATTR_IPV6;
+            break;
+        default:
+            /* ECMP hash, not applicable to bond devices */
+            return SAI_STATUS_SUCCESS;
+    }
+
+    std_mutex_lock (&sai_vm_lag_lock);
+
+    old_policy = sai_vm_lag_xmit_hash_policy;
+
+    sai_vm_lag_hash_class[hash_attr] =
+        sai_vm_lag_hash_fields_to_class (native_field_list);
+
+    /* A bond has a single policy, covering the fields of every packet type */
+    for (hash_attr = 0; hash_attr < SAI_VM_LAG_HASH_ATTR_MAX; hash_attr++) {
+        hash_class |= sai_vm_lag_hash_class[hash_attr];
+    }
+
+    sai_vm_lag_xmit_hash_policy = sai_vm_lag_hash_class_to_policy (hash_class);
+
+    if (sai_vm_lag_xmit_hash_policy != old_policy) {
+        SAI_LAG_LOG_TRACE ("Bond xmit hash policy changed from %u to %u.",
+                           old_policy, sai_vm_lag_xmit_hash_policy);
+
+        sai_vm_rtnl_batch_init (&batch);
+
+        for (lag_idx = 0; lag_idx < SAI_VM_SWITCH_MAX_LAG_NUMBER; lag_idx++) {
+            if ((sai_vm_lag_table[lag_idx].in_use) &&
+                (sai_vm_lag_table[lag_idx].if_index != 0)) {
+                sai_vm_lag_link_msg_add (&batch, sai_vm_lag_table[lag_idx].if_index,
+                                         0, 0);
+                sai_vm_lag_bond_info_add (&batch, false);
+            }
+        }
+
+        sai_rc = sai_vm_rtnl_batch_commit (sai_vm_lag_sock, &batch, NULL, NULL);
+        sai_vm_rtnl_batch_free (&batch);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_LAG_LOG_ERR ("Bond xmit hash policy %u update failed, rc %d.",
+                             sai_vm_lag_xmit_hash_policy, sai_rc);
+            /* The policy is kept, so that the caller resetting the previous
+             * hash fields pushes the old policy to every bond again. */
+        }
+    }
+
+    std_mutex_unlock (&sai_vm_lag_lock);
+
+    return sai_rc;
+}
+
 static sai_npu_lag_api_t sai_vm_lag_api_table = {
     sai_npu_lag_init,
     sai_npu_lag_create,
@@ -157,4 +833,3 @@ sai_npu_lag_api_t* sai_vm_lag_api_query (void)
 {
     return &sai_vm_lag_api_table;
 }
-
@@ -15,24 +15,572 @@
  */
 
 /**
-* @file sai_vm_l2mc.c
+* @file sai_vm_mcast.c
 *
-* @brief This file contains L2MC implementation APIs for sai-vm.
+* @brief This file contains the L2 multicast entry APIs for sai-vm, rendering
+*        the entries and their member ports into the MDB of the kernel
+*        VLAN bridges.
+*
+*        Only bridge ports with a front panel interface in the switch
+*        namespace are rendered. Members on LAG bridge ports are kept in
+*        software only, their bond devices are not bridge members there.
 *************************************************************************/
 
 #include "std_assert.h"
+#include "std_rbtree.h"
+#include "std_mutex_lock.h"
+#include "std_thread_tools.h"
+#include "std_struct_utils.h"
 #include "saistatus.h"
 #include "sai_npu_mcast.h"
+#include "sai_mcast_common.h"
+#include "sai_mcast_api.h"
+#include "sai_l2mc_common.h"
+#include "sai_l2mc_api.h"
+#include "sai_vlan_api.h"
+#include "sai_oid_utils.h"
+#include "sai_gen_utils.h"
+#include "sai_vm_mcast.h"
+#include "sai_vm_rtnl.h"
+#include "sai_vm_bridge_link.h"
 
-static sai_status_t sai_vm_mcast_init(void)
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <linux/if_ether.h>
+#include <linux/if_bridge.h>
+#include <arpa/inet.h>
+
+/* Kernel MDB entry of a port on a VLAN bridge */
+typedef struct _sai_vm_mdb_key_t {
+    int              port_if_index;
+    sai_vlan_id_t    vlan_id;
+    sai_ip_address_t grp_addr;
+    /* All zero for a (*,G) entry */
+    sai_ip_address_t src_addr;
+} sai_vm_mdb_key_t;
+
+/* Queued MDB change, the last update of an entry wins */
+typedef struct _sai_vm_mdb_op_t {
+    sai_vm_mdb_key_t key;
+    bool             is_sg;
+    bool             add;
+} sai_vm_mdb_op_t;
+
+static rbtree_handle sai_vm_mdb_pending_tree = NULL;
+static std_mutex_lock_create_static_init_fast(sai_vm_mdb_lock);
+
+/* Serializes the flushes, so that the kernel sees the changes in order */
+static std_mutex_lock_create_static_init_fast(sai_vm_mdb_flush_lock);
+
+/*
+ * rtnetlink socket in the switch namespace, invalid when the entries are
+ * kept in software only. Used with the flush lock held.
+ */
+static int sai_vm_mdb_sock = STD_INVALID_FD;
+
+static int sai_vm_mdb_wake_fd [2] = {STD_INVALID_FD, STD_INVALID_FD};
+static std_thread_create_param_t sai_vm_mdb_thread;
+
+static void sai_vm_mdb_addr_fill (struct br_mdb_entry *p_entry,
+                                  const sai_ip_address_t *p_grp_addr)
+{
+    if (p_grp_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        p_entry->addr.proto = htons (ETH_P_IP);
+        p_entry->addr.u.ip4 = p_grp_addr->addr.ip4;
+    } else {
+        p_entry->addr.proto = htons (ETH_P_IPV6);
+        memcpy (&p_entry->addr.u.ip6, p_grp_addr->addr.ip6, sizeof (p_entry->addr.u.ip6));
+    }
+}
+
+static void sai_vm_mdb_src_attr_add (sai_vm_rtnl_batch_t *batch,
+                                     const sai_ip_address_t *p_src_addr)
+{
+    size_t nest = sai_vm_rtnl_nest_begin (batch, MDBA_SET_ENTRY_ATTRS);
+
+    if (p_src_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        sai_vm_rtnl_attr_add (batch, MDBE_ATTR_SOURCE, &p_src_addr->addr.ip4,
+                              sizeof (p_src_addr->addr.ip4));
+    } else {
+        sai_vm_rtnl_attr_add (batch, MDBE_ATTR_SOURCE, p_src_addr->addr.ip6,
+                              sizeof (p_src_addr->addr.ip6));
+    }
+
+    sai_vm_rtnl_nest_end (batch, nest);
+}
+
+/* Batch being built and change being rendered on each bridge member */
+typedef struct _sai_vm_mdb_msg_ctx_t {
+    sai_vm_rtnl_batch_t   *batch;
+    const sai_vm_mdb_op_t *p_op;
+} sai_vm_mdb_msg_ctx_t;
+
+static void sai_vm_mdb_member_msg_add (int br_if_index, int if_index, void *ctx)
+{
+    sai_vm_mdb_msg_ctx_t  *p_ctx = (sai_vm_mdb_msg_ctx_t *) ctx;
+    const sai_vm_mdb_op_t *p_op = p_ctx->p_op;
+    struct br_port_msg     bpm;
+    struct br_mdb_entry    entry;
+
+    memset (&bpm, 0, sizeof (bpm));
+    bpm.family = AF_BRIDGE;
+    bpm.ifindex = br_if_index;
+
+    /* The VLAN bridges are not VLAN aware, the entries carry no VID */
+    memset (&entry, 0, sizeof (entry));
+    entry.ifindex = if_index;
+    entry.state = MDB_PERMANENT;
+    sai_vm_mdb_addr_fill (&entry, &p_op->key.grp_addr);
+
+    sai_vm_rtnl_batch_msg_add (p_ctx->batch, p_op->add ? RTM_NEWMDB : RTM_DELMDB,
+                               p_op->add ? NLM_F_CREATE : 0, &bpm, sizeof (bpm));
+    sai_vm_rtnl_attr_add (p_ctx->batch, MDBA_SET_ENTRY, &entry, sizeof (entry));
+
+    if (p_op->is_sg) {
+        sai_vm_mdb_src_attr_add (p_ctx->batch, &p_op->key.src_addr);
+    }
+}
+
+/*
+ * An entry already in the requested state is not an error: the kernel is
+ * only ever written from the SAI cache, after a reconcile at init.
+ */
+static sai_status_t sai_vm_mdb_batch_status_get (const sai_vm_rtnl_batch_t *batch,
+                                                 sai_status_t sai_rc)
 {
+    uint32_t msg;
+    int      err;
+
+    if ((sai_rc == SAI_STATUS_SUCCESS) || (batch->msg_err == NULL)) {
+        return sai_rc;
+    }
+
+    for (msg = 0; msg < batch->msg_count; msg++) {
+        err = -batch->msg_err [msg];
+
+        if ((err != 0) && (err != ENOENT) && (err != EEXIST)) {
+            return sai_vm_rtnl_errno_to_sai_status (err);
+        }
+    }
+
     return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t sai_vm_mdb_flush (void)
+{
+    sai_status_t               sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_bridge_link_table_t tbl;
+    sai_vm_rtnl_batch_t        batch;
+    sai_vm_mdb_msg_ctx_t       ctx;
+    sai_vm_mdb_op_t           *p_op = NULL;
+
+    std_mutex_lock (&sai_vm_mdb_flush_lock);
+
+    if (sai_vm_mdb_sock == STD_INVALID_FD) {
+        std_mutex_unlock (&sai_vm_mdb_flush_lock);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    /* The bridge members are resolved once for all the queued changes */
+    sai_rc = sai_vm_bridge_link_table_get (sai_vm_mdb_sock, &tbl);
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        std_mutex_unlock (&sai_vm_mdb_flush_lock);
+        return sai_rc;
+    }
+
+    sai_vm_rtnl_batch_init (&batch);
+    ctx.batch = &batch;
+
+    std_mutex_lock (&sai_vm_mdb_lock);
+
+    while ((p_op = std_rbtree_getfirst (sai_vm_mdb_pending_tree)) != NULL) {
+        std_rbtree_remove (sai_vm_mdb_pending_tree, p_op);
+
+        ctx.p_op = p_op;
+        sai_vm_bridge_vlan_members_walk (&tbl, p_op->key.vlan_id, p_op->key.port_if_index,
+                                         sai_vm_mdb_member_msg_add, &ctx);
+        free (p_op);
+    }
+
+    std_mutex_unlock (&sai_vm_mdb_lock);
+
+    sai_rc = sai_vm_mdb_batch_status_get (&batch,
+                                          sai_vm_rtnl_batch_commit (sai_vm_mdb_sock, &batch,
+                                                                    NULL, NULL));
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_MCAST_LOG_ERR ("Kernel MDB update of %u entries failed, rc %d.",
+                           batch.msg_count, sai_rc);
+    }
+
+    sai_vm_rtnl_batch_free (&batch);
+    sai_vm_bridge_link_table_free (&tbl);
+
+    std_mutex_unlock (&sai_vm_mdb_flush_lock);
+
+    return sai_rc;
+}
+
+static void *sai_vm_mdb_flush_thread (void *param)
+{
+    char wake;
+
+    while (read (sai_vm_mdb_wake_fd [0], &wake, sizeof (wake)) > 0) {
+        /* Let the rest of a membership burst join the batch */
+        usleep (SAI_VM_MDB_FLUSH_DELAY_US);
+
+        sai_vm_mdb_flush ();
+    }
+
+    SAI_MCAST_LOG_ERR ("MDB flusher event queue closed, exiting.");
+    return NULL;
+}
+
+sai_status_t sai_vm_mdb_entry_update (sai_vlan_id_t vlan_id, int port_if_index,
+                                      const sai_ip_address_t *grp_addr,
+                                      const sai_ip_address_t *src_addr, bool add)
+{
+    sai_vm_mdb_op_t  op;
+    sai_vm_mdb_op_t *p_op = NULL;
+    bool             wake = false;
+    char             event = 1;
+
+    STD_ASSERT (grp_addr != NULL);
+
+    if (sai_vm_mdb_pending_tree == NULL) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    /* Zero the padding and unused address bytes, the key is compared raw */
+    memset (&op, 0, sizeof (op));
+    op.key.port_if_index = port_if_index;
+    op.key.vlan_id = vlan_id;
+    op.key.grp_addr.addr_family = grp_addr->addr_family;
+    if (grp_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        op.key.grp_addr.addr.ip4 = grp_addr->addr.ip4;
+    } else {
+        memcpy (op.key.grp_addr.addr.ip6, grp_addr->addr.ip6, sizeof (sai_ip6_t));
+    }
+
+    if (src_addr != NULL) {
+        op.is_sg = true;
+        op.key.src_addr.addr_family = src_addr->addr_family;
+        if (src_addr->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+            op.key.src_addr.addr.ip4 = src_addr->addr.ip4;
+        } else {
+            memcpy (op.key.src_addr.addr.ip6, src_addr->addr.ip6, sizeof (sai_ip6_t));
+        }
+    }
+    op.add = add;
+
+    std_mutex_lock (&sai_vm_mdb_lock);
+
+    p_op = std_rbtree_getexact (sai_vm_mdb_pending_tree, &op);
+
+    if (p_op != NULL) {
+        p_op->add = add;
+    } else {
+        p_op = calloc (1, sizeof (sai_vm_mdb_op_t));
+
+        if (p_op == NULL) {
+            std_mutex_unlock (&sai_vm_mdb_lock);
+            SAI_MCAST_LOG_ERR ("Unable to queue MDB update, memory unavailable.");
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        memcpy (p_op, &op, sizeof (op));
+
+        /* Wake the flusher once per batch */
+        wake = (std_rbtree_getfirst (sai_vm_mdb_pending_tree) == NULL);
+
+        if (std_rbtree_insert (sai_vm_mdb_pending_tree, p_op) != STD_ERR_OK) {
+            std_mutex_unlock (&sai_vm_mdb_lock);
+            free (p_op);
+            return SAI_STATUS_FAILURE;
+        }
+    }
+
+    std_mutex_unlock (&sai_vm_mdb_lock);
+
+    if ((wake) && (sai_vm_mdb_wake_fd [1] != STD_INVALID_FD) &&
+        (write (sai_vm_mdb_wake_fd [1], &event, sizeof (event)) != sizeof (event))) {
+        SAI_MCAST_LOG_ERR ("Writing to MDB event queue failed.");
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Queue the deletion of a stale permanent entry found in an MDB dump */
+static void sai_vm_mdb_stale_entry_add (sai_vm_rtnl_batch_t *batch, int br_if_index,
+                                        struct rtattr *info)
+{
+    struct br_port_msg  bpm;
+    struct br_mdb_entry entry;
+    struct rtattr      *tb [MDBA_MDB_EATTR_MAX + 1];
+    size_t              nest;
+
+    memcpy (&entry, RTA_DATA (info), sizeof (entry));
+
+    if (entry.state != MDB_PERMANENT) {
+        return;
+    }
+
+    memset (&bpm, 0, sizeof (bpm));
+    bpm.family = AF_BRIDGE;
+    bpm.ifindex = br_if_index;
+
+    sai_vm_rtnl_batch_msg_add (batch, RTM_DELMDB, 0, &bpm, sizeof (bpm));
+    sai_vm_rtnl_attr_add (batch, MDBA_SET_ENTRY, &entry, sizeof (entry));
+
+    /* The extended attributes of an entry follow the entry itself */
+    if (RTA_PAYLOAD (info) <= NLA_ALIGN (sizeof (entry))) {
+        return;
+    }
+
+    sai_vm_rtnl_attr_parse (tb, MDBA_MDB_EATTR_MAX,
+                            (struct rtattr *) ((char *) RTA_DATA (info) +
+                                               NLA_ALIGN (sizeof (entry))),
+                            RTA_PAYLOAD (info) - NLA_ALIGN (sizeof (entry)));
+
+    if (tb [MDBA_MDB_EATTR_SOURCE] != NULL) {
+        nest = sai_vm_rtnl_nest_begin (batch, MDBA_SET_ENTRY_ATTRS);
+        sai_vm_rtnl_attr_add (batch, MDBE_ATTR_SOURCE, RTA_DATA (tb [MDBA_MDB_EATTR_SOURCE]),
+                              RTA_PAYLOAD (tb [MDBA_MDB_EATTR_SOURCE]));
+        sai_vm_rtnl_nest_end (batch, nest);
+    }
+}
+
+static void sai_vm_mdb_dump_cb (struct nlmsghdr *hdr, void *ctx)
+{
+    sai_vm_rtnl_batch_t *batch = (sai_vm_rtnl_batch_t *) ctx;
+    struct br_port_msg  *bpm = (struct br_port_msg *) NLMSG_DATA (hdr);
+    struct rtattr       *tb [MDBA_MAX + 1];
+    struct rtattr       *entry = NULL;
+    struct rtattr       *info = NULL;
+    char                 if_name [IF_NAMESIZE];
+    unsigned int         vlan_id = 0;
+    char                 trail = 0;
+    int                  mdb_len;
+    int                  entry_len;
+
+    if (hdr->nlmsg_type != RTM_NEWMDB) {
+        return;
+    }
+
+    /* Only the VLAN bridges are owned by the switch */
+    if ((if_indextoname (bpm->ifindex, if_name) == NULL) ||
+        (sscanf (if_name, SAI_VM_BRIDGE_VLAN_NAME_FMT "%c", &vlan_id, &trail) != 1)) {
+        return;
+    }
+
+    sai_vm_rtnl_attr_parse (tb, MDBA_MAX,
+                            (struct rtattr *) ((char *) bpm + NLMSG_ALIGN (sizeof (*bpm))),
+                            hdr->nlmsg_len - NLMSG_LENGTH (sizeof (*bpm)));
+
+    if (tb [MDBA_MDB] == NULL) {
+        return;
+    }
+
+    mdb_len = RTA_PAYLOAD (tb [MDBA_MDB]);
+
+    for (entry = (struct rtattr *) RTA_DATA (tb [MDBA_MDB]); RTA_OK (entry, mdb_len);
+         entry = RTA_NEXT (entry, mdb_len)) {
+        if ((entry->rta_type & NLA_TYPE_MASK) != MDBA_MDB_ENTRY) {
+            continue;
+        }
+
+        entry_len = RTA_PAYLOAD (entry);
+
+        for (info = (struct rtattr *) RTA_DATA (entry); RTA_OK (info, entry_len);
+             info = RTA_NEXT (info, entry_len)) {
+            if (((info->rta_type & NLA_TYPE_MASK) == MDBA_MDB_ENTRY_INFO) &&
+                (RTA_PAYLOAD (info) >= sizeof (struct br_mdb_entry))) {
+                sai_vm_mdb_stale_entry_add (batch, bpm->ifindex, info);
+            }
+        }
+    }
+}
+
+/*
+ * The SAI cache is empty at init, so every permanent entry left on the VLAN
+ * bridges by a previous run is stale. They are all removed in one batch.
+ */
+static void sai_vm_mdb_reconcile (void)
+{
+    sai_vm_rtnl_batch_t batch;
+    sai_status_t        sai_rc;
+    struct {
+        struct nlmsghdr    hdr;
+        struct br_port_msg bpm;
+    } req;
+
+    memset (&req, 0, sizeof (req));
+    req.hdr.nlmsg_len = NLMSG_LENGTH (sizeof (req.bpm));
+    req.hdr.nlmsg_type = RTM_GETMDB;
+    req.bpm.family = AF_BRIDGE;
+
+    sai_vm_rtnl_batch_init (&batch);
+
+    sai_rc = sai_vm_rtnl_dump (sai_vm_mdb_sock, &req.hdr, sai_vm_mdb_dump_cb, &batch);
+
+    if (sai_rc == SAI_STATUS_SUCCESS) {
+        sai_rc = sai_vm_mdb_batch_status_get (&batch,
+                                              sai_vm_rtnl_batch_commit (sai_vm_mdb_sock,
+                                                                        &batch, NULL, NULL));
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_MCAST_LOG_ERR ("Kernel MDB reconcile failed, rc %d.", sai_rc);
+    } else if (batch.msg_count > 0) {
+        SAI_MCAST_LOG_INFO ("Removed %u stale kernel MDB entries.", batch.msg_count);
+    }
+
+    sai_vm_rtnl_batch_free (&batch);
+}
+
+sai_status_t sai_vm_mdb_init (void)
+{
+    if (sai_vm_mdb_pending_tree != NULL) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_vm_mdb_pending_tree = std_rbtree_create_simple ("SAI VM MDB pending tree",
+            STD_STR_OFFSET_OF (sai_vm_mdb_op_t, key),
+            STD_STR_SIZE_OF (sai_vm_mdb_op_t, key));
+
+    if (sai_vm_mdb_pending_tree == NULL) {
+        SAI_MCAST_LOG_CRIT ("Unable to create MDB pending tree.");
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_vm_mdb_sock = sai_vm_rtnl_switch_ns_open (0);
+    if (sai_vm_mdb_sock == STD_INVALID_FD) {
+        SAI_MCAST_LOG_ERR ("L2 multicast entries are not applied to the kernel bridges.");
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_vm_mdb_reconcile ();
+
+    if (pipe (sai_vm_mdb_wake_fd) != 0) {
+        SAI_MCAST_LOG_ERR ("MDB event queue initialization failed.");
+        sai_vm_mdb_wake_fd [0] = sai_vm_mdb_wake_fd [1] = STD_INVALID_FD;
+        return SAI_STATUS_FAILURE;
+    }
+
+    std_thread_init_struct (&sai_vm_mdb_thread);
+    sai_vm_mdb_thread.name = "sai-vm-mdb";
+    sai_vm_mdb_thread.thread_function = sai_vm_mdb_flush_thread;
+
+    if (std_thread_create (&sai_vm_mdb_thread) != STD_ERR_OK) {
+        SAI_MCAST_LOG_ERR ("MDB flusher thread creation failed.");
+        return SAI_STATUS_FAILURE;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* VLAN of the bridge an L2MC entry is rendered on, 0 if not rendered */
+static sai_vlan_id_t sai_vm_mcast_entry_vlan_get (const dn_sai_mcast_entry_node_t *mcast_entry_node)
+{
+    /* Entries on .1D bridges have no kernel VLAN bridge */
+    if ((mcast_entry_node->owner != SAI_MCAST_OWNER_L2MC) ||
+        (!sai_is_obj_id_vlan (mcast_entry_node->mcast_key.bv_id))) {
+        return 0;
+    }
+
+    return sai_vlan_obj_id_to_vlan_id (mcast_entry_node->mcast_key.bv_id);
+}
+
+static void sai_vm_mcast_member_render (const dn_sai_mcast_entry_node_t *mcast_entry_node,
+                                        sai_vlan_id_t vlan_id,
+                                        sai_object_id_t bridge_port_id, bool add)
+{
+    int port_if_index = sai_vm_bridge_port_if_index_get (bridge_port_id);
+
+    if (port_if_index == 0) {
+        SAI_MCAST_LOG_TRACE ("Bridge port 0x%"PRIx64" has no interface, MDB entry on "
+                             "VLAN %d kept in software only.", bridge_port_id, vlan_id);
+        return;
+    }
+
+    sai_vm_mdb_entry_update (vlan_id, port_if_index, &mcast_entry_node->mcast_key.grp_addr,
+                             (mcast_entry_node->entry_type == SAI_MCAST_ENTRY_TYPE_SG) ?
+                             &mcast_entry_node->mcast_key.src_addr : NULL, add);
+}
+
+static void sai_vm_mcast_entry_render (const dn_sai_mcast_entry_node_t *mcast_entry_node,
+                                       bool add)
+{
+    dn_sai_l2mc_group_node_t      *l2mc_group_node = NULL;
+    dn_sai_l2mc_member_dll_node_t *l2mc_member_dll_node = NULL;
+    std_dll                       *node = NULL;
+    sai_vlan_id_t                  vlan_id = sai_vm_mcast_entry_vlan_get (mcast_entry_node);
+
+    if (vlan_id == 0) {
+        return;
+    }
+
+    l2mc_group_node = sai_find_l2mc_group_node (mcast_entry_node->mcast_group_id);
+    if (l2mc_group_node == NULL) {
+        return;
+    }
+
+    for (node = std_dll_getfirst (&(l2mc_group_node->member_list)); node != NULL;
+         node = std_dll_getnext (&(l2mc_group_node->member_list), node)) {
+        l2mc_member_dll_node = (dn_sai_l2mc_member_dll_node_t *) node;
+
+        sai_vm_mcast_member_render (mcast_entry_node, vlan_id,
+                                    l2mc_member_dll_node->l2mc_member_info->bridge_port_id,
+                                    add);
+    }
+}
+
+void sai_vm_mcast_l2mc_member_update (const dn_sai_l2mc_member_node_t *l2mc_member_node,
+                                      bool add)
+{
+    dn_sai_mcast_entry_key_t   mcast_key;
+    dn_sai_mcast_entry_node_t *mcast_entry_node = NULL;
+    sai_vlan_id_t              vlan_id;
+
+    STD_ASSERT (l2mc_member_node != NULL);
+
+    memset (&mcast_key, 0, sizeof (mcast_key));
+
+    sai_mcast_lock ();
+
+    for (mcast_entry_node = sai_get_next_mcast_entry (&mcast_key); mcast_entry_node != NULL;
+         mcast_entry_node = sai_get_next_mcast_entry (&mcast_entry_node->mcast_key)) {
+        if (mcast_entry_node->mcast_group_id != l2mc_member_node->l2mc_group_id) {
+            continue;
+        }
+
+        vlan_id = sai_vm_mcast_entry_vlan_get (mcast_entry_node);
+
+        if (vlan_id != 0) {
+            sai_vm_mcast_member_render (mcast_entry_node, vlan_id,
+                                        l2mc_member_node->bridge_port_id, add);
+        }
+    }
+
+    sai_mcast_unlock ();
+}
+
+static sai_status_t sai_vm_mcast_init(void)
+{
+    return sai_vm_mdb_init ();
+}
+
 static sai_status_t sai_vm_mcast_entry_create(const dn_sai_mcast_entry_node_t *mcast_entry_node)
 {
     STD_ASSERT(mcast_entry_node != NULL);
 
+    sai_vm_mcast_entry_render (mcast_entry_node, true);
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -40,6 +588,8 @@ static sai_status_t sai_vm_mcast_entry_remove(const dn_sai_mcast_entry_node_t *m
 {
     STD_ASSERT(mcast_entry_node != NULL);
 
+    sai_vm_mcast_entry_render (mcast_entry_node, false);
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -53,4 +603,3 @@ sai_npu_mcast_api_t* sai_vm_mcast_api_query (void)
 {
     return &sai_vm_mcast_api_table;
 }
-
@@ -29,21 +29,124 @@
 #include "sai_vlan_common.h"
 #include "sai_stp_util.h"
 #include "sai_vm_defs.h"
+#include "sai_vm_rtnl.h"
+#include "sai_vm_bridge_link.h"
+#include "sai_stp_api.h"
+#include "sai_bridge_api.h"
 #include "saistp.h"
 #include "saivlan.h"
 #include "saitypes.h"
 #include "saistatus.h"
 
 #include "std_assert.h"
+#include "std_rbtree.h"
 
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
-#include <stdio.h>
-
+#include <sys/socket.h>
+#include <linux/if_link.h>
+#include <linux/if_bridge.h>
 
 static bool stp_id_in_use[SAI_VM_SWITCH_MAX_STP_INSTANCES];
 static int  default_stp_id = 0;
 
+/*
+ * rtnetlink socket in the switch namespace, invalid when the port states are
+ * kept in software only. All the users run with the STP lock held.
+ */
+static int  sai_vm_stp_sock = STD_INVALID_FD;
+
+static uint8_t sai_vm_stp_state_to_br_state (sai_stp_port_state_t port_state)
+{
+    switch (port_state) {
+        case SAI_STP_PORT_STATE_LEARNING:
+            return BR_STATE_LEARNING;
+        case SAI_STP_PORT_STATE_FORWARDING:
+            return BR_STATE_FORWARDING;
+        case SAI_STP_PORT_STATE_BLOCKING:
+        default:
+            return BR_STATE_BLOCKING;
+    }
+}
+
+static void sai_vm_stp_brport_state_msg_add (sai_vm_rtnl_batch_t *batch,
+                                             int if_index, uint8_t br_state)
+{
+    struct ifinfomsg ifi;
+    size_t           protinfo;
+
+    memset (&ifi, 0, sizeof (ifi));
+    ifi.ifi_family = AF_BRIDGE;
+    ifi.ifi_index = if_index;
+
+    sai_vm_rtnl_batch_msg_add (batch, RTM_SETLINK, 0, &ifi, sizeof (ifi));
+
+    protinfo = sai_vm_rtnl_nest_begin (batch, IFLA_PROTINFO);
+    sai_vm_rtnl_attr_add (batch, IFLA_BRPORT_STATE, &br_state, sizeof (br_state));
+    sai_vm_rtnl_nest_end (batch, protinfo);
+}
+
+/* Batch and state of the messages added for the members of a VLAN bridge */
+typedef struct _sai_vm_stp_msg_ctx_t {
+    sai_vm_rtnl_batch_t *batch;
+    uint8_t              br_state;
+} sai_vm_stp_msg_ctx_t;
+
+static void sai_vm_stp_member_msg_add (int br_if_index, int if_index, void *ctx)
+{
+    sai_vm_stp_msg_ctx_t *p_ctx = (sai_vm_stp_msg_ctx_t *) ctx;
+
+    sai_vm_stp_brport_state_msg_add (p_ctx->batch, if_index, p_ctx->br_state);
+}
+
+/*
+ * Add the state messages of the members of the VLAN bridge backed by the
+ * port, either the port interface itself or a VLAN device on top of it.
+ */
+static void sai_vm_stp_vlan_msgs_add (sai_vm_rtnl_batch_t *batch,
+                                      const sai_vm_bridge_link_table_t *p_tbl,
+                                      sai_vlan_id_t vlan_id, int port_if_index,
+                                      uint8_t br_state)
+{
+    sai_vm_stp_msg_ctx_t ctx;
+
+    ctx.batch = batch;
+    ctx.br_state = br_state;
+
+    sai_vm_bridge_vlan_members_walk (p_tbl, vlan_id, port_if_index,
+                                     sai_vm_stp_member_msg_add, &ctx);
+}
+
+/* Add the state messages of a port on all the VLAN bridges of an instance */
+static void sai_vm_stp_port_msgs_add (sai_vm_rtnl_batch_t *batch,
+                                      const sai_vm_bridge_link_table_t *p_tbl,
+                                      sai_object_id_t stp_inst_id,
+                                      sai_object_id_t bridge_port_id,
+                                      sai_stp_port_state_t port_state)
+{
+    dn_sai_stp_info_t *p_stp_info = NULL;
+    sai_vlan_id_t     *p_vlan_id = NULL;
+    uint8_t            br_state = sai_vm_stp_state_to_br_state (port_state);
+    int                port_if_index = 0;
+
+    p_stp_info = (dn_sai_stp_info_t *) std_rbtree_getexact (
+                                sai_stp_global_info_tree_get (), (void *) &stp_inst_id);
+    if ((p_stp_info == NULL) || (p_stp_info->vlan_tree == NULL)) {
+        return;
+    }
+
+    port_if_index = sai_vm_bridge_port_if_index_get (bridge_port_id);
+    if (port_if_index == 0) {
+        return;
+    }
+
+    for (p_vlan_id = std_rbtree_getfirst (p_stp_info->vlan_tree); p_vlan_id != NULL;
+         p_vlan_id = std_rbtree_getnext (p_stp_info->vlan_tree, p_vlan_id)) {
+        sai_vm_stp_vlan_msgs_add (batch, p_tbl, *p_vlan_id, port_if_index, br_state);
+    }
+}
+
 static sai_status_t sai_npu_stp_instance_create (sai_npu_object_id_t *p_stp_id)
 {
     uint_t stp_idx;
@@ -96,25 +199,187 @@ static sai_status_t sai_npu_stp_init(sai_npu_object_id_t *p_default_stp_instance
     sai_npu_stp_instance_create(p_default_stp_instance);
     default_stp_id = *p_default_stp_instance;
     sai_npu_stp_instance_create(p_l3_stp_instance);
+
+    sai_vm_stp_sock = sai_vm_rtnl_switch_ns_open (0);
+    if (sai_vm_stp_sock == STD_INVALID_FD) {
+        SAI_STP_LOG_ERR ("STP port states are not applied to the kernel bridges.");
+    }
     return SAI_STATUS_SUCCESS;
 }
+
+/*
+ * All the states go out as one rtnetlink batch: a topology change touching
+ * many ports, each on many VLAN bridges, costs one link dump and one sendmsg.
+ */
+static sai_status_t sai_npu_stp_port_state_bulk_set (uint32_t count,
+                                                     const sai_object_id_t *stp_inst_list,
+                                                     const sai_object_id_t *port_list,
+                                                     const sai_stp_port_state_t *state_list,
+                                                     sai_status_t *status_list)
+{
+    sai_status_t                sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_bridge_link_table_t  tbl;
+    sai_vm_rtnl_batch_t         batch;
+    uint32_t                   *first_msg = NULL;
+    uint32_t                    idx;
+    uint32_t                    msg;
+
+    STD_ASSERT (stp_inst_list != NULL);
+    STD_ASSERT (port_list != NULL);
+    STD_ASSERT (state_list != NULL);
+    STD_ASSERT (status_list != NULL);
+
+    for (idx = 0; idx < count; idx++) {
+        status_list [idx] = SAI_STATUS_SUCCESS;
+    }
+
+    if ((sai_vm_stp_sock == STD_INVALID_FD) || (count == 0)) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    first_msg = calloc (count + 1, sizeof (uint32_t));
+    if (first_msg == NULL) {
+        sai_rc = SAI_STATUS_NO_MEMORY;
+    } else {
+        sai_rc = sai_vm_bridge_link_table_get (sai_vm_stp_sock, &tbl);
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        for (idx = 0; idx < count; idx++) {
+            status_list [idx] = sai_rc;
+        }
+        free (first_msg);
+        return sai_rc;
+    }
+
+    sai_vm_rtnl_batch_init (&batch);
+
+    for (idx = 0; idx < count; idx++) {
+        first_msg [idx] = batch.msg_count;
+        sai_vm_stp_port_msgs_add (&batch, &tbl, stp_inst_list [idx], port_list [idx],
+                                  state_list [idx]);
+    }
+    first_msg [count] = batch.msg_count;
+
+    sai_rc = sai_vm_rtnl_batch_commit (sai_vm_stp_sock, &batch, NULL, NULL);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_STP_LOG_ERR ("Kernel bridge port state set of %u ports failed, rc %d.",
+                         count, sai_rc);
+
+        for (idx = 0; idx < count; idx++) {
+            for (msg = first_msg [idx]; msg < first_msg [idx + 1]; msg++) {
+                /* The batch was not sent at all */
+                if (batch.msg_err == NULL) {
+                    status_list [idx] = sai_rc;
+                    break;
+                }
+                if (batch.msg_err [msg] != 0) {
+                    status_list [idx] =
+                        sai_vm_rtnl_errno_to_sai_status (-batch.msg_err [msg]);
+                    break;
+                }
+            }
+        }
+    }
+
+    sai_vm_rtnl_batch_free (&batch);
+    sai_vm_bridge_link_table_free (&tbl);
+    free (first_msg);
+
+    return sai_rc;
+}
+
 static sai_status_t sai_npu_stp_port_state_set (sai_object_id_t stp_inst_id,
                                                 sai_object_id_t port_id,
                                                 sai_stp_port_state_t port_state)
 {
+    sai_status_t status = SAI_STATUS_SUCCESS;
 
-    return SAI_STATUS_SUCCESS;
+    return sai_npu_stp_port_state_bulk_set (1, &stp_inst_id, &port_id, &port_state,
+                                            &status);
 }
 
 static sai_status_t sai_npu_stp_port_state_get (sai_object_id_t stp_inst_id,
                                                 sai_object_id_t port_id,
                                                 sai_stp_port_state_t *port_state)
 {
+    dn_sai_stp_info_t      *p_stp_info = NULL;
+    dn_sai_stp_port_info_t  stp_port_info;
+    dn_sai_stp_port_info_t *p_stp_port_info = NULL;
+
     STD_ASSERT (port_state != NULL);
 
+    p_stp_info = (dn_sai_stp_info_t *) std_rbtree_getexact (
+                                sai_stp_global_info_tree_get (), (void *) &stp_inst_id);
+    if (p_stp_info == NULL) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    memset (&stp_port_info, 0, sizeof (stp_port_info));
+    stp_port_info.bridge_port_id = port_id;
+
+    p_stp_port_info = (dn_sai_stp_port_info_t *) std_rbtree_getexact (
+                                p_stp_info->stp_port_tree, (void *) &stp_port_info);
+    if (p_stp_port_info == NULL) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    /* The kernel bridges are only ever written from this cache */
+    *port_state = p_stp_port_info->port_state;
+
     return SAI_STATUS_SUCCESS;
 }
 
+/* Apply the port states of an instance to the bridge of a VLAN joining it */
+static void sai_vm_stp_vlan_port_states_apply (sai_object_id_t stp_inst_id,
+                                               sai_vlan_id_t vlan_id)
+{
+    dn_sai_stp_info_t          *p_stp_info = NULL;
+    dn_sai_stp_port_info_t     *p_stp_port_info = NULL;
+    sai_vm_bridge_link_table_t  tbl;
+    sai_vm_rtnl_batch_t         batch;
+    sai_status_t                sai_rc;
+    int                         port_if_index;
+
+    if (sai_vm_stp_sock == STD_INVALID_FD) {
+        return;
+    }
+
+    p_stp_info = (dn_sai_stp_info_t *) std_rbtree_getexact (
+                                sai_stp_global_info_tree_get (), (void *) &stp_inst_id);
+    if ((p_stp_info == NULL) || (p_stp_info->num_ports == 0)) {
+        return;
+    }
+
+    if (sai_vm_bridge_link_table_get (sai_vm_stp_sock, &tbl) != SAI_STATUS_SUCCESS) {
+        return;
+    }
+
+    sai_vm_rtnl_batch_init (&batch);
+
+    for (p_stp_port_info = std_rbtree_getfirst (p_stp_info->stp_port_tree);
+         p_stp_port_info != NULL;
+         p_stp_port_info = std_rbtree_getnext (p_stp_info->stp_port_tree, p_stp_port_info)) {
+        port_if_index = sai_vm_bridge_port_if_index_get (p_stp_port_info->bridge_port_id);
+
+        if (port_if_index != 0) {
+            sai_vm_stp_vlan_msgs_add (&batch, &tbl, vlan_id, port_if_index,
+                                      sai_vm_stp_state_to_br_state (p_stp_port_info->port_state));
+        }
+    }
+
+    sai_rc = sai_vm_rtnl_batch_commit (sai_vm_stp_sock, &batch, NULL, NULL);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_STP_LOG_ERR ("Kernel bridge port states of vlan %u on STP 0x%"PRIx64" "
+                         "not applied, rc %d.", vlan_id, stp_inst_id, sai_rc);
+    }
+
+    sai_vm_rtnl_batch_free (&batch);
+    sai_vm_bridge_link_table_free (&tbl);
+}
+
 static sai_status_t sai_npu_stp_vlan_add (sai_object_id_t stp_inst_id,
                                           sai_vlan_id_t vlan_id)
 {
@@ -141,6 +406,8 @@ static sai_status_t sai_npu_stp_vlan_add (sai_object_id_t stp_inst_id,
         return SAI_STATUS_FAILURE;
     }
 
+    sai_vm_stp_vlan_port_states_apply (stp_inst_id, vlan_id);
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -194,6 +461,7 @@ static sai_npu_stp_api_t sai_vm_stp_api_table = {
     sai_npu_vlan_stp_get,
     sai_npu_stp_port_notif_handler,
     sai_npu_stp_port_lag_handler,
+    sai_npu_stp_port_state_bulk_set,
 };
 
 sai_npu_stp_api_t* sai_vm_stp_api_query (void)
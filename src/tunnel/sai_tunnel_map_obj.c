@@ -486,6 +486,7 @@ static sai_status_t dn_sai_create_tunnel_map_entry(sai_object_id_t *tunnel_map_e
 
         p_tunnel_map->ref_count++;
         p_bridge_info->ref_count++;
+        sai_bridge_cache_publish(bridge_oid);
 
         *tunnel_map_entry_id = p_tunnel_map_entry->tunnel_map_entry_id;
 
@@ -625,6 +626,7 @@ static sai_status_t dn_sai_remove_tunnel_map_entry(sai_object_id_t tunnel_map_en
 
         p_tunnel_map->ref_count--;
         p_bridge_info->ref_count--;
+        sai_bridge_cache_publish(bridge_oid);
 
         free(p_tunnel_map_entry);
 
@@ -784,6 +786,8 @@ static sai_status_t dn_sai_set_tunnel_map_entry_attr(sai_object_id_t tunnel_map_
             p_old_bridge_info->ref_count--;
             p_tunnel_map_entry->value.bridge_oid = attr->value.oid;
             p_bridge_info->ref_count++;
+            sai_bridge_cache_publish(old_bridge_oid);
+            sai_bridge_cache_publish(attr->value.oid);
 
         } else if(attr->id == SAI_TUNNEL_MAP_ENTRY_ATTR_VNI_ID_VALUE) {
             p_tunnel_map_entry->value.vnid = attr->value.u32;
@@ -24,20 +24,1060 @@
 #include "saistatus.h"
 #include "saitypes.h"
 #include "sai_tunnel.h"
+#include "sai_tunnel_util.h"
 #include "sai_tunnel_npu_api.h"
 #include "sai_common_utils.h"
+#include "sai_oid_utils.h"
+#include "sai_l3_util.h"
+#include "sai_vm_tunnel.h"
+#include "sai_vm_rtnl.h"
 #include "std_type_defs.h"
 #include "std_assert.h"
+#include "std_rbtree.h"
+#include "std_mutex_lock.h"
+#include "std_thread_tools.h"
+#include "std_struct_utils.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/if_link.h>
+#include <linux/if_tunnel.h>
+#include <linux/ip6_tunnel.h>
+#include <linux/neighbour.h>
+#include <linux/rtnetlink.h>
+#ifdef RTM_NEWNEXTHOP
+#include <linux/nexthop.h>
+#endif
+
+/* Tunnel counters read from the device counters */
+typedef enum _sai_vm_tunnel_stat_t {
+    SAI_VM_TUNNEL_STAT_IN_OCTETS,
+    SAI_VM_TUNNEL_STAT_IN_PACKETS,
+    SAI_VM_TUNNEL_STAT_OUT_OCTETS,
+    SAI_VM_TUNNEL_STAT_OUT_PACKETS,
+    SAI_VM_TUNNEL_STAT_MAX
+} sai_vm_tunnel_stat_t;
+
+/* VNI in the VNI filter of a vxlan device, one reference per map entry */
+typedef struct _sai_vm_tunnel_vni_t {
+    uint32_t vni;
+    uint_t   ref_count;
+} sai_vm_tunnel_vni_t;
+
+/* Remote in the flood list of a vxlan device, one reference per encap next hop */
+typedef struct _sai_vm_tunnel_remote_t {
+    sai_ip_address_t ip;
+    uint_t           ref_count;
+} sai_vm_tunnel_remote_t;
+
+typedef struct _sai_vm_tunnel_hw_info_t {
+    /* Interface index of the tunnel device, 0 if the tunnel is in software only */
+    int           if_index;
+    char          if_name [IFNAMSIZ];
+    bool          is_vxlan;
+    rbtree_handle vni_tree;
+    rbtree_handle remote_tree;
+    /* Device counters at the last clear */
+    uint64_t      stat_base [SAI_VM_TUNNEL_STAT_MAX];
+} sai_vm_tunnel_hw_info_t;
+
+typedef enum _sai_vm_tunnel_op_type_t {
+    /* VNI filter entry */
+    SAI_VM_TUNNEL_OP_VNI,
+    /* All zero MAC flood entry of a VNI towards a remote */
+    SAI_VM_TUNNEL_OP_FLOOD,
+} sai_vm_tunnel_op_type_t;
+
+typedef struct _sai_vm_tunnel_op_key_t {
+    int              if_index;
+    uint32_t         type;
+    uint32_t         vni;
+    /* All zero for a VNI filter entry */
+    sai_ip_address_t remote;
+} sai_vm_tunnel_op_key_t;
+
+/* Queued vxlan device change, the last update of an entry wins */
+typedef struct _sai_vm_tunnel_op_t {
+    sai_vm_tunnel_op_key_t key;
+    bool                   add;
+} sai_vm_tunnel_op_t;
 
 static sai_npu_tunnel_api_t sai_vm_tunnel_api_table;
 
+/* Protects the VNI and remote trees of the devices and the pending tree */
+static std_mutex_lock_create_static_init_fast(sai_vm_tunnel_lock);
+
+static rbtree_handle sai_vm_tunnel_pending_tree = NULL;
+
+/* Serializes the use of the socket, so that the kernel sees the changes in order */
+static std_mutex_lock_create_static_init_fast(sai_vm_tunnel_sock_lock);
+
+/*
+ * rtnetlink socket in the switch namespace, invalid when the tunnels are
+ * kept in software only. Used with the socket lock held.
+ */
+static int sai_vm_tunnel_sock = STD_INVALID_FD;
+
+static int sai_vm_tunnel_wake_fd [2] = {STD_INVALID_FD, STD_INVALID_FD};
+static std_thread_create_param_t sai_vm_tunnel_thread;
+
+/* Copy an address zeroing the unused bytes, the tree keys are compared raw */
+static void sai_vm_tunnel_ip_copy (sai_ip_address_t *p_dst, const sai_ip_address_t *p_src)
+{
+    memset (p_dst, 0, sizeof (*p_dst));
+    p_dst->addr_family = p_src->addr_family;
+
+    if (p_src->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        p_dst->addr.ip4 = p_src->addr.ip4;
+    } else {
+        memcpy (p_dst->addr.ip6, p_src->addr.ip6, sizeof (sai_ip6_t));
+    }
+}
+
+static bool sai_vm_tunnel_ip_is_zero (const sai_ip_address_t *p_ip)
+{
+    static const sai_ip6_t zero_ip6;
+
+    if (p_ip->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        return (p_ip->addr.ip4 == 0);
+    }
+
+    return (memcmp (p_ip->addr.ip6, zero_ip6, sizeof (zero_ip6)) == 0);
+}
+
+static void sai_vm_tunnel_ip_attr_add (sai_vm_rtnl_batch_t *batch, uint16_t ip4_type,
+                                       uint16_t ip6_type, const sai_ip_address_t *p_ip)
+{
+    if (p_ip->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        sai_vm_rtnl_attr_add (batch, ip4_type, &p_ip->addr.ip4, sizeof (p_ip->addr.ip4));
+    } else {
+        sai_vm_rtnl_attr_add (batch, ip6_type, p_ip->addr.ip6, sizeof (sai_ip6_t));
+    }
+}
+
+/* Add the all zero MAC flood entry change of a VNI towards a remote */
+static void sai_vm_tunnel_flood_msg_add (sai_vm_rtnl_batch_t *batch,
+                                         const sai_vm_tunnel_op_t *p_op)
+{
+    static const uint8_t zero_mac [ETH_ALEN];
+    struct ndmsg         ndm;
+
+    memset (&ndm, 0, sizeof (ndm));
+    ndm.ndm_family = AF_BRIDGE;
+    ndm.ndm_ifindex = p_op->key.if_index;
+    ndm.ndm_state = NUD_PERMANENT;
+    ndm.ndm_flags = NTF_SELF;
+
+    /* An all zero MAC entry holds the list of remotes flooded for the VNI */
+    sai_vm_rtnl_batch_msg_add (batch, p_op->add ? RTM_NEWNEIGH : RTM_DELNEIGH,
+                               p_op->add ? (NLM_F_CREATE | NLM_F_APPEND) : 0,
+                               &ndm, sizeof (ndm));
+    sai_vm_rtnl_attr_add (batch, NDA_LLADDR, zero_mac, sizeof (zero_mac));
+    sai_vm_tunnel_ip_attr_add (batch, NDA_DST, NDA_DST, &p_op->key.remote);
+    sai_vm_rtnl_attr_add (batch, NDA_VNI, &p_op->key.vni, sizeof (p_op->key.vni));
+    sai_vm_rtnl_attr_add (batch, NDA_SRC_VNI, &p_op->key.vni, sizeof (p_op->key.vni));
+}
+
+/*
+ * Add the queued VNI filter additions or deletions, one message per device
+ * carrying up to SAI_VM_TUNNEL_VNIS_PER_MSG entries. The pending changes of
+ * a device are contiguous in the tree.
+ */
+static void sai_vm_tunnel_vni_msgs_add (sai_vm_rtnl_batch_t *batch, bool add)
+{
+#ifdef RTM_NEWTUNNEL
+    sai_vm_tunnel_op_t *p_op = NULL;
+    struct tunnel_msg   tmsg;
+    size_t              nest;
+    int                 if_index = 0;
+    uint_t              vni_count = 0;
+
+    for (p_op = std_rbtree_getfirst (sai_vm_tunnel_pending_tree); p_op != NULL;
+         p_op = std_rbtree_getnext (sai_vm_tunnel_pending_tree, p_op)) {
+        if ((p_op->key.type != SAI_VM_TUNNEL_OP_VNI) || (p_op->add != add)) {
+            continue;
+        }
+
+        if ((p_op->key.if_index != if_index) || (vni_count == SAI_VM_TUNNEL_VNIS_PER_MSG)) {
+            memset (&tmsg, 0, sizeof (tmsg));
+            tmsg.family = AF_BRIDGE;
+            tmsg.ifindex = p_op->key.if_index;
+
+            sai_vm_rtnl_batch_msg_add (batch, add ? RTM_NEWTUNNEL : RTM_DELTUNNEL,
+                                       add ? NLM_F_CREATE : 0, &tmsg, sizeof (tmsg));
+            if_index = p_op->key.if_index;
+            vni_count = 0;
+        }
+
+        nest = sai_vm_rtnl_nest_begin (batch, VXLAN_VNIFILTER_ENTRY);
+        sai_vm_rtnl_attr_add (batch, VXLAN_VNIFILTER_ENTRY_START, &p_op->key.vni,
+                              sizeof (p_op->key.vni));
+        sai_vm_rtnl_nest_end (batch, nest);
+        vni_count++;
+    }
+#else
+    /* Without a VNI filter the device accepts all the VNIs */
+#endif
+}
+
+/*
+ * An entry already in the requested state, or on a device deleted since
+ * the change was queued, is not an error.
+ */
+static sai_status_t sai_vm_tunnel_batch_status_get (const sai_vm_rtnl_batch_t *batch,
+                                                    sai_status_t sai_rc)
+{
+    uint32_t msg;
+    int      err;
+
+    if ((sai_rc == SAI_STATUS_SUCCESS) || (batch->msg_err == NULL)) {
+        return sai_rc;
+    }
+
+    for (msg = 0; msg < batch->msg_count; msg++) {
+        err = -batch->msg_err [msg];
+
+        if ((err != 0) && (err != ENOENT) && (err != EEXIST) && (err != ENODEV)) {
+            return sai_vm_rtnl_errno_to_sai_status (err);
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_vm_tunnel_flush (void)
+{
+    sai_status_t        sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_rtnl_batch_t batch;
+    sai_vm_tunnel_op_t *p_op = NULL;
+
+    std_mutex_lock (&sai_vm_tunnel_sock_lock);
+
+    if (sai_vm_tunnel_sock == STD_INVALID_FD) {
+        std_mutex_unlock (&sai_vm_tunnel_sock_lock);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_vm_rtnl_batch_init (&batch);
+
+    std_mutex_lock (&sai_vm_tunnel_lock);
+
+    /* VNIs are added before and deleted after the flood entries using them */
+    sai_vm_tunnel_vni_msgs_add (&batch, true);
+
+    for (p_op = std_rbtree_getfirst (sai_vm_tunnel_pending_tree); p_op != NULL;
+         p_op = std_rbtree_getnext (sai_vm_tunnel_pending_tree, p_op)) {
+        if (p_op->key.type == SAI_VM_TUNNEL_OP_FLOOD) {
+            sai_vm_tunnel_flood_msg_add (&batch, p_op);
+        }
+    }
+
+    sai_vm_tunnel_vni_msgs_add (&batch, false);
+
+    while ((p_op = std_rbtree_getfirst (sai_vm_tunnel_pending_tree)) != NULL) {
+        std_rbtree_remove (sai_vm_tunnel_pending_tree, p_op);
+        free (p_op);
+    }
+
+    std_mutex_unlock (&sai_vm_tunnel_lock);
+
+    sai_rc = sai_vm_tunnel_batch_status_get (&batch,
+                                             sai_vm_rtnl_batch_commit (sai_vm_tunnel_sock,
+                                                                       &batch, NULL, NULL));
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_TUNNEL_LOG_ERR ("Kernel tunnel device update of %u messages failed, rc %d.",
+                            batch.msg_count, sai_rc);
+    }
+
+    sai_vm_rtnl_batch_free (&batch);
+
+    std_mutex_unlock (&sai_vm_tunnel_sock_lock);
+
+    return sai_rc;
+}
+
+static void *sai_vm_tunnel_flush_thread (void *param)
+{
+    char wake;
+
+    while (read (sai_vm_tunnel_wake_fd [0], &wake, sizeof (wake)) > 0) {
+        /* Let the rest of a map entry burst join the batch */
+        usleep (SAI_VM_TUNNEL_FLUSH_DELAY_US);
+
+        sai_vm_tunnel_flush ();
+    }
+
+    SAI_TUNNEL_LOG_ERR ("Tunnel flusher event queue closed, exiting.");
+    return NULL;
+}
+
+/* Called with the tunnel VM lock held */
+static sai_status_t sai_vm_tunnel_op_queue (int if_index, sai_vm_tunnel_op_type_t type,
+                                            uint32_t vni, const sai_ip_address_t *p_remote,
+                                            bool add)
+{
+    sai_vm_tunnel_op_t  op;
+    sai_vm_tunnel_op_t *p_op = NULL;
+    char                event = 1;
+
+    memset (&op, 0, sizeof (op));
+    op.key.if_index = if_index;
+    op.key.type = type;
+    op.key.vni = vni;
+    if (p_remote != NULL) {
+        sai_vm_tunnel_ip_copy (&op.key.remote, p_remote);
+    }
+    op.add = add;
+
+    p_op = std_rbtree_getexact (sai_vm_tunnel_pending_tree, &op);
+
+    if (p_op != NULL) {
+        p_op->add = add;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    p_op = calloc (1, sizeof (sai_vm_tunnel_op_t));
+
+    if (p_op == NULL) {
+        SAI_TUNNEL_LOG_ERR ("Unable to queue tunnel device update, memory unavailable.");
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    memcpy (p_op, &op, sizeof (op));
+
+    /* Wake the flusher once per batch */
+    if ((std_rbtree_getfirst (sai_vm_tunnel_pending_tree) == NULL) &&
+        (sai_vm_tunnel_wake_fd [1] != STD_INVALID_FD) &&
+        (write (sai_vm_tunnel_wake_fd [1], &event, sizeof (event)) != sizeof (event))) {
+        SAI_TUNNEL_LOG_ERR ("Writing to tunnel event queue failed.");
+    }
+
+    if (std_rbtree_insert (sai_vm_tunnel_pending_tree, p_op) != STD_ERR_OK) {
+        free (p_op);
+        return SAI_STATUS_FAILURE;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Drop the queued changes of a device, called with the tunnel VM lock held */
+static void sai_vm_tunnel_op_purge (int if_index)
+{
+    sai_vm_tunnel_op_t *p_op = NULL;
+    sai_vm_tunnel_op_t *p_next = NULL;
+
+    for (p_op = std_rbtree_getfirst (sai_vm_tunnel_pending_tree); p_op != NULL;
+         p_op = p_next) {
+        p_next = std_rbtree_getnext (sai_vm_tunnel_pending_tree, p_op);
+
+        if (p_op->key.if_index == if_index) {
+            std_rbtree_remove (sai_vm_tunnel_pending_tree, p_op);
+            free (p_op);
+        }
+    }
+}
+
+static sai_status_t sai_vm_tunnel_vni_update (sai_vm_tunnel_hw_info_t *p_hw_info,
+                                              uint32_t vni, bool add)
+{
+    sai_status_t            sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_tunnel_vni_t     key;
+    sai_vm_tunnel_vni_t    *p_vni = NULL;
+    sai_vm_tunnel_remote_t *p_remote = NULL;
+
+    if ((p_hw_info == NULL) || (!p_hw_info->is_vxlan) || (p_hw_info->if_index == 0)) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    key.vni = vni;
+
+    std_mutex_lock (&sai_vm_tunnel_lock);
+
+    do {
+        p_vni = std_rbtree_getexact (p_hw_info->vni_tree, &key);
+
+        if (add) {
+            if (p_vni != NULL) {
+                p_vni->ref_count++;
+                break;
+            }
+
+            p_vni = calloc (1, sizeof (sai_vm_tunnel_vni_t));
+            if (p_vni == NULL) {
+                sai_rc = SAI_STATUS_NO_MEMORY;
+                break;
+            }
+
+            p_vni->vni = vni;
+            p_vni->ref_count = 1;
+
+            if (std_rbtree_insert (p_hw_info->vni_tree, p_vni) != STD_ERR_OK) {
+                free (p_vni);
+                sai_rc = SAI_STATUS_FAILURE;
+                break;
+            }
+        } else {
+            if ((p_vni == NULL) || (--p_vni->ref_count > 0)) {
+                break;
+            }
+
+            std_rbtree_remove (p_hw_info->vni_tree, p_vni);
+            free (p_vni);
+        }
+
+        sai_rc = sai_vm_tunnel_op_queue (p_hw_info->if_index, SAI_VM_TUNNEL_OP_VNI,
+                                         vni, NULL, add);
+
+        for (p_remote = std_rbtree_getfirst (p_hw_info->remote_tree);
+             (p_remote != NULL) && (sai_rc == SAI_STATUS_SUCCESS);
+             p_remote = std_rbtree_getnext (p_hw_info->remote_tree, p_remote)) {
+            sai_rc = sai_vm_tunnel_op_queue (p_hw_info->if_index, SAI_VM_TUNNEL_OP_FLOOD,
+                                             vni, &p_remote->ip, add);
+        }
+    } while (0);
+
+    std_mutex_unlock (&sai_vm_tunnel_lock);
+
+    return sai_rc;
+}
+
+static sai_status_t sai_vm_tunnel_remote_update (sai_vm_tunnel_hw_info_t *p_hw_info,
+                                                 const sai_ip_address_t *p_ip, bool add)
+{
+    sai_status_t            sai_rc = SAI_STATUS_SUCCESS;
+    sai_vm_tunnel_remote_t  key;
+    sai_vm_tunnel_remote_t *p_remote = NULL;
+    sai_vm_tunnel_vni_t    *p_vni = NULL;
+
+    sai_vm_tunnel_ip_copy (&key.ip, p_ip);
+
+    std_mutex_lock (&sai_vm_tunnel_lock);
+
+    do {
+        p_remote = std_rbtree_getexact (p_hw_info->remote_tree, &key);
+
+        if (add) {
+            if (p_remote != NULL) {
+                p_remote->ref_count++;
+                break;
+            }
+
+            p_remote = calloc (1, sizeof (sai_vm_tunnel_remote_t));
+            if (p_remote == NULL) {
+                sai_rc = SAI_STATUS_NO_MEMORY;
+                break;
+            }
+
+            p_remote->ip = key.ip;
+            p_remote->ref_count = 1;
+
+            if (std_rbtree_insert (p_hw_info->remote_tree, p_remote) != STD_ERR_OK) {
+                free (p_remote);
+                sai_rc = SAI_STATUS_FAILURE;
+                break;
+            }
+        } else {
+            if ((p_remote == NULL) || (--p_remote->ref_count > 0)) {
+                break;
+            }
+
+            std_rbtree_remove (p_hw_info->remote_tree, p_remote);
+            free (p_remote);
+        }
+
+        for (p_vni = std_rbtree_getfirst (p_hw_info->vni_tree);
+             (p_vni != NULL) && (sai_rc == SAI_STATUS_SUCCESS);
+             p_vni = std_rbtree_getnext (p_hw_info->vni_tree, p_vni)) {
+            sai_rc = sai_vm_tunnel_op_queue (p_hw_info->if_index, SAI_VM_TUNNEL_OP_FLOOD,
+                                             p_vni->vni, &key.ip, add);
+        }
+    } while (0);
+
+    std_mutex_unlock (&sai_vm_tunnel_lock);
+
+    return sai_rc;
+}
+
+static void sai_vm_tunnel_tree_free (rbtree_handle tree)
+{
+    void *p_node = NULL;
+
+    if (tree == NULL) {
+        return;
+    }
+
+    while ((p_node = std_rbtree_getfirst (tree)) != NULL) {
+        std_rbtree_remove (tree, p_node);
+        free (p_node);
+    }
+
+    std_rbtree_destroy (tree);
+}
+
+static void sai_vm_tunnel_hw_info_free (sai_vm_tunnel_hw_info_t *p_hw_info)
+{
+    std_mutex_lock (&sai_vm_tunnel_lock);
+
+    if (p_hw_info->if_index != 0) {
+        sai_vm_tunnel_op_purge (p_hw_info->if_index);
+    }
+
+    sai_vm_tunnel_tree_free (p_hw_info->vni_tree);
+    sai_vm_tunnel_tree_free (p_hw_info->remote_tree);
+
+    std_mutex_unlock (&sai_vm_tunnel_lock);
+
+    free (p_hw_info);
+}
+
+static sai_vm_tunnel_hw_info_t *sai_vm_tunnel_hw_info_alloc (void)
+{
+    sai_vm_tunnel_hw_info_t *p_hw_info = calloc (1, sizeof (sai_vm_tunnel_hw_info_t));
+
+    if (p_hw_info == NULL) {
+        return NULL;
+    }
+
+    p_hw_info->vni_tree = std_rbtree_create_simple ("SAI VM tunnel VNI tree",
+            STD_STR_OFFSET_OF (sai_vm_tunnel_vni_t, vni),
+            STD_STR_SIZE_OF (sai_vm_tunnel_vni_t, vni));
+
+    p_hw_info->remote_tree = std_rbtree_create_simple ("SAI VM tunnel remote tree",
+            STD_STR_OFFSET_OF (sai_vm_tunnel_remote_t, ip),
+            STD_STR_SIZE_OF (sai_vm_tunnel_remote_t, ip));
+
+    if ((p_hw_info->vni_tree == NULL) || (p_hw_info->remote_tree == NULL)) {
+        sai_vm_tunnel_hw_info_free (p_hw_info);
+        return NULL;
+    }
+
+    return p_hw_info;
+}
+
+static void sai_vm_tunnel_vxlan_info_add (sai_vm_rtnl_batch_t *batch,
+                                          const dn_sai_tunnel_t *tunnel_obj)
+{
+    uint8_t  one = 1;
+    uint8_t  zero = 0;
+    uint8_t  ttl = tunnel_obj->encap.ttl;
+    uint8_t  tos = 1;
+    uint16_t port = htons (SAI_VM_TUNNEL_VXLAN_UDP_PORT);
+
+    /* The VNI and the remote come from the VNI filter and the flood entries */
+    sai_vm_rtnl_attr_add (batch, IFLA_VXLAN_COLLECT_METADATA, &one, sizeof (one));
+#ifdef RTM_NEWTUNNEL
+    sai_vm_rtnl_attr_add (batch, IFLA_VXLAN_VNIFILTER, &one, sizeof (one));
+#endif
+
+    if (!sai_vm_tunnel_ip_is_zero (&tunnel_obj->src_ip)) {
+        sai_vm_tunnel_ip_attr_add (batch, IFLA_VXLAN_LOCAL, IFLA_VXLAN_LOCAL6,
+                                   &tunnel_obj->src_ip);
+    }
+
+    if (tunnel_obj->encap.ttl_mode == SAI_TUNNEL_TTL_MODE_PIPE_MODEL) {
+        sai_vm_rtnl_attr_add (batch, IFLA_VXLAN_TTL, &ttl, sizeof (ttl));
+    } else {
+#ifdef RTM_NEWTUNNEL
+        sai_vm_rtnl_attr_add (batch, IFLA_VXLAN_TTL_INHERIT, NULL, 0);
+#endif
+    }
+
+    /* A TOS of 1 copies the inner TOS */
+    if (tunnel_obj->encap.dscp_mode == SAI_TUNNEL_DSCP_MODE_PIPE_MODEL) {
+        tos = (tunnel_obj->encap.dscp << 2);
+    }
+    sai_vm_rtnl_attr_add (batch, IFLA_VXLAN_TOS, &tos, sizeof (tos));
+
+    sai_vm_rtnl_attr_add (batch, IFLA_VXLAN_PORT, &port, sizeof (port));
+    sai_vm_rtnl_attr_add (batch, IFLA_VXLAN_LEARNING, &zero, sizeof (zero));
+}
+
+/*
+ * Without a remote the device is non broadcast multi access: the remote is
+ * the gateway of the route or nexthop through the device.
+ */
+static void sai_vm_tunnel_ip_info_add (sai_vm_rtnl_batch_t *batch,
+                                       const dn_sai_tunnel_t *tunnel_obj)
+{
+    bool     is_ip6 = (tunnel_obj->src_ip.addr_family == SAI_IP_ADDR_FAMILY_IPV6);
+    bool     pipe_dscp = (tunnel_obj->encap.dscp_mode == SAI_TUNNEL_DSCP_MODE_PIPE_MODEL);
+    uint8_t  ttl = 0;
+    uint8_t  tos = 1;
+    uint8_t  proto = 0;
+    uint32_t flags = IP6_TNL_F_IGN_ENCAP_LIMIT;
+    uint32_t flowinfo = 0;
+
+    /* A TTL of 0 copies the inner TTL */
+    if (tunnel_obj->encap.ttl_mode == SAI_TUNNEL_TTL_MODE_PIPE_MODEL) {
+        ttl = tunnel_obj->encap.ttl;
+    }
+
+    if (!sai_vm_tunnel_ip_is_zero (&tunnel_obj->src_ip)) {
+        sai_vm_tunnel_ip_attr_add (batch, IFLA_IPTUN_LOCAL, IFLA_IPTUN_LOCAL,
+                                   &tunnel_obj->src_ip);
+    }
+
+    sai_vm_rtnl_attr_add (batch, IFLA_IPTUN_TTL, &ttl, sizeof (ttl));
+
+    if (!is_ip6) {
+        /* A TOS of 1 copies the inner TOS */
+        if (pipe_dscp) {
+            tos = (tunnel_obj->encap.dscp << 2);
+        }
+        sai_vm_rtnl_attr_add (batch, IFLA_IPTUN_TOS, &tos, sizeof (tos));
+        return;
+    }
+
+    /* Both IPv4 and IPv6 payloads */
+    sai_vm_rtnl_attr_add (batch, IFLA_IPTUN_PROTO, &proto, sizeof (proto));
+
+    if (pipe_dscp) {
+        flowinfo = htonl ((uint32_t) tunnel_obj->encap.dscp << 22);
+        sai_vm_rtnl_attr_add (batch, IFLA_IPTUN_FLOWINFO, &flowinfo, sizeof (flowinfo));
+    } else {
+        flags |= IP6_TNL_F_USE_ORIG_TCLASS;
+    }
+    sai_vm_rtnl_attr_add (batch, IFLA_IPTUN_FLAGS, &flags, sizeof (flags));
+}
+
+static void sai_vm_tunnel_if_index_cb (struct nlmsghdr *hdr, void *ctx)
+{
+    if (hdr->nlmsg_type == RTM_NEWLINK) {
+        *(int *) ctx = ((struct ifinfomsg *) NLMSG_DATA (hdr))->ifi_index;
+    }
+}
+
+static sai_status_t sai_vm_tunnel_dev_remove (int if_index, const char *if_name)
+{
+    sai_vm_rtnl_batch_t batch;
+    sai_status_t        sai_rc;
+    struct ifinfomsg    ifi;
+
+    sai_vm_rtnl_batch_init (&batch);
+
+    memset (&ifi, 0, sizeof (ifi));
+    ifi.ifi_family = AF_UNSPEC;
+    ifi.ifi_index = if_index;
+    sai_vm_rtnl_batch_msg_add (&batch, RTM_DELLINK, 0, &ifi, sizeof (ifi));
+    if (if_index == 0) {
+        sai_vm_rtnl_attr_add (&batch, IFLA_IFNAME, if_name, strlen (if_name) + 1);
+    }
+
+    sai_rc = sai_vm_rtnl_batch_commit (sai_vm_tunnel_sock, &batch, NULL, NULL);
+    sai_vm_rtnl_batch_free (&batch);
+
+    return sai_rc;
+}
+
+/* Called with the socket lock held */
+static sai_status_t sai_vm_tunnel_dev_create (const dn_sai_tunnel_t *tunnel_obj,
+                                              sai_vm_tunnel_hw_info_t *p_hw_info,
+                                              const char *kind)
+{
+    sai_vm_rtnl_batch_t batch;
+    sai_status_t        sai_rc = SAI_STATUS_FAILURE;
+    struct ifinfomsg    ifi;
+    size_t              linkinfo;
+    size_t              data;
+    uint_t              attempt;
+
+    for (attempt = 0; attempt < 2; attempt++) {
+        sai_vm_rtnl_batch_init (&batch);
+
+        memset (&ifi, 0, sizeof (ifi));
+        ifi.ifi_family = AF_UNSPEC;
+        ifi.ifi_flags = IFF_UP;
+        ifi.ifi_change = IFF_UP;
+
+        sai_vm_rtnl_batch_msg_add (&batch, RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL,
+                                   &ifi, sizeof (ifi));
+        sai_vm_rtnl_attr_add (&batch, IFLA_IFNAME, p_hw_info->if_name,
+                              strlen (p_hw_info->if_name) + 1);
+
+        linkinfo = sai_vm_rtnl_nest_begin (&batch, IFLA_LINKINFO);
+        sai_vm_rtnl_attr_add (&batch, IFLA_INFO_KIND, kind, strlen (kind));
+        data = sai_vm_rtnl_nest_begin (&batch, IFLA_INFO_DATA);
+        if (p_hw_info->is_vxlan) {
+            sai_vm_tunnel_vxlan_info_add (&batch, tunnel_obj);
+        } else {
+            sai_vm_tunnel_ip_info_add (&batch, tunnel_obj);
+        }
+        sai_vm_rtnl_nest_end (&batch, data);
+        sai_vm_rtnl_nest_end (&batch, linkinfo);
+
+        /* Fetch the index of the new device in the same round trip */
+        memset (&ifi, 0, sizeof (ifi));
+        ifi.ifi_family = AF_UNSPEC;
+        sai_vm_rtnl_batch_msg_add (&batch, RTM_GETLINK, 0, &ifi, sizeof (ifi));
+        sai_vm_rtnl_attr_add (&batch, IFLA_IFNAME, p_hw_info->if_name,
+                              strlen (p_hw_info->if_name) + 1);
+
+        p_hw_info->if_index = 0;
+        sai_rc = sai_vm_rtnl_batch_commit (sai_vm_tunnel_sock, &batch,
+                                           sai_vm_tunnel_if_index_cb, &p_hw_info->if_index);
+
+        if ((sai_rc != SAI_STATUS_SUCCESS) && (batch.msg_err != NULL) &&
+            (batch.msg_err [0] == -EEXIST) && (attempt == 0)) {
+            /* Left behind by an earlier run, it is recreated from this tunnel */
+            SAI_TUNNEL_LOG_INFO ("Removing stale tunnel device %s.", p_hw_info->if_name);
+            sai_vm_tunnel_dev_remove (0, p_hw_info->if_name);
+            sai_vm_rtnl_batch_free (&batch);
+            continue;
+        }
+
+        sai_vm_rtnl_batch_free (&batch);
+        break;
+    }
+
+    if ((sai_rc == SAI_STATUS_SUCCESS) && (p_hw_info->if_index == 0)) {
+        sai_rc = SAI_STATUS_FAILURE;
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        p_hw_info->if_index = 0;
+    }
+
+    return sai_rc;
+}
+
+/* Context of a device counters read */
+typedef struct _sai_vm_tunnel_link_stats_t {
+    int                      if_index;
+    bool                     found;
+    struct rtnl_link_stats64 stats;
+} sai_vm_tunnel_link_stats_t;
+
+static void sai_vm_tunnel_link_stats_cb (struct nlmsghdr *hdr, void *ctx)
+{
+    sai_vm_tunnel_link_stats_t *p_ctx = (sai_vm_tunnel_link_stats_t *) ctx;
+    struct ifinfomsg           *ifi = NLMSG_DATA (hdr);
+    struct rtattr              *tb [IFLA_MAX + 1];
+    size_t                      len;
+
+    if ((hdr->nlmsg_type != RTM_NEWLINK) || (ifi->ifi_index != p_ctx->if_index)) {
+        return;
+    }
+
+    sai_vm_rtnl_attr_parse (tb, IFLA_MAX, IFLA_RTA (ifi), IFLA_PAYLOAD (hdr));
+
+    if (tb [IFLA_STATS64] == NULL) {
+        return;
+    }
+
+    len = RTA_PAYLOAD (tb [IFLA_STATS64]);
+    if (len > sizeof (p_ctx->stats)) {
+        len = sizeof (p_ctx->stats);
+    }
+
+    memcpy (&p_ctx->stats, RTA_DATA (tb [IFLA_STATS64]), len);
+    p_ctx->found = true;
+}
+
+/*
+ * Read the device counters. Decapsulated traffic is received and
+ * encapsulated traffic is sent by the tunnel device.
+ */
+static sai_status_t sai_vm_tunnel_dev_stats_read (const sai_vm_tunnel_hw_info_t *p_hw_info,
+                                                  uint64_t stats [SAI_VM_TUNNEL_STAT_MAX])
+{
+    sai_vm_rtnl_batch_t        batch;
+    sai_vm_tunnel_link_stats_t ctx;
+    sai_status_t               sai_rc;
+    struct ifinfomsg           ifi;
+
+    memset (stats, 0, sizeof (uint64_t) * SAI_VM_TUNNEL_STAT_MAX);
+
+    if (p_hw_info->if_index == 0) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    memset (&ctx, 0, sizeof (ctx));
+    ctx.if_index = p_hw_info->if_index;
+
+    memset (&ifi, 0, sizeof (ifi));
+    ifi.ifi_family = AF_UNSPEC;
+    ifi.ifi_index = p_hw_info->if_index;
+
+    sai_vm_rtnl_batch_init (&batch);
+    sai_vm_rtnl_batch_msg_add (&batch, RTM_GETLINK, 0, &ifi, sizeof (ifi));
+
+    std_mutex_lock (&sai_vm_tunnel_sock_lock);
+    sai_rc = sai_vm_rtnl_batch_commit (sai_vm_tunnel_sock, &batch,
+                                       sai_vm_tunnel_link_stats_cb, &ctx);
+    std_mutex_unlock (&sai_vm_tunnel_sock_lock);
+
+    sai_vm_rtnl_batch_free (&batch);
+
+    if ((sai_rc == SAI_STATUS_SUCCESS) && (!ctx.found)) {
+        sai_rc = SAI_STATUS_FAILURE;
+    }
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_TUNNEL_LOG_ERR ("Counters read of tunnel device %s failed, rc %d.",
+                            p_hw_info->if_name, sai_rc);
+        return sai_rc;
+    }
+
+    stats [SAI_VM_TUNNEL_STAT_IN_OCTETS] = ctx.stats.rx_bytes;
+    stats [SAI_VM_TUNNEL_STAT_IN_PACKETS] = ctx.stats.rx_packets;
+    stats [SAI_VM_TUNNEL_STAT_OUT_OCTETS] = ctx.stats.tx_bytes;
+    stats [SAI_VM_TUNNEL_STAT_OUT_PACKETS] = ctx.stats.tx_packets;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static int sai_vm_tunnel_stat_index_get (sai_tunnel_stat_t counter_id)
+{
+    switch (counter_id) {
+        case SAI_TUNNEL_STAT_IN_OCTETS:
+            return SAI_VM_TUNNEL_STAT_IN_OCTETS;
+        case SAI_TUNNEL_STAT_IN_PACKETS:
+            return SAI_VM_TUNNEL_STAT_IN_PACKETS;
+        case SAI_TUNNEL_STAT_OUT_OCTETS:
+            return SAI_VM_TUNNEL_STAT_OUT_OCTETS;
+        case SAI_TUNNEL_STAT_OUT_PACKETS:
+            return SAI_VM_TUNNEL_STAT_OUT_PACKETS;
+        default:
+            return -1;
+    }
+}
+
+static uint32_t sai_vm_tunnel_map_entry_vni_get (const dn_sai_tunnel_map_entry_t *p_entry)
+{
+    if (p_entry->type == SAI_TUNNEL_MAP_TYPE_VNI_TO_BRIDGE_IF) {
+        return p_entry->key.vnid;
+    }
+
+    return p_entry->value.vnid;
+}
+
+/* Add or remove the VNI of a map entry on the tunnels using its map */
+static sai_status_t sai_vm_tunnel_map_entry_render (dn_sai_tunnel_map_entry_t *p_entry,
+                                                    uint32_t vni, bool add)
+{
+    sai_status_t    sai_rc = SAI_STATUS_SUCCESS;
+    sai_object_id_t tunnel_id = SAI_NULL_OBJECT_ID;
+    uint_t          count = 0;
+    uint_t          idx;
+
+    if (!dn_sai_is_vxlan_tunnel_map_entry (p_entry)) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (dn_sai_tunnel_map_dep_tunnel_count_get (p_entry->tunnel_map_id,
+                                                &count) != SAI_STATUS_SUCCESS) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    for (idx = 0; (idx < count) && (sai_rc == SAI_STATUS_SUCCESS); idx++) {
+        if (dn_sai_tunnel_map_dep_tunnel_get_at_index (p_entry->tunnel_map_id, idx,
+                                                       &tunnel_id) != SAI_STATUS_SUCCESS) {
+            continue;
+        }
+
+        sai_rc = sai_vm_tunnel_vni_update (dn_sai_tunnel_hw_info_get (tunnel_id), vni, add);
+    }
+
+    return sai_rc;
+}
+
+/* Add or remove the VNIs of all the map entries of the mappers of a tunnel */
+static sai_status_t sai_vm_tunnel_mappers_render (const dn_sai_tunnel_t *tunnel_obj,
+                                                  bool add)
+{
+    sai_status_t               sai_rc = SAI_STATUS_SUCCESS;
+    const sai_object_list_t   *mapper_lists [] = {&tunnel_obj->tunnel_encap_mapper_list,
+                                                  &tunnel_obj->tunnel_decap_mapper_list};
+    dn_sai_tunnel_map_t       *p_map = NULL;
+    dn_sai_tunnel_map_entry_t *p_entry = NULL;
+    uint_t                     list;
+    uint_t                     idx;
+
+    for (list = 0; list < (sizeof (mapper_lists) / sizeof (mapper_lists [0])); list++) {
+        for (idx = 0; idx < mapper_lists [list]->count; idx++) {
+            p_map = dn_sai_tunnel_map_get (mapper_lists [list]->list [idx]);
+            if (p_map == NULL) {
+                continue;
+            }
+
+            for (p_entry = sai_tunnel_get_first_tunnel_map_entry (&p_map->tunnel_map_entry_list);
+                 (p_entry != NULL) && (sai_rc == SAI_STATUS_SUCCESS);
+                 p_entry = sai_tunnel_get_next_tunnel_map_entry (&p_map->tunnel_map_entry_list,
+                                                                 p_entry)) {
+                if (!dn_sai_is_vxlan_tunnel_map_entry (p_entry)) {
+                    continue;
+                }
+
+                sai_rc = sai_vm_tunnel_vni_update (tunnel_obj->hw_info,
+                                                   sai_vm_tunnel_map_entry_vni_get (p_entry),
+                                                   add);
+            }
+        }
+    }
+
+    return sai_rc;
+}
+
+#ifdef RTM_NEWNEXTHOP
+static sai_status_t sai_vm_tunnel_kernel_nh_update (const sai_vm_tunnel_hw_info_t *p_hw_info,
+                                                    uint_t nh_index,
+                                                    const sai_ip_address_t *p_remote, bool add)
+{
+    sai_vm_rtnl_batch_t batch;
+    sai_status_t        sai_rc;
+    struct nhmsg        nhm;
+    uint32_t            nh_id = SAI_VM_TUNNEL_KERNEL_NH_ID_BASE + nh_index;
+    uint32_t            oif = p_hw_info->if_index;
+
+    memset (&nhm, 0, sizeof (nhm));
+    nhm.nh_family = (p_remote->addr_family == SAI_IP_ADDR_FAMILY_IPV4) ? AF_INET : AF_INET6;
+
+    sai_vm_rtnl_batch_init (&batch);
+
+    if (add) {
+        /* The remote is not a neighbor, it is reached through the tunnel */
+        nhm.nh_flags = RTNH_F_ONLINK;
+        sai_vm_rtnl_batch_msg_add (&batch, RTM_NEWNEXTHOP, NLM_F_CREATE | NLM_F_REPLACE,
+                                   &nhm, sizeof (nhm));
+        sai_vm_rtnl_attr_add (&batch, NHA_ID, &nh_id, sizeof (nh_id));
+        sai_vm_rtnl_attr_add (&batch, NHA_OIF, &oif, sizeof (oif));
+        sai_vm_tunnel_ip_attr_add (&batch, NHA_GATEWAY, NHA_GATEWAY, p_remote);
+    } else {
+        sai_vm_rtnl_batch_msg_add (&batch, RTM_DELNEXTHOP, 0, &nhm, sizeof (nhm));
+        sai_vm_rtnl_attr_add (&batch, NHA_ID, &nh_id, sizeof (nh_id));
+    }
+
+    std_mutex_lock (&sai_vm_tunnel_sock_lock);
+    sai_rc = sai_vm_tunnel_batch_status_get (&batch,
+                                             sai_vm_rtnl_batch_commit (sai_vm_tunnel_sock,
+                                                                       &batch, NULL, NULL));
+    std_mutex_unlock (&sai_vm_tunnel_sock_lock);
+
+    sai_vm_rtnl_batch_free (&batch);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        SAI_TUNNEL_LOG_ERR ("Kernel nexthop %u %s on tunnel device %s failed, rc %d.",
+                            nh_id, add ? "add" : "delete", p_hw_info->if_name, sai_rc);
+    }
+
+    return sai_rc;
+}
+#else
+static sai_status_t sai_vm_tunnel_kernel_nh_update (const sai_vm_tunnel_hw_info_t *p_hw_info,
+                                                    uint_t nh_index,
+                                                    const sai_ip_address_t *p_remote, bool add)
+{
+    /* No nexthop objects, the routes through the device carry the gateway */
+    return SAI_STATUS_SUCCESS;
+}
+#endif
+
+/*
+ * The tunnel tree and the hw_info of the tunnels only change with both the
+ * tunnel and the FIB locks held, the callers hold the FIB lock.
+ */
+static sai_vm_tunnel_hw_info_t *sai_vm_tunnel_encap_nh_hw_info_get (sai_fib_nh_t *p_encap_nh)
+{
+    sai_vm_tunnel_hw_info_t *p_hw_info = dn_sai_tunnel_hw_info_get (p_encap_nh->tunnel_id);
+
+    if ((p_hw_info == NULL) || (p_hw_info->if_index == 0)) {
+        return NULL;
+    }
+
+    return p_hw_info;
+}
+
+sai_status_t sai_vm_tunnel_encap_nh_create (sai_fib_nh_t *p_encap_nh, uint_t nh_index)
+{
+    sai_vm_tunnel_hw_info_t *p_hw_info = NULL;
+
+    STD_ASSERT (p_encap_nh != NULL);
+
+    p_hw_info = sai_vm_tunnel_encap_nh_hw_info_get (p_encap_nh);
+
+    if (p_hw_info == NULL) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (p_hw_info->is_vxlan) {
+        return sai_vm_tunnel_remote_update (p_hw_info, sai_fib_next_hop_ip_addr (p_encap_nh),
+                                            true);
+    }
+
+    return sai_vm_tunnel_kernel_nh_update (p_hw_info, nh_index,
+                                           sai_fib_next_hop_ip_addr (p_encap_nh), true);
+}
+
+void sai_vm_tunnel_encap_nh_remove (sai_fib_nh_t *p_encap_nh, uint_t nh_index)
+{
+    sai_vm_tunnel_hw_info_t *p_hw_info = NULL;
+
+    STD_ASSERT (p_encap_nh != NULL);
+
+    p_hw_info = sai_vm_tunnel_encap_nh_hw_info_get (p_encap_nh);
+
+    if (p_hw_info == NULL) {
+        return;
+    }
+
+    if (p_hw_info->is_vxlan) {
+        sai_vm_tunnel_remote_update (p_hw_info, sai_fib_next_hop_ip_addr (p_encap_nh), false);
+    } else {
+        sai_vm_tunnel_kernel_nh_update (p_hw_info, nh_index,
+                                        sai_fib_next_hop_ip_addr (p_encap_nh), false);
+    }
+}
+
 static sai_status_t sai_vm_tunnel_init (void)
 {
+    if (sai_vm_tunnel_pending_tree != NULL) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_vm_tunnel_pending_tree = std_rbtree_create_simple ("SAI VM tunnel pending tree",
+            STD_STR_OFFSET_OF (sai_vm_tunnel_op_t, key),
+            STD_STR_SIZE_OF (sai_vm_tunnel_op_t, key));
+
+    if (sai_vm_tunnel_pending_tree == NULL) {
+        SAI_TUNNEL_LOG_CRIT ("Unable to create tunnel pending tree.");
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sai_vm_tunnel_sock = sai_vm_rtnl_switch_ns_open (0);
+    if (sai_vm_tunnel_sock == STD_INVALID_FD) {
+        SAI_TUNNEL_LOG_ERR ("Tunnels are kept in software only.");
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (pipe (sai_vm_tunnel_wake_fd) != 0) {
+        SAI_TUNNEL_LOG_ERR ("Tunnel event queue initialization failed.");
+        sai_vm_tunnel_wake_fd [0] = sai_vm_tunnel_wake_fd [1] = STD_INVALID_FD;
+        return SAI_STATUS_FAILURE;
+    }
+
+    std_thread_init_struct (&sai_vm_tunnel_thread);
+    sai_vm_tunnel_thread.name = "sai-vm-tunnel";
+    sai_vm_tunnel_thread.thread_function = sai_vm_tunnel_flush_thread;
+
+    if (std_thread_create (&sai_vm_tunnel_thread) != STD_ERR_OK) {
+        SAI_TUNNEL_LOG_ERR ("Tunnel flusher thread creation failed.");
+        return SAI_STATUS_FAILURE;
+    }
+
     return SAI_STATUS_SUCCESS;
 }
 
 static void sai_vm_tunnel_deinit (void)
 {
+    sai_vm_tunnel_flush ();
 }
 
 /*
@@ -151,20 +1191,110 @@ static void sai_vm_tunnel_attr_id_table_get (
     }
 }
 
+static sai_status_t sai_vm_tunnel_obj_remove (dn_sai_tunnel_t *tunnel_obj);
+
 static sai_status_t sai_vm_tunnel_obj_create (dn_sai_tunnel_t *tunnel_obj)
 {
+    sai_vm_tunnel_hw_info_t *p_hw_info = NULL;
+    const char              *kind = NULL;
+    const char              *name_fmt = NULL;
+    sai_status_t             sai_rc;
+
     STD_ASSERT (tunnel_obj != NULL);
 
+    p_hw_info = sai_vm_tunnel_hw_info_alloc ();
+
+    if (p_hw_info == NULL) {
+        SAI_TUNNEL_LOG_ERR ("Unable to allocate hw info of tunnel 0x%"PRIx64".",
+                            tunnel_obj->tunnel_id);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    if (dn_sai_is_vxlan_tunnel (tunnel_obj)) {
+        p_hw_info->is_vxlan = true;
+        kind = "vxlan";
+        name_fmt = SAI_VM_TUNNEL_VXLAN_DEV_NAME_FMT;
+    } else if (tunnel_obj->tunnel_type == SAI_TUNNEL_TYPE_IPINIP) {
+        if (tunnel_obj->src_ip.addr_family == SAI_IP_ADDR_FAMILY_IPV6) {
+            kind = "ip6tnl";
+            name_fmt = SAI_VM_TUNNEL_IP6TNL_DEV_NAME_FMT;
+        } else {
+            kind = "ipip";
+            name_fmt = SAI_VM_TUNNEL_IPIP_DEV_NAME_FMT;
+        }
+    }
+
+    tunnel_obj->hw_info = p_hw_info;
+
+    if ((kind == NULL) || (sai_vm_tunnel_sock == STD_INVALID_FD)) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    snprintf (p_hw_info->if_name, sizeof (p_hw_info->if_name), name_fmt,
+              (uint_t) sai_uoid_npu_obj_id_get (tunnel_obj->tunnel_id));
+
+    std_mutex_lock (&sai_vm_tunnel_sock_lock);
+    sai_rc = sai_vm_tunnel_dev_create (tunnel_obj, p_hw_info, kind);
+    std_mutex_unlock (&sai_vm_tunnel_sock_lock);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        /* e.g. the kernel lacks the tunnel driver */
+        SAI_TUNNEL_LOG_ERR ("Tunnel device %s creation failed, rc %d, tunnel 0x%"PRIx64
+                            " is kept in software only.", p_hw_info->if_name, sai_rc,
+                            tunnel_obj->tunnel_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    SAI_TUNNEL_LOG_INFO ("Tunnel 0x%"PRIx64" is backed by %s device %s.",
+                         tunnel_obj->tunnel_id, kind, p_hw_info->if_name);
+
+    if (p_hw_info->is_vxlan) {
+        sai_rc = sai_vm_tunnel_mappers_render (tunnel_obj, true);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            sai_vm_tunnel_obj_remove (tunnel_obj);
+            return sai_rc;
+        }
+    }
+
     return SAI_STATUS_SUCCESS;
 }
 
 static sai_status_t sai_vm_tunnel_obj_remove (dn_sai_tunnel_t *tunnel_obj)
 {
+    sai_vm_tunnel_hw_info_t *p_hw_info = NULL;
+    sai_status_t             sai_rc;
+
     STD_ASSERT (tunnel_obj != NULL);
 
+    p_hw_info = tunnel_obj->hw_info;
+
+    if (p_hw_info == NULL) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (p_hw_info->if_index != 0) {
+        /* The kernel drops the VNI filter and the flood entries with the device */
+        std_mutex_lock (&sai_vm_tunnel_sock_lock);
+        sai_rc = sai_vm_tunnel_dev_remove (p_hw_info->if_index, p_hw_info->if_name);
+        std_mutex_unlock (&sai_vm_tunnel_sock_lock);
+
+        if (sai_rc != SAI_STATUS_SUCCESS) {
+            SAI_TUNNEL_LOG_ERR ("Tunnel device %s removal failed, rc %d.",
+                                p_hw_info->if_name, sai_rc);
+        }
+    }
+
+    sai_vm_tunnel_hw_info_free (p_hw_info);
+    tunnel_obj->hw_info = NULL;
+
     return SAI_STATUS_SUCCESS;
 }
 
+/*
+ * The tunnel devices decapsulate the packets sent to their local address,
+ * there is nothing to program for a termination entry.
+ */
 static sai_status_t sai_vm_tunnel_term_entry_create (
                                    dn_sai_tunnel_term_entry_t *tunnel_term_obj)
 {
@@ -185,27 +1315,133 @@ static sai_status_t sai_vm_tunnel_map_entry_create(dn_sai_tunnel_map_entry_t *p_
 {
     STD_ASSERT (p_tunnel_map_entry != NULL);
 
-    return SAI_STATUS_SUCCESS;
+    return sai_vm_tunnel_map_entry_render (p_tunnel_map_entry,
+                                           sai_vm_tunnel_map_entry_vni_get (p_tunnel_map_entry),
+                                           true);
 }
 
 static sai_status_t sai_vm_tunnel_map_entry_remove(dn_sai_tunnel_map_entry_t *p_tunnel_map_entry)
 {
     STD_ASSERT (p_tunnel_map_entry != NULL);
 
-    return SAI_STATUS_SUCCESS;
+    return sai_vm_tunnel_map_entry_render (p_tunnel_map_entry,
+                                           sai_vm_tunnel_map_entry_vni_get (p_tunnel_map_entry),
+                                           false);
+}
+
+static sai_status_t sai_vm_tunnel_map_entry_set(dn_sai_tunnel_map_entry_t *p_tunnel_map_entry)
+{
+    dn_sai_tunnel_map_entry_t *p_old_entry = NULL;
+    uint32_t                   old_vni;
+    uint32_t                   new_vni;
+    sai_status_t               sai_rc;
+
+    STD_ASSERT (p_tunnel_map_entry != NULL);
+
+    /* The cached entry still holds the value being replaced */
+    p_old_entry = dn_sai_tunnel_map_entry_get (p_tunnel_map_entry->tunnel_map_entry_id);
+
+    if (p_old_entry == NULL) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    old_vni = sai_vm_tunnel_map_entry_vni_get (p_old_entry);
+    new_vni = sai_vm_tunnel_map_entry_vni_get (p_tunnel_map_entry);
+
+    if (old_vni == new_vni) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_rc = sai_vm_tunnel_map_entry_render (p_tunnel_map_entry, new_vni, true);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        return sai_rc;
+    }
+
+    return sai_vm_tunnel_map_entry_render (p_old_entry, old_vni, false);
 }
 
 static sai_status_t sai_vm_tunnel_stats_get (sai_object_id_t tunnel_id, uint32_t num_counters,
                                               const sai_tunnel_stat_t *counter_ids,
                                               uint64_t *counters)
 {
+    sai_vm_tunnel_hw_info_t *p_hw_info = NULL;
+    uint64_t                 stats [SAI_VM_TUNNEL_STAT_MAX];
+    sai_status_t             sai_rc;
+    uint32_t                 idx;
+    int                      stat;
+
+    STD_ASSERT (counter_ids != NULL);
+    STD_ASSERT (counters != NULL);
+
+    p_hw_info = dn_sai_tunnel_hw_info_get (tunnel_id);
+
+    if (p_hw_info == NULL) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    for (idx = 0; idx < num_counters; idx++) {
+        if (sai_vm_tunnel_stat_index_get (counter_ids [idx]) < 0) {
+            SAI_TUNNEL_LOG_ERR ("Tunnel counter %d is not supported.", counter_ids [idx]);
+            return SAI_STATUS_NOT_SUPPORTED;
+        }
+    }
+
+    /* One read of the device counters serves all the requested counters */
+    sai_rc = sai_vm_tunnel_dev_stats_read (p_hw_info, stats);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        return sai_rc;
+    }
+
+    for (idx = 0; idx < num_counters; idx++) {
+        stat = sai_vm_tunnel_stat_index_get (counter_ids [idx]);
+
+        /* The device counters restart from 0 if the device is recreated */
+        counters [idx] = (stats [stat] >= p_hw_info->stat_base [stat]) ?
+            (stats [stat] - p_hw_info->stat_base [stat]) : stats [stat];
+    }
+
     return SAI_STATUS_SUCCESS;
 }
 
+/* Device counters cannot be cleared, the current values become the base */
 static sai_status_t sai_vm_tunnel_stats_clear (sai_object_id_t tunnel_id,
                                                 uint32_t num_counters,
                                                 const sai_tunnel_stat_t *counter_ids)
 {
+    sai_vm_tunnel_hw_info_t *p_hw_info = NULL;
+    uint64_t                 stats [SAI_VM_TUNNEL_STAT_MAX];
+    sai_status_t             sai_rc;
+    uint32_t                 idx;
+    int                      stat;
+
+    STD_ASSERT (counter_ids != NULL);
+
+    p_hw_info = dn_sai_tunnel_hw_info_get (tunnel_id);
+
+    if (p_hw_info == NULL) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
+    }
+
+    for (idx = 0; idx < num_counters; idx++) {
+        if (sai_vm_tunnel_stat_index_get (counter_ids [idx]) < 0) {
+            SAI_TUNNEL_LOG_ERR ("Tunnel counter %d is not supported.", counter_ids [idx]);
+            return SAI_STATUS_NOT_SUPPORTED;
+        }
+    }
+
+    sai_rc = sai_vm_tunnel_dev_stats_read (p_hw_info, stats);
+
+    if (sai_rc != SAI_STATUS_SUCCESS) {
+        return sai_rc;
+    }
+
+    for (idx = 0; idx < num_counters; idx++) {
+        stat = sai_vm_tunnel_stat_index_get (counter_ids [idx]);
+        p_hw_info->stat_base [stat] = stats [stat];
+    }
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -229,6 +1465,7 @@ static void sai_vm_tunnel_api_table_fill (sai_npu_tunnel_api_t *tunnel_api_table
     tunnel_api_table->tunnel_term_entry_remove = sai_vm_tunnel_term_entry_remove;
     tunnel_api_table->tunnel_map_entry_create  = sai_vm_tunnel_map_entry_create;
     tunnel_api_table->tunnel_map_entry_remove  = sai_vm_tunnel_map_entry_remove;
+    tunnel_api_table->tunnel_map_entry_set     = sai_vm_tunnel_map_entry_set;
     tunnel_api_table->tunnel_stats_get         = sai_vm_tunnel_stats_get;
     tunnel_api_table->tunnel_stats_clear       = sai_vm_tunnel_stats_clear;
 }
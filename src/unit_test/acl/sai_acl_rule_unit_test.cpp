@@ -24,9 +24,12 @@
 
 #include "gtest/gtest.h"
 
+#include <string>
+
 #include "sai_acl_unit_test_utils.h"
 #include "sai_l3_unit_test_utils.h"
 #include "sai_udf_unit_test.h"
+#include "sai_bulk_unit_test_utils.h"
 
 extern "C" {
 #include "sai.h"
@@ -38,7 +41,17 @@ extern "C" {
 #include "saineighbor.h"
 #include "sainexthopgroup.h"
 #include "saiudf.h"
+#include "sai_common_acl.h"
+#include "sai_acl_utils.h"
+#include "sai_vm_acl_util.h"
+#include "sai_acl_rule_utils.h"
+#include "sai_acl_npu_api.h"
+#include "sai_common_infra.h"
+#include "sai_oid_utils.h"
+#include "sai_vm_db_utils.h"
+#include "sai_vm_defs.h"
 #include <inttypes.h>
+#include <string.h>
 }
 
 class saiACLRuleTest : public saiACLTest
@@ -1234,6 +1247,226 @@ TEST_F(saiACLRuleTest, rule_create_with_counter)
     EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
 }
 
+static sai_npu_attach_cntr_to_acl_rule_fn sai_test_acl_attach_cntr_orig = NULL;
+static unsigned int sai_test_acl_attach_cntr_fail_count = 0;
+
+/* NPU counter attach failing the next fail_count calls */
+static sai_status_t sai_test_acl_attach_cntr_fail (sai_acl_rule_t *acl_rule,
+                                                   sai_acl_counter_t *acl_cntr)
+{
+    if (sai_test_acl_attach_cntr_fail_count > 0) {
+        sai_test_acl_attach_cntr_fail_count--;
+        return SAI_STATUS_FAILURE;
+    }
+
+    return sai_test_acl_attach_cntr_orig (acl_rule, acl_cntr);
+}
+
+/* Attribute of the ACL rule row in the VM DB */
+static std::string sai_test_acl_rule_db_attr_get (sai_object_id_t acl_rule_id,
+                                                  const char *attr_str)
+{
+    char        out_str [SAI_VM_MAX_BUFSZ] = {0};
+    std::string cond_str = std::string ("( entry_id=") +
+        std::to_string ((uint_t) sai_uoid_npu_obj_id_get (acl_rule_id)) +
+        std::string (")");
+
+    EXPECT_EQ (STD_ERR_OK,
+               db_sql_get_attribute (sai_vm_get_db_handle(), "SAI_ACL_ENTRY",
+                                     attr_str, cond_str.c_str(), out_str));
+
+    return std::string (out_str);
+}
+
+/* Rule state a failed set must leave untouched */
+typedef struct _sai_test_acl_rule_state_t {
+    uint_t          priority;
+    uint_t          filter_count;
+    uint_t          action_count;
+    sai_object_id_t counter_id;
+    uint32_t        counter_shared_count;
+    std::string     db_priority;
+    std::string     db_filter_count;
+    std::string     db_action_count;
+    std::string     db_counter_id;
+} sai_test_acl_rule_state_t;
+
+static void sai_test_acl_rule_state_get (sai_object_id_t acl_rule_id,
+                                         sai_object_id_t acl_cntr_id,
+                                         sai_test_acl_rule_state_t *p_state)
+{
+    sai_acl_rule_t    *p_acl_rule = NULL;
+    sai_acl_counter_t *p_acl_cntr = NULL;
+
+    sai_acl_lock ();
+
+    p_acl_rule = sai_acl_rule_find (sai_acl_get_acl_node()->sai_acl_rule_tree,
+                                    acl_rule_id);
+    if (p_acl_rule == NULL) {
+        sai_acl_unlock ();
+        ADD_FAILURE () << "ACL rule 0x" << std::hex << acl_rule_id << " not found";
+        return;
+    }
+
+    p_state->priority = p_acl_rule->acl_rule_priority;
+    p_state->filter_count = p_acl_rule->filter_count;
+    p_state->action_count = p_acl_rule->action_count;
+    p_state->counter_id = p_acl_rule->counter_id;
+
+    p_acl_cntr = sai_acl_cntr_find (sai_acl_get_acl_node()->sai_acl_counter_tree,
+                                    acl_cntr_id);
+    p_state->counter_shared_count =
+        (p_acl_cntr != NULL) ? p_acl_cntr->shared_count : 0;
+
+    sai_acl_unlock ();
+
+    p_state->db_priority = sai_test_acl_rule_db_attr_get (acl_rule_id, "priority");
+    p_state->db_filter_count = sai_test_acl_rule_db_attr_get (acl_rule_id,
+                                                              "filter_count");
+    p_state->db_action_count = sai_test_acl_rule_db_attr_get (acl_rule_id,
+                                                              "action_count");
+    p_state->db_counter_id = sai_test_acl_rule_db_attr_get (acl_rule_id,
+                                                            "counter_id");
+}
+
+static void sai_test_acl_rule_state_check (sai_object_id_t acl_rule_id,
+                                           sai_object_id_t acl_cntr_id,
+                                           const sai_test_acl_rule_state_t *p_state)
+{
+    sai_test_acl_rule_state_t state;
+
+    sai_test_acl_rule_state_get (acl_rule_id, acl_cntr_id, &state);
+
+    EXPECT_EQ (p_state->priority, state.priority);
+    EXPECT_EQ (p_state->filter_count, state.filter_count);
+    EXPECT_EQ (p_state->action_count, state.action_count);
+    EXPECT_EQ (p_state->counter_id, state.counter_id);
+    EXPECT_EQ (p_state->counter_shared_count, state.counter_shared_count);
+    EXPECT_EQ (p_state->db_priority, state.db_priority);
+    EXPECT_EQ (p_state->db_filter_count, state.db_filter_count);
+    EXPECT_EQ (p_state->db_action_count, state.db_action_count);
+    EXPECT_EQ (p_state->db_counter_id, state.db_counter_id);
+}
+
+/*
+ * A set failing after the NPU already took the new rule must put the
+ * rule, its counters and its DB row back as they were before the set.
+ * The failure is injected by a counter attach failing in the NPU.
+ */
+TEST_F(saiACLRuleTest, rule_set_rollback_after_npu_set)
+{
+    sai_status_t              sai_rc = SAI_STATUS_SUCCESS;
+    sai_object_id_t           acl_rule_id = 0;
+    sai_object_id_t           acl_counter_id_1 = 0;
+    sai_object_id_t           acl_counter_id_2 = 0;
+    sai_attribute_t          *p_attr_list_get = NULL;
+    unsigned int              test_attr_count = 1;
+    sai_test_acl_rule_state_t rule_state;
+    sai_test_acl_rule_state_t new_cntr_state;
+
+    sai_rc = sai_test_acl_counter_create (&acl_counter_id_1, 2,
+                                          SAI_ACL_COUNTER_ATTR_TABLE_ID, ip_table_id,
+                                          SAI_ACL_COUNTER_ATTR_ENABLE_PACKET_COUNT, true);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_rc = sai_test_acl_counter_create (&acl_counter_id_2, 2,
+                                          SAI_ACL_COUNTER_ATTR_TABLE_ID, ip_table_id,
+                                          SAI_ACL_COUNTER_ATTR_ENABLE_PACKET_COUNT, true);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_rc = sai_test_acl_rule_create_attr_list (&p_attr_list_get, test_attr_count, 0, 0, false, false);
+    ASSERT_TRUE (SAI_STATUS_SUCCESS == sai_rc);
+
+    sai_rc = sai_test_acl_rule_create (&acl_rule_id, 5,
+                                       SAI_ACL_ENTRY_ATTR_TABLE_ID, ip_table_id,
+                                       SAI_ACL_ENTRY_ATTR_PRIORITY, 10,
+                                       SAI_ACL_ENTRY_ATTR_ADMIN_STATE, true,
+                                       SAI_ACL_ENTRY_ATTR_FIELD_IN_PORT,
+                                       1, port_id_1,
+                                       SAI_ACL_ENTRY_ATTR_ACTION_COUNTER,
+                                       1, acl_counter_id_1);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_test_acl_rule_state_get (acl_rule_id, acl_counter_id_1, &rule_state);
+    sai_test_acl_rule_state_get (acl_rule_id, acl_counter_id_2, &new_cntr_state);
+    EXPECT_EQ (acl_counter_id_1, rule_state.counter_id);
+
+    sai_test_acl_attach_cntr_orig = sai_acl_npu_api_get()->attach_cntr_to_acl_rule;
+    sai_acl_npu_api_get()->attach_cntr_to_acl_rule = sai_test_acl_attach_cntr_fail;
+
+    /* Counter change fails after the old counter was detached */
+    sai_test_acl_attach_cntr_fail_count = 1;
+    sai_rc = sai_test_acl_rule_set (acl_rule_id, 1,
+                                    SAI_ACL_ENTRY_ATTR_ACTION_COUNTER,
+                                    1, acl_counter_id_2);
+    EXPECT_NE (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_test_acl_rule_state_check (acl_rule_id, acl_counter_id_1, &rule_state);
+    sai_test_acl_rule_state_check (acl_rule_id, acl_counter_id_2, &new_cntr_state);
+
+    sai_rc = sai_test_acl_rule_get (acl_rule_id, p_attr_list_get,
+                                    test_attr_count,
+                                    SAI_ACL_ENTRY_ATTR_ACTION_COUNTER);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (p_attr_list_get[0].value.aclaction.enable, true);
+    EXPECT_EQ (p_attr_list_get[0].value.aclaction.parameter.oid, acl_counter_id_1);
+
+    sai_rc = sai_test_acl_rule_get (acl_rule_id, p_attr_list_get,
+                                    test_attr_count,
+                                    SAI_ACL_ENTRY_ATTR_FIELD_IN_PORT);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (p_attr_list_get[0].value.aclfield.data.oid, port_id_1);
+
+    /* The restored rule still takes the same set */
+    sai_rc = sai_test_acl_rule_set (acl_rule_id, 1,
+                                    SAI_ACL_ENTRY_ATTR_ACTION_COUNTER,
+                                    1, acl_counter_id_2);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_rc = sai_test_acl_rule_get (acl_rule_id, p_attr_list_get,
+                                    test_attr_count,
+                                    SAI_ACL_ENTRY_ATTR_ACTION_COUNTER);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (p_attr_list_get[0].value.aclaction.parameter.oid, acl_counter_id_2);
+
+    sai_rc = sai_test_acl_rule_remove (acl_rule_id);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    /* Counter added as a new action fails after the action list grew */
+    sai_rc = sai_test_acl_rule_create (&acl_rule_id, 4,
+                                       SAI_ACL_ENTRY_ATTR_TABLE_ID, ip_table_id,
+                                       SAI_ACL_ENTRY_ATTR_PRIORITY, 10,
+                                       SAI_ACL_ENTRY_ATTR_ADMIN_STATE, true,
+                                       SAI_ACL_ENTRY_ATTR_FIELD_IN_PORT,
+                                       1, port_id_1);
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_test_acl_rule_state_get (acl_rule_id, acl_counter_id_1, &rule_state);
+    EXPECT_EQ (0, rule_state.counter_id);
+    EXPECT_EQ (std::string ("-"), rule_state.db_counter_id);
+
+    sai_test_acl_attach_cntr_fail_count = 1;
+    sai_rc = sai_test_acl_rule_set (acl_rule_id, 1,
+                                    SAI_ACL_ENTRY_ATTR_ACTION_COUNTER,
+                                    1, acl_counter_id_1);
+    EXPECT_NE (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_test_acl_rule_state_check (acl_rule_id, acl_counter_id_1, &rule_state);
+
+    sai_acl_npu_api_get()->attach_cntr_to_acl_rule = sai_test_acl_attach_cntr_orig;
+    sai_test_acl_attach_cntr_fail_count = 0;
+
+    sai_test_acl_rule_free_attr_list (p_attr_list_get, test_attr_count);
+
+    sai_rc = sai_test_acl_rule_remove (acl_rule_id);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_rc = sai_test_acl_counter_remove (acl_counter_id_1);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_rc = sai_test_acl_counter_remove (acl_counter_id_2);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+}
 TEST_F(saiACLRuleTest, rule_create_with_defaults)
 {
     sai_status_t             sai_rc = SAI_STATUS_SUCCESS;
@@ -1485,6 +1718,112 @@ TEST_F(saiACLRuleTest, rule_remove)
 
 }
 
+TEST_F(saiACLRuleTest, rule_remove_and_reuse_id)
+{
+    sai_status_t             sai_rc = SAI_STATUS_SUCCESS;
+    sai_object_id_t          acl_rule_id[3] = {0};
+    sai_object_id_t          acl_rule_id_new = 0;
+    unsigned int             rule_idx = 0;
+
+    for (rule_idx = 0; rule_idx < 3; rule_idx++) {
+        sai_rc = sai_test_acl_rule_create (&acl_rule_id[rule_idx], 5,
+                                           SAI_ACL_ENTRY_ATTR_TABLE_ID, mac_table_id,
+                                           SAI_ACL_ENTRY_ATTR_PRIORITY, 10 + rule_idx,
+                                           SAI_ACL_ENTRY_ATTR_ADMIN_STATE, true,
+                                           SAI_ACL_TABLE_ATTR_FIELD_DST_MAC,
+                                           1, &dst_mac_data, &dst_mac_mask,
+                                           SAI_ACL_TABLE_ATTR_FIELD_ETHER_TYPE,
+                                           1, 0x8809, 0xffff);
+        ASSERT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    }
+
+    /* The id of a removed rule is handed out again */
+    sai_rc = sai_test_acl_rule_remove (acl_rule_id[1]);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    sai_rc = sai_test_acl_rule_create (&acl_rule_id_new, 5,
+                                       SAI_ACL_ENTRY_ATTR_TABLE_ID, mac_table_id,
+                                       SAI_ACL_ENTRY_ATTR_PRIORITY, 20,
+                                       SAI_ACL_ENTRY_ATTR_ADMIN_STATE, true,
+                                       SAI_ACL_TABLE_ATTR_FIELD_DST_MAC,
+                                       1, &dst_mac_data, &dst_mac_mask,
+                                       SAI_ACL_TABLE_ATTR_FIELD_ETHER_TYPE,
+                                       1, 0x8809, 0xffff);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    EXPECT_EQ (acl_rule_id[1], acl_rule_id_new);
+
+    acl_rule_id[1] = acl_rule_id_new;
+
+    for (rule_idx = 0; rule_idx < 3; rule_idx++) {
+        sai_rc = sai_test_acl_rule_remove (acl_rule_id[rule_idx]);
+        EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+    }
+}
+
+/*
+ * Bulk rule create and remove, with an invalid entry in the batch.
+ */
+TEST_F(saiACLRuleTest, rule_bulk_create_and_remove)
+{
+    static const unsigned int bulk_count = 4;
+    static const unsigned int bad_index = 2;
+    static const unsigned int rule_attr_count = 3;
+    sai_status_t              sai_rc = SAI_STATUS_SUCCESS;
+    sai_attribute_t           rule_attr [bulk_count][rule_attr_count];
+    const sai_attribute_t    *attr_list [bulk_count];
+    uint32_t                  attr_count [bulk_count];
+    sai_object_id_t           acl_rule_id [bulk_count];
+    sai_status_t              statuses [bulk_count];
+    unsigned int              rule_idx = 0;
+
+    memset (rule_attr, 0, sizeof (rule_attr));
+
+    for (rule_idx = 0; rule_idx < bulk_count; rule_idx++) {
+        rule_attr [rule_idx][0].id = SAI_ACL_ENTRY_ATTR_TABLE_ID;
+        rule_attr [rule_idx][0].value.oid = mac_table_id;
+        rule_attr [rule_idx][1].id = SAI_ACL_ENTRY_ATTR_PRIORITY;
+        rule_attr [rule_idx][1].value.u32 = 30 + rule_idx;
+        rule_attr [rule_idx][2].id = SAI_ACL_ENTRY_ATTR_FIELD_ETHER_TYPE;
+        rule_attr [rule_idx][2].value.aclfield.enable = true;
+        rule_attr [rule_idx][2].value.aclfield.data.u16 = 0x8809;
+        rule_attr [rule_idx][2].value.aclfield.mask.u16 = 0xffff;
+
+        attr_list [rule_idx] = rule_attr [rule_idx];
+        attr_count [rule_idx] = rule_attr_count;
+    }
+
+    /* No field in the bad entry */
+    attr_count [bad_index] = 2;
+
+    sai_rc = sai_bulk_create_acl_rule (sai_acl_get_global_switch_id (),
+                                       bulk_count, attr_count, attr_list,
+                                       SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                       acl_rule_id, statuses);
+    EXPECT_EQ (SAI_STATUS_FAILURE, sai_rc);
+
+    sai_test_bulk_ignore_error_check (bulk_count, statuses, bad_index,
+                                      SAI_STATUS_MANDATORY_ATTRIBUTE_MISSING);
+
+    for (rule_idx = 0; rule_idx < bulk_count; rule_idx++) {
+        if (rule_idx == bad_index) {
+            EXPECT_EQ (SAI_NULL_OBJECT_ID, acl_rule_id [rule_idx]);
+        } else {
+            EXPECT_NE (SAI_NULL_OBJECT_ID, acl_rule_id [rule_idx]);
+        }
+    }
+
+    /* Stop on the bad entry, the last rule is not removed */
+    sai_rc = sai_bulk_remove_acl_rule (bulk_count, acl_rule_id,
+                                       SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                       statuses);
+    EXPECT_EQ (SAI_STATUS_FAILURE, sai_rc);
+    sai_test_bulk_stop_on_error_check (bulk_count, statuses, bad_index,
+                                       SAI_STATUS_INVALID_OBJECT_TYPE);
+
+    sai_rc = sai_test_acl_rule_remove (acl_rule_id [3]);
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+}
+
 TEST_F(saiACLRuleTest, rule_set_with_invalid_attributes)
 {
     sai_status_t          sai_rc = SAI_STATUS_SUCCESS;
@@ -4920,6 +5259,61 @@ TEST_F(saiACLRuleTest, acl_range)
     EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
 
 }
+TEST_F(saiACLRuleTest, acl_range_l4_port_checker)
+{
+    sai_object_id_t  acl_range_id = 0;
+    sai_attribute_t  attr_list[2];
+    sai_attribute_t  set_attr;
+    sai_attribute_t  get_attr;
+    sai_acl_range_t *p_range_node = NULL;
+    sai_object_id_t  switch_id = saiACLTest ::sai_acl_get_global_switch_id();
+
+    attr_list[0].id = SAI_ACL_RANGE_ATTR_TYPE;
+    attr_list[0].value.s32 = SAI_ACL_RANGE_TYPE_L4_DST_PORT_RANGE;
+    attr_list[1].id = SAI_ACL_RANGE_ATTR_LIMIT;
+    attr_list[1].value.s32range.min = 1000;
+    attr_list[1].value.s32range.max = 2000;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, p_sai_acl_api_tbl->
+              create_acl_range(&acl_range_id, switch_id, 2,
+                               (const sai_attribute_t *)attr_list));
+
+    p_range_node = sai_acl_range_find(sai_acl_get_acl_node()->sai_acl_range_tree,
+                                      acl_range_id);
+    ASSERT_TRUE(p_range_node != NULL);
+
+    EXPECT_FALSE(sai_vm_acl_range_match(p_range_node, 999));
+    EXPECT_TRUE(sai_vm_acl_range_match(p_range_node, 1000));
+    EXPECT_TRUE(sai_vm_acl_range_match(p_range_node, 2000));
+    EXPECT_FALSE(sai_vm_acl_range_match(p_range_node, 2001));
+    EXPECT_FALSE(sai_vm_acl_range_match(p_range_node, 0x10000));
+
+    /* Limit set rebuilds the checker of the range */
+    set_attr.id = SAI_ACL_RANGE_ATTR_LIMIT;
+    set_attr.value.s32range.min = 1500;
+    set_attr.value.s32range.max = 1600;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, p_sai_acl_api_tbl->
+              set_acl_range_attribute(acl_range_id,
+                                      (const sai_attribute_t *)&set_attr));
+
+    get_attr.id = SAI_ACL_RANGE_ATTR_LIMIT;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, p_sai_acl_api_tbl->
+              get_acl_range_attribute(acl_range_id, 1, &get_attr));
+
+    EXPECT_EQ(1500, get_attr.value.s32range.min);
+    EXPECT_EQ(1600, get_attr.value.s32range.max);
+
+    EXPECT_FALSE(sai_vm_acl_range_match(p_range_node, 1000));
+    EXPECT_TRUE(sai_vm_acl_range_match(p_range_node, 1500));
+    EXPECT_TRUE(sai_vm_acl_range_match(p_range_node, 1600));
+    EXPECT_FALSE(sai_vm_acl_range_match(p_range_node, 2000));
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, p_sai_acl_api_tbl->
+                            remove_acl_range(acl_range_id));
+}
+
 TEST_F(saiACLRuleTest, rule_with_next_header)
 {
     sai_status_t    sai_rc = SAI_STATUS_SUCCESS;
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file  sai_acl_bench.cpp
+*
+* @brief This file contains the microbenchmarks of the SAI ACL entry and
+*        counter APIs.
+*
+*************************************************************************/
+
+#include "sai_bench_utils.h"
+
+extern "C" {
+#include "sai.h"
+#include "saiacl.h"
+#include "sai_common_acl.h"
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+}
+
+#include <vector>
+
+class saiAclBench : public saiBenchTest
+{
+    public:
+        static void SetUpTestCase (void);
+        static void TearDownTestCase (void);
+
+        static void acl_entry_attr_fill (uint32_t index, uint32_t priority,
+                                         sai_attribute_t *attr_list);
+        static sai_status_t acl_entry_create (uint32_t index, uint32_t priority,
+                                              sai_object_id_t *p_entry_id);
+        static void entries_install (const char *op,
+                                     const std::vector<uint32_t> &priorities);
+
+        static sai_acl_api_t  *p_acl_api;
+        static sai_object_id_t table_id;
+
+        /* Entries per table in the VM profile */
+        static const uint32_t  entry_count = 512;
+        /* Attributes of a benchmark entry */
+        static const uint32_t  entry_attr_count = 7;
+        /* Entries of the policy installed with the bulk APIs */
+        static const uint32_t  policy_entry_count = 10000;
+        /* Counters per table in the VM */
+        static const uint32_t  counter_count = 512;
+};
+
+sai_acl_api_t  *saiAclBench ::p_acl_api = NULL;
+sai_object_id_t saiAclBench ::table_id = 0;
+
+void saiAclBench ::SetUpTestCase (void)
+{
+    static const sai_attr_id_t table_fields [] = {
+        SAI_ACL_TABLE_ATTR_FIELD_SRC_IP,
+        SAI_ACL_TABLE_ATTR_FIELD_DST_IP,
+        SAI_ACL_TABLE_ATTR_FIELD_L4_SRC_PORT,
+        SAI_ACL_TABLE_ATTR_FIELD_L4_DST_PORT,
+        SAI_ACL_TABLE_ATTR_FIELD_IP_PROTOCOL,
+    };
+    static const unsigned int field_count =
+        sizeof (table_fields) / sizeof (table_fields [0]);
+    sai_attribute_t attr_list [2 + field_count];
+    unsigned int    idx;
+
+    saiBenchTest ::SetUpTestCase ();
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_api_query
+               (SAI_API_ACL, (static_cast<void**>
+                              (static_cast<void*>(&p_acl_api)))));
+
+    ASSERT_TRUE (p_acl_api != NULL);
+
+    memset (attr_list, 0, sizeof (attr_list));
+
+    attr_list [0].id = SAI_ACL_TABLE_ATTR_ACL_STAGE;
+    attr_list [0].value.s32 = SAI_ACL_STAGE_INGRESS;
+    attr_list [1].id = SAI_ACL_TABLE_ATTR_PRIORITY;
+    attr_list [1].value.u32 = 1;
+
+    for (idx = 0; idx < field_count; idx++) {
+        attr_list [2 + idx].id = table_fields [idx];
+        attr_list [2 + idx].value.booldata = true;
+    }
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_acl_api->create_acl_table (&table_id, switch_id,
+                                            2 + field_count, attr_list));
+}
+
+void saiAclBench ::TearDownTestCase (void)
+{
+    EXPECT_EQ (SAI_STATUS_SUCCESS, p_acl_api->remove_acl_table (table_id));
+}
+
+void saiAclBench ::acl_entry_attr_fill (uint32_t index, uint32_t priority,
+                                        sai_attribute_t *attr_list)
+{
+    memset (attr_list, 0, entry_attr_count * sizeof (sai_attribute_t));
+
+    attr_list [0].id = SAI_ACL_ENTRY_ATTR_TABLE_ID;
+    attr_list [0].value.oid = table_id;
+    attr_list [1].id = SAI_ACL_ENTRY_ATTR_PRIORITY;
+    attr_list [1].value.u32 = priority;
+    attr_list [2].id = SAI_ACL_ENTRY_ATTR_ADMIN_STATE;
+    attr_list [2].value.booldata = true;
+
+    attr_list [3].id = SAI_ACL_ENTRY_ATTR_FIELD_SRC_IP;
+    attr_list [3].value.aclfield.enable = true;
+    attr_list [3].value.aclfield.data.ip4 = htonl (0x0a000000 + index);
+    attr_list [3].value.aclfield.mask.ip4 = htonl (0xffffffff);
+
+    attr_list [4].id = SAI_ACL_ENTRY_ATTR_FIELD_L4_DST_PORT;
+    attr_list [4].value.aclfield.enable = true;
+    attr_list [4].value.aclfield.data.u16 = (uint16_t) (1024 + index);
+    attr_list [4].value.aclfield.mask.u16 = 0xffff;
+
+    attr_list [5].id = SAI_ACL_ENTRY_ATTR_FIELD_IP_PROTOCOL;
+    attr_list [5].value.aclfield.enable = true;
+    attr_list [5].value.aclfield.data.u8 = 6;
+    attr_list [5].value.aclfield.mask.u8 = 0xff;
+
+    attr_list [6].id = SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION;
+    attr_list [6].value.aclaction.enable = true;
+    attr_list [6].value.aclaction.parameter.s32 = SAI_PACKET_ACTION_DROP;
+}
+
+sai_status_t saiAclBench ::acl_entry_create (uint32_t index, uint32_t priority,
+                                             sai_object_id_t *p_entry_id)
+{
+    sai_attribute_t attr_list [entry_attr_count];
+
+    acl_entry_attr_fill (index, priority, attr_list);
+
+    return p_acl_api->create_acl_entry (p_entry_id, switch_id,
+                                        entry_attr_count, attr_list);
+}
+
+void saiAclBench ::entries_install (const char *op,
+                                    const std::vector<uint32_t> &priorities)
+{
+    std::vector<sai_object_id_t> entry_list (priorities.size ());
+    saiBenchTimer                timer;
+    uint32_t                     idx;
+
+    timer.start ();
+
+    for (idx = 0; idx < priorities.size (); idx++) {
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   acl_entry_create (idx, priorities [idx], &entry_list [idx]));
+    }
+
+    sai_bench_result_record ("acl_entry", op, priorities.size (),
+                             priorities.size (), timer.elapsed_sec ());
+
+    timer.start ();
+
+    for (idx = 0; idx < entry_list.size (); idx++) {
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   p_acl_api->remove_acl_entry (entry_list [idx]));
+    }
+
+    sai_bench_result_record ("acl_entry", "remove", entry_list.size (),
+                             entry_list.size (), timer.elapsed_sec ());
+}
+
+/*
+ * ACL entry install rate of a full table, in ascending, descending and
+ * random priority order since the rule list is kept priority sorted.
+ */
+TEST_F (saiAclBench, acl_entry_install)
+{
+    std::vector<uint32_t> priorities (entry_count);
+    uint32_t              idx;
+
+    for (idx = 0; idx < entry_count; idx++) {
+        priorities [idx] = idx + 1;
+    }
+
+    entries_install ("create_ascending_prio", priorities);
+
+    for (idx = 0; idx < entry_count; idx++) {
+        priorities [idx] = entry_count - idx;
+    }
+
+    entries_install ("create_descending_prio", priorities);
+
+    srandom (entry_count);
+
+    for (idx = 0; idx < entry_count; idx++) {
+        priorities [idx] = 1 + (random () % 0xffff);
+    }
+
+    entries_install ("create_random_prio", priorities);
+}
+
+/*
+ * Install and remove a policy of 10K entries with one call per entry, then
+ * with the bulk ACL entry APIs.
+ */
+TEST_F (saiAclBench, acl_policy_bulk_install)
+{
+    std::vector<sai_attribute_t>        attr_buf (policy_entry_count *
+                                                  entry_attr_count);
+    std::vector<const sai_attribute_t*> attr_list (policy_entry_count);
+    std::vector<uint32_t>               attr_count (policy_entry_count,
+                                                    (uint32_t) entry_attr_count);
+    std::vector<sai_object_id_t>        entry_list (policy_entry_count);
+    std::vector<sai_status_t>           statuses (policy_entry_count);
+    saiBenchTimer                       timer;
+    uint32_t                            idx;
+
+    for (idx = 0; idx < policy_entry_count; idx++) {
+        acl_entry_attr_fill (idx, idx + 1, &attr_buf [idx * entry_attr_count]);
+        attr_list [idx] = &attr_buf [idx * entry_attr_count];
+    }
+
+    timer.start ();
+
+    for (idx = 0; idx < policy_entry_count; idx++) {
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   p_acl_api->create_acl_entry (&entry_list [idx], switch_id,
+                                                entry_attr_count,
+                                                attr_list [idx]));
+    }
+
+    sai_bench_result_record ("acl_policy", "create_single", policy_entry_count,
+                             policy_entry_count, timer.elapsed_sec ());
+
+    timer.start ();
+
+    for (idx = 0; idx < policy_entry_count; idx++) {
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   p_acl_api->remove_acl_entry (entry_list [idx]));
+    }
+
+    sai_bench_result_record ("acl_policy", "remove_single", policy_entry_count,
+                             policy_entry_count, timer.elapsed_sec ());
+
+    timer.start ();
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_bulk_create_acl_rule (switch_id, policy_entry_count,
+                                         attr_count.data (), attr_list.data (),
+                                         SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                         entry_list.data (), statuses.data ()));
+
+    sai_bench_result_record ("acl_policy", "create_bulk", policy_entry_count,
+                             policy_entry_count, timer.elapsed_sec ());
+
+    timer.start ();
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_bulk_remove_acl_rule (policy_entry_count, entry_list.data (),
+                                         SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                         statuses.data ()));
+
+    sai_bench_result_record ("acl_policy", "remove_bulk", policy_entry_count,
+                             policy_entry_count, timer.elapsed_sec ());
+}
+
+/*
+ * Create and remove all the counters of a table with one call per counter,
+ * then with the bulk ACL counter APIs.
+ */
+TEST_F (saiAclBench, acl_counter_bulk_install)
+{
+    sai_attribute_t                     cntr_attr [2];
+    std::vector<const sai_attribute_t*> attr_list (counter_count, cntr_attr);
+    std::vector<uint32_t>               attr_count (counter_count, 2);
+    std::vector<sai_object_id_t>        cntr_list (counter_count);
+    std::vector<sai_status_t>           statuses (counter_count);
+    saiBenchTimer                       timer;
+    uint32_t                            idx;
+
+    memset (cntr_attr, 0, sizeof (cntr_attr));
+
+    cntr_attr [0].id = SAI_ACL_COUNTER_ATTR_TABLE_ID;
+    cntr_attr [0].value.oid = table_id;
+    cntr_attr [1].id = SAI_ACL_COUNTER_ATTR_ENABLE_PACKET_COUNT;
+    cntr_attr [1].value.booldata = true;
+
+    timer.start ();
+
+    for (idx = 0; idx < counter_count; idx++) {
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   p_acl_api->create_acl_counter (&cntr_list [idx], switch_id,
+                                                  2, cntr_attr));
+    }
+
+    sai_bench_result_record ("acl_counter", "create_single", counter_count,
+                             counter_count, timer.elapsed_sec ());
+
+    timer.start ();
+
+    for (idx = 0; idx < counter_count; idx++) {
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   p_acl_api->remove_acl_counter (cntr_list [idx]));
+    }
+
+    sai_bench_result_record ("acl_counter", "remove_single", counter_count,
+                             counter_count, timer.elapsed_sec ());
+
+    timer.start ();
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_bulk_create_acl_counter (switch_id, counter_count,
+                                            attr_count.data (), attr_list.data (),
+                                            SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                            cntr_list.data (), statuses.data ()));
+
+    sai_bench_result_record ("acl_counter", "create_bulk", counter_count,
+                             counter_count, timer.elapsed_sec ());
+
+    timer.start ();
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               sai_bulk_remove_acl_counter (counter_count, cntr_list.data (),
+                                            SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                            statuses.data ()));
+
+    sai_bench_result_record ("acl_counter", "remove_bulk", counter_count,
+                             counter_count, timer.elapsed_sec ());
+}
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file  sai_bench_utils.cpp
+*
+* @brief This file contains the switch initialization and the result
+*        reporting shared by the SAI control plane microbenchmarks.
+*
+*************************************************************************/
+
+#include "sai_bench_utils.h"
+
+extern "C" {
+#include "sai.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/utsname.h>
+}
+
+#include <atomic>
+
+sai_object_id_t    saiBenchTest ::switch_id = 0;
+sai_object_id_t    saiBenchTest ::default_vlan_id = 0;
+sai_object_id_t    saiBenchTest ::default_bridge_id = 0;
+sai_switch_api_t  *saiBenchTest ::p_sai_switch_api_tbl = NULL;
+sai_bridge_api_t  *saiBenchTest ::p_sai_bridge_api_tbl = NULL;
+unsigned int       saiBenchTest ::port_count = 0;
+sai_object_id_t    saiBenchTest ::port_list [SAI_BENCH_MAX_PORTS] = {0};
+unsigned int       saiBenchTest ::bridge_port_count = 0;
+sai_object_id_t    saiBenchTest ::bridge_port_list [SAI_BENCH_MAX_PORTS] = {0};
+
+static std::atomic<uint64_t> sai_bench_rx_packet_count (0);
+
+/*
+ * Stubs for Callback functions to be passed from adapter host/application.
+ */
+static inline void sai_port_state_evt_callback (uint32_t count,
+                                                sai_port_oper_status_notification_t *data)
+{
+}
+
+static inline void sai_fdb_evt_callback (uint32_t count,
+                                         sai_fdb_event_notification_data_t *data)
+{
+}
+
+static inline void sai_switch_operstate_callback (sai_switch_oper_status_t
+                                                  switchstate)
+{
+}
+
+static inline void sai_packet_event_callback (const void *buffer,
+                                              sai_size_t buffer_size,
+                                              uint32_t attr_count,
+                                              const sai_attribute_t *attr_list)
+{
+    sai_bench_rx_packet_count.fetch_add (1, std::memory_order_relaxed);
+}
+
+static inline void sai_switch_shutdown_callback (void)
+{
+}
+
+/* SAI switch initialization, done once for all the benchmark cases */
+void saiBenchTest ::SetUpTestCase (void)
+{
+    sai_attribute_t attr;
+    sai_attribute_t sai_attr_set [7];
+    uint32_t        attr_count = 7;
+
+    if (p_sai_switch_api_tbl != NULL) {
+        return;
+    }
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_api_query
+               (SAI_API_SWITCH, (static_cast<void**>
+                                 (static_cast<void*>(&p_sai_switch_api_tbl)))));
+
+    ASSERT_TRUE (p_sai_switch_api_tbl != NULL);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_api_query
+               (SAI_API_BRIDGE, (static_cast<void**>
+                                 (static_cast<void*>(&p_sai_bridge_api_tbl)))));
+
+    ASSERT_TRUE (p_sai_bridge_api_tbl != NULL);
+
+    memset (sai_attr_set, 0, sizeof (sai_attr_set));
+
+    sai_attr_set[0].id = SAI_SWITCH_ATTR_INIT_SWITCH;
+    sai_attr_set[0].value.booldata = 1;
+
+    sai_attr_set[1].id = SAI_SWITCH_ATTR_SWITCH_PROFILE_ID;
+    sai_attr_set[1].value.u32 = 0;
+
+    sai_attr_set[2].id = SAI_SWITCH_ATTR_FDB_EVENT_NOTIFY;
+    sai_attr_set[2].value.ptr = (void *)sai_fdb_evt_callback;
+
+    sai_attr_set[3].id = SAI_SWITCH_ATTR_PORT_STATE_CHANGE_NOTIFY;
+    sai_attr_set[3].value.ptr = (void *)sai_port_state_evt_callback;
+
+    sai_attr_set[4].id = SAI_SWITCH_ATTR_PACKET_EVENT_NOTIFY;
+    sai_attr_set[4].value.ptr = (void *)sai_packet_event_callback;
+
+    sai_attr_set[5].id = SAI_SWITCH_ATTR_SWITCH_STATE_CHANGE_NOTIFY;
+    sai_attr_set[5].value.ptr = (void *)sai_switch_operstate_callback;
+
+    sai_attr_set[6].id = SAI_SWITCH_ATTR_SHUTDOWN_REQUEST_NOTIFY;
+    sai_attr_set[6].value.ptr = (void *)sai_switch_shutdown_callback;
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_sai_switch_api_tbl->create_switch (&switch_id, attr_count,
+                                                    sai_attr_set));
+
+    memset (&attr, 0, sizeof (attr));
+
+    attr.id = SAI_SWITCH_ATTR_PORT_LIST;
+    attr.value.objlist.count = SAI_BENCH_MAX_PORTS;
+    attr.value.objlist.list  = port_list;
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_sai_switch_api_tbl->get_switch_attribute (switch_id, 1, &attr));
+    port_count = attr.value.objlist.count;
+
+    attr.id = SAI_SWITCH_ATTR_DEFAULT_VLAN_ID;
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_sai_switch_api_tbl->get_switch_attribute (switch_id, 1, &attr));
+    default_vlan_id = attr.value.oid;
+
+    attr.id = SAI_SWITCH_ATTR_DEFAULT_1Q_BRIDGE_ID;
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_sai_switch_api_tbl->get_switch_attribute (switch_id, 1, &attr));
+    default_bridge_id = attr.value.oid;
+
+    attr.id = SAI_BRIDGE_ATTR_PORT_LIST;
+    attr.value.objlist.count = SAI_BENCH_MAX_PORTS;
+    attr.value.objlist.list = bridge_port_list;
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_sai_bridge_api_tbl->get_bridge_attribute (default_bridge_id,
+                                                           1, &attr));
+    bridge_port_count = attr.value.objlist.count;
+
+    ASSERT_TRUE (port_count != 0);
+    ASSERT_TRUE (bridge_port_count != 0);
+}
+
+sai_object_id_t saiBenchTest ::sai_bench_port_id_get (uint32_t port_index)
+{
+    if (port_index >= port_count) {
+        return 0;
+    }
+
+    return port_list [port_index];
+}
+
+sai_object_id_t saiBenchTest ::sai_bench_bridge_port_id_get (uint32_t port_index)
+{
+    if (port_index >= bridge_port_count) {
+        return 0;
+    }
+
+    return bridge_port_list [port_index];
+}
+
+uint64_t saiBenchTest ::sai_bench_rx_packet_count_get (void)
+{
+    return sai_bench_rx_packet_count.load (std::memory_order_relaxed);
+}
+
+std::vector<uint64_t> saiBenchTest ::sai_bench_scales_get (
+                                     const char *env_name,
+                                     const std::vector<uint64_t> &dflt)
+{
+    std::vector<uint64_t> scales;
+    const char           *env = getenv (env_name);
+    char                 *end = NULL;
+    uint64_t              scale;
+
+    if ((env == NULL) || (*env == '\0')) {
+        return dflt;
+    }
+
+    while (*env != '\0') {
+        scale = strtoull (env, &end, 0);
+
+        if (end == env) {
+            break;
+        }
+
+        if (scale != 0) {
+            scales.push_back (scale);
+        }
+
+        env = (*end == ',') ? (end + 1) : end;
+    }
+
+    return (scales.empty () ? dflt : scales);
+}
+
+void saiBenchTest ::sai_bench_result_record (const char *bench, const char *op,
+                                             uint64_t scale, uint64_t op_count,
+                                             double sec)
+{
+    const char     *file_name = getenv (SAI_BENCH_RESULT_FILE_ENV);
+    const char     *commit = getenv (SAI_BENCH_COMMIT_ENV);
+    FILE           *fp = stdout;
+    struct utsname  uts;
+    double          ops_per_sec = (sec > 0) ? (op_count / sec) : 0;
+    double          usec_per_op = (op_count != 0) ? ((sec * 1e6) / op_count) : 0;
+
+    if (uname (&uts) != 0) {
+        snprintf (uts.nodename, sizeof (uts.nodename), "unknown");
+        snprintf (uts.release, sizeof (uts.release), "unknown");
+    }
+
+    if ((file_name != NULL) && (*file_name != '\0')) {
+        fp = fopen (file_name, "a");
+
+        if (fp == NULL) {
+            printf ("Failed to open benchmark result file %s.\r\n", file_name);
+            fp = stdout;
+        }
+    }
+
+    fprintf (fp, "{\"bench\": \"%s\", \"op\": \"%s\", \"scale\": %llu, "
+             "\"count\": %llu, \"sec\": %.6f, \"ops_per_sec\": %.1f, "
+             "\"usec_per_op\": %.3f, \"commit\": \"%s\", \"host\": \"%s\", "
+             "\"kernel\": \"%s\", \"cpus\": %ld, \"timestamp\": %ld}\n",
+             bench, op, (unsigned long long) scale,
+             (unsigned long long) op_count, sec, ops_per_sec, usec_per_op,
+             (commit != NULL) ? commit : "", uts.nodename, uts.release,
+             sysconf (_SC_NPROCESSORS_ONLN), (long) time (NULL));
+
+    if (fp != stdout) {
+        fclose (fp);
+    } else {
+        fflush (fp);
+    }
+}
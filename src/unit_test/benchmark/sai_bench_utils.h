@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file  sai_bench_utils.h
+*
+* @brief This file contains the class definition and helper prototypes
+*        shared by the SAI control plane microbenchmarks.
+*
+* Results are appended as one JSON object per line to the file named by
+* SAI_BENCH_RESULT_FILE (stdout if unset), so that runs of different
+* commits can be compared with standard tools.
+*
+*************************************************************************/
+
+#ifndef __SAI_BENCH_UTILS_H__
+#define __SAI_BENCH_UTILS_H__
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "saitypes.h"
+#include "saistatus.h"
+#include "saiswitch.h"
+#include "saiport.h"
+#include "saibridge.h"
+#include "saivlan.h"
+#include <stdint.h>
+#include <time.h>
+}
+
+#include <vector>
+
+/* Environment variables read by the benchmarks */
+#define SAI_BENCH_RESULT_FILE_ENV   "SAI_BENCH_RESULT_FILE"
+#define SAI_BENCH_COMMIT_ENV        "SAI_BENCH_COMMIT"
+#define SAI_BENCH_ROUTE_SCALES_ENV  "SAI_BENCH_ROUTE_SCALES"
+#define SAI_BENCH_HOSTIF_PEER_ENV   "SAI_BENCH_HOSTIF_PEER"
+#define SAI_BENCH_QOS_PORT_SCALES_ENV  "SAI_BENCH_QOS_PORT_SCALES"
+
+/* Monotonic stopwatch */
+class saiBenchTimer
+{
+    public:
+        void start (void)
+        {
+            clock_gettime (CLOCK_MONOTONIC, &start_ts);
+        }
+
+        double elapsed_sec (void) const
+        {
+            struct timespec now;
+
+            clock_gettime (CLOCK_MONOTONIC, &now);
+
+            return ((now.tv_sec - start_ts.tv_sec) +
+                    ((now.tv_nsec - start_ts.tv_nsec) / 1e9));
+        }
+
+    private:
+        struct timespec start_ts;
+};
+
+class saiBenchTest : public ::testing::Test
+{
+    public:
+        static void SetUpTestCase (void);
+
+        /*
+         * Record one measurement: op_count operations of a benchmark at a
+         * given scale took sec seconds.
+         */
+        static void sai_bench_result_record (const char *bench,
+                                             const char *op,
+                                             uint64_t scale,
+                                             uint64_t op_count,
+                                             double sec);
+
+        /* Parse a comma separated list of scales from the environment */
+        static std::vector<uint64_t> sai_bench_scales_get (
+                                             const char *env_name,
+                                             const std::vector<uint64_t> &dflt);
+
+        static sai_object_id_t sai_bench_port_id_get (uint32_t port_index);
+        static sai_object_id_t sai_bench_bridge_port_id_get (uint32_t port_index);
+
+        static const unsigned int SAI_BENCH_MAX_PORTS = 256;
+
+        static sai_object_id_t    switch_id;
+        static sai_object_id_t    default_vlan_id;
+        static sai_object_id_t    default_bridge_id;
+        static sai_switch_api_t  *p_sai_switch_api_tbl;
+        static sai_bridge_api_t  *p_sai_bridge_api_tbl;
+        static unsigned int       port_count;
+        static sai_object_id_t    port_list [SAI_BENCH_MAX_PORTS];
+        static unsigned int       bridge_port_count;
+        static sai_object_id_t    bridge_port_list [SAI_BENCH_MAX_PORTS];
+
+        /* Packets delivered to the packet event callback so far */
+        static uint64_t sai_bench_rx_packet_count_get (void);
+};
+
+#endif /* __SAI_BENCH_UTILS_H__ */
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file  sai_fdb_bench.cpp
+*
+* @brief This file contains the microbenchmarks of the SAI FDB APIs.
+*
+*************************************************************************/
+
+#include "sai_bench_utils.h"
+
+extern "C" {
+#include "sai.h"
+#include "saifdb.h"
+#include "sai_fdb_main.h"
+#include "sai_api_stats.h"
+#include <string.h>
+}
+
+#include <vector>
+
+/* Highest API stats overhead accepted, in percent */
+#define SAI_BENCH_API_STATS_MAX_OVERHEAD  5.0
+
+class saiFdbBench : public saiBenchTest
+{
+    public:
+        static void SetUpTestCase (void);
+
+        static void fdb_entry_fill (uint32_t index, sai_fdb_entry_t *p_entry);
+        static void fdb_entries_create (uint32_t count,
+                                        sai_object_id_t bridge_port_id);
+        static double fdb_churn_sec (void);
+
+        static sai_fdb_api_t *p_fdb_api;
+
+        /* FDB table size of the VM profile */
+        static const uint32_t fdb_count = 8192;
+
+        /* Batch size of the bulk FDB APIs */
+        static const uint32_t fdb_bulk_count = 256;
+};
+
+sai_fdb_api_t *saiFdbBench ::p_fdb_api = NULL;
+
+void saiFdbBench ::SetUpTestCase (void)
+{
+    saiBenchTest ::SetUpTestCase ();
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_api_query
+               (SAI_API_FDB, (static_cast<void**>
+                              (static_cast<void*>(&p_fdb_api)))));
+
+    ASSERT_TRUE (p_fdb_api != NULL);
+}
+
+void saiFdbBench ::fdb_entry_fill (uint32_t index, sai_fdb_entry_t *p_entry)
+{
+    memset (p_entry, 0, sizeof (sai_fdb_entry_t));
+
+    /* Locally administered unicast MACs */
+    p_entry->mac_address [0] = 0x02;
+    p_entry->mac_address [1] = 0xbe;
+    p_entry->mac_address [2] = 0x00;
+    p_entry->mac_address [3] = (uint8_t) (index >> 16);
+    p_entry->mac_address [4] = (uint8_t) (index >> 8);
+    p_entry->mac_address [5] = (uint8_t) index;
+    p_entry->bv_id = default_vlan_id;
+}
+
+void saiFdbBench ::fdb_entries_create (uint32_t count,
+                                       sai_object_id_t bridge_port_id)
+{
+    sai_fdb_entry_t fdb_entry;
+    sai_attribute_t attr_list [3];
+    uint32_t        idx;
+
+    memset (attr_list, 0, sizeof (attr_list));
+
+    attr_list [0].id = SAI_FDB_ENTRY_ATTR_TYPE;
+    attr_list [0].value.s32 = SAI_FDB_ENTRY_TYPE_DYNAMIC;
+    attr_list [1].id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
+    attr_list [1].value.oid = bridge_port_id;
+    attr_list [2].id = SAI_FDB_ENTRY_ATTR_PACKET_ACTION;
+    attr_list [2].value.s32 = SAI_PACKET_ACTION_FORWARD;
+
+    for (idx = 0; idx < count; idx++) {
+        fdb_entry_fill (idx, &fdb_entry);
+
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   p_fdb_api->create_fdb_entry (&fdb_entry, 3, attr_list));
+    }
+}
+
+/*
+ * FDB create and remove rate at 8K MACs.
+ */
+TEST_F (saiFdbBench, fdb_create_remove)
+{
+    sai_fdb_entry_t fdb_entry;
+    saiBenchTimer   timer;
+    uint32_t        idx;
+
+    timer.start ();
+
+    fdb_entries_create (fdb_count, sai_bench_bridge_port_id_get (0));
+
+    sai_bench_result_record ("fdb", "create", fdb_count, fdb_count,
+                             timer.elapsed_sec ());
+
+    timer.start ();
+
+    for (idx = 0; idx < fdb_count; idx++) {
+        fdb_entry_fill (idx, &fdb_entry);
+
+        ASSERT_EQ (SAI_STATUS_SUCCESS, p_fdb_api->remove_fdb_entry (&fdb_entry));
+    }
+
+    sai_bench_result_record ("fdb", "remove", fdb_count, fdb_count,
+                             timer.elapsed_sec ());
+}
+
+/*
+ * FDB flush latency of 8K dynamic MACs, per bridge port and per VLAN.
+ */
+TEST_F (saiFdbBench, fdb_flush)
+{
+    sai_attribute_t flush_attr [2];
+    saiBenchTimer   timer;
+
+    fdb_entries_create (fdb_count, sai_bench_bridge_port_id_get (0));
+
+    memset (flush_attr, 0, sizeof (flush_attr));
+
+    flush_attr [0].id = SAI_FDB_FLUSH_ATTR_BRIDGE_PORT_ID;
+    flush_attr [0].value.oid = sai_bench_bridge_port_id_get (0);
+    flush_attr [1].id = SAI_FDB_FLUSH_ATTR_ENTRY_TYPE;
+    flush_attr [1].value.s32 = SAI_FDB_FLUSH_ENTRY_TYPE_DYNAMIC;
+
+    timer.start ();
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_fdb_api->flush_fdb_entries (switch_id, 2, flush_attr));
+
+    sai_bench_result_record ("fdb", "flush_port", fdb_count, fdb_count,
+                             timer.elapsed_sec ());
+
+    fdb_entries_create (fdb_count, sai_bench_bridge_port_id_get (0));
+
+    flush_attr [0].id = SAI_FDB_FLUSH_ATTR_BV_ID;
+    flush_attr [0].value.oid = default_vlan_id;
+
+    timer.start ();
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_fdb_api->flush_fdb_entries (switch_id, 2, flush_attr));
+
+    sai_bench_result_record ("fdb", "flush_vlan", fdb_count, fdb_count,
+                             timer.elapsed_sec ());
+}
+
+/*
+ * Time of 8K MACs created and removed one by one, then in batches with the
+ * bulk APIs.
+ */
+double saiFdbBench ::fdb_churn_sec (void)
+{
+    sai_attribute_t attr_list [3];
+    std::vector<sai_fdb_entry_t> entry_list (fdb_bulk_count);
+    std::vector<const sai_attribute_t *> attr_ptr_list (fdb_bulk_count, attr_list);
+    std::vector<uint32_t> attr_count_list (fdb_bulk_count, 3);
+    std::vector<sai_status_t> status_list (fdb_bulk_count);
+    sai_fdb_entry_t fdb_entry;
+    saiBenchTimer   timer;
+    uint32_t        base;
+    uint32_t        idx;
+
+    memset (attr_list, 0, sizeof (attr_list));
+
+    attr_list [0].id = SAI_FDB_ENTRY_ATTR_TYPE;
+    attr_list [0].value.s32 = SAI_FDB_ENTRY_TYPE_DYNAMIC;
+    attr_list [1].id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
+    attr_list [1].value.oid = sai_bench_bridge_port_id_get (0);
+    attr_list [2].id = SAI_FDB_ENTRY_ATTR_PACKET_ACTION;
+    attr_list [2].value.s32 = SAI_PACKET_ACTION_FORWARD;
+
+    timer.start ();
+
+    for (idx = 0; idx < fdb_count; idx++) {
+        fdb_entry_fill (idx, &fdb_entry);
+
+        EXPECT_EQ (SAI_STATUS_SUCCESS,
+                   p_fdb_api->create_fdb_entry (&fdb_entry, 3, attr_list));
+    }
+
+    for (idx = 0; idx < fdb_count; idx++) {
+        fdb_entry_fill (idx, &fdb_entry);
+
+        EXPECT_EQ (SAI_STATUS_SUCCESS, p_fdb_api->remove_fdb_entry (&fdb_entry));
+    }
+
+    for (base = 0; base < fdb_count; base += fdb_bulk_count) {
+        for (idx = 0; idx < fdb_bulk_count; idx++) {
+            fdb_entry_fill (base + idx, &entry_list [idx]);
+        }
+
+        EXPECT_EQ (SAI_STATUS_SUCCESS,
+                   sai_l2_bulk_create_fdb_entry (fdb_bulk_count, entry_list.data (),
+                                                 attr_count_list.data (),
+                                                 attr_ptr_list.data (),
+                                                 SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                                 status_list.data ()));
+    }
+
+    for (base = 0; base < fdb_count; base += fdb_bulk_count) {
+        for (idx = 0; idx < fdb_bulk_count; idx++) {
+            fdb_entry_fill (base + idx, &entry_list [idx]);
+        }
+
+        EXPECT_EQ (SAI_STATUS_SUCCESS,
+                   sai_l2_bulk_remove_fdb_entry (fdb_bulk_count, entry_list.data (),
+                                                 SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                                 status_list.data ()));
+    }
+
+    return timer.elapsed_sec ();
+}
+
+/*
+ * Overhead of the API stats collection on the single and bulk FDB APIs.
+ * The best of a few alternating rounds is kept for each mode, to filter
+ * out the noise of the host.
+ */
+TEST_F (saiFdbBench, fdb_api_stats_overhead)
+{
+    const unsigned int rounds = 5;
+    bool               was_enabled = sai_api_stats_is_enabled ();
+    double             off_sec = 0;
+    double             on_sec = 0;
+    double             sec;
+    double             overhead;
+    unsigned int       round;
+
+    for (round = 0; round < rounds; round++) {
+        sai_api_stats_enable_set (false);
+        sec = fdb_churn_sec ();
+        off_sec = ((round == 0) || (sec < off_sec)) ? sec : off_sec;
+
+        sai_api_stats_enable_set (true);
+        sec = fdb_churn_sec ();
+        on_sec = ((round == 0) || (sec < on_sec)) ? sec : on_sec;
+    }
+
+    sai_api_stats_enable_set (was_enabled);
+
+    sai_bench_result_record ("fdb_api_stats", "stats_off", fdb_count,
+                             fdb_count * 4, off_sec);
+    sai_bench_result_record ("fdb_api_stats", "stats_on", fdb_count,
+                             fdb_count * 4, on_sec);
+
+    overhead = ((on_sec - off_sec) * 100.0) / off_sec;
+
+    printf ("API stats overhead on the FDB APIs: %.2f%%\r\n", overhead);
+
+    EXPECT_LT (overhead, SAI_BENCH_API_STATS_MAX_OVERHEAD);
+}
@@ -0,0 +1,659 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file  sai_hostif_bench.cpp
+*
+* @brief This file contains the packet RX/TX rate microbenchmarks of the
+*        host interface over the veth pairs backing the virtual ports.
+*
+* TX sends frames out of a port with send_hostif_packet. RX injects frames
+* into the veth peer of the port and counts the packet event callbacks.
+* The peer is found from the IFLA_LINK of the virtual port, or can be
+* given with SAI_BENCH_HOSTIF_PEER.
+*
+* The netdev cases bind a TAP backed host interface to the port, with 1, 2
+* and 4 queues, and count the frames of many flows crossing it either way.
+*
+*************************************************************************/
+
+#include "sai_bench_utils.h"
+
+extern "C" {
+#include "sai.h"
+#include "saihostif.h"
+#include "sai_port_utils.h"
+#include "sai_vm_vport.h"
+#include "sai_vm_rtnl.h"
+#include "sai_vm_hostif_tap.h"
+#include "std_socket_tools.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <linux/rtnetlink.h>
+}
+
+class saiHostifBench : public saiBenchTest
+{
+    public:
+        static void SetUpTestCase (void);
+
+        static int peer_if_index_get (void);
+        static void frame_fill (uint8_t *frame, uint32_t seq);
+        static double rx_wait (const saiBenchTimer &timer, uint64_t target,
+                               double idle_sec);
+        static void flow_frame_fill (uint8_t *frame, uint32_t seq);
+        static sai_object_id_t netdev_create (uint_t queue_count);
+        static int packet_sock_open (int if_index);
+        static void netdev_rx_run (uint_t queue_count);
+        static void netdev_tx_run (uint_t queue_count);
+
+        static sai_hostif_api_t *p_hostif_api;
+        static sai_port_api_t   *p_port_api;
+        static sai_object_id_t   port_id;
+        static vport_desc_t     *p_vport;
+
+        static const uint32_t    frame_len = 64;
+        static const uint32_t    frame_count = 100000;
+        static const uint_t      tx_thread_count = 4;
+};
+
+#define SAI_BENCH_NETDEV_NAME  "saibench0"
+
+sai_hostif_api_t *saiHostifBench ::p_hostif_api = NULL;
+sai_port_api_t   *saiHostifBench ::p_port_api = NULL;
+sai_object_id_t   saiHostifBench ::port_id = 0;
+vport_desc_t     *saiHostifBench ::p_vport = NULL;
+
+void saiHostifBench ::SetUpTestCase (void)
+{
+    sai_attribute_t   attr;
+    sai_port_info_t  *p_port_info = NULL;
+
+    saiBenchTest ::SetUpTestCase ();
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_api_query
+               (SAI_API_HOSTIF, (static_cast<void**>
+                                 (static_cast<void*>(&p_hostif_api)))));
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_api_query
+               (SAI_API_PORT, (static_cast<void**>
+                               (static_cast<void*>(&p_port_api)))));
+
+    port_id = sai_bench_port_id_get (0);
+
+    p_port_info = sai_port_info_get (port_id);
+    ASSERT_TRUE (p_port_info != NULL);
+
+    p_vport = sai_vm_vport_get_desc (p_port_info->phy_port_id);
+
+    memset (&attr, 0, sizeof (attr));
+    attr.id = SAI_PORT_ATTR_ADMIN_STATE;
+    attr.value.booldata = true;
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS,
+               p_port_api->set_port_attribute (port_id, &attr));
+}
+
+typedef struct _sai_bench_link_ctx_t {
+    int if_index;
+    int link_if_index;
+} sai_bench_link_ctx_t;
+
+static void sai_bench_link_cb (struct nlmsghdr *hdr, void *ctx)
+{
+    sai_bench_link_ctx_t *p_ctx = (sai_bench_link_ctx_t *) ctx;
+    struct ifinfomsg     *ifi = (struct ifinfomsg *) NLMSG_DATA (hdr);
+    struct rtattr        *tb [IFLA_MAX + 1];
+
+    if ((hdr->nlmsg_type != RTM_NEWLINK) || (ifi->ifi_index != p_ctx->if_index)) {
+        return;
+    }
+
+    sai_vm_rtnl_attr_parse (tb, IFLA_MAX, IFLA_RTA (ifi),
+                            hdr->nlmsg_len - NLMSG_LENGTH (sizeof (*ifi)));
+
+    if (tb [IFLA_LINK] != NULL) {
+        p_ctx->link_if_index = *(int *) RTA_DATA (tb [IFLA_LINK]);
+    }
+}
+
+/* Interface index, in the current namespace, of the veth peer of the port */
+int saiHostifBench ::peer_if_index_get (void)
+{
+    const char          *peer_name = getenv (SAI_BENCH_HOSTIF_PEER_ENV);
+    sai_bench_link_ctx_t ctx;
+    int                  sock;
+    struct {
+        struct nlmsghdr  hdr;
+        struct ifinfomsg ifi;
+    } req;
+
+    if ((peer_name != NULL) && (*peer_name != '\0')) {
+        return (int) if_nametoindex (peer_name);
+    }
+
+    if (p_vport == NULL) {
+        return 0;
+    }
+
+    sock = sai_vm_rtnl_open (0);
+
+    if (sock == STD_INVALID_FD) {
+        return 0;
+    }
+
+    memset (&req, 0, sizeof (req));
+    req.hdr.nlmsg_len = NLMSG_LENGTH (sizeof (req.ifi));
+    req.hdr.nlmsg_type = RTM_GETLINK;
+    req.ifi.ifi_family = AF_UNSPEC;
+
+    ctx.if_index = p_vport->if_index;
+    ctx.link_if_index = 0;
+
+    sai_vm_rtnl_dump (sock, &req.hdr, sai_bench_link_cb, &ctx);
+    sai_vm_rtnl_close (sock);
+
+    /* The veth peer lives outside the virtual port namespace */
+    return ctx.link_if_index;
+}
+
+void saiHostifBench ::frame_fill (uint8_t *frame, uint32_t seq)
+{
+    static const uint8_t hdr [] = {
+        0x02, 0xbe, 0x00, 0x00, 0x00, 0x01, /* DA */
+        0x02, 0xbe, 0x00, 0x00, 0x00, 0x02, /* SA */
+        0x88, 0xb5                          /* Local experimental ethertype */
+    };
+
+    memset (frame, 0, frame_len);
+    memcpy (frame, hdr, sizeof (hdr));
+    memcpy (frame + sizeof (hdr), &seq, sizeof (seq));
+}
+
+/*
+ * Wait until target packets were delivered or none arrived for idle_sec,
+ * return the time of the last delivery on the timer.
+ */
+double saiHostifBench ::rx_wait (const saiBenchTimer &timer, uint64_t target,
+                                 double idle_sec)
+{
+    uint64_t count = sai_bench_rx_packet_count_get ();
+    uint64_t last_count = count;
+    double   last_sec = timer.elapsed_sec ();
+
+    while (count < target) {
+        usleep (100);
+
+        count = sai_bench_rx_packet_count_get ();
+
+        if (count != last_count) {
+            last_count = count;
+            last_sec = timer.elapsed_sec ();
+        } else if ((timer.elapsed_sec () - last_sec) > idle_sec) {
+            break;
+        }
+    }
+
+    return last_sec;
+}
+
+/*
+ * TX rate of send_hostif_packet, pipeline bypass out of one port.
+ */
+TEST_F (saiHostifBench, hostif_tx)
+{
+    sai_attribute_t attr_list [2];
+    uint8_t         frame [frame_len];
+    saiBenchTimer   timer;
+    uint32_t        idx;
+    uint32_t        sent = 0;
+
+    memset (attr_list, 0, sizeof (attr_list));
+
+    attr_list [0].id = SAI_HOSTIF_PACKET_ATTR_EGRESS_PORT_OR_LAG;
+    attr_list [0].value.oid = port_id;
+    attr_list [1].id = SAI_HOSTIF_PACKET_ATTR_HOSTIF_TX_TYPE;
+    attr_list [1].value.s32 = SAI_HOSTIF_TX_TYPE_PIPELINE_BYPASS;
+
+    timer.start ();
+
+    for (idx = 0; idx < frame_count; idx++) {
+        frame_fill (frame, idx);
+
+        if (p_hostif_api->send_hostif_packet (SAI_NULL_OBJECT_ID, frame,
+                                              frame_len, 2, attr_list)
+            == SAI_STATUS_SUCCESS) {
+            sent++;
+        }
+    }
+
+    sai_bench_result_record ("hostif", "tx_pipeline_bypass", frame_len, sent,
+                             timer.elapsed_sec ());
+
+    EXPECT_EQ ((uint32_t) frame_count, sent);
+}
+
+/*
+ * RX rate from the veth peer of a port up to the packet event callback.
+ */
+TEST_F (saiHostifBench, hostif_rx)
+{
+    struct sockaddr_ll addr;
+    uint8_t            frame [frame_len];
+    saiBenchTimer      timer;
+    uint64_t           base;
+    uint64_t           received;
+    double             sec;
+    uint32_t           idx;
+    int                peer_if_index = peer_if_index_get ();
+    int                sock = -1;
+
+    if (peer_if_index <= 0) {
+        printf ("Veth peer of the port not found, set %s to run the RX "
+                "benchmark.\r\n", SAI_BENCH_HOSTIF_PEER_ENV);
+        return;
+    }
+
+    sock = socket (AF_PACKET, SOCK_RAW, htons (ETH_P_ALL));
+    ASSERT_TRUE (sock >= 0);
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons (ETH_P_ALL);
+    addr.sll_ifindex = peer_if_index;
+    addr.sll_halen = ETH_ALEN;
+
+    /* Let the packets of the previous cases drain */
+    usleep (200000);
+
+    base = sai_bench_rx_packet_count_get ();
+
+    timer.start ();
+
+    for (idx = 0; idx < frame_count; idx++) {
+        frame_fill (frame, idx);
+
+        while (sendto (sock, frame, frame_len, 0, (struct sockaddr *) &addr,
+                       sizeof (addr)) < 0) {
+            /* Back off when the peer TX queue is full */
+            if ((errno != ENOBUFS) && (errno != EAGAIN)) {
+                ADD_FAILURE () << "sendto failed errno " << errno;
+                close (sock);
+                return;
+            }
+
+            usleep (10);
+        }
+    }
+
+    sec = rx_wait (timer, base + frame_count, 0.5);
+
+    received = sai_bench_rx_packet_count_get () - base;
+
+    sai_bench_result_record ("hostif", "rx", frame_len, received, sec);
+
+    printf ("Hostif RX: %llu of %u frames delivered.\r\n",
+            (unsigned long long) received, frame_count);
+
+    close (sock);
+}
+
+/* IPv4 UDP frame of flow seq, so that the flows spread over the TAP queues */
+void saiHostifBench ::flow_frame_fill (uint8_t *frame, uint32_t seq)
+{
+    static const uint8_t hdr [] = {
+        0x02, 0xbe, 0x00, 0x00, 0x00, 0x01, /* DA */
+        0x02, 0xbe, 0x00, 0x00, 0x00, 0x02, /* SA */
+        0x08, 0x00,                         /* IPv4 */
+        0x45, 0x00, 0x00, 0x32, 0x00, 0x00, 0x00, 0x00,
+        0x40, 0x11, 0x00, 0x00,             /* TTL, UDP, no checksum */
+        0x0a, 0x00, 0x00, 0x00,             /* SIP */
+        0x0a, 0x01, 0x00, 0x01              /* DIP */
+    };
+    uint16_t sport = htons ((uint16_t) (seq & 0xffff));
+    uint16_t dport = htons (9);
+
+    memset (frame, 0, frame_len);
+    memcpy (frame, hdr, sizeof (hdr));
+    frame [29] = (uint8_t) (seq >> 16);
+    memcpy (frame + 34, &sport, sizeof (sport));
+    memcpy (frame + 36, &dport, sizeof (dport));
+}
+
+/* Netdev hostif on the port, with its TAP up */
+sai_object_id_t saiHostifBench ::netdev_create (uint_t queue_count)
+{
+    sai_attribute_t attr_list [3];
+    sai_object_id_t hostif_id = SAI_NULL_OBJECT_ID;
+    struct ifreq    ifr;
+    char            queues [16];
+    int             sock;
+
+    snprintf (queues, sizeof (queues), "%u", queue_count);
+    setenv (SAI_VM_HOSTIF_TAP_QUEUES_ENV, queues, 1);
+
+    memset (attr_list, 0, sizeof (attr_list));
+
+    attr_list [0].id = SAI_HOSTIF_ATTR_TYPE;
+    attr_list [0].value.s32 = SAI_HOSTIF_TYPE_NETDEV;
+    attr_list [1].id = SAI_HOSTIF_ATTR_OBJ_ID;
+    attr_list [1].value.oid = port_id;
+    attr_list [2].id = SAI_HOSTIF_ATTR_NAME;
+    strncpy (attr_list [2].value.chardata, SAI_BENCH_NETDEV_NAME,
+             SAI_HOSTIF_NAME_SIZE - 1);
+
+    if (p_hostif_api->create_hostif (&hostif_id, switch_id, 3,
+                                     attr_list) != SAI_STATUS_SUCCESS) {
+        unsetenv (SAI_VM_HOSTIF_TAP_QUEUES_ENV);
+        return SAI_NULL_OBJECT_ID;
+    }
+
+    unsetenv (SAI_VM_HOSTIF_TAP_QUEUES_ENV);
+
+    memset (attr_list, 0, sizeof (attr_list));
+    attr_list [0].id = SAI_HOSTIF_ATTR_OPER_STATUS;
+    attr_list [0].value.booldata = true;
+    p_hostif_api->set_hostif_attribute (hostif_id, &attr_list [0]);
+
+    sock = socket (AF_INET, SOCK_DGRAM, 0);
+
+    if (sock >= 0) {
+        memset (&ifr, 0, sizeof (ifr));
+        strncpy (ifr.ifr_name, SAI_BENCH_NETDEV_NAME, sizeof (ifr.ifr_name) - 1);
+
+        if (ioctl (sock, SIOCGIFFLAGS, &ifr) == 0) {
+            ifr.ifr_flags |= IFF_UP;
+            ioctl (sock, SIOCSIFFLAGS, &ifr);
+        }
+
+        close (sock);
+    }
+
+    return hostif_id;
+}
+
+int saiHostifBench ::packet_sock_open (int if_index)
+{
+    struct sockaddr_ll addr;
+    struct timeval     tv = { 0, 100000 };
+    int                sock;
+
+    sock = socket (AF_PACKET, SOCK_RAW, htons (ETH_P_IP));
+
+    if (sock < 0) {
+        return -1;
+    }
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons (ETH_P_IP);
+    addr.sll_ifindex = if_index;
+
+    if (bind (sock, (struct sockaddr *) &addr, sizeof (addr)) != 0) {
+        close (sock);
+        return -1;
+    }
+
+    setsockopt (sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof (tv));
+
+    return sock;
+}
+
+typedef struct _sai_bench_counter_t {
+    int               sock;
+    volatile bool     stop;
+    volatile uint64_t count;
+    saiBenchTimer    *p_timer;
+    double            last_sec;
+} sai_bench_counter_t;
+
+/* Counts the frames of the benchmark flows received on a socket */
+static void *sai_bench_counter_thread (void *param)
+{
+    sai_bench_counter_t *p_counter = (sai_bench_counter_t *) param;
+    uint8_t              buf [2048];
+    ssize_t              len;
+
+    while (!p_counter->stop) {
+        len = recv (p_counter->sock, buf, sizeof (buf), 0);
+
+        if ((len >= 34) && (buf [30] == 0x0a) && (buf [31] == 0x01)) {
+            p_counter->count++;
+            p_counter->last_sec = p_counter->p_timer->elapsed_sec ();
+        }
+    }
+
+    return NULL;
+}
+
+/* Wait until target frames were counted or none arrived for idle_sec */
+static void sai_bench_counter_wait (sai_bench_counter_t *p_counter, uint64_t target,
+                                    double idle_sec)
+{
+    uint64_t last_count = p_counter->count;
+    double   last_sec = p_counter->p_timer->elapsed_sec ();
+
+    while (p_counter->count < target) {
+        usleep (1000);
+
+        if (p_counter->count != last_count) {
+            last_count = p_counter->count;
+            last_sec = p_counter->p_timer->elapsed_sec ();
+        } else if ((p_counter->p_timer->elapsed_sec () - last_sec) > idle_sec) {
+            break;
+        }
+    }
+}
+
+/*
+ * RX rate of many flows from the veth peer of a port into the TAP of its
+ * netdev hostif.
+ */
+void saiHostifBench ::netdev_rx_run (uint_t queue_count)
+{
+    sai_bench_counter_t counter;
+    struct sockaddr_ll  addr;
+    sai_object_id_t     hostif_id;
+    pthread_t           thread;
+    uint8_t             frame [frame_len];
+    saiBenchTimer       timer;
+    char                op [32];
+    uint32_t            idx;
+    int                 peer_if_index = peer_if_index_get ();
+    int                 sock;
+
+    if (peer_if_index <= 0) {
+        printf ("Veth peer of the port not found, set %s to run the netdev RX "
+                "benchmark.\r\n", SAI_BENCH_HOSTIF_PEER_ENV);
+        return;
+    }
+
+    hostif_id = netdev_create (queue_count);
+    ASSERT_NE (SAI_NULL_OBJECT_ID, hostif_id);
+
+    memset (&counter, 0, sizeof (counter));
+    counter.p_timer = &timer;
+    counter.sock = packet_sock_open ((int) if_nametoindex (SAI_BENCH_NETDEV_NAME));
+    ASSERT_TRUE (counter.sock >= 0);
+
+    sock = socket (AF_PACKET, SOCK_RAW, htons (ETH_P_ALL));
+    ASSERT_TRUE (sock >= 0);
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons (ETH_P_ALL);
+    addr.sll_ifindex = peer_if_index;
+    addr.sll_halen = ETH_ALEN;
+
+    timer.start ();
+    ASSERT_EQ (0, pthread_create (&thread, NULL, sai_bench_counter_thread, &counter));
+
+    for (idx = 0; idx < frame_count; idx++) {
+        flow_frame_fill (frame, idx);
+
+        while (sendto (sock, frame, frame_len, 0, (struct sockaddr *) &addr,
+                       sizeof (addr)) < 0) {
+            if ((errno != ENOBUFS) && (errno != EAGAIN)) {
+                break;
+            }
+
+            usleep (10);
+        }
+    }
+
+    sai_bench_counter_wait (&counter, frame_count, 0.5);
+
+    counter.stop = true;
+    pthread_join (thread, NULL);
+
+    snprintf (op, sizeof (op), "netdev_rx_q%u", queue_count);
+    sai_bench_result_record ("hostif", op, frame_len, counter.count, counter.last_sec);
+
+    printf ("Netdev RX %u queues: %llu of %u frames delivered.\r\n", queue_count,
+            (unsigned long long) counter.count, frame_count);
+
+    close (sock);
+    close (counter.sock);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, p_hostif_api->remove_hostif (hostif_id));
+}
+
+typedef struct _sai_bench_sender_t {
+    int      if_index;
+    uint32_t first;
+    uint32_t count;
+} sai_bench_sender_t;
+
+static void *sai_bench_sender_thread (void *param)
+{
+    sai_bench_sender_t *p_sender = (sai_bench_sender_t *) param;
+    struct sockaddr_ll  addr;
+    uint8_t             frame [saiHostifBench ::frame_len];
+    uint32_t            idx;
+    int                 sock;
+
+    sock = socket (AF_PACKET, SOCK_RAW, htons (ETH_P_ALL));
+
+    if (sock < 0) {
+        return NULL;
+    }
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons (ETH_P_ALL);
+    addr.sll_ifindex = p_sender->if_index;
+    addr.sll_halen = ETH_ALEN;
+
+    for (idx = p_sender->first; idx < (p_sender->first + p_sender->count); idx++) {
+        saiHostifBench ::flow_frame_fill (frame, idx);
+
+        while (sendto (sock, frame, saiHostifBench ::frame_len, 0,
+                       (struct sockaddr *) &addr, sizeof (addr)) < 0) {
+            if ((errno != ENOBUFS) && (errno != EAGAIN)) {
+                break;
+            }
+
+            usleep (10);
+        }
+    }
+
+    close (sock);
+
+    return NULL;
+}
+
+/*
+ * TX rate of many flows written to the TAP of a netdev hostif, from several
+ * threads, up to the veth peer of its port.
+ */
+void saiHostifBench ::netdev_tx_run (uint_t queue_count)
+{
+    sai_bench_counter_t counter;
+    sai_bench_sender_t  senders [tx_thread_count];
+    sai_object_id_t     hostif_id;
+    pthread_t           counter_thread;
+    pthread_t           threads [tx_thread_count];
+    saiBenchTimer       timer;
+    char                op [32];
+    uint_t              idx;
+    int                 peer_if_index = peer_if_index_get ();
+
+    if (peer_if_index <= 0) {
+        printf ("Veth peer of the port not found, set %s to run the netdev TX "
+                "benchmark.\r\n", SAI_BENCH_HOSTIF_PEER_ENV);
+        return;
+    }
+
+    hostif_id = netdev_create (queue_count);
+    ASSERT_NE (SAI_NULL_OBJECT_ID, hostif_id);
+
+    memset (&counter, 0, sizeof (counter));
+    counter.p_timer = &timer;
+    counter.sock = packet_sock_open (peer_if_index);
+    ASSERT_TRUE (counter.sock >= 0);
+
+    timer.start ();
+    ASSERT_EQ (0, pthread_create (&counter_thread, NULL, sai_bench_counter_thread,
+                                  &counter));
+
+    for (idx = 0; idx < tx_thread_count; idx++) {
+        senders [idx].if_index = (int) if_nametoindex (SAI_BENCH_NETDEV_NAME);
+        senders [idx].first = idx * (frame_count / tx_thread_count);
+        senders [idx].count = frame_count / tx_thread_count;
+        pthread_create (&threads [idx], NULL, sai_bench_sender_thread, &senders [idx]);
+    }
+
+    for (idx = 0; idx < tx_thread_count; idx++) {
+        pthread_join (threads [idx], NULL);
+    }
+
+    sai_bench_counter_wait (&counter, frame_count, 0.5);
+
+    counter.stop = true;
+    pthread_join (counter_thread, NULL);
+
+    snprintf (op, sizeof (op), "netdev_tx_q%u", queue_count);
+    sai_bench_result_record ("hostif", op, frame_len, counter.count, counter.last_sec);
+
+    printf ("Netdev TX %u queues: %llu of %u frames delivered.\r\n", queue_count,
+            (unsigned long long) counter.count, frame_count);
+
+    close (counter.sock);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, p_hostif_api->remove_hostif (hostif_id));
+}
+
+TEST_F (saiHostifBench, netdev_rx)
+{
+    netdev_rx_run (1);
+    netdev_rx_run (2);
+    netdev_rx_run (4);
+}
+
+TEST_F (saiHostifBench, netdev_tx)
+{
+    netdev_tx_run (1);
+    netdev_tx_run (2);
+    netdev_tx_run (4);
+}
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file  sai_qos_bench.cpp
+*
+* @brief This file contains the per packet cost microbenchmarks of the
+*        software QoS classification and remarking of the virtual ports.
+*
+* Frames of all the DSCP values are classified, and remarked when the
+* classification asks for it, on the first port. The maps are created and
+* bound through the SAI QoS map and port APIs. The cases run with no map,
+* with ingress maps and with ingress and egress remarking maps bound.
+*
+* The port init case tears down the QoS state of a number of ports and
+* times rebuilding it at switch init, serially and deferred to the builder
+* thread, checking that both give the ports the same queue ids.
+*
+*************************************************************************/
+
+#include "sai_bench_utils.h"
+
+extern "C" {
+#include "sai.h"
+#include "saiqosmap.h"
+#include "sai_port_utils.h"
+#include "sai_vm_vport.h"
+#include "sai_qos_util.h"
+#include "sai_qos_api_utils.h"
+#include "sai_vm_qos.h"
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+}
+
+class saiQosBench : public saiBenchTest
+{
+    public:
+        static void SetUpTestCase (void);
+        static void TearDownTestCase (void);
+
+        static sai_object_id_t map_create (sai_qos_map_type_t map_type);
+        static void map_bind (sai_attr_id_t attr_id, sai_object_id_t map_id);
+        static void frame_fill (uint8_t *frame, uint8_t dscp);
+        static void classify_run (const char *op, uint_t expected_remarks);
+
+        static sai_qos_map_api_t *p_qos_map_api;
+        static sai_port_api_t    *p_port_api;
+        static sai_object_id_t    port_id;
+        static vport_desc_t      *p_vport;
+        static sai_object_id_t    dscp_to_tc_map_id;
+        static sai_object_id_t    tc_to_queue_map_id;
+        static sai_object_id_t    tc_color_to_dscp_map_id;
+
+        static const uint32_t     frame_len = 64;
+        static const uint32_t     frame_count = 1000000;
+};
+
+sai_qos_map_api_t *saiQosBench ::p_qos_map_api = NULL;
+sai_port_api_t    *saiQosBench ::p_port_api = NULL;
+sai_object_id_t    saiQosBench ::port_id = 0;
+vport_desc_t      *saiQosBench ::p_vport = NULL;
+sai_object_id_t    saiQosBench ::dscp_to_tc_map_id = SAI_NULL_OBJECT_ID;
+sai_object_id_t    saiQosBench ::tc_to_queue_map_id = SAI_NULL_OBJECT_ID;
+sai_object_id_t    saiQosBench ::tc_color_to_dscp_map_id = SAI_NULL_OBJECT_ID;
+
+void saiQosBench ::SetUpTestCase (void)
+{
+    sai_port_info_t  *p_port_info = NULL;
+
+    saiBenchTest ::SetUpTestCase ();
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_api_query
+               (SAI_API_QOS_MAP, (static_cast<void**>
+                                  (static_cast<void*>(&p_qos_map_api)))));
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_api_query
+               (SAI_API_PORT, (static_cast<void**>
+                               (static_cast<void*>(&p_port_api)))));
+
+    port_id = sai_bench_port_id_get (0);
+
+    p_port_info = sai_port_info_get (port_id);
+    ASSERT_TRUE (p_port_info != NULL);
+
+    p_vport = sai_vm_vport_get_desc (p_port_info->phy_port_id);
+    ASSERT_TRUE (p_vport != NULL);
+}
+
+void saiQosBench ::TearDownTestCase (void)
+{
+    map_bind (SAI_PORT_ATTR_QOS_TC_AND_COLOR_TO_DSCP_MAP, SAI_NULL_OBJECT_ID);
+    map_bind (SAI_PORT_ATTR_QOS_TC_TO_QUEUE_MAP, SAI_NULL_OBJECT_ID);
+    map_bind (SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP, SAI_NULL_OBJECT_ID);
+
+    if (tc_color_to_dscp_map_id != SAI_NULL_OBJECT_ID) {
+        p_qos_map_api->remove_qos_map (tc_color_to_dscp_map_id);
+    }
+    if (tc_to_queue_map_id != SAI_NULL_OBJECT_ID) {
+        p_qos_map_api->remove_qos_map (tc_to_queue_map_id);
+    }
+    if (dscp_to_tc_map_id != SAI_NULL_OBJECT_ID) {
+        p_qos_map_api->remove_qos_map (dscp_to_tc_map_id);
+    }
+}
+
+/*
+ * DSCP x goes to TC x/8, TC x to queue x, and TC x of any color is remarked
+ * to DSCP 8*x, so that 7 DSCP values in 8 get rewritten.
+ */
+sai_object_id_t saiQosBench ::map_create (sai_qos_map_type_t map_type)
+{
+    sai_qos_map_t   entries [SAI_VM_VPORT_QOS_DSCP_MAX];
+    sai_attribute_t attr_list [2];
+    sai_object_id_t map_id = SAI_NULL_OBJECT_ID;
+    uint_t          count = 0;
+    uint_t          idx;
+
+    memset (entries, 0, sizeof (entries));
+
+    if (map_type == SAI_QOS_MAP_TYPE_DSCP_TO_TC) {
+        for (idx = 0; idx < SAI_VM_VPORT_QOS_DSCP_MAX; idx++, count++) {
+            entries [count].key.dscp = idx;
+            entries [count].value.tc = idx / 8;
+        }
+    } else if (map_type == SAI_QOS_MAP_TYPE_TC_TO_QUEUE) {
+        for (idx = 0; idx < 8; idx++, count++) {
+            entries [count].key.tc = idx;
+            entries [count].value.queue_index = idx;
+        }
+    } else {
+        for (idx = 0; idx < 8 * SAI_VM_VPORT_QOS_COLOR_MAX; idx++, count++) {
+            entries [count].key.tc = idx / SAI_VM_VPORT_QOS_COLOR_MAX;
+            entries [count].key.color =
+                (sai_packet_color_t) (idx % SAI_VM_VPORT_QOS_COLOR_MAX);
+            entries [count].value.dscp = 8 * entries [count].key.tc;
+        }
+    }
+
+    memset (attr_list, 0, sizeof (attr_list));
+    attr_list [0].id = SAI_QOS_MAP_ATTR_TYPE;
+    attr_list [0].value.s32 = map_type;
+    attr_list [1].id = SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST;
+    attr_list [1].value.qosmap.count = count;
+    attr_list [1].value.qosmap.list = entries;
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS,
+               p_qos_map_api->create_qos_map (&map_id, switch_id, 2, attr_list));
+
+    return map_id;
+}
+
+void saiQosBench ::map_bind (sai_attr_id_t attr_id, sai_object_id_t map_id)
+{
+    sai_attribute_t attr;
+
+    memset (&attr, 0, sizeof (attr));
+    attr.id = attr_id;
+    attr.value.oid = map_id;
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS,
+               p_port_api->set_port_attribute (port_id, &attr));
+}
+
+void saiQosBench ::frame_fill (uint8_t *frame, uint8_t dscp)
+{
+    static const uint8_t hdr [] = {
+        0x02, 0xbe, 0x00, 0x00, 0x00, 0x01, /* DA */
+        0x02, 0xbe, 0x00, 0x00, 0x00, 0x02, /* SA */
+        0x08, 0x00,                         /* IPv4 */
+        0x45, 0x00, 0x00, 0x32, 0x00, 0x00, 0x00, 0x00,
+        0x40, 0x11, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x01,
+        0x0a, 0x00, 0x00, 0x02
+    };
+
+    memset (frame, 0, frame_len);
+    memcpy (frame, hdr, sizeof (hdr));
+    frame [15] = (uint8_t) (dscp << 2);
+}
+
+/*
+ * Classify and remark frame_count frames, cycling through the DSCP values.
+ */
+void saiQosBench ::classify_run (const char *op, uint_t expected_remarks)
+{
+    uint8_t                  frames [SAI_VM_VPORT_QOS_DSCP_MAX][frame_len];
+    uint8_t                  frame [frame_len];
+    sai_vm_vport_qos_class_t qos_class;
+    saiBenchTimer            timer;
+    uint64_t                 remarked = 0;
+    uint32_t                 idx;
+
+    for (idx = 0; idx < SAI_VM_VPORT_QOS_DSCP_MAX; idx++) {
+        frame_fill (frames [idx], (uint8_t) idx);
+    }
+
+    timer.start ();
+
+    for (idx = 0; idx < frame_count; idx++) {
+        memcpy (frame, frames [idx % SAI_VM_VPORT_QOS_DSCP_MAX], frame_len);
+
+        sai_vm_vport_qos_classify (p_vport, frame, frame_len, NULL, &qos_class);
+
+        if (sai_vm_vport_qos_remark (frame, frame_len, &qos_class)) {
+            remarked++;
+        }
+    }
+
+    sai_bench_result_record ("qos", op, frame_len, frame_count,
+                             timer.elapsed_sec ());
+
+    EXPECT_EQ (((uint64_t) frame_count / SAI_VM_VPORT_QOS_DSCP_MAX) *
+               expected_remarks, remarked);
+}
+
+/*
+ * Frame parsing and default TC, with no map bound.
+ */
+TEST_F (saiQosBench, classify_unmapped)
+{
+    classify_run ("classify_unmapped", 0);
+}
+
+/*
+ * DSCP to TC and TC to queue lookups.
+ */
+TEST_F (saiQosBench, classify_ingress_maps)
+{
+    dscp_to_tc_map_id = map_create (SAI_QOS_MAP_TYPE_DSCP_TO_TC);
+    tc_to_queue_map_id = map_create (SAI_QOS_MAP_TYPE_TC_TO_QUEUE);
+
+    map_bind (SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP, dscp_to_tc_map_id);
+    map_bind (SAI_PORT_ATTR_QOS_TC_TO_QUEUE_MAP, tc_to_queue_map_id);
+
+    classify_run ("classify_ingress_maps", 0);
+}
+
+/*
+ * Ingress lookups plus the DSCP rewrite and IPv4 checksum update.
+ */
+TEST_F (saiQosBench, classify_dscp_remark)
+{
+    tc_color_to_dscp_map_id = map_create (SAI_QOS_MAP_TYPE_TC_AND_COLOR_TO_DSCP);
+
+    map_bind (SAI_PORT_ATTR_QOS_TC_AND_COLOR_TO_DSCP_MAP, tc_color_to_dscp_map_id);
+
+    classify_run ("classify_dscp_remark", SAI_VM_VPORT_QOS_DSCP_MAX / 8 * 7);
+}
+
+class saiQosPortInitBench : public saiBenchTest
+{
+    public:
+        static double port_all_init_run (bool defer, double *p_ready_sec);
+        static void queue_ids_get (uint_t count, std::vector<sai_object_id_t> &ids);
+};
+
+/*
+ * Rebuild the ports torn down, as sai_qos_init does. Returns the time until
+ * the QoS state of all the ports is built, the time sai_qos_port_all_init
+ * took in p_ready_sec.
+ */
+double saiQosPortInitBench ::port_all_init_run (bool defer, double *p_ready_sec)
+{
+    saiBenchTimer timer;
+    sai_status_t  sai_rc;
+
+    setenv (SAI_QOS_PORT_INIT_DEFER_ENV, defer ? "1" : "0", 1);
+
+    timer.start ();
+
+    sai_qos_lock ();
+    sai_rc = sai_qos_port_all_init ();
+    sai_qos_unlock ();
+
+    *p_ready_sec = timer.elapsed_sec ();
+
+    sai_qos_port_all_init_wait ();
+
+    unsetenv (SAI_QOS_PORT_INIT_DEFER_ENV);
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_rc);
+
+    return timer.elapsed_sec ();
+}
+
+void saiQosPortInitBench ::queue_ids_get (uint_t count,
+                                          std::vector<sai_object_id_t> &ids)
+{
+    sai_object_id_t   queues [SAI_VM_QOS_MAX_SUPPORTED_QUEUES];
+    sai_object_list_t queue_list;
+    uint_t            idx;
+
+    ids.clear ();
+
+    for (idx = 0; idx < count; idx++) {
+        queue_list.count = SAI_VM_QOS_MAX_SUPPORTED_QUEUES;
+        queue_list.list = queues;
+
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   sai_qos_port_queue_id_list_get (port_list [idx], &queue_list));
+
+        ids.insert (ids.end (), queues, queues + queue_list.count);
+    }
+}
+
+/*
+ * Switch init time of the port QoS state at growing port counts, serial
+ * against deferred. The port counts can be overridden with
+ * SAI_BENCH_QOS_PORT_SCALES=n1,n2,...
+ */
+TEST_F (saiQosPortInitBench, port_all_init)
+{
+    std::vector<uint64_t>        dflt_scales = {1, 8, 32, 128};
+    std::vector<uint64_t>        scales =
+        sai_bench_scales_get (SAI_BENCH_QOS_PORT_SCALES_ENV, dflt_scales);
+    std::vector<sai_object_id_t> serial_ids;
+    std::vector<sai_object_id_t> deferred_ids;
+    double                       ready_sec;
+    double                       complete_sec;
+    uint_t                       count;
+    uint_t                       idx;
+
+    for (uint64_t scale : scales) {
+        count = (scale < port_count) ? (uint_t) scale : port_count;
+
+        for (int defer = 0; defer < 2; defer++) {
+            for (idx = 0; idx < count; idx++) {
+                ASSERT_EQ (SAI_STATUS_SUCCESS, sai_qos_port_deinit (port_list [idx]));
+            }
+
+            complete_sec = port_all_init_run (defer != 0, &ready_sec);
+
+            sai_bench_result_record ("qos_port_init",
+                                     defer ? "deferred_ready" : "serial_ready",
+                                     count, count, ready_sec);
+            sai_bench_result_record ("qos_port_init",
+                                     defer ? "deferred_complete" : "serial_complete",
+                                     count, count, complete_sec);
+
+            queue_ids_get (count, defer ? deferred_ids : serial_ids);
+        }
+
+        EXPECT_FALSE (serial_ids.empty ());
+        EXPECT_TRUE (serial_ids == deferred_ids);
+    }
+}
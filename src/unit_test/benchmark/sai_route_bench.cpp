@@ -0,0 +1,727 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file  sai_route_bench.cpp
+*
+* @brief This file contains the microbenchmarks of the SAI route,
+*        next hop and next hop group member APIs.
+*
+*************************************************************************/
+
+#include "sai_bench_utils.h"
+
+extern "C" {
+#include "sai.h"
+#include "saivirtualrouter.h"
+#include "sairouterinterface.h"
+#include "sainexthop.h"
+#include "sainexthopgroup.h"
+#include "sairoute.h"
+#include "sai_gen_utils.h"
+#include "sai_log_async.h"
+#include <arpa/inet.h>
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <pthread.h>
+}
+
+#include <vector>
+
+class saiRouteBench : public saiBenchTest
+{
+    public:
+        static void SetUpTestCase (void);
+        static void TearDownTestCase (void);
+
+        static sai_status_t nexthop_create (uint32_t ip4_host_order,
+                                            sai_object_id_t rif_id,
+                                            sai_object_id_t *p_nh_id);
+        static sai_status_t group_member_add (sai_object_id_t group_id,
+                                              sai_object_id_t nh_id,
+                                              sai_object_id_t *p_member_id);
+        static void route_entry_fill (uint64_t index, sai_route_entry_t *p_route);
+        static void *route_get_thread (void *arg);
+        static void *route_churn_thread (void *arg);
+
+        static sai_virtual_router_api_t   *p_vrf_api;
+        static sai_router_interface_api_t *p_rif_api;
+        static sai_next_hop_api_t         *p_nh_api;
+        static sai_next_hop_group_api_t   *p_nh_grp_api;
+        static sai_route_api_t            *p_route_api;
+
+        static sai_object_id_t vr_id;
+        static sai_object_id_t rif_id;
+        static sai_object_id_t nh_id;
+
+        /* Next hop addresses of the benchmark, on the RIF subnet */
+        static const uint32_t  nh_base_ip = 0x0a000001; /* 10.0.0.1 */
+        /* Benchmark routes are consecutive /24s from this prefix */
+        static const uint32_t  route_base_ip = 0x14000000; /* 20.0.0.0 */
+};
+
+sai_virtual_router_api_t   *saiRouteBench ::p_vrf_api = NULL;
+sai_router_interface_api_t *saiRouteBench ::p_rif_api = NULL;
+sai_next_hop_api_t         *saiRouteBench ::p_nh_api = NULL;
+sai_next_hop_group_api_t   *saiRouteBench ::p_nh_grp_api = NULL;
+sai_route_api_t            *saiRouteBench ::p_route_api = NULL;
+
+sai_object_id_t saiRouteBench ::vr_id = 0;
+sai_object_id_t saiRouteBench ::rif_id = 0;
+sai_object_id_t saiRouteBench ::nh_id = 0;
+
+void saiRouteBench ::SetUpTestCase (void)
+{
+    sai_attribute_t attr_list [3];
+    const sai_mac_t router_mac = {0x00, 0x00, 0x00, 0xaa, 0xbb, 0xcc};
+
+    saiBenchTest ::SetUpTestCase ();
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_api_query
+               (SAI_API_VIRTUAL_ROUTER, (static_cast<void**>
+                                         (static_cast<void*>(&p_vrf_api)))));
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_api_query
+               (SAI_API_ROUTER_INTERFACE, (static_cast<void**>
+                                           (static_cast<void*>(&p_rif_api)))));
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_api_query
+               (SAI_API_NEXT_HOP, (static_cast<void**>
+                                   (static_cast<void*>(&p_nh_api)))));
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_api_query
+               (SAI_API_NEXT_HOP_GROUP, (static_cast<void**>
+                                         (static_cast<void*>(&p_nh_grp_api)))));
+    ASSERT_EQ (SAI_STATUS_SUCCESS, sai_api_query
+               (SAI_API_ROUTE, (static_cast<void**>
+                                (static_cast<void*>(&p_route_api)))));
+
+    memset (attr_list, 0, sizeof (attr_list));
+
+    attr_list [0].id = SAI_SWITCH_ATTR_SRC_MAC_ADDRESS;
+    memcpy (attr_list [0].value.mac, router_mac, sizeof (sai_mac_t));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_sai_switch_api_tbl->set_switch_attribute (switch_id,
+                                                           &attr_list [0]));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_vrf_api->create_virtual_router (&vr_id, switch_id, 0, NULL));
+
+    attr_list [0].id = SAI_ROUTER_INTERFACE_ATTR_VIRTUAL_ROUTER_ID;
+    attr_list [0].value.oid = vr_id;
+    attr_list [1].id = SAI_ROUTER_INTERFACE_ATTR_TYPE;
+    attr_list [1].value.s32 = SAI_ROUTER_INTERFACE_TYPE_PORT;
+    attr_list [2].id = SAI_ROUTER_INTERFACE_ATTR_PORT_ID;
+    attr_list [2].value.oid = sai_bench_port_id_get (0);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_rif_api->create_router_interface (&rif_id, switch_id, 3,
+                                                   attr_list));
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, nexthop_create (nh_base_ip, rif_id, &nh_id));
+}
+
+void saiRouteBench ::TearDownTestCase (void)
+{
+    EXPECT_EQ (SAI_STATUS_SUCCESS, p_nh_api->remove_next_hop (nh_id));
+    EXPECT_EQ (SAI_STATUS_SUCCESS, p_rif_api->remove_router_interface (rif_id));
+    EXPECT_EQ (SAI_STATUS_SUCCESS, p_vrf_api->remove_virtual_router (vr_id));
+}
+
+sai_status_t saiRouteBench ::nexthop_create (uint32_t ip4_host_order,
+                                             sai_object_id_t nh_rif_id,
+                                             sai_object_id_t *p_nh_id)
+{
+    sai_attribute_t attr_list [3];
+
+    memset (attr_list, 0, sizeof (attr_list));
+
+    attr_list [0].id = SAI_NEXT_HOP_ATTR_TYPE;
+    attr_list [0].value.s32 = SAI_NEXT_HOP_TYPE_IP;
+    attr_list [1].id = SAI_NEXT_HOP_ATTR_IP;
+    attr_list [1].value.ipaddr.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    attr_list [1].value.ipaddr.addr.ip4 = htonl (ip4_host_order);
+    attr_list [2].id = SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID;
+    attr_list [2].value.oid = nh_rif_id;
+
+    return p_nh_api->create_next_hop (p_nh_id, switch_id, 3, attr_list);
+}
+
+sai_status_t saiRouteBench ::group_member_add (sai_object_id_t group_id,
+                                               sai_object_id_t member_nh_id,
+                                               sai_object_id_t *p_member_id)
+{
+    sai_attribute_t attr_list [2];
+
+    memset (attr_list, 0, sizeof (attr_list));
+
+    attr_list [0].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+    attr_list [0].value.oid = group_id;
+    attr_list [1].id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+    attr_list [1].value.oid = member_nh_id;
+
+    return p_nh_grp_api->create_next_hop_group_member (p_member_id, switch_id,
+                                                       2, attr_list);
+}
+
+void saiRouteBench ::route_entry_fill (uint64_t index, sai_route_entry_t *p_route)
+{
+    memset (p_route, 0, sizeof (sai_route_entry_t));
+
+    p_route->vr_id = vr_id;
+    p_route->destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    p_route->destination.addr.ip4 =
+        htonl (route_base_ip + (uint32_t) (index << 8));
+    p_route->destination.mask.ip4 = htonl (0xffffff00);
+}
+
+/*
+ * Route create, next hop update and remove rate at 10K/100K/1M prefixes.
+ * The scales can be overridden with SAI_BENCH_ROUTE_SCALES=n1,n2,...
+ */
+TEST_F (saiRouteBench, route_create_set_remove)
+{
+    std::vector<uint64_t> dflt_scales = {10000, 100000, 1000000};
+    std::vector<uint64_t> scales =
+        sai_bench_scales_get (SAI_BENCH_ROUTE_SCALES_ENV, dflt_scales);
+    sai_route_entry_t     route;
+    sai_attribute_t       attr;
+    sai_object_id_t       alt_nh_id = 0;
+    saiBenchTimer         timer;
+    uint64_t              idx;
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               nexthop_create (nh_base_ip + 1, rif_id, &alt_nh_id));
+
+    for (uint64_t scale : scales) {
+        ASSERT_LE (scale, (uint64_t) (1 << 24));
+
+        memset (&attr, 0, sizeof (attr));
+        attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+        attr.value.oid = nh_id;
+
+        timer.start ();
+
+        for (idx = 0; idx < scale; idx++) {
+            route_entry_fill (idx, &route);
+
+            ASSERT_EQ (SAI_STATUS_SUCCESS,
+                       p_route_api->create_route_entry (&route, 1, &attr));
+        }
+
+        sai_bench_result_record ("route", "create", scale, scale,
+                                 timer.elapsed_sec ());
+
+        attr.value.oid = alt_nh_id;
+
+        timer.start ();
+
+        for (idx = 0; idx < scale; idx++) {
+            route_entry_fill (idx, &route);
+
+            ASSERT_EQ (SAI_STATUS_SUCCESS,
+                       p_route_api->set_route_entry_attribute (&route, &attr));
+        }
+
+        sai_bench_result_record ("route", "set_next_hop", scale, scale,
+                                 timer.elapsed_sec ());
+
+        timer.start ();
+
+        for (idx = 0; idx < scale; idx++) {
+            route_entry_fill (idx, &route);
+
+            ASSERT_EQ (SAI_STATUS_SUCCESS,
+                       p_route_api->remove_route_entry (&route));
+        }
+
+        sai_bench_result_record ("route", "remove", scale, scale,
+                                 timer.elapsed_sec ());
+    }
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, p_nh_api->remove_next_hop (alt_nh_id));
+}
+
+/*
+ * Next hop create/remove churn on one router interface.
+ */
+TEST_F (saiRouteBench, next_hop_churn)
+{
+    static const uint64_t        nh_count = 4096;
+    static const unsigned int    rounds = 4;
+    std::vector<sai_object_id_t> nh_list (nh_count);
+    saiBenchTimer                timer;
+    double                       create_sec = 0;
+    double                       remove_sec = 0;
+    uint64_t                     idx;
+    unsigned int                 round;
+
+    for (round = 0; round < rounds; round++) {
+        timer.start ();
+
+        for (idx = 0; idx < nh_count; idx++) {
+            ASSERT_EQ (SAI_STATUS_SUCCESS,
+                       nexthop_create (nh_base_ip + 16 + idx, rif_id,
+                                       &nh_list [idx]));
+        }
+
+        create_sec += timer.elapsed_sec ();
+
+        timer.start ();
+
+        for (idx = 0; idx < nh_count; idx++) {
+            ASSERT_EQ (SAI_STATUS_SUCCESS,
+                       p_nh_api->remove_next_hop (nh_list [idx]));
+        }
+
+        remove_sec += timer.elapsed_sec ();
+    }
+
+    sai_bench_result_record ("next_hop", "create", nh_count,
+                             nh_count * rounds, create_sec);
+    sai_bench_result_record ("next_hop", "remove", nh_count,
+                             nh_count * rounds, remove_sec);
+}
+
+/*
+ * Next hop group member add/remove churn with routes pointing to the
+ * group, so that every membership change walks the dependent routes.
+ */
+TEST_F (saiRouteBench, next_hop_group_member_churn)
+{
+    static const uint64_t        member_count = 32;
+    static const uint64_t        route_count = 1000;
+    static const unsigned int    rounds = 64;
+    std::vector<sai_object_id_t> nh_list (member_count);
+    std::vector<sai_object_id_t> member_list (member_count);
+    sai_object_id_t              group_id = 0;
+    sai_object_id_t              anchor_member_id = 0;
+    sai_route_entry_t            route;
+    sai_attribute_t              attr;
+    saiBenchTimer                timer;
+    double                       add_sec = 0;
+    double                       remove_sec = 0;
+    uint64_t                     idx;
+    unsigned int                 round;
+
+    for (idx = 0; idx < member_count; idx++) {
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   nexthop_create (nh_base_ip + 16 + idx, rif_id,
+                                   &nh_list [idx]));
+    }
+
+    memset (&attr, 0, sizeof (attr));
+    attr.id = SAI_NEXT_HOP_GROUP_ATTR_TYPE;
+    attr.value.s32 = SAI_NEXT_HOP_GROUP_TYPE_ECMP;
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               p_nh_grp_api->create_next_hop_group (&group_id, switch_id, 1,
+                                                    &attr));
+
+    /* Keep one member so that the group never becomes empty */
+    ASSERT_EQ (SAI_STATUS_SUCCESS,
+               group_member_add (group_id, nh_id, &anchor_member_id));
+
+    attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+    attr.value.oid = group_id;
+
+    for (idx = 0; idx < route_count; idx++) {
+        route_entry_fill (idx, &route);
+
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   p_route_api->create_route_entry (&route, 1, &attr));
+    }
+
+    for (round = 0; round < rounds; round++) {
+        timer.start ();
+
+        for (idx = 0; idx < member_count; idx++) {
+            ASSERT_EQ (SAI_STATUS_SUCCESS,
+                       group_member_add (group_id, nh_list [idx],
+                                         &member_list [idx]));
+        }
+
+        add_sec += timer.elapsed_sec ();
+
+        timer.start ();
+
+        for (idx = 0; idx < member_count; idx++) {
+            ASSERT_EQ (SAI_STATUS_SUCCESS,
+                       p_nh_grp_api->remove_next_hop_group_member (
+                                                       member_list [idx]));
+        }
+
+        remove_sec += timer.elapsed_sec ();
+    }
+
+    sai_bench_result_record ("next_hop_group_member", "add", route_count,
+                             member_count * rounds, add_sec);
+    sai_bench_result_record ("next_hop_group_member", "remove", route_count,
+                             member_count * rounds, remove_sec);
+
+    for (idx = 0; idx < route_count; idx++) {
+        route_entry_fill (idx, &route);
+
+        EXPECT_EQ (SAI_STATUS_SUCCESS, p_route_api->remove_route_entry (&route));
+    }
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS,
+               p_nh_grp_api->remove_next_hop_group_member (anchor_member_id));
+    EXPECT_EQ (SAI_STATUS_SUCCESS,
+               p_nh_grp_api->remove_next_hop_group (group_id));
+
+    for (idx = 0; idx < member_count; idx++) {
+        EXPECT_EQ (SAI_STATUS_SUCCESS, p_nh_api->remove_next_hop (nh_list [idx]));
+    }
+}
+
+/* State shared by the threads of the concurrent route get benchmark */
+typedef struct _sai_bench_route_thread_t {
+    volatile bool *p_stop;
+    uint64_t       first_index;
+    uint64_t       route_count;
+    uint64_t       ops;
+    sai_status_t   status;
+} sai_bench_route_thread_t;
+
+void *saiRouteBench ::route_get_thread (void *arg)
+{
+    sai_bench_route_thread_t *p_thread = (sai_bench_route_thread_t *) arg;
+    sai_route_entry_t         route;
+    sai_attribute_t           attr;
+    uint64_t                  idx = p_thread->first_index;
+
+    while (!__atomic_load_n (p_thread->p_stop, __ATOMIC_RELAXED)) {
+        route_entry_fill (idx % p_thread->route_count, &route);
+
+        memset (&attr, 0, sizeof (attr));
+        attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+
+        p_thread->status = p_route_api->get_route_entry_attribute (&route, 1,
+                                                                   &attr);
+        if (p_thread->status != SAI_STATUS_SUCCESS) {
+            break;
+        }
+
+        if (attr.value.oid != nh_id) {
+            p_thread->status = SAI_STATUS_FAILURE;
+            break;
+        }
+
+        p_thread->ops++;
+        idx += 7919;
+    }
+
+    return NULL;
+}
+
+void *saiRouteBench ::route_churn_thread (void *arg)
+{
+    sai_bench_route_thread_t *p_thread = (sai_bench_route_thread_t *) arg;
+    sai_route_entry_t         route;
+    sai_attribute_t           attr;
+    uint64_t                  idx;
+
+    memset (&attr, 0, sizeof (attr));
+    attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+    attr.value.oid = nh_id;
+
+    while (!__atomic_load_n (p_thread->p_stop, __ATOMIC_RELAXED)) {
+        for (idx = 0; idx < p_thread->route_count; idx++) {
+            route_entry_fill (p_thread->first_index + idx, &route);
+
+            p_thread->status = p_route_api->create_route_entry (&route, 1, &attr);
+            if (p_thread->status != SAI_STATUS_SUCCESS) {
+                return NULL;
+            }
+        }
+
+        for (idx = 0; idx < p_thread->route_count; idx++) {
+            route_entry_fill (p_thread->first_index + idx, &route);
+
+            p_thread->status = p_route_api->remove_route_entry (&route);
+            if (p_thread->status != SAI_STATUS_SUCCESS) {
+                return NULL;
+            }
+        }
+
+        p_thread->ops += 2 * p_thread->route_count;
+    }
+
+    return NULL;
+}
+
+/*
+ * Route attribute get rate with 1, 2 and 4 reader threads, while a writer
+ * thread keeps creating and removing other routes. The gets share the FIB
+ * lock, so their rate scales with the readers, and the writer keeps making
+ * progress since it is preferred over new readers.
+ */
+TEST_F (saiRouteBench, route_get_concurrent)
+{
+    static const uint64_t     route_count = 10000;
+    static const uint64_t     churn_count = 1000;
+    static const double       run_sec = 1.0;
+    static const unsigned int max_readers = 4;
+    sai_bench_route_thread_t  readers [max_readers];
+    sai_bench_route_thread_t  writer;
+    pthread_t                 reader_threads [max_readers];
+    pthread_t                 writer_thread;
+    volatile bool             stop;
+    sai_route_entry_t         route;
+    sai_attribute_t           attr;
+    saiBenchTimer             timer;
+    double                    sec;
+    uint64_t                  gets;
+    uint64_t                  idx;
+    unsigned int              reader_count;
+    unsigned int              reader;
+    char                      op [32];
+
+    memset (&attr, 0, sizeof (attr));
+    attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+    attr.value.oid = nh_id;
+
+    for (idx = 0; idx < route_count; idx++) {
+        route_entry_fill (idx, &route);
+
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   p_route_api->create_route_entry (&route, 1, &attr));
+    }
+
+    for (reader_count = 1; reader_count <= max_readers; reader_count *= 2) {
+        stop = false;
+
+        memset (&writer, 0, sizeof (writer));
+        writer.p_stop = &stop;
+        writer.first_index = route_count;
+        writer.route_count = churn_count;
+
+        timer.start ();
+
+        ASSERT_EQ (0, pthread_create (&writer_thread, NULL, route_churn_thread,
+                                      &writer));
+
+        for (reader = 0; reader < reader_count; reader++) {
+            memset (&readers [reader], 0, sizeof (readers [reader]));
+            readers [reader].p_stop = &stop;
+            readers [reader].first_index = reader;
+            readers [reader].route_count = route_count;
+
+            ASSERT_EQ (0, pthread_create (&reader_threads [reader], NULL,
+                                          route_get_thread, &readers [reader]));
+        }
+
+        usleep ((useconds_t) (run_sec * 1000000));
+        __atomic_store_n (&stop, true, __ATOMIC_RELAXED);
+
+        gets = 0;
+        for (reader = 0; reader < reader_count; reader++) {
+            pthread_join (reader_threads [reader], NULL);
+
+            EXPECT_EQ (SAI_STATUS_SUCCESS, readers [reader].status);
+            gets += readers [reader].ops;
+        }
+        pthread_join (writer_thread, NULL);
+
+        sec = timer.elapsed_sec ();
+
+        EXPECT_EQ (SAI_STATUS_SUCCESS, writer.status);
+        /* A writer starved by the readers would not complete a round */
+        EXPECT_GT (writer.ops, 0);
+
+        snprintf (op, sizeof (op), "get_%u_readers", reader_count);
+        sai_bench_result_record ("route", op, route_count, gets, sec);
+
+        snprintf (op, sizeof (op), "churn_%u_readers", reader_count);
+        sai_bench_result_record ("route", op, churn_count, writer.ops, sec);
+    }
+
+    for (idx = 0; idx < route_count; idx++) {
+        route_entry_fill (idx, &route);
+
+        EXPECT_EQ (SAI_STATUS_SUCCESS, p_route_api->remove_route_entry (&route));
+    }
+}
+
+/*
+ * Route create and remove rate with the logs of the route path and of the
+ * DB mirror disabled, and the cost of one disabled level check.
+ */
+TEST_F (saiRouteBench, route_create_log_disabled)
+{
+    static const sai_api_t log_api_list [] = {
+        SAI_API_SWITCH, SAI_API_VIRTUAL_ROUTER, SAI_API_ROUTER_INTERFACE,
+        SAI_API_NEXT_HOP, SAI_API_NEXT_HOP_GROUP, SAI_API_ROUTE};
+    static const uint64_t  check_count = 100000000;
+    std::vector<uint64_t>  dflt_scales = {100000};
+    std::vector<uint64_t>  scales =
+        sai_bench_scales_get (SAI_BENCH_ROUTE_SCALES_ENV, dflt_scales);
+    sai_route_entry_t      route;
+    sai_attribute_t        attr;
+    saiBenchTimer          timer;
+    uint64_t               enabled = 0;
+    uint64_t               idx;
+    unsigned int           api_idx;
+
+    for (api_idx = 0; api_idx < (sizeof (log_api_list) / sizeof (sai_api_t));
+         api_idx++) {
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   sai_log_set (log_api_list [api_idx], SAI_LOG_LEVEL_CRITICAL));
+    }
+
+    for (uint64_t scale : scales) {
+        ASSERT_LE (scale, (uint64_t) (1 << 24));
+
+        memset (&attr, 0, sizeof (attr));
+        attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+        attr.value.oid = nh_id;
+
+        timer.start ();
+
+        for (idx = 0; idx < scale; idx++) {
+            route_entry_fill (idx, &route);
+
+            ASSERT_EQ (SAI_STATUS_SUCCESS,
+                       p_route_api->create_route_entry (&route, 1, &attr));
+        }
+
+        sai_bench_result_record ("route", "create_log_off", scale, scale,
+                                 timer.elapsed_sec ());
+
+        timer.start ();
+
+        for (idx = 0; idx < scale; idx++) {
+            route_entry_fill (idx, &route);
+
+            ASSERT_EQ (SAI_STATUS_SUCCESS,
+                       p_route_api->remove_route_entry (&route));
+        }
+
+        sai_bench_result_record ("route", "remove_log_off", scale, scale,
+                                 timer.elapsed_sec ());
+    }
+
+    timer.start ();
+
+    for (idx = 0; idx < check_count; idx++) {
+        enabled += sai_is_log_enabled (SAI_API_ROUTE, SAI_LOG_LEVEL_DEBUG);
+    }
+
+    sai_bench_result_record ("log_level_check", "function", check_count,
+                             check_count, timer.elapsed_sec ());
+
+    timer.start ();
+
+    for (idx = 0; idx < check_count; idx++) {
+        enabled += sai_is_log_enabled_fast (SAI_API_ROUTE, SAI_LOG_LEVEL_DEBUG);
+        __asm__ __volatile__ ("" ::: "memory");
+    }
+
+    sai_bench_result_record ("log_level_check", "inline", check_count,
+                             check_count, timer.elapsed_sec ());
+
+    EXPECT_EQ ((uint64_t) 0, enabled);
+
+    for (api_idx = 0; api_idx < (sizeof (log_api_list) / sizeof (sai_api_t));
+         api_idx++) {
+        EXPECT_EQ (SAI_STATUS_SUCCESS,
+                   sai_log_set (log_api_list [api_idx], SAI_LOG_LEVEL_WARN));
+    }
+}
+
+/*
+ * Route create and remove rate with the route path traces enabled, logged
+ * synchronously and then through the asynchronous log sink.
+ */
+TEST_F (saiRouteBench, route_create_trace_sync_async)
+{
+    static const sai_api_t log_api_list [] = {
+        SAI_API_VIRTUAL_ROUTER, SAI_API_ROUTER_INTERFACE, SAI_API_NEXT_HOP,
+        SAI_API_NEXT_HOP_GROUP, SAI_API_ROUTE};
+    static const char     *mode_list [] = {"sync", "async"};
+    std::vector<uint64_t>  dflt_scales = {100000};
+    std::vector<uint64_t>  scales =
+        sai_bench_scales_get (SAI_BENCH_ROUTE_SCALES_ENV, dflt_scales);
+    sai_route_entry_t      route;
+    sai_attribute_t        attr;
+    saiBenchTimer          timer;
+    char                   op [64];
+    uint64_t               drops = 0;
+    uint64_t               idx;
+    unsigned int           api_idx;
+    unsigned int           mode;
+
+    for (api_idx = 0; api_idx < (sizeof (log_api_list) / sizeof (sai_api_t));
+         api_idx++) {
+        ASSERT_EQ (SAI_STATUS_SUCCESS,
+                   sai_log_set (log_api_list [api_idx], SAI_LOG_LEVEL_DEBUG));
+    }
+
+    for (uint64_t scale : scales) {
+        ASSERT_LE (scale, (uint64_t) (1 << 24));
+
+        for (mode = 0; mode < (sizeof (mode_list) / sizeof (mode_list [0])); mode++) {
+            ASSERT_EQ (SAI_STATUS_SUCCESS, sai_log_async_enable (mode != 0));
+
+            memset (&attr, 0, sizeof (attr));
+            attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+            attr.value.oid = nh_id;
+
+            drops = sai_log_async_drops_get ();
+
+            timer.start ();
+
+            for (idx = 0; idx < scale; idx++) {
+                route_entry_fill (idx, &route);
+
+                ASSERT_EQ (SAI_STATUS_SUCCESS,
+                           p_route_api->create_route_entry (&route, 1, &attr));
+            }
+
+            snprintf (op, sizeof (op), "create_trace_%s", mode_list [mode]);
+            sai_bench_result_record ("route", op, scale, scale,
+                                     timer.elapsed_sec ());
+
+            timer.start ();
+
+            for (idx = 0; idx < scale; idx++) {
+                route_entry_fill (idx, &route);
+
+                ASSERT_EQ (SAI_STATUS_SUCCESS,
+                           p_route_api->remove_route_entry (&route));
+            }
+
+            snprintf (op, sizeof (op), "remove_trace_%s", mode_list [mode]);
+            sai_bench_result_record ("route", op, scale, scale,
+                                     timer.elapsed_sec ());
+
+            /* Logs dropped on full rings, as a count over the 2 loops */
+            snprintf (op, sizeof (op), "log_drops_%s", mode_list [mode]);
+            sai_bench_result_record ("route", op, scale,
+                                     sai_log_async_drops_get () - drops, 0);
+
+            EXPECT_TRUE (sai_log_async_flush (10000));
+        }
+    }
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS, sai_log_async_enable (false));
+
+    for (api_idx = 0; api_idx < (sizeof (log_api_list) / sizeof (sai_api_t));
+         api_idx++) {
+        EXPECT_EQ (SAI_STATUS_SUCCESS,
+                   sai_log_set (log_api_list [api_idx], SAI_LOG_LEVEL_WARN));
+    }
+}
@@ -23,6 +23,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <pthread.h>
 #include "gtest/gtest.h"
 #include <inttypes.h>
 
@@ -36,6 +37,7 @@ extern "C" {
 #include "saiswitch.h"
 #include "sai_bridge_main.h"
 #include "sai_bridge_common.h"
+#include "sai_bridge_api.h"
 }
 
 static sai_object_id_t          cb_bridge_port_id = 0;
@@ -972,3 +974,129 @@ TEST_F(bridgeTest, 1d_multicast_flood_groups_on_lag)
                                                true, &bridge_port_list[1]));
 }
 
+
+#define SAI_BRIDGE_UT_SNAPSHOT_PORTS   16
+#define SAI_BRIDGE_UT_SNAPSHOT_READERS 4
+#define SAI_BRIDGE_UT_SNAPSHOT_ROUNDS  200
+
+static sai_object_id_t snapshot_bridge_port_ids[SAI_BRIDGE_UT_SNAPSHOT_PORTS];
+static sai_object_id_t snapshot_bridge_id = SAI_NULL_OBJECT_ID;
+static volatile bool   snapshot_readers_stop = false;
+
+typedef struct _sai_bridge_ut_snapshot_reader_t {
+    uint_t reads;
+    uint_t errors;
+} sai_bridge_ut_snapshot_reader_t;
+
+static void *sai_bridge_ut_snapshot_reader(void *arg)
+{
+    sai_bridge_ut_snapshot_reader_t *reader = (sai_bridge_ut_snapshot_reader_t *)arg;
+    dn_sai_bridge_port_info_t        bridge_port_info;
+    sai_object_id_t                  list[SAI_MAX_BRIDGE_PORTS];
+    sai_object_id_t                  bridge_port_id;
+    sai_vlan_id_t                    vlan_id;
+    uint_t                           count;
+    uint_t                           idx = 0;
+
+    while(!__atomic_load_n(&snapshot_readers_stop, __ATOMIC_RELAXED)) {
+        idx = (idx + 1) % SAI_BRIDGE_UT_SNAPSHOT_PORTS;
+        bridge_port_id = __atomic_load_n(&snapshot_bridge_port_ids[idx], __ATOMIC_RELAXED);
+
+        /*
+         * Lookups race with the create, set and remove of the bridge port, and
+         * a removed id may be given again to a bridge port of another slot.
+         */
+        if(sai_bridge_port_cache_snapshot_read(bridge_port_id, &bridge_port_info)
+           == SAI_STATUS_SUCCESS) {
+            vlan_id = sai_bridge_port_info_get_vlan_id(&bridge_port_info);
+
+            if((bridge_port_info.bridge_port_id != bridge_port_id) ||
+               (bridge_port_info.bridge_port_type != SAI_BRIDGE_PORT_TYPE_SUB_PORT) ||
+               (bridge_port_info.bridge_id != snapshot_bridge_id) ||
+               (vlan_id < SAI_BRIDGE_GTEST_VLAN) ||
+               (vlan_id >= (SAI_BRIDGE_GTEST_VLAN + SAI_BRIDGE_UT_SNAPSHOT_PORTS))) {
+                reader->errors++;
+            }
+        }
+
+        count = SAI_MAX_BRIDGE_PORTS;
+        if(sai_bridge_port_list_get(&count, list) != SAI_STATUS_SUCCESS) {
+            reader->errors++;
+        }
+        reader->reads++;
+    }
+    return NULL;
+}
+
+TEST_F(bridgeTest, bridge_port_snapshot_read_concurrent)
+{
+    sai_bridge_ut_snapshot_reader_t readers[SAI_BRIDGE_UT_SNAPSHOT_READERS];
+    pthread_t                       threads[SAI_BRIDGE_UT_SNAPSHOT_READERS];
+    sai_object_id_t                 bridge_id = SAI_NULL_OBJECT_ID;
+    sai_object_id_t                 bridge_port_id = SAI_NULL_OBJECT_ID;
+    sai_attribute_t                 attr[4];
+    uint_t                          base_count = sai_bridge_port_total_count();
+    uint_t                          round = 0;
+    uint_t                          idx = 0;
+
+    attr[0].id = SAI_BRIDGE_ATTR_TYPE;
+    attr[0].value.s32 = SAI_BRIDGE_TYPE_1D;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              p_sai_bridge_api_tbl->create_bridge(&bridge_id, switch_id, 1, &attr[0]));
+
+    memset(readers, 0, sizeof(readers));
+    memset(snapshot_bridge_port_ids, 0, sizeof(snapshot_bridge_port_ids));
+    snapshot_bridge_id = bridge_id;
+    snapshot_readers_stop = false;
+    for(idx = 0; idx < SAI_BRIDGE_UT_SNAPSHOT_READERS; idx++) {
+        ASSERT_EQ(0, pthread_create(&threads[idx], NULL, sai_bridge_ut_snapshot_reader,
+                                    &readers[idx]));
+    }
+
+    attr[0].id = SAI_BRIDGE_PORT_ATTR_TYPE;
+    attr[0].value.s32 = SAI_BRIDGE_PORT_TYPE_SUB_PORT;
+    attr[1].id = SAI_BRIDGE_PORT_ATTR_PORT_ID;
+    attr[1].value.oid = port_list[0];
+    attr[2].id = SAI_BRIDGE_PORT_ATTR_BRIDGE_ID;
+    attr[2].value.oid = bridge_id;
+    attr[3].id = SAI_BRIDGE_PORT_ATTR_VLAN_ID;
+
+    for(round = 0; round < SAI_BRIDGE_UT_SNAPSHOT_ROUNDS; round++) {
+        for(idx = 0; idx < SAI_BRIDGE_UT_SNAPSHOT_PORTS; idx++) {
+            attr[3].value.u16 = SAI_BRIDGE_GTEST_VLAN + idx;
+            EXPECT_EQ(SAI_STATUS_SUCCESS,
+                      p_sai_bridge_api_tbl->create_bridge_port(&bridge_port_id, switch_id,
+                                                               4, attr));
+            __atomic_store_n(&snapshot_bridge_port_ids[idx], bridge_port_id, __ATOMIC_RELAXED);
+        }
+        EXPECT_EQ(base_count + SAI_BRIDGE_UT_SNAPSHOT_PORTS, sai_bridge_port_total_count());
+
+        for(idx = 0; idx < SAI_BRIDGE_UT_SNAPSHOT_PORTS; idx++) {
+            sai_attribute_t admin_attr;
+
+            admin_attr.id = SAI_BRIDGE_PORT_ATTR_ADMIN_STATE;
+            admin_attr.value.booldata = ((round % 2) == 0);
+            EXPECT_EQ(SAI_STATUS_SUCCESS,
+                      p_sai_bridge_api_tbl->set_bridge_port_attribute(
+                      snapshot_bridge_port_ids[idx], &admin_attr));
+        }
+
+        for(idx = 0; idx < SAI_BRIDGE_UT_SNAPSHOT_PORTS; idx++) {
+            EXPECT_EQ(SAI_STATUS_SUCCESS,
+                      p_sai_bridge_api_tbl->remove_bridge_port(snapshot_bridge_port_ids[idx]));
+        }
+        EXPECT_EQ(base_count, sai_bridge_port_total_count());
+    }
+
+    __atomic_store_n(&snapshot_readers_stop, true, __ATOMIC_RELAXED);
+    for(idx = 0; idx < SAI_BRIDGE_UT_SNAPSHOT_READERS; idx++) {
+        pthread_join(threads[idx], NULL);
+        printf("Reader %u: %u reads, %u errors\r\n", idx, readers[idx].reads,
+               readers[idx].errors);
+        EXPECT_EQ(0, readers[idx].errors);
+    }
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              p_sai_bridge_api_tbl->remove_bridge(bridge_id));
+}
@@ -25,6 +25,7 @@ extern "C" {
 #include "sai.h"
 #include "saihostif.h"
 #include "saitypes.h"
+#include "sai_hostif_api.h"
 }
 
 
@@ -563,6 +564,94 @@ TEST_F(hostIntfInit, send_pkt_pipeline_lookup)
     ASSERT_EQ (rc, SAI_STATUS_SUCCESS);
 }
 
+TEST_F(hostIntfInit, create_remove_netdev_hostif)
+{
+    sai_attribute_t attr_list[3];
+    sai_attribute_t get_attr[2];
+    sai_object_id_t hostif_id = SAI_NULL_OBJECT_ID;
+    sai_object_id_t dup_hostif_id = SAI_NULL_OBJECT_ID;
+
+    memset(attr_list, 0, sizeof(attr_list));
+    memset(get_attr, 0, sizeof(get_attr));
+
+    attr_list[0].id = SAI_HOSTIF_ATTR_TYPE;
+    attr_list[0].value.s32 = SAI_HOSTIF_TYPE_NETDEV;
+
+    attr_list[1].id = SAI_HOSTIF_ATTR_OBJ_ID;
+    attr_list[1].value.oid = port_list[0];
+
+    attr_list[2].id = SAI_HOSTIF_ATTR_NAME;
+    strncpy(attr_list[2].value.chardata, "saitest0", SAI_HOSTIF_NAME_SIZE - 1);
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              sai_hostif_api_table->create_hostif(&hostif_id, switch_id, 3, attr_list));
+
+    /* A port is bound to one netdev hostif */
+    strncpy(attr_list[2].value.chardata, "saitest1", SAI_HOSTIF_NAME_SIZE - 1);
+    EXPECT_NE(SAI_STATUS_SUCCESS,
+              sai_hostif_api_table->create_hostif(&dup_hostif_id, switch_id, 3, attr_list));
+
+    get_attr[0].id = SAI_HOSTIF_ATTR_OPER_STATUS;
+    get_attr[0].value.booldata = true;
+    EXPECT_EQ(SAI_STATUS_SUCCESS,
+              sai_hostif_api_table->set_hostif_attribute(hostif_id, &get_attr[0]));
+
+    get_attr[0].id = SAI_HOSTIF_ATTR_OBJ_ID;
+    get_attr[1].id = SAI_HOSTIF_ATTR_OPER_STATUS;
+    get_attr[1].value.booldata = false;
+    EXPECT_EQ(SAI_STATUS_SUCCESS,
+              sai_hostif_api_table->get_hostif_attribute(hostif_id, 2, get_attr));
+    EXPECT_EQ(port_list[0], get_attr[0].value.oid);
+    EXPECT_TRUE(get_attr[1].value.booldata);
+
+    EXPECT_EQ(SAI_STATUS_SUCCESS, sai_hostif_api_table->remove_hostif(hostif_id));
+    EXPECT_NE(SAI_STATUS_SUCCESS, sai_hostif_api_table->remove_hostif(hostif_id));
+}
+
+TEST_F(hostIntfInit, fd_hostif_recv)
+{
+    sai_attribute_t attr;
+    sai_attribute_t pkt_attr[DN_SAI_HOSTIF_PKT_MAX_ATTRS];
+    sai_object_id_t hostif_id = SAI_NULL_OBJECT_ID;
+    uint8_t buffer[256];
+    sai_size_t buffer_size = sizeof(buffer);
+    uint_t attr_count = DN_SAI_HOSTIF_PKT_MAX_ATTRS;
+    uint64_t rx_drops = 1;
+    int event_fd = -1;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.id = SAI_HOSTIF_ATTR_TYPE;
+    attr.value.s32 = SAI_HOSTIF_TYPE_FD;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              sai_hostif_api_table->create_hostif(&hostif_id, switch_id, 1, &attr));
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_hostif_event_fd_get(hostif_id, &event_fd));
+    EXPECT_TRUE(event_fd >= 0);
+
+    EXPECT_EQ(SAI_STATUS_SUCCESS, sai_hostif_rx_drops_get(hostif_id, &rx_drops));
+    EXPECT_EQ(0, rx_drops);
+
+    /* Drain whatever was punted so far */
+    while (sai_hostif_api_table->recv_hostif_packet(hostif_id, buffer, &buffer_size,
+                                                    &attr_count, pkt_attr)
+           == SAI_STATUS_SUCCESS) {
+        EXPECT_TRUE(attr_count >= 1);
+        buffer_size = sizeof(buffer);
+        attr_count = DN_SAI_HOSTIF_PKT_MAX_ATTRS;
+    }
+
+    /* Room for every packet attribute is required */
+    attr_count = 1;
+    EXPECT_EQ(SAI_STATUS_BUFFER_OVERFLOW,
+              sai_hostif_api_table->recv_hostif_packet(hostif_id, buffer, &buffer_size,
+                                                       &attr_count, pkt_attr));
+    EXPECT_EQ(DN_SAI_HOSTIF_PKT_MAX_ATTRS, attr_count);
+
+    EXPECT_EQ(SAI_STATUS_SUCCESS, sai_hostif_api_table->remove_hostif(hostif_id));
+    EXPECT_NE(SAI_STATUS_SUCCESS, sai_hostif_event_fd_get(hostif_id, &event_fd));
+}
+
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -31,6 +31,8 @@ extern "C" {
 #include "sai_qos_unit_test_utils.h"
 #include "sai.h"
 #include "saiqosmap.h"
+#include "sai_vm_vport.h"
+#include "sai_port_utils.h"
 #include <inttypes.h>
 }
 
@@ -1799,6 +1801,161 @@ TEST_F(qosMap, tc_to_queue_map_set_get)
               (map_id, 1, &get_attr));
 }
 
+/*
+ * Set a tc_to_queue map bound to ports, again with the same values, then
+ * with an out of range entry, then with a changed entry.
+ * Expect - the same values and the failed set push nothing to the ports,
+ *          the values of the first set are kept and the changed entry
+ *          reaches the queue lookup of the ports.
+ */
+TEST_F(qosMap, tc_to_queue_map_update_on_ports)
+{
+    sai_attribute_t attr;
+    sai_attribute_t get_attr;
+    sai_attribute_t set_attr;
+    sai_attribute_t default_tc_attr;
+    sai_object_id_t map_id = 0;
+    sai_qos_map_list_t map_list;
+    sai_port_info_t *p_port_info = NULL;
+    vport_desc_t *p_vport = NULL;
+    sai_vm_vport_qos_class_t qos_class;
+    uint64_t generation = 0;
+    /* Untagged non IP frame, classified to the switch default TC */
+    uint8_t frame[64] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05,
+                         0x00, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+                         0x08, 0x06};
+
+    p_port_info = sai_port_info_get(sai_qos_port_id_get(test_port_id));
+    ASSERT_TRUE(p_port_info != NULL);
+
+    p_vport = sai_vm_vport_get_desc(p_port_info->phy_port_id);
+    ASSERT_TRUE(p_vport != NULL);
+
+    default_tc_attr.id = SAI_SWITCH_ATTR_QOS_DEFAULT_TC;
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              sai_switch_api_table->get_switch_attribute(switch_id, 1, &default_tc_attr));
+
+    set_attr.id = SAI_SWITCH_ATTR_QOS_DEFAULT_TC;
+    set_attr.value.u32 = DEFAULT_TC;
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              sai_switch_api_table->set_switch_attribute(switch_id, &set_attr));
+
+    attr.id = SAI_QOS_MAP_ATTR_TYPE;
+    attr.value.s32 = SAI_QOS_MAP_TYPE_TC_TO_QUEUE;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->create_qos_map
+              (&map_id, switch_id, 1, (const sai_attribute_t *)&attr));
+
+    set_attr.id = SAI_PORT_ATTR_QOS_TC_TO_QUEUE_MAP;
+    set_attr.value.oid = map_id;
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_port_api_table->set_port_attribute
+              (sai_qos_port_id_get(test_port_id), (const sai_attribute_t *)&set_attr));
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_port_api_table->set_port_attribute
+              (sai_qos_port_id_get(test_port_id_1), (const sai_attribute_t *)&set_attr));
+
+    set_attr.id = SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST;
+    map_list.count = 2;
+    map_list.list = (sai_qos_map_t *)calloc(map_list.count, sizeof(sai_qos_map_t));
+
+    map_list.list[0].key.tc = DEFAULT_TC;
+    map_list.list[0].value.queue_index = UC_Q_INDEX;
+    map_list.list[1].key.tc = 2;
+    map_list.list[1].value.queue_index = UC_Q_INDEX;
+
+    set_attr.value.qosmap.count = map_list.count;
+    set_attr.value.qosmap.list = map_list.list;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              sai_qos_map_api_table->set_qos_map_attribute(map_id, &set_attr));
+
+    generation = sai_vm_vport_qos_map_generation_get(p_port_info->phy_port_id,
+                                                     SAI_QOS_MAP_TYPE_TC_TO_QUEUE);
+    EXPECT_NE(0U, generation);
+
+    sai_vm_vport_qos_classify(p_vport, frame, sizeof(frame), NULL, &qos_class);
+    EXPECT_EQ(DEFAULT_TC, qos_class.tc);
+    EXPECT_EQ(UC_Q_INDEX, qos_class.queue);
+
+    /* Same values again: nothing changed, nothing pushed to the ports */
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              sai_qos_map_api_table->set_qos_map_attribute(map_id, &set_attr));
+
+    EXPECT_EQ(generation,
+              sai_vm_vport_qos_map_generation_get(p_port_info->phy_port_id,
+                                                  SAI_QOS_MAP_TYPE_TC_TO_QUEUE));
+
+    map_list.list[0].value.queue_index = 0;
+    map_list.list[1].key.tc = 200;
+
+    EXPECT_NE(SAI_STATUS_SUCCESS,
+              sai_qos_map_api_table->set_qos_map_attribute(map_id, &set_attr));
+
+    EXPECT_EQ(generation,
+              sai_vm_vport_qos_map_generation_get(p_port_info->phy_port_id,
+                                                  SAI_QOS_MAP_TYPE_TC_TO_QUEUE));
+
+    free(map_list.list);
+
+    get_attr.id = SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST;
+    get_attr.value.qosmap.count = 0;
+    get_attr.value.qosmap.list = NULL;
+
+    ASSERT_EQ(SAI_STATUS_BUFFER_OVERFLOW,
+              sai_qos_map_api_table->get_qos_map_attribute(map_id, 1, &get_attr));
+
+    map_list.count = get_attr.value.qosmap.count;
+    map_list.list = (sai_qos_map_t *)calloc(map_list.count, sizeof(sai_qos_map_t));
+    get_attr.value.qosmap.list = map_list.list;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              sai_qos_map_api_table->get_qos_map_attribute(map_id, 1, &get_attr));
+
+    EXPECT_EQ(get_attr.value.qosmap.list[DEFAULT_TC].value.queue_index, UC_Q_INDEX);
+    EXPECT_EQ(get_attr.value.qosmap.list[2].value.queue_index, UC_Q_INDEX);
+    free(map_list.list);
+
+    sai_vm_vport_qos_classify(p_vport, frame, sizeof(frame), NULL, &qos_class);
+    EXPECT_EQ(UC_Q_INDEX, qos_class.queue);
+
+    /* A changed entry reaches the queue lookup of the bound ports */
+    set_attr.id = SAI_QOS_MAP_ATTR_MAP_TO_VALUE_LIST;
+    map_list.count = 1;
+    map_list.list = (sai_qos_map_t *)calloc(map_list.count, sizeof(sai_qos_map_t));
+
+    map_list.list[0].key.tc = DEFAULT_TC;
+    map_list.list[0].value.queue_index = DFLT_Q_INDEX;
+
+    set_attr.value.qosmap.count = map_list.count;
+    set_attr.value.qosmap.list = map_list.list;
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              sai_qos_map_api_table->set_qos_map_attribute(map_id, &set_attr));
+    free(map_list.list);
+
+    EXPECT_LT(generation,
+              sai_vm_vport_qos_map_generation_get(p_port_info->phy_port_id,
+                                                  SAI_QOS_MAP_TYPE_TC_TO_QUEUE));
+
+    sai_vm_vport_qos_classify(p_vport, frame, sizeof(frame), NULL, &qos_class);
+    EXPECT_EQ(DEFAULT_TC, qos_class.tc);
+    EXPECT_EQ(DFLT_Q_INDEX, qos_class.queue);
+
+    set_attr.id = SAI_PORT_ATTR_QOS_TC_TO_QUEUE_MAP;
+    set_attr.value.oid = SAI_NULL_OBJECT_ID;
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_port_api_table->set_port_attribute
+              (sai_qos_port_id_get(test_port_id), (const sai_attribute_t *)&set_attr));
+    ASSERT_EQ(SAI_STATUS_SUCCESS,sai_port_api_table->set_port_attribute
+              (sai_qos_port_id_get(test_port_id_1), (const sai_attribute_t *)&set_attr));
+
+    EXPECT_EQ(0U, sai_vm_vport_qos_map_generation_get(p_port_info->phy_port_id,
+                                                     SAI_QOS_MAP_TYPE_TC_TO_QUEUE));
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS, sai_qos_map_api_table->remove_qos_map(map_id));
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              sai_switch_api_table->set_switch_attribute(switch_id, &default_tc_attr));
+}
+
 /*
  * Create a empty map and then populate with values.
  */
@@ -2167,3 +2324,94 @@ TEST_F(qosMap, pfc_pri_to_queue_map_test)
               sai_qos_map_api_table->get_qos_map_attribute
               (map_id, 1, &get_attr));
 }
+
+static uint16_t sai_qos_ut_ipv4_csum_fold(const uint8_t *ip)
+{
+    uint32_t sum = 0;
+    unsigned int idx = 0;
+
+    for (idx = 0; idx < 20; idx += 2) {
+        sum += (uint32_t)((ip[idx] << 8) | ip[idx + 1]);
+    }
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+
+    return (uint16_t)sum;
+}
+
+/*
+ * Remark a tagged IPv4 frame and an untagged IPv6 frame. DSCP and PCP are
+ * rewritten, ECN, DEI and VID are kept and the IPv4 header checksum stays valid.
+ */
+TEST_F(qosMap, vport_qos_remark)
+{
+    uint8_t frame[64];
+    uint8_t orig[64];
+    uint8_t *ip = &frame[18];
+    uint16_t csum = 0;
+    sai_vm_vport_qos_class_t qos_class;
+
+    memset(frame, 0, sizeof(frame));
+    memset(frame, 0xff, 6);
+    frame[6] = 0x00; frame[7] = 0x01; frame[11] = 0x02;
+    // 802.1Q, PCP 1, DEI set, VID 100
+    frame[12] = 0x81; frame[13] = 0x00;
+    frame[14] = 0x30; frame[15] = 0x64;
+    frame[16] = 0x08; frame[17] = 0x00;
+    // IPv4, DSCP 0, ECN 1, UDP
+    ip[0] = 0x45; ip[1] = 0x01;
+    ip[2] = 0x00; ip[3] = 0x2e;
+    ip[4] = 0x12; ip[5] = 0x34;
+    ip[8] = 64; ip[9] = 17;
+    ip[12] = 10; ip[13] = 0; ip[14] = 0; ip[15] = 1;
+    ip[16] = 10; ip[17] = 0; ip[18] = 0; ip[19] = 2;
+    csum = (uint16_t)~sai_qos_ut_ipv4_csum_fold(ip);
+    ip[10] = (uint8_t)(csum >> 8);
+    ip[11] = (uint8_t)(csum & 0xff);
+    ASSERT_EQ(0xffff, sai_qos_ut_ipv4_csum_fold(ip));
+
+    memcpy(orig, frame, sizeof(frame));
+
+    memset(&qos_class, 0, sizeof(qos_class));
+    qos_class.dscp = SAI_VM_VPORT_QOS_NO_REMARK;
+    qos_class.dot1p = SAI_VM_VPORT_QOS_NO_REMARK;
+    EXPECT_FALSE(sai_vm_vport_qos_remark(frame, sizeof(frame), &qos_class));
+    EXPECT_EQ(0, memcmp(orig, frame, sizeof(frame)));
+
+    qos_class.dscp = 46;
+    qos_class.dot1p = 5;
+    EXPECT_TRUE(sai_vm_vport_qos_remark(frame, sizeof(frame), &qos_class));
+
+    EXPECT_EQ(5, frame[14] >> 5);
+    EXPECT_EQ(0x1064, ((frame[14] << 8) | frame[15]) & 0x1fff);
+    EXPECT_EQ(46, ip[1] >> 2);
+    EXPECT_EQ(1, ip[1] & 0x03);
+    EXPECT_EQ(0xffff, sai_qos_ut_ipv4_csum_fold(ip));
+    EXPECT_EQ(0, memcmp(&orig[20], &ip[2], 8));
+    EXPECT_EQ(0, memcmp(&orig[30], &ip[12], sizeof(frame) - 30));
+
+    // Remark down to DSCP 0 keeps the checksum valid too
+    qos_class.dscp = 0;
+    qos_class.dot1p = SAI_VM_VPORT_QOS_NO_REMARK;
+    EXPECT_TRUE(sai_vm_vport_qos_remark(frame, sizeof(frame), &qos_class));
+    EXPECT_EQ(0, ip[1] >> 2);
+    EXPECT_EQ(5, frame[14] >> 5);
+    EXPECT_EQ(0xffff, sai_qos_ut_ipv4_csum_fold(ip));
+
+    // Untagged IPv6, traffic class 0x03 (DSCP 0, ECN 3)
+    memset(frame, 0, sizeof(frame));
+    frame[12] = 0x86; frame[13] = 0xdd;
+    ip = &frame[14];
+    ip[0] = 0x60; ip[1] = 0x3a; ip[2] = 0xbc; ip[3] = 0xde;
+    ip[6] = 17; ip[7] = 64;
+
+    qos_class.dscp = 46;
+    qos_class.dot1p = 5;
+    EXPECT_TRUE(sai_vm_vport_qos_remark(frame, sizeof(frame), &qos_class));
+    EXPECT_EQ(6, ip[0] >> 4);
+    EXPECT_EQ(46, ((ip[0] & 0x0f) << 2) | (ip[1] >> 6));
+    EXPECT_EQ(0x3a, ip[1] & 0x3f);
+    EXPECT_EQ(0xbc, ip[2]);
+    EXPECT_EQ(0x86, frame[12]);
+    EXPECT_EQ(0xdd, frame[13]);
+}
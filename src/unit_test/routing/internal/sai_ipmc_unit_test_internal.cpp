@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/*
+ * sai_ipmc_unit_test_internal.cpp
+ *
+ * Routing of multicast traffic through the kernel MFC entries programmed by
+ * the VM IPMC handlers. Each case runs in a child process with a network
+ * namespace of its own, holding veth pairs as router interfaces.
+ */
+
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <sched.h>
+#include "gtest/gtest.h"
+#include <inttypes.h>
+
+extern "C" {
+#include "sai.h"
+#include "saitypes.h"
+#include "sai_vm_mroute.h"
+#include <errno.h>
+#include <net/if.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+}
+
+/* Exit code of a child that cannot build its namespace */
+#define SAI_IPMC_UT_SKIP       (77)
+
+#define SAI_IPMC_UT_PORTS      (3)
+#define SAI_IPMC_UT_FRAMES     (8)
+#define SAI_IPMC_UT_GROUP      "239.1.1.1"
+#define SAI_IPMC_UT_SOURCE     "10.0.1.2"
+#define SAI_IPMC_UT_MR_CACHE   "/proc/net/ip_mr_cache"
+
+/* Router interfaces p1-p3, each a veth whose peer p<n>x sends and receives */
+static const char *sai_ipmc_ut_setup_cmd =
+    "for i in 1 2 3; do "
+    "ip link add p$i type veth peer name p${i}x && "
+    "ip addr add 10.0.$i.1/24 dev p$i && "
+    "ip link set p$i up && ip link set p${i}x up || exit 1; done && "
+    "sleep 0.3";
+
+static void sai_ipmc_ut_ip4_get (const char *addr_str, sai_ip_address_t *p_addr)
+{
+    memset (p_addr, 0, sizeof (*p_addr));
+    p_addr->addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    inet_pton (AF_INET, addr_str, &p_addr->addr.ip4);
+}
+
+static uint16_t sai_ipmc_ut_csum (const uint8_t *p_buf, size_t len)
+{
+    uint32_t sum = 0;
+    size_t   idx;
+
+    for (idx = 0; idx + 1 < len; idx += 2) {
+        sum += (p_buf [idx] << 8) | p_buf [idx + 1];
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+
+    return (uint16_t) ~sum;
+}
+
+/* UDP frame from the source to the group, with a TTL to be routed */
+static size_t sai_ipmc_ut_frame_fill (uint8_t *frame)
+{
+    static const uint8_t src_mac [] = {0x02, 0xbe, 0x00, 0x00, 0x00, 0x01};
+    uint8_t             *ip = frame + ETH_HLEN;
+    uint8_t             *udp = ip + 20;
+    uint32_t             grp = 0;
+    uint32_t             src = 0;
+    uint16_t             csum;
+
+    inet_pton (AF_INET, SAI_IPMC_UT_GROUP, &grp);
+    inet_pton (AF_INET, SAI_IPMC_UT_SOURCE, &src);
+
+    memset (frame, 0, ETH_HLEN + 28);
+    frame [0] = 0x01;
+    frame [1] = 0x00;
+    frame [2] = 0x5e;
+    frame [3] = ((uint8_t *) &grp) [1] & 0x7f;
+    frame [4] = ((uint8_t *) &grp) [2];
+    frame [5] = ((uint8_t *) &grp) [3];
+    memcpy (frame + ETH_ALEN, src_mac, ETH_ALEN);
+    frame [12] = 0x08;
+    frame [13] = 0x00;
+
+    ip [0] = 0x45;
+    ip [3] = 28;
+    ip [8] = 8;
+    ip [9] = IPPROTO_UDP;
+    memcpy (ip + 12, &src, sizeof (src));
+    memcpy (ip + 16, &grp, sizeof (grp));
+    csum = htons (sai_ipmc_ut_csum (ip, 20));
+    memcpy (ip + 10, &csum, sizeof (csum));
+
+    udp [0] = 0x03;
+    udp [1] = 0xe8;
+    udp [2] = 0x07;
+    udp [3] = 0xd0;
+    udp [5] = 8;
+
+    return ETH_HLEN + 28;
+}
+
+static int sai_ipmc_ut_sock_open (const char *if_name)
+{
+    struct sockaddr_ll addr;
+    int                sock = socket (AF_PACKET, SOCK_RAW | SOCK_NONBLOCK, htons (ETH_P_IP));
+
+    if (sock < 0) {
+        return -1;
+    }
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons (ETH_P_IP);
+    addr.sll_ifindex = (int) if_nametoindex (if_name);
+
+    if (bind (sock, (struct sockaddr *) &addr, sizeof (addr)) != 0) {
+        close (sock);
+        return -1;
+    }
+
+    return sock;
+}
+
+/* Frames sent on p1 and routed to the group on the peer of each interface */
+static bool sai_ipmc_ut_traffic_run (uint32_t rx_count [SAI_IPMC_UT_PORTS])
+{
+    uint8_t  frame [ETH_FRAME_LEN];
+    uint8_t  buf [ETH_FRAME_LEN];
+    char     if_name [IF_NAMESIZE];
+    int      sock [SAI_IPMC_UT_PORTS];
+    uint32_t grp = 0;
+    size_t   len = sai_ipmc_ut_frame_fill (frame);
+    ssize_t  rx_len;
+    bool     ok = true;
+    int      port;
+    int      idx;
+
+    inet_pton (AF_INET, SAI_IPMC_UT_GROUP, &grp);
+
+    for (port = 0; port < SAI_IPMC_UT_PORTS; port++) {
+        snprintf (if_name, sizeof (if_name), "p%dx", port + 1);
+        sock [port] = sai_ipmc_ut_sock_open (if_name);
+        rx_count [port] = 0;
+        ok = ok && (sock [port] >= 0);
+    }
+
+    for (idx = 0; ok && (idx < SAI_IPMC_UT_FRAMES); idx++) {
+        ok = (send (sock [0], frame, len, 0) == (ssize_t) len);
+    }
+
+    usleep (200000);
+
+    for (port = 1; port < SAI_IPMC_UT_PORTS; port++) {
+        while ((sock [port] >= 0) &&
+               ((rx_len = recv (sock [port], buf, sizeof (buf), 0)) > 0)) {
+            if ((rx_len >= (ssize_t) len) &&
+                (memcmp (buf + ETH_HLEN + 16, &grp, sizeof (grp)) == 0)) {
+                rx_count [port]++;
+            }
+        }
+    }
+
+    for (port = 0; port < SAI_IPMC_UT_PORTS; port++) {
+        if (sock [port] >= 0) {
+            close (sock [port]);
+        }
+    }
+
+    return ok;
+}
+
+/* Packet count of the only MFC entry, -1 if there is none */
+static long sai_ipmc_ut_mfc_pkt_count (void)
+{
+    char  line [256];
+    char  grp [16];
+    char  origin [16];
+    int   iif = 0;
+    long  pkts = -1;
+    FILE *fp = fopen (SAI_IPMC_UT_MR_CACHE, "r");
+
+    if (fp == NULL) {
+        return -1;
+    }
+
+    /* Skip the header line */
+    if (fgets (line, sizeof (line), fp) != NULL) {
+        while (fgets (line, sizeof (line), fp) != NULL) {
+            if (sscanf (line, "%15s %15s %d %ld", grp, origin, &iif, &pkts) == 4) {
+                break;
+            }
+            pkts = -1;
+        }
+    }
+
+    fclose (fp);
+
+    return pkts;
+}
+
+/*
+ * Child side of the test, the return value is the exit code: 0 on success,
+ * the number of the failed step otherwise.
+ */
+static int sai_ipmc_ut_mfc_routing (void)
+{
+    sai_ip_address_t grp_addr;
+    sai_ip_address_t src_addr;
+    uint8_t          ttls [SAI_VM_MROUTE_MAX_VIFS];
+    uint32_t         rx_count [SAI_IPMC_UT_PORTS];
+    int              vif [SAI_IPMC_UT_PORTS];
+    char             if_name [IF_NAMESIZE];
+    long             pkt_count;
+    int              port;
+
+    if (unshare (CLONE_NEWNET) != 0) {
+        printf ("Network namespace unavailable, errno %d.\r\n", errno);
+        return SAI_IPMC_UT_SKIP;
+    }
+
+    if (system (sai_ipmc_ut_setup_cmd) != 0) {
+        printf ("Interface setup failed in the test namespace.\r\n");
+        return SAI_IPMC_UT_SKIP;
+    }
+
+    if (sai_vm_mroute_init () != SAI_STATUS_SUCCESS) {
+        return 1;
+    }
+
+    for (port = 0; port < SAI_IPMC_UT_PORTS; port++) {
+        snprintf (if_name, sizeof (if_name), "p%d", port + 1);
+        vif [port] = sai_vm_mroute_vif_get ((int) if_nametoindex (if_name));
+        if (vif [port] == SAI_VM_MROUTE_INVALID_VIF) {
+            return 2;
+        }
+    }
+
+    /* A second reference shares the VIF of the interface */
+    if (sai_vm_mroute_vif_get ((int) if_nametoindex ("p2")) != vif [1]) {
+        return 3;
+    }
+    sai_vm_mroute_vif_put ((int) if_nametoindex ("p2"));
+
+    sai_ipmc_ut_ip4_get (SAI_IPMC_UT_GROUP, &grp_addr);
+    sai_ipmc_ut_ip4_get (SAI_IPMC_UT_SOURCE, &src_addr);
+
+    /* (S,G) from p1 to p2 */
+    memset (ttls, SAI_VM_MROUTE_NO_OIF_TTL, sizeof (ttls));
+    ttls [vif [1]] = SAI_VM_MROUTE_OIF_TTL;
+
+    if (sai_vm_mroute_mfc_set (&src_addr, &grp_addr, vif [0], ttls) != SAI_STATUS_SUCCESS) {
+        return 4;
+    }
+
+    if (!sai_ipmc_ut_traffic_run (rx_count)) {
+        return 5;
+    }
+
+    printf ("Group " SAI_IPMC_UT_GROUP " packets on p2: %u, p3: %u.\r\n",
+            rx_count [1], rx_count [2]);
+
+    if ((rx_count [1] != SAI_IPMC_UT_FRAMES) || (rx_count [2] != 0)) {
+        return 6;
+    }
+
+    /* p3 joins: the entry is updated in place and keeps its counters */
+    ttls [vif [2]] = SAI_VM_MROUTE_OIF_TTL;
+
+    if (sai_vm_mroute_mfc_set (&src_addr, &grp_addr, vif [0], ttls) != SAI_STATUS_SUCCESS) {
+        return 7;
+    }
+
+    pkt_count = sai_ipmc_ut_mfc_pkt_count ();
+    if (pkt_count != SAI_IPMC_UT_FRAMES) {
+        printf ("MFC packet count %ld after the update.\r\n", pkt_count);
+        return 8;
+    }
+
+    if (!sai_ipmc_ut_traffic_run (rx_count) ||
+        (rx_count [1] != SAI_IPMC_UT_FRAMES) || (rx_count [2] != SAI_IPMC_UT_FRAMES)) {
+        return 9;
+    }
+
+    /* p2 interface goes away, the kernel drops it from the output list */
+    sai_vm_mroute_vif_put ((int) if_nametoindex ("p2"));
+
+    if (!sai_ipmc_ut_traffic_run (rx_count) ||
+        (rx_count [1] != 0) || (rx_count [2] != SAI_IPMC_UT_FRAMES)) {
+        return 10;
+    }
+
+    if ((sai_vm_mroute_mfc_del (&src_addr, &grp_addr) != SAI_STATUS_SUCCESS) ||
+        (sai_ipmc_ut_mfc_pkt_count () != -1)) {
+        return 11;
+    }
+
+    /* A missing entry is not an error */
+    if (sai_vm_mroute_mfc_del (&src_addr, &grp_addr) != SAI_STATUS_SUCCESS) {
+        return 12;
+    }
+
+    return 0;
+}
+
+TEST(saiIpmcInternalTest, mfc_routing_in_namespace)
+{
+    pid_t pid = fork ();
+    int   status = 0;
+
+    ASSERT_TRUE (pid >= 0);
+
+    if (pid == 0) {
+        _exit (sai_ipmc_ut_mfc_routing ());
+    }
+
+    ASSERT_EQ (pid, waitpid (pid, &status, 0));
+    ASSERT_TRUE (WIFEXITED (status));
+
+    if (WEXITSTATUS (status) == SAI_IPMC_UT_SKIP) {
+        printf ("Skipped, the test needs CAP_NET_ADMIN and iproute2.\r\n");
+        return;
+    }
+
+    EXPECT_EQ (0, WEXITSTATUS (status));
+}
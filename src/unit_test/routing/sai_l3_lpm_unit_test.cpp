@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file  sai_l3_lpm_unit_test.cpp
+*
+* @brief This file contains the google unit test cases to test the
+*        compiled LPM table against the radix route tree, and the
+*        lookup/update benchmark of the LPM table.
+*
+*************************************************************************/
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "saistatus.h"
+#include "saitypes.h"
+#include "sai_l3_lpm.h"
+#include "std_radix.h"
+#include <arpa/inet.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+}
+
+#include <vector>
+
+/* Route tree node, laid out like sai_fib_route_t: head first, then key */
+typedef struct _lpm_test_route_t {
+    std_rt_head       rt_head;
+    sai_ip_address_t  prefix;
+    uint_t            prefix_len;
+    uint_t            leaf;
+    sai_fib_lpm_nh_t  nh;
+} lpm_test_route_t;
+
+static const unsigned int LPM_TEST_AF_BITS =
+                              (sizeof (sai_ip_addr_family_t) * 8);
+static const unsigned int LPM_TEST_KEY_BITS = (sizeof (sai_ip_address_t) * 8);
+
+class saiL3LpmTest : public ::testing::Test {
+    protected:
+        virtual void SetUp (void);
+        virtual void TearDown (void);
+
+        void random_prefix (sai_ip_addr_family_t af, sai_ip_address_t *prefix,
+                            uint_t *prefix_len);
+        void random_addr (sai_ip_addr_family_t af, sai_ip_address_t *addr);
+        lpm_test_route_t *route_add (const sai_ip_address_t *prefix,
+                                     uint_t prefix_len);
+        void route_remove (lpm_test_route_t *p_route);
+        void lookup_verify (const sai_ip_address_t *addr);
+        void run_random_test (sai_ip_addr_family_t af, unsigned int count);
+
+        sai_fib_lpm_t *lpm;
+        std_rt_table  *tree;
+        std::vector<lpm_test_route_t *> routes;
+        sai_object_id_t next_nh_id;
+};
+
+void saiL3LpmTest::SetUp (void)
+{
+    srandom (0x5a1);
+
+    lpm = sai_fib_lpm_create ();
+    ASSERT_TRUE (lpm != NULL);
+
+    tree = std_radix_create ("LPM_Test_Route_Tree", LPM_TEST_KEY_BITS,
+                             NULL, NULL, 0);
+    ASSERT_TRUE (tree != NULL);
+
+    next_nh_id = 0x1000;
+}
+
+void saiL3LpmTest::TearDown (void)
+{
+    sai_fib_lpm_stats_t stats;
+
+    while (!routes.empty ()) {
+        route_remove (routes.back ());
+    }
+
+    /* Every leaf and group must be released with the last prefix */
+    sai_fib_lpm_stats_get (lpm, &stats);
+
+    EXPECT_EQ (0, stats.leaf_count);
+    EXPECT_EQ (0, stats.ipv4_group_count);
+    EXPECT_EQ (0, stats.ipv6_group_count);
+
+    std_radix_destroy (tree);
+    sai_fib_lpm_destroy (lpm);
+}
+
+static void lpm_test_prefix_mask (sai_ip_address_t *prefix, uint_t prefix_len)
+{
+    uint8_t *bytes;
+    uint_t   len;
+    uint_t   idx;
+
+    if (prefix->addr_family == SAI_IP_ADDR_FAMILY_IPV4) {
+        bytes = (uint8_t *) &prefix->addr.ip4;
+        len = sizeof (prefix->addr.ip4);
+    } else {
+        bytes = prefix->addr.ip6;
+        len = sizeof (prefix->addr.ip6);
+    }
+
+    for (idx = 0; idx < len; idx++) {
+        if (prefix_len >= 8) {
+            prefix_len -= 8;
+        } else {
+            bytes [idx] &= (uint8_t) (0xff00 >> prefix_len);
+            prefix_len = 0;
+        }
+    }
+}
+
+void saiL3LpmTest::random_addr (sai_ip_addr_family_t af, sai_ip_address_t *addr)
+{
+    unsigned int idx;
+
+    memset (addr, 0, sizeof (sai_ip_address_t));
+    addr->addr_family = af;
+
+    if (af == SAI_IP_ADDR_FAMILY_IPV4) {
+        /* Keep the addresses in a few /8s so that prefixes overlap */
+        addr->addr.ip4 = htonl ((uint32_t) ((10 + (random () % 4)) << 24) |
+                                (uint32_t) (random () & 0xffffff));
+    } else {
+        addr->addr.ip6 [0] = 0x20;
+        addr->addr.ip6 [1] = 0x01;
+        addr->addr.ip6 [2] = (uint8_t) (random () % 4);
+
+        for (idx = 3; idx < sizeof (addr->addr.ip6); idx++) {
+            addr->addr.ip6 [idx] = (uint8_t) random ();
+        }
+    }
+}
+
+void saiL3LpmTest::random_prefix (sai_ip_addr_family_t af,
+                                  sai_ip_address_t *prefix, uint_t *prefix_len)
+{
+    uint_t max_len = (af == SAI_IP_ADDR_FAMILY_IPV4) ? 32 : 128;
+
+    random_addr (af, prefix);
+
+    /* Bias towards the lengths seen in real tables */
+    switch (random () % 4) {
+        case 0:
+            *prefix_len = random () % (max_len + 1);
+            break;
+        case 1:
+            *prefix_len = (af == SAI_IP_ADDR_FAMILY_IPV4) ? 24 : 48;
+            break;
+        case 2:
+            *prefix_len = (af == SAI_IP_ADDR_FAMILY_IPV4) ?
+                (25 + (random () % 8)) : (64 + (random () % 65));
+            break;
+        default:
+            *prefix_len = (af == SAI_IP_ADDR_FAMILY_IPV4) ?
+                (8 + (random () % 17)) : (16 + (random () % 33));
+            break;
+    }
+
+    lpm_test_prefix_mask (prefix, *prefix_len);
+}
+
+lpm_test_route_t *saiL3LpmTest::route_add (const sai_ip_address_t *prefix,
+                                           uint_t prefix_len)
+{
+    lpm_test_route_t *p_route;
+
+    p_route = (lpm_test_route_t *) calloc (1, sizeof (lpm_test_route_t));
+
+    if (p_route == NULL) {
+        return NULL;
+    }
+
+    memcpy (&p_route->prefix, prefix, sizeof (sai_ip_address_t));
+    p_route->prefix_len = prefix_len;
+    p_route->rt_head.rth_addr = (u_char *) &p_route->prefix;
+
+    if (std_radix_insert (tree, &p_route->rt_head,
+                          LPM_TEST_AF_BITS + prefix_len) != &p_route->rt_head) {
+        /* Duplicate prefix */
+        free (p_route);
+        return NULL;
+    }
+
+    p_route->nh.packet_action = SAI_PACKET_ACTION_FORWARD;
+    p_route->nh.nh_type = SAI_OBJECT_TYPE_NEXT_HOP;
+    p_route->nh.nh_id = next_nh_id++;
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS,
+               sai_fib_lpm_prefix_add (lpm, prefix, prefix_len, &p_route->nh,
+                                       &p_route->leaf));
+    EXPECT_NE (SAI_FIB_LPM_LEAF_NONE, p_route->leaf);
+
+    routes.push_back (p_route);
+
+    return p_route;
+}
+
+void saiL3LpmTest::route_remove (lpm_test_route_t *p_route)
+{
+    lpm_test_route_t *p_cover;
+    std::vector<lpm_test_route_t *>::iterator it;
+
+    /* The cover is looked up before the node leaves the tree */
+    p_cover = (lpm_test_route_t *)
+        std_radix_getlessspecific (tree, &p_route->rt_head);
+
+    sai_fib_lpm_prefix_remove (lpm, &p_route->prefix, p_route->prefix_len,
+                               p_route->leaf,
+                               (p_cover != NULL) ? p_cover->leaf :
+                               SAI_FIB_LPM_LEAF_NONE,
+                               (p_cover != NULL) ? p_cover->prefix_len : 0);
+
+    std_radix_remove (tree, &p_route->rt_head);
+
+    for (it = routes.begin (); it != routes.end (); ++it) {
+        if (*it == p_route) {
+            routes.erase (it);
+            break;
+        }
+    }
+
+    free (p_route);
+}
+
+void saiL3LpmTest::lookup_verify (const sai_ip_address_t *addr)
+{
+    lpm_test_route_t *p_best;
+    sai_fib_lpm_nh_t  nh;
+    bool              found;
+
+    memset (&nh, 0, sizeof (nh));
+
+    p_best = (lpm_test_route_t *)
+        std_radix_getbest (tree, (uint8_t *) addr, LPM_TEST_KEY_BITS);
+
+    found = sai_fib_lpm_lookup (lpm, addr, &nh);
+
+    ASSERT_EQ ((p_best != NULL), found);
+
+    if (p_best != NULL) {
+        EXPECT_EQ (p_best->prefix_len, nh.prefix_len);
+        EXPECT_EQ (p_best->nh.nh_id, nh.nh_id);
+        EXPECT_EQ (p_best->nh.nh_type, nh.nh_type);
+        EXPECT_EQ (p_best->nh.packet_action, nh.packet_action);
+    }
+}
+
+void saiL3LpmTest::run_random_test (sai_ip_addr_family_t af, unsigned int count)
+{
+    sai_ip_address_t addr;
+    uint_t           prefix_len;
+    unsigned int     idx;
+    unsigned int     round;
+
+    for (round = 0; round < 4; round++) {
+        for (idx = 0; idx < count; idx++) {
+            random_prefix (af, &addr, &prefix_len);
+            route_add (&addr, prefix_len);
+        }
+
+        for (idx = 0; idx < (4 * count); idx++) {
+            random_addr (af, &addr);
+            lookup_verify (&addr);
+        }
+
+        /* Lookups at the first address of every prefix hit prefix edges */
+        for (idx = 0; idx < routes.size (); idx++) {
+            lookup_verify (&routes [idx]->prefix);
+        }
+
+        /* Change some results in place */
+        for (idx = 0; idx < routes.size (); idx += 7) {
+            routes [idx]->nh.nh_id = next_nh_id++;
+            routes [idx]->nh.packet_action = SAI_PACKET_ACTION_DROP;
+            sai_fib_lpm_prefix_update (lpm, routes [idx]->leaf,
+                                       &routes [idx]->nh);
+        }
+
+        /* Remove a random half, then check the holes fell back correctly */
+        for (idx = 0; idx < (count / 2) && !routes.empty (); idx++) {
+            route_remove (routes [random () % routes.size ()]);
+        }
+
+        for (idx = 0; idx < (4 * count); idx++) {
+            random_addr (af, &addr);
+            lookup_verify (&addr);
+        }
+    }
+}
+
+/*
+ * Random IPv4 prefixes, compared against the route tree after every add,
+ * update and remove pass.
+ */
+TEST_F (saiL3LpmTest, ipv4_random_prefixes)
+{
+    run_random_test (SAI_IP_ADDR_FAMILY_IPV4, 5000);
+}
+
+/*
+ * Random IPv6 prefixes, compared against the route tree.
+ */
+TEST_F (saiL3LpmTest, ipv6_random_prefixes)
+{
+    run_random_test (SAI_IP_ADDR_FAMILY_IPV6, 5000);
+}
+
+/*
+ * Default route plus nested prefixes sharing the same group.
+ */
+TEST_F (saiL3LpmTest, nested_prefixes)
+{
+    sai_ip_address_t  addr;
+    lpm_test_route_t *p_route_24;
+    lpm_test_route_t *p_route_28;
+    lpm_test_route_t *p_route_32;
+    sai_fib_lpm_nh_t  nh;
+
+    memset (&addr, 0, sizeof (addr));
+    addr.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+
+    ASSERT_TRUE (route_add (&addr, 0) != NULL);
+
+    inet_pton (AF_INET, "50.1.1.0", &addr.addr.ip4);
+    p_route_24 = route_add (&addr, 24);
+    p_route_28 = route_add (&addr, 28);
+    inet_pton (AF_INET, "50.1.1.1", &addr.addr.ip4);
+    p_route_32 = route_add (&addr, 32);
+
+    ASSERT_TRUE (p_route_24 != NULL);
+    ASSERT_TRUE (p_route_28 != NULL);
+    ASSERT_TRUE (p_route_32 != NULL);
+
+    ASSERT_TRUE (sai_fib_lpm_lookup (lpm, &addr, &nh));
+    EXPECT_EQ (32, nh.prefix_len);
+
+    route_remove (p_route_32);
+    ASSERT_TRUE (sai_fib_lpm_lookup (lpm, &addr, &nh));
+    EXPECT_EQ (28, nh.prefix_len);
+
+    route_remove (p_route_24);
+    ASSERT_TRUE (sai_fib_lpm_lookup (lpm, &addr, &nh));
+    EXPECT_EQ (28, nh.prefix_len);
+
+    route_remove (p_route_28);
+    ASSERT_TRUE (sai_fib_lpm_lookup (lpm, &addr, &nh));
+    EXPECT_EQ (0, nh.prefix_len);
+}
+
+static double lpm_test_elapsed_sec (const struct timespec *start)
+{
+    struct timespec end;
+
+    clock_gettime (CLOCK_MONOTONIC, &end);
+
+    return ((end.tv_sec - start->tv_sec) +
+            ((end.tv_nsec - start->tv_nsec) / 1e9));
+}
+
+/*
+ * Benchmark: update cost of the LPM table and of the route tree for the
+ * same prefixes, and lookup rate of both.
+ */
+TEST_F (saiL3LpmTest, benchmark)
+{
+    static const unsigned int prefix_count = 100000;
+    static const unsigned int lookup_count = 1000000;
+    std::vector<sai_ip_address_t> prefixes (prefix_count);
+    std::vector<uint_t>           prefix_lens (prefix_count);
+    std::vector<sai_ip_address_t> addrs (lookup_count);
+    sai_fib_lpm_stats_t stats;
+    sai_fib_lpm_nh_t    nh;
+    struct timespec     start;
+    double              sec;
+    unsigned int        idx;
+    unsigned int        hits = 0;
+
+    for (idx = 0; idx < prefix_count; idx++) {
+        random_prefix (SAI_IP_ADDR_FAMILY_IPV4, &prefixes [idx],
+                       &prefix_lens [idx]);
+    }
+
+    for (idx = 0; idx < lookup_count; idx++) {
+        random_addr (SAI_IP_ADDR_FAMILY_IPV4, &addrs [idx]);
+    }
+
+    clock_gettime (CLOCK_MONOTONIC, &start);
+
+    for (idx = 0; idx < prefix_count; idx++) {
+        route_add (&prefixes [idx], prefix_lens [idx]);
+    }
+
+    sec = lpm_test_elapsed_sec (&start);
+
+    sai_fib_lpm_stats_get (lpm, &stats);
+
+    printf ("LPM add: %u prefixes (%u unique) in %.3f sec, %.2f usec/prefix "
+            "(tree + LPM), LPM memory %lu bytes\r\n", prefix_count,
+            (unsigned int) routes.size (), sec,
+            (sec * 1e6) / prefix_count, (unsigned long) stats.mem_bytes);
+
+    clock_gettime (CLOCK_MONOTONIC, &start);
+
+    for (idx = 0; idx < lookup_count; idx++) {
+        if (sai_fib_lpm_lookup (lpm, &addrs [idx], &nh)) {
+            hits++;
+        }
+    }
+
+    sec = lpm_test_elapsed_sec (&start);
+
+    printf ("LPM lookup: %.0f lookups/sec (%u hits)\r\n",
+            lookup_count / sec, hits);
+
+    hits = 0;
+    clock_gettime (CLOCK_MONOTONIC, &start);
+
+    for (idx = 0; idx < lookup_count; idx++) {
+        if (std_radix_getbest (tree, (uint8_t *) &addrs [idx],
+                               LPM_TEST_KEY_BITS) != NULL) {
+            hits++;
+        }
+    }
+
+    sec = lpm_test_elapsed_sec (&start);
+
+    printf ("Radix lookup: %.0f lookups/sec (%u hits)\r\n",
+            lookup_count / sec, hits);
+
+    idx = routes.size ();
+    clock_gettime (CLOCK_MONOTONIC, &start);
+
+    while (!routes.empty ()) {
+        route_remove (routes.back ());
+    }
+
+    sec = lpm_test_elapsed_sec (&start);
+
+    printf ("LPM remove: %u prefixes in %.3f sec, %.2f usec/prefix "
+            "(tree + LPM)\r\n", idx, sec, (idx != 0) ? ((sec * 1e6) / idx) : 0);
+}
@@ -24,12 +24,14 @@
 #include "gtest/gtest.h"
 
 #include "sai_l3_unit_test_utils.h"
+#include "sai_bulk_unit_test_utils.h"
 
 extern "C" {
 #include "sai.h"
 #include "saistatus.h"
 #include "saitypes.h"
 #include "saifdb.h"
+#include "sai_l3_api_utils.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -941,3 +943,128 @@ int main (int argc, char **argv)
 
     return RUN_ALL_TESTS ();
 }
+
+/*
+ * Validates bulk Next Hop and Neighbor creation and removal on a Port router
+ * interface, with an invalid entry in the middle of the batch in both the
+ * error modes.
+ */
+TEST_F (saiL3NeighborTest, bulk_create_and_remove_on_port_rif)
+{
+    static const unsigned int bulk_count = 8;
+    static const unsigned int bad_index = bulk_count / 2;
+    sai_status_t              status;
+    sai_ip_addr_family_t      ip_af = SAI_IP_ADDR_FAMILY_IPV4;
+    const char               *p_mac_str = "00:d1:d2:d3:d4:d5";
+    char                      ip_str [bulk_count][INET_ADDRSTRLEN];
+    sai_neighbor_entry_t      neighbor_entry [bulk_count];
+    sai_attribute_t           nbr_attr;
+    sai_attribute_t           nh_attr_list [bulk_count][default_nh_attr_count];
+    const sai_attribute_t    *attr_list [bulk_count];
+    uint32_t                  attr_count [bulk_count];
+    sai_object_id_t           nh_id [bulk_count];
+    sai_status_t              statuses [bulk_count];
+    unsigned int              index;
+
+    memset (&nbr_attr, 0, sizeof (nbr_attr));
+    nbr_attr.id = SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS;
+    sai_test_router_mac_str_to_bytes_get (p_mac_str, nbr_attr.value.mac);
+
+    memset (neighbor_entry, 0, sizeof (neighbor_entry));
+    memset (nh_attr_list, 0, sizeof (nh_attr_list));
+
+    for (index = 0; index < bulk_count; index++) {
+        snprintf (ip_str [index], INET_ADDRSTRLEN, "12.0.0.%u", index + 1);
+
+        neighbor_entry [index].switch_id = switch_id;
+        neighbor_entry [index].rif_id = port_rif_id;
+        neighbor_entry [index].ip_address.addr_family = ip_af;
+        inet_pton (AF_INET, ip_str [index],
+                   (void *) &neighbor_entry [index].ip_address.addr.ip4);
+
+        nh_attr_list [index][0].id = SAI_NEXT_HOP_ATTR_TYPE;
+        nh_attr_list [index][0].value.s32 = SAI_NEXT_HOP_TYPE_IP;
+        nh_attr_list [index][1].id = SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID;
+        nh_attr_list [index][1].value.oid = port_rif_id;
+        nh_attr_list [index][2].id = SAI_NEXT_HOP_ATTR_IP;
+        nh_attr_list [index][2].value.ipaddr = neighbor_entry [index].ip_address;
+
+        attr_list [index] = nh_attr_list [index];
+        attr_count [index] = default_nh_attr_count;
+    }
+
+    /* Next Hops on the neighbor IP addresses, before the neighbors */
+    status = sai_fib_next_hop_bulk_create (switch_id, bulk_count, attr_count,
+                                           attr_list,
+                                           SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                           nh_id, statuses);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, status);
+
+    for (index = 0; index < bulk_count; index++) {
+        attr_list [index] = &nbr_attr;
+        attr_count [index] = default_neighbor_attr_count;
+    }
+
+    neighbor_entry [bad_index].rif_id = SAI_NULL_OBJECT_ID;
+
+    /* Stop on error leaves the rest of the batch not executed */
+    status = sai_fib_neighbor_bulk_create (bulk_count, neighbor_entry,
+                                           attr_count, attr_list,
+                                           SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                           statuses);
+
+    EXPECT_NE (SAI_STATUS_SUCCESS, status);
+
+    sai_test_bulk_stop_on_error_check (bulk_count, statuses, bad_index,
+                                       SAI_STATUS_INVALID_OBJECT_ID);
+
+    /* Ignore error creates the rest, the first half exists already */
+    status = sai_fib_neighbor_bulk_create (bulk_count, neighbor_entry,
+                                           attr_count, attr_list,
+                                           SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                           statuses);
+
+    EXPECT_NE (SAI_STATUS_SUCCESS, status);
+
+    sai_test_bulk_statuses_check (bulk_count, statuses, bad_index,
+                                  SAI_STATUS_ITEM_ALREADY_EXISTS,
+                                  SAI_STATUS_INVALID_OBJECT_ID,
+                                  SAI_STATUS_SUCCESS);
+
+    for (index = bad_index + 1; index < bulk_count; index++) {
+        sai_neighbor_verify_after_creation (port_rif_id, ip_af,
+                                            ip_str [index], p_mac_str,
+                                            default_pkt_action);
+    }
+
+    /* Removing a duplicate in the same batch removes the neighbor once */
+    neighbor_entry [bad_index] = neighbor_entry [0];
+
+    status = sai_fib_neighbor_bulk_remove (bulk_count, neighbor_entry,
+                                           SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                           statuses);
+
+    EXPECT_NE (SAI_STATUS_SUCCESS, status);
+
+    sai_test_bulk_ignore_error_check (bulk_count, statuses, bad_index,
+                                      SAI_STATUS_ITEM_NOT_FOUND);
+
+    for (index = 0; index < bulk_count; index++) {
+        if (index == bad_index) {
+            continue;
+        }
+
+        sai_neighbor_verify_after_removal (port_rif_id, ip_af, ip_str [index]);
+
+        /* Verify the next hop object still exists */
+        sai_verify_ip_nh_after_neighbor_removal (nh_id [index], port_rif_id,
+                                                 ip_af, ip_str [index]);
+    }
+
+    status = sai_fib_next_hop_bulk_remove (bulk_count, nh_id,
+                                           SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                           statuses);
+
+    ASSERT_EQ (SAI_STATUS_SUCCESS, status);
+}
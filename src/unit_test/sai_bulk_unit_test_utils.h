@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+* @file  sai_bulk_unit_test_utils.h
+*
+* @brief This file contains the helpers checking the object statuses
+*        returned by the SAI bulk APIs in their error modes.
+*
+*************************************************************************/
+
+#ifndef __SAI_BULK_UNIT_TEST_UTILS_H__
+#define __SAI_BULK_UNIT_TEST_UTILS_H__
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "saitypes.h"
+#include "saistatus.h"
+}
+
+/*
+ * Statuses of a bulk call with one failing object at bad_idx: the objects
+ * before it carry before_status, the failing one bad_status and the objects
+ * after it after_status.
+ */
+static inline void sai_test_bulk_statuses_check (uint32_t object_count,
+                                                 const sai_status_t *object_statuses,
+                                                 uint32_t bad_idx,
+                                                 sai_status_t before_status,
+                                                 sai_status_t bad_status,
+                                                 sai_status_t after_status)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < object_count; idx++) {
+        if (idx < bad_idx) {
+            EXPECT_EQ (before_status, object_statuses [idx]) << "object " << idx;
+        } else if (idx == bad_idx) {
+            EXPECT_EQ (bad_status, object_statuses [idx]) << "object " << idx;
+        } else {
+            EXPECT_EQ (after_status, object_statuses [idx]) << "object " << idx;
+        }
+    }
+}
+
+/*
+ * Stop on error: the objects before the failing one are processed, the
+ * objects after it are not executed.
+ */
+static inline void sai_test_bulk_stop_on_error_check (uint32_t object_count,
+                                                      const sai_status_t *object_statuses,
+                                                      uint32_t bad_idx,
+                                                      sai_status_t bad_status)
+{
+    sai_test_bulk_statuses_check (object_count, object_statuses, bad_idx,
+                                  SAI_STATUS_SUCCESS, bad_status,
+                                  SAI_STATUS_NOT_EXECUTED);
+}
+
+/*
+ * Ignore error: every object but the failing one is processed.
+ */
+static inline void sai_test_bulk_ignore_error_check (uint32_t object_count,
+                                                     const sai_status_t *object_statuses,
+                                                     uint32_t bad_idx,
+                                                     sai_status_t bad_status)
+{
+    sai_test_bulk_statuses_check (object_count, object_statuses, bad_idx,
+                                  SAI_STATUS_SUCCESS, bad_status,
+                                  SAI_STATUS_SUCCESS);
+}
+
+#endif /* __SAI_BULK_UNIT_TEST_UTILS_H__ */
@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <time.h>
 #include "gtest/gtest.h"
 #include "inttypes.h"
 
@@ -38,6 +39,7 @@ extern "C" {
 #include "sai_l2_unit_test_defs.h"
 #include "sai_fdb_main.h"
 #include "sai_fdb_unit_test.h"
+#include "sai_bulk_unit_test_utils.h"
 }
 
 #define MAX_FDB_NOTIFICATIONS 50
@@ -255,3 +257,296 @@ TEST_F(fdbInit, sai_fdb_port_change_notification_callback)
     ASSERT_EQ (SAI_STATUS_SUCCESS,
                sai_l2_deregister_fdb_entry(&fdb_entry));
 }
+
+#define SAI_FDB_BULK_TEST_COUNT 8
+#define SAI_FDB_BULK_PERF_COUNT 4096
+
+static inline void sai_set_test_bulk_entry(uint32_t index, sai_fdb_entry_t* fdb_entry)
+{
+    memset(fdb_entry,0, sizeof(sai_fdb_entry_t));
+    fdb_entry->mac_address[0] = 0x02;
+    fdb_entry->mac_address[3] = (uint8_t)(index >> 16);
+    fdb_entry->mac_address[4] = (uint8_t)(index >> 8);
+    fdb_entry->mac_address[5] = (uint8_t)index;
+    fdb_entry->bv_id = SAI_GTEST_VLAN_OBJ;
+}
+
+static inline void sai_set_test_bulk_attr(sai_attribute_t *attr_list,
+                                          sai_object_id_t bridge_port_id)
+{
+    memset(attr_list,0, sizeof(sai_attribute_t)*SAI_MAX_FDB_TEST_ATTRIBUTES);
+    attr_list[0].id = SAI_FDB_ENTRY_ATTR_TYPE;
+    attr_list[0].value.s32 = SAI_FDB_ENTRY_TYPE_STATIC;
+
+    attr_list[1].id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
+    attr_list[1].value.oid = bridge_port_id;
+
+    attr_list[2].id = SAI_FDB_ENTRY_ATTR_PACKET_ACTION;
+    attr_list[2].value.s32 = SAI_PACKET_ACTION_FORWARD;
+}
+
+static double sai_fdb_test_elapsed_sec(const struct timespec *start)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + ((now.tv_nsec - start->tv_nsec) / 1e9);
+}
+
+/*
+ * Bulk FDB create, set and remove with per entry statuses, an invalid
+ * vlan in the middle of the batch in both error modes.
+ */
+TEST_F(fdbInit, sai_fdb_bulk_create_set_remove)
+{
+    sai_fdb_entry_t fdb_entry[SAI_FDB_BULK_TEST_COUNT];
+    sai_attribute_t attr_list[SAI_MAX_FDB_TEST_ATTRIBUTES];
+    const sai_attribute_t *attr_list_ptr[SAI_FDB_BULK_TEST_COUNT];
+    uint32_t attr_count[SAI_FDB_BULK_TEST_COUNT];
+    sai_attribute_t set_attr[SAI_FDB_BULK_TEST_COUNT];
+    sai_status_t statuses[SAI_FDB_BULK_TEST_COUNT];
+    sai_attribute_t get_attr;
+    const uint32_t bad_idx = SAI_FDB_BULK_TEST_COUNT/2;
+    uint32_t idx;
+
+    sai_set_test_bulk_attr(attr_list, bridge_port_id_1);
+    for(idx = 0; idx < SAI_FDB_BULK_TEST_COUNT; idx++) {
+        sai_set_test_bulk_entry(idx, &fdb_entry[idx]);
+        attr_count[idx] = SAI_MAX_FDB_TEST_ATTRIBUTES;
+        attr_list_ptr[idx] = attr_list;
+    }
+    fdb_entry[bad_idx].bv_id = SAI_NULL_OBJECT_ID;
+
+    /* Stop on error leaves the rest of the batch not executed */
+    EXPECT_EQ(SAI_STATUS_FAILURE,
+              sai_l2_bulk_create_fdb_entry(SAI_FDB_BULK_TEST_COUNT, fdb_entry,
+                                           attr_count, attr_list_ptr,
+                                           SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                           statuses));
+    sai_test_bulk_stop_on_error_check(SAI_FDB_BULK_TEST_COUNT, statuses, bad_idx,
+                                      SAI_STATUS_INVALID_OBJECT_ID);
+
+    EXPECT_EQ(SAI_STATUS_FAILURE,
+              sai_l2_bulk_remove_fdb_entry(SAI_FDB_BULK_TEST_COUNT, fdb_entry,
+                                           SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                           statuses));
+    sai_test_bulk_statuses_check(SAI_FDB_BULK_TEST_COUNT, statuses, bad_idx,
+                                 SAI_STATUS_SUCCESS, SAI_STATUS_INVALID_OBJECT_ID,
+                                 SAI_STATUS_ADDR_NOT_FOUND);
+
+    /* Ignore error creates every valid entry */
+    EXPECT_EQ(SAI_STATUS_FAILURE,
+              sai_l2_bulk_create_fdb_entry(SAI_FDB_BULK_TEST_COUNT, fdb_entry,
+                                           attr_count, attr_list_ptr,
+                                           SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                           statuses));
+    sai_test_bulk_ignore_error_check(SAI_FDB_BULK_TEST_COUNT, statuses, bad_idx,
+                                     SAI_STATUS_INVALID_OBJECT_ID);
+
+    memset(set_attr, 0, sizeof(set_attr));
+    for(idx = 0; idx < SAI_FDB_BULK_TEST_COUNT; idx++) {
+        set_attr[idx].id = SAI_FDB_ENTRY_ATTR_PACKET_ACTION;
+        set_attr[idx].value.s32 = SAI_PACKET_ACTION_DROP;
+    }
+
+    EXPECT_EQ(SAI_STATUS_FAILURE,
+              sai_l2_bulk_set_fdb_entry_attribute(SAI_FDB_BULK_TEST_COUNT, fdb_entry,
+                                                  set_attr,
+                                                  SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                                  statuses));
+    sai_test_bulk_ignore_error_check(SAI_FDB_BULK_TEST_COUNT, statuses, bad_idx,
+                                     SAI_STATUS_INVALID_OBJECT_ID);
+
+    for(idx = 0; idx < SAI_FDB_BULK_TEST_COUNT; idx++) {
+        if(idx == bad_idx) {
+            continue;
+        }
+
+        memset(&get_attr,0, sizeof(get_attr));
+        get_attr.id = SAI_FDB_ENTRY_ATTR_PACKET_ACTION;
+        EXPECT_EQ(SAI_STATUS_SUCCESS,
+                  sai_fdb_api_table->get_fdb_entry_attribute(
+                                     (const sai_fdb_entry_t*)&fdb_entry[idx],
+                                     1, &get_attr));
+        EXPECT_EQ(SAI_PACKET_ACTION_DROP, get_attr.value.s32);
+    }
+
+    /* Removing a duplicate in the same batch removes the entry once */
+    fdb_entry[bad_idx] = fdb_entry[0];
+    EXPECT_EQ(SAI_STATUS_FAILURE,
+              sai_l2_bulk_remove_fdb_entry(SAI_FDB_BULK_TEST_COUNT, fdb_entry,
+                                           SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR,
+                                           statuses));
+    sai_test_bulk_ignore_error_check(SAI_FDB_BULK_TEST_COUNT, statuses, bad_idx,
+                                     SAI_STATUS_ADDR_NOT_FOUND);
+
+    memset(&get_attr,0, sizeof(get_attr));
+    get_attr.id = SAI_FDB_ENTRY_ATTR_TYPE;
+    EXPECT_EQ(SAI_STATUS_ADDR_NOT_FOUND,
+              sai_fdb_api_table->get_fdb_entry_attribute(
+                                 (const sai_fdb_entry_t*)&fdb_entry[0],
+                                 1, &get_attr));
+}
+
+/*
+ * A duplicate in a stop on error batch stops it before the NPU call, the
+ * entries after it keep their cache node and DB row.
+ */
+TEST_F(fdbInit, sai_fdb_bulk_duplicate_stop_on_error)
+{
+    sai_fdb_entry_t fdb_entry[SAI_FDB_BULK_TEST_COUNT];
+    sai_attribute_t attr_list[SAI_MAX_FDB_TEST_ATTRIBUTES];
+    const sai_attribute_t *attr_list_ptr[SAI_FDB_BULK_TEST_COUNT];
+    uint32_t attr_count[SAI_FDB_BULK_TEST_COUNT];
+    sai_attribute_t set_attr[SAI_FDB_BULK_TEST_COUNT];
+    sai_status_t statuses[SAI_FDB_BULK_TEST_COUNT];
+    sai_attribute_t get_attr;
+    const uint32_t dup_idx = SAI_FDB_BULK_TEST_COUNT/2;
+    uint32_t idx;
+
+    sai_set_test_bulk_attr(attr_list, bridge_port_id_1);
+    for(idx = 0; idx < SAI_FDB_BULK_TEST_COUNT; idx++) {
+        sai_set_test_bulk_entry(idx, &fdb_entry[idx]);
+        attr_count[idx] = SAI_MAX_FDB_TEST_ATTRIBUTES;
+        attr_list_ptr[idx] = attr_list;
+    }
+
+    ASSERT_EQ(SAI_STATUS_SUCCESS,
+              sai_l2_bulk_create_fdb_entry(SAI_FDB_BULK_TEST_COUNT, fdb_entry,
+                                           attr_count, attr_list_ptr,
+                                           SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                           statuses));
+
+    /* Set the entries to drop, with entry 0 repeated in the middle */
+    fdb_entry[dup_idx] = fdb_entry[0];
+    memset(set_attr, 0, sizeof(set_attr));
+    for(idx = 0; idx < SAI_FDB_BULK_TEST_COUNT; idx++) {
+        set_attr[idx].id = SAI_FDB_ENTRY_ATTR_PACKET_ACTION;
+        set_attr[idx].value.s32 = SAI_PACKET_ACTION_DROP;
+    }
+
+    EXPECT_EQ(SAI_STATUS_FAILURE,
+              sai_l2_bulk_set_fdb_entry_attribute(SAI_FDB_BULK_TEST_COUNT, fdb_entry,
+                                                  set_attr,
+                                                  SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                                  statuses));
+    sai_test_bulk_stop_on_error_check(SAI_FDB_BULK_TEST_COUNT, statuses, dup_idx,
+                                      SAI_STATUS_INVALID_PARAMETER);
+
+    for(idx = 0; idx < SAI_FDB_BULK_TEST_COUNT; idx++) {
+        if(idx == dup_idx) {
+            continue;
+        }
+
+        memset(&get_attr,0, sizeof(get_attr));
+        get_attr.id = SAI_FDB_ENTRY_ATTR_PACKET_ACTION;
+        EXPECT_EQ(SAI_STATUS_SUCCESS,
+                  sai_fdb_api_table->get_fdb_entry_attribute(
+                                     (const sai_fdb_entry_t*)&fdb_entry[idx],
+                                     1, &get_attr));
+        EXPECT_EQ((idx < dup_idx) ? SAI_PACKET_ACTION_DROP : SAI_PACKET_ACTION_FORWARD,
+                  get_attr.value.s32);
+    }
+
+    EXPECT_EQ(SAI_STATUS_FAILURE,
+              sai_l2_bulk_remove_fdb_entry(SAI_FDB_BULK_TEST_COUNT, fdb_entry,
+                                           SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                           statuses));
+    sai_test_bulk_stop_on_error_check(SAI_FDB_BULK_TEST_COUNT, statuses, dup_idx,
+                                      SAI_STATUS_ADDR_NOT_FOUND);
+
+    for(idx = dup_idx + 1; idx < SAI_FDB_BULK_TEST_COUNT; idx++) {
+        memset(&get_attr,0, sizeof(get_attr));
+        get_attr.id = SAI_FDB_ENTRY_ATTR_TYPE;
+        EXPECT_EQ(SAI_STATUS_SUCCESS,
+                  sai_fdb_api_table->get_fdb_entry_attribute(
+                                     (const sai_fdb_entry_t*)&fdb_entry[idx],
+                                     1, &get_attr));
+
+        /* The DB row is still there, a create of the same key fails */
+        EXPECT_NE(SAI_STATUS_SUCCESS,
+                  sai_fdb_api_table->create_fdb_entry(
+                                     (const sai_fdb_entry_t*)&fdb_entry[idx],
+                                     SAI_MAX_FDB_TEST_ATTRIBUTES, attr_list));
+    }
+
+    EXPECT_EQ(SAI_STATUS_SUCCESS,
+              sai_l2_bulk_remove_fdb_entry(SAI_FDB_BULK_TEST_COUNT - dup_idx - 1,
+                                           &fdb_entry[dup_idx + 1],
+                                           SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                           statuses));
+}
+
+/*
+ * Create and remove rate of static MACs, per entry calls against the
+ * bulk APIs.
+ */
+TEST_F(fdbInit, sai_fdb_bulk_throughput)
+{
+    sai_fdb_entry_t *fdb_entry = NULL;
+    sai_status_t *statuses = NULL;
+    uint32_t *attr_count = NULL;
+    const sai_attribute_t **attr_list_ptr = NULL;
+    sai_attribute_t attr_list[SAI_MAX_FDB_TEST_ATTRIBUTES];
+    struct timespec start;
+    double loop_create_sec, loop_remove_sec, bulk_create_sec, bulk_remove_sec;
+    uint32_t idx;
+
+    fdb_entry = (sai_fdb_entry_t *)calloc(SAI_FDB_BULK_PERF_COUNT, sizeof(*fdb_entry));
+    statuses = (sai_status_t *)calloc(SAI_FDB_BULK_PERF_COUNT, sizeof(*statuses));
+    attr_count = (uint32_t *)calloc(SAI_FDB_BULK_PERF_COUNT, sizeof(*attr_count));
+    attr_list_ptr = (const sai_attribute_t **)calloc(SAI_FDB_BULK_PERF_COUNT,
+                                                     sizeof(*attr_list_ptr));
+    ASSERT_TRUE((fdb_entry != NULL) && (statuses != NULL) &&
+                (attr_count != NULL) && (attr_list_ptr != NULL));
+
+    sai_set_test_bulk_attr(attr_list, bridge_port_id_1);
+    for(idx = 0; idx < SAI_FDB_BULK_PERF_COUNT; idx++) {
+        sai_set_test_bulk_entry(idx, &fdb_entry[idx]);
+        attr_count[idx] = SAI_MAX_FDB_TEST_ATTRIBUTES;
+        attr_list_ptr[idx] = attr_list;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(idx = 0; idx < SAI_FDB_BULK_PERF_COUNT; idx++) {
+        EXPECT_EQ(SAI_STATUS_SUCCESS,
+                  sai_fdb_api_table->create_fdb_entry(&fdb_entry[idx],
+                                                      SAI_MAX_FDB_TEST_ATTRIBUTES,
+                                                      attr_list));
+    }
+    loop_create_sec = sai_fdb_test_elapsed_sec(&start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(idx = 0; idx < SAI_FDB_BULK_PERF_COUNT; idx++) {
+        EXPECT_EQ(SAI_STATUS_SUCCESS,
+                  sai_fdb_api_table->remove_fdb_entry(&fdb_entry[idx]));
+    }
+    loop_remove_sec = sai_fdb_test_elapsed_sec(&start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    EXPECT_EQ(SAI_STATUS_SUCCESS,
+              sai_l2_bulk_create_fdb_entry(SAI_FDB_BULK_PERF_COUNT, fdb_entry,
+                                           attr_count, attr_list_ptr,
+                                           SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                           statuses));
+    bulk_create_sec = sai_fdb_test_elapsed_sec(&start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    EXPECT_EQ(SAI_STATUS_SUCCESS,
+              sai_l2_bulk_remove_fdb_entry(SAI_FDB_BULK_PERF_COUNT, fdb_entry,
+                                           SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+                                           statuses));
+    bulk_remove_sec = sai_fdb_test_elapsed_sec(&start);
+
+    printf("FDB create %u entries: per entry %.0f/sec, bulk %.0f/sec\r\n",
+           SAI_FDB_BULK_PERF_COUNT, SAI_FDB_BULK_PERF_COUNT/loop_create_sec,
+           SAI_FDB_BULK_PERF_COUNT/bulk_create_sec);
+    printf("FDB remove %u entries: per entry %.0f/sec, bulk %.0f/sec\r\n",
+           SAI_FDB_BULK_PERF_COUNT, SAI_FDB_BULK_PERF_COUNT/loop_remove_sec,
+           SAI_FDB_BULK_PERF_COUNT/bulk_remove_sec);
+
+    free(fdb_entry);
+    free(statuses);
+    free(attr_count);
+    free(attr_list_ptr);
+}
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+
+/*
+ * sai_l2mc_unit_test_internal.cpp
+ *
+ * Delivery of multicast traffic through the kernel bridge MDB programmed by
+ * the VM L2MC handlers. Each case runs in a child process with a network
+ * namespace of its own, holding a VLAN bridge and veth pairs as ports.
+ */
+
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <sched.h>
+#include "gtest/gtest.h"
+#include <inttypes.h>
+
+extern "C" {
+#include "sai.h"
+#include "saitypes.h"
+#include "sai_vm_mcast.h"
+#include <errno.h>
+#include <net/if.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+}
+
+/* Exit code of a child that cannot build its namespace */
+#define SAI_L2MC_UT_SKIP       (77)
+
+#define SAI_L2MC_UT_VLAN       (10)
+#define SAI_L2MC_UT_BRIDGE     "br10"
+#define SAI_L2MC_UT_PORTS      (3)
+#define SAI_L2MC_UT_FRAMES     (8)
+#define SAI_L2MC_UT_GROUP      "239.1.1.1"
+#define SAI_L2MC_UT_STALE_GRP  "239.1.1.2"
+
+/*
+ * Bridge br10 with ports p1-p3, each a veth whose peer p<n>x sends and
+ * receives the test traffic. The bridge is the querier with a short
+ * response interval: the kernel floods groups until a querier is known.
+ */
+static const char *sai_l2mc_ut_setup_cmd =
+    "ip link add " SAI_L2MC_UT_BRIDGE " type bridge && "
+    "for i in 1 2 3; do "
+    "ip link add p$i type veth peer name p${i}x && "
+    "ip link set p$i master " SAI_L2MC_UT_BRIDGE " && "
+    "ip link set p$i up && ip link set p${i}x up || exit 1; done && "
+    "ip link set " SAI_L2MC_UT_BRIDGE " type bridge mcast_snooping 1 "
+    "mcast_query_response_interval 10 && "
+    "ip link set " SAI_L2MC_UT_BRIDGE " type bridge mcast_querier 1 && "
+    "ip link set " SAI_L2MC_UT_BRIDGE " up && "
+    "bridge mdb add dev " SAI_L2MC_UT_BRIDGE " port p3 grp "
+    SAI_L2MC_UT_STALE_GRP " permanent && sleep 0.5";
+
+static void sai_l2mc_ut_ip4_get (const char *addr_str, sai_ip_address_t *p_addr)
+{
+    memset (p_addr, 0, sizeof (*p_addr));
+    p_addr->addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    inet_pton (AF_INET, addr_str, &p_addr->addr.ip4);
+}
+
+static uint16_t sai_l2mc_ut_csum (const uint8_t *p_buf, size_t len)
+{
+    uint32_t sum = 0;
+    size_t   idx;
+
+    for (idx = 0; idx + 1 < len; idx += 2) {
+        sum += (p_buf [idx] << 8) | p_buf [idx + 1];
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+
+    return (uint16_t) ~sum;
+}
+
+/* UDP frame to a group, mapped to its multicast MAC */
+static size_t sai_l2mc_ut_frame_fill (uint8_t *frame, const char *grp_str)
+{
+    static const uint8_t src_mac [] = {0x02, 0xbe, 0x00, 0x00, 0x00, 0x01};
+    uint8_t             *ip = frame + ETH_HLEN;
+    uint8_t             *udp = ip + 20;
+    uint32_t             grp = 0;
+    uint32_t             src = htonl (0x0a000001);
+    uint16_t             csum;
+
+    inet_pton (AF_INET, grp_str, &grp);
+
+    memset (frame, 0, ETH_HLEN + 28);
+    frame [0] = 0x01;
+    frame [1] = 0x00;
+    frame [2] = 0x5e;
+    frame [3] = ((uint8_t *) &grp) [1] & 0x7f;
+    frame [4] = ((uint8_t *) &grp) [2];
+    frame [5] = ((uint8_t *) &grp) [3];
+    memcpy (frame + ETH_ALEN, src_mac, ETH_ALEN);
+    frame [12] = 0x08;
+    frame [13] = 0x00;
+
+    ip [0] = 0x45;
+    ip [3] = 28;
+    ip [8] = 1;
+    ip [9] = IPPROTO_UDP;
+    memcpy (ip + 12, &src, sizeof (src));
+    memcpy (ip + 16, &grp, sizeof (grp));
+    csum = htons (sai_l2mc_ut_csum (ip, 20));
+    memcpy (ip + 10, &csum, sizeof (csum));
+
+    udp [0] = 0x03;
+    udp [1] = 0xe8;
+    udp [2] = 0x07;
+    udp [3] = 0xd0;
+    udp [5] = 8;
+
+    return ETH_HLEN + 28;
+}
+
+static int sai_l2mc_ut_sock_open (const char *if_name)
+{
+    struct sockaddr_ll addr;
+    int                sock = socket (AF_PACKET, SOCK_RAW | SOCK_NONBLOCK, htons (ETH_P_IP));
+
+    if (sock < 0) {
+        return -1;
+    }
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons (ETH_P_IP);
+    addr.sll_ifindex = (int) if_nametoindex (if_name);
+
+    if (bind (sock, (struct sockaddr *) &addr, sizeof (addr)) != 0) {
+        close (sock);
+        return -1;
+    }
+
+    return sock;
+}
+
+/* Frames to the group received on the peer of each port */
+static bool sai_l2mc_ut_traffic_run (const char *grp_str,
+                                     uint32_t rx_count [SAI_L2MC_UT_PORTS])
+{
+    uint8_t  frame [ETH_FRAME_LEN];
+    uint8_t  buf [ETH_FRAME_LEN];
+    char     if_name [IF_NAMESIZE];
+    int      sock [SAI_L2MC_UT_PORTS];
+    uint32_t grp = 0;
+    size_t   len = sai_l2mc_ut_frame_fill (frame, grp_str);
+    ssize_t  rx_len;
+    bool     ok = true;
+    int      port;
+    int      idx;
+
+    inet_pton (AF_INET, grp_str, &grp);
+
+    for (port = 0; port < SAI_L2MC_UT_PORTS; port++) {
+        snprintf (if_name, sizeof (if_name), "p%dx", port + 1);
+        sock [port] = sai_l2mc_ut_sock_open (if_name);
+        rx_count [port] = 0;
+        ok = ok && (sock [port] >= 0);
+    }
+
+    for (idx = 0; ok && (idx < SAI_L2MC_UT_FRAMES); idx++) {
+        ok = (send (sock [0], frame, len, 0) == (ssize_t) len);
+    }
+
+    usleep (200000);
+
+    for (port = 1; port < SAI_L2MC_UT_PORTS; port++) {
+        while ((sock [port] >= 0) &&
+               ((rx_len = recv (sock [port], buf, sizeof (buf), 0)) > 0)) {
+            if ((rx_len >= (ssize_t) len) &&
+                (memcmp (buf + ETH_HLEN + 16, &grp, sizeof (grp)) == 0)) {
+                rx_count [port]++;
+            }
+        }
+    }
+
+    for (port = 0; port < SAI_L2MC_UT_PORTS; port++) {
+        if (sock [port] >= 0) {
+            close (sock [port]);
+        }
+    }
+
+    return ok;
+}
+
+/*
+ * Child side of the test, the return value is the exit code: 0 on success,
+ * the number of the failed step otherwise.
+ */
+static int sai_l2mc_ut_mdb_delivery (void)
+{
+    sai_ip_address_t grp_addr;
+    uint32_t         rx_count [SAI_L2MC_UT_PORTS];
+    int              p2 = 0;
+    int              p3 = 0;
+
+    if (unshare (CLONE_NEWNET) != 0) {
+        printf ("Network namespace unavailable, errno %d.\r\n", errno);
+        return SAI_L2MC_UT_SKIP;
+    }
+
+    if (system (sai_l2mc_ut_setup_cmd) != 0) {
+        printf ("Bridge setup failed in the test namespace.\r\n");
+        return SAI_L2MC_UT_SKIP;
+    }
+
+    p2 = (int) if_nametoindex ("p2");
+    p3 = (int) if_nametoindex ("p3");
+
+    /* Reconcile removes the permanent entry of the previous "run" */
+    if (sai_vm_mdb_init () != SAI_STATUS_SUCCESS) {
+        return 1;
+    }
+
+    if (system ("bridge mdb show dev " SAI_L2MC_UT_BRIDGE
+                " | grep -q " SAI_L2MC_UT_STALE_GRP) == 0) {
+        return 2;
+    }
+
+    sai_l2mc_ut_ip4_get (SAI_L2MC_UT_GROUP, &grp_addr);
+
+    /* Coalesced: p3 joins and leaves before the flush and is never added */
+    if ((sai_vm_mdb_entry_update (SAI_L2MC_UT_VLAN, p2, &grp_addr, NULL, true)
+         != SAI_STATUS_SUCCESS) ||
+        (sai_vm_mdb_entry_update (SAI_L2MC_UT_VLAN, p3, &grp_addr, NULL, true)
+         != SAI_STATUS_SUCCESS) ||
+        (sai_vm_mdb_entry_update (SAI_L2MC_UT_VLAN, p3, &grp_addr, NULL, false)
+         != SAI_STATUS_SUCCESS)) {
+        return 3;
+    }
+
+    if (sai_vm_mdb_flush () != SAI_STATUS_SUCCESS) {
+        return 4;
+    }
+
+    if (!sai_l2mc_ut_traffic_run (SAI_L2MC_UT_GROUP, rx_count)) {
+        return 5;
+    }
+
+    printf ("Group " SAI_L2MC_UT_GROUP " frames on p2: %u, p3: %u.\r\n",
+            rx_count [1], rx_count [2]);
+
+    if ((rx_count [1] != SAI_L2MC_UT_FRAMES) || (rx_count [2] != 0)) {
+        return 6;
+    }
+
+    /* Once the last member leaves, the group is flooded again */
+    if ((sai_vm_mdb_entry_update (SAI_L2MC_UT_VLAN, p2, &grp_addr, NULL, false)
+         != SAI_STATUS_SUCCESS) || (sai_vm_mdb_flush () != SAI_STATUS_SUCCESS)) {
+        return 7;
+    }
+
+    if (system ("bridge mdb show dev " SAI_L2MC_UT_BRIDGE
+                " | grep -q " SAI_L2MC_UT_GROUP) == 0) {
+        return 8;
+    }
+
+    return 0;
+}
+
+TEST(saiL2mcInternalTest, mdb_delivery_in_namespace)
+{
+    pid_t pid = fork ();
+    int   status = 0;
+
+    ASSERT_TRUE (pid >= 0);
+
+    if (pid == 0) {
+        _exit (sai_l2mc_ut_mdb_delivery ());
+    }
+
+    ASSERT_EQ (pid, waitpid (pid, &status, 0));
+    ASSERT_TRUE (WIFEXITED (status));
+
+    if (WEXITSTATUS (status) == SAI_L2MC_UT_SKIP) {
+        printf ("Skipped, the test needs CAP_NET_ADMIN and iproute2.\r\n");
+        return;
+    }
+
+    EXPECT_EQ (0, WEXITSTATUS (status));
+}
@@ -20,6 +20,7 @@
 
 #include "gtest/gtest.h"
 #include "sai_stp_unit_test.h"
+#include "sai_bulk_unit_test_utils.h"
 
 extern "C" {
 #include "sai.h"
@@ -408,6 +409,91 @@ TEST_F(stpTest, stp_port_state)
             remove_stp(stp_id));
 }
 
+/*
+ * STP port bulk create and remove in both the error modes, with an invalid
+ * bridge port in the middle of the batch.
+ */
+TEST_F(stpTest, stp_port_bulk)
+{
+    static const uint32_t  bulk_count = 4;
+    static const uint32_t  bad_idx = 2;
+    sai_attribute_t        attr[bulk_count][SAI_STP_NO_OF_PORT_ATTRIB];
+    const sai_attribute_t *attr_list[bulk_count];
+    uint32_t               attr_count[bulk_count];
+    sai_object_id_t        stp_port_id[bulk_count];
+    sai_status_t           statuses[bulk_count];
+    sai_attribute_t        get_attr;
+    sai_object_id_t        stp_id = 0;
+    uint32_t               idx;
+
+    ASSERT_TRUE(sai_stp_bridge_port_id_get(bulk_count - 1) != 0);
+
+    EXPECT_EQ(SAI_STATUS_SUCCESS,p_sai_stp_api_tbl->
+            create_stp(&stp_id,0,0,&get_attr));
+
+    memset(attr, 0, sizeof(attr));
+
+    for(idx = 0; idx < bulk_count; idx++) {
+        attr[idx][0].id = SAI_STP_PORT_ATTR_STP;
+        attr[idx][0].value.oid = stp_id;
+        attr[idx][1].id = SAI_STP_PORT_ATTR_BRIDGE_PORT;
+        attr[idx][1].value.oid = sai_stp_bridge_port_id_get(idx);
+        attr[idx][2].id = SAI_STP_PORT_ATTR_STATE;
+        attr[idx][2].value.s32 = SAI_STP_PORT_STATE_BLOCKING;
+
+        attr_list[idx] = attr[idx];
+        attr_count[idx] = SAI_STP_NO_OF_PORT_ATTRIB;
+    }
+
+    attr[bad_idx][1].value.oid = sai_stp_invalid_port_id_get();
+
+    EXPECT_EQ(SAI_STATUS_FAILURE, p_sai_stp_api_tbl->
+            create_stp_ports(switch_id, bulk_count, attr_count, attr_list,
+                             SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, stp_port_id, statuses));
+
+    sai_test_bulk_stop_on_error_check(bulk_count, statuses, bad_idx,
+                                      SAI_STATUS_INVALID_ATTR_VALUE_0+SAI_STATUS_CODE(1));
+
+    EXPECT_EQ(SAI_STATUS_SUCCESS, p_sai_stp_api_tbl->
+            remove_stp_ports(bad_idx, stp_port_id,
+                             SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses));
+
+    EXPECT_EQ(SAI_STATUS_FAILURE, p_sai_stp_api_tbl->
+            create_stp_ports(switch_id, bulk_count, attr_count, attr_list,
+                             SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, stp_port_id, statuses));
+
+    sai_test_bulk_ignore_error_check(bulk_count, statuses, bad_idx,
+                                     SAI_STATUS_INVALID_ATTR_VALUE_0+SAI_STATUS_CODE(1));
+
+    for(idx = 0; idx < bulk_count; idx++) {
+        if(idx == bad_idx) {
+            EXPECT_EQ(SAI_NULL_OBJECT_ID, stp_port_id[idx]);
+            continue;
+        }
+
+        get_attr.id = SAI_STP_PORT_ATTR_STATE;
+        EXPECT_EQ(SAI_STATUS_SUCCESS, p_sai_stp_api_tbl->
+                get_stp_port_attribute(stp_port_id[idx],SAI_STP_NO_OF_ATTRIB,&get_attr));
+        EXPECT_EQ(SAI_STP_PORT_STATE_BLOCKING, get_attr.value.s32);
+    }
+
+    EXPECT_EQ(SAI_STATUS_OBJECT_IN_USE, p_sai_stp_api_tbl->
+            remove_stp(stp_id));
+
+    /* Duplicate in the slot of the failed entry */
+    stp_port_id[bad_idx] = stp_port_id[0];
+
+    EXPECT_EQ(SAI_STATUS_FAILURE, p_sai_stp_api_tbl->
+            remove_stp_ports(bulk_count, stp_port_id,
+                             SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses));
+
+    sai_test_bulk_ignore_error_check(bulk_count, statuses, bad_idx,
+                                     SAI_STATUS_ITEM_NOT_FOUND);
+
+    EXPECT_EQ(SAI_STATUS_SUCCESS, p_sai_stp_api_tbl->
+            remove_stp(stp_id));
+}
+
 TEST_F(stpTest, delet_vlan)
 {
     sai_attribute_t attr[SAI_STP_NO_OF_ATTRIB] = {0};
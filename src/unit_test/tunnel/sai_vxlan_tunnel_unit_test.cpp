@@ -661,6 +661,51 @@ TEST_F (saiTunnelTest, create_and_remove_vxlan_tunnel_object)
     sai_test_vxlan_1d_bridge_remove (bridge_id, true);
 }
 
+TEST_F (saiTunnelTest, get_and_clear_vxlan_tunnel_stats)
+{
+    sai_object_id_t    bridge_id             = SAI_NULL_OBJECT_ID;
+    sai_object_id_t    encap_map_id          = SAI_NULL_OBJECT_ID;
+    sai_object_id_t    decap_map_id          = SAI_NULL_OBJECT_ID;
+    sai_object_id_t    encap_map_entry_id    = SAI_NULL_OBJECT_ID;
+    sai_object_id_t    decap_map_entry_id    = SAI_NULL_OBJECT_ID;
+    sai_object_id_t    tunnel_id             = SAI_NULL_OBJECT_ID;
+    const char         *tunnel_sip           = "10.0.0.1";
+    sai_uint32_t       vnid                  = 100;
+
+    sai_test_vxlan_1d_bridge_create(&bridge_id, true);
+
+    sai_test_vxlan_encap_tunnel_map_create(&encap_map_id, true);
+    sai_test_vxlan_decap_tunnel_map_create(&decap_map_id, true);
+
+    sai_test_vxlan_encap_map_entry_create(&encap_map_entry_id, encap_map_id,
+                                          bridge_id, vnid, true);
+    sai_test_vxlan_decap_map_entry_create(&decap_map_entry_id, decap_map_id,
+                                          vnid, bridge_id, true);
+
+    sai_test_vxlan_tunnel_create(&tunnel_id, dflt_underlay_rif_id, dflt_overlay_rif_id,
+                                 tunnel_sip, encap_map_id, decap_map_id, true);
+
+    /*Counters are read from the tunnel device*/
+    EXPECT_EQ (SAI_STATUS_SUCCESS,
+               sai_test_tunnel_stats_get (tunnel_id, 4,
+                                          SAI_TUNNEL_STAT_IN_OCTETS,
+                                          SAI_TUNNEL_STAT_IN_PACKETS,
+                                          SAI_TUNNEL_STAT_OUT_OCTETS,
+                                          SAI_TUNNEL_STAT_OUT_PACKETS));
+
+    EXPECT_EQ (SAI_STATUS_SUCCESS,
+               sai_test_tunnel_stats_clear (tunnel_id, 2,
+                                            SAI_TUNNEL_STAT_IN_PACKETS,
+                                            SAI_TUNNEL_STAT_OUT_PACKETS));
+
+    sai_test_vxlan_tunnel_remove (tunnel_id, true);
+    sai_test_vxlan_tunnel_map_entry_remove (decap_map_entry_id, true);
+    sai_test_vxlan_tunnel_map_entry_remove (encap_map_entry_id, true);
+    sai_test_vxlan_tunnel_map_remove (decap_map_id, true);
+    sai_test_vxlan_tunnel_map_remove (encap_map_id, true);
+    sai_test_vxlan_1d_bridge_remove (bridge_id, true);
+}
+
 TEST_F (saiTunnelTest, create_and_remove_vxlan_tunnel_term_object)
 {
     sai_object_id_t    bridge_id             = SAI_NULL_OBJECT_ID;
@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2018 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * @file sai_vm_rtnl.c
+ *
+ * @brief Function implementations for rtnetlink requests issued in the
+ *        virtual port namespace and in the switch namespace.
+ *************************************************************************/
+#include "sai_vm_rtnl.h"
+#include "sai_vm_vport.h"
+#include "sai_switch_utils.h"
+#include "std_socket_tools.h"
+#include "std_file_utils.h"
+
+#include <sys/socket.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t sai_vm_rtnl_seq = 0;
+
+static inline uint32_t sai_vm_rtnl_next_seq (void)
+{
+    return __sync_add_and_fetch (&sai_vm_rtnl_seq, 1);
+}
+
+/* Bind a freshly created rtnetlink socket, closing it on failure */
+static int sai_vm_rtnl_sock_setup (int sock, uint32_t groups)
+{
+    struct sockaddr_nl addr;
+
+    memset (&addr, 0, sizeof (addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = groups;
+
+    if (bind (sock, (struct sockaddr *) &addr, sizeof (addr)) < 0) {
+        SAI_SWITCH_LOG_ERR ("Cannot bind rtnetlink socket %s(%d)", strerror (errno), errno);
+        std_close (sock);
+        return STD_INVALID_FD;
+    }
+
+    if (std_sock_set_rcvbuf (sock, SAI_VM_RTNL_RCV_BUF_SIZE) != STD_ERR_OK) {
+        SAI_SWITCH_LOG_ERR ("Cannot set rcvbuf size %s(%d)", strerror (errno), errno);
+        /* Continue: we can still receive messages. */
+    }
+    return sock;
+}
+
+int sai_vm_rtnl_open (uint32_t groups)
+{
+    int sock = STD_INVALID_FD;
+    t_std_error rc = std_netns_socket_create (e_std_sock_NETLINK,
+            e_std_sock_type_RAW,
+            NETLINK_ROUTE,
+            (const std_socket_address_t*)NULL,
+            VPORT_NAME_SPACE,
+            &sock);
+
+    if (rc != STD_ERR_OK) {
+        SAI_SWITCH_LOG_ERR ("Cannot open rtnetlink socket %s(%d)", strerror (errno), errno);
+        return STD_INVALID_FD;
+    }
+
+    return sai_vm_rtnl_sock_setup (sock, groups);
+}
+
+int sai_vm_rtnl_switch_ns_open (uint32_t groups)
+{
+    int sock = STD_INVALID_FD;
+    t_std_error rc = std_socket_create (e_std_sock_NETLINK,
+            e_std_sock_type_RAW,
+            NETLINK_ROUTE,
+            (const std_socket_address_t*)NULL,
+            &sock);
+
+    if (rc != STD_ERR_OK) {
+        SAI_SWITCH_LOG_ERR ("Cannot open rtnetlink socket %s(%d)", strerror (errno), errno);
+        return STD_INVALID_FD;
+    }
+
+    return sai_vm_rtnl_sock_setup (sock, groups);
+}
+
+void sai_vm_rtnl_close (int sock)
+{
+    if (sock != STD_INVALID_FD) {
+        std_close (sock);
+    }
+}
+
+void sai_vm_rtnl_attr_parse (struct rtattr **tb, int max,
+                             struct rtattr *rta, int len)
+{
+    memset (tb, 0, sizeof (struct rtattr *) * (max + 1));
+
+    while (RTA_OK (rta, len)) {
+        unsigned short type = rta->rta_type & NLA_TYPE_MASK;
+
+        if ((type <= max) && (tb[type] == NULL)) {
+            tb[type] = rta;
+        }
+        rta = RTA_NEXT (rta, len);
+    }
+}
+
+sai_status_t sai_vm_rtnl_dump (int sock, struct nlmsghdr *req,
+                               sai_vm_rtnl_msg_cb_t cb, void *ctx)
+{
+    sai_status_t status = SAI_STATUS_FAILURE;
+    bool         done = false;
+    char        *buf = NULL;
+    uint32_t     seq = 0;
+
+    if ((sock == STD_INVALID_FD) || (req == NULL) || (cb == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    buf = malloc (SAI_VM_RTNL_RCV_BUF_SIZE);
+    if (buf == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    seq = sai_vm_rtnl_next_seq ();
+    req->nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    req->nlmsg_seq = seq;
+
+    if (send (sock, req, req->nlmsg_len, 0) < 0) {
+        SAI_SWITCH_LOG_ERR ("rtnetlink dump type %d send error %s(%d)",
+                            req->nlmsg_type, strerror (errno), errno);
+        free (buf);
+        return SAI_STATUS_FAILURE;
+    }
+
+    while (!done) {
+        struct nlmsghdr *hdr;
+        int count = recv (sock, buf, SAI_VM_RTNL_RCV_BUF_SIZE, 0);
+
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            SAI_SWITCH_LOG_ERR ("rtnetlink dump recv error %s(%d)", strerror (errno), errno);
+            break;
+        }
+
+        if (count == 0) {
+            SAI_SWITCH_LOG_ERR ("rtnetlink dump EOF");
+            break;
+        }
+
+        for (hdr = (struct nlmsghdr *) buf; NLMSG_OK (hdr, count);
+             hdr = NLMSG_NEXT (hdr, count)) {
+
+            if (hdr->nlmsg_seq != seq) {
+                /* Stale reply of an earlier, aborted request */
+                continue;
+            }
+
+            if (hdr->nlmsg_type == NLMSG_DONE) {
+                status = SAI_STATUS_SUCCESS;
+                done = true;
+                break;
+            }
+
+            if (hdr->nlmsg_type == NLMSG_ERROR) {
+                struct nlmsgerr *err = (struct nlmsgerr *) NLMSG_DATA (hdr);
+
+                SAI_SWITCH_LOG_ERR ("rtnetlink dump type %d failed %s(%d)",
+                                    req->nlmsg_type, strerror (-err->error),
+                                    -err->error);
+                done = true;
+                break;
+            }
+
+            cb (hdr, ctx);
+        }
+    }
+
+    free (buf);
+    return status;
+}
+
+void sai_vm_rtnl_batch_init (sai_vm_rtnl_batch_t *batch)
+{
+    memset (batch, 0, sizeof (*batch));
+}
+
+void sai_vm_rtnl_batch_free (sai_vm_rtnl_batch_t *batch)
+{
+    free (batch->buf);
+    free (batch->msg_err);
+    sai_vm_rtnl_batch_init (batch);
+}
+
+/* Reserve len aligned bytes at the end of the batch, NULL on failure */
+static void *sai_vm_rtnl_batch_reserve (sai_vm_rtnl_batch_t *batch, size_t len)
+{
+    size_t  aligned = NLMSG_ALIGN (len);
+    void   *p = NULL;
+
+    if (batch->oom) {
+        return NULL;
+    }
+
+    if ((batch->len + aligned) > batch->size) {
+        size_t  size = batch->size + SAI_VM_RTNL_BATCH_CHUNK_SIZE;
+        char   *buf = NULL;
+
+        while (size < (batch->len + aligned)) {
+            size += SAI_VM_RTNL_BATCH_CHUNK_SIZE;
+        }
+
+        buf = realloc (batch->buf, size);
+        if (buf == NULL) {
+            SAI_SWITCH_LOG_ERR ("rtnetlink batch allocation of %u bytes failed",
+                                (uint_t) size);
+            batch->oom = true;
+            return NULL;
+        }
+        batch->buf = buf;
+        batch->size = size;
+    }
+
+    p = batch->buf + batch->len;
+    memset (p, 0, aligned);
+    batch->len += aligned;
+
+    return p;
+}
+
+static inline struct nlmsghdr *sai_vm_rtnl_batch_cur_msg (sai_vm_rtnl_batch_t *batch)
+{
+    return (struct nlmsghdr *) (batch->buf + batch->msg_offset);
+}
+
+void sai_vm_rtnl_batch_msg_add (sai_vm_rtnl_batch_t *batch, uint16_t type,
+                                uint16_t flags, const void *hdr, size_t hdr_len)
+{
+    struct nlmsghdr *nlh = NULL;
+    size_t           offset = batch->len;
+
+    nlh = sai_vm_rtnl_batch_reserve (batch, NLMSG_LENGTH (hdr_len));
+    if (nlh == NULL) {
+        return;
+    }
+
+    nlh->nlmsg_len = NLMSG_LENGTH (hdr_len);
+    nlh->nlmsg_type = type;
+    nlh->nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK | flags;
+
+    if (hdr_len != 0) {
+        memcpy (NLMSG_DATA (nlh), hdr, hdr_len);
+    }
+
+    batch->msg_offset = offset;
+    batch->msg_count++;
+}
+
+void sai_vm_rtnl_attr_add (sai_vm_rtnl_batch_t *batch, uint16_t type,
+                           const void *data, size_t len)
+{
+    struct rtattr *rta = NULL;
+
+    rta = sai_vm_rtnl_batch_reserve (batch, RTA_LENGTH (len));
+    if (rta == NULL) {
+        return;
+    }
+
+    rta->rta_type = type;
+    rta->rta_len = RTA_LENGTH (len);
+
+    if (len != 0) {
+        memcpy (RTA_DATA (rta), data, len);
+    }
+
+    sai_vm_rtnl_batch_cur_msg (batch)->nlmsg_len = batch->len - batch->msg_offset;
+}
+
+size_t sai_vm_rtnl_nest_begin (sai_vm_rtnl_batch_t *batch, uint16_t type)
+{
+    size_t nest = batch->len;
+
+    sai_vm_rtnl_attr_add (batch, type | NLA_F_NESTED, NULL, 0);
+
+    return nest;
+}
+
+void sai_vm_rtnl_nest_end (sai_vm_rtnl_batch_t *batch, size_t nest)
+{
+    struct rtattr *rta = NULL;
+
+    if (batch->oom) {
+        return;
+    }
+
+    rta = (struct rtattr *) (batch->buf + nest);
+    rta->rta_len = batch->len - nest;
+}
+
+sai_status_t sai_vm_rtnl_errno_to_sai_status (int err)
+{
+    switch (err) {
+        case 0:
+            return SAI_STATUS_SUCCESS;
+        case EEXIST:
+            return SAI_STATUS_ITEM_ALREADY_EXISTS;
+        case ENODEV:
+        case ENOENT:
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        case ENOMEM:
+        case ENOBUFS:
+            return SAI_STATUS_NO_MEMORY;
+        case EBUSY:
+            return SAI_STATUS_OBJECT_IN_USE;
+        case EINVAL:
+        case ERANGE:
+            return SAI_STATUS_INVALID_PARAMETER;
+        case EOPNOTSUPP:
+            return SAI_STATUS_NOT_SUPPORTED;
+        default:
+            return SAI_STATUS_FAILURE;
+    }
+}
+
+sai_status_t sai_vm_rtnl_batch_commit (int sock, sai_vm_rtnl_batch_t *batch,
+                                       sai_vm_rtnl_msg_cb_t cb, void *ctx)
+{
+    sai_status_t     status = SAI_STATUS_SUCCESS;
+    struct nlmsghdr *nlh = NULL;
+    char            *buf = NULL;
+    uint32_t         first_seq = 0;
+    uint32_t         acked = 0;
+    uint32_t         idx = 0;
+    int              len = 0;
+    bool             aborted = false;
+
+    if (batch == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (batch->oom) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    if (batch->msg_count == 0) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (sock == STD_INVALID_FD) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    free (batch->msg_err);
+    batch->msg_err = calloc (batch->msg_count, sizeof (int));
+    buf = malloc (SAI_VM_RTNL_RCV_BUF_SIZE);
+
+    if ((batch->msg_err == NULL) || (buf == NULL)) {
+        free (buf);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    /* Reserve a contiguous range of sequence numbers for the batch */
+    first_seq = __sync_add_and_fetch (&sai_vm_rtnl_seq, batch->msg_count)
+                - batch->msg_count + 1;
+
+    /* Messages left unacknowledged on an aborted commit report -EIO */
+    len = batch->len;
+    for (nlh = (struct nlmsghdr *) batch->buf; NLMSG_OK (nlh, len);
+         nlh = NLMSG_NEXT (nlh, len)) {
+        nlh->nlmsg_seq = first_seq + idx;
+        batch->msg_err[idx] = -EIO;
+        idx++;
+    }
+
+    /*
+     * Send the batch a window at a time, so that the acks of a window fit in
+     * the receive buffer.
+     */
+    nlh = (struct nlmsghdr *) batch->buf;
+    len = batch->len;
+
+    while ((acked < batch->msg_count) && (!aborted)) {
+        char     *win_buf = (char *) nlh;
+        size_t    win_len = 0;
+        uint32_t  win_end = acked;
+
+        while ((win_end - acked < SAI_VM_RTNL_BATCH_WINDOW) && (NLMSG_OK (nlh, len))) {
+            win_len += NLMSG_ALIGN (nlh->nlmsg_len);
+            nlh = NLMSG_NEXT (nlh, len);
+            win_end++;
+        }
+
+        if (win_len > (size_t) (batch->buf + batch->len - win_buf)) {
+            win_len = batch->buf + batch->len - win_buf;
+        }
+
+        if (send (sock, win_buf, win_len, 0) < 0) {
+            SAI_SWITCH_LOG_ERR ("rtnetlink batch of %u messages send error %s(%d)",
+                                batch->msg_count, strerror (errno), errno);
+            status = SAI_STATUS_FAILURE;
+            break;
+        }
+
+        while ((acked < win_end) && (!aborted)) {
+            struct nlmsghdr *hdr;
+            int count = recv (sock, buf, SAI_VM_RTNL_RCV_BUF_SIZE, 0);
+
+            if (count < 0) {
+                if (errno == EINTR) continue;
+                SAI_SWITCH_LOG_ERR ("rtnetlink batch recv error %s(%d)", strerror (errno), errno);
+                status = SAI_STATUS_FAILURE;
+                aborted = true;
+                break;
+            }
+
+            if (count == 0) {
+                SAI_SWITCH_LOG_ERR ("rtnetlink batch EOF");
+                status = SAI_STATUS_FAILURE;
+                aborted = true;
+                break;
+            }
+
+            for (hdr = (struct nlmsghdr *) buf; NLMSG_OK (hdr, count);
+                 hdr = NLMSG_NEXT (hdr, count)) {
+
+                idx = hdr->nlmsg_seq - first_seq;
+                if (idx >= batch->msg_count) {
+                    /* Stale reply of an earlier, aborted request */
+                    continue;
+                }
+
+                if (hdr->nlmsg_type != NLMSG_ERROR) {
+                    if (cb != NULL) {
+                        cb (hdr, ctx);
+                    }
+                    continue;
+                }
+
+                batch->msg_err[idx] = ((struct nlmsgerr *) NLMSG_DATA (hdr))->error;
+                acked++;
+
+                if (batch->msg_err[idx] != 0) {
+                    SAI_SWITCH_LOG_ERR ("rtnetlink batch message %u failed %s(%d)",
+                                        idx, strerror (-batch->msg_err[idx]),
+                                        -batch->msg_err[idx]);
+
+                    if (status == SAI_STATUS_SUCCESS) {
+                        status = sai_vm_rtnl_errno_to_sai_status (-batch->msg_err[idx]);
+                    }
+                }
+            }
+        }
+    }
+
+    free (buf);
+    return status;
+}
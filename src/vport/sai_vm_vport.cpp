@@ -28,6 +28,11 @@
 #include "event_log.h"
 #include "sai_switch_utils.h"
 #include "std_file_utils.h"
+#include "std_mutex_lock.h"
+
+extern "C" {
+#include "sai_vm_qos.h"
+}
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -76,6 +81,52 @@
 // See also: vnic.sh in platform-VM: config/scripts/common/bin/vnic.sh
 #define VNIC_PORT_PREFIX "vport"
 
+/* 802.1ad outer tag, classified as an 802.1Q tag */
+#define VPORT_QOS_ETHERTYPE_QINQ  0x88a8
+
+/* Unmapped entry of a QoS classification array */
+#define VPORT_QOS_UNMAPPED  0xff
+
+/* Largest frame remarked on TX, as received by the packet RX thread */
+#define VPORT_QOS_MAX_FRAME  (16*1024+4)
+
+/* Map types applied on the packet path */
+#define VPORT_QOS_MAP_SLOTS  7
+
+/*
+ * Serializes the writers of the QoS classification arrays: full map sets
+ * run under the QoS lock, map deltas are pushed after it is released.
+ */
+static std_mutex_lock_create_static_init_fast(vport_qos_lock);
+
+/*
+ * QoS classification arrays of a virtual port, unmapped entries holding
+ * VPORT_QOS_UNMAPPED. The vport_qos_lock holder rewrites them inside an
+ * odd/even sequence count window. The packet path reads them without a lock
+ * and retries if the count moved.
+ */
+struct _sai_vm_vport_qos_t {
+    unsigned int seq;
+    uint8_t dot1p_to_tc[SAI_VM_VPORT_QOS_DOT1P_MAX];
+    uint8_t dot1p_to_color[SAI_VM_VPORT_QOS_DOT1P_MAX];
+    uint8_t dscp_to_tc[SAI_VM_VPORT_QOS_DSCP_MAX];
+    uint8_t dscp_to_color[SAI_VM_VPORT_QOS_DSCP_MAX];
+    uint8_t tc_to_queue[SAI_VM_VPORT_QOS_TC_MAX];
+    uint8_t tc_color_to_dot1p[SAI_VM_VPORT_QOS_TC_MAX][SAI_VM_VPORT_QOS_COLOR_MAX];
+    uint8_t tc_color_to_dscp[SAI_VM_VPORT_QOS_TC_MAX][SAI_VM_VPORT_QOS_COLOR_MAX];
+    /* TX socket of each queue, STD_INVALID_FD to use the data socket */
+    int tx_sock[SAI_VM_VPORT_QOS_TX_QUEUES];
+};
+
+/* QoS fields of a frame, -1 when absent */
+typedef struct _vport_qos_hdr_t {
+    int tci_offset;
+    int l3_offset;
+    int pcp;
+    int dscp;
+    bool is_ipv4;
+} vport_qos_hdr_t;
+
 
 /** Virtual front panel port */
 class sai_vport {
@@ -86,6 +137,10 @@ protected:
     int mac_addr_offset;
     std::string if_name;
     std::string vnic_name;
+    struct _sai_vm_vport_qos_t qos;
+    // Map bound per map type, and generation of its values last applied
+    sai_object_id_t qos_map_id[VPORT_QOS_MAP_SLOTS];
+    uint64_t qos_map_generation[VPORT_QOS_MAP_SLOTS];
 
     sai_vport():
         mac_addr_offset(-1)
@@ -93,12 +148,26 @@ protected:
         desc.fpp_id = 0;
         desc.if_index = 0;
         desc.data_sock = STD_INVALID_FD;
+        desc.qos = &qos;
+
+        memset(&qos, VPORT_QOS_UNMAPPED, sizeof(qos));
+        qos.seq = 0;
+        for (unsigned int queue = 0; queue < SAI_VM_VPORT_QOS_TX_QUEUES; queue++) {
+            qos.tx_sock[queue] = STD_INVALID_FD;
+        }
+        for (unsigned int slot = 0; slot < VPORT_QOS_MAP_SLOTS; slot++) {
+            qos_map_id[slot] = SAI_NULL_OBJECT_ID;
+            qos_map_generation[slot] = 0;
+        }
     }
     virtual ~sai_vport() {}
     bool read_cfg(std_config_node_t& fpp_node);
 
     t_std_error start_ctl_oper(int* sock, int* ns_handle);
     void finish_ctl_oper(int sock, int ns_handle);
+    void open_qos_tx_socks();
+    bool get_qos_map_table(sai_qos_map_type_t map_type, uint8_t **table,
+                           size_t *table_size, unsigned int *slot);
 
     // List of (virtual) ports - addressed by if_index
     static std::unordered_map<int, sai_vport*> fp_ports_by_ifindex;
@@ -122,13 +191,24 @@ public:
     bool set_mtu_size(unsigned int mtu_sz);
     sai_port_oper_status_t get_oper_status();
     bool update_mac_address(const sai_mac_t *mac_address);
+    sai_status_t set_qos_map(sai_qos_map_type_t map_type, sai_object_id_t map_id,
+                             uint64_t generation, const sai_qos_map_list_t *map_list);
+    sai_status_t update_qos_map(sai_qos_map_type_t map_type, sai_object_id_t map_id,
+                                uint64_t generation, const uint_t *index_list,
+                                const sai_qos_map_t *entry_list, uint_t count);
+    uint64_t get_qos_map_generation(sai_qos_map_type_t map_type);
+
+    // TC of frames no bound map classifies
+    static uint8_t qos_default_tc;
 
     vport_desc_t* get_desc() { return &this->desc; }
+    const char* get_if_name() { return this->if_name.c_str(); }
 };
 
 
 std::unordered_map<int, sai_vport*> sai_vport::fp_ports_by_ifindex;
 std::unordered_map<unsigned int, sai_vport*> sai_vport::fp_ports_by_hwport;
+uint8_t sai_vport::qos_default_tc = 0;
 
 bool sai_vport::read_cfg(std_config_node_t& fpp_node)
 {
@@ -293,12 +373,40 @@ t_std_error sai_vport::init_packet_io()
             vfpp->desc.data_sock = STD_INVALID_FD;
             continue;
         }
+
+        vfpp->open_qos_tx_socks();
     }
 
     std_sys_reset_netns(&crt_ns_handle);
     return STD_ERR_OK;
 }
 
+// Open a TX-only socket per queue, whose skb priority selects the tc class of
+// the queue on the root qdisc of the port
+void sai_vport::open_qos_tx_socks()
+{
+    for (unsigned int queue = 0; queue < SAI_VM_VPORT_QOS_TX_QUEUES; queue++) {
+        int sock = STD_INVALID_FD;
+        int priority = (int)SAI_VM_QOS_QUEUE_CLASSID(queue);
+
+        if (std_socket_create(e_std_sock_PACKET, e_std_sock_type_RAW, 0,
+                    (const std_socket_address_t*)NULL, &sock) != STD_ERR_OK) {
+            EV_LOGGING(SAI_SWITCH, ERR, "SAI-VM-VFPP", "Cannot open queue %u socket for (%s)",
+                    queue, vnic_name.c_str());
+            continue;
+        }
+
+        if (setsockopt(sock, SOL_SOCKET, SO_PRIORITY, &priority, sizeof(priority)) < 0) {
+            EV_LOGGING(SAI_SWITCH,ERR,"SAI-VM-VFPP","setsockopt SO_PRIORITY failed vnic=%s queue=%u errno=%s(%d)",
+                    vnic_name.c_str(), queue, strerror(errno), errno);
+            std_close(sock);
+            continue;
+        }
+
+        qos.tx_sock[queue] = sock;
+    }
+}
+
 // Packet I/O RX loop; must be called from its own thread
 void sai_vport::do_packet_rx_loop(vport_packet_rx_t packet_rx)
 {
@@ -554,6 +662,321 @@ sai_status_t sai_vport::set_mac_address (const sai_mac_t *mac_address)
     return rc;
 }
 
+// Key and value of a QoS map entry, as indices of the array of its map type
+static bool vport_qos_map_entry_get(sai_qos_map_type_t map_type, const sai_qos_map_t *entry,
+                                    unsigned int *key, unsigned int *value)
+{
+    unsigned int value_max = 0;
+
+    switch (map_type) {
+        case SAI_QOS_MAP_TYPE_DOT1P_TO_TC:
+            *key = entry->key.dot1p;
+            *value = entry->value.tc;
+            value_max = SAI_VM_VPORT_QOS_TC_MAX;
+            break;
+        case SAI_QOS_MAP_TYPE_DOT1P_TO_COLOR:
+            *key = entry->key.dot1p;
+            *value = entry->value.color;
+            value_max = SAI_VM_VPORT_QOS_COLOR_MAX;
+            break;
+        case SAI_QOS_MAP_TYPE_DSCP_TO_TC:
+            *key = entry->key.dscp;
+            *value = entry->value.tc;
+            value_max = SAI_VM_VPORT_QOS_TC_MAX;
+            break;
+        case SAI_QOS_MAP_TYPE_DSCP_TO_COLOR:
+            *key = entry->key.dscp;
+            *value = entry->value.color;
+            value_max = SAI_VM_VPORT_QOS_COLOR_MAX;
+            break;
+        case SAI_QOS_MAP_TYPE_TC_TO_QUEUE:
+            *key = entry->key.tc;
+            *value = entry->value.queue_index;
+            value_max = VPORT_QOS_UNMAPPED;
+            break;
+        case SAI_QOS_MAP_TYPE_TC_AND_COLOR_TO_DOT1P:
+        case SAI_QOS_MAP_TYPE_TC_AND_COLOR_TO_DSCP:
+            if ((entry->key.tc >= SAI_VM_VPORT_QOS_TC_MAX) ||
+                ((unsigned int)entry->key.color >= SAI_VM_VPORT_QOS_COLOR_MAX)) {
+                return false;
+            }
+            *key = (entry->key.tc * SAI_VM_VPORT_QOS_COLOR_MAX) + entry->key.color;
+            if (map_type == SAI_QOS_MAP_TYPE_TC_AND_COLOR_TO_DOT1P) {
+                *value = entry->value.dot1p;
+                value_max = SAI_VM_VPORT_QOS_DOT1P_MAX;
+            } else {
+                *value = entry->value.dscp;
+                value_max = SAI_VM_VPORT_QOS_DSCP_MAX;
+            }
+            break;
+        default:
+            return false;
+    }
+
+    return (*value < value_max);
+}
+
+// Classification array of a map type, false if not applied on the packet path
+bool sai_vport::get_qos_map_table(sai_qos_map_type_t map_type, uint8_t **table,
+                                  size_t *table_size, unsigned int *slot)
+{
+    switch (map_type) {
+        case SAI_QOS_MAP_TYPE_DOT1P_TO_TC:
+            *table = qos.dot1p_to_tc;
+            *table_size = sizeof(qos.dot1p_to_tc);
+            *slot = 0;
+            break;
+        case SAI_QOS_MAP_TYPE_DOT1P_TO_COLOR:
+            *table = qos.dot1p_to_color;
+            *table_size = sizeof(qos.dot1p_to_color);
+            *slot = 1;
+            break;
+        case SAI_QOS_MAP_TYPE_DSCP_TO_TC:
+            *table = qos.dscp_to_tc;
+            *table_size = sizeof(qos.dscp_to_tc);
+            *slot = 2;
+            break;
+        case SAI_QOS_MAP_TYPE_DSCP_TO_COLOR:
+            *table = qos.dscp_to_color;
+            *table_size = sizeof(qos.dscp_to_color);
+            *slot = 3;
+            break;
+        case SAI_QOS_MAP_TYPE_TC_TO_QUEUE:
+            *table = qos.tc_to_queue;
+            *table_size = sizeof(qos.tc_to_queue);
+            *slot = 4;
+            break;
+        case SAI_QOS_MAP_TYPE_TC_AND_COLOR_TO_DOT1P:
+            *table = &qos.tc_color_to_dot1p[0][0];
+            *table_size = sizeof(qos.tc_color_to_dot1p);
+            *slot = 5;
+            break;
+        case SAI_QOS_MAP_TYPE_TC_AND_COLOR_TO_DSCP:
+            *table = &qos.tc_color_to_dscp[0][0];
+            *table_size = sizeof(qos.tc_color_to_dscp);
+            *slot = 6;
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+sai_status_t sai_vport::set_qos_map(sai_qos_map_type_t map_type, sai_object_id_t map_id,
+                                    uint64_t generation, const sai_qos_map_list_t *map_list)
+{
+    uint8_t *table = NULL;
+    size_t table_size = 0;
+    unsigned int slot = 0;
+    uint8_t compiled[SAI_VM_VPORT_QOS_DSCP_MAX];
+    unsigned int key = 0, value = 0;
+    size_t idx = 0, count = 0;
+
+    if (!get_qos_map_table(map_type, &table, &table_size, &slot)) {
+        // Not applied on the packet path
+        return SAI_STATUS_SUCCESS;
+    }
+
+    memset(compiled, VPORT_QOS_UNMAPPED, sizeof(compiled));
+
+    if ((map_list != NULL) && (map_list->list != NULL)) {
+        count = map_list->count;
+
+        // Multicast queues of a TC to queue map follow its unicast queues
+        if ((map_type == SAI_QOS_MAP_TYPE_TC_TO_QUEUE) && (count > SAI_VM_VPORT_QOS_TC_MAX)) {
+            count = SAI_VM_VPORT_QOS_TC_MAX;
+        }
+
+        for (idx = 0; idx < count; idx++) {
+            if (!vport_qos_map_entry_get(map_type, &map_list->list[idx], &key, &value) ||
+                (key >= table_size)) {
+                EV_LOGGING(SAI_SWITCH,DEBUG,"SAI-VM-VFPP","ifname=%s QoS map type %d entry %u skipped",
+                        if_name.c_str(), map_type, (unsigned int)idx);
+                continue;
+            }
+            compiled[key] = (uint8_t)value;
+        }
+    }
+
+    std_mutex_lock(&vport_qos_lock);
+
+    __atomic_store_n(&qos.seq, qos.seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    for (idx = 0; idx < table_size; idx++) {
+        __atomic_store_n(&table[idx], compiled[idx], __ATOMIC_RELAXED);
+    }
+
+    __atomic_store_n(&qos.seq, qos.seq + 1, __ATOMIC_RELEASE);
+
+    qos_map_id[slot] = (map_list != NULL) ? map_id : SAI_NULL_OBJECT_ID;
+    qos_map_generation[slot] = generation;
+
+    std_mutex_unlock(&vport_qos_lock);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_vport::update_qos_map(sai_qos_map_type_t map_type, sai_object_id_t map_id,
+                                       uint64_t generation, const uint_t *index_list,
+                                       const sai_qos_map_t *entry_list, uint_t count)
+{
+    uint8_t *table = NULL;
+    size_t table_size = 0;
+    unsigned int slot = 0;
+    unsigned int key = 0, value = 0;
+    uint_t idx = 0;
+
+    if (!get_qos_map_table(map_type, &table, &table_size, &slot)) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    std_mutex_lock(&vport_qos_lock);
+
+    // The map was unbound, or a full set already applied these values
+    if ((qos_map_id[slot] != map_id) || (qos_map_generation[slot] >= generation)) {
+        std_mutex_unlock(&vport_qos_lock);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    // All changed entries in one window, readers see the old or the new map
+    __atomic_store_n(&qos.seq, qos.seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    for (idx = 0; idx < count; idx++) {
+        // Multicast queues of a TC to queue map follow its unicast queues
+        if ((map_type == SAI_QOS_MAP_TYPE_TC_TO_QUEUE) &&
+            (index_list[idx] >= SAI_VM_VPORT_QOS_TC_MAX)) {
+            continue;
+        }
+        if (!vport_qos_map_entry_get(map_type, &entry_list[idx], &key, &value) ||
+            (key >= table_size)) {
+            EV_LOGGING(SAI_SWITCH,DEBUG,"SAI-VM-VFPP","ifname=%s QoS map type %d entry %u skipped",
+                    if_name.c_str(), map_type, index_list[idx]);
+            continue;
+        }
+        __atomic_store_n(&table[key], (uint8_t)value, __ATOMIC_RELAXED);
+    }
+
+    __atomic_store_n(&qos.seq, qos.seq + 1, __ATOMIC_RELEASE);
+
+    qos_map_generation[slot] = generation;
+
+    std_mutex_unlock(&vport_qos_lock);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+uint64_t sai_vport::get_qos_map_generation(sai_qos_map_type_t map_type)
+{
+    uint8_t *table = NULL;
+    size_t table_size = 0;
+    unsigned int slot = 0;
+    uint64_t generation = 0;
+
+    if (!get_qos_map_table(map_type, &table, &table_size, &slot)) {
+        return 0;
+    }
+
+    std_mutex_lock(&vport_qos_lock);
+    generation = qos_map_generation[slot];
+    std_mutex_unlock(&vport_qos_lock);
+
+    return generation;
+}
+
+static void vport_qos_hdr_parse(const uint8_t *frame, size_t len, const uint16_t *vlan_tci,
+                                vport_qos_hdr_t *hdr)
+{
+    size_t offset = ETHER_ADDR_LEN * 2;
+    uint16_t eth_type = 0;
+
+    hdr->tci_offset = -1;
+    hdr->l3_offset = -1;
+    hdr->pcp = (vlan_tci != NULL) ? (*vlan_tci >> 13) : -1;
+    hdr->dscp = -1;
+    hdr->is_ipv4 = false;
+
+    if (len < ETHER_HDR_LEN) {
+        return;
+    }
+
+    eth_type = (uint16_t)((frame[offset] << 8) | frame[offset + 1]);
+
+    if (((eth_type == ETHERTYPE_VLAN) || (eth_type == VPORT_QOS_ETHERTYPE_QINQ)) &&
+        (len >= ETHER_HDR_LEN + 4)) {
+        hdr->tci_offset = offset + 2;
+        if (vlan_tci == NULL) {
+            hdr->pcp = frame[offset + 2] >> 5;
+        }
+        offset += 4;
+        eth_type = (uint16_t)((frame[offset] << 8) | frame[offset + 1]);
+    }
+    offset += 2;
+
+    if ((eth_type == ETHERTYPE_IP) && (len >= offset + 20) &&
+        ((frame[offset] >> 4) == 4)) {
+        hdr->l3_offset = offset;
+        hdr->dscp = frame[offset + 1] >> 2;
+        hdr->is_ipv4 = true;
+    } else if ((eth_type == ETHERTYPE_IPV6) && (len >= offset + 40) &&
+               ((frame[offset] >> 4) == 6)) {
+        hdr->l3_offset = offset;
+        hdr->dscp = ((frame[offset] & 0x0f) << 2) | (frame[offset + 1] >> 6);
+    }
+}
+
+static inline uint8_t vport_qos_load(const uint8_t *entry)
+{
+    return __atomic_load_n(entry, __ATOMIC_RELAXED);
+}
+
+static void vport_qos_lookup(const struct _sai_vm_vport_qos_t *qos, const vport_qos_hdr_t *hdr,
+                             sai_vm_vport_qos_class_t *qos_class)
+{
+    unsigned int start = 0;
+    uint8_t tc = 0, color = 0, queue = 0, dscp = 0, dot1p = 0;
+
+    do {
+        while ((start = __atomic_load_n(&qos->seq, __ATOMIC_ACQUIRE)) & 1);
+
+        tc = VPORT_QOS_UNMAPPED;
+        color = VPORT_QOS_UNMAPPED;
+        if (hdr->dscp >= 0) {
+            tc = vport_qos_load(&qos->dscp_to_tc[hdr->dscp]);
+            color = vport_qos_load(&qos->dscp_to_color[hdr->dscp]);
+        }
+        if (hdr->pcp >= 0) {
+            if (tc == VPORT_QOS_UNMAPPED) {
+                tc = vport_qos_load(&qos->dot1p_to_tc[hdr->pcp]);
+            }
+            if (color == VPORT_QOS_UNMAPPED) {
+                color = vport_qos_load(&qos->dot1p_to_color[hdr->pcp]);
+            }
+        }
+        if (tc == VPORT_QOS_UNMAPPED) {
+            tc = __atomic_load_n(&sai_vport::qos_default_tc, __ATOMIC_RELAXED);
+        }
+        if (color == VPORT_QOS_UNMAPPED) {
+            color = SAI_PACKET_COLOR_GREEN;
+        }
+
+        queue = vport_qos_load(&qos->tc_to_queue[tc]);
+        dscp = (hdr->dscp >= 0) ?
+            vport_qos_load(&qos->tc_color_to_dscp[tc][color]) : VPORT_QOS_UNMAPPED;
+        dot1p = (hdr->tci_offset >= 0) ?
+            vport_qos_load(&qos->tc_color_to_dot1p[tc][color]) : VPORT_QOS_UNMAPPED;
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (__atomic_load_n(&qos->seq, __ATOMIC_RELAXED) != start);
+
+    qos_class->tc = tc;
+    qos_class->color = color;
+    qos_class->queue = (queue == VPORT_QOS_UNMAPPED) ? tc : queue;
+    qos_class->dscp = (dscp == hdr->dscp) ? SAI_VM_VPORT_QOS_NO_REMARK : dscp;
+    qos_class->dot1p = (dot1p == hdr->pcp) ? SAI_VM_VPORT_QOS_NO_REMARK : dot1p;
+}
+
 
 extern "C" sai_status_t sai_vport_get_npu_port(int if_index, sai_npu_port_id_t *port)
 {
@@ -577,6 +1000,17 @@ extern "C" vport_desc_t* sai_vm_vport_get_desc(sai_npu_port_id_t port_id)
     return vfpp->get_desc();
 }
 
+extern "C" const char* sai_vm_vport_get_if_name(sai_npu_port_id_t port_id)
+{
+    sai_vport *vfpp = sai_vport::find_interface_by_hwport((unsigned int)port_id);
+
+    if (NULL == vfpp) {
+        return NULL;
+    }
+
+    return vfpp->get_if_name();
+}
+
 
 extern "C" t_std_error sai_vport_init_packet_io(void)
 {
@@ -628,6 +1062,152 @@ extern "C" sai_port_oper_status_t sai_vport_get_oper_status(sai_npu_port_id_t po
     return vfpp->get_oper_status();
 }
 
+extern "C" sai_status_t sai_vm_vport_qos_map_set(sai_npu_port_id_t port_id,
+                                                 sai_qos_map_type_t map_type,
+                                                 sai_object_id_t map_id,
+                                                 uint64_t generation,
+                                                 const sai_qos_map_list_t *map_list)
+{
+    sai_vport *vfpp = sai_vport::find_interface_by_hwport((unsigned int)port_id);
+    if (NULL == vfpp) {
+        // This is not an error - we do not have such an interface in the VM
+        return SAI_STATUS_SUCCESS;
+    }
+    return vfpp->set_qos_map(map_type, map_id, generation, map_list);
+}
+
+extern "C" sai_status_t sai_vm_vport_qos_map_update(sai_npu_port_id_t port_id,
+                                                    sai_qos_map_type_t map_type,
+                                                    sai_object_id_t map_id,
+                                                    uint64_t generation,
+                                                    const uint_t *index_list,
+                                                    const sai_qos_map_t *entry_list,
+                                                    uint_t count)
+{
+    sai_vport *vfpp = sai_vport::find_interface_by_hwport((unsigned int)port_id);
+    if (NULL == vfpp) {
+        return SAI_STATUS_SUCCESS;
+    }
+    return vfpp->update_qos_map(map_type, map_id, generation, index_list,
+                                entry_list, count);
+}
+
+extern "C" uint64_t sai_vm_vport_qos_map_generation_get(sai_npu_port_id_t port_id,
+                                                        sai_qos_map_type_t map_type)
+{
+    sai_vport *vfpp = sai_vport::find_interface_by_hwport((unsigned int)port_id);
+    if (NULL == vfpp) {
+        return 0;
+    }
+    return vfpp->get_qos_map_generation(map_type);
+}
+
+extern "C" void sai_vm_vport_qos_default_tc_set(uint_t tc)
+{
+    if (tc >= SAI_VM_VPORT_QOS_TC_MAX) {
+        return;
+    }
+    __atomic_store_n(&sai_vport::qos_default_tc, (uint8_t)tc, __ATOMIC_RELAXED);
+}
+
+extern "C" void sai_vm_vport_qos_classify(const vport_desc_t *desc, const uint8_t *frame,
+                                          size_t len, const uint16_t *vlan_tci,
+                                          sai_vm_vport_qos_class_t *qos_class)
+{
+    vport_qos_hdr_t hdr;
+    struct _sai_vm_vport_qos_t unmapped;
+
+    vport_qos_hdr_parse(frame, len, vlan_tci, &hdr);
+
+    if (desc->qos != NULL) {
+        vport_qos_lookup(desc->qos, &hdr, qos_class);
+        return;
+    }
+
+    memset(&unmapped, VPORT_QOS_UNMAPPED, sizeof(unmapped));
+    unmapped.seq = 0;
+    vport_qos_lookup(&unmapped, &hdr, qos_class);
+}
+
+extern "C" bool sai_vm_vport_qos_remark(uint8_t *frame, size_t len,
+                                        const sai_vm_vport_qos_class_t *qos_class)
+{
+    vport_qos_hdr_t hdr;
+    bool changed = false;
+
+    vport_qos_hdr_parse(frame, len, NULL, &hdr);
+
+    if ((qos_class->dot1p != SAI_VM_VPORT_QOS_NO_REMARK) && (hdr.tci_offset >= 0)) {
+        frame[hdr.tci_offset] = (uint8_t)((frame[hdr.tci_offset] & 0x1f) |
+                                          (qos_class->dot1p << 5));
+        changed = true;
+    }
+
+    if ((qos_class->dscp != SAI_VM_VPORT_QOS_NO_REMARK) && (hdr.l3_offset >= 0)) {
+        uint8_t *ip = &frame[hdr.l3_offset];
+
+        if (hdr.is_ipv4) {
+            // Incremental header checksum update (RFC 1624)
+            uint16_t old_word = (uint16_t)((ip[0] << 8) | ip[1]);
+            uint16_t new_word = 0;
+            uint32_t sum = 0;
+
+            ip[1] = (uint8_t)((qos_class->dscp << 2) | (ip[1] & 0x03));
+            new_word = (uint16_t)((ip[0] << 8) | ip[1]);
+
+            sum = (uint16_t)~((ip[10] << 8) | ip[11]);
+            sum += (uint16_t)~old_word;
+            sum += new_word;
+            sum = (sum & 0xffff) + (sum >> 16);
+            sum = (sum & 0xffff) + (sum >> 16);
+            sum = ~sum & 0xffff;
+
+            ip[10] = (uint8_t)(sum >> 8);
+            ip[11] = (uint8_t)(sum & 0xff);
+        } else {
+            ip[0] = (uint8_t)((ip[0] & 0xf0) | (qos_class->dscp >> 2));
+            ip[1] = (uint8_t)((ip[1] & 0x3f) | ((qos_class->dscp & 0x03) << 6));
+        }
+        changed = true;
+    }
+
+    return changed;
+}
+
+extern "C" ssize_t sai_vm_vport_qos_send(const vport_desc_t *desc, const void *frame,
+                                         size_t len)
+{
+    const uint8_t *p_frame = (const uint8_t *)frame;
+    uint8_t remark_buf[VPORT_QOS_MAX_FRAME];
+    sai_vm_vport_qos_class_t qos_class;
+    struct sockaddr_ll socket_address;
+    int sock = desc->data_sock;
+
+    sai_vm_vport_qos_classify(desc, p_frame, len, NULL, &qos_class);
+
+    if (((qos_class.dscp != SAI_VM_VPORT_QOS_NO_REMARK) ||
+         (qos_class.dot1p != SAI_VM_VPORT_QOS_NO_REMARK)) &&
+        (len <= sizeof(remark_buf))) {
+        memcpy(remark_buf, frame, len);
+        if (sai_vm_vport_qos_remark(remark_buf, len, &qos_class)) {
+            p_frame = remark_buf;
+        }
+    }
+
+    if ((desc->qos != NULL) && (qos_class.queue < SAI_VM_VPORT_QOS_TX_QUEUES) &&
+        (desc->qos->tx_sock[qos_class.queue] != STD_INVALID_FD)) {
+        sock = desc->qos->tx_sock[qos_class.queue];
+    }
+
+    memset(&socket_address, 0, sizeof(socket_address));
+    socket_address.sll_ifindex = desc->if_index;
+    socket_address.sll_halen = ETH_ALEN;
+    memcpy(socket_address.sll_addr, p_frame, ETH_ALEN);
+
+    return sendto(sock, p_frame, len, 0, (struct sockaddr*)&socket_address,
+                  sizeof(socket_address));
+}
+
 
 /***************************************************************************
  *
@@ -43,6 +43,7 @@
 
 static int nl_socket = STD_INVALID_FD;
 static sai_vport_oper_status_cb_t oper_status_cb_func = NULL;
+static sai_vport_link_cb_t link_cb_func = NULL;
 
 
 
@@ -124,6 +125,7 @@ static void event_handler (struct sockaddr_nl *nladdr, struct nlmsghdr *n)
     struct ifinfomsg *ifi = NLMSG_DATA (n);
     struct rtattr *rta = IFLA_RTA (ifi);
     const char *name = NULL;
+    int master_if_index = 0;
     int len = n->nlmsg_len;
 
     len -= NLMSG_LENGTH (sizeof (*ifi));
@@ -132,12 +134,21 @@ static void event_handler (struct sockaddr_nl *nladdr, struct nlmsghdr *n)
         if ((rta->rta_type & 0xffff) == IFLA_IFNAME) {
             name = (const char *) RTA_DATA (rta);
         }
+        else if ((rta->rta_type & 0xffff) == IFLA_MASTER) {
+            master_if_index = *(int *) RTA_DATA (rta);
+        }
 
         rta = RTA_NEXT (rta, len);
     }
 
     /* determine and report any change to the port status */
     sai_vm_state_handler(name, ifi);
+
+    /* LAG member state follows the same link notifications, no polling */
+    if ((n->nlmsg_type == RTM_NEWLINK) && (link_cb_func != NULL)) {
+        link_cb_func(ifi->ifi_index, master_if_index,
+                     (ifi->ifi_flags & IFF_RUNNING) != 0);
+    }
 }
 
 
@@ -242,3 +253,8 @@ void sai_vm_vport_event_oper_status_callback (sai_vport_oper_status_cb_t func)
     oper_status_cb_func = func;
 }
 
+void sai_vm_vport_event_link_callback (sai_vport_link_cb_t func)
+{
+    link_cb_func = func;
+}
+